@@ -16,21 +16,26 @@
 #include "Source/EBGeometry_DCEL.hpp"
 #include "Source/EBGeometry_DCEL_Edge.hpp"
 #include "Source/EBGeometry_DCEL_Face.hpp"
+#include "Source/EBGeometry_DCEL_IndexedMesh.hpp"
 #include "Source/EBGeometry_DCEL_Iterator.hpp"
 #include "Source/EBGeometry_DCEL_Mesh.hpp"
 #include "Source/EBGeometry_DCEL_Vertex.hpp"
+#include "Source/EBGeometry_DeformingBVH.hpp"
 #include "Source/EBGeometry_ImplicitFunction.hpp"
+#include "Source/EBGeometry_InstancedSDF.hpp"
 #include "Source/EBGeometry_Macros.hpp"
 #include "Source/EBGeometry_MeshDistanceFunctions.hpp"
 #include "Source/EBGeometry_OBJ.hpp"
 #include "Source/EBGeometry_Octree.hpp"
 #include "Source/EBGeometry_PLY.hpp"
+#include "Source/EBGeometry_Parallel.hpp"
 #include "Source/EBGeometry_Parser.hpp"
 #include "Source/EBGeometry_PointAoSoA.hpp"
 #include "Source/EBGeometry_PointCloudBVH.hpp"
 #include "Source/EBGeometry_PointCloudHashGrid.hpp"
 #include "Source/EBGeometry_PointSoA.hpp"
 #include "Source/EBGeometry_Polygon2D.hpp"
+#include "Source/EBGeometry_QuantizedBVH.hpp"
 #include "Source/EBGeometry_Random.hpp"
 #include "Source/EBGeometry_SFC.hpp"
 #include "Source/EBGeometry_STL.hpp"
@@ -156,6 +156,27 @@ runClusterSAH(const std::vector<Vec3>& a_positions, size_t a_maxClusterSize)
   return {-1.0, -1.0, directBuildTime}; // treeBuild/pack sentinel: direct-only strategy
 }
 
+// Times PLOC: TreeBVH::plocSortAndPartition() (agglomerative clustering along a Morton curve), then pack().
+// TreeBVH-only -- there is no direct PackedBVH constructor -- so the direct build is reported as "--".
+StrategyResult
+runPLOC(const std::vector<Vec3>& a_positions)
+{
+  EBGeometry::SimpleTimer timer;
+
+  timer.start();
+  auto tree = std::make_shared<Tree>(makeWrappedPrimitives(a_positions));
+  tree->plocSortAndPartition();
+  timer.stop();
+  const double treeBuildTime = timer.seconds();
+
+  timer.start();
+  auto packed = tree->pack();
+  timer.stop();
+  const double packTime = timer.seconds();
+
+  return {treeBuildTime, packTime, -1.0}; // direct-build sentinel: TreeBVH-only strategy
+}
+
 } // namespace
 
 int
@@ -164,7 +185,7 @@ main()
   // Benchmark: build the same random point cloud into a BVH with every construction strategy
   // EBGeometry offers, and time each. For the top-down and space-filling-curve strategies, both the
   // traditional TreeBVH-then-pack() path and PackedBVH's direct constructor are timed; ClusterSAH is
-  // direct-only.
+  // direct-only, and PLOC is TreeBVH-only.
 
   const std::vector<size_t> sizes = {500'000};
 
@@ -222,6 +243,8 @@ main()
     // ClusterSAH is direct-only: cluster to <= maxClusterSize primitives, then SAH over the clusters.
     const auto clusterSah = runClusterSAH(positions, /*maxClusterSize=*/8);
 
+    const auto ploc = runPLOC(positions);
+
     std::cout << std::left << std::setw(12) << "Strategy" << std::right << std::setw(16) << "TreeBVH (s)"
               << std::setw(16) << "+ pack() (s)" << std::setw(16) << "Total (s)" << std::setw(18) << "Direct build (s)"
               << "\n";
@@ -237,7 +260,12 @@ main()
                   << (a_result.treeBuildTime + a_result.packTime);
       }
 
-      std::cout << std::setw(18) << a_result.directBuildTime << "\n";
+      if (a_result.directBuildTime < 0.0) { // TreeBVH-only strategy: no direct constructor
+        std::cout << std::setw(18) << "--" << "\n";
+      }
+      else {
+        std::cout << std::setw(18) << a_result.directBuildTime << "\n";
+      }
     };
 
     printRow("TopDown", topDown);
@@ -247,6 +275,7 @@ main()
     printRow("Nested", nested);
     printRow("Hilbert", hilbert);
     printRow("ClusterSAH", clusterSah);
+    printRow("PLOC", ploc);
   }
 
   return 0;
@@ -17,9 +17,12 @@
 #include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <istream>
 #include <iterator>
 #include <limits>
 #include <memory>
+#include <ostream>
+#include <string>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -31,6 +34,7 @@
 // Our includes
 #include "EBGeometry_BoundingVolumes.hpp"
 #include "EBGeometry_Macros.hpp"
+#include "EBGeometry_Parallel.hpp"
 #include "EBGeometry_SFC.hpp"
 #include "EBGeometry_Vec.hpp"
 
@@ -49,9 +53,29 @@ enum class Build
   TopDown, ///< Recursive top-down partitioning.
   Morton,  ///< Bottom-up construction along a Morton space-filling curve.
   Nested,  ///< Bottom-up construction along a Nested space-filling curve.
-  SAH      ///< Recursive top-down with binned Surface Area Heuristic splitting. This is the recommended
+  SAH,     ///< Recursive top-down with binned Surface Area Heuristic splitting. This is the recommended
            ///< default: generally produces better-balanced trees and lower traversal cost than TopDown.
            ///< Use with BinnedSAHPartitioner. See BinnedSAHPartitioner for recommended K values per ISA.
+  PLOC,    ///< Bottom-up agglomerative clustering of Morton-ordered primitives (parallel locally-ordered
+           ///< clustering). Close to SAH quality at close to Morton build speed, and parallel. See
+           ///< TreeBVH::plocSortAndPartition().
+  SBVH     ///< Binned SAH that may also split space, clipping primitives that straddle the split plane into
+           ///< both children (spatial-split BVH). Tightest trees for meshes with long, thin faces, at the cost
+           ///< of slower builds and some primitives appearing in more than one leaf. Only for primitives with
+           ///< a clipper (mesh faces and triangles); CSG falls back to SAH. See
+           ///< TreeBVH::spatialSortAndPartition().
+};
+
+/**
+ * @brief Order of the nodes in a PackedBVH's node array. See PackedBVH::relayout().
+ * @details Every layout keeps the root at index zero and every child after its parent.
+ */
+enum class Layout
+{
+  DepthFirst,   ///< Depth-first pre-order, as built. A subtree is one contiguous range of nodes.
+  BreadthFirst, ///< Level by level, top to bottom. The top levels, which every query visits, share a few cache lines.
+  VanEmdeBoas   ///< Recursive blocking: the top half of the levels first, then each subtree below it, each laid out
+                ///< the same way. Any root-to-leaf path touches few blocks, whatever the cache line or page size.
 };
 
 /**
@@ -70,6 +94,250 @@ struct ClusterSpec
   size_t maxClusterSize = 8; ///< Maximum primitives per cluster (the leaf/bucket granularity). Must be > 0.
 };
 
+/**
+ * @brief Quality metrics of a PackedBVH, as computed by PackedBVH::computeMetrics().
+ * @details Costs are normalized by the surface area of the root, so trees over different geometries can be
+ * compared. The SAH cost is the expected cost of a query that reaches the root, with each interior node visited
+ * costing the traversal cost and each primitive tested the intersection cost. The effective parent overlap (EPO)
+ * is the fraction of that cost spent in nodes whose boxes overlap geometry outside their own subtree, which is what
+ * makes a query visit several branches; lower is better. Leaf boxes stand in for the geometry, since a PackedBVH
+ * does not know the shape of its primitives.
+ */
+struct TreeMetrics
+{
+  size_t              numNodes         = 0;   ///< Number of nodes, interior and leaf.
+  size_t              numInteriorNodes = 0;   ///< Number of interior nodes.
+  size_t              numLeaves        = 0;   ///< Number of leaves.
+  size_t              numPrimitives    = 0;   ///< Size of the primitive array.
+  size_t              numPaddedLeaves  = 0;   ///< Leaves repeating the primitive range of another leaf.
+  size_t              minLeafDepth     = 0;   ///< Depth of the shallowest leaf (the root is at depth zero).
+  size_t              maxLeafDepth     = 0;   ///< Depth of the deepest leaf.
+  double              meanLeafDepth    = 0.0; ///< Average leaf depth.
+  double              sahCost          = 0.0; ///< Surface area heuristic cost of the tree.
+  double              epo              = 0.0; ///< Effective parent overlap, between zero and one.
+  std::vector<size_t> leafFill;               ///< leafFill[n] is the number of leaves holding n primitives.
+};
+
+/**
+ * @brief Work done by PackedBVH traversals, accumulated over all threads.
+ * @details Only counted when EBGeometry is compiled with EBGEOMETRY_ENABLE_TRAVERSAL_STATISTICS; otherwise the
+ * counters stay zero and cost nothing. Every traverse(), pruneTraverse() and packetPruneTraverse() call adds its own
+ * counts once, on return, so resetting the counters around a single call gives the numbers for that call.
+ */
+struct TraversalStatistics
+{
+  uint64_t numTraversals       = 0; ///< Number of traversals.
+  uint64_t numNodesVisited     = 0; ///< Nodes that were not pruned, interior and leaf.
+  uint64_t numLeavesVisited    = 0; ///< Leaf evaluations (in a packet traversal, one per active lane).
+  uint64_t numPrimitivesTested = 0; ///< Primitives handed to the leaf evaluator.
+};
+
+/**
+ * @brief Get the traversal counters accumulated since the last resetTraversalStatistics().
+ * @return Snapshot of the counters.
+ */
+[[nodiscard]] inline TraversalStatistics
+getTraversalStatistics() noexcept;
+
+/**
+ * @brief Set all traversal counters to zero.
+ */
+inline void
+resetTraversalStatistics() noexcept;
+
+namespace Detail {
+
+/**
+ * @brief Per-call traversal counter that adds its counts to the global counters when it goes out of scope.
+ * @details Without EBGEOMETRY_ENABLE_TRAVERSAL_STATISTICS every member is empty and the counter compiles away.
+ */
+class TraversalCounter
+{
+public:
+  /**
+   * @brief Constructor.
+   */
+  TraversalCounter() noexcept = default;
+
+  /**
+   * @brief Copy constructor (deleted).
+   */
+  TraversalCounter(const TraversalCounter&) = delete;
+
+  /**
+   * @brief Copy assignment (deleted).
+   * @return Nothing.
+   */
+  TraversalCounter&
+  operator=(const TraversalCounter&) = delete;
+
+  /**
+   * @brief Destructor. Flushes the counts to the global counters.
+   */
+  inline ~TraversalCounter() noexcept;
+
+  /**
+   * @brief Count a node that was not pruned.
+   */
+  inline void
+  visitNode() noexcept;
+
+  /**
+   * @brief Count a leaf evaluation.
+   * @param[in] a_numPrimitives Number of primitives handed to the leaf evaluator.
+   */
+  inline void
+  visitLeaf(size_t a_numPrimitives) noexcept;
+
+#if defined(EBGEOMETRY_ENABLE_TRAVERSAL_STATISTICS)
+private:
+  /**
+   * @brief Nodes visited by this traversal.
+   */
+  uint64_t m_numNodes = 0;
+
+  /**
+   * @brief Leaves evaluated by this traversal.
+   */
+  uint64_t m_numLeaves = 0;
+
+  /**
+   * @brief Primitives tested by this traversal.
+   */
+  uint64_t m_numPrimitives = 0;
+#endif
+};
+
+/**
+ * @brief Fixed-size header at the start of a file written by PackedBVH::save().
+ * @details Everything after the header is located through the byte offsets stored in it, measured from the first
+ * byte of the header, so a reader never has to know how the sections were padded.
+ */
+struct SerializationHeader
+{
+  char     magic[8];         ///< Always SerializationMagic.
+  uint32_t version;          ///< Format version, SerializationVersion when written.
+  uint32_t endianTag;        ///< SerializationEndianTag in the byte order of the writer.
+  uint32_t precision;        ///< sizeof(T).
+  uint32_t branchingRatio;   ///< K.
+  uint32_t nodeSize;         ///< Bytes per node record.
+  uint32_t soaSize;          ///< Bytes per SoA child-box record.
+  uint32_t leafSize;         ///< Bytes per leaf record.
+  uint32_t reserved;         ///< Zero. Keeps the 64-bit fields below aligned.
+  uint32_t primitiveSize;    ///< sizeof of one stored primitive.
+  uint32_t primitiveAlign;   ///< alignof of one stored primitive.
+  uint64_t numNodes;         ///< Number of nodes.
+  uint64_t numInteriorNodes; ///< Number of interior nodes (and SoA records).
+  uint64_t numLeaves;        ///< Number of leaves (and leaf records).
+  uint64_t numPrimitives;    ///< Number of primitives.
+  uint64_t nodesOffset;      ///< Byte offset of the node records.
+  uint64_t soaOffset;        ///< Byte offset of the SoA child-box records.
+  uint64_t leavesOffset;     ///< Byte offset of the leaf records.
+  uint64_t primitivesOffset; ///< Byte offset of the primitives.
+  uint64_t size;             ///< Total number of bytes, header included.
+  double   rootLo[3];        ///< Low corner of the root's box.
+  double   rootHi[3];        ///< High corner of the root's box.
+};
+
+/**
+ * @brief On-disk record of one PackedBVH node: its reference and child indices, in that order. The node's box is
+ * in the SoA child-box record of its parent (or in the header, for the root).
+ * @tparam K Branching factor.
+ */
+template <size_t K>
+struct SerializedNode
+{
+  uint32_t ref;         ///< SoA record of an interior node, or leaf record (with the leaf flag set) of a leaf.
+  uint32_t childOff[K]; ///< Indices of the children of an interior node.
+};
+
+/**
+ * @brief On-disk record of one PackedBVH leaf: its primitive range.
+ */
+struct SerializedLeaf
+{
+  uint32_t primOff;  ///< First primitive of the leaf.
+  uint32_t numPrims; ///< Number of primitives of the leaf.
+};
+
+/**
+ * @brief Magic bytes that open every file written by PackedBVH::save().
+ */
+inline constexpr char SerializationMagic[8] = {'E', 'B', 'G', 'B', 'V', 'H', '\0', '\0'};
+
+/**
+ * @brief Reads as 0x01020304 only on a machine with the same byte order as the writer.
+ */
+inline constexpr uint32_t SerializationEndianTag = 0x01020304U;
+
+/**
+ * @brief Alignment (in bytes) of every section in a file written by PackedBVH::save().
+ */
+inline constexpr uint64_t SerializationAlignment = 64;
+
+} // namespace Detail
+
+/**
+ * @brief Version of the binary format written by PackedBVH::save(). Bumped whenever the layout changes.
+ */
+inline constexpr uint32_t SerializationVersion = 4;
+
+/**
+ * @brief Child index that marks an unused child slot of a PackedBVH interior node.
+ * @details Index 0 is the root, which is never a child, so it is free to mean "no child". An interior node has
+ * between 1 and K children in its leading slots; the slots after them hold EmptyChild.
+ */
+inline constexpr uint32_t EmptyChild = 0;
+
+/**
+ * @brief Smallest subtree (in primitives) that the top-down builders hand to another thread.
+ * @details Below this the work of a subtree no longer pays for a task, so it is built on the thread that split
+ * its parent. Only matters when the thread pool has more than one thread (see Parallel::setNumThreads()).
+ */
+inline constexpr size_t ParallelBuildThreshold = 4096;
+
+/**
+ * @brief Smallest split (in primitives) whose binned-SAH centroid box and bins are computed in parallel.
+ * @details Used by SAH2WaySplit(). Only the few splits at the top of a large build reach this size; below it, the
+ * split runs on the thread that owns the subtree.
+ */
+inline constexpr size_t ParallelBinningThreshold = 65536;
+
+/**
+ * @brief Smallest tree (in nodes) that PackedBVH::refit() refits in parallel.
+ * @details Only matters when the thread pool has more than one thread (see Parallel::setNumThreads()).
+ */
+inline constexpr size_t ParallelRefitThreshold = 16384;
+
+/**
+ * @brief Default PLOC search radius: how many neighbors on each side along the space-filling curve a cluster
+ * compares itself with when looking for its nearest neighbor.
+ * @details Larger radii find better merges (lower-cost trees) at a proportionally higher build cost; 16 is the
+ * usual sweet spot. See TreeBVH::plocSortAndPartition().
+ */
+inline constexpr size_t PLOCSearchRadius = 16;
+
+/**
+ * @brief Default spatial-split duplication budget, as a fraction of the number of primitives.
+ * @details A spatial split puts a primitive that straddles the split plane into both children. The total number
+ * of such extra references in a tree is capped at this fraction of the primitive count. See
+ * TreeBVH::spatialSortAndPartition().
+ */
+inline constexpr double SpatialSplitBudget = 0.5;
+
+/**
+ * @brief Default overlap threshold for trying a spatial split, relative to the surface area of the root.
+ * @details Spatial splits are only evaluated at nodes where the two children of the best object split overlap by
+ * more than this fraction of the root's surface area; elsewhere they rarely win and are not worth binning.
+ */
+inline constexpr double SpatialSplitOverlap = 1.E-5;
+
+/**
+ * @brief Default number of PackedBVH::optimize() sweeps over the tree.
+ * @details Every sweep restructures all treelets bottom-up; most of the cost reduction comes from the first two.
+ */
+inline constexpr size_t OptimizationPasses = 3;
+
 /**
  * @brief Returns the SIMD-optimal BVH branching factor for type T on the current target ISA.
  * @details Maps the floating-point type and the compile-time ISA to the K that fills one
@@ -278,6 +546,14 @@ struct ValueStorage
 template <class T, class P, size_t K, class StoragePolicy = SharedPtrStorage<P>>
 class PackedBVH;
 
+/**
+ * @brief Forward declaration of the compressed BVH, which is built from the node array of a PackedBVH.
+ * @details Q is the integer type of the quantized child boxes (uint8_t or uint16_t). See
+ * EBGeometry_QuantizedBVH.hpp.
+ */
+template <class T, class P, size_t K, class Q = uint8_t, class StoragePolicy = SharedPtrStorage<P>>
+class QuantizedBVH;
+
 /**
  * @brief Convenience alias for a (primitive, bounding-volume) pair.
  * @tparam P  Primitive type.
@@ -322,6 +598,19 @@ using Partitioner = std::function<std::array<PrimAndBVList<P, BV>, K>(PrimAndBVL
 template <class T, class P, class BV, size_t K>
 using LeafPredicate = std::function<bool(const TreeBVH<T, P, BV, K>& a_node)>;
 
+/**
+ * @brief Writes out the vertices of a planar, polygonal primitive (e.g. a triangle or a DCEL face), in order
+ * around the polygon.
+ * @details Spatial-split builds clip primitives to boxes, which they do through this polygon. Must be safe to
+ * call concurrently.
+ * @tparam T Floating-point precision.
+ * @tparam P Primitive type.
+ * @param[in]  a_primitive Primitive.
+ * @param[out] a_vertices  Vertices of the primitive (overwritten).
+ */
+template <class T, class P>
+using PrimitivePolygon = std::function<void(const P& a_primitive, std::vector<Vec3T<T>>& a_vertices)>;
+
 /**
  * @brief Leaf-evaluation callback for TreeBVH::traverse.
  * @details Called once for every leaf node visited during traversal.
@@ -340,18 +629,19 @@ using LeafEvaluator = std::function<void(const PrimitiveList<P>& a_primitives)>;
  * @tparam P             Primitive type.
  * @tparam StoragePolicy PackedBVH storage policy (default: SharedPtrStorage<P>, matching every
  * PackedBVH<T, P, K> that does not name a storage policy explicitly).
- * @param[in] a_primitives Global primitive array (element type StoragePolicy::StorageType).
+ * @param[in] a_primitives Start of the global primitive array (element type StoragePolicy::StorageType), valid for
+ * owned and mapped trees alike (see PackedBVH::getPrimitiveData()).
  * @param[in] a_offset     Index of the first primitive belonging to this leaf.
  * @param[in] a_count      Number of primitives in this leaf.
  */
 template <class P, class StoragePolicy = SharedPtrStorage<P>>
-using PackedLeafEvaluator = std::function<void(
-  const std::vector<typename StoragePolicy::StorageType>& a_primitives, size_t a_offset, size_t a_count)>;
+using PackedLeafEvaluator =
+  std::function<void(const typename StoragePolicy::StorageType* a_primitives, size_t a_offset, size_t a_count)>;
 
 /**
  * @brief Node-visit predicate for BVH traversal.
  * @details Must return true to descend into the node and false to prune it.
- * @tparam NodeType Node type (TreeBVH or PackedBVH::Node).
+ * @tparam NodeType Node type (TreeBVH or PackedBVH::NodeView).
  * @tparam NodeKey  Caller-supplied per-node key attached to each stack entry
  * (e.g. a running minimum distance).
  * @param[in] a_node Node under consideration.
@@ -389,7 +679,7 @@ using PackedChildOrderer = std::function<void(std::array<std::pair<uint32_t, Nod
  * @brief Node-key factory called once per node during BVH traversal.
  * @details Produces the NodeKey value that will be passed to PrunePredicate and ChildOrderer for
  * each child of the current node.
- * @tparam NodeType Node type (TreeBVH or PackedBVH::Node).
+ * @tparam NodeType Node type (TreeBVH or PackedBVH::NodeView).
  * @tparam NodeKey  Per-node key type to produce.
  * @param[in] a_node Current node.
  * @return NodeKey value for a_node's children.
@@ -533,15 +823,46 @@ SAH2WaySplit(PrimAndBVList<P, BV>& a_list,
 
   const size_t N = a_end - a_begin;
 
+  // Large splits (the top levels of a big build, where one split is a serial pass over millions of primitives)
+  // reduce the centroid box and the bins over chunks of the range in parallel, then merge the partial results.
+  // Min/max and counts come out exactly the same in any order, so the chosen plane matches the serial pass.
+  const size_t numChunks = (N >= ParallelBinningThreshold && Parallel::getNumThreads() > 1)
+                             ? std::min(N / (ParallelBinningThreshold / 4), size_t(4) * Parallel::getNumThreads())
+                             : 1;
+
+  const auto chunkBegin = [a_begin, N, numChunks](size_t a_chunk) noexcept -> size_t {
+    return a_begin + (N * a_chunk) / numChunks;
+  };
+
+  const auto centroidBounds = [&a_list](size_t a_lo, size_t a_hi, Vec3T<T>& a_clo, Vec3T<T>& a_chi) noexcept {
+    for (size_t i = a_lo; i < a_hi; i++) {
+      const auto& c = a_list[i].second.getCentroid();
+
+      a_clo = min(a_clo, c);
+      a_chi = max(a_chi, c);
+    }
+  };
+
   // Centroid bounding box
   Vec3T<T> clo = +Vec3T<T>::max();
   Vec3T<T> chi = -Vec3T<T>::max();
 
-  for (size_t i = a_begin; i < a_end; i++) {
-    const auto& c = a_list[i].second.getCentroid();
+  if (numChunks == 1) {
+    centroidBounds(a_begin, a_end, clo, chi);
+  }
+  else {
+    std::vector<std::pair<Vec3T<T>, Vec3T<T>>> partial(numChunks, {+Vec3T<T>::max(), -Vec3T<T>::max()});
 
-    clo = min(clo, c);
-    chi = max(chi, c);
+    Parallel::parallelFor(0, numChunks, 1, [&](size_t a_lo, size_t a_hi) noexcept {
+      for (size_t chunk = a_lo; chunk < a_hi; chunk++) {
+        centroidBounds(chunkBegin(chunk), chunkBegin(chunk + 1), partial[chunk].first, partial[chunk].second);
+      }
+    });
+
+    for (const auto& [plo, phi] : partial) {
+      clo = min(clo, plo);
+      chi = max(chi, phi);
+    }
   }
 
   T   bestCost  = std::numeric_limits<T>::max();
@@ -570,17 +891,51 @@ SAH2WaySplit(PrimAndBVList<P, BV>& a_list,
 
     const T scale = T(BINS) / ext;
 
-    for (int b = 0; b < BINS; b++) {
-      binLo[b]  = Vec3T<T>::max();
-      binHi[b]  = -Vec3T<T>::max();
-      binCnt[b] = 0;
+    const auto binRange = [&a_list, axis, lo, scale](
+                            size_t a_lo, size_t a_hi, Vec3T<T>* a_binLo, Vec3T<T>* a_binHi, int* a_binCnt) noexcept {
+      for (int b = 0; b < BINS; b++) {
+        a_binLo[b]  = Vec3T<T>::max();
+        a_binHi[b]  = -Vec3T<T>::max();
+        a_binCnt[b] = 0;
+      }
+
+      for (size_t i = a_lo; i < a_hi; i++) {
+        const int b = std::min(BINS - 1, (int)((a_list[i].second.getCentroid()[axis] - lo) * scale));
+        a_binLo[b]  = min(a_binLo[b], a_list[i].second.getLowCorner());
+        a_binHi[b]  = max(a_binHi[b], a_list[i].second.getHighCorner());
+        a_binCnt[b] = a_binCnt[b] + 1;
+      }
+    };
+
+    if (numChunks == 1) {
+      binRange(a_begin, a_end, binLo, binHi, binCnt);
     }
+    else {
+      std::vector<Vec3T<T>> partialLo(numChunks * BINS);
+      std::vector<Vec3T<T>> partialHi(numChunks * BINS);
+      std::vector<int>      partialCnt(numChunks * BINS);
+
+      Parallel::parallelFor(0, numChunks, 1, [&](size_t a_lo, size_t a_hi) noexcept {
+        for (size_t chunk = a_lo; chunk < a_hi; chunk++) {
+          binRange(chunkBegin(chunk),
+                   chunkBegin(chunk + 1),
+                   &partialLo[chunk * BINS],
+                   &partialHi[chunk * BINS],
+                   &partialCnt[chunk * BINS]);
+        }
+      });
+
+      for (int b = 0; b < BINS; b++) {
+        binLo[b]  = Vec3T<T>::max();
+        binHi[b]  = -Vec3T<T>::max();
+        binCnt[b] = 0;
 
-    for (size_t i = a_begin; i < a_end; i++) {
-      const int b = std::min(BINS - 1, (int)((a_list[i].second.getCentroid()[axis] - lo) * scale));
-      binLo[b]    = min(binLo[b], a_list[i].second.getLowCorner());
-      binHi[b]    = max(binHi[b], a_list[i].second.getHighCorner());
-      binCnt[b]   = binCnt[b] + 1;
+        for (size_t chunk = 0; chunk < numChunks; chunk++) {
+          binLo[b]  = min(binLo[b], partialLo[chunk * BINS + b]);
+          binHi[b]  = max(binHi[b], partialHi[chunk * BINS + b]);
+          binCnt[b] = binCnt[b] + partialCnt[chunk * BINS + b];
+        }
+      }
     }
 
     // Left prefix: accumulated AABB and count for bins [0..b]
@@ -868,6 +1223,89 @@ auto MidpointPartitioner = [](PrimAndBVList<P, BV> a_primsAndBVs) -> std::array<
   return result;
 };
 
+/**
+ * @brief Internal helper: split a planar polygon at an axis-aligned plane.
+ * @details One Sutherland-Hodgman step. Vertices created on the plane are snapped onto it, and vertices on the
+ * plane go to both sides.
+ * @tparam T Floating-point precision.
+ * @param[in]  a_polygon Polygon vertices, in order around the polygon.
+ * @param[in]  a_dir     Plane normal direction (0, 1 or 2).
+ * @param[in]  a_plane   Plane position along a_dir.
+ * @param[out] a_below   Part with x[a_dir] <= a_plane (overwritten), or nullptr if not wanted.
+ * @param[out] a_above   Part with x[a_dir] >= a_plane (overwritten), or nullptr if not wanted.
+ */
+template <class T>
+inline void
+splitPolygon(const std::vector<Vec3T<T>>& a_polygon,
+             const int                    a_dir,
+             const T                      a_plane,
+             std::vector<Vec3T<T>>*       a_below,
+             std::vector<Vec3T<T>>*       a_above);
+
+/**
+ * @brief Clip a planar polygon to a box.
+ * @details Clips against the six faces of the box in turn (Sutherland-Hodgman), skipping faces the polygon lies
+ * entirely inside of.
+ * @tparam T Floating-point precision.
+ * @param[in,out] a_polygon Polygon vertices, in order around the polygon. Empty on return if the polygon misses
+ * the box.
+ * @param[in]     a_box     Clipping box.
+ * @param[in,out] a_scratch Scratch space, so that repeated calls need not allocate.
+ */
+template <class T>
+inline void
+clipPolygonToBox(std::vector<Vec3T<T>>&           a_polygon,
+                 const BoundingVolumes::AABBT<T>& a_box,
+                 std::vector<Vec3T<T>>&           a_scratch);
+
+/**
+ * @brief Internal helper: bounding box of a polygon, intersected with a box that is known to contain it.
+ * @details The intersection only trims round-off from clipping.
+ * @tparam T Floating-point precision.
+ * @param[in] a_polygon Polygon vertices.
+ * @param[in] a_box     Box containing the polygon.
+ * @return Bounding box of the polygon, or @p a_box itself if the polygon is empty.
+ */
+template <class T>
+inline BoundingVolumes::AABBT<T>
+polygonBoundingBox(const std::vector<Vec3T<T>>& a_polygon, const BoundingVolumes::AABBT<T>& a_box) noexcept;
+
+/**
+ * @brief Internal helper: 2-way split that may also split space (the SBVH split).
+ * @details First finds the best binned-SAH object split (32 centroid bins per axis), exactly as SAH2WaySplit
+ * does. If the two sides of that split overlap by more than @p a_minOverlap in surface area, also bins the node's
+ * bounds into 16 slabs per axis, clipping every primitive to each slab it spans with @p a_clipper, and evaluates
+ * the planes between slabs. Each primitive is clipped to its bounding box once and then chopped into the slabs it
+ * spans, one plane at a time. A primitive that straddles the chosen spatial plane goes into both sides, each with
+ * the bounding box of its own part, unless moving it whole into one side is cheaper ("reference unsplitting").
+ * The spatial split is used when it is cheaper than the object split and straddles at most @p a_budget primitives.
+ *
+ * Only splits that leave at least @p a_minLeft primitives on the left and @p a_minRight on the right are
+ * considered; if no object split qualifies (e.g. all centroids coincide), the primitives are split around the
+ * median centroid instead.
+ * @tparam T Floating-point precision.
+ * @tparam P Primitive type.
+ * @param[in,out] a_list       Primitives and their bounding volumes. Consumed.
+ * @param[out]    a_left       Left side of the split.
+ * @param[out]    a_right      Right side of the split.
+ * @param[in]     a_minLeft    Fewest primitives the left side may get. Must be > 0.
+ * @param[in]     a_minRight   Fewest primitives the right side may get. Must be > 0.
+ * @param[in]     a_budget     Most primitives that may be put into both sides.
+ * @param[in]     a_minOverlap Overlap area between the object-split sides above which spatial splits are tried.
+ * @param[in]     a_polygon    Vertices of a primitive.
+ * @return Number of primitives that were put into both sides.
+ */
+template <class T, class P>
+inline size_t
+SpatialSAH2WaySplit(PrimAndBVList<P, BoundingVolumes::AABBT<T>>& a_list,
+                    PrimAndBVList<P, BoundingVolumes::AABBT<T>>& a_left,
+                    PrimAndBVList<P, BoundingVolumes::AABBT<T>>& a_right,
+                    const size_t                                 a_minLeft,
+                    const size_t                                 a_minRight,
+                    const size_t                                 a_budget,
+                    const T                                      a_minOverlap,
+                    const PrimitivePolygon<T, P>&                a_polygon);
+
 /**
  * @brief Default stop function: stop partitioning when the node holds fewer than K primitives.
  * @tparam T  Floating-point precision.
@@ -935,6 +1373,11 @@ public:
    */
   using LeafPredicate = BVH::LeafPredicate<T, P, BV, K>;
 
+  /**
+   * @brief Alias for the primitive-polygon callback used by spatialSortAndPartition().
+   */
+  using PrimitivePolygon = BVH::PrimitivePolygon<T, P>;
+
   /**
    * @brief Default constructor. Creates an empty interior node.
    */
@@ -999,7 +1442,10 @@ public:
 
   /**
    * @brief Recursively partition this node top-down.
-   * @details The stop criterion and partitioner determine the tree shape.
+   * @details The stop criterion and partitioner determine the tree shape. Subtrees with at least
+   * BVH::ParallelBuildThreshold primitives are partitioned concurrently on the thread pool, so both callables must
+   * be safe to call concurrently (all of EBGeometry's own partitioners and leaf predicates are). The resulting tree
+   * does not depend on the number of threads.
    * @param[in] a_partitioner Partitioning function. Divides a (primitive, BV) list into K sub-lists.
    * @param[in] a_stopCrit    Stop function. Returns true when a node should become a leaf.
    */
@@ -1018,6 +1464,50 @@ public:
   inline void
   bottomUpSortAndPartition();
 
+  /**
+   * @brief Partition this node bottom-up with PLOC (parallel locally-ordered clustering).
+   * @details Primitives are sorted along the space-filling curve S and start out as one cluster each. In every
+   * round, each cluster finds the cluster within @p a_searchRadius positions along the curve whose merged bounding
+   * volume has the smallest surface area; pairs that chose each other merge into a binary node, which takes the
+   * place of the left one of the pair. Rounds repeat until one cluster is left. Ties are broken by position, so
+   * every round merges at least one pair, and the neighbor searches and merges of a round run in parallel with a
+   * result that does not depend on the thread count.
+   *
+   * The binary tree is then collapsed into K-wide nodes top-down: starting from a node's two children, the child
+   * with the largest surface area is repeatedly replaced by its own two children until there are K. A subtree
+   * becomes a leaf once it holds at most @p a_maxLeafSize primitives, or fewer than K, which could not fill K
+   * children.
+   * @tparam S Space-filling curve type (e.g. SFC::Morton, SFC::Hilbert) that orders the initial clusters.
+   * @param[in] a_maxLeafSize  Largest subtree (in primitives) that is made into a leaf. Must be > 0.
+   * @param[in] a_searchRadius Neighbors on each side along the curve that a cluster searches. Must be > 0.
+   */
+  template <typename S = SFC::Morton>
+  inline void
+  plocSortAndPartition(size_t a_maxLeafSize = K - 1, size_t a_searchRadius = PLOCSearchRadius);
+
+  /**
+   * @brief Partition this node top-down with binned SAH, allowing spatial splits (SBVH).
+   * @details Like topDownSortAndPartition() with BinnedSAHPartitioner -- each node is split into K children by
+   * recursive 2-way splits -- but every 2-way split may also be a spatial split (see SpatialSAH2WaySplit()): a
+   * primitive that straddles the split plane is clipped at it and goes into both children, each bounding only its
+   * own part. This pays off for long, thin primitives whose boxes overlap heavily, which no
+   * object split can separate.
+   *
+   * A primitive that ends up in several leaves is still the whole primitive in each of them, so a traversal that
+   * reduces over leaf primitives (e.g. the minimum signed distance) gives the same answer as without duplication;
+   * only the bounding volumes are tighter. The number of extra references is capped at @p a_budget times the
+   * number of primitives, handed down the tree in proportion to the size of each subtree, so the tree does not
+   * depend on the number of threads.
+   * @note Requires BV == AABBT<T>.
+   * @param[in] a_polygon     Vertices of a primitive, which must be a planar polygon.
+   * @param[in] a_maxLeafSize Largest node (in primitive references) that is made into a leaf. Must be > 0.
+   * @param[in] a_budget      Most extra references, as a fraction of the number of primitives. Must be >= 0.
+   */
+  inline void
+  spatialSortAndPartition(const PrimitivePolygon& a_polygon,
+                          size_t                  a_maxLeafSize = K - 1,
+                          double                  a_budget      = SpatialSplitBudget);
+
   /**
    * @brief Return true if this is a leaf node (no children, non-empty primitive list).
    * @return True if this node holds primitives directly (i.e. is a leaf).
@@ -1027,7 +1517,8 @@ public:
 
   /**
    * @brief Return true if the tree has already been partitioned.
-   * @return True if topDownSortAndPartition() or bottomUpSortAndPartition() has been called.
+   * @return True if topDownSortAndPartition(), bottomUpSortAndPartition(), plocSortAndPartition() or
+   * spatialSortAndPartition() has been called.
    */
   [[nodiscard]] inline bool
   isPartitioned() const noexcept;
@@ -1229,9 +1720,14 @@ protected:
 
 /**
  * @brief Linearised, AABB-backed BVH with SIMD-accelerated traversal.
- * @details PackedBVH is the runtime query class. It stores a flat depth-first array of
- * Node structs, a contiguous primitive list, and a per-node SoA AABB cache that enables
- * SIMD child tests.
+ * @details PackedBVH is the runtime query class. It stores a flat array of compact Node structs, one SoA record
+ * per interior node holding the boxes of its children (which enables SIMD child tests), an array of Leaf primitive
+ * ranges, and a contiguous primitive list. Every box is stored once: in the SoA record of the node's parent, or,
+ * for the root, in the tree itself.
+ *
+ * The node array has one ordering contract: the root is at index 0, and every child comes after its
+ * parent. refit() and computeMetrics() rely on it, and load() rejects files that break it. The
+ * builders write depth-first pre-order; relayout() switches to another order that keeps the contract.
  *
  * Instances are obtained by calling TreeBVH::pack() (same primitive type) or
  * TreeBVH::packWith<Q>(converter) (type-converting pack).
@@ -1278,13 +1774,128 @@ public:
    */
   using StorageType = typename StoragePolicy::StorageType;
 
+  /**
+   * @brief Set in Node::m_ref of a leaf, whose reference is then an index into the leaf array.
+   */
+  static constexpr uint32_t s_leafFlag = 0x80000000U;
+
   /**
    * @brief Compact BVH node stored in the flat node array.
-   * @details Each node holds a bounding volume, a primitive range (leaves) or child
-   * index table (interior nodes). Exposed as a public nested type so that users can
-   * write traverse() callbacks (PrunePredicate, NodeKeyFactory) that inspect nodes.
+   * @details A node holds its child links and one reference: an interior node refers to its record in the SoA
+   * child-box cache, and a leaf (with s_leafFlag set) to its Leaf, which holds the primitive range. A node does not
+   * store its own bounding volume; that lives in the child-box record of its parent, and the box of the root in the
+   * tree itself, so every box is stored exactly once. traverse() reassembles the pieces into a NodeView for its
+   * callbacks.
+   *
+   * An interior node has between 1 and K children. They fill the leading child slots, and the remaining slots hold
+   * BVH::EmptyChild. See getNumChildren().
    */
   struct Node
+  {
+    /**
+     * @brief Index of the node's SoA child-box record (interior nodes), or of its Leaf with s_leafFlag set (leaves).
+     */
+    uint32_t m_ref{};
+
+    /**
+     * @brief Depth-first indices of the child nodes (interior nodes only). Unused slots hold BVH::EmptyChild.
+     */
+    std::array<uint32_t, K> m_childOff{};
+
+    /**
+     * @brief Set the depth-first index of the k-th child.
+     * @param[in] a_off Node index of the child.
+     * @param[in] a_k   Child slot (0 … K-1).
+     */
+    inline void
+    setChildOffset(uint32_t a_off, size_t a_k) noexcept
+    {
+      EBGEOMETRY_EXPECT(a_k < K);
+      m_childOff[a_k] = a_off;
+    }
+
+    /**
+     * @brief Get the index of this node's record in the SoA child-box cache (interior nodes only).
+     * @details Assigned in node-array order when the cache is built, so interior node j (in array order among
+     * the interior nodes) owns record j.
+     * @return Index of the SoA record holding the boxes of the K children.
+     */
+    [[nodiscard]] inline uint32_t
+    getChildBoxesIndex() const noexcept
+    {
+      return m_ref;
+    }
+
+    /**
+     * @brief Get the index of this node's Leaf (leaf nodes only).
+     * @return Index into the leaf array.
+     */
+    [[nodiscard]] inline uint32_t
+    getLeafIndex() const noexcept
+    {
+      return m_ref & ~s_leafFlag;
+    }
+
+    /**
+     * @brief Get the child index table.
+     * @return Reference to the K-element child-offset array.
+     */
+    [[nodiscard]] inline const std::array<uint32_t, K>&
+    getChildOffsets() const noexcept
+    {
+      return m_childOff;
+    }
+
+    /**
+     * @brief Get the number of children (interior nodes only): the number of leading child slots in use.
+     * @return Number of children, between 1 and K for an interior node.
+     */
+    [[nodiscard]] inline size_t
+    getNumChildren() const noexcept
+    {
+      size_t numChildren = 0;
+      while (numChildren < K && m_childOff[numChildren] != EmptyChild) {
+        numChildren++;
+      }
+
+      return numChildren;
+    }
+
+    /**
+     * @brief Return true if this is a leaf node.
+     * @return True if s_leafFlag is set in m_ref.
+     */
+    [[nodiscard]] inline bool
+    isLeaf() const noexcept
+    {
+      return (m_ref & s_leafFlag) != 0U;
+    }
+  };
+
+  /**
+   * @brief Leaf payload: a range in the primitive array. Kept apart from the nodes, which only refer to it.
+   */
+  struct Leaf
+  {
+    /**
+     * @brief Index of the first primitive.
+     */
+    uint32_t m_primOff;
+
+    /**
+     * @brief Number of primitives.
+     */
+    uint32_t m_numPrims;
+  };
+
+  /**
+   * @brief Complete description of one node: its bounding volume, its primitive range (leaves) and its children
+   * (interior nodes).
+   * @details PackedBVH stores this information split up (see Node). traverse() reassembles it for the nodes it
+   * hands to PrunePredicate and NodeKeyFactory callbacks, and the builders describe the tree with it before it is
+   * split into the compact arrays.
+   */
+  struct NodeView
   {
     /**
      * @brief Axis-aligned bounding box for this node's subtree.
@@ -1292,7 +1903,7 @@ public:
     BV m_bv{};
 
     /**
-     * @brief Index of the first primitive in the global primitive list (leaf nodes only).
+     * @brief Index of the first primitive in the global primitive list (leaf nodes).
      */
     uint32_t m_primOff{};
 
@@ -1302,7 +1913,7 @@ public:
     uint32_t m_numPrims{};
 
     /**
-     * @brief Depth-first indices of the K child nodes (interior nodes only).
+     * @brief Depth-first indices of the child nodes (interior nodes only). Unused slots hold BVH::EmptyChild.
      */
     std::array<uint32_t, K> m_childOff{};
 
@@ -1388,6 +1999,21 @@ public:
       return m_childOff;
     }
 
+    /**
+     * @brief Get the number of children (interior nodes only): the number of leading child slots in use.
+     * @return Number of children, between 1 and K for an interior node.
+     */
+    [[nodiscard]] inline size_t
+    getNumChildren() const noexcept
+    {
+      size_t numChildren = 0;
+      while (numChildren < K && m_childOff[numChildren] != EmptyChild) {
+        numChildren++;
+      }
+
+      return numChildren;
+    }
+
     /**
      * @brief Return true if this is a leaf node.
      * @return True if m_numPrims > 0 (leaf), false otherwise (interior).
@@ -1431,8 +2057,8 @@ public:
 
   /**
    * @brief Construct by packing a TreeBVH (identity primitive type).
-   * @details Walks the tree depth-first, fills m_linearNodes and m_primitives directly,
-   * then builds the SoA AABB cache. The source tree must have been built with
+   * @details Walks the tree depth-first, fills m_primitives directly and describes the nodes,
+   * then packs those into the node, SoA and leaf arrays. The source tree must have been built with
    * BV == AABBT<T>; bounding volumes are reused without conversion.
    * @param[in] a_tree Source tree.
    */
@@ -1481,12 +2107,17 @@ public:
    * TreeBVH::bottomUpSortAndPartition(), which derives a leaf count of K^floor(log_K(N)) purely
    * from N and K, this lets the caller control leaf size directly.
    *
-   * Because the resulting leaf count generally isn't a power of K, the K-ary merge pads up to the
-   * next power of K by re-using the last real leaf's index in place of a missing child -- so every
-   * interior node still has exactly K children (no change to Node's shape or to traverse()/
-   * pruneTraverse(), which assume this), at the cost of that one leaf's primitives potentially
-   * being visited more than once by a query in the (bounded, rare) case where the real leaf count
-   * isn't already a power of K. This never duplicates primitive data, only (cheap) Node entries.
+   * The leaves are merged bottom-up, K consecutive nodes of one level under one node of the level
+   * above. The leaf count generally isn't a power of K, so the last node of a level may have fewer
+   * than K children (see Node::getNumChildren()); nothing is padded, and no leaf is visited twice.
+   * A node that would get a single child is left out, and that child takes its place, so every
+   * interior node has at least two children.
+   *
+   * Every stage runs on the Parallel thread pool: centroid binning and encoding, the sort (a stable
+   * parallel radix sort, SFC::sortByCode()), leaf bounding volumes, and the node array itself.
+   * Since the tree's shape depends on the leaf count alone, each node's pre-order index is known
+   * in closed form and every level is written straight into place, with no serial merge. The
+   * result is identical for any thread count.
    *
    * @tparam S Space-filling curve type (e.g. SFC::Morton, SFC::Nested). Defaults to SFC::Morton;
    * a constructor template's own parameters cannot be explicitly specified the way a named
@@ -1509,9 +2140,9 @@ public:
    * BVCentroidPartitioner, BinnedSAHPartitioner, PrimitiveCentroidPartitioner, or any
    * caller-supplied one -- exactly as TreeBVH::topDownSortAndPartition() does, but writes nodes
    * directly into m_linearNodes in depth-first pre-order as the recursion unwinds, instead of
-   * building a persistent, shared_ptr<TreeBVH>-linked tree first. Unlike the SFC-build
-   * constructor above, no relayout pass is needed here: top-down recursion visits the root before
-   * its children, matching PackedBVH's "root at index 0" invariant for free.
+   * building a persistent, shared_ptr<TreeBVH>-linked tree first. No relayout pass is needed:
+   * top-down recursion visits the root before its children, matching PackedBVH's "root at index 0"
+   * invariant for free.
    *
    * This still shared_ptr-wraps each primitive once up front (needed to reuse the existing
    * Partitioner/LeafPredicate signatures, which operate on PrimAndBVList), and a lightweight,
@@ -1522,6 +2153,13 @@ public:
    * lifetime at every level -- measured as the dominant cost of the traditional
    * build-then-pack() path (see the "Direct construction" section of the Sphinx docs).
    *
+   * With more than one thread in the pool (see Parallel::setNumThreads()), the build is
+   * task-parallel: the children of every node with at least BVH::ParallelBuildThreshold primitives
+   * are built concurrently into separate node/primitive arrays, which are then stitched into the
+   * final pre-order array, and BinnedSAHPartitioner bins the largest splits in parallel (see
+   * BVH::ParallelBinningThreshold). The resulting PackedBVH is identical to the single-threaded
+   * build. Both callables must be safe to call concurrently; all of EBGeometry's own are.
+   *
    * @param[in] a_primsAndBVs Primitives and their bounding volumes, taken by value (a sink
    * parameter the caller can std::move in) -- never requires shared_ptr-wrapping by the caller,
    * regardless of this PackedBVH's StoragePolicy.
@@ -1543,7 +2181,8 @@ public:
    * soon as a bucket is small enough -- so buckets are spatially tight and follow the primitive
    * density (robust on surface/clustered data, where a fixed Cartesian grid would overcrowd); (2) run
    * binned SAH top-down over the @em buckets (their bounding boxes) to build the flat node array,
-   * with each leaf holding one or a few buckets' primitives. SAH thus partitions ~N/maxClusterSize
+   * with each leaf holding one bucket's primitives; a range of fewer than K buckets becomes a node
+   * with one child per bucket (see Node::getNumChildren()). SAH thus partitions ~N/maxClusterSize
    * boxes rather than all N primitives -- the source of the speedup. Requires BV == AABBT<T>;
    * enforced by static_assert at instantiation. Disambiguated from the SFC-build constructor by the
    * @c ClusterSpec parameter type.
@@ -1568,7 +2207,7 @@ public:
    * TreeBVH) and BVH::ValueStorage (primitives are copied by value -- safe as long as the
    * primitive type's own copy constructor is complete; see DCEL::FaceT's copy-constructor
    * documentation for a case where it deliberately is not, which is why MeshSDF never uses
-   * BVH::ValueStorage).
+   * BVH::ValueStorage). The copy of a mapped tree (see map()) shares the read-only mapping instead.
    * @param[in] a_other Other instance to copy.
    */
   PackedBVH(const PackedBVH& a_other) = default;
@@ -1599,6 +2238,9 @@ public:
 
   /**
    * @brief Get the global primitive list (in leaf-traversal order).
+   * @details Empty for a mapped tree (see map()), whose primitives are reached through getPrimitiveData(); calling
+   * this on a mapped tree prints a warning. Slots vacated by remove() stay in the list, unreferenced by any leaf,
+   * until compact().
    * @return Reference to m_primitives.
    */
   [[nodiscard]] inline const std::vector<StorageType>&
@@ -1631,19 +2273,22 @@ public:
    * (the root) paired with @p a_nodeKeyFactory applied to the root node. On each iteration:
    *
    * 1. Pop the back entry to obtain a (nodeIdx, nodeKey) pair.
-   * 2. Look up the node at m_linearNodes[nodeIdx].
+   * 2. Look up the node at m_linearNodes[nodeIdx] and reassemble it into a NodeView: its box from the SoA record of
+   * its parent (the entry remembers which record and slot), its primitive range from its Leaf.
    * 3. Call @p a_prunePredicate(node, nodeKey). If it returns false the entire subtree rooted at
    * that node is skipped (pruned) and the loop continues.
-   * 4. If the node is a leaf, call @p a_leafEvaluator with the global primitive list
-   * m_primitives, the leaf's primitive offset, and its primitive count. The leafEvaluator
-   * receives a view into the shared list rather than a freshly allocated sub-list,
-   * avoiding a heap allocation per leaf visit.
+   * 4. If the node is a leaf, call @p a_leafEvaluator with a pointer to the global primitive
+   * array (getPrimitiveData()), the leaf's primitive offset, and its primitive count. The
+   * leafEvaluator receives a view into the shared array rather than a freshly allocated
+   * sub-list, avoiding a heap allocation per leaf visit. The pointer is valid for owned and
+   * mapped trees (see map()) alike.
    * 5. If the node is an interior node:
-   * a. Collect the K child indices from node.getChildOffsets(), look each child up in
-   * m_linearNodes, and call @p a_nodeKeyFactory on each to produce a NodeKey value.
+   * a. Collect the child indices from node.getChildOffsets(), reassemble each child into a
+   * NodeView, and call @p a_nodeKeyFactory on each to produce a NodeKey value.
    * b. Bundle the K (childIdx, NodeKey) pairs into a local array and pass it to
-   * @p a_childOrderer, which reorders the array in-place.
-   * c. Push all K pairs onto the back of the stack in sorted order.
+   * @p a_childOrderer, which reorders the array in-place. Unused child slots of a node with fewer
+   * than K children enter the array as (BVH::EmptyChild, NodeKey{}).
+   * c. Push the pairs onto the back of the stack in sorted order, skipping unused slots.
    *
    * Because the stack is LIFO, the child pushed last is visited first. @p a_childOrderer
    * should therefore place the most promising child last in the array. For a
@@ -1652,7 +2297,7 @@ public:
    * sits at the back of the vector and is expanded next.
    *
    * @tparam NodeKey Auxiliary data type carried on the traversal stack (e.g. a running minimum distance).
-   * @param[in] a_leafEvaluator     Called at each leaf with the global primitive list, offset, and count.
+   * @param[in] a_leafEvaluator     Called at each leaf with the global primitive array, offset, and count.
    * @param[in] a_prunePredicate     Called at each node; return true to descend, false to prune.
    * @param[in] a_childOrderer      Reorders the K (childIdx, NodeKey) pairs in-place before they are
    * pushed; the last element after sorting is visited first.
@@ -1662,9 +2307,9 @@ public:
   template <class NodeKey>
   inline void
   traverse(const BVH::PackedLeafEvaluator<P, StoragePolicy>& a_leafEvaluator,
-           const BVH::PrunePredicate<Node, NodeKey>&         a_prunePredicate,
+           const BVH::PrunePredicate<NodeView, NodeKey>&     a_prunePredicate,
            const BVH::PackedChildOrderer<NodeKey, K>&        a_childOrderer,
-           const BVH::NodeKeyFactory<Node, NodeKey>&         a_nodeKeyFactory) const noexcept;
+           const BVH::NodeKeyFactory<NodeView, NodeKey>&     a_nodeKeyFactory) const noexcept;
 
   /**
    * @brief Generic SIMD-accelerated, distance-pruned traversal.
@@ -1709,16 +2354,54 @@ public:
                 LeafEvaluator&&    a_evalLeaf,
                 PruneDistSquared&& a_pruneDist2) const noexcept;
 
+  /**
+   * @brief Packet variant of pruneTraverse(): carries a group of query points through the tree together.
+   * @details Intended for spatially coherent query groups (e.g. a 4x4x4 block of grid cell centres) whose
+   * individual traversals would walk almost the same nodes. The packet shares one traversal stack, so each node
+   * and its SoA child boxes are fetched once per packet rather than once per point, and every stack entry carries
+   * an active-lane mask: a lane is dropped from a subtree as soon as that subtree's box lies beyond the lane's own
+   * pruning bound, and a node is skipped once no lane remains active. Children are visited nearest-first with
+   * respect to the nearest active lane.
+   *
+   * Per-lane pruning is exactly as strict as in pruneTraverse() (a lane only ever visits nodes within its own
+   * bound, re-read fresh at every node), so for a nearest-primitive search each lane finds the same minimum as an
+   * independent pruneTraverse() call; only the visiting order, and hence the winner among exact ties, may differ.
+   * Incoherent packets remain correct but degrade towards the cost of the union of the individual traversals.
+   *
+   * @tparam State            Per-lane running search state.
+   * @tparam LeafEvaluator    Callable: (State&, size_t lane, size_t offset, size_t count) noexcept -> void.
+   * Scans primitives [offset, offset+count) for query point a_points[lane] and updates that lane's state.
+   * @tparam PruneDistSquared Callable: (const State&) noexcept -> T. Squared pruning bound of one lane.
+   * @param[in]     a_points     Query points, one per lane.
+   * @param[in,out] a_states     Per-lane search states (a_numPoints entries).
+   * @param[in]     a_numPoints  Number of lanes in the packet; at most s_maxPacketSize.
+   * @param[in]     a_evalLeaf   Leaf-visit callback.
+   * @param[in]     a_pruneDist2 Pruning-bound callback.
+   */
+  template <class State, class LeafEvaluator, class PruneDistSquared>
+  inline void
+  packetPruneTraverse(const Vec3T<T>*    a_points,
+                      State*             a_states,
+                      std::size_t        a_numPoints,
+                      LeafEvaluator&&    a_evalLeaf,
+                      PruneDistSquared&& a_pruneDist2) const noexcept;
+
+  /**
+   * @brief Maximum number of lanes in one packetPruneTraverse() packet (the width of its active-lane mask).
+   */
+  static constexpr std::size_t s_maxPacketSize = 64;
+
   /**
    * @brief Refit every node's bounding volume in place after the primitives have moved.
    * @details The flat-array counterpart of TreeBVH::refit(): keeps the node array, the primitive
    * array, and every leaf's primitive range exactly as they are, recomputing only the bounding
-   * volumes. Because m_linearNodes is a depth-first pre-order flattening (root at index 0, every
-   * child at a higher index than its parent), a single reverse sweep over the array refits children
-   * before parents with no recursion or explicit stack: each leaf's box becomes the union of its
-   * primitives' boxes (recomputed via @p a_bvConstructor), and each interior node's box the union of
-   * its K children's freshly-refitted boxes. The per-node SoA AABB cache used by the SIMD traversal
-   * is rebuilt at the end, so pruneTraverse() stays consistent.
+   * volumes. Because of the node-array ordering contract (root at index 0, every child at a higher
+   * index than its parent, whatever the layout), a single reverse sweep over the array refits children
+   * before parents with no recursion or explicit stack: at each interior node, the box of a leaf
+   * child becomes the union of its primitives' boxes (recomputed via @p a_bvConstructor), and the box
+   * of an interior child the union of that child's freshly-refitted child boxes. Boxes are written
+   * straight into the node's SoA record -- the only place they are stored -- so pruneTraverse() stays
+   * consistent without a second pass over the tree.
    *
    * Same use and caveats as TreeBVH::refit(): cheap per-frame maintenance for a geometry whose
    * primitives shift without migrating between leaves, and not a substitute for a rebuild once a
@@ -1726,6 +2409,11 @@ public:
    * (drawn from the primitive array via the storage policy) and must return its current bounding
    * volume.
    *
+   * Trees with at least BVH::ParallelRefitThreshold nodes are refitted on the Parallel thread pool: the top levels
+   * are cut into a few subtrees per thread, which are refitted concurrently, and the nodes above the cut are
+   * refitted last. Every box is computed exactly as in the serial sweep, so the result does not depend on the
+   * thread count, but @p a_bvConstructor must then be safe to call concurrently.
+   *
    * @tparam BVConstructor Callable: (const P&) -> BV, returning one primitive's current bounding volume.
    * @param[in] a_bvConstructor Bounding-volume constructor for a single primitive.
    */
@@ -1733,24 +2421,287 @@ public:
   inline void
   refit(const BVConstructor& a_bvConstructor);
 
+  /**
+   * @brief Refit only the leaves holding the given primitives, and their ancestors.
+   * @details For a geometry where few primitives move per step. The leaves are found through a primitive-to-leaf
+   * map and the ancestors through a parent map, both built on the first call (about four bytes per node and eight
+   * per primitive) and kept until the tree structure changes. The cost is then proportional to the number of
+   * changed primitives times the tree depth, instead of the size of the tree. The leaves are refitted on the
+   * Parallel thread pool, so @p a_bvConstructor must be safe to call concurrently.
+   *
+   * The result is the same as that of a full refit() if the other primitives have not moved.
+   * @tparam BVConstructor Callable: (const P&) -> BV, returning one primitive's current bounding volume.
+   * @param[in] a_primitives    Indices in the primitive array (see getPrimitives()) of the primitives that moved.
+   * Duplicates are allowed.
+   * @param[in] a_bvConstructor Bounding-volume constructor for a single primitive.
+   */
+  template <class BVConstructor>
+  inline void
+  refit(const std::vector<uint32_t>& a_primitives, const BVConstructor& a_bvConstructor);
+
+  /**
+   * @brief Insert one primitive without rebuilding the tree.
+   * @details The primitive is appended to the primitive array and gets a leaf of its own. The insertion point is
+   * found by a greedy descent from the root on the increase in surface area (the SAH cost), in the manner of the
+   * dynamic BVHs used for collision detection: an interior node with a free child slot takes the new leaf directly
+   * unless a child absorbs it more cheaply, a full node passes it on to the cheapest child, and a leaf reached this
+   * way becomes an interior node over itself and the new leaf. Only the boxes and SoA child-box records on that
+   * path are updated. New nodes are appended to the node array, which keeps the node-array ordering contract.
+   *
+   * If the new leaf ends up deeper than twice the depth of a balanced tree over the same number of primitives
+   * (plus two), the smallest subtree on its path whose rebuild brings it back within bounds is rebuilt: its leaves
+   * are kept, and the interior nodes above them are replaced by a balanced tree from centroid splits. This bounds
+   * the depth, and with it the fixed-size traversal stacks, however the primitives arrive. Insertions degrade the
+   * SAH cost of the tree slowly; call optimize() now and then, or rebuild after large changes.
+   * @param[in] a_primitive Primitive to insert.
+   * @param[in] a_bv        Bounding volume of the primitive.
+   */
+  inline void
+  insert(StorageType a_primitive, const BV& a_bv);
+
+  /**
+   * @brief Remove one primitive without rebuilding the tree.
+   * @details The primitive is looked up in the leaves whose boxes overlap @p a_bv, so @p a_bv must bound it as
+   * the tree does: the box it was built or inserted with, or the one computed by the last refit(). Every
+   * reference there for which @p a_match returns true is swapped to the end of its leaf's range, and the range is
+   * shortened. All of them are removed because an SBVH build (spatialSortAndPartition()) can put one primitive in
+   * several leaves, each with a clipped box that overlaps the primitive's box without containing it. @p a_match
+   * should therefore identify a single primitive.
+   *
+   * A leaf that loses its last primitive is detached from its parent, as is any ancestor left without children.
+   * An interior node left with one child is replaced by that child, so interior nodes keep at least two children
+   * (the root is replaced by its child as well). The boxes and SoA records above are shrunk to the remaining
+   * children. Leaf boxes are not shrunk, since the tree does not store a box per primitive; the next refit()
+   * tightens them.
+   *
+   * Detached nodes and vacated primitive slots stay in their arrays, unreachable, until compact() squeezes them
+   * out. That happens automatically once they make up half of either array, so the arrays never grow beyond twice
+   * their live size. A removal that would leave the tree without primitives is refused.
+   * @tparam Match Callable: (const P&) -> bool, true for the primitive to remove.
+   * @param[in] a_bv    Bounding volume of the primitive, as held by the tree.
+   * @param[in] a_match Predicate that identifies the primitive.
+   * @return True if a primitive was removed, false if none matched or it was the last one.
+   */
+  template <class Match>
+  inline bool
+  remove(const BV& a_bv, const Match& a_match);
+
+  /**
+   * @brief Squeeze the nodes and primitive slots left behind by remove() and insert() out of the arrays.
+   * @details Re-emits the reachable nodes in depth-first pre-order, rewrites the primitive array in leaf order and
+   * drops the SoA and leaf records of detached nodes. Called automatically by remove() and insert() once half of either
+   * array is garbage. computeMetrics(), save() and QuantizedBVH work on a compacted copy if there is any garbage, and
+   * optimize() compacts first. Node and primitive indices change, so visit counts from recordVisits() must be recorded
+   * again afterwards.
+   */
+  inline void
+  compact();
+
+  /**
+   * @brief Compute quality metrics of the tree: SAH cost, effective parent overlap, leaf depths and fill.
+   * @details A diagnostic, not meant for hot paths: the EPO needs one overlap query per node, which is run in
+   * parallel on the Parallel thread pool. The result does not depend on the thread count. See TreeMetrics.
+   * @param[in] a_traversalCost    SAH cost of visiting one interior node.
+   * @param[in] a_intersectionCost SAH cost of testing one primitive.
+   * @return The metrics.
+   */
+  [[nodiscard]] inline TreeMetrics
+  computeMetrics(double a_traversalCost = 1.0, double a_intersectionCost = 1.0) const;
+
+  /**
+   * @brief Compute the SAH cost of the tree on its own.
+   * @details Same value as TreeMetrics::sahCost, from one sweep over the node array and without the EPO queries, so
+   * it is cheap enough to call after every refit() (see DeformingBVH). Nodes detached by remove() count as zero.
+   * @param[in] a_traversalCost    SAH cost of visiting one interior node.
+   * @param[in] a_intersectionCost SAH cost of testing one primitive.
+   * @return The SAH cost, relative to the surface area of the root.
+   */
+  [[nodiscard]] inline double
+  computeSAHCost(double a_traversalCost = 1.0, double a_intersectionCost = 1.0) const noexcept;
+
+  /**
+   * @brief Lower the SAH cost of the tree by restructuring small treelets in place.
+   * @details A post-build pass for trees from the fast builders (Morton, Nested, ClusterSAH) and for trees that
+   * have been refitted many times. It is the K-ary counterpart of tree rotations and treelet restructuring: the
+   * treelet of an interior node is the node, its K children and their children. The node's subtrees at those two
+   * levels are exchanged greedily -- a grandchild with a grandchild under another child, or a child with a
+   * grandchild under another child -- as long as an exchange lowers the summed surface area of the children.
+   * Leaves, their primitive ranges and the primitive array are never touched, and neither is the bounding volume
+   * of the node itself, so only the treelet's own children change. Exchanges that would make the tree deeper are
+   * not taken, which keeps the fixed-size traversal stacks safe.
+   *
+   * Treelets are visited bottom-up. Those at the same depth are disjoint and are restructured in parallel on the
+   * Parallel thread pool; the result does not depend on the thread count. Each sweep ends by re-emitting the node
+   * array in depth-first pre-order along with its SoA and leaf records, so the tree is immediately usable for
+   * traversal. Sweeps stop early once one of them changes nothing. Call relayout() afterwards for another layout.
+   * @param[in] a_numPasses Maximum number of sweeps over the tree.
+   */
+  inline void
+  optimize(size_t a_numPasses = OptimizationPasses);
+
+  /**
+   * @brief Reorder the node array, and the SoA child-box and leaf records with it, into another layout.
+   * @details Only the order changes: the tree, the leaves' primitive ranges and the primitive array are the same,
+   * so every query gives the same result. A large tree that does not fit in L2 takes fewer cache misses per query
+   * when the nodes a query visits together lie together, which depth-first order only achieves for the lower
+   * levels. See Layout.
+   * @param[in] a_layout New layout.
+   */
+  inline void
+  relayout(Layout a_layout);
+
+  /**
+   * @brief Reorder the node array by how often sample queries visited each node, most visited first.
+   * @details Nodes are emitted one at a time, always the most visited node whose parent has been emitted, so
+   * the order keeps the node-array ordering contract. A node is visited at most as often as its parent, so the
+   * counts decrease along the array, and the nodes the sample queries touched end up packed at its front. Nodes
+   * never visited follow in depth-first pre-order.
+   * @param[in] a_visits Visit count of each node, indexed by its current position, e.g. from recordVisits().
+   */
+  inline void
+  relayout(const std::vector<uint64_t>& a_visits);
+
+  /**
+   * @brief Run one pruneTraverse() query and count the nodes it visits.
+   * @details Visits the same nodes as pruneTraverse() with the same arguments, without the SIMD box test. Counts
+   * accumulate into @p a_visits, which is first resized to the number of nodes if it is smaller. Running a sample
+   * of queries through this gives the input to relayout(const std::vector<uint64_t>&).
+   * @param[in,out] a_visits     Visit count of each node, indexed by its position in the node array.
+   * @param[in]     a_point      Query point.
+   * @param[in,out] a_state      Running search state, as for pruneTraverse().
+   * @param[in]     a_evalLeaf   Leaf-visit callback, as for pruneTraverse().
+   * @param[in]     a_pruneDist2 Pruning-bound callback, as for pruneTraverse().
+   */
+  template <class State, class LeafEvaluator, class PruneDistSquared>
+  inline void
+  recordVisits(std::vector<uint64_t>& a_visits,
+               const Vec3T<T>&        a_point,
+               State&                 a_state,
+               LeafEvaluator&&        a_evalLeaf,
+               PruneDistSquared&&     a_pruneDist2) const;
+
+  /**
+   * @brief Write the tree to a binary stream, so it can be loaded again without a rebuild.
+   * @details Writes a Detail::SerializationHeader (which holds the root's box) followed by the node array, the SoA
+   * child-box records, the leaf records and the primitive array, each as one contiguous block aligned to
+   * Detail::SerializationAlignment bytes relative to the start of the header. The format is versioned
+   * (SerializationVersion) and tagged with the byte order, precision, branching factor and record sizes of the writer;
+   * load() refuses files that do not match. Primitives are written as raw bytes, so this requires BVH::ValueStorage
+   * over a trivially copyable primitive (e.g. TriangleAoSoA or PointAoSoA); a SharedPtrStorage tree has nothing that
+   * could be written meaningfully.
+   * @param[in,out] a_stream Binary output stream.
+   * @return True on success, false (with a message on std::cerr) if the stream failed.
+   */
+  inline bool
+  save(std::ostream& a_stream) const;
+
+  /**
+   * @brief Write the tree to a binary file. See save(std::ostream&).
+   * @param[in] a_filename File name. An existing file is overwritten.
+   * @return True on success, false (with a message on std::cerr) otherwise.
+   */
+  inline bool
+  save(const std::string& a_filename) const;
+
+  /**
+   * @brief Read a tree written by save().
+   * @details A bulk read of the four arrays: nothing is rebuilt, not even the SoA child-box records. The node
+   * indices and primitive ranges are checked in one linear pass, so a truncated or corrupt file is reported
+   * rather than traversed. The header is checked against the length of the stream before anything is allocated.
+   * @param[in,out] a_stream Binary input stream, positioned at the header. Must be seekable.
+   * @return The tree, or nullptr (with a message on std::cerr) if the stream does not hold a compatible tree.
+   */
+  [[nodiscard]] static inline std::shared_ptr<PackedBVH>
+  load(std::istream& a_stream);
+
+  /**
+   * @brief Read a tree from a binary file written by save(). See load(std::istream&).
+   * @param[in] a_filename File name.
+   * @return The tree, or nullptr (with a message on std::cerr) on failure.
+   */
+  [[nodiscard]] static inline std::shared_ptr<PackedBVH>
+  load(const std::string& a_filename);
+
+  /**
+   * @brief Map a file written by save() into memory and query the tree in place, without copying it.
+   * @details The file is mapped read-only and shared (POSIX mmap with MAP_SHARED), so every process that maps the
+   * same file -- e.g. all MPI ranks on a node -- shares one physical copy of the tree through the page cache. A file
+   * in /dev/shm is a POSIX shared-memory segment on Linux and can be mapped the same way. The file format is
+   * position-independent (children and primitive ranges are array indices, sections are located by offsets in the
+   * header), so nothing is fixed up after mapping. The node records are read once when mapping, to check them as
+   * load() does; the child bounding boxes and the primitives are only paged in when a traversal first touches them.
+   *
+   * The returned tree is read-only: traversal, computeMetrics() and save() work as usual, but refit() and
+   * optimize() refuse to run, and getPrimitives() is empty -- use getPrimitiveData() instead. The mapping is
+   * released when the last copy of the tree goes away. On platforms without mmap this falls back to load().
+   * @param[in] a_filename File name.
+   * @return The tree, or nullptr (with a message on std::cerr) on failure.
+   */
+  [[nodiscard]] static inline std::shared_ptr<PackedBVH>
+  map(const std::string& a_filename);
+
+  /**
+   * @brief Query a tree written by save() in place in a caller-provided buffer, without copying it.
+   * @details The lower-level counterpart of map() for memory that the caller obtained itself, e.g. a POSIX or MPI
+   * shared-memory window filled by one rank. The buffer must start at the header and be aligned to
+   * Detail::SerializationAlignment bytes; it is not copied, so it must outlive the returned tree unless
+   * @p a_owner keeps it alive. The same read-only restrictions as for map() apply.
+   * @param[in] a_data  Start of the serialized tree.
+   * @param[in] a_size  Size of the buffer in bytes.
+   * @param[in] a_owner Optional owner of the buffer, held by the tree (and its copies) until they are destroyed.
+   * @return The tree, or nullptr (with a message on std::cerr) if the buffer does not hold a compatible tree.
+   */
+  [[nodiscard]] static inline std::shared_ptr<PackedBVH>
+  view(const void* a_data, size_t a_size, std::shared_ptr<const void> a_owner = nullptr);
+
+  /**
+   * @brief Check whether the tree lives in memory it does not own (see map() and view()).
+   * @return True for a mapped or viewed tree, false for a tree that owns its arrays.
+   */
+  [[nodiscard]] inline bool
+  isMapped() const noexcept;
+
+  /**
+   * @brief Get a pointer to the primitives in leaf-traversal order, for owned and mapped trees alike.
+   * @return Pointer to getNumPrimitives() primitives.
+   */
+  [[nodiscard]] inline const StorageType*
+  getPrimitiveData() const noexcept;
+
+  /**
+   * @brief Get the number of primitives in the tree.
+   * @details Counts the slots of the primitive array, including those vacated by remove() until compact().
+   * @return Number of primitives.
+   */
+  [[nodiscard]] inline size_t
+  getNumPrimitives() const noexcept;
+
 protected:
   /**
-   * @brief Adopt pre-built node and primitive arrays, then finalize the SoA child-AABB layout.
+   * @brief QuantizedBVH compresses the node array directly.
+   */
+  template <class, class, size_t, class, class>
+  friend class QuantizedBVH;
+
+  /**
+   * @brief Adopt a pre-built node description and primitive array, and pack them into the compact arrays.
    * @details Not part of the public API. It exists so a specialized builder in a derived class (e.g.
    * PointCloudBVH, which fills the arrays with its own index-based build) can construct the packed
    * representation directly, without going through a TreeBVH or a PrimAndBVList. The node array must
-   * be a valid depth-first pre-order flattening (root at index 0) referencing @p a_primitives.
-   * @param[in] a_linearNodes Flattened node array (moved in).
-   * @param[in] a_primitives  Global primitive list in leaf-traversal order (moved in).
+   * keep the node-array ordering contract (root at index 0, children after parents) and reference
+   * @p a_primitives.
+   * @param[in] a_nodes      Node descriptions, in node-array order.
+   * @param[in] a_primitives Global primitive list in leaf-traversal order (moved in).
    */
-  inline PackedBVH(std::vector<Node>&& a_linearNodes, std::vector<StorageType>&& a_primitives) noexcept
-    : m_linearNodes(std::move(a_linearNodes)), m_primitives(std::move(a_primitives))
+  inline PackedBVH(const std::vector<NodeView>& a_nodes, std::vector<StorageType>&& a_primitives)
+    : m_primitives(std::move(a_primitives))
   {
-    this->buildSoA();
+    this->packNodes(a_nodes);
   }
 
   /**
-   * @brief Flat depth-first node array.
+   * @brief Flat node array: root at index 0, every child after its parent. Depth-first pre-order unless relayout()
+   * was called.
    */
   std::vector<Node> m_linearNodes;
 
@@ -1779,16 +2730,334 @@ protected:
   };
 
   /**
-   * @brief Per-node SoA AABB cache used by the SIMD traversal in pruneTraverse().
+   * @brief SoA child-box records, one per interior node, indexed by Node::getChildBoxesIndex(). This is where the
+   * boxes of all nodes but the root live; pruneTraverse() tests them K at a time.
    */
   std::vector<ChildAABBSoA> m_childAabbSoA;
 
   /**
-   * @brief Populate m_childAabbSoA from the completed m_linearNodes array.
-   * @details Called at the end of every constructor after m_linearNodes is fully built.
+   * @brief Primitive ranges of the leaves, indexed by Node::getLeafIndex().
+   */
+  std::vector<Leaf> m_leaves;
+
+  /**
+   * @brief Bounding volume of the root, the one node without a parent record to hold it.
+   */
+  BV m_bv{Vec3T<T>::zeros(), Vec3T<T>::zeros()};
+
+  /**
+   * @brief Adopt complete node, primitive, SoA child-box and leaf arrays, as read by load().
+   * @param[in] a_linearNodes  Flattened node array (moved in).
+   * @param[in] a_primitives   Global primitive list in leaf-traversal order (moved in).
+   * @param[in] a_childAabbSoA SoA child-box records matching @p a_linearNodes (moved in).
+   * @param[in] a_leaves       Leaf records matching @p a_linearNodes (moved in).
+   * @param[in] a_bv           Bounding volume of the root.
+   */
+  inline PackedBVH(std::vector<Node>&&         a_linearNodes,
+                   std::vector<StorageType>&&  a_primitives,
+                   std::vector<ChildAABBSoA>&& a_childAabbSoA,
+                   std::vector<Leaf>&&         a_leaves,
+                   const BV&                   a_bv) noexcept
+    : m_linearNodes(std::move(a_linearNodes)),
+      m_primitives(std::move(a_primitives)),
+      m_childAabbSoA(std::move(a_childAabbSoA)),
+      m_leaves(std::move(a_leaves)),
+      m_bv(a_bv)
+  {}
+
+  /**
+   * @brief Split complete node descriptions into m_linearNodes, m_childAabbSoA, m_leaves and m_bv.
+   * @details Called at the end of every constructor. Numbers the interior nodes and the leaves in array order, and
+   * writes the box of every child into the SoA record of its parent.
+   * @param[in] a_nodes Node descriptions, in node-array order.
    */
   inline void
-  buildSoA();
+  packNodes(const std::vector<NodeView>& a_nodes);
+
+  /**
+   * @brief Reassemble the description of every node, the inverse of packNodes().
+   * @details Nodes detached by remove() or insert() get a point box at the origin.
+   * @return One NodeView per node, in node-array order.
+   */
+  [[nodiscard]] inline std::vector<NodeView>
+  getNodeViews() const;
+
+  /**
+   * @brief Get the bounding volume of every node, in node-array order. Detached nodes get a point box at the origin.
+   * @return Bounding volumes.
+   */
+  [[nodiscard]] inline std::vector<BV>
+  getNodeBoundingVolumes() const;
+
+  /**
+   * @brief Reassemble the description of one node.
+   * @param[in] a_node Node.
+   * @param[in] a_bv   Bounding volume of the node, read from its parent's SoA record.
+   * @return Description of the node.
+   */
+  [[nodiscard]] inline NodeView
+  getNodeView(const Node& a_node, const BV& a_bv) const noexcept;
+
+  /**
+   * @brief Get the box of the k-th child from an SoA child-box record.
+   * @param[in] a_record SoA record index. Must belong to an interior node.
+   * @param[in] a_k      Child slot. Must be in use.
+   * @return Bounding volume of the child.
+   */
+  [[nodiscard]] inline BV
+  getChildBoundingVolume(uint32_t a_record, size_t a_k) const noexcept;
+
+  /**
+   * @brief Get the union of the boxes of an interior node's children, which is the box of the node.
+   * @param[in] a_node Interior node with at least one child.
+   * @return Bounding volume of the node.
+   */
+  [[nodiscard]] inline BV
+  getChildrenBoundingVolume(const Node& a_node) const noexcept;
+
+  /**
+   * @brief Write the box of the k-th child into an SoA child-box record.
+   * @param[in] a_record SoA record index.
+   * @param[in] a_k      Child slot.
+   * @param[in] a_bv     Bounding volume of the child.
+   */
+  inline void
+  setChildBoundingVolume(uint32_t a_record, size_t a_k, const BV& a_bv) noexcept;
+
+  /**
+   * @brief Mark the k-th slot of an SoA child-box record unused: an inverted, infinitely far box, which the SIMD
+   * box test puts at infinite distance.
+   * @param[in] a_record SoA record index.
+   * @param[in] a_k      Child slot.
+   */
+  inline void
+  clearChildBoundingVolume(uint32_t a_record, size_t a_k) noexcept;
+
+  /**
+   * @brief Find the child slot of a node that holds a given child.
+   * @param[in] a_node  Interior node.
+   * @param[in] a_child Index of one of its children.
+   * @return Child slot.
+   */
+  [[nodiscard]] static inline size_t
+  getChildSlot(const Node& a_node, uint32_t a_child) noexcept;
+
+  /**
+   * @brief Get the node order of a layout.
+   * @details Only follows child links from the root, so the current order of the node array does not matter.
+   * @param[in] a_layout Layout.
+   * @return Current indices of the nodes, in the order of @p a_layout.
+   */
+  [[nodiscard]] inline std::vector<uint32_t>
+  getNodeOrder(Layout a_layout) const;
+
+  /**
+   * @brief Move the nodes into a new order and rewrite the child indices. The SoA records and leaf records are
+   * renumbered into the same order, and those of detached nodes dropped.
+   * @param[in] a_order Current indices of the nodes, in their new order. Must be a permutation with parents before
+   * children.
+   */
+  inline void
+  reorderNodes(const std::vector<uint32_t>& a_order);
+
+  /**
+   * @brief Number of nodes detached by remove() or replaced by a subtree rebuild in insert(), awaiting compact().
+   * @details Such nodes are unreachable and hold a deadNode(): an interior node without children. Their SoA and
+   * leaf records are dropped by compact().
+   */
+  size_t m_numDeadNodes = 0;
+
+  /**
+   * @brief Number of primitive slots vacated by remove(), awaiting compact().
+   */
+  size_t m_numDeadPrimitives = 0;
+
+  /**
+   * @brief Check for garbage left by remove() or insert().
+   * @return True if the arrays hold dead nodes or vacated primitive slots.
+   */
+  [[nodiscard]] inline bool
+  hasGarbage() const noexcept;
+
+  /**
+   * @brief Call compact() once dead nodes or vacated primitive slots make up half of their array.
+   */
+  inline void
+  collectGarbage();
+
+  /**
+   * @brief Replace the interior nodes of a subtree by a balanced tree over its leaves.
+   * @details The subtree root keeps its index, and everything below it is appended to the node array in
+   * depth-first pre-order; the old nodes below the root become garbage. Each interior node splits its leaves into
+   * at most K equal groups along the longest axis of their centroids, so the subtree is ceil(log_K(leaves)) deep.
+   * @param[in] a_root Index of the subtree root. Must be an interior node.
+   */
+  inline void
+  rebuildSubtree(uint32_t a_root);
+
+  /**
+   * @brief Node that remove() and rebuildSubtree() leave behind: interior, without children, and unreachable.
+   * @return The dead node.
+   */
+  [[nodiscard]] inline static Node
+  deadNode() noexcept;
+
+  /**
+   * @brief Recompute the SoA child-box record of one interior node: leaf children from their primitives, interior
+   * children from their own records.
+   * @tparam BVConstructor Callable: (const P&) -> BV.
+   * @param[in]    a_index         Node index. Must be an interior node whose interior children are up to date.
+   * @param[in]    a_bvConstructor Bounding-volume constructor for a single primitive.
+   * @param[in]    a_refitLeaves   Whether to recompute the boxes of leaf children too, or keep them.
+   * @param[inout] a_scratch       Scratch space, reused between calls.
+   */
+  template <class BVConstructor>
+  inline void
+  refitNode(size_t               a_index,
+            const BVConstructor& a_bvConstructor,
+            bool                 a_refitLeaves,
+            std::vector<BV>&     a_scratch);
+
+  /**
+   * @brief Compute the box of a leaf from its primitives.
+   * @tparam BVConstructor Callable: (const P&) -> BV.
+   * @param[in]    a_node          Leaf node.
+   * @param[in]    a_bvConstructor Bounding-volume constructor for a single primitive.
+   * @param[inout] a_scratch       Scratch space, reused between calls.
+   * @return Bounding volume of the leaf.
+   */
+  template <class BVConstructor>
+  [[nodiscard]] inline BV
+  computeLeafBoundingVolume(const Node& a_node, const BVConstructor& a_bvConstructor, std::vector<BV>& a_scratch) const;
+
+  /**
+   * @brief Build the parent and primitive-to-leaf maps used by the partial refit().
+   */
+  inline void
+  buildParentIndices();
+
+  /**
+   * @brief Parent of every node, NoParent for the root and for dead nodes. Empty until the partial refit() needs
+   * it, and cleared whenever the tree structure changes.
+   */
+  std::vector<uint32_t> m_parentIndices;
+
+  /**
+   * @brief Offsets into m_primitiveLeaves, one per primitive plus one. Built along with m_parentIndices.
+   */
+  std::vector<uint32_t> m_primitiveLeafOffsets;
+
+  /**
+   * @brief Leaves holding each primitive, in the ranges given by m_primitiveLeafOffsets. A leaf that repeats the
+   * range of another leaf makes a primitive appear in both.
+   */
+  std::vector<uint32_t> m_primitiveLeaves;
+
+  /**
+   * @brief Parent index of the root.
+   */
+  static constexpr uint32_t NoParent = std::numeric_limits<uint32_t>::max();
+
+  /**
+   * @brief Arrays of a mapped tree, pointing into the memory held by m_mapping.
+   */
+  struct MappedArrays
+  {
+    const Node*         nodes            = nullptr; ///< Node array.
+    const ChildAABBSoA* childAabbSoA     = nullptr; ///< SoA child-box records.
+    const Leaf*         leaves           = nullptr; ///< Leaf records.
+    const StorageType*  primitives       = nullptr; ///< Primitive array.
+    size_t              numNodes         = 0;       ///< Number of nodes.
+    size_t              numInteriorNodes = 0;       ///< Number of interior nodes (and SoA records).
+    size_t              numLeaves        = 0;       ///< Number of leaves (and leaf records).
+    size_t              numPrimitives    = 0;       ///< Number of primitives.
+  };
+
+  /**
+   * @brief Keeps the memory of a mapped tree alive. Null for a tree that owns its arrays.
+   */
+  std::shared_ptr<const void> m_mapping;
+
+  /**
+   * @brief Arrays of a mapped tree. Only used when m_mapping is set.
+   */
+  MappedArrays m_mapped;
+
+  /**
+   * @brief Get the node array, owned or mapped.
+   * @return Pointer to getNumNodes() nodes.
+   */
+  [[nodiscard]] inline const Node*
+  getNodeData() const noexcept;
+
+  /**
+   * @brief Get the SoA child-box cache, owned or mapped.
+   * @return Pointer to getNumInteriorNodes() records.
+   */
+  [[nodiscard]] inline const ChildAABBSoA*
+  getChildAabbData() const noexcept;
+
+  /**
+   * @brief Get the leaf records, owned or mapped.
+   * @return Pointer to getNumLeaves() records.
+   */
+  [[nodiscard]] inline const Leaf*
+  getLeafData() const noexcept;
+
+  /**
+   * @brief Get the number of leaf records, owned or mapped.
+   * @return Number of leaf records.
+   */
+  [[nodiscard]] inline size_t
+  getNumLeaves() const noexcept;
+
+  /**
+   * @brief Get the number of interior nodes, which is also the number of SoA child-box records.
+   * @return Number of interior nodes.
+   */
+  [[nodiscard]] inline size_t
+  getNumInteriorNodes() const noexcept;
+
+  /**
+   * @brief Get the number of nodes, owned or mapped.
+   * @return Number of nodes.
+   */
+  [[nodiscard]] inline size_t
+  getNumNodes() const noexcept;
+
+  /**
+   * @brief Check the header of a serialized tree against this instantiation.
+   * @param[in] a_header Header to check.
+   * @param[in] a_caller Name printed in error messages.
+   * @return True if the header describes a tree this instantiation can read, false (with a message on std::cerr)
+   * otherwise.
+   */
+  static inline bool
+  checkHeader(const Detail::SerializationHeader& a_header, const char* a_caller);
+
+  /**
+   * @brief Check the node and leaf records of a serialized tree: children come after their parent, interior nodes
+   * reference existing SoA records with valid boxes in their used slots, leaves reference existing leaf records, and
+   * those existing primitives.
+   * @param[in] a_records          Node records.
+   * @param[in] a_childAabbSoA     SoA child-box records.
+   * @param[in] a_leaves           Leaf records.
+   * @param[in] a_numNodes         Number of node records.
+   * @param[in] a_numInteriorNodes Number of SoA child-box records.
+   * @param[in] a_numLeaves        Number of leaf records.
+   * @param[in] a_numPrimitives    Number of primitives.
+   * @param[in] a_caller           Name printed in error messages.
+   * @return True if all records are valid, false (with a message on std::cerr) otherwise.
+   */
+  static inline bool
+  checkNodes(const Detail::SerializedNode<K>* a_records,
+             const ChildAABBSoA*              a_childAabbSoA,
+             const Detail::SerializedLeaf*    a_leaves,
+             size_t                           a_numNodes,
+             size_t                           a_numInteriorNodes,
+             size_t                           a_numLeaves,
+             size_t                           a_numPrimitives,
+             const char*                      a_caller);
 };
 
 } // namespace BVH
@@ -14,26 +14,610 @@
 // Std includes
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <fstream>
 #include <functional>
+#include <iostream>
 #include <limits>
+#include <map>
 #include <memory>
+#include <numeric>
+#include <queue>
 #include <stack>
 #include <tuple>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 // Our includes
 #include "EBGeometry_BVH.hpp"
 #include "EBGeometry_BoundingVolumes.hpp"
+#include "EBGeometry_Parallel.hpp"
 
 namespace EBGeometry {
 
 namespace BVH {
 
+namespace Detail {
+
+/**
+ * @brief The global traversal counters.
+ * @return Reference to the counters.
+ */
+inline std::array<std::atomic<uint64_t>, 4>&
+traversalCounters() noexcept
+{
+  static std::array<std::atomic<uint64_t>, 4> counters{};
+
+  return counters;
+}
+
+inline TraversalCounter::~TraversalCounter() noexcept
+{
+#if defined(EBGEOMETRY_ENABLE_TRAVERSAL_STATISTICS)
+  auto& counters = traversalCounters();
+
+  counters[0].fetch_add(1, std::memory_order_relaxed);
+  counters[1].fetch_add(m_numNodes, std::memory_order_relaxed);
+  counters[2].fetch_add(m_numLeaves, std::memory_order_relaxed);
+  counters[3].fetch_add(m_numPrimitives, std::memory_order_relaxed);
+#endif
+}
+
+inline void
+TraversalCounter::visitNode() noexcept
+{
+#if defined(EBGEOMETRY_ENABLE_TRAVERSAL_STATISTICS)
+  m_numNodes++;
+#endif
+}
+
+inline void
+TraversalCounter::visitLeaf([[maybe_unused]] size_t a_numPrimitives) noexcept
+{
+#if defined(EBGEOMETRY_ENABLE_TRAVERSAL_STATISTICS)
+  m_numLeaves++;
+  m_numPrimitives += a_numPrimitives;
+#endif
+}
+
+} // namespace Detail
+
+inline TraversalStatistics
+getTraversalStatistics() noexcept
+{
+  const auto& counters = Detail::traversalCounters();
+
+  TraversalStatistics stats;
+
+  stats.numTraversals       = counters[0].load();
+  stats.numNodesVisited     = counters[1].load();
+  stats.numLeavesVisited    = counters[2].load();
+  stats.numPrimitivesTested = counters[3].load();
+
+  return stats;
+}
+
+inline void
+resetTraversalStatistics() noexcept
+{
+  for (auto& counter : Detail::traversalCounters()) {
+    counter.store(0);
+  }
+}
+
+template <class T>
+inline void
+splitPolygon(const std::vector<Vec3T<T>>& a_polygon,
+             const int                    a_dir,
+             const T                      a_plane,
+             std::vector<Vec3T<T>>*       a_below,
+             std::vector<Vec3T<T>>*       a_above)
+{
+  if (a_below != nullptr) {
+    a_below->clear();
+  }
+  if (a_above != nullptr) {
+    a_above->clear();
+  }
+
+  const size_t n = a_polygon.size();
+
+  for (size_t i = 0; i < n; i++) {
+    const Vec3T<T>& a = a_polygon[i];
+    const Vec3T<T>& b = a_polygon[(i + 1 == n) ? 0 : i + 1];
+
+    if (a_below != nullptr && a[a_dir] <= a_plane) {
+      a_below->emplace_back(a);
+    }
+    if (a_above != nullptr && a[a_dir] >= a_plane) {
+      a_above->emplace_back(a);
+    }
+
+    if ((a[a_dir] < a_plane && b[a_dir] > a_plane) || (a[a_dir] > a_plane && b[a_dir] < a_plane)) {
+      const T t = (a_plane - a[a_dir]) / (b[a_dir] - a[a_dir]);
+
+      Vec3T<T> x = a + t * (b - a);
+      x[a_dir]   = a_plane;
+
+      if (a_below != nullptr) {
+        a_below->emplace_back(x);
+      }
+      if (a_above != nullptr) {
+        a_above->emplace_back(x);
+      }
+    }
+  }
+}
+
+template <class T>
+inline void
+clipPolygonToBox(std::vector<Vec3T<T>>&           a_polygon,
+                 const BoundingVolumes::AABBT<T>& a_box,
+                 std::vector<Vec3T<T>>&           a_scratch)
+{
+  for (int dir = 0; dir < 3 && !a_polygon.empty(); dir++) {
+    const T lo = a_box.getLowCorner()[dir];
+    const T hi = a_box.getHighCorner()[dir];
+
+    if (std::any_of(a_polygon.begin(), a_polygon.end(), [dir, lo](const Vec3T<T>& x) { return x[dir] < lo; })) {
+      splitPolygon<T>(a_polygon, dir, lo, nullptr, &a_scratch);
+      std::swap(a_polygon, a_scratch);
+    }
+    if (std::any_of(a_polygon.begin(), a_polygon.end(), [dir, hi](const Vec3T<T>& x) { return x[dir] > hi; })) {
+      splitPolygon<T>(a_polygon, dir, hi, &a_scratch, nullptr);
+      std::swap(a_polygon, a_scratch);
+    }
+  }
+}
+
+template <class T>
+inline BoundingVolumes::AABBT<T>
+polygonBoundingBox(const std::vector<Vec3T<T>>& a_polygon, const BoundingVolumes::AABBT<T>& a_box) noexcept
+{
+  // An empty polygon can only come out of clipping through round-off, in which case the box itself is a valid (if
+  // loose) bound.
+  if (a_polygon.empty()) {
+    return a_box;
+  }
+
+  Vec3T<T> lo = Vec3T<T>::max();
+  Vec3T<T> hi = -Vec3T<T>::max();
+
+  for (const auto& x : a_polygon) {
+    lo = min(lo, x);
+    hi = max(hi, x);
+  }
+
+  return BoundingVolumes::AABBT<T>(max(lo, a_box.getLowCorner()), min(hi, a_box.getHighCorner()));
+}
+
+template <class T, class P>
+inline size_t
+SpatialSAH2WaySplit(PrimAndBVList<P, BoundingVolumes::AABBT<T>>& a_list,
+                    PrimAndBVList<P, BoundingVolumes::AABBT<T>>& a_left,
+                    PrimAndBVList<P, BoundingVolumes::AABBT<T>>& a_right,
+                    const size_t                                 a_minLeft,
+                    const size_t                                 a_minRight,
+                    const size_t                                 a_budget,
+                    const T                                      a_minOverlap,
+                    const PrimitivePolygon<T, P>&                a_polygon)
+{
+  using BV   = BoundingVolumes::AABBT<T>;
+  using Vec3 = Vec3T<T>;
+
+  // Spatial binning chops every primitive into each slab it spans on all three axes; 16 slabs find splits as good as
+  // 32 at half the cost.
+  constexpr int BINS  = 32;
+  constexpr int SLABS = 16;
+
+  const size_t N = a_list.size();
+
+  EBGEOMETRY_EXPECT(a_minLeft > 0);
+  EBGEOMETRY_EXPECT(a_minRight > 0);
+  EBGEOMETRY_EXPECT(N >= a_minLeft + a_minRight);
+
+  // Surface area of the box [lo, hi], zero if it is empty.
+  const auto area = [](const Vec3& a_lo, const Vec3& a_hi) noexcept -> T {
+    const Vec3 d = a_hi - a_lo;
+
+    return (d[0] < T(0) || d[1] < T(0) || d[2] < T(0)) ? T(0) : T(2) * (d[0] * d[1] + d[1] * d[2] + d[2] * d[0]);
+  };
+
+  Vec3 nodeLo = Vec3::max();
+  Vec3 nodeHi = -Vec3::max();
+  Vec3 clo    = Vec3::max();
+  Vec3 chi    = -Vec3::max();
+
+  for (const auto& pbv : a_list) {
+    nodeLo = min(nodeLo, pbv.second.getLowCorner());
+    nodeHi = max(nodeHi, pbv.second.getHighCorner());
+    clo    = min(clo, pbv.second.getCentroid());
+    chi    = max(chi, pbv.second.getCentroid());
+  }
+
+  Vec3 binLo[BINS];
+  Vec3 binHi[BINS];
+
+  size_t binCnt[BINS];
+
+  Vec3   prefixLo[BINS - 1];
+  Vec3   prefixHi[BINS - 1];
+  size_t prefixCnt[BINS - 1];
+
+  // Object split. Primitives are sent left or right by the same bin arithmetic that counted them, so the split
+  // has exactly the counts it was chosen for.
+  T    objectCost = std::numeric_limits<T>::max();
+  int  objectAxis = -1;
+  int  objectBin  = 0;
+  Vec3 objectLeftLo;
+  Vec3 objectLeftHi;
+  Vec3 objectRightLo;
+  Vec3 objectRightHi;
+
+  const auto centroidBin = [&clo, &chi](const BV& a_bv, const int a_axis) noexcept -> int {
+    const T scale = T(BINS) / (chi[a_axis] - clo[a_axis]);
+
+    return std::min(BINS - 1, (int)((a_bv.getCentroid()[a_axis] - clo[a_axis]) * scale));
+  };
+
+  for (int axis = 0; axis < 3; axis++) {
+    if (chi[axis] - clo[axis] <= T(0)) {
+      continue;
+    }
+
+    for (int b = 0; b < BINS; b++) {
+      binLo[b]  = Vec3::max();
+      binHi[b]  = -Vec3::max();
+      binCnt[b] = 0;
+    }
+
+    for (const auto& pbv : a_list) {
+      const int b = centroidBin(pbv.second, axis);
+
+      binLo[b] = min(binLo[b], pbv.second.getLowCorner());
+      binHi[b] = max(binHi[b], pbv.second.getHighCorner());
+      binCnt[b]++;
+    }
+
+    Vec3   lo  = Vec3::max();
+    Vec3   hi  = -Vec3::max();
+    size_t cnt = 0;
+
+    for (int b = 0; b < BINS - 1; b++) {
+      lo  = min(lo, binLo[b]);
+      hi  = max(hi, binHi[b]);
+      cnt = cnt + binCnt[b];
+
+      prefixLo[b]  = lo;
+      prefixHi[b]  = hi;
+      prefixCnt[b] = cnt;
+    }
+
+    lo  = Vec3::max();
+    hi  = -Vec3::max();
+    cnt = 0;
+
+    for (int b = BINS - 1; b >= 1; b--) {
+      lo  = min(lo, binLo[b]);
+      hi  = max(hi, binHi[b]);
+      cnt = cnt + binCnt[b];
+
+      if (prefixCnt[b - 1] >= a_minLeft && cnt >= a_minRight) {
+        const T cost = area(prefixLo[b - 1], prefixHi[b - 1]) * T(prefixCnt[b - 1]) + area(lo, hi) * T(cnt);
+
+        if (cost < objectCost) {
+          objectCost    = cost;
+          objectAxis    = axis;
+          objectBin     = b;
+          objectLeftLo  = prefixLo[b - 1];
+          objectLeftHi  = prefixHi[b - 1];
+          objectRightLo = lo;
+          objectRightHi = hi;
+        }
+      }
+    }
+  }
+
+  // Spatial split, only where the object split leaves the two sides overlapping.
+  T   spatialCost = std::numeric_limits<T>::max();
+  int spatialAxis = -1;
+  int spatialBin  = 0;
+
+  const bool trySpatial = a_budget > 0 && (objectAxis < 0 || area(max(objectLeftLo, objectRightLo),
+                                                                   min(objectLeftHi, objectRightHi)) > a_minOverlap);
+
+  // Slab b along an axis is [slabBoundary(axis, b), slabBoundary(axis, b + 1)].
+  const auto slabBoundary = [&nodeLo, &nodeHi](const int a_axis, const int a_bin) noexcept -> T {
+    return (a_bin == SLABS) ? nodeHi[a_axis]
+                            : nodeLo[a_axis] + (nodeHi[a_axis] - nodeLo[a_axis]) * T(a_bin) / T(SLABS);
+  };
+
+  const auto slabOf = [&nodeLo, &nodeHi](const T a_x, const int a_axis) noexcept -> int {
+    const T scale = T(SLABS) / (nodeHi[a_axis] - nodeLo[a_axis]);
+
+    return std::max(0, std::min(SLABS - 1, (int)((a_x - nodeLo[a_axis]) * scale)));
+  };
+
+  // The part of a primitive inside a_box, left in polygon. The other buffers are scratch space for chopping it.
+  std::vector<Vec3> polygon;
+  std::vector<Vec3> scratch;
+  std::vector<Vec3> rest;
+  std::vector<Vec3> below;
+  std::vector<Vec3> above;
+
+  const auto clip = [&a_polygon, &polygon, &scratch](const P& a_prim, const BV& a_box) {
+    a_polygon(a_prim, polygon);
+    clipPolygonToBox(polygon, a_box, scratch);
+  };
+
+  Vec3   slabLo[3][SLABS];
+  Vec3   slabHi[3][SLABS];
+  size_t slabEnter[3][SLABS];
+  size_t slabExit[3][SLABS];
+
+  const auto growSlab = [&slabLo, &slabHi](const int a_axis, const int a_bin, const BV& a_bv) noexcept {
+    slabLo[a_axis][a_bin] = min(slabLo[a_axis][a_bin], a_bv.getLowCorner());
+    slabHi[a_axis][a_bin] = max(slabHi[a_axis][a_bin], a_bv.getHighCorner());
+  };
+
+  if (trySpatial) {
+    for (int axis = 0; axis < 3; axis++) {
+      for (int b = 0; b < SLABS; b++) {
+        slabLo[axis][b]    = Vec3::max();
+        slabHi[axis][b]    = -Vec3::max();
+        slabEnter[axis][b] = 0;
+        slabExit[axis][b]  = 0;
+      }
+    }
+
+    for (const auto& pbv : a_list) {
+      const BV& box = pbv.second;
+
+      bool clipped = false;
+
+      for (int axis = 0; axis < 3; axis++) {
+        if (nodeHi[axis] - nodeLo[axis] <= T(0)) {
+          continue;
+        }
+
+        const int first = slabOf(box.getLowCorner()[axis], axis);
+        const int last  = slabOf(box.getHighCorner()[axis], axis);
+
+        slabEnter[axis][first]++;
+        slabExit[axis][last]++;
+
+        if (first == last) {
+          growSlab(axis, first, box);
+
+          continue;
+        }
+
+        // Chop the primitive into the slabs it spans: the part below each slab boundary goes into the slab, and
+        // the rest is carried on to the next one.
+        if (!clipped) {
+          clip(*pbv.first, box);
+
+          clipped = true;
+        }
+
+        rest = polygon;
+
+        for (int b = first; b < last; b++) {
+          const T plane = slabBoundary(axis, b + 1);
+
+          Vec3 partLo  = box.getLowCorner();
+          Vec3 partHi  = box.getHighCorner();
+          partLo[axis] = std::max(partLo[axis], slabBoundary(axis, b));
+          partHi[axis] = std::min(partHi[axis], plane);
+
+          splitPolygon(rest, axis, plane, &below, &above);
+          std::swap(rest, above);
+
+          growSlab(axis, b, polygonBoundingBox(below, BV(partLo, partHi)));
+        }
+
+        Vec3 partLo  = box.getLowCorner();
+        partLo[axis] = std::max(partLo[axis], slabBoundary(axis, last));
+
+        growSlab(axis, last, polygonBoundingBox(rest, BV(partLo, box.getHighCorner())));
+      }
+    }
+  }
+
+  for (int axis = 0; trySpatial && axis < 3; axis++) {
+    if (nodeHi[axis] - nodeLo[axis] <= T(0)) {
+      continue;
+    }
+
+    Vec3   lo  = Vec3::max();
+    Vec3   hi  = -Vec3::max();
+    size_t cnt = 0;
+
+    for (int b = 0; b < SLABS - 1; b++) {
+      lo  = min(lo, slabLo[axis][b]);
+      hi  = max(hi, slabHi[axis][b]);
+      cnt = cnt + slabEnter[axis][b];
+
+      prefixLo[b]  = lo;
+      prefixHi[b]  = hi;
+      prefixCnt[b] = cnt;
+    }
+
+    lo  = Vec3::max();
+    hi  = -Vec3::max();
+    cnt = 0;
+
+    for (int b = SLABS - 1; b >= 1; b--) {
+      lo  = min(lo, slabLo[axis][b]);
+      hi  = max(hi, slabHi[axis][b]);
+      cnt = cnt + slabExit[axis][b];
+
+      const size_t numLeft      = prefixCnt[b - 1];
+      const size_t numStraddled = numLeft + cnt - N;
+
+      if (numLeft >= a_minLeft && cnt >= a_minRight && numStraddled <= a_budget) {
+        const T cost = area(prefixLo[b - 1], prefixHi[b - 1]) * T(numLeft) + area(lo, hi) * T(cnt);
+
+        if (cost < spatialCost) {
+          spatialCost = cost;
+          spatialAxis = axis;
+          spatialBin  = b;
+        }
+      }
+    }
+  }
+
+  a_left.clear();
+  a_right.clear();
+
+  if (spatialAxis >= 0 && spatialCost < objectCost) {
+    const int axis  = spatialAxis;
+    const T   plane = slabBoundary(axis, spatialBin);
+
+    struct Straddler
+    {
+      size_t index;
+      BV     leftPart;
+      BV     rightPart;
+    };
+
+    std::vector<Straddler> straddlers;
+
+    Vec3 leftLo  = Vec3::max();
+    Vec3 leftHi  = -Vec3::max();
+    Vec3 rightLo = Vec3::max();
+    Vec3 rightHi = -Vec3::max();
+
+    for (size_t i = 0; i < N; i++) {
+      const BV& box = a_list[i].second;
+
+      if (slabOf(box.getHighCorner()[axis], axis) < spatialBin) {
+        leftLo = min(leftLo, box.getLowCorner());
+        leftHi = max(leftHi, box.getHighCorner());
+
+        a_left.emplace_back(std::move(a_list[i]));
+      }
+      else if (slabOf(box.getLowCorner()[axis], axis) >= spatialBin) {
+        rightLo = min(rightLo, box.getLowCorner());
+        rightHi = max(rightHi, box.getHighCorner());
+
+        a_right.emplace_back(std::move(a_list[i]));
+      }
+      else {
+        Vec3 splitLo = box.getLowCorner();
+        Vec3 splitHi = box.getHighCorner();
+
+        splitLo[axis] = std::min(splitHi[axis], plane);
+        splitHi[axis] = std::max(box.getLowCorner()[axis], plane);
+
+        clip(*a_list[i].first, box);
+        splitPolygon(polygon, axis, plane, &below, &above);
+
+        const BV leftPart  = polygonBoundingBox(below, BV(box.getLowCorner(), splitHi));
+        const BV rightPart = polygonBoundingBox(above, BV(splitLo, box.getHighCorner()));
+
+        leftLo  = min(leftLo, leftPart.getLowCorner());
+        leftHi  = max(leftHi, leftPart.getHighCorner());
+        rightLo = min(rightLo, rightPart.getLowCorner());
+        rightHi = max(rightHi, rightPart.getHighCorner());
+
+        straddlers.push_back({i, leftPart, rightPart});
+      }
+    }
+
+    // Reference unsplitting: a straddler goes whole into one side if that is cheaper than splitting it.
+    size_t numLeft       = a_left.size() + straddlers.size();
+    size_t numRight      = a_right.size() + straddlers.size();
+    size_t numDuplicated = 0;
+
+    for (const auto& s : straddlers) {
+      auto&     pbv = a_list[s.index];
+      const BV& box = pbv.second;
+
+      const T leftArea  = area(leftLo, leftHi);
+      const T rightArea = area(rightLo, rightHi);
+
+      const T splitCost = leftArea * T(numLeft) + rightArea * T(numRight);
+      const T leftCost  = (numRight > a_minRight)
+                            ? area(min(leftLo, box.getLowCorner()), max(leftHi, box.getHighCorner())) * T(numLeft) +
+                               rightArea * T(numRight - 1)
+                            : std::numeric_limits<T>::max();
+      const T rightCost = (numLeft > a_minLeft)
+                            ? leftArea * T(numLeft - 1) +
+                                area(min(rightLo, box.getLowCorner()), max(rightHi, box.getHighCorner())) * T(numRight)
+                            : std::numeric_limits<T>::max();
+
+      if (leftCost < splitCost && leftCost <= rightCost) {
+        leftLo = min(leftLo, box.getLowCorner());
+        leftHi = max(leftHi, box.getHighCorner());
+        numRight--;
+
+        a_left.emplace_back(std::move(pbv));
+      }
+      else if (rightCost < splitCost) {
+        rightLo = min(rightLo, box.getLowCorner());
+        rightHi = max(rightHi, box.getHighCorner());
+        numLeft--;
+
+        a_right.emplace_back(std::move(pbv));
+      }
+      else {
+        a_left.emplace_back(pbv.first, s.leftPart);
+        a_right.emplace_back(std::move(pbv.first), s.rightPart);
+
+        numDuplicated++;
+      }
+    }
+
+    a_list.clear();
+
+    return numDuplicated;
+  }
+
+  if (objectAxis >= 0) {
+    for (auto& pbv : a_list) {
+      if (centroidBin(pbv.second, objectAxis) < objectBin) {
+        a_left.emplace_back(std::move(pbv));
+      }
+      else {
+        a_right.emplace_back(std::move(pbv));
+      }
+    }
+  }
+  else {
+    // No binned object split leaves enough primitives on each side: split around the median centroid on the
+    // longest axis of the node.
+    const size_t dir = (nodeHi - nodeLo).maxDir(true);
+    const size_t mid = std::max(a_minLeft, std::min(N - a_minRight, N / 2));
+
+    std::nth_element(a_list.begin(),
+                     a_list.begin() + mid,
+                     a_list.end(),
+                     [dir](const PrimAndBV<P, BV>& a, const PrimAndBV<P, BV>& b) noexcept {
+                       return a.second.getCentroid()[dir] < b.second.getCentroid()[dir];
+                     });
+
+    a_left.assign(std::make_move_iterator(a_list.begin()), std::make_move_iterator(a_list.begin() + mid));
+    a_right.assign(std::make_move_iterator(a_list.begin() + mid), std::make_move_iterator(a_list.end()));
+  }
+
+  a_list.clear();
+
+  return 0;
+}
+
 template <class T, class P, class BV, size_t K>
 inline TreeBVH<T, P, BV, K>::TreeBVH() noexcept
 {
@@ -195,9 +779,23 @@ TreeBVH<T, P, BV, K>::topDownSortAndPartition(const Partitioner& a_partitioner,
       m_children[c] = std::make_shared<TreeBVH<T, P, BV, K>>(std::move(newPartitions[c]));
     }
 
-    // Recursive partitioning.
-    for (auto& c : m_children) {
-      c->topDownSortAndPartition(a_partitioner, a_stopCrit);
+    // Recursive partitioning. Large subtrees are independent of each other, so siblings are handed to the
+    // thread pool while this thread keeps the first child.
+    if (numPrimsInThisNode >= BVH::ParallelBuildThreshold && Parallel::getNumThreads() > 1) {
+      Parallel::TaskGroup group;
+
+      for (size_t c = 1; c < K; c++) {
+        group.run([&, c]() { m_children[c]->topDownSortAndPartition(a_partitioner, a_stopCrit); });
+      }
+
+      m_children[0]->topDownSortAndPartition(a_partitioner, a_stopCrit);
+
+      group.wait();
+    }
+    else {
+      for (auto& c : m_children) {
+        c->topDownSortAndPartition(a_partitioner, a_stopCrit);
+      }
     }
   }
 
@@ -312,783 +910,3717 @@ TreeBVH<T, P, BV, K>::bottomUpSortAndPartition()
 }
 
 template <class T, class P, class BV, size_t K>
+template <typename S>
 inline void
-TreeBVH<T, P, BV, K>::setChildren(const std::array<std::shared_ptr<TreeBVH<T, P, BV, K>>, K>& a_children) noexcept
+TreeBVH<T, P, BV, K>::plocSortAndPartition(const size_t a_maxLeafSize, const size_t a_searchRadius)
 {
-  std::vector<BV> boundingVolumes;
-  boundingVolumes.reserve(a_children.size());
-  for (const auto& child : a_children) {
-    boundingVolumes.emplace_back(child->getBoundingVolume());
+  EBGEOMETRY_EXPECT(a_maxLeafSize > 0);
+  EBGEOMETRY_EXPECT(a_searchRadius > 0);
+
+  const size_t numPrimitives = m_primitives.size();
+
+  if (numPrimitives <= a_maxLeafSize || numPrimitives < K) {
+    m_partitioned = true;
+
+    return;
   }
 
-  m_primitives.resize(0);
-  m_boundingVolumes.resize(0);
+  // Smallest range of a per-primitive (or per-cluster) loop handed to one thread.
+  constexpr size_t grainSize = 4096;
 
-  m_boundingVolume = BV(boundingVolumes);
-  m_children       = a_children;
-  m_partitioned    = true;
-}
+  // ---- Phase 1: order the primitives along the curve --------------------------------------------
+  // Same binning and encoding as the direct SFC-build PackedBVH constructor.
+  std::vector<Vec3> centroids(numPrimitives);
 
-template <class T, class P, class BV, size_t K>
-inline T
-TreeBVH<T, P, BV, K>::getDistanceToBoundingVolume(const Vec3& a_point) const noexcept
-{
-  return m_boundingVolume.getDistance(a_point);
-}
+  Parallel::parallelFor(0, numPrimitives, grainSize, [&](size_t a_lo, size_t a_hi) noexcept {
+    for (size_t i = a_lo; i < a_hi; i++) {
+      centroids[i] = m_boundingVolumes[i].getCentroid();
+    }
+  });
 
-template <class T, class P, class BV, size_t K>
-template <class NodeKey>
-inline void
-TreeBVH<T, P, BV, K>::traverse(const BVH::LeafEvaluator<P>&               a_leafEvaluator,
-                               const BVH::PrunePredicate<Node, NodeKey>&  a_prunePredicate,
-                               const BVH::ChildOrderer<Node, NodeKey, K>& a_childOrderer,
-                               const BVH::NodeKeyFactory<Node, NodeKey>&  a_nodeKeyFactory) const noexcept
-{
-  std::array<std::pair<std::shared_ptr<const Node>, NodeKey>, K> children;
-  std::stack<std::pair<std::shared_ptr<const Node>, NodeKey>>    q;
+  const std::vector<SFC::Index> bins = SFC::computeBins<T>(centroids);
 
-  q.emplace(this->shared_from_this(), a_nodeKeyFactory(*this));
+  std::vector<SFC::Code> codes(numPrimitives);
 
-  while (!(q.empty())) {
-    const auto& node    = q.top().first;
-    const auto& nodeKey = q.top().second;
+  Parallel::parallelFor(0, numPrimitives, grainSize, [&](size_t a_lo, size_t a_hi) noexcept {
+    for (size_t i = a_lo; i < a_hi; i++) {
+      codes[i] = S::encode(bins[i]);
+    }
+  });
 
-    q.pop();
+  const std::vector<uint32_t> sorted = SFC::sortByCode(codes);
 
-    if (a_prunePredicate(*node, nodeKey)) {
-      if (node->isLeaf()) {
-        a_leafEvaluator(node->getPrimitives());
-      }
-      else {
-        for (size_t k = 0; k < K; k++) {
-          children[k].first  = node->getChildren()[k];
-          children[k].second = a_nodeKeyFactory(*children[k].first);
-        }
+  // ---- Phase 2: agglomerative clustering into a binary tree -------------------------------------
+  // Binary node b < numPrimitives is the leaf holding primitive sorted[b]; merged nodes are appended after the
+  // leaves, so the root ends up last.
+  const size_t numNodes = 2 * numPrimitives - 1;
 
-        // User-based visit pattern.
-        a_childOrderer(children);
+  std::vector<BV>                      nodeBVs(numNodes);
+  std::vector<std::array<uint32_t, 2>> nodeChildren(numNodes);
+  std::vector<uint32_t>                nodeCounts(numNodes, 1U);
 
-        for (const auto& child : children) {
-          q.push(child);
-        }
-      }
+  Parallel::parallelFor(0, numPrimitives, grainSize, [&](size_t a_lo, size_t a_hi) {
+    for (size_t i = a_lo; i < a_hi; i++) {
+      nodeBVs[i] = m_boundingVolumes[sorted[i]];
     }
-  }
-}
+  });
 
-template <class T, class P, class BV, size_t K>
-template <class BVConstructor>
-inline const BV&
-TreeBVH<T, P, BV, K>::refit(const BVConstructor& a_bvConstructor)
-{
-  if (this->isLeaf()) {
-    for (size_t i = 0; i < m_primitives.size(); i++) {
-      m_boundingVolumes[i] = a_bvConstructor(*m_primitives[i]);
+  const auto merge = [](const BV& a_lhs, const BV& a_rhs) -> BV {
+    if constexpr (std::is_same_v<BV, BoundingVolumes::AABBT<T>>) {
+      return BV(min(a_lhs.getLowCorner(), a_rhs.getLowCorner()), max(a_lhs.getHighCorner(), a_rhs.getHighCorner()));
     }
-
-    m_boundingVolume = BV(m_boundingVolumes);
-  }
-  else {
-    std::vector<BV> childBoundingVolumes;
-    childBoundingVolumes.reserve(K);
-
-    for (const auto& child : m_children) {
-      childBoundingVolumes.emplace_back(child->refit(a_bvConstructor));
+    else {
+      return BV(std::vector<BV>{a_lhs, a_rhs});
     }
+  };
 
-    m_boundingVolume = BV(childBoundingVolumes);
-  }
-
-  return m_boundingVolume;
-}
-
-template <class T, class P, class BV, size_t K>
-template <class StoragePolicy>
-inline std::shared_ptr<PackedBVH<T, P, K, StoragePolicy>>
-TreeBVH<T, P, BV, K>::pack() const
-{
-  static_assert(std::is_same_v<BV, EBGeometry::BoundingVolumes::AABBT<T>>, "TreeBVH::pack requires BV == AABBT<T>");
+  // Surface area of the union of two bounding volumes -- the merge cost, and the innermost operation of the
+  // neighbor search.
+  const auto mergedArea = [&merge](const BV& a_lhs, const BV& a_rhs) -> T {
+    if constexpr (std::is_same_v<BV, BoundingVolumes::AABBT<T>>) {
+      const Vec3 lo = min(a_lhs.getLowCorner(), a_rhs.getLowCorner());
+      const Vec3 hi = max(a_lhs.getHighCorner(), a_rhs.getHighCorner());
+      const Vec3 d  = hi - lo;
 
-  return std::make_shared<PackedBVH<T, P, K, StoragePolicy>>(*this);
-}
+      return T(2) * (d[0] * d[1] + d[1] * d[2] + d[2] * d[0]);
+    }
+    else {
+      return merge(a_lhs, a_rhs).getArea();
+    }
+  };
 
-template <class T, class P, class BV, size_t K>
-template <class Q, class Converter, class StoragePolicy>
-inline std::shared_ptr<PackedBVH<T, Q, K, StoragePolicy>>
-TreeBVH<T, P, BV, K>::packWith(Converter&& a_converter) const
-{
-  static_assert(std::is_same_v<BV, EBGeometry::BoundingVolumes::AABBT<T>>, "TreeBVH::packWith requires BV == AABBT<T>");
+  // The live clusters in curve order, with a contiguous copy of their bounding volumes for the neighbor search.
+  std::vector<uint32_t> clusters(numPrimitives);
+  std::vector<BV>       clusterBVs(nodeBVs.begin(), nodeBVs.begin() + long(numPrimitives));
+  std::vector<uint32_t> nextClusters;
+  std::vector<BV>       nextClusterBVs;
+  std::vector<uint32_t> neighbors;
 
-  return std::make_shared<PackedBVH<T, Q, K, StoragePolicy>>(*this, std::forward<Converter>(a_converter));
-}
+  std::iota(clusters.begin(), clusters.end(), uint32_t(0));
 
-template <class T, class P, size_t K, class StoragePolicy>
-inline void
-PackedBVH<T, P, K, StoragePolicy>::buildSoA()
-{
-  m_childAabbSoA.resize(m_linearNodes.size());
+  size_t numMerged = numPrimitives;
 
-  for (size_t i = 0; i < m_linearNodes.size(); i++) {
-    const auto& node = m_linearNodes[i];
+  while (clusters.size() > 1) {
+    const size_t numClusters = clusters.size();
 
-    if (!node.isLeaf()) {
-      const auto& offsets = node.getChildOffsets();
-      auto&       soa     = m_childAabbSoA[i];
+    // Nearest neighbor of every cluster. Candidates are ranked by merged area, then by the lower and then the
+    // higher position of the pair -- which is what a strict comparison scanning upwards gives. The ranking is
+    // symmetric, so the globally best-ranked pair always chooses each other and every round merges at least once.
+    // The merged volume is always formed in position order, since only an AABB union is guaranteed to be symmetric.
+    //
+    // Each pair's area is needed by both of its clusters, so it is computed once per block of clusters into
+    // areas[(p - base) * a_searchRadius + k - 1], the merged area of the clusters at positions p and p + k.
+    neighbors.resize(numClusters);
 
-      for (size_t k = 0; k < K; k++) {
-        const auto& bv = m_linearNodes[offsets[k]].getBoundingVolume();
-        const auto& lo = bv.getLowCorner();
-        const auto& hi = bv.getHighCorner();
+    Parallel::parallelFor(0, numClusters, grainSize / a_searchRadius + 1, [&](size_t a_lo, size_t a_hi) {
+      constexpr size_t blockSize = 256;
 
-        soa.m_lo[0][k] = lo[0];
-        soa.m_lo[1][k] = lo[1];
-        soa.m_lo[2][k] = lo[2];
+      std::vector<T> areas((blockSize + a_searchRadius) * a_searchRadius);
 
-        soa.m_hi[0][k] = hi[0];
-        soa.m_hi[1][k] = hi[1];
-        soa.m_hi[2][k] = hi[2];
-      }
-    }
-  }
-}
+      for (size_t blockBegin = a_lo; blockBegin < a_hi; blockBegin += blockSize) {
+        const size_t blockEnd = std::min(blockBegin + blockSize, a_hi);
+        const size_t base     = (blockBegin > a_searchRadius) ? blockBegin - a_searchRadius : 0;
 
-template <class T, class P, size_t K, class StoragePolicy>
-inline PackedBVH<T, P, K, StoragePolicy>::PackedBVH(
-  const TreeBVH<T, P, EBGeometry::BoundingVolumes::AABBT<T>, K>& a_tree)
-{
-  using AABBType = EBGeometry::BoundingVolumes::AABBT<T>;
+        for (size_t p = base; p < blockEnd; p++) {
+          const size_t numPairs = std::min(a_searchRadius, numClusters - 1 - p);
 
-  // Depth-first. Each call reserves a slot by index, then fills child offsets
-  // after recursion. Indexing by position (not pointer) is safe across
-  // vector reallocation; C++17 RHS-before-LHS ensures fresh re-fetch of
-  // m_linearNodes[idx] after any push_back inside the recursive call.
-  std::function<uint32_t(const TreeBVH<T, P, AABBType, K>&)> dfs =
-    [&](const TreeBVH<T, P, AABBType, K>& node) -> uint32_t {
-    const uint32_t idx = static_cast<uint32_t>(m_linearNodes.size());
+          for (size_t k = 1; k <= numPairs; k++) {
+            areas[(p - base) * a_searchRadius + k - 1] = mergedArea(clusterBVs[p], clusterBVs[p + k]);
+          }
+        }
 
-    m_linearNodes.push_back({});
-    m_linearNodes[idx].m_bv = node.getBoundingVolume();
+        for (size_t i = blockBegin; i < blockEnd; i++) {
+          const size_t first = (i > a_searchRadius) ? i - a_searchRadius : 0;
+          const size_t last  = std::min(i + a_searchRadius, numClusters - 1);
 
-    if (node.isLeaf()) {
-      const auto& prims = node.getPrimitives();
+          T      bestArea = std::numeric_limits<T>::infinity();
+          size_t best     = (i == first) ? i + 1 : first;
 
-      m_linearNodes[idx].m_primOff  = static_cast<uint32_t>(m_primitives.size());
-      m_linearNodes[idx].m_numPrims = static_cast<uint32_t>(prims.size());
+          for (size_t j = first; j < i; j++) {
+            const T area = areas[(j - base) * a_searchRadius + (i - j) - 1];
 
-      StoragePolicy::appendTreeLeaf(m_primitives, prims);
-    }
-    else {
-      m_linearNodes[idx].m_numPrims = 0U;
-      m_linearNodes[idx].m_primOff  = 0U;
+            if (area < bestArea) {
+              bestArea = area;
+              best     = j;
+            }
+          }
+          for (size_t j = i + 1; j <= last; j++) {
+            const T area = areas[(i - base) * a_searchRadius + (j - i) - 1];
 
-      const auto& children = node.getChildren();
+            if (area < bestArea) {
+              bestArea = area;
+              best     = j;
+            }
+          }
 
-      for (size_t k = 0; k < K; k++) {
-        m_linearNodes[idx].m_childOff[k] = dfs(*children[k]);
+          neighbors[i] = static_cast<uint32_t>(best);
+        }
       }
-    }
-    return idx;
-  };
-
-  dfs(a_tree);
-  buildSoA();
-}
+    });
 
-template <class T, class P, size_t K, class StoragePolicy>
-template <class Q, class Converter>
-inline PackedBVH<T, P, K, StoragePolicy>::PackedBVH(
-  const TreeBVH<T, Q, EBGeometry::BoundingVolumes::AABBT<T>, K>& a_tree, Converter&& a_converter)
-{
-  using AABBType = EBGeometry::BoundingVolumes::AABBT<T>;
+    // Compact the cluster list: a mutual pair (i, j), i < j, becomes one new node at i's place, and every other
+    // cluster keeps its place. Chunks count their merges and survivors first, so that new node indices and output
+    // positions are the same for any chunking.
+    const auto isMutual = [&neighbors](size_t a_i) noexcept { return neighbors[neighbors[a_i]] == a_i; };
 
-  // Accumulate converted P-values into a single contiguous buffer; StoragePolicy::appendAliased
-  // materialises it into m_primitives once every push_back below has completed (aliased
-  // shared_ptrs, for the default SharedPtrStorage<P>, so no dangling pointers).
-  auto dstStorage = std::make_shared<std::vector<P>>();
+    const size_t numChunks =
+      std::max(size_t(1), std::min(numClusters / grainSize, 4 * size_t(Parallel::getNumThreads())));
 
-  std::function<uint32_t(const TreeBVH<T, Q, AABBType, K>&)> dfs =
-    [&](const TreeBVH<T, Q, AABBType, K>& node) -> uint32_t {
-    const uint32_t idx = static_cast<uint32_t>(m_linearNodes.size());
+    const auto chunkBegin = [numClusters, numChunks](size_t a_chunk) noexcept -> size_t {
+      return (numClusters * a_chunk) / numChunks;
+    };
 
-    m_linearNodes.push_back({});
-    m_linearNodes[idx].m_bv = node.getBoundingVolume();
+    std::vector<std::pair<size_t, size_t>> chunkOffsets(numChunks, {0, 0});
 
-    if (node.isLeaf()) {
-      const auto&    prims  = node.getPrimitives();
-      const uint32_t dstOff = static_cast<uint32_t>(dstStorage->size());
+    Parallel::parallelFor(0, numChunks, 1, [&](size_t a_lo, size_t a_hi) noexcept {
+      for (size_t chunk = a_lo; chunk < a_hi; chunk++) {
+        for (size_t i = chunkBegin(chunk); i < chunkBegin(chunk + 1); i++) {
+          const bool mutual = isMutual(i);
 
-      auto newVals = a_converter(prims, 0U, static_cast<uint32_t>(prims.size()));
+          chunkOffsets[chunk].first += (mutual && i < neighbors[i]) ? 1 : 0;
+          chunkOffsets[chunk].second += (mutual && i > neighbors[i]) ? 0 : 1;
+        }
+      }
+    });
 
-      m_linearNodes[idx].m_primOff  = dstOff;
-      m_linearNodes[idx].m_numPrims = static_cast<uint32_t>(newVals.size());
+    size_t numNew   = 0;
+    size_t numAlive = 0;
 
-      for (auto&& v : newVals) {
-        dstStorage->push_back(std::move(v));
-      }
-    }
-    else {
-      m_linearNodes[idx].m_numPrims = 0U;
-      m_linearNodes[idx].m_primOff  = 0U;
+    for (auto& [newOffset, aliveOffset] : chunkOffsets) {
+      const size_t newCount   = newOffset;
+      const size_t aliveCount = aliveOffset;
 
-      const auto& children = node.getChildren();
+      newOffset   = numMerged + numNew;
+      aliveOffset = numAlive;
 
-      for (size_t k = 0; k < K; k++) {
-        m_linearNodes[idx].m_childOff[k] = dfs(*children[k]);
-      }
+      numNew += newCount;
+      numAlive += aliveCount;
     }
 
-    return idx;
-  };
-
-  dfs(a_tree);
+    nextClusters.resize(numAlive);
+    nextClusterBVs.resize(numAlive);
 
-  StoragePolicy::appendAliased(m_primitives, dstStorage);
+    Parallel::parallelFor(0, numChunks, 1, [&](size_t a_lo, size_t a_hi) {
+      for (size_t chunk = a_lo; chunk < a_hi; chunk++) {
+        size_t newNode = chunkOffsets[chunk].first;
+        size_t alive   = chunkOffsets[chunk].second;
 
-  this->buildSoA();
-}
+        for (size_t i = chunkBegin(chunk); i < chunkBegin(chunk + 1); i++) {
+          const size_t j = neighbors[i];
 
-template <class T, class P, size_t K, class StoragePolicy>
-template <class S>
-inline PackedBVH<T, P, K, StoragePolicy>::PackedBVH(std::vector<std::pair<P, BV>> a_primsAndBVs,
-                                                    size_t                        a_targetLeafSize,
-                                                    S)
-{
-  EBGEOMETRY_EXPECT(!a_primsAndBVs.empty());
-  EBGEOMETRY_EXPECT(a_targetLeafSize > 0);
+          if (!isMutual(i)) {
+            nextClusters[alive]   = clusters[i];
+            nextClusterBVs[alive] = clusterBVs[i];
 
-  const size_t numPrimitives = a_primsAndBVs.size();
+            alive++;
+          }
+          else if (i < j) {
+            const uint32_t lhs = clusters[i];
+            const uint32_t rhs = clusters[j];
 
-  // Sort primitives along the space-filling curve, exactly like
-  // TreeBVH::bottomUpSortAndPartition() (same binning helper), but keeping P by value throughout
-  // -- no shared_ptr anywhere in this constructor.
-  std::vector<Vec3T<T>> centroids;
-  centroids.reserve(numPrimitives);
-  for (const auto& pbv : a_primsAndBVs) {
-    centroids.push_back(pbv.second.getCentroid());
-  }
+            nodeBVs[newNode]      = merge(clusterBVs[i], clusterBVs[j]);
+            nodeChildren[newNode] = {lhs, rhs};
+            nodeCounts[newNode]   = nodeCounts[lhs] + nodeCounts[rhs];
 
-  const std::vector<SFC::Index> bins = SFC::computeBins<T>(centroids);
+            nextClusters[alive]   = static_cast<uint32_t>(newNode);
+            nextClusterBVs[alive] = nodeBVs[newNode];
 
-  using PrimBvAndCode = std::tuple<P, BV, SFC::Code>;
+            alive++;
+            newNode++;
+          }
+        }
+      }
+    });
 
-  std::vector<PrimBvAndCode> sortedPrimitives;
+    EBGEOMETRY_EXPECT(numNew > 0);
 
-  sortedPrimitives.reserve(numPrimitives);
+    numMerged += numNew;
 
-  for (size_t i = 0; i < numPrimitives; i++) {
-    sortedPrimitives.emplace_back(std::move(a_primsAndBVs[i].first), a_primsAndBVs[i].second, S::encode(bins[i]));
+    clusters.swap(nextClusters);
+    clusterBVs.swap(nextClusterBVs);
   }
-  a_primsAndBVs.clear();
 
-  std::sort(sortedPrimitives.begin(),
-            sortedPrimitives.end(),
-            [](const PrimBvAndCode& a_lhs, const PrimBvAndCode& a_rhs) noexcept -> bool {
-              return std::get<2>(a_lhs) < std::get<2>(a_rhs);
-            });
+  EBGEOMETRY_EXPECT(numMerged == numNodes);
 
-  // Cut leaves via a single linear scan at the target leaf size (unlike
-  // TreeBVH::bottomUpSortAndPartition(), which derives a leaf count of K^floor(log_K(N)) from N
-  // and K alone).
-  struct LeafRange
-  {
-    uint32_t offset;
-    uint32_t count;
-    BV       bv;
-  };
-
-  std::vector<LeafRange> leafRanges;
-  leafRanges.reserve(numPrimitives / a_targetLeafSize + 1);
-  for (size_t i = 0; i < numPrimitives;) {
-    const size_t count = std::min(a_targetLeafSize, numPrimitives - i);
-
-    std::vector<BV> leafBVs;
-    leafBVs.reserve(count);
-    for (size_t j = 0; j < count; j++) {
-      leafBVs.push_back(std::get<1>(sortedPrimitives[i + j]));
-    }
+  // ---- Phase 3: collapse into K-wide nodes ------------------------------------------------------
+  // This node stops being a leaf; its primitives move into the new leaves below.
+  std::vector<std::shared_ptr<const P>> primitives      = std::move(m_primitives);
+  std::vector<BV>                       boundingVolumes = std::move(m_boundingVolumes);
 
-    leafRanges.push_back({static_cast<uint32_t>(i), static_cast<uint32_t>(count), BV(leafBVs)});
+  m_primitives.resize(0);
+  m_boundingVolumes.resize(0);
 
-    i += count;
-  }
+  const auto isLeaf = [&nodeCounts, a_maxLeafSize](uint32_t a_node) noexcept -> bool {
+    return nodeCounts[a_node] <= a_maxLeafSize || nodeCounts[a_node] < K;
+  };
 
-  // Populate the primitive array once, in final sorted order -- independent of whatever order
-  // the node array below ends up being built/relaid-out in.
-  auto primBlock = std::make_shared<std::vector<P>>();
+  // Leaf node holding every primitive below binary node a_node, in depth-first order.
+  std::function<void(uint32_t, PrimAndBVList<P, BV>&)> gather = [&](uint32_t a_node, PrimAndBVList<P, BV>& a_list) {
+    if (a_node < numPrimitives) {
+      a_list.emplace_back(std::move(primitives[sorted[a_node]]), std::move(boundingVolumes[sorted[a_node]]));
+    }
+    else {
+      gather(nodeChildren[a_node][0], a_list);
+      gather(nodeChildren[a_node][1], a_list);
+    }
+  };
 
-  primBlock->reserve(numPrimitives);
+  const auto makeLeaf = [&](uint32_t a_node) -> std::shared_ptr<TreeBVH<T, P, BV, K>> {
+    PrimAndBVList<P, BV> primsAndBVs;
+    primsAndBVs.reserve(nodeCounts[a_node]);
 
-  for (auto& entry : sortedPrimitives) {
-    primBlock->push_back(std::move(std::get<0>(entry)));
-  }
+    gather(a_node, primsAndBVs);
 
-  StoragePolicy::appendAliased(m_primitives, primBlock);
+    return std::make_shared<TreeBVH<T, P, BV, K>>(std::move(primsAndBVs));
+  };
 
-  // Build the K-ary structure bottom-up in a scratch array (reusing Node's own shape), then relay
-  // it out into m_linearNodes in depth-first pre-order below -- a bottom-up merge naturally
-  // produces the root last, but PackedBVH's traversal assumes the root is always at index 0.
-  const size_t numRealLeaves = leafRanges.size();
+  std::function<void(uint32_t, TreeBVH<T, P, BV, K>&)> collapse = [&](uint32_t              a_node,
+                                                                      TreeBVH<T, P, BV, K>& a_target) -> void {
+    std::array<uint32_t, K> children;
 
-  size_t paddedLeafCount = 1;
+    children[0] = nodeChildren[a_node][0];
+    children[1] = nodeChildren[a_node][1];
 
-  while (paddedLeafCount < numRealLeaves) {
-    paddedLeafCount *= K;
-  }
+    for (size_t numChildren = 2; numChildren < K; numChildren++) {
+      size_t widest     = numChildren;
+      T      widestArea = -std::numeric_limits<T>::infinity();
 
-  std::vector<Node> scratch(paddedLeafCount);
-  // Reserve the exact final node count up front -- for a full K-ary tree with paddedLeafCount
-  // leaves (itself a power of K), the total node count across every level is
-  // (paddedLeafCount * K - 1) / (K - 1) (geometric series 1 + K + K^2 + ... + paddedLeafCount) --
-  // so the emplace_back() calls building interior nodes below never trigger a reallocation.
-  scratch.reserve((paddedLeafCount * K - 1) / (K - 1));
+      for (size_t c = 0; c < numChildren; c++) {
+        if (children[c] >= numPrimitives && nodeBVs[children[c]].getArea() > widestArea) {
+          widest     = c;
+          widestArea = nodeBVs[children[c]].getArea();
+        }
+      }
 
-  for (size_t i = 0; i < numRealLeaves; i++) {
-    scratch[i].setBoundingVolume(leafRanges[i].bv);
-    scratch[i].setPrimitivesOffset(leafRanges[i].offset);
-    scratch[i].setNumPrimitives(leafRanges[i].count);
-  }
+      EBGEOMETRY_EXPECT(widest < numChildren);
 
-  // Padding slots (present only when numRealLeaves isn't already a power of K) reuse the last
-  // real leaf's scratch index rather than inventing an empty placeholder node: the resulting
-  // duplicate Node entries (one per parent that references it) are cheap, and re-visiting the
-  // same primitives more than once is harmless for any min-reduction query -- see the
-  // constructor's doxygen comment.
-  std::vector<uint32_t> levelIndices(paddedLeafCount);
+      const auto grandChildren = nodeChildren[children[widest]];
 
-  for (size_t i = 0; i < paddedLeafCount; i++) {
-    levelIndices[i] = static_cast<uint32_t>(i < numRealLeaves ? i : numRealLeaves - 1);
-  }
+      std::copy_backward(children.begin() + long(widest) + 1,
+                         children.begin() + long(numChildren),
+                         children.begin() + long(numChildren) + 1);
 
-  while (levelIndices.size() > 1) {
-    const size_t          numParents = levelIndices.size() / K;
-    std::vector<uint32_t> parentIndices(numParents);
+      children[widest]     = grandChildren[0];
+      children[widest + 1] = grandChildren[1];
+    }
 
-    for (size_t p = 0; p < numParents; p++) {
-      const uint32_t parentIdx = static_cast<uint32_t>(scratch.size());
-      scratch.emplace_back();
+    std::array<std::shared_ptr<TreeBVH<T, P, BV, K>>, K> childNodes;
 
-      std::vector<BV> childBVs;
+    for (size_t c = 0; c < K; c++) {
+      childNodes[c] = isLeaf(children[c]) ? makeLeaf(children[c]) : std::make_shared<TreeBVH<T, P, BV, K>>();
+    }
 
-      childBVs.reserve(K);
+    // Interior children need their own subtrees before setChildren() can read their bounding volumes. Large ones
+    // are independent of each other, so they are handed to the thread pool.
+    if (nodeCounts[a_node] >= BVH::ParallelBuildThreshold && Parallel::getNumThreads() > 1) {
+      Parallel::TaskGroup group;
 
       for (size_t c = 0; c < K; c++) {
-        const uint32_t childIdx = levelIndices[p * K + c];
-        scratch[parentIdx].setChildOffset(childIdx, c);
-        childBVs.push_back(scratch[childIdx].getBoundingVolume());
+        if (!isLeaf(children[c])) {
+          group.run([&, c]() { collapse(children[c], *childNodes[c]); });
+        }
       }
 
-      scratch[parentIdx].setBoundingVolume(BV(childBVs));
-
-      parentIndices[p] = parentIdx;
+      group.wait();
     }
-
-    levelIndices = std::move(parentIndices);
-  }
-
-  const uint32_t scratchRoot = levelIndices.front();
-
-  // Relay the scratch tree into m_linearNodes in depth-first pre-order (root at index 0), exactly
-  // matching the invariant the other two constructors establish.
-  m_linearNodes.reserve(scratch.size());
-
-  std::function<uint32_t(uint32_t)> relayout = [&](uint32_t a_scratchIdx) -> uint32_t {
-    const uint32_t newIdx = static_cast<uint32_t>(m_linearNodes.size());
-
-    m_linearNodes.push_back(scratch[a_scratchIdx]);
-
-    if (!scratch[a_scratchIdx].isLeaf()) {
+    else {
       for (size_t c = 0; c < K; c++) {
-        const uint32_t newChildIdx = relayout(scratch[a_scratchIdx].getChildOffsets()[c]);
-
-        m_linearNodes[newIdx].setChildOffset(static_cast<uint32_t>(newChildIdx), c);
+        if (!isLeaf(children[c])) {
+          collapse(children[c], *childNodes[c]);
+        }
       }
     }
 
-    return newIdx;
+    a_target.setChildren(childNodes);
   };
 
-  relayout(scratchRoot);
-
-  buildSoA();
+  collapse(static_cast<uint32_t>(numNodes - 1), *this);
 }
 
-template <class T, class P, size_t K, class StoragePolicy>
-inline PackedBVH<T, P, K, StoragePolicy>::PackedBVH(std::vector<std::pair<P, BV>>          a_primsAndBVs,
-                                                    const BVH::Partitioner<P, BV, K>&      a_partitioner,
-                                                    const BVH::LeafPredicate<T, P, BV, K>& a_stopCrit)
+template <class T, class P, class BV, size_t K>
+inline void
+TreeBVH<T, P, BV, K>::spatialSortAndPartition(const PrimitivePolygon& a_polygon,
+                                              size_t                  a_maxLeafSize,
+                                              double                  a_budget)
 {
-  EBGEOMETRY_EXPECT(!a_primsAndBVs.empty());
+  static_assert(std::is_same_v<BV, EBGeometry::BoundingVolumes::AABBT<T>>,
+                "spatialSortAndPartition requires BV == AABBT<T>");
 
-  // shared_ptr-wrap each primitive once, up front, so the existing Partitioner/LeafPredicate
-  // machinery (which operates on PrimAndBVList) can be reused unchanged. This is not the cost
-  // this constructor targets -- see its doxygen comment -- only the persistent, per-node
-  // shared_ptr<TreeBVH> allocation is avoided.
-  BVH::PrimAndBVList<P, BV> wrapped;
+  EBGEOMETRY_EXPECT(a_maxLeafSize > 0);
+  EBGEOMETRY_EXPECT(a_budget >= 0.0);
 
-  wrapped.reserve(a_primsAndBVs.size());
+  const T      minOverlap = T(SpatialSplitOverlap) * m_boundingVolume.getArea();
+  const size_t budget     = static_cast<size_t>(a_budget * static_cast<double>(m_primitives.size()));
 
-  for (auto& pbv : a_primsAndBVs) {
-    wrapped.emplace_back(std::make_shared<P>(std::move(pbv.first)), pbv.second);
-  }
+  // Split a list into a_numGroups groups by recursive 2-way splits, as SAHKWaySplit does. Whatever budget a split
+  // leaves unused is shared between its two sides in proportion to their sizes.
+  using Group = std::pair<PrimAndBVList<P, BV>, size_t>;
 
-  a_primsAndBVs.clear();
+  std::function<void(PrimAndBVList<P, BV>&, size_t, size_t, std::vector<Group>&)> split =
+    [&](PrimAndBVList<P, BV>& a_list, size_t a_numGroups, size_t a_budgetLeft, std::vector<Group>& a_groups) {
+      if (a_numGroups <= 1) {
+        a_groups.emplace_back(std::move(a_list), a_budgetLeft);
 
-  // Recursively partition top-down, writing nodes directly into m_linearNodes in pre-order (root
-  // first) as the recursion unwinds -- unlike the SFC-build constructor above, top-down
-  // partitioning visits the root before its children, so no relayout pass is needed here. At every
-  // split, a lightweight, stack-local TreeBVH ("probe") is constructed purely to evaluate
-  // a_stopCrit (whose signature expects an actual TreeBVH node, matching
-  // TreeBVH::topDownSortAndPartition()'s own contract) and to read off its primitive list; it is
-  // discarded immediately afterward, never linked into a persistent tree.
-  std::function<uint32_t(BVH::PrimAndBVList<P, BV>)> build = [&](BVH::PrimAndBVList<P, BV> a_prims) -> uint32_t {
-    const uint32_t idx = static_cast<uint32_t>(m_linearNodes.size());
+        return;
+      }
 
-    m_linearNodes.push_back({});
+      const size_t K1 = a_numGroups / 2;
+      const size_t K2 = a_numGroups - K1;
 
-    const BVH::TreeBVH<T, P, BV, K> probe(a_prims);
+      PrimAndBVList<P, BV> left;
+      PrimAndBVList<P, BV> right;
 
-    m_linearNodes[idx].setBoundingVolume(probe.getBoundingVolume());
+      const size_t used = SpatialSAH2WaySplit<T, P>(a_list, left, right, K1, K2, a_budgetLeft, minOverlap, a_polygon);
 
-    if (a_stopCrit(probe) || a_prims.size() < K) {
-      const auto& leafPrims = probe.getPrimitives();
+      const size_t remaining  = a_budgetLeft - used;
+      const size_t leftBudget = remaining * left.size() / (left.size() + right.size());
 
-      m_linearNodes[idx].setPrimitivesOffset(static_cast<uint32_t>(m_primitives.size()));
-      m_linearNodes[idx].setNumPrimitives(static_cast<uint32_t>(leafPrims.size()));
+      split(left, K1, leftBudget, a_groups);
+      split(right, K2, remaining - leftBudget, a_groups);
+    };
 
-      StoragePolicy::appendTreeLeaf(m_primitives, leafPrims);
-    }
-    else {
-      // The partitioner takes its list by value and moves the sub-lists out; a_prims is not used
-      // after this, so move it in, and move each child sub-list into the recursion.
-      std::array<BVH::PrimAndBVList<P, BV>, K> children = a_partitioner(std::move(a_prims));
+  std::function<void(TreeBVH&, size_t)> partition = [&](TreeBVH& a_node, size_t a_budgetLeft) {
+    const size_t numPrims = a_node.m_primitives.size();
 
-      for (size_t k = 0; k < K; k++) {
-        const uint32_t childIdx = build(std::move(children[k]));
-        m_linearNodes[idx].setChildOffset(childIdx, k);
-      }
+    a_node.m_partitioned = true;
+
+    if (numPrims <= a_maxLeafSize || numPrims < K) {
+      return;
     }
 
-    return idx;
-  };
+    PrimAndBVList<P, BV> primsAndBVs;
 
-  build(std::move(wrapped));
+    primsAndBVs.reserve(numPrims);
 
-  buildSoA();
-}
+    for (size_t i = 0; i < numPrims; i++) {
+      primsAndBVs.emplace_back(std::move(a_node.m_primitives[i]), std::move(a_node.m_boundingVolumes[i]));
+    }
 
-template <class T, class P, size_t K, class StoragePolicy>
-inline PackedBVH<T, P, K, StoragePolicy>::PackedBVH(std::vector<std::pair<P, BV>> a_primsAndBVs,
-                                                    BVH::ClusterSpec              a_spec)
-{
-  static_assert(std::is_same_v<BV, EBGeometry::BoundingVolumes::AABBT<T>>, "ClusterSAH requires BV == AABBT<T>");
+    a_node.m_primitives.resize(0);
+    a_node.m_boundingVolumes.resize(0);
 
-  EBGEOMETRY_EXPECT(!a_primsAndBVs.empty());
-  EBGEOMETRY_EXPECT(a_spec.maxClusterSize > 0);
+    std::vector<Group> groups;
 
-  const size_t maxC = a_spec.maxClusterSize;
+    groups.reserve(K);
 
-  // A cluster: its bounding volume, centroid, and the primitives it owns (moved in).
-  struct Cluster
-  {
-    BV                            bv;
-    Vec3T<T>                      centroid;
-    std::vector<std::pair<P, BV>> prims;
-  };
+    split(primsAndBVs, K, a_budgetLeft, groups);
 
-  // ---- Phase 1: density-adaptive clustering --------------------------------------------------
-  // Recursively split a_primsAndBVs[begin, end) at the midpoint of its centroid bounding box (longest
-  // axis) until a range holds at most maxC primitives, then freeze it as a cluster. The midpoint
-  // splits are cheap, the subdivision is shallow, and it follows the primitive density (fine where
-  // dense, coarse where sparse), so no cluster overcrowds -- robust where a fixed grid would fail.
-  std::vector<Cluster> clusters;
-  clusters.reserve(a_primsAndBVs.size() / maxC + 1);
+    for (size_t c = 0; c < K; c++) {
+      a_node.m_children[c] = std::make_shared<TreeBVH<T, P, BV, K>>(std::move(groups[c].first));
+    }
 
-  std::function<void(size_t, size_t)> makeClusters = [&](size_t a_begin, size_t a_end) -> void {
-    if (a_end - a_begin <= maxC) {
-      Cluster cluster;
-      cluster.prims.reserve(a_end - a_begin);
+    if (numPrims >= BVH::ParallelBuildThreshold && Parallel::getNumThreads() > 1) {
+      Parallel::TaskGroup group;
 
-      Vec3T<T> lo = +Vec3T<T>::max();
-      Vec3T<T> hi = -Vec3T<T>::max();
-      for (size_t i = a_begin; i < a_end; i++) {
-        lo = min(lo, a_primsAndBVs[i].second.getLowCorner());
-        hi = max(hi, a_primsAndBVs[i].second.getHighCorner());
-        cluster.prims.push_back(std::move(a_primsAndBVs[i]));
+      for (size_t c = 1; c < K; c++) {
+        group.run([&, c]() { partition(*a_node.m_children[c], groups[c].second); });
       }
-      cluster.bv       = BV(lo, hi);
-      cluster.centroid = cluster.bv.getCentroid();
 
-      clusters.push_back(std::move(cluster));
+      partition(*a_node.m_children[0], groups[0].second);
 
-      return;
+      group.wait();
     }
+    else {
+      for (size_t c = 0; c < K; c++) {
+        partition(*a_node.m_children[c], groups[c].second);
+      }
+    }
+  };
+
+  partition(*this, budget);
+}
+
+template <class T, class P, class BV, size_t K>
+inline void
+TreeBVH<T, P, BV, K>::setChildren(const std::array<std::shared_ptr<TreeBVH<T, P, BV, K>>, K>& a_children) noexcept
+{
+  std::vector<BV> boundingVolumes;
+  boundingVolumes.reserve(a_children.size());
+  for (const auto& child : a_children) {
+    boundingVolumes.emplace_back(child->getBoundingVolume());
+  }
+
+  m_primitives.resize(0);
+  m_boundingVolumes.resize(0);
+
+  m_boundingVolume = BV(boundingVolumes);
+  m_children       = a_children;
+  m_partitioned    = true;
+}
+
+template <class T, class P, class BV, size_t K>
+inline T
+TreeBVH<T, P, BV, K>::getDistanceToBoundingVolume(const Vec3& a_point) const noexcept
+{
+  return m_boundingVolume.getDistance(a_point);
+}
+
+template <class T, class P, class BV, size_t K>
+template <class NodeKey>
+inline void
+TreeBVH<T, P, BV, K>::traverse(const BVH::LeafEvaluator<P>&               a_leafEvaluator,
+                               const BVH::PrunePredicate<Node, NodeKey>&  a_prunePredicate,
+                               const BVH::ChildOrderer<Node, NodeKey, K>& a_childOrderer,
+                               const BVH::NodeKeyFactory<Node, NodeKey>&  a_nodeKeyFactory) const noexcept
+{
+  std::array<std::pair<std::shared_ptr<const Node>, NodeKey>, K> children;
+  std::stack<std::pair<std::shared_ptr<const Node>, NodeKey>>    q;
+
+  q.emplace(this->shared_from_this(), a_nodeKeyFactory(*this));
+
+  while (!(q.empty())) {
+    const auto& node    = q.top().first;
+    const auto& nodeKey = q.top().second;
+
+    q.pop();
+
+    if (a_prunePredicate(*node, nodeKey)) {
+      if (node->isLeaf()) {
+        a_leafEvaluator(node->getPrimitives());
+      }
+      else {
+        for (size_t k = 0; k < K; k++) {
+          children[k].first  = node->getChildren()[k];
+          children[k].second = a_nodeKeyFactory(*children[k].first);
+        }
+
+        // User-based visit pattern.
+        a_childOrderer(children);
+
+        for (const auto& child : children) {
+          q.push(child);
+        }
+      }
+    }
+  }
+}
+
+template <class T, class P, class BV, size_t K>
+template <class BVConstructor>
+inline const BV&
+TreeBVH<T, P, BV, K>::refit(const BVConstructor& a_bvConstructor)
+{
+  if (this->isLeaf()) {
+    for (size_t i = 0; i < m_primitives.size(); i++) {
+      m_boundingVolumes[i] = a_bvConstructor(*m_primitives[i]);
+    }
+
+    m_boundingVolume = BV(m_boundingVolumes);
+  }
+  else {
+    std::vector<BV> childBoundingVolumes;
+    childBoundingVolumes.reserve(K);
+
+    for (const auto& child : m_children) {
+      childBoundingVolumes.emplace_back(child->refit(a_bvConstructor));
+    }
+
+    m_boundingVolume = BV(childBoundingVolumes);
+  }
+
+  return m_boundingVolume;
+}
+
+template <class T, class P, class BV, size_t K>
+template <class StoragePolicy>
+inline std::shared_ptr<PackedBVH<T, P, K, StoragePolicy>>
+TreeBVH<T, P, BV, K>::pack() const
+{
+  static_assert(std::is_same_v<BV, EBGeometry::BoundingVolumes::AABBT<T>>, "TreeBVH::pack requires BV == AABBT<T>");
+
+  return std::make_shared<PackedBVH<T, P, K, StoragePolicy>>(*this);
+}
+
+template <class T, class P, class BV, size_t K>
+template <class Q, class Converter, class StoragePolicy>
+inline std::shared_ptr<PackedBVH<T, Q, K, StoragePolicy>>
+TreeBVH<T, P, BV, K>::packWith(Converter&& a_converter) const
+{
+  static_assert(std::is_same_v<BV, EBGeometry::BoundingVolumes::AABBT<T>>, "TreeBVH::packWith requires BV == AABBT<T>");
+
+  return std::make_shared<PackedBVH<T, Q, K, StoragePolicy>>(*this, std::forward<Converter>(a_converter));
+}
+
+template <class T, class P, size_t K, class StoragePolicy>
+inline void
+PackedBVH<T, P, K, StoragePolicy>::packNodes(const std::vector<NodeView>& a_nodes)
+{
+  const size_t numInterior = size_t(std::count_if(
+    a_nodes.begin(), a_nodes.end(), [](const NodeView& a_node) noexcept { return !a_node.isLeaf(); }));
+
+  m_linearNodes.resize(a_nodes.size());
+  m_linearNodes.shrink_to_fit();
+  m_childAabbSoA.resize(numInterior);
+  m_childAabbSoA.shrink_to_fit();
+  m_leaves.resize(a_nodes.size() - numInterior);
+  m_leaves.shrink_to_fit();
+
+  if (!a_nodes.empty()) {
+    m_bv = a_nodes[0].getBoundingVolume();
+  }
+
+  // Interior nodes and leaves are numbered separately, in array order. Each interior node's record then takes the
+  // boxes of its children, which is the only place those boxes are kept.
+  uint32_t soaIndex  = 0;
+  uint32_t leafIndex = 0;
+
+  for (size_t i = 0; i < a_nodes.size(); i++) {
+    const NodeView& view = a_nodes[i];
+    Node&           node = m_linearNodes[i];
+
+    node.m_childOff = view.getChildOffsets();
+
+    if (view.isLeaf()) {
+      EBGEOMETRY_EXPECT(leafIndex < s_leafFlag);
+
+      node.m_ref = s_leafFlag | leafIndex;
+
+      m_leaves[leafIndex++] = {view.getPrimitivesOffset(), view.getNumPrimitives()};
+    }
+    else {
+      node.m_ref = soaIndex++;
+
+      for (size_t k = 0; k < K; k++) {
+        if (k < view.getNumChildren()) {
+          this->setChildBoundingVolume(node.m_ref, k, a_nodes[view.getChildOffsets()[k]].getBoundingVolume());
+        }
+        else {
+          this->clearChildBoundingVolume(node.m_ref, k);
+        }
+      }
+    }
+  }
+}
+
+template <class T, class P, size_t K, class StoragePolicy>
+inline std::vector<typename PackedBVH<T, P, K, StoragePolicy>::BV>
+PackedBVH<T, P, K, StoragePolicy>::getNodeBoundingVolumes() const
+{
+  const Node* const nodes    = this->getNodeData();
+  const size_t      numNodes = this->getNumNodes();
+
+  // Detached nodes have no parent record, and keep this box.
+  std::vector<BV> boundingVolumes(numNodes, BV(Vec3T<T>::zeros(), Vec3T<T>::zeros()));
+
+  if (numNodes > 0) {
+    boundingVolumes[0] = this->getBoundingVolume();
+  }
+
+  for (size_t i = 0; i < numNodes; i++) {
+    const Node& node = nodes[i];
+
+    if (!node.isLeaf()) {
+      for (size_t k = 0; k < node.getNumChildren(); k++) {
+        boundingVolumes[node.getChildOffsets()[k]] = this->getChildBoundingVolume(node.getChildBoxesIndex(), k);
+      }
+    }
+  }
+
+  return boundingVolumes;
+}
+
+template <class T, class P, size_t K, class StoragePolicy>
+inline std::vector<typename PackedBVH<T, P, K, StoragePolicy>::NodeView>
+PackedBVH<T, P, K, StoragePolicy>::getNodeViews() const
+{
+  const Node* const     nodes           = this->getNodeData();
+  const std::vector<BV> boundingVolumes = this->getNodeBoundingVolumes();
+
+  std::vector<NodeView> views;
+  views.reserve(boundingVolumes.size());
+
+  for (size_t i = 0; i < boundingVolumes.size(); i++) {
+    views.emplace_back(this->getNodeView(nodes[i], boundingVolumes[i]));
+  }
+
+  return views;
+}
+
+template <class T, class P, size_t K, class StoragePolicy>
+inline typename PackedBVH<T, P, K, StoragePolicy>::NodeView
+PackedBVH<T, P, K, StoragePolicy>::getNodeView(const Node& a_node, const BV& a_bv) const noexcept
+{
+  NodeView view;
+
+  view.setBoundingVolume(a_bv);
+  view.m_childOff = a_node.getChildOffsets();
+
+  if (a_node.isLeaf()) {
+    const Leaf& leaf = this->getLeafData()[a_node.getLeafIndex()];
+
+    view.setPrimitivesOffset(leaf.m_primOff);
+    view.setNumPrimitives(leaf.m_numPrims);
+  }
+
+  return view;
+}
+
+template <class T, class P, size_t K, class StoragePolicy>
+inline typename PackedBVH<T, P, K, StoragePolicy>::BV
+PackedBVH<T, P, K, StoragePolicy>::getChildBoundingVolume(const uint32_t a_record, const size_t a_k) const noexcept
+{
+  EBGEOMETRY_EXPECT(a_record < this->getNumInteriorNodes());
+  EBGEOMETRY_EXPECT(a_k < K);
+
+  const ChildAABBSoA& soa = this->getChildAabbData()[a_record];
+
+  return BV(Vec3T<T>(soa.m_lo[0][a_k], soa.m_lo[1][a_k], soa.m_lo[2][a_k]),
+            Vec3T<T>(soa.m_hi[0][a_k], soa.m_hi[1][a_k], soa.m_hi[2][a_k]));
+}
+
+template <class T, class P, size_t K, class StoragePolicy>
+inline typename PackedBVH<T, P, K, StoragePolicy>::BV
+PackedBVH<T, P, K, StoragePolicy>::getChildrenBoundingVolume(const Node& a_node) const noexcept
+{
+  EBGEOMETRY_EXPECT(!a_node.isLeaf());
+  EBGEOMETRY_EXPECT(a_node.getNumChildren() > 0);
+
+  const ChildAABBSoA& soa = this->getChildAabbData()[a_node.getChildBoxesIndex()];
+
+  Vec3T<T> lo = Vec3T<T>::infinity();
+  Vec3T<T> hi = -Vec3T<T>::infinity();
+
+  for (size_t k = 0; k < a_node.getNumChildren(); k++) {
+    lo = min(lo, Vec3T<T>(soa.m_lo[0][k], soa.m_lo[1][k], soa.m_lo[2][k]));
+    hi = max(hi, Vec3T<T>(soa.m_hi[0][k], soa.m_hi[1][k], soa.m_hi[2][k]));
+  }
+
+  return BV(lo, hi);
+}
+
+template <class T, class P, size_t K, class StoragePolicy>
+inline void
+PackedBVH<T, P, K, StoragePolicy>::setChildBoundingVolume(const uint32_t a_record,
+                                                          const size_t   a_k,
+                                                          const BV&      a_bv) noexcept
+{
+  EBGEOMETRY_EXPECT(a_record < m_childAabbSoA.size());
+  EBGEOMETRY_EXPECT(a_k < K);
+
+  ChildAABBSoA&   soa = m_childAabbSoA[a_record];
+  const Vec3T<T>& lo  = a_bv.getLowCorner();
+  const Vec3T<T>& hi  = a_bv.getHighCorner();
+
+  for (size_t dir = 0; dir < 3; dir++) {
+    soa.m_lo[dir][a_k] = lo[dir];
+    soa.m_hi[dir][a_k] = hi[dir];
+  }
+}
+
+template <class T, class P, size_t K, class StoragePolicy>
+inline void
+PackedBVH<T, P, K, StoragePolicy>::clearChildBoundingVolume(const uint32_t a_record, const size_t a_k) noexcept
+{
+  EBGEOMETRY_EXPECT(a_record < m_childAabbSoA.size());
+  EBGEOMETRY_EXPECT(a_k < K);
+
+  ChildAABBSoA& soa = m_childAabbSoA[a_record];
+
+  for (size_t dir = 0; dir < 3; dir++) {
+    soa.m_lo[dir][a_k] = std::numeric_limits<T>::infinity();
+    soa.m_hi[dir][a_k] = -std::numeric_limits<T>::infinity();
+  }
+}
+
+template <class T, class P, size_t K, class StoragePolicy>
+inline size_t
+PackedBVH<T, P, K, StoragePolicy>::getChildSlot(const Node& a_node, const uint32_t a_child) noexcept
+{
+  size_t k = 0;
+  while (a_node.getChildOffsets()[k] != a_child) {
+    k++;
+
+    EBGEOMETRY_EXPECT(k < K);
+  }
+
+  return k;
+}
+
+template <class T, class P, size_t K, class StoragePolicy>
+inline PackedBVH<T, P, K, StoragePolicy>::PackedBVH(
+  const TreeBVH<T, P, EBGeometry::BoundingVolumes::AABBT<T>, K>& a_tree)
+{
+  using AABBType = EBGeometry::BoundingVolumes::AABBT<T>;
+
+  std::vector<NodeView> nodes;
+
+  // Depth-first. Each call reserves a slot by index, then fills child offsets
+  // after recursion. Indexing by position (not pointer) is safe across
+  // vector reallocation; C++17 RHS-before-LHS ensures fresh re-fetch of
+  // nodes[idx] after any push_back inside the recursive call.
+  std::function<uint32_t(const TreeBVH<T, P, AABBType, K>&)> dfs =
+    [&](const TreeBVH<T, P, AABBType, K>& node) -> uint32_t {
+    const uint32_t idx = static_cast<uint32_t>(nodes.size());
+
+    nodes.push_back({});
+    nodes[idx].m_bv = node.getBoundingVolume();
+
+    if (node.isLeaf()) {
+      const auto& prims = node.getPrimitives();
+
+      nodes[idx].m_primOff  = static_cast<uint32_t>(m_primitives.size());
+      nodes[idx].m_numPrims = static_cast<uint32_t>(prims.size());
+
+      StoragePolicy::appendTreeLeaf(m_primitives, prims);
+    }
+    else {
+      nodes[idx].m_numPrims = 0U;
+      nodes[idx].m_primOff  = 0U;
+
+      const auto& children = node.getChildren();
+
+      for (size_t k = 0; k < K; k++) {
+        nodes[idx].m_childOff[k] = dfs(*children[k]);
+      }
+    }
+    return idx;
+  };
+
+  dfs(a_tree);
+
+  this->packNodes(nodes);
+}
+
+template <class T, class P, size_t K, class StoragePolicy>
+template <class Q, class Converter>
+inline PackedBVH<T, P, K, StoragePolicy>::PackedBVH(
+  const TreeBVH<T, Q, EBGeometry::BoundingVolumes::AABBT<T>, K>& a_tree, Converter&& a_converter)
+{
+  using AABBType = EBGeometry::BoundingVolumes::AABBT<T>;
+
+  // Accumulate converted P-values into a single contiguous buffer; StoragePolicy::appendAliased
+  // materialises it into m_primitives once every push_back below has completed (aliased
+  // shared_ptrs, for the default SharedPtrStorage<P>, so no dangling pointers).
+  auto dstStorage = std::make_shared<std::vector<P>>();
+
+  std::vector<NodeView> nodes;
+
+  std::function<uint32_t(const TreeBVH<T, Q, AABBType, K>&)> dfs =
+    [&](const TreeBVH<T, Q, AABBType, K>& node) -> uint32_t {
+    const uint32_t idx = static_cast<uint32_t>(nodes.size());
+
+    nodes.push_back({});
+    nodes[idx].m_bv = node.getBoundingVolume();
+
+    if (node.isLeaf()) {
+      const auto&    prims  = node.getPrimitives();
+      const uint32_t dstOff = static_cast<uint32_t>(dstStorage->size());
+
+      auto newVals = a_converter(prims, 0U, static_cast<uint32_t>(prims.size()));
+
+      nodes[idx].m_primOff  = dstOff;
+      nodes[idx].m_numPrims = static_cast<uint32_t>(newVals.size());
+
+      for (auto&& v : newVals) {
+        dstStorage->push_back(std::move(v));
+      }
+    }
+    else {
+      nodes[idx].m_numPrims = 0U;
+      nodes[idx].m_primOff  = 0U;
+
+      const auto& children = node.getChildren();
+
+      for (size_t k = 0; k < K; k++) {
+        nodes[idx].m_childOff[k] = dfs(*children[k]);
+      }
+    }
+
+    return idx;
+  };
+
+  dfs(a_tree);
+
+  StoragePolicy::appendAliased(m_primitives, dstStorage);
+
+  this->packNodes(nodes);
+}
+
+template <class T, class P, size_t K, class StoragePolicy>
+template <class S>
+inline PackedBVH<T, P, K, StoragePolicy>::PackedBVH(std::vector<std::pair<P, BV>> a_primsAndBVs,
+                                                    size_t                        a_targetLeafSize,
+                                                    S)
+{
+  EBGEOMETRY_EXPECT(!a_primsAndBVs.empty());
+  EBGEOMETRY_EXPECT(a_targetLeafSize > 0);
+
+  const size_t numPrimitives = a_primsAndBVs.size();
+
+  // Per-primitive and per-node loops below are independent across iterations and run on the thread pool; this
+  // is the smallest range handed to one thread.
+  constexpr size_t grainSize = 4096;
+
+  // Sort primitives along the space-filling curve with the same binning helper as
+  // TreeBVH::bottomUpSortAndPartition(), but as a permutation (SFC::sortByCode(), a parallel radix sort) rather
+  // than by moving the primitives around -- P is kept by value throughout and moved exactly once, into its final
+  // slot. No shared_ptr anywhere in this constructor.
+  std::vector<Vec3T<T>> centroids(numPrimitives);
+
+  Parallel::parallelFor(0, numPrimitives, grainSize, [&](size_t a_lo, size_t a_hi) noexcept {
+    for (size_t i = a_lo; i < a_hi; i++) {
+      centroids[i] = a_primsAndBVs[i].second.getCentroid();
+    }
+  });
+
+  const std::vector<SFC::Index> bins = SFC::computeBins<T>(centroids);
+
+  std::vector<SFC::Code> codes(numPrimitives);
+
+  Parallel::parallelFor(0, numPrimitives, grainSize, [&](size_t a_lo, size_t a_hi) noexcept {
+    for (size_t i = a_lo; i < a_hi; i++) {
+      codes[i] = S::encode(bins[i]);
+    }
+  });
+
+  const std::vector<uint32_t> sorted = SFC::sortByCode(codes);
+
+  // Leaves are consecutive runs of a_targetLeafSize sorted primitives (the last one possibly shorter), unlike
+  // TreeBVH::bottomUpSortAndPartition(), which derives a leaf count of K^floor(log_K(N)) from N and K alone.
+  const size_t numRealLeaves = (numPrimitives + a_targetLeafSize - 1) / a_targetLeafSize;
+
+  std::vector<BV> leafBVs(numRealLeaves);
+
+  Parallel::parallelFor(0, numRealLeaves, grainSize / a_targetLeafSize + 1, [&](size_t a_lo, size_t a_hi) {
+    std::vector<BV> primBVs;
+
+    for (size_t leaf = a_lo; leaf < a_hi; leaf++) {
+      const size_t begin = leaf * a_targetLeafSize;
+      const size_t end   = std::min(begin + a_targetLeafSize, numPrimitives);
+
+      primBVs.clear();
+      for (size_t i = begin; i < end; i++) {
+        primBVs.push_back(a_primsAndBVs[sorted[i]].second);
+      }
+
+      leafBVs[leaf] = BV(primBVs);
+    }
+  });
+
+  // Populate the primitive array once, in final sorted order -- independent of the order the node array below is
+  // written in.
+  auto primBlock = std::make_shared<std::vector<P>>();
+
+  if constexpr (std::is_default_constructible_v<P>) {
+    primBlock->resize(numPrimitives);
+
+    Parallel::parallelFor(0, numPrimitives, grainSize, [&](size_t a_lo, size_t a_hi) {
+      for (size_t i = a_lo; i < a_hi; i++) {
+        (*primBlock)[i] = std::move(a_primsAndBVs[sorted[i]].first);
+      }
+    });
+  }
+  else {
+    primBlock->reserve(numPrimitives);
+
+    for (size_t i = 0; i < numPrimitives; i++) {
+      primBlock->push_back(std::move(a_primsAndBVs[sorted[i]].first));
+    }
+  }
+
+  a_primsAndBVs.clear();
+
+  StoragePolicy::appendAliased(m_primitives, primBlock);
+
+  // The hierarchy is built level by level over the leaves: level D holds the numRealLeaves leaves, and each level
+  // above groups K consecutive nodes of the level below under one parent, until a single root remains. Only the last
+  // node of a level can have fewer than K children; its unused slots stay BVH::EmptyChild, so no placeholder leaves
+  // are emitted -- see the constructor's doxygen comment. If that last node would get a single child, it is left out
+  // and the child takes its place in the parent.
+  //
+  // Because the shape is fixed by numRealLeaves alone, every node's depth-first pre-order index follows in closed
+  // form from its level and its position on that level. Each level is therefore written straight into
+  // m_linearNodes in parallel, Karras-style, with no serial merge and no relayout pass: bounding volumes
+  // bottom-up (a node needs its children's), node records top-down.
+  std::vector<size_t> levelSize(1, numRealLeaves);
+
+  while (levelSize.back() > 1) {
+    levelSize.push_back((levelSize.back() + K - 1) / K);
+  }
+
+  std::reverse(levelSize.begin(), levelSize.end());
+
+  const size_t depth = levelSize.size() - 1;
+
+  // levelBVs[l][j] is the bounding volume of the j-th node on level l.
+  std::vector<std::vector<BV>> levelBVs(depth + 1);
+
+  levelBVs[depth] = std::move(leafBVs);
+
+  for (size_t l = depth; l > 0; l--) {
+    const auto& childBVs = levelBVs[l];
+    auto&       bvs      = levelBVs[l - 1];
+
+    bvs.resize(levelSize[l - 1]);
+
+    Parallel::parallelFor(0, bvs.size(), grainSize / K + 1, [&](size_t a_lo, size_t a_hi) {
+      for (size_t j = a_lo; j < a_hi; j++) {
+        const size_t first = j * K;
+        const size_t last  = std::min(first + K, childBVs.size());
+
+        bvs[j] = BV(std::vector<BV>(childBVs.begin() + long(first), childBVs.begin() + long(last)));
+      }
+    });
+  }
+
+  // isLone[l] is true if the last node on level l has a single child. The root never does, since the level below
+  // it has more than one node.
+  std::vector<bool> isLone(depth + 1, false);
+
+  for (size_t l = 0; l < depth; l++) {
+    isLone[l] = levelSize[l + 1] == (levelSize[l] - 1) * K + 1;
+  }
+
+  const auto isDropped = [&levelSize, &isLone](size_t a_level, size_t a_position) noexcept -> bool {
+    return isLone[a_level] && a_position + 1 == levelSize[a_level];
+  };
+
+  // Pre-order index of the j-th node on level l: the nodes visited before it are its ancestors and everything to
+  // their left on the levels above, the nodes to its left on its own level, and on every level below the
+  // descendants of those left neighbours. A dropped node is the last on its level, so its subtree is at the end of
+  // the array, and dropping it moves only its descendants up by one.
+  const auto preOrderIndex = [&levelSize, &isLone, depth](size_t a_level, size_t a_position) noexcept -> uint32_t {
+    size_t index = a_position;
+    size_t below = 1;
+
+    for (size_t l = a_level; l > 0; l--) {
+      below *= K;
+      index += a_position / below + 1;
+    }
+
+    size_t first = a_position;
+
+    for (size_t l = a_level + 1; l <= depth; l++) {
+      first = std::min(first * K, levelSize[l]);
+      index += first;
+    }
+
+    for (size_t l = 0; l < a_level; l++) {
+      size_t firstDescendant = levelSize[l] - 1;
+
+      for (size_t m = l; m < a_level; m++) {
+        firstDescendant *= K;
+      }
+
+      index -= (isLone[l] && a_position >= firstDescendant) ? 1 : 0;
+    }
+
+    return static_cast<uint32_t>(index);
+  };
+
+  const size_t numDropped = size_t(std::count(isLone.begin(), isLone.end(), true));
+
+  std::vector<NodeView> nodes(std::accumulate(levelSize.begin(), levelSize.end(), size_t(0)) - numDropped);
+
+  for (size_t l = 0; l <= depth; l++) {
+    Parallel::parallelFor(0, levelSize[l], grainSize / K + 1, [&, l](size_t a_lo, size_t a_hi) noexcept {
+      for (size_t j = a_lo; j < a_hi; j++) {
+        if (isDropped(l, j)) {
+          continue;
+        }
+
+        NodeView& node = nodes[preOrderIndex(l, j)];
+
+        node.setBoundingVolume(levelBVs[l][j]);
+
+        if (l == depth) {
+          const size_t begin = j * a_targetLeafSize;
+
+          node.setPrimitivesOffset(static_cast<uint32_t>(begin));
+          node.setNumPrimitives(static_cast<uint32_t>(std::min(a_targetLeafSize, numPrimitives - begin)));
+        }
+        else {
+          for (size_t c = 0; c < K && j * K + c < levelSize[l + 1]; c++) {
+            size_t childLevel    = l + 1;
+            size_t childPosition = j * K + c;
+
+            // A dropped child is replaced by its only child, and so on down.
+            while (isDropped(childLevel, childPosition)) {
+              childLevel++;
+              childPosition *= K;
+            }
+
+            node.setChildOffset(preOrderIndex(childLevel, childPosition), c);
+          }
+        }
+      }
+    });
+  }
+
+  this->packNodes(nodes);
+}
+
+template <class T, class P, size_t K, class StoragePolicy>
+inline PackedBVH<T, P, K, StoragePolicy>::PackedBVH(std::vector<std::pair<P, BV>>          a_primsAndBVs,
+                                                    const BVH::Partitioner<P, BV, K>&      a_partitioner,
+                                                    const BVH::LeafPredicate<T, P, BV, K>& a_stopCrit)
+{
+  EBGEOMETRY_EXPECT(!a_primsAndBVs.empty());
+
+  // shared_ptr-wrap each primitive once, up front, so the existing Partitioner/LeafPredicate
+  // machinery (which operates on PrimAndBVList) can be reused unchanged. This is not the cost
+  // this constructor targets -- see its doxygen comment -- only the persistent, per-node
+  // shared_ptr<TreeBVH> allocation is avoided.
+  BVH::PrimAndBVList<P, BV> wrapped;
+
+  wrapped.reserve(a_primsAndBVs.size());
+
+  for (auto& pbv : a_primsAndBVs) {
+    wrapped.emplace_back(std::make_shared<P>(std::move(pbv.first)), pbv.second);
+  }
+
+  a_primsAndBVs.clear();
+
+  // Recursively partition top-down, writing nodes in pre-order (root first) as the recursion unwinds -- top-down
+  // partitioning visits the root before its children, so no relayout pass is needed here. At every split, a lightweight, stack-local TreeBVH ("probe") is constructed purely to
+  // evaluate a_stopCrit (whose signature expects an actual TreeBVH node, matching
+  // TreeBVH::topDownSortAndPartition()'s own contract) and to read off its primitive list; it is discarded
+  // immediately afterward, never linked into a persistent tree.
+  //
+  // Sibling subtrees of a large enough node are independent, so they are built concurrently, each into its own
+  // Subtree with node and primitive offsets relative to itself. Appending them to the parent in child order and
+  // rebasing those offsets yields exactly the arrays the serial recursion writes.
+  struct Subtree
+  {
+    std::vector<NodeView>    nodes;
+    std::vector<StorageType> primitives;
+  };
+
+  std::function<uint32_t(BVH::PrimAndBVList<P, BV>, Subtree&)> build =
+    [&](BVH::PrimAndBVList<P, BV> a_prims, Subtree& a_out) -> uint32_t {
+    const uint32_t idx = static_cast<uint32_t>(a_out.nodes.size());
+
+    a_out.nodes.push_back({});
+
+    const BVH::TreeBVH<T, P, BV, K> probe(a_prims);
+
+    a_out.nodes[idx].setBoundingVolume(probe.getBoundingVolume());
+
+    if (a_stopCrit(probe) || a_prims.size() < K) {
+      const auto& leafPrims = probe.getPrimitives();
+
+      a_out.nodes[idx].setPrimitivesOffset(static_cast<uint32_t>(a_out.primitives.size()));
+      a_out.nodes[idx].setNumPrimitives(static_cast<uint32_t>(leafPrims.size()));
+
+      StoragePolicy::appendTreeLeaf(a_out.primitives, leafPrims);
+    }
+    else {
+      const bool forkChildren = a_prims.size() >= BVH::ParallelBuildThreshold && Parallel::getNumThreads() > 1;
+
+      // The partitioner takes its list by value and moves the sub-lists out; a_prims is not used
+      // after this, so move it in, and move each child sub-list into the recursion.
+      std::array<BVH::PrimAndBVList<P, BV>, K> children = a_partitioner(std::move(a_prims));
+
+      if (forkChildren) {
+        std::array<Subtree, K> subtrees;
+
+        {
+          Parallel::TaskGroup group;
+
+          for (size_t k = 1; k < K; k++) {
+            group.run([&, k]() { build(std::move(children[k]), subtrees[k]); });
+          }
+
+          build(std::move(children[0]), subtrees[0]);
+
+          group.wait();
+        }
+
+        for (size_t k = 0; k < K; k++) {
+          const uint32_t nodeBase = static_cast<uint32_t>(a_out.nodes.size());
+          const uint32_t primBase = static_cast<uint32_t>(a_out.primitives.size());
+
+          for (NodeView node : subtrees[k].nodes) {
+            if (node.isLeaf()) {
+              node.setPrimitivesOffset(node.getPrimitivesOffset() + primBase);
+            }
+            else {
+              for (size_t c = 0; c < node.getNumChildren(); c++) {
+                node.setChildOffset(node.getChildOffsets()[c] + nodeBase, c);
+              }
+            }
+
+            a_out.nodes.push_back(node);
+          }
+
+          a_out.primitives.insert(a_out.primitives.end(),
+                                  std::make_move_iterator(subtrees[k].primitives.begin()),
+                                  std::make_move_iterator(subtrees[k].primitives.end()));
+
+          a_out.nodes[idx].setChildOffset(nodeBase, k);
+
+          subtrees[k] = Subtree();
+        }
+      }
+      else {
+        for (size_t k = 0; k < K; k++) {
+          const uint32_t childIdx = build(std::move(children[k]), a_out);
+          a_out.nodes[idx].setChildOffset(childIdx, k);
+        }
+      }
+    }
+
+    return idx;
+  };
+
+  Subtree tree;
+
+  build(std::move(wrapped), tree);
+
+  m_primitives = std::move(tree.primitives);
+
+  this->packNodes(tree.nodes);
+}
+
+template <class T, class P, size_t K, class StoragePolicy>
+inline PackedBVH<T, P, K, StoragePolicy>::PackedBVH(std::vector<std::pair<P, BV>> a_primsAndBVs,
+                                                    BVH::ClusterSpec              a_spec)
+{
+  static_assert(std::is_same_v<BV, EBGeometry::BoundingVolumes::AABBT<T>>, "ClusterSAH requires BV == AABBT<T>");
+
+  EBGEOMETRY_EXPECT(!a_primsAndBVs.empty());
+  EBGEOMETRY_EXPECT(a_spec.maxClusterSize > 0);
+
+  const size_t maxC = a_spec.maxClusterSize;
+
+  // A cluster: its bounding volume, centroid, and the primitives it owns (moved in).
+  struct Cluster
+  {
+    BV                            bv;
+    Vec3T<T>                      centroid;
+    std::vector<std::pair<P, BV>> prims;
+  };
+
+  // ---- Phase 1: density-adaptive clustering --------------------------------------------------
+  // Recursively split a_primsAndBVs[begin, end) at the midpoint of its centroid bounding box (longest
+  // axis) until a range holds at most maxC primitives, then freeze it as a cluster. The midpoint
+  // splits are cheap, the subdivision is shallow, and it follows the primitive density (fine where
+  // dense, coarse where sparse), so no cluster overcrowds -- robust where a fixed grid would fail.
+  std::vector<Cluster> clusters;
+  clusters.reserve(a_primsAndBVs.size() / maxC + 1);
+
+  std::function<void(size_t, size_t)> makeClusters = [&](size_t a_begin, size_t a_end) -> void {
+    if (a_end - a_begin <= maxC) {
+      Cluster cluster;
+      cluster.prims.reserve(a_end - a_begin);
+
+      Vec3T<T> lo = +Vec3T<T>::max();
+      Vec3T<T> hi = -Vec3T<T>::max();
+      for (size_t i = a_begin; i < a_end; i++) {
+        lo = min(lo, a_primsAndBVs[i].second.getLowCorner());
+        hi = max(hi, a_primsAndBVs[i].second.getHighCorner());
+        cluster.prims.push_back(std::move(a_primsAndBVs[i]));
+      }
+      cluster.bv       = BV(lo, hi);
+      cluster.centroid = cluster.bv.getCentroid();
+
+      clusters.push_back(std::move(cluster));
+
+      return;
+    }
+
+    Vec3T<T> clo = +Vec3T<T>::max();
+    Vec3T<T> chi = -Vec3T<T>::max();
+    for (size_t i = a_begin; i < a_end; i++) {
+      const auto& c = a_primsAndBVs[i].second.getCentroid();
+      clo           = min(clo, c);
+      chi           = max(chi, c);
+    }
+
+    const size_t axis = (chi - clo).maxDir(true);
+    const T      mid  = T(0.5) * (clo[axis] + chi[axis]);
+
+    const auto pivot = std::partition(
+      a_primsAndBVs.begin() + a_begin,
+      a_primsAndBVs.begin() + a_end,
+      [axis, mid](const std::pair<P, BV>& a_pb) noexcept { return a_pb.second.getCentroid()[axis] < mid; });
+
+    size_t split = static_cast<size_t>(pivot - a_primsAndBVs.begin());
+    if (split == a_begin || split == a_end) {
+      split = a_begin + (a_end - a_begin) / 2; // all centroids on one side: fall back to equal counts
+    }
+
+    makeClusters(a_begin, split);
+    makeClusters(split, a_end);
+  };
+  makeClusters(0, a_primsAndBVs.size());
+  a_primsAndBVs.clear();
+
+  // ---- Phase 2: binned SAH over the clusters -------------------------------------------------
+  // A self-contained 2-way binned SAH over clusters[begin, end) -- mirrors SAH2WaySplit but over
+  // cluster boxes, deliberately isolated so the primitive SAH path is untouched. Partitions the
+  // clusters in place and returns the split index.
+  constexpr int BINS = 32;
+
+  const auto sah2Way = [&clusters](size_t a_begin, size_t a_end) noexcept -> size_t {
+    const size_t nClusters = a_end - a_begin;
+
+    Vec3T<T> clo = +Vec3T<T>::max();
+    Vec3T<T> chi = -Vec3T<T>::max();
+    for (size_t i = a_begin; i < a_end; i++) {
+      clo = min(clo, clusters[i].centroid);
+      chi = max(chi, clusters[i].centroid);
+    }
+
+    T   bestCost  = std::numeric_limits<T>::max();
+    T   bestPlane = T(0);
+    int bestAxis  = -1;
+
+    Vec3T<T> binLo[BINS];
+    Vec3T<T> binHi[BINS];
+    int      binCnt[BINS];
+    T        leftArea[BINS - 1];
+    int      leftCnt[BINS - 1];
+
+    for (int axis = 0; axis < 3; axis++) {
+      const T lo  = clo[axis];
+      const T hi  = chi[axis];
+      const T ext = hi - lo;
+      if (ext <= T(0)) {
+        continue;
+      }
+      const T scale = T(BINS) / ext;
+
+      for (int b = 0; b < BINS; b++) {
+        binLo[b]  = Vec3T<T>::max();
+        binHi[b]  = -Vec3T<T>::max();
+        binCnt[b] = 0;
+      }
+      for (size_t i = a_begin; i < a_end; i++) {
+        const int b = std::min(BINS - 1, static_cast<int>((clusters[i].centroid[axis] - lo) * scale));
+        binLo[b]    = min(binLo[b], clusters[i].bv.getLowCorner());
+        binHi[b]    = max(binHi[b], clusters[i].bv.getHighCorner());
+        binCnt[b]   = binCnt[b] + 1;
+      }
+
+      Vec3T<T> rlo = +Vec3T<T>::max();
+      Vec3T<T> rhi = -Vec3T<T>::max();
+
+      int rcnt = 0;
+
+      for (int b = 0; b < BINS - 1; b++) {
+        if (binCnt[b] > 0) {
+          rlo = min(rlo, binLo[b]);
+          rhi = max(rhi, binHi[b]);
+        }
+        rcnt        = rcnt + binCnt[b];
+        leftArea[b] = (rcnt > 0) ? BV(rlo, rhi).getArea() : T(0);
+        leftCnt[b]  = rcnt;
+      }
+
+      Vec3T<T> rrlo = +Vec3T<T>::max();
+      Vec3T<T> rrhi = -Vec3T<T>::max();
+
+      int rrcnt = 0;
+
+      for (int b = BINS - 1; b >= 1; b--) {
+        if (binCnt[b] > 0) {
+          rrlo = min(rrlo, binLo[b]);
+          rrhi = max(rrhi, binHi[b]);
+        }
+
+        rrcnt += binCnt[b];
+
+        if (leftCnt[b - 1] > 0 && rrcnt > 0) {
+          const T cost = leftArea[b - 1] * T(leftCnt[b - 1]) + BV(rrlo, rrhi).getArea() * T(rrcnt);
+
+          if (cost < bestCost) {
+            bestCost  = cost;
+            bestAxis  = axis;
+            bestPlane = lo + static_cast<T>(b) / scale;
+          }
+        }
+      }
+    }
+
+    if (bestAxis < 0) {
+      return a_begin + nClusters / 2; // degenerate (all cluster centroids coincide): equal-count split
+    }
+
+    const auto pivot =
+      std::partition(clusters.begin() + a_begin,
+                     clusters.begin() + a_end,
+                     [bestAxis, bestPlane](const Cluster& a_c) noexcept { return a_c.centroid[bestAxis] < bestPlane; });
+    size_t split = static_cast<size_t>(pivot - clusters.begin());
+    if (split == a_begin || split == a_end) {
+      split = a_begin + nClusters / 2;
+    }
+    return split;
+  };
+
+  // K-way SAH split: recursively bisect into floor(K/2)/ceil(K/2), mirroring SAHKWaySplit.
+  std::function<void(size_t, size_t, size_t, std::vector<std::pair<size_t, size_t>>&)> sahKWay =
+    [&](size_t a_begin, size_t a_end, size_t a_K, std::vector<std::pair<size_t, size_t>>& a_groups) -> void {
+    if (a_K <= 1 || a_begin >= a_end) {
+      a_groups.emplace_back(a_begin, a_end);
+      return;
+    }
+
+    const size_t K1 = a_K / 2;
+    const size_t K2 = a_K - K1;
+
+    const size_t raw = sah2Way(a_begin, a_end);
+    const size_t mid = std::max(a_begin + K1, std::min(a_end - K2, raw));
+
+    sahKWay(a_begin, mid, K1, a_groups);
+    sahKWay(mid, a_end, K2, a_groups);
+  };
+
+  // Build the flat node array top-down (pre-order), populating the primitive block in DFS-leaf order
+  // so each leaf's primitives are a contiguous [offset, count) range.
+  auto primBlock = std::make_shared<std::vector<P>>();
+
+  size_t total = 0;
+
+  for (const auto& c : clusters) {
+    total += c.prims.size();
+  }
+
+  primBlock->reserve(total);
+
+  std::vector<NodeView> nodes;
+
+  std::function<uint32_t(size_t, size_t)> build = [&](size_t a_begin, size_t a_end) -> uint32_t {
+    const uint32_t idx = static_cast<uint32_t>(nodes.size());
+    nodes.push_back({});
+
+    Vec3T<T> nlo = +Vec3T<T>::max();
+    Vec3T<T> nhi = -Vec3T<T>::max();
+
+    for (size_t i = a_begin; i < a_end; i++) {
+      nlo = min(nlo, clusters[i].bv.getLowCorner());
+      nhi = max(nhi, clusters[i].bv.getHighCorner());
+    }
+
+    nodes[idx].setBoundingVolume(BV(nlo, nhi));
+
+    if (a_end - a_begin <= 1) {
+      // Leaf: a single cluster -- append its primitives to the block, contiguously.
+      nodes[idx].setPrimitivesOffset(static_cast<uint32_t>(primBlock->size()));
+
+      uint32_t count = 0;
+
+      for (size_t i = a_begin; i < a_end; i++) {
+        for (auto& pb : clusters[i].prims) {
+          primBlock->push_back(std::move(pb.first));
+          count++;
+        }
+      }
+      nodes[idx].setNumPrimitives(count);
+    }
+    else {
+      // Fewer than K clusters give a node with one child per cluster; the remaining slots stay empty.
+      std::vector<std::pair<size_t, size_t>> groups;
+      groups.reserve(K);
+      sahKWay(a_begin, a_end, std::min(K, a_end - a_begin), groups);
+
+      for (size_t k = 0; k < groups.size(); k++) {
+        const uint32_t childIdx = build(groups[k].first, groups[k].second);
+        nodes[idx].setChildOffset(childIdx, k);
+      }
+    }
+
+    return idx;
+  };
+  build(0, clusters.size());
+
+  StoragePolicy::appendAliased(m_primitives, primBlock);
+
+  this->packNodes(nodes);
+}
+
+template <class T, class P, size_t K, class StoragePolicy>
+inline const std::vector<typename PackedBVH<T, P, K, StoragePolicy>::StorageType>&
+PackedBVH<T, P, K, StoragePolicy>::getPrimitives() const noexcept
+{
+  if (this->isMapped()) {
+    std::cerr << "PackedBVH::getPrimitives -- Warning! A mapped tree keeps its primitives in the mapping, use "
+                 "getPrimitiveData() instead\n";
+  }
+
+  return m_primitives;
+}
+
+template <class T, class P, size_t K, class StoragePolicy>
+inline bool
+PackedBVH<T, P, K, StoragePolicy>::isMapped() const noexcept
+{
+  return m_mapping != nullptr;
+}
+
+template <class T, class P, size_t K, class StoragePolicy>
+inline const typename PackedBVH<T, P, K, StoragePolicy>::StorageType*
+PackedBVH<T, P, K, StoragePolicy>::getPrimitiveData() const noexcept
+{
+  return m_mapping ? m_mapped.primitives : m_primitives.data();
+}
+
+template <class T, class P, size_t K, class StoragePolicy>
+inline size_t
+PackedBVH<T, P, K, StoragePolicy>::getNumPrimitives() const noexcept
+{
+  return m_mapping ? m_mapped.numPrimitives : m_primitives.size();
+}
+
+template <class T, class P, size_t K, class StoragePolicy>
+inline const typename PackedBVH<T, P, K, StoragePolicy>::Node*
+PackedBVH<T, P, K, StoragePolicy>::getNodeData() const noexcept
+{
+  return m_mapping ? m_mapped.nodes : m_linearNodes.data();
+}
+
+template <class T, class P, size_t K, class StoragePolicy>
+inline const typename PackedBVH<T, P, K, StoragePolicy>::ChildAABBSoA*
+PackedBVH<T, P, K, StoragePolicy>::getChildAabbData() const noexcept
+{
+  return m_mapping ? m_mapped.childAabbSoA : m_childAabbSoA.data();
+}
+
+template <class T, class P, size_t K, class StoragePolicy>
+inline const typename PackedBVH<T, P, K, StoragePolicy>::Leaf*
+PackedBVH<T, P, K, StoragePolicy>::getLeafData() const noexcept
+{
+  return m_mapping ? m_mapped.leaves : m_leaves.data();
+}
+
+template <class T, class P, size_t K, class StoragePolicy>
+inline size_t
+PackedBVH<T, P, K, StoragePolicy>::getNumLeaves() const noexcept
+{
+  return m_mapping ? m_mapped.numLeaves : m_leaves.size();
+}
+
+template <class T, class P, size_t K, class StoragePolicy>
+inline size_t
+PackedBVH<T, P, K, StoragePolicy>::getNumNodes() const noexcept
+{
+  return m_mapping ? m_mapped.numNodes : m_linearNodes.size();
+}
+
+template <class T, class P, size_t K, class StoragePolicy>
+inline size_t
+PackedBVH<T, P, K, StoragePolicy>::getNumInteriorNodes() const noexcept
+{
+  return m_mapping ? m_mapped.numInteriorNodes : m_childAabbSoA.size();
+}
+
+template <class T, class P, size_t K, class StoragePolicy>
+inline const EBGeometry::BoundingVolumes::AABBT<T>&
+PackedBVH<T, P, K, StoragePolicy>::getBoundingVolume() const noexcept
+{
+  return m_bv;
+}
+
+template <class T, class P, size_t K, class StoragePolicy>
+inline EBGeometry::BoundingVolumes::AABBT<T>
+PackedBVH<T, P, K, StoragePolicy>::computeBoundingVolume() const noexcept
+{
+  return m_bv;
+}
+
+template <class T, class P, size_t K, class StoragePolicy>
+template <class NodeKey>
+inline void
+PackedBVH<T, P, K, StoragePolicy>::traverse(
+  const BVH::PackedLeafEvaluator<P, StoragePolicy>& a_leafEvaluator,
+  const BVH::PrunePredicate<NodeView, NodeKey>&     a_prunePredicate,
+  const BVH::PackedChildOrderer<NodeKey, K>&        a_childOrderer,
+  const BVH::NodeKeyFactory<NodeView, NodeKey>&     a_nodeKeyFactory) const noexcept
+{
+  const Node* const        nodes      = this->getNodeData();
+  const StorageType* const primitives = this->getPrimitiveData();
+
+  // A node's box lives in a slot of its parent's SoA record, so a stack entry remembers that record and slot
+  // (NoParent for the root, whose box the tree keeps itself).
+  struct StackEntry
+  {
+    uint32_t idx;
+    uint32_t record;
+    uint32_t slot;
+    NodeKey  key;
+  };
+
+  const auto getView = [this, nodes](const uint32_t a_idx, const uint32_t a_record, const size_t a_slot) noexcept {
+    return this->getNodeView(nodes[a_idx],
+                             (a_record == NoParent) ? this->getBoundingVolume()
+                                                    : this->getChildBoundingVolume(a_record, a_slot));
+  };
+
+  std::array<std::pair<uint32_t, NodeKey>, K> children;
+
+  // Vector-backed stack avoids deque chunk allocations; reserve avoids reallocs.
+  std::vector<StackEntry> q;
+
+  q.reserve(64);
+  q.push_back({0U, NoParent, 0U, a_nodeKeyFactory(getView(0U, NoParent, 0))});
+
+  Detail::TraversalCounter counter;
+
+  while (!q.empty()) {
+    const StackEntry entry = q.back();
+    q.pop_back();
+
+    const NodeView node = getView(entry.idx, entry.record, entry.slot);
+
+    if (a_prunePredicate(node, entry.key)) {
+      counter.visitNode();
+
+      if (node.isLeaf()) {
+        counter.visitLeaf(node.getNumPrimitives());
+        a_leafEvaluator(primitives, node.getPrimitivesOffset(), node.getNumPrimitives());
+      }
+      else {
+        const uint32_t record = nodes[entry.idx].getChildBoxesIndex();
+
+        for (size_t k = 0; k < K; k++) {
+          const uint32_t childIdx = node.getChildOffsets()[k];
+          children[k].first       = childIdx;
+          children[k].second = (childIdx == EmptyChild) ? NodeKey{} : a_nodeKeyFactory(getView(childIdx, record, k));
+        }
+
+        a_childOrderer(children);
+
+        for (const auto& child : children) {
+          if (child.first != EmptyChild) {
+            const size_t slot = getChildSlot(nodes[entry.idx], child.first);
+
+            q.push_back({child.first, record, static_cast<uint32_t>(slot), child.second});
+          }
+        }
+      }
+    }
+  }
+}
+
+template <class T, class P, size_t K, class StoragePolicy>
+template <class State, class LeafEvaluator, class PruneDistSquared>
+inline void
+PackedBVH<T, P, K, StoragePolicy>::pruneTraverse(const Vec3T<T>&    a_point,
+                                                 State&             a_state,
+                                                 LeafEvaluator&&    a_evalLeaf,
+                                                 PruneDistSquared&& a_pruneDist2) const noexcept
+{
+  struct StackEntry
+  {
+    uint32_t idx;
+    T        dist2;
+  };
+
+  // Unused when no SIMD path is compiled in and the scalar fallback below runs instead.
+  [[maybe_unused]] const Node* const         nodes        = this->getNodeData();
+  [[maybe_unused]] const ChildAABBSoA* const childAabbSoA = this->getChildAabbData();
+  [[maybe_unused]] const Leaf* const         leaves       = this->getLeafData();
+
+  // ──────────────────────────────────────────────────────────────────────────────
+  // AVX-512F paths: K==8/double and K==16/float.
+  //
+  // When compiled with -mavx512f these are selected in preference to the AVX
+  // paths below because they appear first and each path ends with a return.
+  // The compiler will dead-code-eliminate the corresponding AVX branches.
+  //
+  // Alignment: ChildAABBSoA uses alignas(sizeof(T)*K), which equals 64 bytes
+  // for both (K=8, T=double) and (K=16, T=float).  _mm512_load_pd / _mm512_load_ps
+  // both require 64-byte alignment — the static_assert below catches any mismatch.
+  //
+  // Recommended configurations on AVX-512 hardware:
+  //   float  → K=16, W=16  (one _mm512_load_ps covers all children and one leaf group)
+  //   double → K=8,  W=8   (one _mm512_load_pd covers all children; AVX-512F replaces
+  //                          the 2×_mm256_load_pd emulation in the AVX fallback below)
+  // ──────────────────────────────────────────────────────────────────────────────
+#if defined(__AVX512F__)
+  if constexpr (K == 8 && std::is_same_v<T, double>) {
+    static_assert(alignof(ChildAABBSoA) == sizeof(T) * K,
+                  "ChildAABBSoA alignment mismatch: _mm512_load_pd requires 64-byte alignment");
+
+    const __m512d px   = _mm512_set1_pd(a_point[0]);
+    const __m512d py   = _mm512_set1_pd(a_point[1]);
+    const __m512d pz   = _mm512_set1_pd(a_point[2]);
+    const __m512d zero = _mm512_setzero_pd();
+
+    alignas(64) StackEntry stack[256];
+
+    Detail::TraversalCounter counter;
+
+    int top      = 0;
+    stack[top++] = {0U, 0.0};
+
+    while (top > 0) {
+      const StackEntry entry    = stack[--top];
+      const double     curBest2 = static_cast<double>(a_pruneDist2(a_state));
+
+      if (entry.dist2 > curBest2) {
+        continue;
+      }
+
+      const Node& node = nodes[entry.idx];
+
+      counter.visitNode();
+
+      if (node.isLeaf()) {
+        const Leaf& leaf = leaves[node.getLeafIndex()];
+
+        counter.visitLeaf(leaf.m_numPrims);
+        a_evalLeaf(a_state, leaf.m_primOff, leaf.m_numPrims);
+      }
+      else {
+        const auto& soa = childAabbSoA[node.getChildBoxesIndex()];
+
+        const __m512d lo_x = _mm512_load_pd(soa.m_lo[0]);
+        const __m512d lo_y = _mm512_load_pd(soa.m_lo[1]);
+        const __m512d lo_z = _mm512_load_pd(soa.m_lo[2]);
+        const __m512d hi_x = _mm512_load_pd(soa.m_hi[0]);
+        const __m512d hi_y = _mm512_load_pd(soa.m_hi[1]);
+        const __m512d hi_z = _mm512_load_pd(soa.m_hi[2]);
+
+        const __m512d dx = _mm512_max_pd(zero, _mm512_max_pd(_mm512_sub_pd(lo_x, px), _mm512_sub_pd(px, hi_x)));
+        const __m512d dy = _mm512_max_pd(zero, _mm512_max_pd(_mm512_sub_pd(lo_y, py), _mm512_sub_pd(py, hi_y)));
+        const __m512d dz = _mm512_max_pd(zero, _mm512_max_pd(_mm512_sub_pd(lo_z, pz), _mm512_sub_pd(pz, hi_z)));
+        const __m512d d2 =
+          _mm512_add_pd(_mm512_mul_pd(dx, dx), _mm512_add_pd(_mm512_mul_pd(dy, dy), _mm512_mul_pd(dz, dz)));
+
+        alignas(64) double dist2[K];
+        _mm512_store_pd(dist2, d2);
+
+        const auto&                                offsets = node.getChildOffsets();
+        std::array<std::pair<double, uint32_t>, K> children;
+
+        for (size_t k = 0; k < K; k++) {
+          children[k] = {dist2[k], offsets[k]};
+        }
+
+        std::sort(children.begin(),
+                  children.end(),
+                  [](const std::pair<double, uint32_t>& a, const std::pair<double, uint32_t>& b) noexcept {
+                    return a.first > b.first;
+                  });
+
+        const double newBest2 = static_cast<double>(a_pruneDist2(a_state));
+
+        for (const auto& [d, idx] : children) {
+          if (d <= newBest2 && idx != EmptyChild) {
+            stack[top++] = {idx, d};
+          }
+        }
+      }
+    }
+
+    return;
+  }
+
+  if constexpr (K == 16 && std::is_same_v<T, float>) {
+    static_assert(alignof(ChildAABBSoA) == sizeof(T) * K,
+                  "ChildAABBSoA alignment mismatch: _mm512_load_ps requires 64-byte alignment");
+
+    const __m512 px   = _mm512_set1_ps((float)a_point[0]);
+    const __m512 py   = _mm512_set1_ps((float)a_point[1]);
+    const __m512 pz   = _mm512_set1_ps((float)a_point[2]);
+    const __m512 zero = _mm512_setzero_ps();
+
+    alignas(64) StackEntry stack[256];
+
+    Detail::TraversalCounter counter;
+
+    int top      = 0;
+    stack[top++] = {0U, 0.f};
+
+    while (top > 0) {
+      const StackEntry entry    = stack[--top];
+      const float      curBest2 = static_cast<float>(a_pruneDist2(a_state));
+
+      if (entry.dist2 > curBest2) {
+        continue;
+      }
+
+      const Node& node = nodes[entry.idx];
+
+      counter.visitNode();
+
+      if (node.isLeaf()) {
+        const Leaf& leaf = leaves[node.getLeafIndex()];
+
+        counter.visitLeaf(leaf.m_numPrims);
+        a_evalLeaf(a_state, leaf.m_primOff, leaf.m_numPrims);
+      }
+      else {
+        const auto& soa = childAabbSoA[node.getChildBoxesIndex()];
+
+        const __m512 lo_x = _mm512_load_ps(soa.m_lo[0]);
+        const __m512 lo_y = _mm512_load_ps(soa.m_lo[1]);
+        const __m512 lo_z = _mm512_load_ps(soa.m_lo[2]);
+        const __m512 hi_x = _mm512_load_ps(soa.m_hi[0]);
+        const __m512 hi_y = _mm512_load_ps(soa.m_hi[1]);
+        const __m512 hi_z = _mm512_load_ps(soa.m_hi[2]);
+
+        const __m512 dx = _mm512_max_ps(zero, _mm512_max_ps(_mm512_sub_ps(lo_x, px), _mm512_sub_ps(px, hi_x)));
+        const __m512 dy = _mm512_max_ps(zero, _mm512_max_ps(_mm512_sub_ps(lo_y, py), _mm512_sub_ps(py, hi_y)));
+        const __m512 dz = _mm512_max_ps(zero, _mm512_max_ps(_mm512_sub_ps(lo_z, pz), _mm512_sub_ps(pz, hi_z)));
+        const __m512 d2 =
+          _mm512_add_ps(_mm512_mul_ps(dx, dx), _mm512_add_ps(_mm512_mul_ps(dy, dy), _mm512_mul_ps(dz, dz)));
+
+        alignas(64) float dist2[K];
+        _mm512_store_ps(dist2, d2);
+
+        const auto&                               offsets = node.getChildOffsets();
+        std::array<std::pair<float, uint32_t>, K> children;
+
+        for (size_t k = 0; k < K; k++) {
+          children[k] = {dist2[k], offsets[k]};
+        }
+
+        std::sort(children.begin(),
+                  children.end(),
+                  [](const std::pair<float, uint32_t>& a, const std::pair<float, uint32_t>& b) noexcept {
+                    return a.first > b.first;
+                  });
+
+        const float newBest2 = static_cast<float>(a_pruneDist2(a_state));
+
+        for (const auto& [d, idx] : children) {
+          if (d <= newBest2 && idx != EmptyChild) {
+            stack[top++] = {idx, d};
+          }
+        }
+      }
+    }
+
+    return;
+  }
+#endif // __AVX512F__
+
+  // ──────────────────────────────────────────────────────────────────────────────
+  // AVX paths: K==4/double (single pass), K==8/float (single pass),
+  //            K==8/double (two 4-wide passes — superseded by AVX-512F above).
+  // ──────────────────────────────────────────────────────────────────────────────
+#if defined(__AVX__)
+  if constexpr (K == 4 && std::is_same_v<T, double>) {
+    static_assert(alignof(ChildAABBSoA) == sizeof(T) * K,
+                  "ChildAABBSoA alignment mismatch: _mm256_load_pd requires 32-byte alignment");
+
+    const __m256d px   = _mm256_set1_pd(a_point[0]);
+    const __m256d py   = _mm256_set1_pd(a_point[1]);
+    const __m256d pz   = _mm256_set1_pd(a_point[2]);
+    const __m256d zero = _mm256_setzero_pd();
+
+    alignas(32) StackEntry stack[256];
+
+    Detail::TraversalCounter counter;
+
+    int top      = 0;
+    stack[top++] = {0U, 0.0};
+
+    while (top > 0) {
+      const StackEntry entry    = stack[--top];
+      const double     curBest2 = static_cast<double>(a_pruneDist2(a_state));
+
+      if (entry.dist2 > curBest2) {
+        continue;
+      }
+
+      const Node& node = nodes[entry.idx];
+
+      counter.visitNode();
+
+      if (node.isLeaf()) {
+        const Leaf& leaf = leaves[node.getLeafIndex()];
+
+        counter.visitLeaf(leaf.m_numPrims);
+        a_evalLeaf(a_state, leaf.m_primOff, leaf.m_numPrims);
+      }
+      else {
+        const auto& soa = childAabbSoA[node.getChildBoxesIndex()];
+
+        const __m256d lo_x = _mm256_load_pd(soa.m_lo[0]);
+        const __m256d lo_y = _mm256_load_pd(soa.m_lo[1]);
+        const __m256d lo_z = _mm256_load_pd(soa.m_lo[2]);
+        const __m256d hi_x = _mm256_load_pd(soa.m_hi[0]);
+        const __m256d hi_y = _mm256_load_pd(soa.m_hi[1]);
+        const __m256d hi_z = _mm256_load_pd(soa.m_hi[2]);
+
+        const __m256d dx = _mm256_max_pd(zero, _mm256_max_pd(_mm256_sub_pd(lo_x, px), _mm256_sub_pd(px, hi_x)));
+        const __m256d dy = _mm256_max_pd(zero, _mm256_max_pd(_mm256_sub_pd(lo_y, py), _mm256_sub_pd(py, hi_y)));
+        const __m256d dz = _mm256_max_pd(zero, _mm256_max_pd(_mm256_sub_pd(lo_z, pz), _mm256_sub_pd(pz, hi_z)));
+        const __m256d d2 =
+          _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_add_pd(_mm256_mul_pd(dy, dy), _mm256_mul_pd(dz, dz)));
+
+        alignas(32) double dist2[K];
+
+        _mm256_store_pd(dist2, d2);
+
+        const auto&                                offsets = node.getChildOffsets();
+        std::array<std::pair<double, uint32_t>, K> children;
+
+        for (size_t k = 0; k < K; k++) {
+          children[k] = {dist2[k], offsets[k]};
+        }
+
+        std::sort(children.begin(),
+                  children.end(),
+                  [](const std::pair<double, uint32_t>& a, const std::pair<double, uint32_t>& b) noexcept {
+                    return a.first > b.first;
+                  });
+
+        const double newBest2 = static_cast<double>(a_pruneDist2(a_state));
+
+        for (const auto& [d, idx] : children) {
+          if (d <= newBest2 && idx != EmptyChild) {
+            stack[top++] = {idx, d};
+          }
+        }
+      }
+    }
+
+    return;
+  }
+  if constexpr (K == 8 && std::is_same_v<T, float>) {
+    static_assert(alignof(ChildAABBSoA) == sizeof(T) * K,
+                  "ChildAABBSoA alignment mismatch: _mm256_load_ps requires 32-byte alignment");
+
+    const __m256 px   = _mm256_set1_ps((float)a_point[0]);
+    const __m256 py   = _mm256_set1_ps((float)a_point[1]);
+    const __m256 pz   = _mm256_set1_ps((float)a_point[2]);
+    const __m256 zero = _mm256_setzero_ps();
+
+    alignas(32) StackEntry stack[256];
+
+    Detail::TraversalCounter counter;
+
+    int top      = 0;
+    stack[top++] = {0U, 0.f};
+
+    while (top > 0) {
+      const StackEntry entry    = stack[--top];
+      const float      curBest2 = static_cast<float>(a_pruneDist2(a_state));
+
+      if (entry.dist2 > curBest2) {
+        continue;
+      }
+
+      const Node& node = nodes[entry.idx];
+
+      counter.visitNode();
+
+      if (node.isLeaf()) {
+        const Leaf& leaf = leaves[node.getLeafIndex()];
+
+        counter.visitLeaf(leaf.m_numPrims);
+        a_evalLeaf(a_state, leaf.m_primOff, leaf.m_numPrims);
+      }
+      else {
+        const auto& soa = childAabbSoA[node.getChildBoxesIndex()];
+
+        const __m256 lo_x = _mm256_load_ps(soa.m_lo[0]);
+        const __m256 lo_y = _mm256_load_ps(soa.m_lo[1]);
+        const __m256 lo_z = _mm256_load_ps(soa.m_lo[2]);
+        const __m256 hi_x = _mm256_load_ps(soa.m_hi[0]);
+        const __m256 hi_y = _mm256_load_ps(soa.m_hi[1]);
+        const __m256 hi_z = _mm256_load_ps(soa.m_hi[2]);
+
+        const __m256 dx = _mm256_max_ps(zero, _mm256_max_ps(_mm256_sub_ps(lo_x, px), _mm256_sub_ps(px, hi_x)));
+        const __m256 dy = _mm256_max_ps(zero, _mm256_max_ps(_mm256_sub_ps(lo_y, py), _mm256_sub_ps(py, hi_y)));
+        const __m256 dz = _mm256_max_ps(zero, _mm256_max_ps(_mm256_sub_ps(lo_z, pz), _mm256_sub_ps(pz, hi_z)));
+        const __m256 d2 =
+          _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_add_ps(_mm256_mul_ps(dy, dy), _mm256_mul_ps(dz, dz)));
+
+        alignas(32) float dist2[K];
+        _mm256_store_ps(dist2, d2);
+
+        const auto& offsets = node.getChildOffsets();
+
+        std::array<std::pair<float, uint32_t>, K> children;
+
+        for (size_t k = 0; k < K; k++) {
+          children[k] = {dist2[k], offsets[k]};
+        }
+
+        std::sort(children.begin(),
+                  children.end(),
+                  [](const std::pair<float, uint32_t>& a, const std::pair<float, uint32_t>& b) noexcept {
+                    return a.first > b.first;
+                  });
+
+        const float newBest2 = static_cast<float>(a_pruneDist2(a_state));
+
+        for (const auto& [d, idx] : children) {
+          if (d <= newBest2 && idx != EmptyChild) {
+            stack[top++] = {idx, d};
+          }
+        }
+      }
+    }
+
+    return;
+  }
+
+  if constexpr (K == 8 && std::is_same_v<T, double>) {
+    static_assert(alignof(ChildAABBSoA) == sizeof(T) * K,
+                  "ChildAABBSoA alignment mismatch: _mm256_load_pd requires 32-byte alignment");
+
+    const __m256d px   = _mm256_set1_pd(a_point[0]);
+    const __m256d py   = _mm256_set1_pd(a_point[1]);
+    const __m256d pz   = _mm256_set1_pd(a_point[2]);
+    const __m256d zero = _mm256_setzero_pd();
+
+    alignas(32) StackEntry stack[256];
+
+    Detail::TraversalCounter counter;
+
+    int top      = 0;
+    stack[top++] = {0U, 0.0};
+
+    while (top > 0) {
+      const StackEntry entry    = stack[--top];
+      const double     curBest2 = static_cast<double>(a_pruneDist2(a_state));
+
+      if (entry.dist2 > curBest2) {
+        continue;
+      }
+
+      const Node& node = nodes[entry.idx];
+
+      counter.visitNode();
+
+      if (node.isLeaf()) {
+        const Leaf& leaf = leaves[node.getLeafIndex()];
+
+        counter.visitLeaf(leaf.m_numPrims);
+        a_evalLeaf(a_state, leaf.m_primOff, leaf.m_numPrims);
+      }
+      else {
+        const auto& soa = childAabbSoA[node.getChildBoxesIndex()];
+
+        const __m256d lo_x0 = _mm256_load_pd(soa.m_lo[0]);
+        const __m256d lo_y0 = _mm256_load_pd(soa.m_lo[1]);
+        const __m256d lo_z0 = _mm256_load_pd(soa.m_lo[2]);
+        const __m256d hi_x0 = _mm256_load_pd(soa.m_hi[0]);
+        const __m256d hi_y0 = _mm256_load_pd(soa.m_hi[1]);
+        const __m256d hi_z0 = _mm256_load_pd(soa.m_hi[2]);
+
+        const __m256d dx0 = _mm256_max_pd(zero, _mm256_max_pd(_mm256_sub_pd(lo_x0, px), _mm256_sub_pd(px, hi_x0)));
+        const __m256d dy0 = _mm256_max_pd(zero, _mm256_max_pd(_mm256_sub_pd(lo_y0, py), _mm256_sub_pd(py, hi_y0)));
+        const __m256d dz0 = _mm256_max_pd(zero, _mm256_max_pd(_mm256_sub_pd(lo_z0, pz), _mm256_sub_pd(pz, hi_z0)));
+        const __m256d d2_0 =
+          _mm256_add_pd(_mm256_mul_pd(dx0, dx0), _mm256_add_pd(_mm256_mul_pd(dy0, dy0), _mm256_mul_pd(dz0, dz0)));
+
+        const __m256d lo_x1 = _mm256_load_pd(soa.m_lo[0] + 4);
+        const __m256d lo_y1 = _mm256_load_pd(soa.m_lo[1] + 4);
+        const __m256d lo_z1 = _mm256_load_pd(soa.m_lo[2] + 4);
+        const __m256d hi_x1 = _mm256_load_pd(soa.m_hi[0] + 4);
+        const __m256d hi_y1 = _mm256_load_pd(soa.m_hi[1] + 4);
+        const __m256d hi_z1 = _mm256_load_pd(soa.m_hi[2] + 4);
+
+        const __m256d dx1 = _mm256_max_pd(zero, _mm256_max_pd(_mm256_sub_pd(lo_x1, px), _mm256_sub_pd(px, hi_x1)));
+        const __m256d dy1 = _mm256_max_pd(zero, _mm256_max_pd(_mm256_sub_pd(lo_y1, py), _mm256_sub_pd(py, hi_y1)));
+        const __m256d dz1 = _mm256_max_pd(zero, _mm256_max_pd(_mm256_sub_pd(lo_z1, pz), _mm256_sub_pd(pz, hi_z1)));
+        const __m256d d2_1 =
+          _mm256_add_pd(_mm256_mul_pd(dx1, dx1), _mm256_add_pd(_mm256_mul_pd(dy1, dy1), _mm256_mul_pd(dz1, dz1)));
+
+        alignas(32) double dist2[K];
+        _mm256_store_pd(dist2, d2_0);
+        _mm256_store_pd(dist2 + 4, d2_1);
+
+        const auto& offsets = node.getChildOffsets();
+
+        std::array<std::pair<double, uint32_t>, K> children;
+
+        for (size_t k = 0; k < K; k++) {
+          children[k] = {dist2[k], offsets[k]};
+        }
+
+        std::sort(children.begin(),
+                  children.end(),
+                  [](const std::pair<double, uint32_t>& a, const std::pair<double, uint32_t>& b) noexcept {
+                    return a.first > b.first;
+                  });
+
+        const double newBest2 = static_cast<double>(a_pruneDist2(a_state));
+
+        for (const auto& [d, idx] : children) {
+          if (d <= newBest2 && idx != EmptyChild) {
+            stack[top++] = {idx, d};
+          }
+        }
+      }
+    }
+
+    return;
+  }
+#endif
+#if defined(__SSE4_1__)
+  if constexpr (K == 4 && std::is_same_v<T, float>) {
+    static_assert(alignof(ChildAABBSoA) == sizeof(T) * K,
+                  "ChildAABBSoA alignment mismatch: _mm_load_ps requires 16-byte alignment");
+
+    const __m128 px   = _mm_set1_ps(a_point[0]);
+    const __m128 py   = _mm_set1_ps(a_point[1]);
+    const __m128 pz   = _mm_set1_ps(a_point[2]);
+    const __m128 zero = _mm_setzero_ps();
+
+    alignas(16) StackEntry stack[256];
+
+    Detail::TraversalCounter counter;
+    int                    top = 0;
+    stack[top++]               = {0U, 0.0f};
+
+    while (top > 0) {
+      const StackEntry entry    = stack[--top];
+      const float      curBest2 = static_cast<float>(a_pruneDist2(a_state));
+
+      if (entry.dist2 > curBest2) {
+        continue;
+      }
+
+      const Node& node = nodes[entry.idx];
+
+      counter.visitNode();
+
+      if (node.isLeaf()) {
+        const Leaf& leaf = leaves[node.getLeafIndex()];
+
+        counter.visitLeaf(leaf.m_numPrims);
+        a_evalLeaf(a_state, leaf.m_primOff, leaf.m_numPrims);
+      }
+      else {
+        const auto& soa = childAabbSoA[node.getChildBoxesIndex()];
+
+        const __m128 lo_x = _mm_load_ps(soa.m_lo[0]);
+        const __m128 lo_y = _mm_load_ps(soa.m_lo[1]);
+        const __m128 lo_z = _mm_load_ps(soa.m_lo[2]);
+        const __m128 hi_x = _mm_load_ps(soa.m_hi[0]);
+        const __m128 hi_y = _mm_load_ps(soa.m_hi[1]);
+        const __m128 hi_z = _mm_load_ps(soa.m_hi[2]);
+
+        const __m128 dx = _mm_max_ps(zero, _mm_max_ps(_mm_sub_ps(lo_x, px), _mm_sub_ps(px, hi_x)));
+        const __m128 dy = _mm_max_ps(zero, _mm_max_ps(_mm_sub_ps(lo_y, py), _mm_sub_ps(py, hi_y)));
+        const __m128 dz = _mm_max_ps(zero, _mm_max_ps(_mm_sub_ps(lo_z, pz), _mm_sub_ps(pz, hi_z)));
+        const __m128 d2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_add_ps(_mm_mul_ps(dy, dy), _mm_mul_ps(dz, dz)));
+
+        alignas(16) float dist2[K];
+        _mm_store_ps(dist2, d2);
+
+        const auto& offsets = node.getChildOffsets();
+
+        std::array<std::pair<float, uint32_t>, K> children;
+
+        for (size_t k = 0; k < K; k++) {
+          children[k] = {dist2[k], offsets[k]};
+        }
+
+        std::sort(children.begin(),
+                  children.end(),
+                  [](const std::pair<float, uint32_t>& a, const std::pair<float, uint32_t>& b) noexcept {
+                    return a.first > b.first;
+                  });
+
+        const float newBest2 = static_cast<float>(a_pruneDist2(a_state));
+
+        for (const auto& [d, idx] : children) {
+          if (d <= newBest2 && idx != EmptyChild) {
+            stack[top++] = {idx, d};
+          }
+        }
+      }
+    }
+
+    return;
+  }
+#endif
+
+  // Scalar fallback for all other (T, K) combinations.
+  const BVH::PackedLeafEvaluator<P, StoragePolicy> leafEvaluator =
+    [&a_state, &a_evalLeaf](const StorageType*, size_t offset, size_t count) noexcept -> void {
+    a_evalLeaf(a_state, offset, count);
+  };
+
+  // The node key is the *squared* box distance (getDistanceToBoundingVolume2), matching the squared
+  // pruning bound a_pruneDist2 returns -- so the predicate compares directly, with no sqrt anywhere.
+  // (Squaring is monotonic, so ordering children by squared distance is identical to ordering by
+  // distance.) The SIMD paths above already work entirely in squared distance; this keeps the
+  // scalar fallback consistent instead of taking a square root only to square it back.
+  const BVH::PrunePredicate<NodeView, T> prunePredicate =
+    [&a_state, &a_pruneDist2](const NodeView& /*n*/, const T& d2) noexcept -> bool {
+    return d2 <= a_pruneDist2(a_state);
+  };
+
+  const BVH::PackedChildOrderer<T, K> childOrderer = [](std::array<std::pair<uint32_t, T>, K>& ch) noexcept -> void {
+    std::sort(ch.begin(), ch.end(), [](const std::pair<uint32_t, T>& a, const std::pair<uint32_t, T>& b) noexcept {
+      return a.second > b.second;
+    });
+  };
+
+  const BVH::NodeKeyFactory<NodeView, T> nodeKeyFactory = [&a_point](const NodeView& n) noexcept -> T {
+    return n.getDistanceToBoundingVolume2(a_point);
+  };
+
+  this->traverse(leafEvaluator, prunePredicate, childOrderer, nodeKeyFactory);
+}
+
+template <class T, class P, size_t K, class StoragePolicy>
+template <class State, class LeafEvaluator, class PruneDistSquared>
+inline void
+PackedBVH<T, P, K, StoragePolicy>::packetPruneTraverse(const Vec3T<T>*    a_points,
+                                                       State*             a_states,
+                                                       std::size_t        a_numPoints,
+                                                       LeafEvaluator&&    a_evalLeaf,
+                                                       PruneDistSquared&& a_pruneDist2) const noexcept
+{
+  EBGEOMETRY_EXPECT(a_numPoints <= s_maxPacketSize);
+  EBGEOMETRY_EXPECT(a_numPoints == 0 || a_points != nullptr);
+  EBGEOMETRY_EXPECT(a_numPoints == 0 || a_states != nullptr);
+
+  if (a_numPoints == 0 || this->getNumNodes() == 0) {
+    return;
+  }
+
+  const Node* const         nodes        = this->getNodeData();
+  const ChildAABBSoA* const childAabbSoA = this->getChildAabbData();
+  const Leaf* const         leaves       = this->getLeafData();
+
+  using LaneMask = uint64_t;
+
+  // The node's box is re-tested on pop, so an entry remembers the SoA record and slot it is stored in (NoParent
+  // for the root, whose box the tree keeps itself).
+  struct PacketEntry
+  {
+    uint32_t idx;
+    uint32_t record;
+    uint32_t slot;
+    LaneMask mask;
+  };
+
+  // Query points transposed to SoA once, so the box tests below run branch-free over contiguous lanes and
+  // vectorize across the packet. Lanes outside the current entry carry a negative bound, which no squared
+  // distance can satisfy, so they drop out of every mask without a per-lane branch.
+  alignas(64) std::array<T, s_maxPacketSize> px;
+  alignas(64) std::array<T, s_maxPacketSize> py;
+  alignas(64) std::array<T, s_maxPacketSize> pz;
+  alignas(64) std::array<T, s_maxPacketSize> bound2;
+  alignas(64) std::array<T, s_maxPacketSize> dist2;
+
+  for (std::size_t lane = 0; lane < a_numPoints; lane++) {
+    px[lane] = a_points[lane][0];
+    py[lane] = a_points[lane][1];
+    pz[lane] = a_points[lane][2];
+  }
+
+  // Squared distance from every lane to the box [lo, hi], written to dist2.
+  const auto boxDistances2 = [&px, &py, &pz, &dist2, a_numPoints](const T a_loX,
+                                                                  const T a_loY,
+                                                                  const T a_loZ,
+                                                                  const T a_hiX,
+                                                                  const T a_hiY,
+                                                                  const T a_hiZ) noexcept {
+    for (std::size_t lane = 0; lane < a_numPoints; lane++) {
+      const T dx = std::max(T(0), std::max(a_loX - px[lane], px[lane] - a_hiX));
+      const T dy = std::max(T(0), std::max(a_loY - py[lane], py[lane] - a_hiY));
+      const T dz = std::max(T(0), std::max(a_loZ - pz[lane], pz[lane] - a_hiZ));
+
+      dist2[lane] = dx * dx + dy * dy + dz * dz;
+    }
+  };
+
+  // Same fixed-size stack convention as pruneTraverse(); a packet pushes at most K entries per interior node.
+  constexpr int maxStack = 256;
+
+  PacketEntry stack[maxStack];
+  int         top = 0;
+
+  Detail::TraversalCounter counter;
+
+  stack[top++] = {
+    0U, NoParent, 0U, (a_numPoints == s_maxPacketSize) ? ~LaneMask(0) : ((LaneMask(1) << a_numPoints) - 1)};
+
+  while (top > 0) {
+    const PacketEntry entry = stack[--top];
+    const Node&       node  = nodes[entry.idx];
+
+    // Lanes were admitted into this entry against the bounds they had when it was pushed. Leaves visited since
+    // then may have tightened them, so re-test every carried lane against the node's box and its current bound.
+    for (std::size_t lane = 0; lane < a_numPoints; lane++) {
+      bound2[lane] = ((entry.mask >> lane) & 1U) != 0 ? a_pruneDist2(a_states[lane]) : T(-1);
+    }
+
+    if (entry.record == NoParent) {
+      const Vec3T<T>& lo = this->getBoundingVolume().getLowCorner();
+      const Vec3T<T>& hi = this->getBoundingVolume().getHighCorner();
+
+      boxDistances2(lo[0], lo[1], lo[2], hi[0], hi[1], hi[2]);
+    }
+    else {
+      const auto&  box = childAabbSoA[entry.record];
+      const size_t k   = entry.slot;
+
+      boxDistances2(box.m_lo[0][k], box.m_lo[1][k], box.m_lo[2][k], box.m_hi[0][k], box.m_hi[1][k], box.m_hi[2][k]);
+    }
+
+    LaneMask active = 0;
+
+    for (std::size_t lane = 0; lane < a_numPoints; lane++) {
+      active |= LaneMask(dist2[lane] <= bound2[lane]) << lane;
+    }
+
+    if (active == 0) {
+      continue;
+    }
+
+    counter.visitNode();
+
+    if (node.isLeaf()) {
+      const Leaf& leaf = leaves[node.getLeafIndex()];
+
+      for (std::size_t lane = 0; lane < a_numPoints; lane++) {
+        if (((active >> lane) & 1U) != 0) {
+          counter.visitLeaf(leaf.m_numPrims);
+          a_evalLeaf(a_states[lane], lane, leaf.m_primOff, leaf.m_numPrims);
+        }
+      }
+
+      continue;
+    }
+
+    for (std::size_t lane = 0; lane < a_numPoints; lane++) {
+      if (((active >> lane) & 1U) == 0) {
+        bound2[lane] = T(-1);
+      }
+    }
+
+    // One SoA fetch serves the whole packet: per child, the lanes within their bound form the child's mask, and
+    // the nearest such lane's squared distance is the child's ordering key.
+    const auto& soa     = childAabbSoA[node.getChildBoxesIndex()];
+    const auto& offsets = node.getChildOffsets();
+
+    std::array<std::pair<T, size_t>, K> order;
+    std::array<LaneMask, K>             childMasks;
+
+    for (size_t k = 0; k < K; k++) {
+      boxDistances2(soa.m_lo[0][k], soa.m_lo[1][k], soa.m_lo[2][k], soa.m_hi[0][k], soa.m_hi[1][k], soa.m_hi[2][k]);
+
+      T        key  = std::numeric_limits<T>::infinity();
+      LaneMask mask = 0;
+
+      for (std::size_t lane = 0; lane < a_numPoints; lane++) {
+        const bool inside = dist2[lane] <= bound2[lane];
+
+        mask |= LaneMask(inside) << lane;
+        key = std::min(key, inside ? dist2[lane] : std::numeric_limits<T>::infinity());
+      }
+
+      order[k]      = {key, k};
+      childMasks[k] = mask;
+    }
+
+    // Farthest first onto the LIFO stack, so the nearest child is expanded next.
+    std::sort(order.begin(), order.end(), [](const std::pair<T, size_t>& a, const std::pair<T, size_t>& b) noexcept {
+      return a.first > b.first;
+    });
+
+    for (const auto& [key, k] : order) {
+      if (childMasks[k] != 0 && offsets[k] != EmptyChild) {
+        EBGEOMETRY_EXPECT(top < maxStack);
+
+        stack[top++] = {offsets[k], node.getChildBoxesIndex(), static_cast<uint32_t>(k), childMasks[k]};
+      }
+    }
+  }
+}
+
+template <class T, class P, size_t K, class StoragePolicy>
+template <class BVConstructor>
+inline void
+PackedBVH<T, P, K, StoragePolicy>::refit(const BVConstructor& a_bvConstructor)
+{
+  if (this->isMapped()) {
+    std::cerr << "PackedBVH::refit -- Error! A mapped PackedBVH is read-only\n";
+
+    return;
+  }
+
+  if (m_linearNodes.empty()) {
+    return;
+  }
+
+  // A node's box lives in its parent's SoA record, so refitting an interior node recomputes the boxes of its
+  // children: a leaf child's from its primitives, an interior child's from that child's own, already refitted,
+  // record. The root's box is the union of its record.
+  std::vector<BV> boundingVolumes;
+
+  const auto refitRoot = [this, &a_bvConstructor, &boundingVolumes]() {
+    const Node& root = m_linearNodes[0];
+
+    m_bv = root.isLeaf() ? this->computeLeafBoundingVolume(root, a_bvConstructor, boundingVolumes)
+                         : this->getChildrenBoundingVolume(root);
+  };
+
+  if (m_linearNodes.size() >= ParallelRefitThreshold && Parallel::getNumThreads() > 1) {
+    // Cut the tree level by level until there are a few subtrees per thread. The expanded nodes above the cut are
+    // kept in breadth-first order, so in reverse every child comes before its parent.
+    const size_t numSubtrees = 8 * size_t(Parallel::getNumThreads());
+
+    std::vector<uint32_t> top;
+    std::vector<uint32_t> subtrees(1, 0U);
+    std::vector<uint32_t> next;
+
+    bool expanded = true;
+    while (expanded && subtrees.size() < numSubtrees) {
+      expanded = false;
+
+      next.clear();
+      for (const uint32_t s : subtrees) {
+        const Node& node = m_linearNodes[s];
+
+        if (node.isLeaf()) {
+          next.emplace_back(s);
+        }
+        else {
+          top.emplace_back(s);
+          next.insert(
+            next.end(), node.getChildOffsets().begin(), node.getChildOffsets().begin() + node.getNumChildren());
+
+          expanded = true;
+        }
+      }
+
+      subtrees.swap(next);
+    }
+
+    // A subtree writes the records of its own interior nodes only; the box of its root is written by the parent.
+    Parallel::parallelFor(0, subtrees.size(), 1, [&](size_t a_lo, size_t a_hi) {
+      std::vector<BV>       scratch;
+      std::vector<uint32_t> stack;
+      std::vector<uint32_t> preOrder;
+
+      for (size_t i = a_lo; i < a_hi; i++) {
+        // Reversed, the pre-order of a subtree has every child before its parent.
+        preOrder.clear();
+        stack.assign(1, subtrees[i]);
+
+        while (!stack.empty()) {
+          const Node& node = m_linearNodes[stack.back()];
+
+          if (!node.isLeaf()) {
+            preOrder.emplace_back(stack.back());
+          }
+          stack.pop_back();
+
+          if (!node.isLeaf()) {
+            stack.insert(
+              stack.end(), node.getChildOffsets().begin(), node.getChildOffsets().begin() + node.getNumChildren());
+          }
+        }
+
+        for (size_t j = preOrder.size(); j-- > 0;) {
+          this->refitNode(preOrder[j], a_bvConstructor, true, scratch);
+        }
+      }
+    });
+
+    for (size_t j = top.size(); j-- > 0;) {
+      this->refitNode(top[j], a_bvConstructor, true, boundingVolumes);
+    }
+
+    refitRoot();
+
+    return;
+  }
+
+  // Whatever the layout, every child has a higher index than its parent (the node-array ordering
+  // contract). Sweeping the array in reverse therefore refits all of a node's children before the node
+  // itself -- no recursion or explicit stack needed.
+  //
+  // The scratch vector feeding AABBT's union constructor is declared once here and clear()ed per
+  // leaf rather than reallocated inside the loop: its capacity stabilizes after the first few leaves,
+  // so a refit() (meant as cheap per-frame maintenance) makes effectively no steady-state heap
+  // allocations.
+  for (size_t i = m_linearNodes.size(); i-- > 0;) {
+    const Node& node = m_linearNodes[i];
+
+    // Leaves are refitted by their parent. Interior nodes without children were detached by remove() or insert()
+    // and await compact().
+    if (node.isLeaf() || node.getNumChildren() == 0) {
+      continue;
+    }
+
+    this->refitNode(i, a_bvConstructor, true, boundingVolumes);
+  }
+
+  refitRoot();
+}
+
+template <class T, class P, size_t K, class StoragePolicy>
+template <class BVConstructor>
+inline void
+PackedBVH<T, P, K, StoragePolicy>::refit(const std::vector<uint32_t>& a_primitives,
+                                         const BVConstructor&         a_bvConstructor)
+{
+  if (this->isMapped()) {
+    std::cerr << "PackedBVH::refit -- Error! A mapped PackedBVH is read-only\n";
+
+    return;
+  }
+
+  if (m_parentIndices.empty()) {
+    this->buildParentIndices();
+  }
+
+  std::vector<uint32_t> leaves;
+  for (const uint32_t p : a_primitives) {
+    EBGEOMETRY_EXPECT(size_t(p) < m_primitives.size());
+
+    leaves.insert(leaves.end(),
+                  m_primitiveLeaves.begin() + m_primitiveLeafOffsets[p],
+                  m_primitiveLeaves.begin() + m_primitiveLeafOffsets[p + 1]);
+  }
+
+  std::sort(leaves.begin(), leaves.end());
+  leaves.erase(std::unique(leaves.begin(), leaves.end()), leaves.end());
+
+  // Leaves are independent of each other. Each writes its box into its own slot of its parent's SoA record.
+  Parallel::parallelFor(0, leaves.size(), 256, [&](size_t a_lo, size_t a_hi) {
+    std::vector<BV> boundingVolumes;
+
+    for (size_t i = a_lo; i < a_hi; i++) {
+      const Node&    leaf   = m_linearNodes[leaves[i]];
+      const uint32_t parent = m_parentIndices[leaves[i]];
+      const BV       bv     = this->computeLeafBoundingVolume(leaf, a_bvConstructor, boundingVolumes);
+
+      if (parent == NoParent) {
+        m_bv = bv;
+      }
+      else {
+        const Node& node = m_linearNodes[parent];
+
+        this->setChildBoundingVolume(node.getChildBoxesIndex(), getChildSlot(node, leaves[i]), bv);
+      }
+    }
+  });
+
+  // Children have higher indices than their parents, so refitting the ancestors from the highest index down
+  // updates every node after its children.
+  std::vector<uint32_t> ancestors;
+  for (const uint32_t leaf : leaves) {
+    for (uint32_t node = m_parentIndices[leaf]; node != NoParent; node = m_parentIndices[node]) {
+      ancestors.emplace_back(node);
+    }
+  }
+
+  std::sort(ancestors.begin(), ancestors.end());
+  ancestors.erase(std::unique(ancestors.begin(), ancestors.end()), ancestors.end());
+
+  std::vector<BV> boundingVolumes;
+  for (size_t j = ancestors.size(); j-- > 0;) {
+    this->refitNode(ancestors[j], a_bvConstructor, false, boundingVolumes);
+  }
+
+  if (!m_linearNodes[0].isLeaf()) {
+    m_bv = this->getChildrenBoundingVolume(m_linearNodes[0]);
+  }
+}
+
+template <class T, class P, size_t K, class StoragePolicy>
+template <class BVConstructor>
+inline void
+PackedBVH<T, P, K, StoragePolicy>::refitNode(const size_t         a_index,
+                                             const BVConstructor& a_bvConstructor,
+                                             const bool           a_refitLeaves,
+                                             std::vector<BV>&     a_scratch)
+{
+  const Node& node = m_linearNodes[a_index];
+
+  EBGEOMETRY_EXPECT(!node.isLeaf());
+
+  const auto&  childOffsets = node.getChildOffsets();
+  const size_t numChildren  = node.getNumChildren();
+
+  for (size_t k = 0; k < numChildren; k++) {
+    EBGEOMETRY_EXPECT(childOffsets[k] > a_index);
+
+    const Node& child = m_linearNodes[childOffsets[k]];
+
+    if (!child.isLeaf()) {
+      this->setChildBoundingVolume(node.getChildBoxesIndex(), k, this->getChildrenBoundingVolume(child));
+    }
+    else if (a_refitLeaves) {
+      this->setChildBoundingVolume(
+        node.getChildBoxesIndex(), k, this->computeLeafBoundingVolume(child, a_bvConstructor, a_scratch));
+    }
+  }
+}
+
+template <class T, class P, size_t K, class StoragePolicy>
+template <class BVConstructor>
+inline typename PackedBVH<T, P, K, StoragePolicy>::BV
+PackedBVH<T, P, K, StoragePolicy>::computeLeafBoundingVolume(const Node&          a_node,
+                                                             const BVConstructor& a_bvConstructor,
+                                                             std::vector<BV>&     a_scratch) const
+{
+  EBGEOMETRY_EXPECT(a_node.isLeaf());
+
+  const Leaf& leaf = m_leaves[a_node.getLeafIndex()];
+
+  a_scratch.clear();
+  a_scratch.reserve(leaf.m_numPrims);
+
+  for (uint32_t p = 0; p < leaf.m_numPrims; p++) {
+    a_scratch.emplace_back(a_bvConstructor(StoragePolicy::get(m_primitives[leaf.m_primOff + p])));
+  }
+
+  return BV(a_scratch);
+}
+
+template <class T, class P, size_t K, class StoragePolicy>
+inline void
+PackedBVH<T, P, K, StoragePolicy>::buildParentIndices()
+{
+  m_parentIndices.assign(m_linearNodes.size(), NoParent);
+  m_primitiveLeafOffsets.assign(m_primitives.size() + 1, 0U);
+
+  // Count the leaves of every primitive, then place them.
+  for (const Node& node : m_linearNodes) {
+    if (node.isLeaf()) {
+      const Leaf& leaf = m_leaves[node.getLeafIndex()];
+
+      for (uint32_t p = leaf.m_primOff; p < leaf.m_primOff + leaf.m_numPrims; p++) {
+        m_primitiveLeafOffsets[p + 1]++;
+      }
+    }
+  }
+
+  std::partial_sum(m_primitiveLeafOffsets.begin(), m_primitiveLeafOffsets.end(), m_primitiveLeafOffsets.begin());
+
+  std::vector<uint32_t> fill(m_primitiveLeafOffsets.begin(), m_primitiveLeafOffsets.end() - 1);
+
+  m_primitiveLeaves.resize(m_primitiveLeafOffsets.back());
+
+  for (size_t i = 0; i < m_linearNodes.size(); i++) {
+    const Node& node = m_linearNodes[i];
+
+    if (node.isLeaf()) {
+      const Leaf& leaf = m_leaves[node.getLeafIndex()];
+
+      for (uint32_t p = leaf.m_primOff; p < leaf.m_primOff + leaf.m_numPrims; p++) {
+        m_primitiveLeaves[fill[p]++] = static_cast<uint32_t>(i);
+      }
+    }
+    else {
+      for (size_t k = 0; k < node.getNumChildren(); k++) {
+        m_parentIndices[node.getChildOffsets()[k]] = static_cast<uint32_t>(i);
+      }
+    }
+  }
+}
 
-    Vec3T<T> clo = +Vec3T<T>::max();
-    Vec3T<T> chi = -Vec3T<T>::max();
+template <class T, class P, size_t K, class StoragePolicy>
+inline void
+PackedBVH<T, P, K, StoragePolicy>::insert(StorageType a_primitive, const BV& a_bv)
+{
+  if (this->isMapped()) {
+    std::cerr << "PackedBVH::insert -- Error! A mapped PackedBVH is read-only\n";
+
+    return;
+  }
+
+  EBGEOMETRY_EXPECT(!m_linearNodes.empty());
+  EBGEOMETRY_EXPECT(m_primitives.size() < size_t(std::numeric_limits<uint32_t>::max()));
+
+  m_parentIndices.clear();
+  EBGEOMETRY_EXPECT(m_linearNodes.size() + 2 < size_t(std::numeric_limits<uint32_t>::max()));
+
+  const auto merge = [](const BV& a_lhs, const BV& a_rhs) noexcept -> BV {
+    return BV(min(a_lhs.getLowCorner(), a_rhs.getLowCorner()), max(a_lhs.getHighCorner(), a_rhs.getHighCorner()));
+  };
+
+  // Greedy descent on the growth in surface area. Adding the new leaf to a node costs the area of the grown node;
+  // handing it to a child costs what the node grows anyway, plus the area of a new interior node over a leaf child,
+  // or the growth of an interior child (a lower bound for what happens further down).
+  // The box of the current node is carried along, and the slot taken at every step is recorded, so the boxes along
+  // the path can be grown in their parents' SoA records afterwards.
+  std::vector<uint32_t> path;
+  std::vector<size_t>   slots;
+
+  BV       box     = m_bv;
+  uint32_t current = 0;
+  while (true) {
+    path.emplace_back(current);
+
+    const Node& node = m_linearNodes[current];
+
+    if (node.isLeaf()) {
+      break;
+    }
+
+    const size_t numChildren = node.getNumChildren();
+    const T      grown       = merge(box, a_bv).getArea();
+    const T      inherited   = grown - box.getArea();
+
+    T      bestCost = (numChildren < K) ? grown : std::numeric_limits<T>::infinity();
+    size_t bestSlot = K;
+
+    for (size_t k = 0; k < numChildren; k++) {
+      const Node& child      = m_linearNodes[node.getChildOffsets()[k]];
+      const BV    childBox   = this->getChildBoundingVolume(node.getChildBoxesIndex(), k);
+      const T     childGrown = merge(childBox, a_bv).getArea();
+      const T     cost       = inherited + (child.isLeaf() ? childGrown : childGrown - childBox.getArea());
+
+      if (cost < bestCost) {
+        bestCost = cost;
+        bestSlot = k;
+      }
+    }
+
+    if (bestSlot == K) {
+      break;
+    }
+
+    slots.emplace_back(bestSlot);
+
+    box     = this->getChildBoundingVolume(node.getChildBoxesIndex(), bestSlot);
+    current = node.getChildOffsets()[bestSlot];
+  }
+
+  EBGEOMETRY_EXPECT(m_leaves.size() < size_t(s_leafFlag));
+
+  Node leaf;
+  leaf.m_ref = s_leafFlag | static_cast<uint32_t>(m_leaves.size());
+
+  m_leaves.push_back({static_cast<uint32_t>(m_primitives.size()), 1U});
+  m_primitives.emplace_back(std::move(a_primitive));
+
+  const uint32_t target = path.back();
+  const uint32_t added  = static_cast<uint32_t>(m_linearNodes.size());
+
+  if (m_linearNodes[target].isLeaf()) {
+    // The old leaf moves to the end of the array, so that both children come after the node that replaces it.
+    const uint32_t moved = added + 1U;
+
+    Node interior;
+    interior.setChildOffset(moved, 0);
+    interior.setChildOffset(added, 1);
+    interior.m_ref = static_cast<uint32_t>(m_childAabbSoA.size());
+
+    m_childAabbSoA.emplace_back();
+
+    this->setChildBoundingVolume(interior.getChildBoxesIndex(), 0, box);
+    this->setChildBoundingVolume(interior.getChildBoxesIndex(), 1, a_bv);
+    for (size_t k = 2; k < K; k++) {
+      this->clearChildBoundingVolume(interior.getChildBoxesIndex(), k);
+    }
+
+    const Node old = m_linearNodes[target];
+
+    m_linearNodes.emplace_back(leaf);
+    m_linearNodes.emplace_back(old);
+    m_linearNodes[target] = interior;
+  }
+  else {
+    const size_t slot = m_linearNodes[target].getNumChildren();
+
+    m_linearNodes[target].setChildOffset(added, slot);
+    m_linearNodes.emplace_back(leaf);
+
+    this->setChildBoundingVolume(m_linearNodes[target].getChildBoxesIndex(), slot, a_bv);
+  }
+
+  // Grow the boxes on the path, each in its parent's SoA record, and the root's.
+  for (size_t i = 1; i < path.size(); i++) {
+    const uint32_t record = m_linearNodes[path[i - 1]].getChildBoxesIndex();
+    const BV       grown  = merge(this->getChildBoundingVolume(record, slots[i - 1]), a_bv);
+
+    this->setChildBoundingVolume(record, slots[i - 1], grown);
+  }
+
+  m_bv = merge(m_bv, a_bv);
+
+  // Number of levels of a balanced K-ary tree over a_count leaves.
+  const auto balancedDepth = [](const size_t a_count) noexcept -> size_t {
+    size_t depth    = 0;
+    size_t capacity = 1;
+    while (capacity < a_count) {
+      capacity *= K;
+      depth++;
+    }
+
+    return depth;
+  };
+
+  // The new leaf sits at depth path.size(). If that is too deep, rebuild the smallest subtree on the path whose
+  // balanced rebuild brings the leaf back within bounds.
+  const size_t balanced = balancedDepth(m_primitives.size() - m_numDeadPrimitives);
+
+  if (path.size() > 2 * balanced + 2) {
+    for (size_t j = path.size(); j-- > 0;) {
+      size_t                numLeaves = 0;
+      std::vector<uint32_t> stack(1, path[j]);
+
+      while (!stack.empty()) {
+        const Node& node = m_linearNodes[stack.back()];
+        stack.pop_back();
+
+        if (node.isLeaf()) {
+          numLeaves++;
+        }
+        else {
+          stack.insert(stack.end(),
+                       node.getChildOffsets().begin(),
+                       node.getChildOffsets().begin() + node.getNumChildren());
+        }
+      }
+
+      if (j + balancedDepth(numLeaves) <= balanced + 2) {
+        this->rebuildSubtree(path[j]);
+
+        break;
+      }
+    }
+  }
+
+  this->collectGarbage();
+}
+
+template <class T, class P, size_t K, class StoragePolicy>
+template <class Match>
+inline bool
+PackedBVH<T, P, K, StoragePolicy>::remove(const BV& a_bv, const Match& a_match)
+{
+  if (this->isMapped()) {
+    std::cerr << "PackedBVH::remove -- Error! A mapped PackedBVH is read-only\n";
+
+    return false;
+  }
+
+  if (m_linearNodes.empty()) {
+    return false;
+  }
+
+  const Vec3T<T>& lo = a_bv.getLowCorner();
+  const Vec3T<T>& hi = a_bv.getHighCorner();
+
+  // Overlap rather than containment: a reference split by an SBVH build sits in leaves whose boxes only bound
+  // the clipped part of the primitive.
+  const auto overlaps = [&lo, &hi](const BV& a_box) noexcept -> bool {
+    return a_box.getLowCorner() <= hi && lo <= a_box.getHighCorner();
+  };
+
+  // First pass: the slots of every matching reference, so that nothing changes if the removal is refused.
+  std::vector<uint32_t> matched;
+
+  std::function<void(uint32_t, const BV&)> find = [&](const uint32_t a_node, const BV& a_box) -> void {
+    const Node& node = m_linearNodes[a_node];
+
+    if (!overlaps(a_box)) {
+      return;
+    }
+
+    if (node.isLeaf()) {
+      const Leaf& leaf = m_leaves[node.getLeafIndex()];
+
+      for (uint32_t i = leaf.m_primOff; i < leaf.m_primOff + leaf.m_numPrims; i++) {
+        if (a_match(StoragePolicy::get(m_primitives[i]))) {
+          matched.emplace_back(i);
+        }
+      }
+    }
+    else {
+      for (size_t k = 0; k < node.getNumChildren(); k++) {
+        find(node.getChildOffsets()[k], this->getChildBoundingVolume(node.getChildBoxesIndex(), k));
+      }
+    }
+  };
+
+  find(0U, m_bv);
+
+  if (matched.empty()) {
+    return false;
+  }
+
+  if (matched.size() >= m_primitives.size() - m_numDeadPrimitives) {
+    std::cerr << "PackedBVH::remove -- Error! Cannot remove the last primitive of the tree\n";
+
+    return false;
+  }
+
+  std::sort(matched.begin(), matched.end());
+
+  m_parentIndices.clear();
+
+  const auto retire = [this](const uint32_t a_node) noexcept -> void {
+    m_linearNodes[a_node] = deadNode();
+    m_numDeadNodes++;
+  };
+
+  // Second pass, over the same nodes. Each leaf swaps its matched references to the end of its range and shortens
+  // it. On the way back up, every parent detaches the children left empty, replaces a child left with a single
+  // child of its own by that grandchild, and shrinks the boxes of the others in its SoA record. Children are
+  // visited in reverse so that closing a gap only shifts slots that are already done.
+  std::function<bool(uint32_t, const BV&)> prune = [&](const uint32_t a_node, const BV& a_box) -> bool {
+    Node& node = m_linearNodes[a_node];
+
+    if (!overlaps(a_box)) {
+      return false;
+    }
+
+    if (node.isLeaf()) {
+      Leaf& leaf = m_leaves[node.getLeafIndex()];
+
+      const uint32_t numPrims = leaf.m_numPrims;
+
+      for (uint32_t i = leaf.m_primOff + numPrims; i-- > leaf.m_primOff;) {
+        if (std::binary_search(matched.begin(), matched.end(), i)) {
+          std::swap(m_primitives[i], m_primitives[leaf.m_primOff + leaf.m_numPrims - 1U]);
+
+          leaf.m_numPrims--;
+          m_numDeadPrimitives++;
+        }
+      }
+
+      return leaf.m_numPrims < numPrims;
+    }
+
+    const uint32_t record  = node.getChildBoxesIndex();
+    bool           changed = false;
+
+    for (size_t k = node.getNumChildren(); k-- > 0;) {
+      const uint32_t index = node.getChildOffsets()[k];
+
+      if (!prune(index, this->getChildBoundingVolume(record, k))) {
+        continue;
+      }
+
+      changed = true;
+
+      const Node& child = m_linearNodes[index];
+
+      if (child.isLeaf() ? m_leaves[child.getLeafIndex()].m_numPrims == 0 : child.getNumChildren() == 0) {
+        // Close the gap in the child slots, and in the SoA record with them.
+        for (size_t j = k; j + 1 < K; j++) {
+          node.setChildOffset(node.getChildOffsets()[j + 1], j);
+
+          if (node.getChildOffsets()[j] != EmptyChild) {
+            this->setChildBoundingVolume(record, j, this->getChildBoundingVolume(record, j + 1));
+          }
+          else {
+            this->clearChildBoundingVolume(record, j);
+          }
+        }
+        node.setChildOffset(EmptyChild, K - 1);
+        this->clearChildBoundingVolume(record, K - 1);
+
+        retire(index);
+      }
+      else if (!child.isLeaf() && child.getNumChildren() == 1) {
+        // The grandchild comes after the child, so it also comes after this node.
+        const uint32_t grandchild = child.getChildOffsets()[0];
+
+        this->setChildBoundingVolume(record, k, this->getChildBoundingVolume(child.getChildBoxesIndex(), 0));
+        node.setChildOffset(grandchild, k);
+
+        retire(index);
+      }
+      else if (!child.isLeaf()) {
+        this->setChildBoundingVolume(record, k, this->getChildrenBoundingVolume(child));
+      }
+    }
+
+    return changed;
+  };
+
+  if (prune(0U, m_bv) && !m_linearNodes[0].isLeaf()) {
+    // A root left with a single child is replaced by that child, which keeps its own children and records.
+    while (!m_linearNodes[0].isLeaf() && m_linearNodes[0].getNumChildren() == 1) {
+      const uint32_t child = m_linearNodes[0].getChildOffsets()[0];
+
+      m_bv             = this->getChildBoundingVolume(m_linearNodes[0].getChildBoxesIndex(), 0);
+      m_linearNodes[0] = m_linearNodes[child];
+
+      retire(child);
+    }
+
+    if (!m_linearNodes[0].isLeaf()) {
+      m_bv = this->getChildrenBoundingVolume(m_linearNodes[0]);
+    }
+  }
+
+  this->collectGarbage();
+
+  return true;
+}
+
+template <class T, class P, size_t K, class StoragePolicy>
+inline void
+PackedBVH<T, P, K, StoragePolicy>::compact()
+{
+  if (this->isMapped()) {
+    std::cerr << "PackedBVH::compact -- Error! A mapped PackedBVH is read-only\n";
+
+    return;
+  }
+
+  if (m_linearNodes.empty()) {
+    return;
+  }
+
+  this->reorderNodes(this->getNodeOrder(Layout::DepthFirst));
+
+  // Primitives in leaf order. A range shared by several leaves is copied once.
+  std::vector<StorageType>                           primitives;
+  std::map<std::pair<uint32_t, uint32_t>, uint32_t> ranges;
+
+  primitives.reserve(m_primitives.size() - m_numDeadPrimitives);
+
+  // The leaf records are in node-array order after the reordering, so this is leaf order.
+  for (Leaf& leaf : m_leaves) {
+    const std::pair<uint32_t, uint32_t> range(leaf.m_primOff, leaf.m_numPrims);
+    const auto [it, isNew] = ranges.emplace(range, static_cast<uint32_t>(primitives.size()));
+
+    if (isNew) {
+      primitives.insert(primitives.end(),
+                        m_primitives.begin() + range.first,
+                        m_primitives.begin() + range.first + range.second);
+    }
+
+    leaf.m_primOff = it->second;
+  }
+
+  m_primitives        = std::move(primitives);
+  m_numDeadPrimitives = 0;
+}
+
+template <class T, class P, size_t K, class StoragePolicy>
+inline bool
+PackedBVH<T, P, K, StoragePolicy>::hasGarbage() const noexcept
+{
+  return m_numDeadNodes > 0 || m_numDeadPrimitives > 0;
+}
+
+template <class T, class P, size_t K, class StoragePolicy>
+inline void
+PackedBVH<T, P, K, StoragePolicy>::collectGarbage()
+{
+  if (2 * m_numDeadNodes >= m_linearNodes.size() || 2 * m_numDeadPrimitives >= m_primitives.size()) {
+    this->compact();
+  }
+}
+
+template <class T, class P, size_t K, class StoragePolicy>
+inline void
+PackedBVH<T, P, K, StoragePolicy>::rebuildSubtree(const uint32_t a_root)
+{
+  EBGEOMETRY_EXPECT(!m_linearNodes[a_root].isLeaf());
+
+  // Collect the leaves with their boxes, read from their parents' SoA records, and retire every node below the root.
+  std::vector<std::pair<Node, BV>>     leaves;
+  std::vector<std::pair<uint32_t, BV>> stack;
+
+  const auto pushChildren = [this, &stack](const Node& a_node) {
+    for (size_t k = 0; k < a_node.getNumChildren(); k++) {
+      stack.emplace_back(a_node.getChildOffsets()[k], this->getChildBoundingVolume(a_node.getChildBoxesIndex(), k));
+    }
+  };
+
+  pushChildren(m_linearNodes[a_root]);
+
+  while (!stack.empty()) {
+    const auto [index, box] = stack.back();
+    const Node node         = m_linearNodes[index];
+    stack.pop_back();
+
+    if (node.isLeaf()) {
+      leaves.emplace_back(node, box);
+    }
+    else {
+      pushChildren(node);
+    }
+
+    m_linearNodes[index] = deadNode();
+    m_numDeadNodes++;
+  }
+
+  // The root keeps its SoA record. Every other interior node gets a new one. Leaves keep their leaf records.
+  const uint32_t rootRecord = m_linearNodes[a_root].getChildBoxesIndex();
+
+  std::function<BV(size_t, size_t, uint32_t)> build = [&](size_t a_begin, size_t a_end, uint32_t a_index) -> BV {
+    const size_t count = a_end - a_begin;
+
+    if (count == 1) {
+      m_linearNodes[a_index] = leaves[a_begin].first;
+
+      return leaves[a_begin].second;
+    }
+
+    // Sort along the longest axis of the centroids and split into at most K groups of equal size.
+    Vec3T<T> lo = Vec3T<T>::infinity();
+    Vec3T<T> hi = -Vec3T<T>::infinity();
     for (size_t i = a_begin; i < a_end; i++) {
-      const auto& c = a_primsAndBVs[i].second.getCentroid();
-      clo           = min(clo, c);
-      chi           = max(chi, c);
+      lo = min(lo, leaves[i].second.getCentroid());
+      hi = max(hi, leaves[i].second.getCentroid());
+    }
+
+    const size_t axis = (hi - lo).maxDir(true);
+
+    const auto byCentroid = [axis](const std::pair<Node, BV>& a_lhs, const std::pair<Node, BV>& a_rhs) noexcept {
+      return a_lhs.second.getCentroid()[axis] < a_rhs.second.getCentroid()[axis];
+    };
+
+    std::sort(leaves.begin() + long(a_begin), leaves.begin() + long(a_end), byCentroid);
+
+    const size_t groupSize = (count + K - 1) / K;
+
+    Node node;
+    node.m_ref = (a_index == a_root) ? rootRecord : static_cast<uint32_t>(m_childAabbSoA.size());
+
+    if (a_index != a_root) {
+      m_childAabbSoA.emplace_back();
+    }
+
+    std::vector<BV> boundingVolumes;
+
+    size_t k = 0;
+    for (size_t begin = a_begin; begin < a_end; begin += groupSize, k++) {
+      const uint32_t child = static_cast<uint32_t>(m_linearNodes.size());
+
+      m_linearNodes.emplace_back(deadNode());
+      node.setChildOffset(child, k);
+
+      boundingVolumes.emplace_back(build(begin, std::min(begin + groupSize, a_end), child));
+
+      this->setChildBoundingVolume(node.getChildBoxesIndex(), k, boundingVolumes.back());
+    }
+
+    for (; k < K; k++) {
+      this->clearChildBoundingVolume(node.getChildBoxesIndex(), k);
+    }
+
+    m_linearNodes[a_index] = node;
+
+    return BV(boundingVolumes);
+  };
+
+  // Same leaves, so the box of the root does not change.
+  build(0, leaves.size(), a_root);
+}
+
+template <class T, class P, size_t K, class StoragePolicy>
+inline typename PackedBVH<T, P, K, StoragePolicy>::Node
+PackedBVH<T, P, K, StoragePolicy>::deadNode() noexcept
+{
+  return Node{};
+}
+
+template <class T, class P, size_t K, class StoragePolicy>
+inline double
+PackedBVH<T, P, K, StoragePolicy>::computeSAHCost(double a_traversalCost, double a_intersectionCost) const noexcept
+{
+  const Node* const nodes    = this->getNodeData();
+  const Leaf* const leaves   = this->getLeafData();
+  const size_t      numNodes = this->getNumNodes();
+
+  if (numNodes == 0) {
+    return 0.0;
+  }
+
+  // Every node but the root is weighted through its parent's SoA record; detached nodes have no parent and count as
+  // zero.
+  const auto cost = [&](const Node& a_node) noexcept -> double {
+    return a_node.isLeaf() ? a_intersectionCost * leaves[a_node.getLeafIndex()].m_numPrims : a_traversalCost;
+  };
+
+  const double rootArea     = static_cast<double>(this->getBoundingVolume().getArea());
+  double       weightedArea = cost(nodes[0]) * rootArea;
+
+  for (size_t i = 0; i < numNodes; i++) {
+    const Node& node = nodes[i];
+
+    if (!node.isLeaf()) {
+      for (size_t k = 0; k < node.getNumChildren(); k++) {
+        const BV bv = this->getChildBoundingVolume(node.getChildBoxesIndex(), k);
+
+        weightedArea += cost(nodes[node.getChildOffsets()[k]]) * static_cast<double>(bv.getArea());
+      }
     }
+  }
+
+  return (rootArea > 0.0) ? weightedArea / rootArea : 0.0;
+}
+
+template <class T, class P, size_t K, class StoragePolicy>
+inline TreeMetrics
+PackedBVH<T, P, K, StoragePolicy>::computeMetrics(double a_traversalCost, double a_intersectionCost) const
+{
+  if (this->hasGarbage()) {
+    PackedBVH compacted(*this);
+    compacted.compact();
+
+    return compacted.computeMetrics(a_traversalCost, a_intersectionCost);
+  }
+
+  TreeMetrics metrics;
+
+  const std::vector<NodeView> views    = this->getNodeViews();
+  const NodeView* const       nodes    = views.data();
+  const size_t                numNodes = views.size();
+
+  metrics.numNodes      = numNodes;
+  metrics.numPrimitives = this->getNumPrimitives();
+
+  if (numNodes == 0) {
+    return metrics;
+  }
 
-    const size_t axis = (chi - clo).maxDir(true);
-    const T      mid  = T(0.5) * (clo[axis] + chi[axis]);
+  // Node depths from a forward sweep and subtree sizes from a reverse one. In depth-first pre-order, the subtree of
+  // node i is the rank range [rank[i], rank[i] + subtreeSize[i]), whatever the layout of the node array.
+  std::vector<size_t>   depth(numNodes, 0);
+  std::vector<size_t>   subtreeSize(numNodes, 1);
+  std::vector<uint32_t> rank(numNodes);
 
-    const auto pivot = std::partition(
-      a_primsAndBVs.begin() + a_begin,
-      a_primsAndBVs.begin() + a_end,
-      [axis, mid](const std::pair<P, BV>& a_pb) noexcept { return a_pb.second.getCentroid()[axis] < mid; });
+  const std::vector<uint32_t> depthFirst = this->getNodeOrder(Layout::DepthFirst);
+  for (size_t i = 0; i < numNodes; i++) {
+    rank[depthFirst[i]] = static_cast<uint32_t>(i);
+  }
 
-    size_t split = static_cast<size_t>(pivot - a_primsAndBVs.begin());
-    if (split == a_begin || split == a_end) {
-      split = a_begin + (a_end - a_begin) / 2; // all centroids on one side: fall back to equal counts
+  for (size_t i = 0; i < numNodes; i++) {
+    if (!nodes[i].isLeaf()) {
+      for (size_t k = 0; k < nodes[i].getNumChildren(); k++) {
+        depth[nodes[i].getChildOffsets()[k]] = depth[i] + 1;
+      }
+    }
+  }
+  for (size_t i = numNodes; i-- > 0;) {
+    if (!nodes[i].isLeaf()) {
+      for (size_t k = 0; k < nodes[i].getNumChildren(); k++) {
+        subtreeSize[i] += subtreeSize[nodes[i].getChildOffsets()[k]];
+      }
     }
+  }
 
-    makeClusters(a_begin, split);
-    makeClusters(split, a_end);
+  const auto area = [](const BV& a_bv) noexcept -> double { return static_cast<double>(a_bv.getArea()); };
+
+  // Cost of visiting a node, in the SAH sense.
+  const auto nodeCost = [&](const NodeView& a_node) noexcept -> double {
+    return a_node.isLeaf() ? a_intersectionCost * a_node.getNumPrimitives() : a_traversalCost;
   };
-  makeClusters(0, a_primsAndBVs.size());
-  a_primsAndBVs.clear();
 
-  // ---- Phase 2: binned SAH over the clusters -------------------------------------------------
-  // A self-contained 2-way binned SAH over clusters[begin, end) -- mirrors SAH2WaySplit but over
-  // cluster boxes, deliberately isolated so the primitive SAH path is untouched. Partitions the
-  // clusters in place and returns the split index.
-  constexpr int BINS = 32;
+  std::vector<std::pair<uint32_t, uint32_t>> leafRanges;
 
-  const auto sah2Way = [&clusters](size_t a_begin, size_t a_end) noexcept -> size_t {
-    const size_t nClusters = a_end - a_begin;
+  metrics.minLeafDepth = std::numeric_limits<size_t>::max();
 
-    Vec3T<T> clo = +Vec3T<T>::max();
-    Vec3T<T> chi = -Vec3T<T>::max();
-    for (size_t i = a_begin; i < a_end; i++) {
-      clo = min(clo, clusters[i].centroid);
-      chi = max(chi, clusters[i].centroid);
-    }
+  double sumLeafDepth = 0.0;
+  double weightedArea = 0.0;
 
-    T   bestCost  = std::numeric_limits<T>::max();
-    T   bestPlane = T(0);
-    int bestAxis  = -1;
+  for (size_t i = 0; i < numNodes; i++) {
+    const NodeView& node = nodes[i];
 
-    Vec3T<T> binLo[BINS];
-    Vec3T<T> binHi[BINS];
-    int      binCnt[BINS];
-    T        leftArea[BINS - 1];
-    int      leftCnt[BINS - 1];
+    weightedArea += nodeCost(node) * area(node.getBoundingVolume());
 
-    for (int axis = 0; axis < 3; axis++) {
-      const T lo  = clo[axis];
-      const T hi  = chi[axis];
-      const T ext = hi - lo;
-      if (ext <= T(0)) {
-        continue;
-      }
-      const T scale = T(BINS) / ext;
+    if (node.isLeaf()) {
+      const size_t numPrims = node.getNumPrimitives();
 
-      for (int b = 0; b < BINS; b++) {
-        binLo[b]  = Vec3T<T>::max();
-        binHi[b]  = -Vec3T<T>::max();
-        binCnt[b] = 0;
-      }
-      for (size_t i = a_begin; i < a_end; i++) {
-        const int b = std::min(BINS - 1, static_cast<int>((clusters[i].centroid[axis] - lo) * scale));
-        binLo[b]    = min(binLo[b], clusters[i].bv.getLowCorner());
-        binHi[b]    = max(binHi[b], clusters[i].bv.getHighCorner());
-        binCnt[b]   = binCnt[b] + 1;
+      metrics.numLeaves++;
+      metrics.minLeafDepth = std::min(metrics.minLeafDepth, depth[i]);
+      metrics.maxLeafDepth = std::max(metrics.maxLeafDepth, depth[i]);
+      sumLeafDepth += double(depth[i]);
+
+      if (metrics.leafFill.size() <= numPrims) {
+        metrics.leafFill.resize(numPrims + 1, 0);
       }
+      metrics.leafFill[numPrims]++;
 
-      Vec3T<T> rlo = +Vec3T<T>::max();
-      Vec3T<T> rhi = -Vec3T<T>::max();
+      leafRanges.emplace_back(node.getPrimitivesOffset(), node.getNumPrimitives());
+    }
+  }
 
-      int rcnt = 0;
+  metrics.numInteriorNodes = numNodes - metrics.numLeaves;
+  metrics.meanLeafDepth    = sumLeafDepth / double(metrics.numLeaves);
 
-      for (int b = 0; b < BINS - 1; b++) {
-        if (binCnt[b] > 0) {
-          rlo = min(rlo, binLo[b]);
-          rhi = max(rhi, binHi[b]);
-        }
-        rcnt        = rcnt + binCnt[b];
-        leftArea[b] = (rcnt > 0) ? BV(rlo, rhi).getArea() : T(0);
-        leftCnt[b]  = rcnt;
-      }
+  // Leaves that repeat the primitive range of another leaf.
+  std::sort(leafRanges.begin(), leafRanges.end());
+  const auto uniqueEnd = std::unique(leafRanges.begin(), leafRanges.end());
 
-      Vec3T<T> rrlo = +Vec3T<T>::max();
-      Vec3T<T> rrhi = -Vec3T<T>::max();
+  metrics.numPaddedLeaves = size_t(std::distance(uniqueEnd, leafRanges.end()));
 
-      int rrcnt = 0;
+  const double rootArea = area(nodes[0].getBoundingVolume());
 
-      for (int b = BINS - 1; b >= 1; b--) {
-        if (binCnt[b] > 0) {
-          rrlo = min(rrlo, binLo[b]);
-          rrhi = max(rrhi, binHi[b]);
+  metrics.sahCost = (rootArea > 0.0) ? weightedArea / rootArea : 0.0;
+
+  // Effective parent overlap: the area of every node's box that is covered by leaves outside its subtree, found by
+  // an overlap query from the root, weighted like the SAH cost. One value per node keeps the sum independent of
+  // how the nodes are spread over threads.
+  std::vector<double> overlap(numNodes, 0.0);
+
+  Parallel::parallelFor(0, numNodes, 256, [&](size_t a_lo, size_t a_hi) {
+    std::vector<uint32_t> stack;
+
+    for (size_t i = a_lo; i < a_hi; i++) {
+      const Vec3T<T>& lo = nodes[i].getBoundingVolume().getLowCorner();
+      const Vec3T<T>& hi = nodes[i].getBoundingVolume().getHighCorner();
+
+      double covered = 0.0;
+
+      stack.assign(1, 0U);
+      while (!stack.empty()) {
+        const uint32_t j = stack.back();
+        stack.pop_back();
+
+        if (rank[j] >= rank[i] && rank[j] < rank[i] + subtreeSize[i]) {
+          continue;
         }
 
-        rrcnt += binCnt[b];
+        const NodeView&    other      = nodes[j];
+        const Vec3T<T> sectLo     = max(lo, other.getBoundingVolume().getLowCorner());
+        const Vec3T<T> sectHi     = min(hi, other.getBoundingVolume().getHighCorner());
+        const bool     intersects = sectLo[0] <= sectHi[0] && sectLo[1] <= sectHi[1] && sectLo[2] <= sectHi[2];
 
-        if (leftCnt[b - 1] > 0 && rrcnt > 0) {
-          const T cost = leftArea[b - 1] * T(leftCnt[b - 1]) + BV(rrlo, rrhi).getArea() * T(rrcnt);
+        if (!intersects) {
+          continue;
+        }
 
-          if (cost < bestCost) {
-            bestCost  = cost;
-            bestAxis  = axis;
-            bestPlane = lo + static_cast<T>(b) / scale;
+        if (other.isLeaf()) {
+          covered += area(BV(sectLo, sectHi));
+        }
+        else {
+          for (size_t k = 0; k < other.getNumChildren(); k++) {
+            stack.emplace_back(other.getChildOffsets()[k]);
           }
         }
       }
-    }
 
-    if (bestAxis < 0) {
-      return a_begin + nClusters / 2; // degenerate (all cluster centroids coincide): equal-count split
+      overlap[i] = nodeCost(nodes[i]) * std::min(covered, area(nodes[i].getBoundingVolume()));
     }
+  });
 
-    const auto pivot =
-      std::partition(clusters.begin() + a_begin,
-                     clusters.begin() + a_end,
-                     [bestAxis, bestPlane](const Cluster& a_c) noexcept { return a_c.centroid[bestAxis] < bestPlane; });
-    size_t split = static_cast<size_t>(pivot - clusters.begin());
-    if (split == a_begin || split == a_end) {
-      split = a_begin + nClusters / 2;
-    }
-    return split;
-  };
+  const double epoArea = std::accumulate(overlap.begin(), overlap.end(), 0.0);
 
-  // K-way SAH split: recursively bisect into floor(K/2)/ceil(K/2), mirroring SAHKWaySplit.
-  std::function<void(size_t, size_t, size_t, std::vector<std::pair<size_t, size_t>>&)> sahKWay =
-    [&](size_t a_begin, size_t a_end, size_t a_K, std::vector<std::pair<size_t, size_t>>& a_groups) -> void {
-    if (a_K <= 1 || a_begin >= a_end) {
-      a_groups.emplace_back(a_begin, a_end);
-      return;
-    }
+  metrics.epo = (weightedArea > 0.0) ? epoArea / weightedArea : 0.0;
 
-    const size_t K1 = a_K / 2;
-    const size_t K2 = a_K - K1;
+  return metrics;
+}
 
-    const size_t raw = sah2Way(a_begin, a_end);
-    const size_t mid = std::max(a_begin + K1, std::min(a_end - K2, raw));
+template <class T, class P, size_t K, class StoragePolicy>
+inline void
+PackedBVH<T, P, K, StoragePolicy>::optimize(size_t a_numPasses)
+{
+  if (this->isMapped()) {
+    std::cerr << "PackedBVH::optimize -- Error! A mapped PackedBVH is read-only\n";
 
-    sahKWay(a_begin, mid, K1, a_groups);
-    sahKWay(mid, a_end, K2, a_groups);
+    return;
+  }
+
+  if (this->hasGarbage()) {
+    this->compact();
+  }
+
+  if (m_linearNodes.empty() || m_linearNodes[0].isLeaf()) {
+    return;
+  }
+
+  // The treelets are restructured on complete node descriptions, packed back after every sweep that changed them.
+  std::vector<NodeView> views = this->getNodeViews();
+
+  const auto area = [](const Vec3T<T>& a_lo, const Vec3T<T>& a_hi) noexcept -> T {
+    const Vec3T<T> d = a_hi - a_lo;
+
+    return T(2) * (d[0] * d[1] + d[1] * d[2] + d[2] * d[0]);
   };
 
-  // Build the flat node array top-down (pre-order), populating the primitive block in DFS-leaf order
-  // so each leaf's primitives are a contiguous [offset, count) range.
-  auto primBlock = std::make_shared<std::vector<P>>();
+  // Height of every subtree (zero for a leaf). Exchanges keep the height of the treelet root from growing, so the
+  // tree never gets deeper than it was built.
+  std::vector<uint32_t> height(views.size(), 0U);
+
+  // Restructure the treelet below one node. Slots are either children of the node (level 1) or children of an
+  // interior child (level 2); two slots are exchanged when neither contains the other and the children's summed
+  // surface area drops. Only used slots take part, so every node keeps its number of children. Returns true if
+  // anything changed.
+  const auto restructure = [&](const uint32_t a_node) noexcept -> bool {
+    bool changed = false;
+
+    // Upper bound on the number of exchanges per treelet, and the smallest improvement that counts as one.
+    const size_t maxMoves    = K * K;
+    const T      threshold   = T(1.E-6) * views[a_node].getBoundingVolume().getArea();
+    const size_t numChildren = views[a_node].getNumChildren();
+
+    for (size_t move = 0; move < maxMoves; move++) {
+      const auto& child = views[a_node].getChildOffsets();
+
+      // Box and height of child j with its grandchild b left out, from prefix and suffix unions.
+      std::array<std::array<Vec3T<T>, K>, K> exclLo;
+      std::array<std::array<Vec3T<T>, K>, K> exclHi;
+      std::array<std::array<uint32_t, K>, K> exclHeight{};
+      std::array<T, K>                       childArea;
+      std::array<size_t, K>                  numGrand{};
+
+      uint32_t treeletHeight = 0U;
+      for (size_t j = 0; j < numChildren; j++) {
+        const NodeView& c = views[child[j]];
+
+        treeletHeight = std::max(treeletHeight, height[child[j]] + 1U);
+        childArea[j]  = area(c.getBoundingVolume().getLowCorner(), c.getBoundingVolume().getHighCorner());
+
+        if (c.isLeaf()) {
+          continue;
+        }
 
-  size_t total = 0;
+        const auto& grand = c.getChildOffsets();
 
-  for (const auto& c : clusters) {
-    total += c.prims.size();
-  }
+        numGrand[j] = c.getNumChildren();
 
-  primBlock->reserve(total);
+        Vec3T<T> lo = Vec3T<T>::infinity();
+        Vec3T<T> hi = -Vec3T<T>::infinity();
+        uint32_t h  = 0U;
+        for (size_t b = 0; b < numGrand[j]; b++) {
+          exclLo[j][b]     = lo;
+          exclHi[j][b]     = hi;
+          exclHeight[j][b] = h;
 
-  std::function<uint32_t(size_t, size_t)> build = [&](size_t a_begin, size_t a_end) -> uint32_t {
-    const uint32_t idx = static_cast<uint32_t>(m_linearNodes.size());
-    m_linearNodes.push_back({});
+          lo = min(lo, views[grand[b]].getBoundingVolume().getLowCorner());
+          hi = max(hi, views[grand[b]].getBoundingVolume().getHighCorner());
+          h  = std::max(h, height[grand[b]]);
+        }
 
-    Vec3T<T> nlo = +Vec3T<T>::max();
-    Vec3T<T> nhi = -Vec3T<T>::max();
+        lo = Vec3T<T>::infinity();
+        hi = -Vec3T<T>::infinity();
+        h  = 0U;
+        for (size_t b = numGrand[j]; b-- > 0;) {
+          exclLo[j][b]     = min(exclLo[j][b], lo);
+          exclHi[j][b]     = max(exclHi[j][b], hi);
+          exclHeight[j][b] = std::max(exclHeight[j][b], h);
+
+          lo = min(lo, views[grand[b]].getBoundingVolume().getLowCorner());
+          hi = max(hi, views[grand[b]].getBoundingVolume().getHighCorner());
+          h  = std::max(h, height[grand[b]]);
+        }
+      }
 
-    for (size_t i = a_begin; i < a_end; i++) {
-      nlo = min(nlo, clusters[i].bv.getLowCorner());
-      nhi = max(nhi, clusters[i].bv.getHighCorner());
+      // Height of the treelet root if the children in slots i and j (i == j allowed) had the given heights.
+      const auto newTreeletHeight = [&](size_t i, uint32_t hi, size_t j, uint32_t hj) noexcept -> uint32_t {
+        uint32_t h = std::max(hi, hj) + 1U;
+        for (size_t k = 0; k < numChildren; k++) {
+          if (k != i && k != j) {
+            h = std::max(h, height[child[k]] + 1U);
+          }
+        }
+        return h;
+      };
+
+      T      bestDelta = -threshold;
+      size_t bestJ     = K;
+      size_t bestB     = K;
+      size_t bestI     = K;
+      size_t bestA     = K;
+
+      for (size_t j = 0; j < numChildren; j++) {
+        if (views[child[j]].isLeaf()) {
+          continue;
+        }
+
+        const auto& grandJ = views[child[j]].getChildOffsets();
+
+        for (size_t b = 0; b < numGrand[j]; b++) {
+          const NodeView& g = views[grandJ[b]];
+
+          // Child i takes the place of grandchild b under child j; grandchild b moves up into slot i.
+          for (size_t i = 0; i < numChildren; i++) {
+            if (i == j) {
+              continue;
+            }
+
+            const NodeView& c = views[child[i]];
+
+            const T delta = area(min(exclLo[j][b], c.getBoundingVolume().getLowCorner()),
+                                 max(exclHi[j][b], c.getBoundingVolume().getHighCorner())) -
+                            childArea[j];
+
+            if (delta < bestDelta) {
+              const uint32_t hj = std::max(exclHeight[j][b], height[child[i]]) + 1U;
+
+              if (newTreeletHeight(i, height[grandJ[b]], j, hj) <= treeletHeight) {
+                bestDelta = delta;
+                bestJ     = j;
+                bestB     = b;
+                bestI     = i;
+                bestA     = K;
+              }
+            }
+          }
+
+          // Grandchild a under child i and grandchild b under child j trade places.
+          for (size_t i = j + 1; i < numChildren; i++) {
+            if (views[child[i]].isLeaf()) {
+              continue;
+            }
+
+            const auto& grandI = views[child[i]].getChildOffsets();
+
+            for (size_t a = 0; a < numGrand[i]; a++) {
+              const NodeView& f = views[grandI[a]];
+
+              const T delta = area(min(exclLo[j][b], f.getBoundingVolume().getLowCorner()),
+                                   max(exclHi[j][b], f.getBoundingVolume().getHighCorner())) +
+                              area(min(exclLo[i][a], g.getBoundingVolume().getLowCorner()),
+                                   max(exclHi[i][a], g.getBoundingVolume().getHighCorner())) -
+                              childArea[j] - childArea[i];
+
+              if (delta < bestDelta) {
+                const uint32_t hj = std::max(exclHeight[j][b], height[grandI[a]]) + 1U;
+                const uint32_t hi = std::max(exclHeight[i][a], height[grandJ[b]]) + 1U;
+
+                if (newTreeletHeight(i, hi, j, hj) <= treeletHeight) {
+                  bestDelta = delta;
+                  bestJ     = j;
+                  bestB     = b;
+                  bestI     = i;
+                  bestA     = a;
+                }
+              }
+            }
+          }
+        }
+      }
+
+      if (bestJ == K) {
+        break;
+      }
+
+      // Apply the exchange, then refresh the box and height of every child whose grandchildren changed.
+      const uint32_t childJ = child[bestJ];
+      const uint32_t childI = child[bestI];
+
+      if (bestA == K) {
+        const uint32_t grand = views[childJ].getChildOffsets()[bestB];
+
+        views[childJ].setChildOffset(childI, bestB);
+        views[a_node].setChildOffset(grand, bestI);
+      }
+      else {
+        const uint32_t grandJ = views[childJ].getChildOffsets()[bestB];
+        const uint32_t grandI = views[childI].getChildOffsets()[bestA];
+
+        views[childJ].setChildOffset(grandI, bestB);
+        views[childI].setChildOffset(grandJ, bestA);
+      }
+
+      for (const uint32_t c : {childJ, childI}) {
+        NodeView& node = views[c];
+
+        if (node.isLeaf()) {
+          continue;
+        }
+
+        Vec3T<T> lo = Vec3T<T>::infinity();
+        Vec3T<T> hi = -Vec3T<T>::infinity();
+        uint32_t h  = 0U;
+        for (size_t k = 0; k < node.getNumChildren(); k++) {
+          const uint32_t g = node.getChildOffsets()[k];
+
+          lo = min(lo, views[g].getBoundingVolume().getLowCorner());
+          hi = max(hi, views[g].getBoundingVolume().getHighCorner());
+          h  = std::max(h, height[g] + 1U);
+        }
+
+        node.setBoundingVolume(BV(lo, hi));
+        height[c] = h;
+      }
+
+      changed = true;
     }
 
-    m_linearNodes[idx].setBoundingVolume(BV(nlo, nhi));
+    return changed;
+  };
 
-    if (a_end - a_begin < K) {
-      // Leaf: fewer than K clusters -- append their primitives to the block, contiguously.
-      m_linearNodes[idx].setPrimitivesOffset(static_cast<uint32_t>(primBlock->size()));
+  for (size_t pass = 0; pass < a_numPasses; pass++) {
+    const size_t numNodes = views.size();
 
-      uint32_t count = 0;
+    // views is in pre-order here, so a forward sweep sees parents before children and a reverse sweep
+    // children before parents.
+    std::vector<uint32_t> depth(numNodes, 0U);
+    for (size_t i = 0; i < numNodes; i++) {
+      const NodeView& node = views[i];
 
-      for (size_t i = a_begin; i < a_end; i++) {
-        for (auto& pb : clusters[i].prims) {
-          primBlock->push_back(std::move(pb.first));
-          count++;
+      if (!node.isLeaf()) {
+        for (size_t k = 0; k < node.getNumChildren(); k++) {
+          depth[node.getChildOffsets()[k]] = depth[i] + 1U;
         }
       }
-      m_linearNodes[idx].setNumPrimitives(count);
     }
-    else {
-      std::vector<std::pair<size_t, size_t>> groups;
-      groups.reserve(K);
-      sahKWay(a_begin, a_end, K, groups);
+    for (size_t i = numNodes; i-- > 0;) {
+      const NodeView& node = views[i];
 
-      for (size_t k = 0; k < K; k++) {
-        const uint32_t childIdx = build(groups[k].first, groups[k].second);
-        m_linearNodes[idx].setChildOffset(childIdx, k);
+      height[i] = 0U;
+      if (!node.isLeaf()) {
+        for (size_t k = 0; k < node.getNumChildren(); k++) {
+          height[i] = std::max(height[i], height[node.getChildOffsets()[k]] + 1U);
+        }
       }
     }
 
-    return idx;
-  };
-  build(0, clusters.size());
+    // Interior nodes grouped by depth. A treelet only reaches two levels down, so treelets rooted at the same depth
+    // never share a node.
+    const uint32_t                     maxDepth = *std::max_element(depth.begin(), depth.end());
+    std::vector<std::vector<uint32_t>> levels(maxDepth + 1);
+    for (size_t i = 0; i < numNodes; i++) {
+      if (!views[i].isLeaf()) {
+        levels[depth[i]].emplace_back(static_cast<uint32_t>(i));
+      }
+    }
 
-  StoragePolicy::appendAliased(m_primitives, primBlock);
+    std::atomic<bool> changed{false};
+    for (size_t d = levels.size(); d-- > 0;) {
+      const auto& level = levels[d];
 
-  buildSoA();
-}
+      Parallel::parallelFor(0, level.size(), 64, [&](size_t a_lo, size_t a_hi) noexcept {
+        bool any = false;
+        for (size_t i = a_lo; i < a_hi; i++) {
+          any = restructure(level[i]) || any;
+        }
+        if (any) {
+          changed.store(true);
+        }
+      });
+    }
 
-template <class T, class P, size_t K, class StoragePolicy>
-inline const std::vector<typename PackedBVH<T, P, K, StoragePolicy>::StorageType>&
-PackedBVH<T, P, K, StoragePolicy>::getPrimitives() const noexcept
-{
-  return m_primitives;
+    if (!changed.load()) {
+      break;
+    }
+
+    // Pack the changed boxes and links back into the SoA records. An exchange can move a node below one that comes
+    // after it in the array. Re-emitting the node array in depth-first pre-order restores the parent-before-child
+    // order that the next sweep and refit() rely on.
+    this->packNodes(views);
+    this->reorderNodes(this->getNodeOrder(Layout::DepthFirst));
+
+    views = this->getNodeViews();
+  }
 }
 
 template <class T, class P, size_t K, class StoragePolicy>
-inline const EBGeometry::BoundingVolumes::AABBT<T>&
-PackedBVH<T, P, K, StoragePolicy>::getBoundingVolume() const noexcept
+inline void
+PackedBVH<T, P, K, StoragePolicy>::relayout(const Layout a_layout)
 {
-  return m_linearNodes.front().getBoundingVolume();
+  if (this->isMapped()) {
+    std::cerr << "PackedBVH::relayout -- Error! A mapped PackedBVH is read-only\n";
+
+    return;
+  }
+
+  if (m_linearNodes.empty()) {
+    return;
+  }
+
+  this->reorderNodes(this->getNodeOrder(a_layout));
 }
 
 template <class T, class P, size_t K, class StoragePolicy>
-inline EBGeometry::BoundingVolumes::AABBT<T>
-PackedBVH<T, P, K, StoragePolicy>::computeBoundingVolume() const noexcept
+inline void
+PackedBVH<T, P, K, StoragePolicy>::relayout(const std::vector<uint64_t>& a_visits)
 {
-  return m_linearNodes.front().getBoundingVolume();
+  if (this->isMapped()) {
+    std::cerr << "PackedBVH::relayout -- Error! A mapped PackedBVH is read-only\n";
+
+    return;
+  }
+
+  const size_t numNodes = m_linearNodes.size();
+
+  if (numNodes == 0) {
+    return;
+  }
+
+  // Ties go to the node that comes first in depth-first pre-order, so nodes never visited keep that order.
+  const std::vector<uint32_t> depthFirst = this->getNodeOrder(Layout::DepthFirst);
+
+  std::vector<uint32_t> rank(numNodes);
+  for (size_t i = 0; i < numNodes; i++) {
+    rank[depthFirst[i]] = static_cast<uint32_t>(i);
+  }
+
+  const auto visits = [&a_visits](const uint32_t a_node) noexcept -> uint64_t {
+    return (a_node < a_visits.size()) ? a_visits[a_node] : 0U;
+  };
+
+  const auto colder = [&visits, &rank](const uint32_t a_lhs, const uint32_t a_rhs) noexcept -> bool {
+    return visits(a_lhs) < visits(a_rhs) || (visits(a_lhs) == visits(a_rhs) && rank[a_lhs] > rank[a_rhs]);
+  };
+
+  // Nodes whose parent has been emitted, hottest on top.
+  std::priority_queue<uint32_t, std::vector<uint32_t>, decltype(colder)> frontier(colder);
+
+  std::vector<uint32_t> order;
+  order.reserve(numNodes);
+
+  frontier.push(0U);
+  while (!frontier.empty()) {
+    const uint32_t node = frontier.top();
+    frontier.pop();
+
+    order.emplace_back(node);
+
+    if (!m_linearNodes[node].isLeaf()) {
+      for (size_t k = 0; k < m_linearNodes[node].getNumChildren(); k++) {
+        frontier.push(m_linearNodes[node].getChildOffsets()[k]);
+      }
+    }
+  }
+
+  this->reorderNodes(order);
 }
 
 template <class T, class P, size_t K, class StoragePolicy>
-template <class NodeKey>
+template <class State, class LeafEvaluator, class PruneDistSquared>
 inline void
-PackedBVH<T, P, K, StoragePolicy>::traverse(const BVH::PackedLeafEvaluator<P, StoragePolicy>& a_leafEvaluator,
-                                            const BVH::PrunePredicate<Node, NodeKey>&         a_prunePredicate,
-                                            const BVH::PackedChildOrderer<NodeKey, K>&        a_childOrderer,
-                                            const BVH::NodeKeyFactory<Node, NodeKey>& a_nodeKeyFactory) const noexcept
+PackedBVH<T, P, K, StoragePolicy>::recordVisits(std::vector<uint64_t>& a_visits,
+                                                const Vec3T<T>&        a_point,
+                                                State&                 a_state,
+                                                LeafEvaluator&&        a_evalLeaf,
+                                                PruneDistSquared&&     a_pruneDist2) const
 {
-  std::array<std::pair<uint32_t, NodeKey>, K> children;
+  const Node* const nodes  = this->getNodeData();
+  const Leaf* const leaves = this->getLeafData();
 
-  // Vector-backed stack avoids deque chunk allocations; reserve avoids reallocs.
-  std::vector<std::pair<uint32_t, NodeKey>> q;
+  if (a_visits.size() < this->getNumNodes()) {
+    a_visits.resize(this->getNumNodes(), 0U);
+  }
 
-  q.reserve(64);
-  q.emplace_back(static_cast<uint32_t>(0), a_nodeKeyFactory(m_linearNodes[0]));
+  if (this->getNumNodes() == 0) {
+    return;
+  }
 
-  while (!q.empty()) {
-    const uint32_t nodeIdx = q.back().first;
-    const NodeKey  nodeKey = q.back().second;
-    q.pop_back();
+  // The scalar fallback of pruneTraverse() (see traverse()), counting every node that passes the pruning test. Same
+  // child order, and so the same visits, as the (index, squared distance) pairs are sorted the same way.
+  std::array<std::pair<uint32_t, T>, K> children;
+  std::vector<std::pair<uint32_t, T>>   stack(1, {0U, this->getBoundingVolume().getDistance2(a_point)});
 
-    const Node& node = m_linearNodes[nodeIdx];
+  while (!stack.empty()) {
+    const auto [index, d2] = stack.back();
+    stack.pop_back();
 
-    if (a_prunePredicate(node, nodeKey)) {
-      if (node.isLeaf()) {
-        a_leafEvaluator(m_primitives, node.getPrimitivesOffset(), node.getNumPrimitives());
+    if (!(d2 <= a_pruneDist2(a_state))) {
+      continue;
+    }
+
+    a_visits[index]++;
+
+    const Node& node = nodes[index];
+
+    if (node.isLeaf()) {
+      const Leaf& leaf = leaves[node.getLeafIndex()];
+
+      a_evalLeaf(a_state, leaf.m_primOff, leaf.m_numPrims);
+    }
+    else {
+      for (size_t k = 0; k < K; k++) {
+        const uint32_t child = node.getChildOffsets()[k];
+
+        children[k].first  = child;
+        children[k].second = (child == EmptyChild)
+                               ? T{}
+                               : this->getChildBoundingVolume(node.getChildBoxesIndex(), k).getDistance2(a_point);
       }
-      else {
-        for (size_t k = 0; k < K; k++) {
-          const uint32_t childIdx = node.getChildOffsets()[k];
-          children[k].first       = childIdx;
-          children[k].second      = a_nodeKeyFactory(m_linearNodes[childIdx]);
-        }
 
-        a_childOrderer(children);
+      std::sort(children.begin(),
+                children.end(),
+                [](const std::pair<uint32_t, T>& a, const std::pair<uint32_t, T>& b) noexcept {
+                  return a.second > b.second;
+                });
 
-        for (const auto& child : children) {
-          q.push_back(child);
+      for (const auto& child : children) {
+        if (child.first != EmptyChild) {
+          stack.emplace_back(child);
         }
       }
     }
@@ -1096,559 +4628,640 @@ PackedBVH<T, P, K, StoragePolicy>::traverse(const BVH::PackedLeafEvaluator<P, St
 }
 
 template <class T, class P, size_t K, class StoragePolicy>
-template <class State, class LeafEvaluator, class PruneDistSquared>
-inline void
-PackedBVH<T, P, K, StoragePolicy>::pruneTraverse(const Vec3T<T>&    a_point,
-                                                 State&             a_state,
-                                                 LeafEvaluator&&    a_evalLeaf,
-                                                 PruneDistSquared&& a_pruneDist2) const noexcept
+inline std::vector<uint32_t>
+PackedBVH<T, P, K, StoragePolicy>::getNodeOrder(const Layout a_layout) const
 {
-  struct StackEntry
-  {
-    uint32_t idx;
-    T        dist2;
+  const Node* const nodes    = this->getNodeData();
+  const size_t      numNodes = this->getNumNodes();
+
+  std::vector<uint32_t> order;
+  order.reserve(numNodes);
+
+  if (numNodes == 0) {
+    return order;
+  }
+
+  // Appends the children of a node to a list, left to right.
+  const auto appendChildren = [nodes](const uint32_t a_node, std::vector<uint32_t>& a_list) {
+    if (!nodes[a_node].isLeaf()) {
+      for (size_t k = 0; k < nodes[a_node].getNumChildren(); k++) {
+        a_list.emplace_back(nodes[a_node].getChildOffsets()[k]);
+      }
+    }
   };
 
-  // ──────────────────────────────────────────────────────────────────────────────
-  // AVX-512F paths: K==8/double and K==16/float.
-  //
-  // When compiled with -mavx512f these are selected in preference to the AVX
-  // paths below because they appear first and each path ends with a return.
-  // The compiler will dead-code-eliminate the corresponding AVX branches.
-  //
-  // Alignment: ChildAABBSoA uses alignas(sizeof(T)*K), which equals 64 bytes
-  // for both (K=8, T=double) and (K=16, T=float).  _mm512_load_pd / _mm512_load_ps
-  // both require 64-byte alignment — the static_assert below catches any mismatch.
-  //
-  // Recommended configurations on AVX-512 hardware:
-  //   float  → K=16, W=16  (one _mm512_load_ps covers all children and one leaf group)
-  //   double → K=8,  W=8   (one _mm512_load_pd covers all children; AVX-512F replaces
-  //                          the 2×_mm256_load_pd emulation in the AVX fallback below)
-  // ──────────────────────────────────────────────────────────────────────────────
-#if defined(__AVX512F__)
-  if constexpr (K == 8 && std::is_same_v<T, double>) {
-    static_assert(alignof(ChildAABBSoA) == sizeof(T) * K,
-                  "ChildAABBSoA alignment mismatch: _mm512_load_pd requires 64-byte alignment");
+  switch (a_layout) {
+  case Layout::DepthFirst: {
+    std::vector<uint32_t> stack(1, 0U);
+    std::vector<uint32_t> children;
 
-    const __m512d px   = _mm512_set1_pd(a_point[0]);
-    const __m512d py   = _mm512_set1_pd(a_point[1]);
-    const __m512d pz   = _mm512_set1_pd(a_point[2]);
-    const __m512d zero = _mm512_setzero_pd();
+    while (!stack.empty()) {
+      const uint32_t node = stack.back();
+      stack.pop_back();
 
-    alignas(64) StackEntry stack[256];
+      order.emplace_back(node);
 
-    int top      = 0;
-    stack[top++] = {0U, 0.0};
+      // Pushed last to first, so the first child is emitted next.
+      children.clear();
+      appendChildren(node, children);
+      stack.insert(stack.end(), children.rbegin(), children.rend());
+    }
 
-    while (top > 0) {
-      const StackEntry entry    = stack[--top];
-      const double     curBest2 = static_cast<double>(a_pruneDist2(a_state));
+    break;
+  }
+  case Layout::BreadthFirst: {
+    order.emplace_back(0U);
+    for (size_t i = 0; i < order.size(); i++) {
+      appendChildren(order[i], order);
+    }
 
-      if (entry.dist2 > curBest2) {
-        continue;
+    break;
+  }
+  case Layout::VanEmdeBoas: {
+    // Number of levels in every subtree, from a reverse sweep (children come after their parents).
+    std::vector<uint32_t> levels(numNodes, 1U);
+    for (size_t i = numNodes; i-- > 0;) {
+      if (!nodes[i].isLeaf()) {
+        for (size_t k = 0; k < nodes[i].getNumChildren(); k++) {
+          levels[i] = std::max(levels[i], levels[nodes[i].getChildOffsets()[k]] + 1U);
+        }
       }
+    }
 
-      const Node& node = m_linearNodes[entry.idx];
+    // Emit the top a_levels levels below a_root: the upper half of them as one block, then the subtrees hanging
+    // below that block, left to right, each laid out the same way.
+    std::function<void(uint32_t, uint32_t)> emit = [&](const uint32_t a_root, const uint32_t a_levels) -> void {
+      if (a_levels <= 1 || nodes[a_root].isLeaf()) {
+        order.emplace_back(a_root);
 
-      if (node.isLeaf()) {
-        a_evalLeaf(a_state, node.getPrimitivesOffset(), node.getNumPrimitives());
+        return;
       }
-      else {
-        const auto& soa = m_childAabbSoA[entry.idx];
 
-        const __m512d lo_x = _mm512_load_pd(soa.m_lo[0]);
-        const __m512d lo_y = _mm512_load_pd(soa.m_lo[1]);
-        const __m512d lo_z = _mm512_load_pd(soa.m_lo[2]);
-        const __m512d hi_x = _mm512_load_pd(soa.m_hi[0]);
-        const __m512d hi_y = _mm512_load_pd(soa.m_hi[1]);
-        const __m512d hi_z = _mm512_load_pd(soa.m_hi[2]);
+      const uint32_t top = a_levels / 2;
 
-        const __m512d dx = _mm512_max_pd(zero, _mm512_max_pd(_mm512_sub_pd(lo_x, px), _mm512_sub_pd(px, hi_x)));
-        const __m512d dy = _mm512_max_pd(zero, _mm512_max_pd(_mm512_sub_pd(lo_y, py), _mm512_sub_pd(py, hi_y)));
-        const __m512d dz = _mm512_max_pd(zero, _mm512_max_pd(_mm512_sub_pd(lo_z, pz), _mm512_sub_pd(pz, hi_z)));
-        const __m512d d2 =
-          _mm512_add_pd(_mm512_mul_pd(dx, dx), _mm512_add_pd(_mm512_mul_pd(dy, dy), _mm512_mul_pd(dz, dz)));
+      emit(a_root, top);
 
-        alignas(64) double dist2[K];
-        _mm512_store_pd(dist2, d2);
+      std::vector<uint32_t> below(1, a_root);
+      for (uint32_t l = 0; l < top; l++) {
+        std::vector<uint32_t> next;
+        for (const uint32_t node : below) {
+          appendChildren(node, next);
+        }
+        below = std::move(next);
+      }
 
-        const auto&                                offsets = node.getChildOffsets();
-        std::array<std::pair<double, uint32_t>, K> children;
+      for (const uint32_t subtree : below) {
+        emit(subtree, std::min(a_levels - top, levels[subtree]));
+      }
+    };
 
-        for (size_t k = 0; k < K; k++) {
-          children[k] = {dist2[k], offsets[k]};
-        }
+    emit(0U, levels[0]);
 
-        std::sort(children.begin(),
-                  children.end(),
-                  [](const std::pair<double, uint32_t>& a, const std::pair<double, uint32_t>& b) noexcept {
-                    return a.first > b.first;
-                  });
+    break;
+  }
+  }
 
-        const double newBest2 = static_cast<double>(a_pruneDist2(a_state));
+  EBGEOMETRY_EXPECT(order.size() + m_numDeadNodes == numNodes);
 
-        for (const auto& [d, idx] : children) {
-          if (d <= newBest2) {
-            stack[top++] = {idx, d};
-          }
-        }
-      }
-    }
+  return order;
+}
 
-    return;
-  }
+template <class T, class P, size_t K, class StoragePolicy>
+inline void
+PackedBVH<T, P, K, StoragePolicy>::reorderNodes(const std::vector<uint32_t>& a_order)
+{
+  const size_t numNodes = a_order.size();
 
-  if constexpr (K == 16 && std::is_same_v<T, float>) {
-    static_assert(alignof(ChildAABBSoA) == sizeof(T) * K,
-                  "ChildAABBSoA alignment mismatch: _mm512_load_ps requires 64-byte alignment");
+  // Dead nodes are unreachable, so they are not in the order and are dropped here, along with their records.
+  EBGEOMETRY_EXPECT(numNodes + m_numDeadNodes == m_linearNodes.size());
 
-    const __m512 px   = _mm512_set1_ps((float)a_point[0]);
-    const __m512 py   = _mm512_set1_ps((float)a_point[1]);
-    const __m512 pz   = _mm512_set1_ps((float)a_point[2]);
-    const __m512 zero = _mm512_setzero_ps();
+  // The maps of the partial refit() hold node indices.
+  m_parentIndices.clear();
 
-    alignas(64) StackEntry stack[256];
+  std::vector<uint32_t> newIndex(m_linearNodes.size(), EmptyChild);
+  for (size_t i = 0; i < numNodes; i++) {
+    newIndex[a_order[i]] = static_cast<uint32_t>(i);
+  }
 
-    int top      = 0;
-    stack[top++] = {0U, 0.f};
+  // SoA and leaf records are renumbered in the new node order.
+  std::vector<uint32_t> refs(numNodes);
 
-    while (top > 0) {
-      const StackEntry entry    = stack[--top];
-      const float      curBest2 = static_cast<float>(a_pruneDist2(a_state));
+  uint32_t numInterior = 0;
+  uint32_t numLeaves   = 0;
+  for (size_t i = 0; i < numNodes; i++) {
+    refs[i] = m_linearNodes[a_order[i]].isLeaf() ? (s_leafFlag | numLeaves++) : numInterior++;
+  }
 
-      if (entry.dist2 > curBest2) {
-        continue;
-      }
+  std::vector<Node>         nodes(numNodes);
+  std::vector<ChildAABBSoA> childAabbSoA(numInterior);
+  std::vector<Leaf>         leaves(numLeaves);
 
-      const Node& node = m_linearNodes[entry.idx];
+  Parallel::parallelFor(0, numNodes, 4096, [&](size_t a_lo, size_t a_hi) noexcept {
+    for (size_t i = a_lo; i < a_hi; i++) {
+      Node node = m_linearNodes[a_order[i]];
 
       if (node.isLeaf()) {
-        a_evalLeaf(a_state, node.getPrimitivesOffset(), node.getNumPrimitives());
+        leaves[refs[i] & ~s_leafFlag] = m_leaves[node.getLeafIndex()];
       }
       else {
-        const auto& soa = m_childAabbSoA[entry.idx];
-
-        const __m512 lo_x = _mm512_load_ps(soa.m_lo[0]);
-        const __m512 lo_y = _mm512_load_ps(soa.m_lo[1]);
-        const __m512 lo_z = _mm512_load_ps(soa.m_lo[2]);
-        const __m512 hi_x = _mm512_load_ps(soa.m_hi[0]);
-        const __m512 hi_y = _mm512_load_ps(soa.m_hi[1]);
-        const __m512 hi_z = _mm512_load_ps(soa.m_hi[2]);
-
-        const __m512 dx = _mm512_max_ps(zero, _mm512_max_ps(_mm512_sub_ps(lo_x, px), _mm512_sub_ps(px, hi_x)));
-        const __m512 dy = _mm512_max_ps(zero, _mm512_max_ps(_mm512_sub_ps(lo_y, py), _mm512_sub_ps(py, hi_y)));
-        const __m512 dz = _mm512_max_ps(zero, _mm512_max_ps(_mm512_sub_ps(lo_z, pz), _mm512_sub_ps(pz, hi_z)));
-        const __m512 d2 =
-          _mm512_add_ps(_mm512_mul_ps(dx, dx), _mm512_add_ps(_mm512_mul_ps(dy, dy), _mm512_mul_ps(dz, dz)));
+        childAabbSoA[refs[i]] = m_childAabbSoA[node.getChildBoxesIndex()];
 
-        alignas(64) float dist2[K];
-        _mm512_store_ps(dist2, d2);
-
-        const auto&                               offsets = node.getChildOffsets();
-        std::array<std::pair<float, uint32_t>, K> children;
+        for (size_t k = 0; k < node.getNumChildren(); k++) {
+          node.setChildOffset(newIndex[node.getChildOffsets()[k]], k);
 
-        for (size_t k = 0; k < K; k++) {
-          children[k] = {dist2[k], offsets[k]};
+          EBGEOMETRY_EXPECT(node.getChildOffsets()[k] > i);
         }
+      }
 
-        std::sort(children.begin(),
-                  children.end(),
-                  [](const std::pair<float, uint32_t>& a, const std::pair<float, uint32_t>& b) noexcept {
-                    return a.first > b.first;
-                  });
+      node.m_ref = refs[i];
+      nodes[i]   = node;
+    }
+  });
 
-        const float newBest2 = static_cast<float>(a_pruneDist2(a_state));
+  m_linearNodes  = std::move(nodes);
+  m_childAabbSoA = std::move(childAabbSoA);
+  m_leaves       = std::move(leaves);
+  m_numDeadNodes = 0;
+}
 
-        for (const auto& [d, idx] : children) {
-          if (d <= newBest2) {
-            stack[top++] = {idx, d};
-          }
-        }
-      }
-    }
+template <class T, class P, size_t K, class StoragePolicy>
+inline bool
+PackedBVH<T, P, K, StoragePolicy>::save(std::ostream& a_stream) const
+{
+  static_assert(std::is_trivially_copyable_v<StorageType>,
+                "PackedBVH::save requires BVH::ValueStorage over a trivially copyable primitive");
 
-    return;
+  if (this->hasGarbage()) {
+    PackedBVH compacted(*this);
+    compacted.compact();
+
+    return compacted.save(a_stream);
   }
-#endif // __AVX512F__
 
-  // ──────────────────────────────────────────────────────────────────────────────
-  // AVX paths: K==4/double (single pass), K==8/float (single pass),
-  //            K==8/double (two 4-wide passes — superseded by AVX-512F above).
-  // ──────────────────────────────────────────────────────────────────────────────
-#if defined(__AVX__)
-  if constexpr (K == 4 && std::is_same_v<T, double>) {
-    static_assert(alignof(ChildAABBSoA) == sizeof(T) * K,
-                  "ChildAABBSoA alignment mismatch: _mm256_load_pd requires 32-byte alignment");
+  using Record = Detail::SerializedNode<K>;
 
-    const __m256d px   = _mm256_set1_pd(a_point[0]);
-    const __m256d py   = _mm256_set1_pd(a_point[1]);
-    const __m256d pz   = _mm256_set1_pd(a_point[2]);
-    const __m256d zero = _mm256_setzero_pd();
+  const uint64_t alignment =
+    std::max({Detail::SerializationAlignment, uint64_t(alignof(ChildAABBSoA)), uint64_t(alignof(StorageType))});
 
-    alignas(32) StackEntry stack[256];
+  const auto align = [alignment](uint64_t a_offset) noexcept -> uint64_t {
+    return (a_offset + alignment - 1) / alignment * alignment;
+  };
 
-    int top      = 0;
-    stack[top++] = {0U, 0.0};
+  const Node* const nodes       = this->getNodeData();
+  const uint64_t    numNodes    = this->getNumNodes();
+  const uint64_t    numInterior = this->getNumInteriorNodes();
+  const uint64_t    numLeaves   = this->getNumLeaves();
+  const uint64_t    numPrims    = this->getNumPrimitives();
+
+  Detail::SerializationHeader header{};
+
+  std::copy(std::begin(Detail::SerializationMagic), std::end(Detail::SerializationMagic), header.magic);
+
+  header.version          = SerializationVersion;
+  header.endianTag        = Detail::SerializationEndianTag;
+  header.precision        = sizeof(T);
+  header.branchingRatio   = K;
+  header.nodeSize         = sizeof(Record);
+  header.soaSize          = sizeof(ChildAABBSoA);
+  header.leafSize         = sizeof(Detail::SerializedLeaf);
+  header.primitiveSize    = sizeof(StorageType);
+  header.primitiveAlign   = alignof(StorageType);
+  header.numNodes         = numNodes;
+  header.numInteriorNodes = numInterior;
+  header.numLeaves        = numLeaves;
+  header.numPrimitives    = numPrims;
+  header.nodesOffset      = align(sizeof(header));
+  header.soaOffset        = align(header.nodesOffset + numNodes * sizeof(Record));
+  header.leavesOffset     = align(header.soaOffset + numInterior * sizeof(ChildAABBSoA));
+  header.primitivesOffset = align(header.leavesOffset + numLeaves * sizeof(Detail::SerializedLeaf));
+  header.size             = header.primitivesOffset + numPrims * sizeof(StorageType);
+
+  for (size_t dir = 0; dir < 3 && numNodes > 0; dir++) {
+    header.rootLo[dir] = static_cast<double>(this->getBoundingVolume().getLowCorner()[dir]);
+    header.rootHi[dir] = static_cast<double>(this->getBoundingVolume().getHighCorner()[dir]);
+  }
 
-    while (top > 0) {
-      const StackEntry entry    = stack[--top];
-      const double     curBest2 = static_cast<double>(a_pruneDist2(a_state));
+  // Value-initialized, so the padding bytes of a record (if any) are written as zeros.
+  std::vector<Record>                 records(numNodes);
+  std::vector<Detail::SerializedLeaf> leafRecords(numLeaves);
 
-      if (entry.dist2 > curBest2) {
-        continue;
-      }
+  for (size_t i = 0; i < numNodes; i++) {
+    records[i].ref = nodes[i].m_ref;
 
-      const Node& node = m_linearNodes[entry.idx];
-      if (node.isLeaf()) {
-        a_evalLeaf(a_state, node.getPrimitivesOffset(), node.getNumPrimitives());
-      }
-      else {
-        const auto& soa = m_childAabbSoA[entry.idx];
+    std::copy(nodes[i].getChildOffsets().begin(), nodes[i].getChildOffsets().end(), records[i].childOff);
+  }
+  for (size_t i = 0; i < numLeaves; i++) {
+    leafRecords[i].primOff  = this->getLeafData()[i].m_primOff;
+    leafRecords[i].numPrims = this->getLeafData()[i].m_numPrims;
+  }
 
-        const __m256d lo_x = _mm256_load_pd(soa.m_lo[0]);
-        const __m256d lo_y = _mm256_load_pd(soa.m_lo[1]);
-        const __m256d lo_z = _mm256_load_pd(soa.m_lo[2]);
-        const __m256d hi_x = _mm256_load_pd(soa.m_hi[0]);
-        const __m256d hi_y = _mm256_load_pd(soa.m_hi[1]);
-        const __m256d hi_z = _mm256_load_pd(soa.m_hi[2]);
+  // Write a block at its offset, zero-filling the gap left by the previous one.
+  uint64_t   position   = 0;
+  const auto writeBlock = [&](uint64_t a_offset, const void* a_data, uint64_t a_numBytes) {
+    const std::vector<char> padding(a_offset - position, 0);
 
-        const __m256d dx = _mm256_max_pd(zero, _mm256_max_pd(_mm256_sub_pd(lo_x, px), _mm256_sub_pd(px, hi_x)));
-        const __m256d dy = _mm256_max_pd(zero, _mm256_max_pd(_mm256_sub_pd(lo_y, py), _mm256_sub_pd(py, hi_y)));
-        const __m256d dz = _mm256_max_pd(zero, _mm256_max_pd(_mm256_sub_pd(lo_z, pz), _mm256_sub_pd(pz, hi_z)));
-        const __m256d d2 =
-          _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_add_pd(_mm256_mul_pd(dy, dy), _mm256_mul_pd(dz, dz)));
+    a_stream.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+    a_stream.write(static_cast<const char*>(a_data), static_cast<std::streamsize>(a_numBytes));
 
-        alignas(32) double dist2[K];
+    position = a_offset + a_numBytes;
+  };
 
-        _mm256_store_pd(dist2, d2);
+  writeBlock(0, &header, sizeof(header));
+  writeBlock(header.nodesOffset, records.data(), numNodes * sizeof(Record));
+  writeBlock(header.soaOffset, this->getChildAabbData(), numInterior * sizeof(ChildAABBSoA));
+  writeBlock(header.leavesOffset, leafRecords.data(), numLeaves * sizeof(Detail::SerializedLeaf));
+  writeBlock(header.primitivesOffset, this->getPrimitiveData(), numPrims * sizeof(StorageType));
 
-        const auto&                                offsets = node.getChildOffsets();
-        std::array<std::pair<double, uint32_t>, K> children;
+  if (!a_stream) {
+    std::cerr << "PackedBVH::save -- Error! Could not write to stream\n";
 
-        for (size_t k = 0; k < K; k++) {
-          children[k] = {dist2[k], offsets[k]};
-        }
+    return false;
+  }
 
-        std::sort(children.begin(),
-                  children.end(),
-                  [](const std::pair<double, uint32_t>& a, const std::pair<double, uint32_t>& b) noexcept {
-                    return a.first > b.first;
-                  });
+  return true;
+}
 
-        const double newBest2 = static_cast<double>(a_pruneDist2(a_state));
+template <class T, class P, size_t K, class StoragePolicy>
+inline bool
+PackedBVH<T, P, K, StoragePolicy>::save(const std::string& a_filename) const
+{
+  std::ofstream file(a_filename, std::ios::binary | std::ios::trunc);
 
-        for (const auto& [d, idx] : children) {
-          if (d <= newBest2)
-            stack[top++] = {idx, d};
-        }
-      }
-    }
+  if (!file) {
+    std::cerr << "PackedBVH::save -- Error! Could not open file " + a_filename + "\n";
 
-    return;
+    return false;
   }
-  if constexpr (K == 8 && std::is_same_v<T, float>) {
-    static_assert(alignof(ChildAABBSoA) == sizeof(T) * K,
-                  "ChildAABBSoA alignment mismatch: _mm256_load_ps requires 32-byte alignment");
-
-    const __m256 px   = _mm256_set1_ps((float)a_point[0]);
-    const __m256 py   = _mm256_set1_ps((float)a_point[1]);
-    const __m256 pz   = _mm256_set1_ps((float)a_point[2]);
-    const __m256 zero = _mm256_setzero_ps();
 
-    alignas(32) StackEntry stack[256];
+  return this->save(file);
+}
 
-    int top      = 0;
-    stack[top++] = {0U, 0.f};
+template <class T, class P, size_t K, class StoragePolicy>
+inline bool
+PackedBVH<T, P, K, StoragePolicy>::checkHeader(const Detail::SerializationHeader& a_header, const char* a_caller)
+{
+  using Record = Detail::SerializedNode<K>;
 
-    while (top > 0) {
-      const StackEntry entry    = stack[--top];
-      const float      curBest2 = static_cast<float>(a_pruneDist2(a_state));
+  if (!std::equal(std::begin(a_header.magic), std::end(a_header.magic), Detail::SerializationMagic)) {
+    std::cerr << a_caller << " -- Error! Stream does not hold a PackedBVH\n";
 
-      if (entry.dist2 > curBest2) {
-        continue;
-      }
+    return false;
+  }
+  if (a_header.endianTag != Detail::SerializationEndianTag) {
+    std::cerr << a_caller << " -- Error! PackedBVH was written on a machine with a different byte order\n";
 
-      const Node& node = m_linearNodes[entry.idx];
-      if (node.isLeaf()) {
-        a_evalLeaf(a_state, node.getPrimitivesOffset(), node.getNumPrimitives());
-      }
-      else {
-        const auto& soa = m_childAabbSoA[entry.idx];
+    return false;
+  }
+  if (a_header.version != SerializationVersion) {
+    std::cerr << a_caller << " -- Error! Unsupported format version " << a_header.version << "\n";
 
-        const __m256 lo_x = _mm256_load_ps(soa.m_lo[0]);
-        const __m256 lo_y = _mm256_load_ps(soa.m_lo[1]);
-        const __m256 lo_z = _mm256_load_ps(soa.m_lo[2]);
-        const __m256 hi_x = _mm256_load_ps(soa.m_hi[0]);
-        const __m256 hi_y = _mm256_load_ps(soa.m_hi[1]);
-        const __m256 hi_z = _mm256_load_ps(soa.m_hi[2]);
+    return false;
+  }
+  if (a_header.precision != sizeof(T) || a_header.branchingRatio != K || a_header.nodeSize != sizeof(Record) ||
+      a_header.soaSize != sizeof(ChildAABBSoA) || a_header.leafSize != sizeof(Detail::SerializedLeaf) ||
+      a_header.primitiveSize != sizeof(StorageType) ||
+      a_header.primitiveAlign != alignof(StorageType)) {
+    std::cerr << a_caller
+              << " -- Error! PackedBVH was written with a different precision, branching factor or primitive type\n";
+
+    return false;
+  }
 
-        const __m256 dx = _mm256_max_ps(zero, _mm256_max_ps(_mm256_sub_ps(lo_x, px), _mm256_sub_ps(px, hi_x)));
-        const __m256 dy = _mm256_max_ps(zero, _mm256_max_ps(_mm256_sub_ps(lo_y, py), _mm256_sub_ps(py, hi_y)));
-        const __m256 dz = _mm256_max_ps(zero, _mm256_max_ps(_mm256_sub_ps(lo_z, pz), _mm256_sub_ps(pz, hi_z)));
-        const __m256 d2 =
-          _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_add_ps(_mm256_mul_ps(dy, dy), _mm256_mul_ps(dz, dz)));
+  const uint64_t numNodes    = a_header.numNodes;
+  const uint64_t numInterior = a_header.numInteriorNodes;
+  const uint64_t numLeaves   = a_header.numLeaves;
+  const uint64_t numPrims    = a_header.numPrimitives;
 
-        alignas(32) float dist2[K];
-        _mm256_store_ps(dist2, d2);
+  bool rootValid = true;
+  for (size_t dir = 0; dir < 3; dir++) {
+    rootValid = rootValid && a_header.rootLo[dir] <= a_header.rootHi[dir];
+  }
 
-        const auto& offsets = node.getChildOffsets();
+  // The counts are bounded before they are added or multiplied, and the offsets by the total size, so none of the
+  // sums below can wrap around.
+  if (numNodes > std::numeric_limits<uint32_t>::max() || numPrims > std::numeric_limits<uint32_t>::max() ||
+      numInterior > numNodes || numLeaves > numNodes || numInterior + numLeaves != numNodes ||
+      (numNodes > 0 && numLeaves == 0) || !rootValid || a_header.size > std::numeric_limits<uint64_t>::max() / 2 ||
+      a_header.nodesOffset > a_header.size || a_header.soaOffset > a_header.size ||
+      a_header.leavesOffset > a_header.size || a_header.primitivesOffset > a_header.size ||
+      a_header.nodesOffset < sizeof(a_header) ||
+      a_header.soaOffset < a_header.nodesOffset + numNodes * sizeof(Record) ||
+      a_header.leavesOffset < a_header.soaOffset + numInterior * sizeof(ChildAABBSoA) ||
+      a_header.primitivesOffset < a_header.leavesOffset + numLeaves * sizeof(Detail::SerializedLeaf) ||
+      a_header.size != a_header.primitivesOffset + numPrims * sizeof(StorageType)) {
+    std::cerr << a_caller << " -- Error! Corrupt header\n";
+
+    return false;
+  }
 
-        std::array<std::pair<float, uint32_t>, K> children;
+  return true;
+}
 
-        for (size_t k = 0; k < K; k++) {
-          children[k] = {dist2[k], offsets[k]};
-        }
+template <class T, class P, size_t K, class StoragePolicy>
+inline bool
+PackedBVH<T, P, K, StoragePolicy>::checkNodes(const Detail::SerializedNode<K>* a_records,
+                                              const ChildAABBSoA*              a_childAabbSoA,
+                                              const Detail::SerializedLeaf*    a_leaves,
+                                              size_t                           a_numNodes,
+                                              size_t                           a_numInteriorNodes,
+                                              size_t                           a_numLeaves,
+                                              size_t                           a_numPrimitives,
+                                              const char*                      a_caller)
+{
+  // Children come after their parent in pre-order, interior nodes reference existing SoA records holding valid boxes
+  // in their used slots, leaves reference existing leaf records, and those existing primitives.
+  for (size_t i = 0; i < a_numNodes; i++) {
+    const Detail::SerializedNode<K>& record = a_records[i];
 
-        std::sort(children.begin(),
-                  children.end(),
-                  [](const std::pair<float, uint32_t>& a, const std::pair<float, uint32_t>& b) noexcept {
-                    return a.first > b.first;
-                  });
+    bool valid = true;
+    if ((record.ref & s_leafFlag) != 0U) {
+      const size_t leafIndex = record.ref & ~s_leafFlag;
 
-        const float newBest2 = static_cast<float>(a_pruneDist2(a_state));
+      valid = leafIndex < a_numLeaves && a_leaves[leafIndex].numPrims > 0 &&
+              uint64_t(a_leaves[leafIndex].primOff) + a_leaves[leafIndex].numPrims <= a_numPrimitives;
 
-        for (const auto& [d, idx] : children) {
-          if (d <= newBest2) {
-            stack[top++] = {idx, d};
+      for (size_t k = 0; k < K; k++) {
+        valid = valid && record.childOff[k] == EmptyChild;
+      }
+    }
+    else {
+      valid = record.ref < a_numInteriorNodes && record.childOff[0] != EmptyChild;
+
+      // Used child slots first, then only unused ones.
+      for (size_t k = 0; k < K; k++) {
+        if (record.childOff[k] == EmptyChild) {
+          valid = valid && (k + 1 == K || record.childOff[k + 1] == EmptyChild);
+        }
+        else {
+          valid = valid && record.childOff[k] > i && record.childOff[k] < a_numNodes;
+
+          for (size_t dir = 0; dir < 3 && valid; dir++) {
+            valid = a_childAabbSoA[record.ref].m_lo[dir][k] <= a_childAabbSoA[record.ref].m_hi[dir][k];
           }
         }
       }
     }
 
-    return;
+    if (!valid) {
+      std::cerr << a_caller << " -- Error! Corrupt node " << i << "\n";
+
+      return false;
+    }
   }
 
-  if constexpr (K == 8 && std::is_same_v<T, double>) {
-    static_assert(alignof(ChildAABBSoA) == sizeof(T) * K,
-                  "ChildAABBSoA alignment mismatch: _mm256_load_pd requires 32-byte alignment");
+  return true;
+}
 
-    const __m256d px   = _mm256_set1_pd(a_point[0]);
-    const __m256d py   = _mm256_set1_pd(a_point[1]);
-    const __m256d pz   = _mm256_set1_pd(a_point[2]);
-    const __m256d zero = _mm256_setzero_pd();
+template <class T, class P, size_t K, class StoragePolicy>
+inline std::shared_ptr<PackedBVH<T, P, K, StoragePolicy>>
+PackedBVH<T, P, K, StoragePolicy>::load(std::istream& a_stream)
+{
+  static_assert(std::is_trivially_copyable_v<StorageType>,
+                "PackedBVH::load requires BVH::ValueStorage over a trivially copyable primitive");
 
-    alignas(32) StackEntry stack[256];
+  using Record = Detail::SerializedNode<K>;
 
-    int top      = 0;
-    stack[top++] = {0U, 0.0};
+  Detail::SerializationHeader header{};
 
-    while (top > 0) {
-      const StackEntry entry    = stack[--top];
-      const double     curBest2 = static_cast<double>(a_pruneDist2(a_state));
+  const std::streampos start = a_stream.tellg();
 
-      if (entry.dist2 > curBest2) {
-        continue;
-      }
+  if (start == std::streampos(-1)) {
+    std::cerr << "PackedBVH::load -- Error! Stream is not seekable\n";
 
-      const Node& node = m_linearNodes[entry.idx];
+    return nullptr;
+  }
 
-      if (node.isLeaf()) {
-        a_evalLeaf(a_state, node.getPrimitivesOffset(), node.getNumPrimitives());
-      }
-      else {
-        const auto& soa = m_childAabbSoA[entry.idx];
+  a_stream.read(reinterpret_cast<char*>(&header), sizeof(header));
 
-        const __m256d lo_x0 = _mm256_load_pd(soa.m_lo[0]);
-        const __m256d lo_y0 = _mm256_load_pd(soa.m_lo[1]);
-        const __m256d lo_z0 = _mm256_load_pd(soa.m_lo[2]);
-        const __m256d hi_x0 = _mm256_load_pd(soa.m_hi[0]);
-        const __m256d hi_y0 = _mm256_load_pd(soa.m_hi[1]);
-        const __m256d hi_z0 = _mm256_load_pd(soa.m_hi[2]);
+  if (!a_stream) {
+    std::cerr << "PackedBVH::load -- Error! Stream does not hold a PackedBVH\n";
 
-        const __m256d dx0 = _mm256_max_pd(zero, _mm256_max_pd(_mm256_sub_pd(lo_x0, px), _mm256_sub_pd(px, hi_x0)));
-        const __m256d dy0 = _mm256_max_pd(zero, _mm256_max_pd(_mm256_sub_pd(lo_y0, py), _mm256_sub_pd(py, hi_y0)));
-        const __m256d dz0 = _mm256_max_pd(zero, _mm256_max_pd(_mm256_sub_pd(lo_z0, pz), _mm256_sub_pd(pz, hi_z0)));
-        const __m256d d2_0 =
-          _mm256_add_pd(_mm256_mul_pd(dx0, dx0), _mm256_add_pd(_mm256_mul_pd(dy0, dy0), _mm256_mul_pd(dz0, dz0)));
+    return nullptr;
+  }
+  if (!checkHeader(header, "PackedBVH::load")) {
+    return nullptr;
+  }
 
-        const __m256d lo_x1 = _mm256_load_pd(soa.m_lo[0] + 4);
-        const __m256d lo_y1 = _mm256_load_pd(soa.m_lo[1] + 4);
-        const __m256d lo_z1 = _mm256_load_pd(soa.m_lo[2] + 4);
-        const __m256d hi_x1 = _mm256_load_pd(soa.m_hi[0] + 4);
-        const __m256d hi_y1 = _mm256_load_pd(soa.m_hi[1] + 4);
-        const __m256d hi_z1 = _mm256_load_pd(soa.m_hi[2] + 4);
+  // Nothing is allocated before the stream is known to hold every byte the header promises, so a corrupt header
+  // cannot make us allocate arbitrary amounts of memory.
+  a_stream.seekg(0, std::ios::end);
 
-        const __m256d dx1 = _mm256_max_pd(zero, _mm256_max_pd(_mm256_sub_pd(lo_x1, px), _mm256_sub_pd(px, hi_x1)));
-        const __m256d dy1 = _mm256_max_pd(zero, _mm256_max_pd(_mm256_sub_pd(lo_y1, py), _mm256_sub_pd(py, hi_y1)));
-        const __m256d dz1 = _mm256_max_pd(zero, _mm256_max_pd(_mm256_sub_pd(lo_z1, pz), _mm256_sub_pd(pz, hi_z1)));
-        const __m256d d2_1 =
-          _mm256_add_pd(_mm256_mul_pd(dx1, dx1), _mm256_add_pd(_mm256_mul_pd(dy1, dy1), _mm256_mul_pd(dz1, dz1)));
+  const std::streampos end = a_stream.tellg();
 
-        alignas(32) double dist2[K];
-        _mm256_store_pd(dist2, d2_0);
-        _mm256_store_pd(dist2 + 4, d2_1);
+  a_stream.seekg(start + std::streamoff(sizeof(header)));
 
-        const auto& offsets = node.getChildOffsets();
+  if (!a_stream || end == std::streampos(-1) || uint64_t(end - start) < header.size) {
+    std::cerr << "PackedBVH::load -- Error! Stream ended before the PackedBVH did\n";
 
-        std::array<std::pair<double, uint32_t>, K> children;
+    return nullptr;
+  }
 
-        for (size_t k = 0; k < K; k++) {
-          children[k] = {dist2[k], offsets[k]};
-        }
+  const uint64_t numNodes    = header.numNodes;
+  const uint64_t numInterior = header.numInteriorNodes;
+  const uint64_t numLeaves   = header.numLeaves;
+  const uint64_t numPrims    = header.numPrimitives;
 
-        std::sort(children.begin(),
-                  children.end(),
-                  [](const std::pair<double, uint32_t>& a, const std::pair<double, uint32_t>& b) noexcept {
-                    return a.first > b.first;
-                  });
+  std::vector<Record>                 records(numNodes);
+  std::vector<ChildAABBSoA>           childAabbSoA(numInterior);
+  std::vector<Detail::SerializedLeaf> leafRecords(numLeaves);
+  std::vector<StorageType>            primitives(numPrims);
 
-        const double newBest2 = static_cast<double>(a_pruneDist2(a_state));
+  // Read a block at its offset, skipping the padding in front of it.
+  uint64_t   position  = sizeof(header);
+  const auto readBlock = [&](uint64_t a_offset, void* a_data, uint64_t a_numBytes) {
+    a_stream.ignore(static_cast<std::streamsize>(a_offset - position));
+    a_stream.read(static_cast<char*>(a_data), static_cast<std::streamsize>(a_numBytes));
 
-        for (const auto& [d, idx] : children) {
-          if (d <= newBest2) {
-            stack[top++] = {idx, d};
-          }
-        }
-      }
-    }
+    position = a_offset + a_numBytes;
+  };
 
-    return;
+  readBlock(header.nodesOffset, records.data(), numNodes * sizeof(Record));
+  readBlock(header.soaOffset, childAabbSoA.data(), numInterior * sizeof(ChildAABBSoA));
+  readBlock(header.leavesOffset, leafRecords.data(), numLeaves * sizeof(Detail::SerializedLeaf));
+  readBlock(header.primitivesOffset, primitives.data(), numPrims * sizeof(StorageType));
+
+  if (!a_stream) {
+    std::cerr << "PackedBVH::load -- Error! Stream ended before the PackedBVH did\n";
+
+    return nullptr;
   }
-#endif
-#if defined(__SSE4_1__)
-  if constexpr (K == 4 && std::is_same_v<T, float>) {
-    static_assert(alignof(ChildAABBSoA) == sizeof(T) * K,
-                  "ChildAABBSoA alignment mismatch: _mm_load_ps requires 16-byte alignment");
 
-    const __m128 px   = _mm_set1_ps(a_point[0]);
-    const __m128 py   = _mm_set1_ps(a_point[1]);
-    const __m128 pz   = _mm_set1_ps(a_point[2]);
-    const __m128 zero = _mm_setzero_ps();
+  if (!checkNodes(records.data(),
+                  childAabbSoA.data(),
+                  leafRecords.data(),
+                  numNodes,
+                  numInterior,
+                  numLeaves,
+                  numPrims,
+                  "PackedBVH::load")) {
+    return nullptr;
+  }
 
-    alignas(16) StackEntry stack[256];
-    int                    top = 0;
-    stack[top++]               = {0U, 0.0f};
+  std::vector<Node> linearNodes(numNodes);
+  for (size_t i = 0; i < numNodes; i++) {
+    linearNodes[i].m_ref = records[i].ref;
 
-    while (top > 0) {
-      const StackEntry entry    = stack[--top];
-      const float      curBest2 = static_cast<float>(a_pruneDist2(a_state));
+    std::copy(std::begin(records[i].childOff), std::end(records[i].childOff), linearNodes[i].m_childOff.begin());
+  }
 
-      if (entry.dist2 > curBest2) {
-        continue;
-      }
+  std::vector<Leaf> leaves(numLeaves);
+  for (size_t i = 0; i < numLeaves; i++) {
+    leaves[i] = {leafRecords[i].primOff, leafRecords[i].numPrims};
+  }
 
-      const Node& node = m_linearNodes[entry.idx];
+  const BV bv(Vec3T<T>(T(header.rootLo[0]), T(header.rootLo[1]), T(header.rootLo[2])),
+              Vec3T<T>(T(header.rootHi[0]), T(header.rootHi[1]), T(header.rootHi[2])));
 
-      if (node.isLeaf()) {
-        a_evalLeaf(a_state, node.getPrimitivesOffset(), node.getNumPrimitives());
-      }
-      else {
-        const auto& soa = m_childAabbSoA[entry.idx];
+  return std::shared_ptr<PackedBVH>(new PackedBVH(
+    std::move(linearNodes), std::move(primitives), std::move(childAabbSoA), std::move(leaves), bv));
+}
 
-        const __m128 lo_x = _mm_load_ps(soa.m_lo[0]);
-        const __m128 lo_y = _mm_load_ps(soa.m_lo[1]);
-        const __m128 lo_z = _mm_load_ps(soa.m_lo[2]);
-        const __m128 hi_x = _mm_load_ps(soa.m_hi[0]);
-        const __m128 hi_y = _mm_load_ps(soa.m_hi[1]);
-        const __m128 hi_z = _mm_load_ps(soa.m_hi[2]);
+template <class T, class P, size_t K, class StoragePolicy>
+inline std::shared_ptr<PackedBVH<T, P, K, StoragePolicy>>
+PackedBVH<T, P, K, StoragePolicy>::load(const std::string& a_filename)
+{
+  std::ifstream file(a_filename, std::ios::binary);
 
-        const __m128 dx = _mm_max_ps(zero, _mm_max_ps(_mm_sub_ps(lo_x, px), _mm_sub_ps(px, hi_x)));
-        const __m128 dy = _mm_max_ps(zero, _mm_max_ps(_mm_sub_ps(lo_y, py), _mm_sub_ps(py, hi_y)));
-        const __m128 dz = _mm_max_ps(zero, _mm_max_ps(_mm_sub_ps(lo_z, pz), _mm_sub_ps(pz, hi_z)));
-        const __m128 d2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_add_ps(_mm_mul_ps(dy, dy), _mm_mul_ps(dz, dz)));
+  if (!file) {
+    std::cerr << "PackedBVH::load -- Error! Could not open file " + a_filename + "\n";
 
-        alignas(16) float dist2[K];
-        _mm_store_ps(dist2, d2);
+    return nullptr;
+  }
 
-        const auto& offsets = node.getChildOffsets();
+  return load(file);
+}
 
-        std::array<std::pair<float, uint32_t>, K> children;
+template <class T, class P, size_t K, class StoragePolicy>
+inline std::shared_ptr<PackedBVH<T, P, K, StoragePolicy>>
+PackedBVH<T, P, K, StoragePolicy>::map(const std::string& a_filename)
+{
+#if defined(__unix__) || defined(__APPLE__)
+  const int fd = ::open(a_filename.c_str(), O_RDONLY);
 
-        for (size_t k = 0; k < K; k++) {
-          children[k] = {dist2[k], offsets[k]};
-        }
+  if (fd < 0) {
+    std::cerr << "PackedBVH::map -- Error! Could not open file " + a_filename + "\n";
 
-        std::sort(children.begin(),
-                  children.end(),
-                  [](const std::pair<float, uint32_t>& a, const std::pair<float, uint32_t>& b) noexcept {
-                    return a.first > b.first;
-                  });
+    return nullptr;
+  }
 
-        const float newBest2 = static_cast<float>(a_pruneDist2(a_state));
+  struct stat status
+  {};
 
-        for (const auto& [d, idx] : children) {
-          if (d <= newBest2) {
-            stack[top++] = {idx, d};
-          }
-        }
-      }
-    }
+  const bool   haveSize = ::fstat(fd, &status) == 0 && status.st_size > 0;
+  const size_t size     = haveSize ? size_t(status.st_size) : 0;
+  void* const  data     = haveSize ? ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
 
-    return;
-  }
-#endif
+  // The mapping outlives the descriptor.
+  ::close(fd);
 
-  // Scalar fallback for all other (T, K) combinations.
-  const BVH::PackedLeafEvaluator<P, StoragePolicy> leafEvaluator =
-    [&a_state, &a_evalLeaf](const std::vector<StorageType>&, size_t offset, size_t count) noexcept -> void {
-    a_evalLeaf(a_state, offset, count);
-  };
+  if (data == MAP_FAILED) {
+    std::cerr << "PackedBVH::map -- Error! Could not map file " + a_filename + "\n";
 
-  // The node key is the *squared* box distance (getDistanceToBoundingVolume2), matching the squared
-  // pruning bound a_pruneDist2 returns -- so the predicate compares directly, with no sqrt anywhere.
-  // (Squaring is monotonic, so ordering children by squared distance is identical to ordering by
-  // distance.) The SIMD paths above already work entirely in squared distance; this keeps the
-  // scalar fallback consistent instead of taking a square root only to square it back.
-  const BVH::PrunePredicate<Node, T> prunePredicate =
-    [&a_state, &a_pruneDist2](const Node& /*n*/, const T& d2) noexcept -> bool { return d2 <= a_pruneDist2(a_state); };
+    return nullptr;
+  }
 
-  const BVH::PackedChildOrderer<T, K> childOrderer = [](std::array<std::pair<uint32_t, T>, K>& ch) noexcept -> void {
-    std::sort(ch.begin(), ch.end(), [](const std::pair<uint32_t, T>& a, const std::pair<uint32_t, T>& b) noexcept {
-      return a.second > b.second;
-    });
-  };
+  const std::shared_ptr<const void> mapping(data,
+                                            [size](const void* a_data) noexcept {
+                                              ::munmap(const_cast<void*>(a_data), size);
+                                            });
 
-  const BVH::NodeKeyFactory<Node, T> nodeKeyFactory = [&a_point](const Node& n) noexcept -> T {
-    return n.getDistanceToBoundingVolume2(a_point);
-  };
+  return view(data, size, mapping);
+#else
+  std::cerr << "PackedBVH::map -- Warning! Memory mapping is not supported on this platform, loading " + a_filename +
+                 " instead\n";
 
-  this->traverse(leafEvaluator, prunePredicate, childOrderer, nodeKeyFactory);
+  return load(a_filename);
+#endif
 }
 
 template <class T, class P, size_t K, class StoragePolicy>
-template <class BVConstructor>
-inline void
-PackedBVH<T, P, K, StoragePolicy>::refit(const BVConstructor& a_bvConstructor)
+inline std::shared_ptr<PackedBVH<T, P, K, StoragePolicy>>
+PackedBVH<T, P, K, StoragePolicy>::view(const void* a_data, size_t a_size, std::shared_ptr<const void> a_owner)
 {
-  // m_linearNodes is a depth-first pre-order flattening, so every child has a higher index than its
-  // parent. Sweeping the array in reverse therefore refits all of a node's children before the node
-  // itself -- no recursion or explicit stack needed.
-  //
-  // The scratch vector feeding AABBT's union constructor is declared once here and clear()ed per
-  // node rather than reallocated inside the loop: its capacity stabilizes after the first few nodes,
-  // so a refit() (meant as cheap per-frame maintenance) makes effectively no steady-state heap
-  // allocations.
-  std::vector<BV> boundingVolumes;
+  static_assert(std::is_trivially_copyable_v<StorageType>,
+                "PackedBVH::view requires BVH::ValueStorage over a trivially copyable primitive");
 
-  for (size_t i = m_linearNodes.size(); i-- > 0;) {
-    Node& node = m_linearNodes[i];
+  using Record = Detail::SerializedNode<K>;
 
-    boundingVolumes.clear();
+  // The node and leaf records are traversed in place as Nodes and Leafs, so they must agree byte for byte.
+  static_assert(std::is_standard_layout_v<Node> && sizeof(Node) == sizeof(Record) && alignof(Node) == alignof(Record),
+                "PackedBVH::view requires Node to have the layout of Detail::SerializedNode");
+  static_assert(offsetof(Node, m_ref) == offsetof(Record, ref) &&
+                  offsetof(Node, m_childOff) == offsetof(Record, childOff),
+                "PackedBVH::view requires Node to have the layout of Detail::SerializedNode");
+  static_assert(std::is_standard_layout_v<Leaf> && sizeof(Leaf) == sizeof(Detail::SerializedLeaf) &&
+                  alignof(Leaf) == alignof(Detail::SerializedLeaf) &&
+                  offsetof(Leaf, m_primOff) == offsetof(Detail::SerializedLeaf, primOff) &&
+                  offsetof(Leaf, m_numPrims) == offsetof(Detail::SerializedLeaf, numPrims),
+                "PackedBVH::view requires Leaf to have the layout of Detail::SerializedLeaf");
 
-    if (node.isLeaf()) {
-      const uint32_t offset = node.getPrimitivesOffset();
-      const uint32_t count  = node.getNumPrimitives();
+  const char* const base = static_cast<const char*>(a_data);
 
-      boundingVolumes.reserve(count);
+  Detail::SerializationHeader header{};
 
-      for (uint32_t p = 0; p < count; p++) {
-        boundingVolumes.emplace_back(a_bvConstructor(StoragePolicy::get(m_primitives[offset + p])));
-      }
-    }
-    else {
-      const auto& childOffsets = node.getChildOffsets();
+  if (base == nullptr || a_size < sizeof(header)) {
+    std::cerr << "PackedBVH::view -- Error! Buffer does not hold a PackedBVH\n";
 
-      boundingVolumes.reserve(K);
+    return nullptr;
+  }
 
-      for (size_t k = 0; k < K; k++) {
-        boundingVolumes.emplace_back(m_linearNodes[childOffsets[k]].getBoundingVolume());
-      }
-    }
+  std::memcpy(&header, base, sizeof(header));
+
+  if (!checkHeader(header, "PackedBVH::view")) {
+    return nullptr;
+  }
+  if (header.size > a_size) {
+    std::cerr << "PackedBVH::view -- Error! Buffer ended before the PackedBVH did\n";
+
+    return nullptr;
+  }
+
+  const auto isAligned = [base](uint64_t a_offset, size_t a_alignment) noexcept -> bool {
+    return reinterpret_cast<std::uintptr_t>(base + a_offset) % a_alignment == 0;
+  };
+
+  if (!isAligned(header.nodesOffset, alignof(Node)) || !isAligned(header.soaOffset, alignof(ChildAABBSoA)) ||
+      !isAligned(header.leavesOffset, alignof(Leaf)) || !isAligned(header.primitivesOffset, alignof(StorageType))) {
+    std::cerr << "PackedBVH::view -- Error! Buffer is not aligned to Detail::SerializationAlignment bytes\n";
 
-    node.setBoundingVolume(BV(boundingVolumes));
+    return nullptr;
   }
 
-  this->buildSoA();
+  using LeafRecord = Detail::SerializedLeaf;
+
+  const Record* const     records = reinterpret_cast<const Record*>(base + header.nodesOffset);
+  const LeafRecord* const leaves  = reinterpret_cast<const LeafRecord*>(base + header.leavesOffset);
+
+  if (!checkNodes(records,
+                  reinterpret_cast<const ChildAABBSoA*>(base + header.soaOffset),
+                  leaves,
+                  header.numNodes,
+                  header.numInteriorNodes,
+                  header.numLeaves,
+                  header.numPrimitives,
+                  "PackedBVH::view")) {
+    return nullptr;
+  }
+
+  const BV bv(Vec3T<T>(T(header.rootLo[0]), T(header.rootLo[1]), T(header.rootLo[2])),
+              Vec3T<T>(T(header.rootHi[0]), T(header.rootHi[1]), T(header.rootHi[2])));
+
+  std::shared_ptr<PackedBVH> bvh(new PackedBVH(
+    std::vector<Node>{}, std::vector<StorageType>{}, std::vector<ChildAABBSoA>{}, std::vector<Leaf>{}, bv));
+
+  // Without an owner the tree still needs a non-null m_mapping; the aliasing constructor gives one that owns nothing.
+  bvh->m_mapping = a_owner ? std::move(a_owner) : std::shared_ptr<const void>(std::shared_ptr<const void>(), a_data);
+
+  bvh->m_mapped.nodes            = reinterpret_cast<const Node*>(records);
+  bvh->m_mapped.childAabbSoA     = reinterpret_cast<const ChildAABBSoA*>(base + header.soaOffset);
+  bvh->m_mapped.leaves           = reinterpret_cast<const Leaf*>(leaves);
+  bvh->m_mapped.primitives       = reinterpret_cast<const StorageType*>(base + header.primitivesOffset);
+  bvh->m_mapped.numNodes         = header.numNodes;
+  bvh->m_mapped.numInteriorNodes = header.numInteriorNodes;
+  bvh->m_mapped.numLeaves        = header.numLeaves;
+  bvh->m_mapped.numPrimitives    = header.numPrimitives;
+
+  return bvh;
 }
 
 } // namespace BVH
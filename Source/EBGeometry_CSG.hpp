@@ -321,6 +321,16 @@ public:
   [[nodiscard]] T
   value(const Vec3T<T>& a_point) const noexcept override;
 
+  /**
+   * @brief Batched value function.
+   * @details Evaluates each stored function over the whole array in turn and min-reduces into a_values.
+   * @param[in]  a_points    Query points (a_numPoints entries).
+   * @param[out] a_values    Function values at a_points (a_numPoints entries).
+   * @param[in]  a_numPoints Number of query points.
+   */
+  void
+  values(const Vec3T<T>* a_points, T* a_values, std::size_t a_numPoints) const noexcept override;
+
 protected:
   /**
    * @brief Stored implicit functions.
@@ -371,6 +381,17 @@ public:
   [[nodiscard]] T
   value(const Vec3T<T>& a_point) const noexcept override;
 
+  /**
+   * @brief Batched value function.
+   * @details Evaluates each stored function over the whole array in turn, tracking the two smallest values per
+   * point, then applies the smooth minimum.
+   * @param[in]  a_points    Query points (a_numPoints entries).
+   * @param[out] a_values    Function values at a_points (a_numPoints entries).
+   * @param[in]  a_numPoints Number of query points.
+   */
+  void
+  values(const Vec3T<T>* a_points, T* a_values, std::size_t a_numPoints) const noexcept override;
+
 protected:
   /**
    * @brief Stored implicit functions.
@@ -444,6 +465,16 @@ public:
   [[nodiscard]] T
   value(const Vec3T<T>& a_point) const noexcept override;
 
+  /**
+   * @brief Batched value function.
+   * @details Runs the BVH-pruned evaluation for each point without re-dispatching through the virtual value().
+   * @param[in]  a_points    Query points (a_numPoints entries).
+   * @param[out] a_values    Function values at a_points (a_numPoints entries).
+   * @param[in]  a_numPoints Number of query points.
+   */
+  void
+  values(const Vec3T<T>* a_points, T* a_values, std::size_t a_numPoints) const noexcept override;
+
   /**
    * @brief Returns the axis-aligned bounding box enclosing all primitives.
    * @return Const reference to the root bounding volume of the BVH.
@@ -451,6 +482,25 @@ public:
   [[nodiscard]] const EBGeometry::BoundingVolumes::AABBT<T>&
   getBoundingVolume() const noexcept;
 
+  /**
+   * @brief Add a primitive to the union without rebuilding the BVH.
+   * @details Forwards to PackedBVH::insert().
+   * @param[in] a_primitive Primitive to add. Must not be nullptr.
+   * @param[in] a_bv        Bounding volume of the primitive.
+   */
+  void
+  insert(const std::shared_ptr<const P>& a_primitive, const BV& a_bv);
+
+  /**
+   * @brief Remove a primitive from the union without rebuilding the BVH.
+   * @details Forwards to PackedBVH::remove(), which identifies the primitive by address.
+   * @param[in] a_primitive Primitive to remove.
+   * @param[in] a_bv        Bounding volume the primitive was added with.
+   * @return True if the primitive was removed, false if it is not in the union or is its only primitive.
+   */
+  bool
+  remove(const std::shared_ptr<const P>& a_primitive, const BV& a_bv);
+
 protected:
   /**
    * @brief Flat BVH over all input primitives.
@@ -523,6 +573,16 @@ public:
   [[nodiscard]] T
   value(const Vec3T<T>& a_point) const noexcept override;
 
+  /**
+   * @brief Batched value function.
+   * @details Runs the BVH-pruned evaluation for each point without re-dispatching through the virtual value().
+   * @param[in]  a_points    Query points (a_numPoints entries).
+   * @param[out] a_values    Function values at a_points (a_numPoints entries).
+   * @param[in]  a_numPoints Number of query points.
+   */
+  void
+  values(const Vec3T<T>* a_points, T* a_values, std::size_t a_numPoints) const noexcept override;
+
   /**
    * @brief Returns the axis-aligned bounding box enclosing all primitives.
    * @return Const reference to the root bounding volume of the BVH.
@@ -530,6 +590,25 @@ public:
   [[nodiscard]] const EBGeometry::BoundingVolumes::AABBT<T>&
   getBoundingVolume() const noexcept;
 
+  /**
+   * @brief Add a primitive to the union without rebuilding the BVH.
+   * @details Forwards to PackedBVH::insert().
+   * @param[in] a_primitive Primitive to add. Must not be nullptr.
+   * @param[in] a_bv        Bounding volume of the primitive.
+   */
+  void
+  insert(const std::shared_ptr<const P>& a_primitive, const BV& a_bv);
+
+  /**
+   * @brief Remove a primitive from the union without rebuilding the BVH.
+   * @details Forwards to PackedBVH::remove(), which identifies the primitive by address.
+   * @param[in] a_primitive Primitive to remove.
+   * @param[in] a_bv        Bounding volume the primitive was added with.
+   * @return True if the primitive was removed, false if it is not in the union or is its only primitive.
+   */
+  bool
+  remove(const std::shared_ptr<const P>& a_primitive, const BV& a_bv);
+
 protected:
   /**
    * @brief Flat BVH over all input primitives.
@@ -594,6 +673,16 @@ public:
   [[nodiscard]] T
   value(const Vec3T<T>& a_point) const noexcept override;
 
+  /**
+   * @brief Batched value function.
+   * @details Evaluates each stored function over the whole array in turn and max-reduces into a_values.
+   * @param[in]  a_points    Query points (a_numPoints entries).
+   * @param[out] a_values    Function values at a_points (a_numPoints entries).
+   * @param[in]  a_numPoints Number of query points.
+   */
+  void
+  values(const Vec3T<T>* a_points, T* a_values, std::size_t a_numPoints) const noexcept override;
+
 protected:
   /**
    * @brief Stored implicit functions.
@@ -656,6 +745,17 @@ public:
   [[nodiscard]] T
   value(const Vec3T<T>& a_point) const noexcept override;
 
+  /**
+   * @brief Batched value function.
+   * @details Evaluates each stored function over the whole array in turn, tracking the two largest values per
+   * point, then applies the smooth maximum.
+   * @param[in]  a_points    Query points (a_numPoints entries).
+   * @param[out] a_values    Function values at a_points (a_numPoints entries).
+   * @param[in]  a_numPoints Number of query points.
+   */
+  void
+  values(const Vec3T<T>* a_points, T* a_values, std::size_t a_numPoints) const noexcept override;
+
 protected:
   /**
    * @brief Stored implicit functions.
@@ -720,6 +820,16 @@ public:
   [[nodiscard]] T
   value(const Vec3T<T>& a_point) const noexcept override;
 
+  /**
+   * @brief Batched value function.
+   * @details Evaluates A and B over the whole array and combines them as max(a, -b).
+   * @param[in]  a_points    Query points (a_numPoints entries).
+   * @param[out] a_values    Function values at a_points (a_numPoints entries).
+   * @param[in]  a_numPoints Number of query points.
+   */
+  void
+  values(const Vec3T<T>* a_points, T* a_values, std::size_t a_numPoints) const noexcept override;
+
 protected:
   /**
    * @brief Minuend implicit function.
@@ -788,6 +898,16 @@ public:
   [[nodiscard]] T
   value(const Vec3T<T>& a_point) const noexcept override;
 
+  /**
+   * @brief Batched value function.
+   * @details Forwards the whole array to the underlying smooth intersection.
+   * @param[in]  a_points    Query points (a_numPoints entries).
+   * @param[out] a_values    Function values at a_points (a_numPoints entries).
+   * @param[in]  a_numPoints Number of query points.
+   */
+  void
+  values(const Vec3T<T>* a_points, T* a_values, std::size_t a_numPoints) const noexcept override;
+
 protected:
   /**
    * @brief Internal smooth intersection implementing smooth(A ∩ complement(B)).
@@ -837,6 +957,16 @@ public:
   [[nodiscard]] T
   value(const Vec3T<T>& a_point) const noexcept override;
 
+  /**
+   * @brief Batched value function.
+   * @details Folds the whole array into the base period and evaluates the repeated function on the folded points.
+   * @param[in]  a_points    Query points (a_numPoints entries).
+   * @param[out] a_values    Function values at a_points (a_numPoints entries).
+   * @param[in]  a_numPoints Number of query points.
+   */
+  void
+  values(const Vec3T<T>* a_points, T* a_values, std::size_t a_numPoints) const noexcept override;
+
 protected:
   /**
    * @brief Tile period in each coordinate direction.
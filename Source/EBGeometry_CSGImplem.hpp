@@ -14,6 +14,7 @@
 // Std includes
 #include <algorithm>
 #include <array>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
@@ -74,7 +75,9 @@ buildBVH(const std::vector<std::pair<std::shared_ptr<const P>, BV>>& a_primsAndB
 
     break;
   }
-  case BVH::Build::SAH: {
+  case BVH::Build::SAH:
+  case BVH::Build::SBVH: {
+    // Implicit functions cannot be clipped to a box, so SBVH builds fall back to plain SAH.
     using Node     = EBGeometry::BVH::TreeBVH<T, P, BV, K>;
     using LeafPred = typename Node::LeafPredicate;
 
@@ -84,6 +87,11 @@ buildBVH(const std::vector<std::pair<std::shared_ptr<const P>, BV>>& a_primsAndB
 
     break;
   }
+  case BVH::Build::PLOC: {
+    root->plocSortAndPartition();
+
+    break;
+  }
   default: {
     EBGEOMETRY_EXPECT(false);
 
@@ -367,6 +375,34 @@ UnionIF<T>::value(const Vec3T<T>& a_point) const noexcept
   return ret;
 }
 
+template <class T>
+void
+UnionIF<T>::values(const Vec3T<T>* a_points, T* a_values, std::size_t a_numPoints) const noexcept
+{
+  constexpr std::size_t chunkSize = ImplicitFunction<T>::s_batchChunkSize;
+
+  std::array<T, chunkSize> childValues;
+
+  // Chunked so the child-value scratch stays on the stack; each child sees the whole chunk at once.
+  for (std::size_t begin = 0; begin < a_numPoints; begin += chunkSize) {
+    const std::size_t count = std::min(chunkSize, a_numPoints - begin);
+
+    T* ret = a_values + begin;
+
+    std::fill(ret, ret + count, std::numeric_limits<T>::infinity());
+
+    for (const auto& prim : m_implicitFunctions) {
+      prim->values(a_points + begin, childValues.data(), count);
+
+      for (std::size_t i = 0; i < count; i++) {
+        EBGEOMETRY_EXPECT(!std::isnan(childValues[i]));
+
+        ret[i] = std::min(ret[i], childValues[i]);
+      }
+    }
+  }
+}
+
 template <class T>
 SmoothUnionIF<T>::SmoothUnionIF(const std::vector<std::shared_ptr<ImplicitFunction<T>>>&    a_implicitFunctions,
                                 const T                                                     a_smoothLen,
@@ -420,6 +456,52 @@ SmoothUnionIF<T>::value(const Vec3T<T>& a_point) const noexcept
   return ret;
 }
 
+template <class T>
+void
+SmoothUnionIF<T>::values(const Vec3T<T>* a_points, T* a_values, std::size_t a_numPoints) const noexcept
+{
+  if (m_implicitFunctions.size() == 1) {
+    m_implicitFunctions.front()->values(a_points, a_values, a_numPoints);
+
+    return;
+  }
+
+  constexpr std::size_t chunkSize = ImplicitFunction<T>::s_batchChunkSize;
+
+  std::array<T, chunkSize> childValues;
+  std::array<T, chunkSize> a;
+  std::array<T, chunkSize> b;
+
+  for (std::size_t begin = 0; begin < a_numPoints; begin += chunkSize) {
+    const std::size_t count = std::min(chunkSize, a_numPoints - begin);
+
+    std::fill(a.begin(), a.begin() + count, std::numeric_limits<T>::infinity());
+    std::fill(b.begin(), b.begin() + count, std::numeric_limits<T>::infinity());
+
+    for (const auto& implicitFunction : m_implicitFunctions) {
+      implicitFunction->values(a_points + begin, childValues.data(), count);
+
+      for (std::size_t i = 0; i < count; i++) {
+        const T curValue = childValues[i];
+
+        EBGEOMETRY_EXPECT(!std::isnan(curValue));
+
+        if (curValue < a[i]) {
+          b[i] = a[i];
+          a[i] = curValue;
+        }
+        else if (curValue < b[i]) {
+          b[i] = curValue;
+        }
+      }
+    }
+
+    for (std::size_t i = 0; i < count; i++) {
+      a_values[begin + i] = m_smoothMin(a[i], b[i], m_smoothLen);
+    }
+  }
+}
+
 template <class T, class P, class BV, size_t K>
 BVHUnionIF<T, P, BV, K>::BVHUnionIF(const std::vector<std::pair<std::shared_ptr<const P>, BV>>& a_primsAndBVs)
 {
@@ -499,6 +581,17 @@ BVHUnionIF<T, P, BV, K>::value(const Vec3T<T>& a_point) const noexcept
   return minDist;
 }
 
+template <class T, class P, class BV, size_t K>
+void
+BVHUnionIF<T, P, BV, K>::values(const Vec3T<T>* a_points, T* a_values, std::size_t a_numPoints) const noexcept
+{
+  // Qualified call: the traversal itself is already the per-point kernel, so the batch gain here is skipping the
+  // virtual dispatch and keeping the (shared) top of the tree hot across consecutive points.
+  for (std::size_t i = 0; i < a_numPoints; i++) {
+    a_values[i] = BVHUnionIF::value(a_points[i]);
+  }
+}
+
 template <class T, class P, class BV, size_t K>
 const EBGeometry::BoundingVolumes::AABBT<T>&
 BVHUnionIF<T, P, BV, K>::getBoundingVolume() const noexcept
@@ -508,6 +601,27 @@ BVHUnionIF<T, P, BV, K>::getBoundingVolume() const noexcept
   return m_bvh->getBoundingVolume();
 }
 
+template <class T, class P, class BV, size_t K>
+void
+BVHUnionIF<T, P, BV, K>::insert(const std::shared_ptr<const P>& a_primitive, const BV& a_bv)
+{
+  EBGEOMETRY_EXPECT(m_bvh != nullptr);
+  EBGEOMETRY_EXPECT(a_primitive != nullptr);
+
+  m_bvh->insert(a_primitive, a_bv);
+}
+
+template <class T, class P, class BV, size_t K>
+bool
+BVHUnionIF<T, P, BV, K>::remove(const std::shared_ptr<const P>& a_primitive, const BV& a_bv)
+{
+  EBGEOMETRY_EXPECT(m_bvh != nullptr);
+
+  return m_bvh->remove(a_bv, [&a_primitive](const P& a_candidate) noexcept -> bool {
+    return &a_candidate == a_primitive.get();
+  });
+}
+
 template <class T, class P, class BV, size_t K>
 BVHSmoothUnionIF<T, P, BV, K>::BVHSmoothUnionIF(
   const std::vector<std::shared_ptr<P>>&               a_distanceFunctions,
@@ -598,6 +712,15 @@ BVHSmoothUnionIF<T, P, BV, K>::value(const Vec3T<T>& a_point) const noexcept
   return m_smoothMin(closest.a, closest.b, m_smoothLen);
 }
 
+template <class T, class P, class BV, size_t K>
+void
+BVHSmoothUnionIF<T, P, BV, K>::values(const Vec3T<T>* a_points, T* a_values, std::size_t a_numPoints) const noexcept
+{
+  for (std::size_t i = 0; i < a_numPoints; i++) {
+    a_values[i] = BVHSmoothUnionIF::value(a_points[i]);
+  }
+}
+
 template <class T, class P, class BV, size_t K>
 const EBGeometry::BoundingVolumes::AABBT<T>&
 BVHSmoothUnionIF<T, P, BV, K>::getBoundingVolume() const noexcept
@@ -607,6 +730,27 @@ BVHSmoothUnionIF<T, P, BV, K>::getBoundingVolume() const noexcept
   return m_bvh->getBoundingVolume();
 }
 
+template <class T, class P, class BV, size_t K>
+void
+BVHSmoothUnionIF<T, P, BV, K>::insert(const std::shared_ptr<const P>& a_primitive, const BV& a_bv)
+{
+  EBGEOMETRY_EXPECT(m_bvh != nullptr);
+  EBGEOMETRY_EXPECT(a_primitive != nullptr);
+
+  m_bvh->insert(a_primitive, a_bv);
+}
+
+template <class T, class P, class BV, size_t K>
+bool
+BVHSmoothUnionIF<T, P, BV, K>::remove(const std::shared_ptr<const P>& a_primitive, const BV& a_bv)
+{
+  EBGEOMETRY_EXPECT(m_bvh != nullptr);
+
+  return m_bvh->remove(a_bv, [&a_primitive](const P& a_candidate) noexcept -> bool {
+    return &a_candidate == a_primitive.get();
+  });
+}
+
 template <class T>
 IntersectionIF<T>::IntersectionIF(const std::vector<std::shared_ptr<ImplicitFunction<T>>>& a_implicitFunctions) noexcept
 {
@@ -636,6 +780,33 @@ IntersectionIF<T>::value(const Vec3T<T>& a_point) const noexcept
   return ret;
 }
 
+template <class T>
+void
+IntersectionIF<T>::values(const Vec3T<T>* a_points, T* a_values, std::size_t a_numPoints) const noexcept
+{
+  constexpr std::size_t chunkSize = ImplicitFunction<T>::s_batchChunkSize;
+
+  std::array<T, chunkSize> childValues;
+
+  for (std::size_t begin = 0; begin < a_numPoints; begin += chunkSize) {
+    const std::size_t count = std::min(chunkSize, a_numPoints - begin);
+
+    T* ret = a_values + begin;
+
+    std::fill(ret, ret + count, -std::numeric_limits<T>::infinity());
+
+    for (const auto& prim : m_implicitFunctions) {
+      prim->values(a_points + begin, childValues.data(), count);
+
+      for (std::size_t i = 0; i < count; i++) {
+        EBGEOMETRY_EXPECT(!std::isnan(childValues[i]));
+
+        ret[i] = std::max(ret[i], childValues[i]);
+      }
+    }
+  }
+}
+
 template <class T>
 SmoothIntersectionIF<T>::SmoothIntersectionIF(
   const std::shared_ptr<ImplicitFunction<T>>&           a_implicitFunctionA,
@@ -708,6 +879,52 @@ SmoothIntersectionIF<T>::value(const Vec3T<T>& a_point) const noexcept
   return ret;
 }
 
+template <class T>
+void
+SmoothIntersectionIF<T>::values(const Vec3T<T>* a_points, T* a_values, std::size_t a_numPoints) const noexcept
+{
+  if (m_implicitFunctions.size() == 1) {
+    m_implicitFunctions.front()->values(a_points, a_values, a_numPoints);
+
+    return;
+  }
+
+  constexpr std::size_t chunkSize = ImplicitFunction<T>::s_batchChunkSize;
+
+  std::array<T, chunkSize> childValues;
+  std::array<T, chunkSize> a;
+  std::array<T, chunkSize> b;
+
+  for (std::size_t begin = 0; begin < a_numPoints; begin += chunkSize) {
+    const std::size_t count = std::min(chunkSize, a_numPoints - begin);
+
+    std::fill(a.begin(), a.begin() + count, -std::numeric_limits<T>::infinity());
+    std::fill(b.begin(), b.begin() + count, -std::numeric_limits<T>::infinity());
+
+    for (const auto& implicitFunction : m_implicitFunctions) {
+      implicitFunction->values(a_points + begin, childValues.data(), count);
+
+      for (std::size_t i = 0; i < count; i++) {
+        const T curValue = childValues[i];
+
+        EBGEOMETRY_EXPECT(!std::isnan(curValue));
+
+        if (curValue > a[i]) {
+          b[i] = a[i];
+          a[i] = curValue;
+        }
+        else if (curValue > b[i]) {
+          b[i] = curValue;
+        }
+      }
+    }
+
+    for (std::size_t i = 0; i < count; i++) {
+      a_values[begin + i] = m_smoothMax(a[i], b[i], m_smoothLen);
+    }
+  }
+}
+
 template <class T>
 DifferenceIF<T>::DifferenceIF(const std::shared_ptr<ImplicitFunction<T>>& a_implicitFunctionA,
                               const std::shared_ptr<ImplicitFunction<T>>& a_implicitFunctionB) noexcept
@@ -743,6 +960,31 @@ DifferenceIF<T>::value(const Vec3T<T>& a_point) const noexcept
   return std::max(a, -b);
 }
 
+template <class T>
+void
+DifferenceIF<T>::values(const Vec3T<T>* a_points, T* a_values, std::size_t a_numPoints) const noexcept
+{
+  constexpr std::size_t chunkSize = ImplicitFunction<T>::s_batchChunkSize;
+
+  std::array<T, chunkSize> b;
+
+  // A is evaluated straight into the output; only B needs scratch.
+  m_implicitFunctionA->values(a_points, a_values, a_numPoints);
+
+  for (std::size_t begin = 0; begin < a_numPoints; begin += chunkSize) {
+    const std::size_t count = std::min(chunkSize, a_numPoints - begin);
+
+    m_implicitFunctionB->values(a_points + begin, b.data(), count);
+
+    for (std::size_t i = 0; i < count; i++) {
+      EBGEOMETRY_EXPECT(!std::isnan(a_values[begin + i]));
+      EBGEOMETRY_EXPECT(!std::isnan(b[i]));
+
+      a_values[begin + i] = std::max(a_values[begin + i], -b[i]);
+    }
+  }
+}
+
 template <class T>
 SmoothDifferenceIF<T>::SmoothDifferenceIF(
   const std::shared_ptr<ImplicitFunction<T>>&                 a_implicitFunctionA,
@@ -792,6 +1034,15 @@ SmoothDifferenceIF<T>::value(const Vec3T<T>& a_point) const noexcept
   return m_smoothIntersectionIF->value(a_point);
 }
 
+template <class T>
+void
+SmoothDifferenceIF<T>::values(const Vec3T<T>* a_points, T* a_values, std::size_t a_numPoints) const noexcept
+{
+  EBGEOMETRY_EXPECT(m_smoothIntersectionIF != nullptr);
+
+  m_smoothIntersectionIF->values(a_points, a_values, a_numPoints);
+}
+
 template <class T>
 FiniteRepetitionIF<T>::FiniteRepetitionIF(const std::shared_ptr<ImplicitFunction<T>>& a_implicitFunction,
                                           const Vec3T<T>&                             a_period,
@@ -827,6 +1078,29 @@ FiniteRepetitionIF<T>::value(const Vec3T<T>& a_point) const noexcept
   return ret;
 }
 
+template <class T>
+void
+FiniteRepetitionIF<T>::values(const Vec3T<T>* a_points, T* a_values, std::size_t a_numPoints) const noexcept
+{
+  constexpr std::size_t chunkSize = ImplicitFunction<T>::s_batchChunkSize;
+
+  std::array<Vec3T<T>, chunkSize> q;
+
+  for (std::size_t begin = 0; begin < a_numPoints; begin += chunkSize) {
+    const std::size_t count = std::min(chunkSize, a_numPoints - begin);
+
+    for (std::size_t j = 0; j < count; j++) {
+      const Vec3T<T>& p = a_points[begin + j];
+
+      for (size_t i = 0; i < 3; i++) {
+        q[j][i] = p[i] - m_period[i] * std::round(std::clamp((p[i] / m_period[i]), -m_repeatLo[i], m_repeatHi[i]));
+      }
+    }
+
+    m_implicitFunction->values(q.data(), a_values + begin, count);
+  }
+}
+
 } // namespace EBGeometry
 
 #endif
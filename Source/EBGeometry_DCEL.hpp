@@ -59,6 +59,14 @@ class FaceT;
 template <class T, class Meta = DefaultMetaData>
 class MeshT;
 
+/**
+ * @brief DCEL mesh stored as flat index arrays instead of linked objects.
+ * @tparam T    Floating-point precision type.
+ * @tparam Meta User-defined metadata type.
+ */
+template <class T, class Meta = DefaultMetaData>
+class IndexedMeshT;
+
 /**
  * @brief Half-edge iterator class for navigating the half edge mesh.
  * @tparam T    Floating-point precision type.
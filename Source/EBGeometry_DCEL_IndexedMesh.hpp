@@ -0,0 +1,561 @@
+// SPDX-FileCopyrightText: 2026 Robert Marskar <robert.marskar@sintef.no>
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+/**
+ * @file   EBGeometry_DCEL_IndexedMesh.hpp
+ * @brief  Declaration of an index-based DCEL mesh that stores its vertices, half-edges and faces in flat arrays.
+ * @author Robert Marskar
+ */
+
+#ifndef EBGEOMETRY_DCEL_INDEXEDMESH_HPP
+#define EBGEOMETRY_DCEL_INDEXEDMESH_HPP
+
+// Std includes
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Our includes
+#include "EBGeometry_DCEL.hpp"
+#include "EBGeometry_DCEL_Mesh.hpp"
+#include "EBGeometry_Polygon2D.hpp"
+#include "EBGeometry_Vec.hpp"
+
+namespace EBGeometry {
+
+namespace DCEL {
+
+/**
+ * @brief DCEL mesh stored as flat arrays of 32-bit indices.
+ * @details Holds the same half-edge structure as MeshT, but instead of one heap-allocated, reference-counted object
+ * per vertex, half-edge and face, every attribute lives in its own contiguous array, indexed by the element number:
+ * positions and normals of the vertices; origin vertex, next and pair half-edge, face and normal of the half-edges;
+ * first half-edge, normal, centroid and area of the faces. A closed triangle mesh takes about 430 bytes per vertex in
+ * double precision, a fraction of what MeshT needs, and the mesh can be copied like any value.
+ *
+ * The signed distance functionality is the same as that of MeshT and gives the same results: the distance to a face
+ * is the distance to its plane if the point projects inside the face, or else the distance to the closest edge or
+ * vertex, signed by the face, edge or vertex (pseudo)normal. The point-in-face test projects the face to the
+ * coordinate plane of Polygon2D on the fly, so no per-face embedding is stored.
+ *
+ * Like MeshT, the mesh is normally built by a file parser (see Parser::readIntoIndexedDCEL()) or by
+ * Soup::soupToIndexedDCEL(). toMesh() converts it to a MeshT for code that needs the pointer-based classes.
+ * @tparam T    Floating-point precision type.
+ * @tparam Meta User-defined metadata type.
+ */
+template <class T, class Meta>
+class IndexedMeshT
+{
+  static_assert(std::is_floating_point_v<T>, "IndexedMeshT requires a floating-point T");
+
+public:
+  /**
+   * @brief Alias for vector type
+   */
+  using Vec3 = Vec3T<T>;
+
+  /**
+   * @brief Alias for the pointer-based mesh type
+   */
+  using Mesh = MeshT<T, Meta>;
+
+  /**
+   * @brief Search algorithms for the direct signed distance, as for MeshT.
+   */
+  using SearchAlgorithm = typename Mesh::SearchAlgorithm;
+
+  /**
+   * @brief Index that marks a missing vertex, half-edge or face, e.g. the pair of a boundary half-edge.
+   */
+  static constexpr uint32_t NoIndex = std::numeric_limits<uint32_t>::max();
+
+  /**
+   * @brief Default constructor. Leaves the mesh empty.
+   */
+  IndexedMeshT() noexcept = default;
+
+  /**
+   * @brief Build the topology from a polygon soup. Does not call reconcile().
+   * @param[in] a_vertices Vertex coordinates. Should not contain duplicates (see Soup::compress()).
+   * @param[in] a_facets   Vertex indices of each polygon, counter-clockwise seen from the outside. Polygons with
+   * fewer than three vertices are skipped with a warning.
+   */
+  IndexedMeshT(const std::vector<Vec3>& a_vertices, const std::vector<std::vector<size_t>>& a_facets);
+
+  /**
+   * @brief Copy constructor. The mesh holds no pointers, so a copy is independent of the original.
+   * @param[in] a_otherMesh Other mesh.
+   */
+  IndexedMeshT(const IndexedMeshT& a_otherMesh) = default;
+
+  /**
+   * @brief Move constructor.
+   * @param[in, out] a_otherMesh Other mesh.
+   */
+  IndexedMeshT(IndexedMeshT&& a_otherMesh) noexcept = default;
+
+  /**
+   * @brief Destructor (does nothing)
+   */
+  ~IndexedMeshT() noexcept = default;
+
+  /**
+   * @brief Copy assignment.
+   * @param[in] a_otherMesh Other mesh.
+   * @return Reference to (*this).
+   */
+  IndexedMeshT&
+  operator=(const IndexedMeshT& a_otherMesh) = default;
+
+  /**
+   * @brief Move assignment.
+   * @param[in, out] a_otherMesh Other mesh.
+   * @return Reference to (*this).
+   */
+  IndexedMeshT&
+  operator=(IndexedMeshT&& a_otherMesh) noexcept = default;
+
+  /**
+   * @brief Build the topology from a polygon soup, replacing the current mesh. Does not call reconcile().
+   * @details Creates one half-edge per polygon side, in the order of the polygons and of their vertices, and links
+   * each half-edge u->v with the half-edge v->u of the neighboring polygon by sorting the half-edges on their
+   * vertex pair. The outgoing half-edge of a vertex is the last one created from it. Normals, centroids and areas
+   * are zero until reconcile() is called.
+   * @param[in] a_vertices Vertex coordinates. Should not contain duplicates (see Soup::compress()).
+   * @param[in] a_facets   Vertex indices of each polygon, counter-clockwise seen from the outside. Polygons with
+   * fewer than three vertices are skipped with a warning.
+   */
+  inline void
+  define(const std::vector<Vec3>& a_vertices, const std::vector<std::vector<size_t>>& a_facets);
+
+  /**
+   * @brief Perform a sanity check.
+   * @details Reports the same problems as MeshT::sanityCheck() (half-edges without a pair, degenerate faces and
+   * edges, unreferenced vertices, and so on) on std::cerr, with the number of times each occurs.
+   * @param[in] a_id Identifier when printing error messages (can be empty string).
+   */
+  inline void
+  sanityCheck(const std::string& a_id) const;
+
+  /**
+   * @brief Search algorithm for direct signed distance computations
+   * @param[in] a_algorithm Algorithm to use
+   */
+  inline void
+  setSearchAlgorithm(const SearchAlgorithm a_algorithm) noexcept;
+
+  /**
+   * @brief Set the algorithm that decides if a point projected to a face plane lies inside the face.
+   * @param[in] a_algorithm Algorithm to use
+   */
+  inline void
+  setInsideOutsideAlgorithm(const typename Polygon2D<T>::InsideOutsideAlgorithm a_algorithm) noexcept;
+
+  /**
+   * @brief Compute the face normals, centroids and areas, the half-edge normals and the vertex normals.
+   * @details Same definitions as MeshT::reconcile(). The vertex normals are accumulated face by face, in the order
+   * of the faces, which is the order MeshT visits the faces around each vertex.
+   * @param[in] a_weight Vertex angle weighting function. Either VertexNormalWeight::None for unweighted vertex
+   * normals or VertexNormalWeight::Angle for the pseudonormal
+   */
+  inline void
+  reconcile(const DCEL::VertexNormalWeight a_weight = DCEL::VertexNormalWeight::Angle) noexcept;
+
+  /**
+   * @brief Flip the mesh, making all the normals change direction.
+   * @note Should be called AFTER all normals have been computed.
+   */
+  inline void
+  flip() noexcept;
+
+  /**
+   * @brief Convert to a pointer-based DCEL mesh.
+   * @details Every field is copied as it is (positions, normals, centroids, areas, metadata and algorithms), so
+   * the result answers signed distance queries like this mesh. Vertices, half-edges and faces keep their indices.
+   * @return A new MeshT.
+   */
+  [[nodiscard]] inline std::shared_ptr<Mesh>
+  toMesh() const;
+
+  /**
+   * @brief Get the number of vertices.
+   * @return Number of vertices.
+   */
+  [[nodiscard]] inline size_t
+  getNumVertices() const noexcept;
+
+  /**
+   * @brief Get the number of half-edges.
+   * @return Number of half-edges.
+   */
+  [[nodiscard]] inline size_t
+  getNumEdges() const noexcept;
+
+  /**
+   * @brief Get the number of faces.
+   * @return Number of faces.
+   */
+  [[nodiscard]] inline size_t
+  getNumFaces() const noexcept;
+
+  /**
+   * @brief Get modifiable vertex positions. Call reconcile() after moving vertices.
+   * @return Reference to the vertex positions.
+   */
+  [[nodiscard]] inline std::vector<Vec3>&
+  getVertexPositions() noexcept;
+
+  /**
+   * @brief Get the vertex positions.
+   * @return Const reference to the vertex positions.
+   */
+  [[nodiscard]] inline const std::vector<Vec3>&
+  getVertexPositions() const noexcept;
+
+  /**
+   * @brief Get the vertex normals.
+   * @return Const reference to the vertex normals.
+   */
+  [[nodiscard]] inline const std::vector<Vec3>&
+  getVertexNormals() const noexcept;
+
+  /**
+   * @brief Get the outgoing half-edge of every vertex.
+   * @return Const reference to the half-edge indices, NoIndex for an unreferenced vertex.
+   */
+  [[nodiscard]] inline const std::vector<uint32_t>&
+  getVertexEdges() const noexcept;
+
+  /**
+   * @brief Get the origin vertex of every half-edge.
+   * @return Const reference to the vertex indices.
+   */
+  [[nodiscard]] inline const std::vector<uint32_t>&
+  getEdgeVertices() const noexcept;
+
+  /**
+   * @brief Get the next half-edge of every half-edge, counter-clockwise around its face.
+   * @return Const reference to the half-edge indices.
+   */
+  [[nodiscard]] inline const std::vector<uint32_t>&
+  getEdgeNextEdges() const noexcept;
+
+  /**
+   * @brief Get the pair half-edge of every half-edge.
+   * @return Const reference to the half-edge indices, NoIndex on a boundary.
+   */
+  [[nodiscard]] inline const std::vector<uint32_t>&
+  getEdgePairEdges() const noexcept;
+
+  /**
+   * @brief Get the face of every half-edge.
+   * @return Const reference to the face indices.
+   */
+  [[nodiscard]] inline const std::vector<uint32_t>&
+  getEdgeFaces() const noexcept;
+
+  /**
+   * @brief Get the half-edge normals.
+   * @return Const reference to the half-edge normals.
+   */
+  [[nodiscard]] inline const std::vector<Vec3>&
+  getEdgeNormals() const noexcept;
+
+  /**
+   * @brief Get the first half-edge of every face.
+   * @return Const reference to the half-edge indices.
+   */
+  [[nodiscard]] inline const std::vector<uint32_t>&
+  getFaceEdges() const noexcept;
+
+  /**
+   * @brief Get the face normals.
+   * @return Const reference to the face normals.
+   */
+  [[nodiscard]] inline const std::vector<Vec3>&
+  getFaceNormals() const noexcept;
+
+  /**
+   * @brief Get the face centroids.
+   * @return Const reference to the face centroids.
+   */
+  [[nodiscard]] inline const std::vector<Vec3>&
+  getFaceCentroids() const noexcept;
+
+  /**
+   * @brief Get the face areas.
+   * @return Const reference to the face areas.
+   */
+  [[nodiscard]] inline const std::vector<T>&
+  getFaceAreas() const noexcept;
+
+  /**
+   * @brief Get modifiable vertex metadata.
+   * @return Reference to the vertex metadata.
+   */
+  [[nodiscard]] inline std::vector<Meta>&
+  getVertexMetaData() noexcept;
+
+  /**
+   * @brief Get the vertex metadata.
+   * @return Const reference to the vertex metadata.
+   */
+  [[nodiscard]] inline const std::vector<Meta>&
+  getVertexMetaData() const noexcept;
+
+  /**
+   * @brief Get modifiable half-edge metadata.
+   * @return Reference to the half-edge metadata.
+   */
+  [[nodiscard]] inline std::vector<Meta>&
+  getEdgeMetaData() noexcept;
+
+  /**
+   * @brief Get the half-edge metadata.
+   * @return Const reference to the half-edge metadata.
+   */
+  [[nodiscard]] inline const std::vector<Meta>&
+  getEdgeMetaData() const noexcept;
+
+  /**
+   * @brief Get modifiable face metadata.
+   * @return Reference to the face metadata.
+   */
+  [[nodiscard]] inline std::vector<Meta>&
+  getFaceMetaData() noexcept;
+
+  /**
+   * @brief Get the face metadata.
+   * @return Const reference to the face metadata.
+   */
+  [[nodiscard]] inline const std::vector<Meta>&
+  getFaceMetaData() const noexcept;
+
+  /**
+   * @brief Get the vertices of a face, in counter-clockwise order.
+   * @param[in] a_face Face index.
+   * @return Vertex indices.
+   */
+  [[nodiscard]] inline std::vector<uint32_t>
+  getFaceVertices(const uint32_t a_face) const;
+
+  /**
+   * @brief Compute the signed distance from a point to this mesh, with the mesh's search algorithm.
+   * @details Iterates through ALL faces; see MeshT::signedDistance().
+   * @param[in] a_x0 3D point in space.
+   * @return Signed distance to the mesh; negative inside, positive outside. Returns +infinity if the mesh has no
+   * faces.
+   */
+  [[nodiscard]] inline T
+  signedDistance(const Vec3& a_x0) const noexcept;
+
+  /**
+   * @brief Compute the signed distance from a point to this mesh.
+   * @details Iterates through ALL faces; see MeshT::signedDistance().
+   * @param[in] a_x0        3D point in space.
+   * @param[in] a_algorithm Search algorithm
+   * @return Signed distance to the mesh; negative inside, positive outside. Returns +infinity if the mesh has no
+   * faces.
+   */
+  [[nodiscard]] inline T
+  signedDistance(const Vec3& a_x0, SearchAlgorithm a_algorithm) const noexcept;
+
+  /**
+   * @brief Compute the unsigned square distance from a point to this mesh.
+   * @param[in] a_x0 3D point in space.
+   * @return Squared unsigned distance to the nearest face, or +infinity if the mesh has no faces.
+   */
+  [[nodiscard]] inline T
+  unsignedDistance2(const Vec3& a_x0) const noexcept;
+
+  /**
+   * @brief Compute the signed distance from a point to one face.
+   * @details Same as FaceT::signedDistance().
+   * @param[in] a_face Face index.
+   * @param[in] a_x0   3D point in space.
+   * @return Signed distance to the face.
+   */
+  [[nodiscard]] inline T
+  faceSignedDistance(const uint32_t a_face, const Vec3& a_x0) const noexcept;
+
+  /**
+   * @brief Compute the unsigned square distance from a point to one face.
+   * @details Same as FaceT::unsignedDistance2().
+   * @param[in] a_face Face index.
+   * @param[in] a_x0   3D point in space.
+   * @return Squared distance to the face.
+   */
+  [[nodiscard]] inline T
+  faceUnsignedDistance2(const uint32_t a_face, const Vec3& a_x0) const noexcept;
+
+protected:
+  /**
+   * @brief Search algorithm. Only used in signed distance functions.
+   */
+  SearchAlgorithm m_algorithm = SearchAlgorithm::Direct2;
+
+  /**
+   * @brief Point-in-face algorithm.
+   */
+  typename Polygon2D<T>::InsideOutsideAlgorithm m_insideOutsideAlgorithm =
+    Polygon2D<T>::InsideOutsideAlgorithm::CrossingNumber;
+
+  /**
+   * @brief Vertex positions
+   */
+  std::vector<Vec3> m_vertexPositions;
+
+  /**
+   * @brief Vertex normals
+   */
+  std::vector<Vec3> m_vertexNormals;
+
+  /**
+   * @brief Outgoing half-edge of every vertex
+   */
+  std::vector<uint32_t> m_vertexEdges;
+
+  /**
+   * @brief Vertex metadata
+   */
+  std::vector<Meta> m_vertexMetaData;
+
+  /**
+   * @brief Origin vertex of every half-edge
+   */
+  std::vector<uint32_t> m_edgeVertices;
+
+  /**
+   * @brief Next half-edge of every half-edge
+   */
+  std::vector<uint32_t> m_edgeNextEdges;
+
+  /**
+   * @brief Pair half-edge of every half-edge
+   */
+  std::vector<uint32_t> m_edgePairEdges;
+
+  /**
+   * @brief Face of every half-edge
+   */
+  std::vector<uint32_t> m_edgeFaces;
+
+  /**
+   * @brief Half-edge normals
+   */
+  std::vector<Vec3> m_edgeNormals;
+
+  /**
+   * @brief Half-edge metadata
+   */
+  std::vector<Meta> m_edgeMetaData;
+
+  /**
+   * @brief First half-edge of every face
+   */
+  std::vector<uint32_t> m_faceEdges;
+
+  /**
+   * @brief Face normals
+   */
+  std::vector<Vec3> m_faceNormals;
+
+  /**
+   * @brief Face centroids
+   */
+  std::vector<Vec3> m_faceCentroids;
+
+  /**
+   * @brief Face areas
+   */
+  std::vector<T> m_faceAreas;
+
+  /**
+   * @brief Face metadata
+   */
+  std::vector<Meta> m_faceMetaData;
+
+  /**
+   * @brief Link every half-edge with the half-edge that runs the other way between the same two vertices.
+   */
+  inline void
+  reconcilePairEdges();
+
+  /**
+   * @brief Compute the face normals, centroids and areas.
+   */
+  inline void
+  reconcileFaces() noexcept;
+
+  /**
+   * @brief Compute the half-edge normals from the normals of the two faces they separate.
+   */
+  inline void
+  reconcileEdges() noexcept;
+
+  /**
+   * @brief Compute the vertex normals from the normals of the faces around them.
+   * @param[in] a_weight Vertex angle weighting
+   */
+  inline void
+  reconcileVertices(const DCEL::VertexNormalWeight a_weight) noexcept;
+
+  /**
+   * @brief Check if a point projects to the inside of a face.
+   * @param[in] a_face Face index.
+   * @param[in] a_x0   3D point in space.
+   * @return True if the projection of a_x0 to the face plane lies inside the face.
+   */
+  [[nodiscard]] inline bool
+  isPointInsideFace(const uint32_t a_face, const Vec3& a_x0) const noexcept;
+
+  /**
+   * @brief Compute the signed distance from a point to one half-edge, or to its end vertices.
+   * @details Same as EdgeT::signedDistance().
+   * @param[in] a_edge Half-edge index.
+   * @param[in] a_x0   3D point in space.
+   * @return Signed distance to the half-edge.
+   */
+  [[nodiscard]] inline T
+  edgeSignedDistance(const uint32_t a_edge, const Vec3& a_x0) const noexcept;
+
+  /**
+   * @brief Compute the unsigned square distance from a point to one half-edge.
+   * @param[in] a_edge Half-edge index.
+   * @param[in] a_x0   3D point in space.
+   * @return Squared distance to the half-edge.
+   */
+  [[nodiscard]] inline T
+  edgeUnsignedDistance2(const uint32_t a_edge, const Vec3& a_x0) const noexcept;
+
+  /**
+   * @brief Compute the signed distance from a point to one vertex.
+   * @param[in] a_vertex Vertex index.
+   * @param[in] a_x0     3D point in space.
+   * @return Distance to the vertex, signed by the vertex normal.
+   */
+  [[nodiscard]] inline T
+  vertexSignedDistance(const uint32_t a_vertex, const Vec3& a_x0) const noexcept;
+
+  /**
+   * @brief Print all warnings to std::cerr
+   * @param[in] a_warnings List of warnings (generated by sanityCheck)
+   * @param[in] a_id Identifier used when printing warnings (can be empty string)
+   */
+  inline void
+  printWarnings(const std::map<std::string, size_t>& a_warnings, const std::string& a_id) const;
+};
+
+} // namespace DCEL
+
+} // namespace EBGeometry
+
+#include "EBGeometry_DCEL_IndexedMeshImplem.hpp"
+
+#endif
@@ -0,0 +1,1024 @@
+// SPDX-FileCopyrightText: 2026 Robert Marskar <robert.marskar@sintef.no>
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+/**
+ * @file   EBGeometry_DCEL_IndexedMeshImplem.hpp
+ * @brief  Implementation of EBGeometry_DCEL_IndexedMesh.hpp
+ * @author Robert Marskar
+ */
+
+#ifndef EBGEOMETRY_DCEL_INDEXEDMESHIMPLEM_HPP
+#define EBGEOMETRY_DCEL_INDEXEDMESHIMPLEM_HPP
+
+// Std includes
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Our includes
+#include "EBGeometry_Constants.hpp"
+#include "EBGeometry_DCEL_Edge.hpp"
+#include "EBGeometry_DCEL_Face.hpp"
+#include "EBGeometry_DCEL_IndexedMesh.hpp"
+#include "EBGeometry_DCEL_Vertex.hpp"
+#include "EBGeometry_Macros.hpp"
+
+namespace EBGeometry {
+
+namespace DCEL {
+
+template <class T, class Meta>
+inline IndexedMeshT<T, Meta>::IndexedMeshT(const std::vector<Vec3>&                a_vertices,
+                                           const std::vector<std::vector<size_t>>& a_facets)
+  : IndexedMeshT()
+{
+  this->define(a_vertices, a_facets);
+}
+
+template <class T, class Meta>
+inline void
+IndexedMeshT<T, Meta>::define(const std::vector<Vec3>& a_vertices, const std::vector<std::vector<size_t>>& a_facets)
+{
+  EBGEOMETRY_EXPECT(a_vertices.size() < NoIndex);
+
+  const size_t numVertices = a_vertices.size();
+
+  size_t numEdges = 0;
+  size_t numFaces = 0;
+  for (const auto& facet : a_facets) {
+    if (facet.size() >= 3) {
+      numEdges += facet.size();
+      numFaces += 1;
+    }
+  }
+
+  EBGEOMETRY_EXPECT(numEdges < NoIndex);
+
+  m_vertexPositions = a_vertices;
+  m_vertexNormals.assign(numVertices, Vec3::zeros());
+  m_vertexEdges.assign(numVertices, NoIndex);
+  m_vertexMetaData.assign(numVertices, Meta());
+
+  m_edgeVertices.clear();
+  m_edgeNextEdges.clear();
+  m_edgeFaces.clear();
+  m_faceEdges.clear();
+
+  m_edgeVertices.reserve(numEdges);
+  m_edgeNextEdges.reserve(numEdges);
+  m_edgeFaces.reserve(numEdges);
+  m_faceEdges.reserve(numFaces);
+
+  for (const auto& facet : a_facets) {
+    if (facet.size() < 3) {
+      std::cerr << "IndexedMeshT::define -- not enough vertices in face, skipping it\n";
+
+      EBGEOMETRY_EXPECT(facet.size() >= 3);
+
+      continue;
+    }
+
+    const auto face  = static_cast<uint32_t>(m_faceEdges.size());
+    const auto first = static_cast<uint32_t>(m_edgeVertices.size());
+
+    for (size_t i = 0; i < facet.size(); i++) {
+      EBGEOMETRY_EXPECT(facet[i] < numVertices);
+
+      const auto vertex = static_cast<uint32_t>(facet[i]);
+
+      m_edgeVertices.emplace_back(vertex);
+      m_edgeNextEdges.emplace_back(first + static_cast<uint32_t>((i + 1) % facet.size()));
+      m_edgeFaces.emplace_back(face);
+
+      m_vertexEdges[vertex] = first + static_cast<uint32_t>(i);
+    }
+
+    m_faceEdges.emplace_back(first);
+  }
+
+  m_edgePairEdges.assign(numEdges, NoIndex);
+  m_edgeNormals.assign(numEdges, Vec3::zeros());
+  m_edgeMetaData.assign(numEdges, Meta());
+
+  m_faceNormals.assign(numFaces, Vec3::zeros());
+  m_faceCentroids.assign(numFaces, Vec3::zeros());
+  m_faceAreas.assign(numFaces, T(0));
+  m_faceMetaData.assign(numFaces, Meta());
+
+  this->reconcilePairEdges();
+}
+
+template <class T, class Meta>
+inline void
+IndexedMeshT<T, Meta>::reconcilePairEdges()
+{
+  const size_t numEdges = m_edgeVertices.size();
+
+  const auto key = [](const uint32_t a_from, const uint32_t a_to) noexcept -> uint64_t {
+    return (uint64_t(a_from) << 32) | uint64_t(a_to);
+  };
+
+  // Half-edges sorted on (origin, destination). The pair of u->v is then found by a binary search for v->u.
+  std::vector<std::pair<uint64_t, uint32_t>> sorted(numEdges);
+  for (size_t e = 0; e < numEdges; e++) {
+    const uint32_t from = m_edgeVertices[e];
+    const uint32_t to   = m_edgeVertices[m_edgeNextEdges[e]];
+
+    sorted[e] = std::make_pair(key(from, to), static_cast<uint32_t>(e));
+  }
+
+  std::sort(sorted.begin(), sorted.end());
+
+  for (size_t e = 0; e < numEdges; e++) {
+    const uint32_t from = m_edgeVertices[e];
+    const uint32_t to   = m_edgeVertices[m_edgeNextEdges[e]];
+
+    const uint64_t reverse = key(to, from);
+
+    const auto it = std::lower_bound(sorted.begin(), sorted.end(), std::make_pair(reverse, uint32_t(0)));
+
+    if (it != sorted.end() && it->first == reverse) {
+      m_edgePairEdges[e] = it->second;
+    }
+  }
+}
+
+template <class T, class Meta>
+inline void
+IndexedMeshT<T, Meta>::printWarnings(const std::map<std::string, size_t>& a_warnings, const std::string& a_id) const
+{
+  std::string baseError = "IndexedMeshT<T, Meta>::sanityCheck(...)";
+
+  if (a_id != "") {
+    baseError += " for '" + a_id + "'";
+  }
+
+  baseError += " - warnings about error '";
+
+  for (const auto& warn : a_warnings) {
+    if (warn.second > 0) {
+      std::cerr << baseError << warn.first << "' = " << warn.second << "\n";
+    }
+  }
+}
+
+template <class T, class Meta>
+inline void
+IndexedMeshT<T, Meta>::sanityCheck(const std::string& a_id) const
+{
+  const std::string f_noEdge     = "face with no edge";
+  const std::string f_degenerate = "degenerate face";
+
+  const std::string e_degenerate = "degenerate edge";
+  const std::string e_noPairEdge = "no pair edge (not watertight)";
+  const std::string e_noNextEdge = "no next edge (badly linked dcel)";
+  const std::string e_noOrigVert = "no origin vertex found for half edge (badly linked dcel)";
+  const std::string e_noFace     = "no face found for half edge (badly linked dcel)";
+
+  const std::string v_noEdge = "no referenced edge for vertex (unreferenced vertex)";
+
+  std::map<std::string, size_t> warnings = {{f_noEdge, 0},
+                                            {f_degenerate, 0},
+                                            {e_degenerate, 0},
+                                            {e_noPairEdge, 0},
+                                            {e_noNextEdge, 0},
+                                            {e_noOrigVert, 0},
+                                            {e_noFace, 0},
+                                            {v_noEdge, 0}};
+
+  for (size_t f = 0; f < m_faceEdges.size(); f++) {
+    if (m_faceEdges[f] == NoIndex) {
+      warnings[f_noEdge] += 1;
+
+      continue;
+    }
+
+    auto vertices = this->getFaceVertices(static_cast<uint32_t>(f));
+    std::sort(vertices.begin(), vertices.end());
+    if (std::unique(vertices.begin(), vertices.end()) != vertices.end()) {
+      warnings[f_degenerate] += 1;
+    }
+  }
+
+  for (size_t e = 0; e < m_edgeVertices.size(); e++) {
+    const uint32_t next = m_edgeNextEdges[e];
+
+    if (next != NoIndex && m_edgeVertices[e] == m_edgeVertices[next]) {
+      warnings[e_degenerate] += 1;
+    }
+    if (m_edgePairEdges[e] == NoIndex) {
+      warnings[e_noPairEdge] += 1;
+    }
+    if (next == NoIndex) {
+      warnings[e_noNextEdge] += 1;
+    }
+    if (m_edgeVertices[e] == NoIndex) {
+      warnings[e_noOrigVert] += 1;
+    }
+    if (m_edgeFaces[e] == NoIndex) {
+      warnings[e_noFace] += 1;
+    }
+  }
+
+  for (const uint32_t e : m_vertexEdges) {
+    if (e == NoIndex) {
+      warnings[v_noEdge] += 1;
+    }
+  }
+
+  this->printWarnings(warnings, a_id);
+}
+
+template <class T, class Meta>
+inline void
+IndexedMeshT<T, Meta>::setSearchAlgorithm(const SearchAlgorithm a_algorithm) noexcept
+{
+  m_algorithm = a_algorithm;
+}
+
+template <class T, class Meta>
+inline void
+IndexedMeshT<T, Meta>::setInsideOutsideAlgorithm(
+  const typename Polygon2D<T>::InsideOutsideAlgorithm a_algorithm) noexcept
+{
+  m_insideOutsideAlgorithm = a_algorithm;
+}
+
+template <class T, class Meta>
+inline void
+IndexedMeshT<T, Meta>::reconcile(const DCEL::VertexNormalWeight a_weight) noexcept
+{
+  this->reconcileFaces();
+  this->reconcileEdges();
+  this->reconcileVertices(a_weight);
+}
+
+template <class T, class Meta>
+inline void
+IndexedMeshT<T, Meta>::flip() noexcept
+{
+  for (auto& n : m_faceNormals) {
+    n = -n;
+  }
+  for (auto& n : m_edgeNormals) {
+    n = -n;
+  }
+  for (auto& n : m_vertexNormals) {
+    n = -n;
+  }
+}
+
+template <class T, class Meta>
+inline void
+IndexedMeshT<T, Meta>::reconcileFaces() noexcept
+{
+  for (size_t f = 0; f < m_faceEdges.size(); f++) {
+    const uint32_t first = m_faceEdges[f];
+
+    EBGEOMETRY_EXPECT(first != NoIndex);
+
+    // Normal from the first three consecutive vertices that span a plane, as in FaceT::computeNormal().
+    Vec3     normal = Vec3::zeros();
+    uint32_t e      = first;
+    do {
+      const uint32_t e1 = m_edgeNextEdges[e];
+      const uint32_t e2 = m_edgeNextEdges[e1];
+
+      const Vec3& x0 = m_vertexPositions[m_edgeVertices[e]];
+      const Vec3& x1 = m_vertexPositions[m_edgeVertices[e1]];
+      const Vec3& x2 = m_vertexPositions[m_edgeVertices[e2]];
+
+      normal = (x2 - x0).cross(x2 - x1);
+
+      e = e1;
+    } while (normal.length() == T(0) && e != first);
+
+    EBGEOMETRY_EXPECT(normal.length() > std::numeric_limits<T>::epsilon());
+
+    normal = normal / normal.length();
+
+    // Centroid, and area from the cross-product formula over all sides (see FaceT::computeArea()).
+    Vec3   centroid    = Vec3::zeros();
+    T      area        = T(0);
+    size_t numVertices = 0;
+
+    e = first;
+    do {
+      const Vec3& v1 = m_vertexPositions[m_edgeVertices[e]];
+      const Vec3& v2 = m_vertexPositions[m_edgeVertices[m_edgeNextEdges[e]]];
+
+      centroid += v1;
+      area += normal.dot(v2.cross(v1));
+      numVertices++;
+
+      e = m_edgeNextEdges[e];
+    } while (e != first);
+
+    EBGEOMETRY_EXPECT(numVertices >= 3);
+
+    m_faceNormals[f]   = normal;
+    m_faceCentroids[f] = centroid / T(numVertices);
+    m_faceAreas[f]     = T(0.5) * std::abs(area);
+  }
+}
+
+template <class T, class Meta>
+inline void
+IndexedMeshT<T, Meta>::reconcileEdges() noexcept
+{
+  for (size_t e = 0; e < m_edgeVertices.size(); e++) {
+    EBGEOMETRY_EXPECT(m_edgeFaces[e] != NoIndex);
+
+    Vec3 normal = m_faceNormals[m_edgeFaces[e]];
+
+    // A boundary half-edge takes the normal of its only face.
+    if (m_edgePairEdges[e] != NoIndex) {
+      normal += m_faceNormals[m_edgeFaces[m_edgePairEdges[e]]];
+    }
+
+    const T len = normal.length();
+
+    EBGEOMETRY_EXPECT(len > T(0));
+
+    m_edgeNormals[e] = (len > std::numeric_limits<T>::epsilon()) ? normal / len : Vec3::zeros();
+  }
+}
+
+template <class T, class Meta>
+inline void
+IndexedMeshT<T, Meta>::reconcileVertices(const DCEL::VertexNormalWeight a_weight) noexcept
+{
+  std::fill(m_vertexNormals.begin(), m_vertexNormals.end(), Vec3::zeros());
+
+  // Scatter from the faces: each corner adds its face normal (weighted by the corner angle for the pseudonormal,
+  // see VertexT::computeVertexNormalAngleWeighted()) to the vertex at the corner.
+  for (size_t f = 0; f < m_faceEdges.size(); f++) {
+    const Vec3&    faceNormal = m_faceNormals[f];
+    const uint32_t first      = m_faceEdges[f];
+
+    uint32_t prev = first;
+    while (m_edgeNextEdges[prev] != first) {
+      prev = m_edgeNextEdges[prev];
+    }
+
+    uint32_t e = first;
+    do {
+      const uint32_t next   = m_edgeNextEdges[e];
+      const uint32_t vertex = m_edgeVertices[e];
+
+      switch (a_weight) {
+      case DCEL::VertexNormalWeight::None: {
+        m_vertexNormals[vertex] += faceNormal;
+
+        break;
+      }
+      case DCEL::VertexNormalWeight::Angle: {
+        const Vec3& x0 = m_vertexPositions[vertex];
+        const Vec3& x1 = m_vertexPositions[m_edgeVertices[next]];
+        const Vec3& x2 = m_vertexPositions[m_edgeVertices[prev]];
+
+        EBGEOMETRY_EXPECT(x0 != x1);
+        EBGEOMETRY_EXPECT(x0 != x2);
+        EBGEOMETRY_EXPECT(x1 != x2);
+
+        Vec3 v1 = x1 - x0;
+        Vec3 v2 = x2 - x0;
+
+        v1 = v1 / v1.length();
+        v2 = v2 / v2.length();
+
+        // Clamp to [-1,1] to guard against std::acos(NaN) from floating-point rounding.
+        const T alpha = std::acos(std::clamp(v1.dot(v2), T(-1), T(1)));
+
+        m_vertexNormals[vertex] += alpha * faceNormal;
+
+        break;
+      }
+      default: {
+        std::cerr << "In file 'EBGeometry_DCEL_IndexedMeshImplem.hpp' function "
+                     "DCEL::IndexedMeshT<T, Meta>::reconcileVertices(VertexNormalWeighting) - a_weight does "
+                     "not match any of the known VertexNormalWeight enumerators.\n";
+        EBGEOMETRY_EXPECT(false);
+
+        break;
+      }
+      }
+
+      prev = e;
+      e    = next;
+    } while (e != first);
+  }
+
+  for (size_t v = 0; v < m_vertexNormals.size(); v++) {
+    // Unreferenced vertices keep a zero normal; sanityCheck() reports them.
+    if (m_vertexEdges[v] == NoIndex) {
+      continue;
+    }
+
+    const T len = m_vertexNormals[v].length();
+
+    EBGEOMETRY_EXPECT(len > std::numeric_limits<T>::epsilon());
+
+    if (len > std::numeric_limits<T>::epsilon()) {
+      m_vertexNormals[v] = m_vertexNormals[v] / len;
+    }
+  }
+}
+
+template <class T, class Meta>
+inline std::shared_ptr<MeshT<T, Meta>>
+IndexedMeshT<T, Meta>::toMesh() const
+{
+  using Vertex = VertexT<T, Meta>;
+  using Edge   = EdgeT<T, Meta>;
+  using Face   = FaceT<T, Meta>;
+
+  auto mesh = std::make_shared<Mesh>();
+
+  auto& vertices = mesh->getVertices();
+  auto& edges    = mesh->getEdges();
+  auto& faces    = mesh->getFaces();
+
+  vertices.reserve(m_vertexPositions.size());
+  edges.reserve(m_edgeVertices.size());
+  faces.reserve(m_faceEdges.size());
+
+  // All objects first, since they refer to each other.
+  for (size_t v = 0; v < m_vertexPositions.size(); v++) {
+    vertices.emplace_back(std::make_shared<Vertex>(m_vertexPositions[v], m_vertexNormals[v]));
+    vertices.back()->setMetaData(m_vertexMetaData[v]);
+  }
+  for (size_t e = 0; e < m_edgeVertices.size(); e++) {
+    edges.emplace_back(std::make_shared<Edge>());
+  }
+  for (size_t f = 0; f < m_faceEdges.size(); f++) {
+    faces.emplace_back(std::make_shared<Face>());
+  }
+
+  for (size_t v = 0; v < m_vertexPositions.size(); v++) {
+    if (m_vertexEdges[v] != NoIndex) {
+      vertices[v]->setEdge(edges[m_vertexEdges[v]]);
+    }
+  }
+
+  for (size_t e = 0; e < m_edgeVertices.size(); e++) {
+    const auto& edge = edges[e];
+
+    edge->setVertex(vertices[m_edgeVertices[e]]);
+    edge->setNextEdge(edges[m_edgeNextEdges[e]]);
+    edge->setFace(faces[m_edgeFaces[e]]);
+    if (m_edgePairEdges[e] != NoIndex) {
+      edge->setPairEdge(edges[m_edgePairEdges[e]]);
+    }
+    edge->getNormal() = m_edgeNormals[e];
+    edge->setMetaData(m_edgeMetaData[e]);
+  }
+
+  // Faces last: the 2D embedding walks the half-edges. The vertices list their faces in face order, as
+  // Soup::soupToDCEL() does.
+  auto insideOutsideAlgorithm = m_insideOutsideAlgorithm;
+
+  for (size_t f = 0; f < m_faceEdges.size(); f++) {
+    const auto& face = faces[f];
+
+    face->setHalfEdge(edges[m_faceEdges[f]]);
+    face->getNormal()   = m_faceNormals[f];
+    face->getCentroid() = m_faceCentroids[f];
+    face->getArea()     = m_faceAreas[f];
+    face->setMetaData(m_faceMetaData[f]);
+    face->setInsideOutsideAlgorithm(insideOutsideAlgorithm);
+    face->computePolygon2D();
+
+    uint32_t e = m_faceEdges[f];
+    do {
+      vertices[m_edgeVertices[e]]->addFace(face);
+
+      e = m_edgeNextEdges[e];
+    } while (e != m_faceEdges[f]);
+  }
+
+  mesh->setSearchAlgorithm(m_algorithm);
+
+  return mesh;
+}
+
+template <class T, class Meta>
+inline size_t
+IndexedMeshT<T, Meta>::getNumVertices() const noexcept
+{
+  return m_vertexPositions.size();
+}
+
+template <class T, class Meta>
+inline size_t
+IndexedMeshT<T, Meta>::getNumEdges() const noexcept
+{
+  return m_edgeVertices.size();
+}
+
+template <class T, class Meta>
+inline size_t
+IndexedMeshT<T, Meta>::getNumFaces() const noexcept
+{
+  return m_faceEdges.size();
+}
+
+template <class T, class Meta>
+inline std::vector<Vec3T<T>>&
+IndexedMeshT<T, Meta>::getVertexPositions() noexcept
+{
+  return m_vertexPositions;
+}
+
+template <class T, class Meta>
+inline const std::vector<Vec3T<T>>&
+IndexedMeshT<T, Meta>::getVertexPositions() const noexcept
+{
+  return m_vertexPositions;
+}
+
+template <class T, class Meta>
+inline const std::vector<Vec3T<T>>&
+IndexedMeshT<T, Meta>::getVertexNormals() const noexcept
+{
+  return m_vertexNormals;
+}
+
+template <class T, class Meta>
+inline const std::vector<uint32_t>&
+IndexedMeshT<T, Meta>::getVertexEdges() const noexcept
+{
+  return m_vertexEdges;
+}
+
+template <class T, class Meta>
+inline const std::vector<uint32_t>&
+IndexedMeshT<T, Meta>::getEdgeVertices() const noexcept
+{
+  return m_edgeVertices;
+}
+
+template <class T, class Meta>
+inline const std::vector<uint32_t>&
+IndexedMeshT<T, Meta>::getEdgeNextEdges() const noexcept
+{
+  return m_edgeNextEdges;
+}
+
+template <class T, class Meta>
+inline const std::vector<uint32_t>&
+IndexedMeshT<T, Meta>::getEdgePairEdges() const noexcept
+{
+  return m_edgePairEdges;
+}
+
+template <class T, class Meta>
+inline const std::vector<uint32_t>&
+IndexedMeshT<T, Meta>::getEdgeFaces() const noexcept
+{
+  return m_edgeFaces;
+}
+
+template <class T, class Meta>
+inline const std::vector<Vec3T<T>>&
+IndexedMeshT<T, Meta>::getEdgeNormals() const noexcept
+{
+  return m_edgeNormals;
+}
+
+template <class T, class Meta>
+inline const std::vector<uint32_t>&
+IndexedMeshT<T, Meta>::getFaceEdges() const noexcept
+{
+  return m_faceEdges;
+}
+
+template <class T, class Meta>
+inline const std::vector<Vec3T<T>>&
+IndexedMeshT<T, Meta>::getFaceNormals() const noexcept
+{
+  return m_faceNormals;
+}
+
+template <class T, class Meta>
+inline const std::vector<Vec3T<T>>&
+IndexedMeshT<T, Meta>::getFaceCentroids() const noexcept
+{
+  return m_faceCentroids;
+}
+
+template <class T, class Meta>
+inline const std::vector<T>&
+IndexedMeshT<T, Meta>::getFaceAreas() const noexcept
+{
+  return m_faceAreas;
+}
+
+template <class T, class Meta>
+inline std::vector<Meta>&
+IndexedMeshT<T, Meta>::getVertexMetaData() noexcept
+{
+  return m_vertexMetaData;
+}
+
+template <class T, class Meta>
+inline const std::vector<Meta>&
+IndexedMeshT<T, Meta>::getVertexMetaData() const noexcept
+{
+  return m_vertexMetaData;
+}
+
+template <class T, class Meta>
+inline std::vector<Meta>&
+IndexedMeshT<T, Meta>::getEdgeMetaData() noexcept
+{
+  return m_edgeMetaData;
+}
+
+template <class T, class Meta>
+inline const std::vector<Meta>&
+IndexedMeshT<T, Meta>::getEdgeMetaData() const noexcept
+{
+  return m_edgeMetaData;
+}
+
+template <class T, class Meta>
+inline std::vector<Meta>&
+IndexedMeshT<T, Meta>::getFaceMetaData() noexcept
+{
+  return m_faceMetaData;
+}
+
+template <class T, class Meta>
+inline const std::vector<Meta>&
+IndexedMeshT<T, Meta>::getFaceMetaData() const noexcept
+{
+  return m_faceMetaData;
+}
+
+template <class T, class Meta>
+inline std::vector<uint32_t>
+IndexedMeshT<T, Meta>::getFaceVertices(const uint32_t a_face) const
+{
+  EBGEOMETRY_EXPECT(a_face < m_faceEdges.size());
+
+  std::vector<uint32_t> vertices;
+  vertices.reserve(3);
+
+  const uint32_t first = m_faceEdges[a_face];
+
+  uint32_t e = first;
+  do {
+    vertices.emplace_back(m_edgeVertices[e]);
+
+    e = m_edgeNextEdges[e];
+  } while (e != first && e != NoIndex);
+
+  return vertices;
+}
+
+template <class T, class Meta>
+inline T
+IndexedMeshT<T, Meta>::signedDistance(const Vec3& a_point) const noexcept
+{
+  return this->signedDistance(a_point, m_algorithm);
+}
+
+template <class T, class Meta>
+inline T
+IndexedMeshT<T, Meta>::signedDistance(const Vec3& a_point, SearchAlgorithm a_algorithm) const noexcept
+{
+  EBGEOMETRY_EXPECT(std::isfinite(a_point[0]));
+  EBGEOMETRY_EXPECT(std::isfinite(a_point[1]));
+  EBGEOMETRY_EXPECT(std::isfinite(a_point[2]));
+
+  const auto numFaces = static_cast<uint32_t>(m_faceEdges.size());
+
+  if (numFaces == 0) {
+    return std::numeric_limits<T>::infinity();
+  }
+
+  T minDist = std::numeric_limits<T>::max();
+
+  switch (a_algorithm) {
+  case SearchAlgorithm::Direct: {
+    minDist = this->faceSignedDistance(0, a_point);
+
+    T minDist2 = minDist * minDist;
+
+    for (uint32_t f = 1; f < numFaces; f++) {
+      const T curDist  = this->faceSignedDistance(f, a_point);
+      const T curDist2 = curDist * curDist;
+
+      if (curDist2 < minDist2) {
+        minDist  = curDist;
+        minDist2 = curDist2;
+      }
+    }
+
+    break;
+  }
+  case SearchAlgorithm::Direct2: {
+    uint32_t closest  = 0;
+    T        minDist2 = this->faceUnsignedDistance2(0, a_point);
+
+    for (uint32_t f = 1; f < numFaces; f++) {
+      const T curDist2 = this->faceUnsignedDistance2(f, a_point);
+
+      if (curDist2 < minDist2) {
+        closest  = f;
+        minDist2 = curDist2;
+      }
+    }
+
+    minDist = this->faceSignedDistance(closest, a_point);
+
+    break;
+  }
+  default: {
+    std::cerr << "Error in file 'EBGeometry_DCEL_IndexedMeshImplem.hpp' IndexedMeshT<T, Meta>::signedDistance - "
+                 "a_algorithm does not match any of the known SearchAlgorithm enumerators.\n";
+    EBGEOMETRY_EXPECT(false);
+
+    break;
+  }
+  }
+
+  return minDist;
+}
+
+template <class T, class Meta>
+inline T
+IndexedMeshT<T, Meta>::unsignedDistance2(const Vec3& a_point) const noexcept
+{
+  EBGEOMETRY_EXPECT(std::isfinite(a_point[0]));
+  EBGEOMETRY_EXPECT(std::isfinite(a_point[1]));
+  EBGEOMETRY_EXPECT(std::isfinite(a_point[2]));
+
+  if (m_faceEdges.empty()) {
+    return std::numeric_limits<T>::infinity();
+  }
+
+  T minDist2 = std::numeric_limits<T>::max();
+
+  for (size_t f = 0; f < m_faceEdges.size(); f++) {
+    minDist2 = std::min(minDist2, this->faceUnsignedDistance2(static_cast<uint32_t>(f), a_point));
+  }
+
+  return minDist2;
+}
+
+template <class T, class Meta>
+inline bool
+IndexedMeshT<T, Meta>::isPointInsideFace(const uint32_t a_face, const Vec3& a_x0) const noexcept
+{
+  using Vec2 = Vec2T<T>;
+
+  const Vec3& normal = m_faceNormals[a_face];
+  const Vec3  p      = a_x0 - normal * (normal.dot(a_x0 - m_faceCentroids[a_face]));
+
+  // Drop the coordinate along which the normal is largest, as Polygon2D does.
+  size_t ignoreDir = 0;
+  for (size_t dir = 1; dir < 3; dir++) {
+    if (std::abs(normal[dir]) > std::abs(normal[ignoreDir])) {
+      ignoreDir = dir;
+    }
+  }
+
+  const size_t xDir = (ignoreDir == 0) ? 1 : 0;
+  const size_t yDir = (ignoreDir == 2) ? 1 : 2;
+
+  const Vec2 P(p[xDir], p[yDir]);
+
+  const auto corner = [this, xDir, yDir](const uint32_t a_edge) noexcept -> Vec2 {
+    const Vec3& x = m_vertexPositions[m_edgeVertices[a_edge]];
+
+    return Vec2(x[xDir], x[yDir]);
+  };
+
+  const uint32_t first = m_faceEdges[a_face];
+
+  bool inside = false;
+
+  // The three tests of Polygon2D, over the sides P1 -> P2 of the projected polygon.
+  switch (m_insideOutsideAlgorithm) {
+  case Polygon2D<T>::InsideOutsideAlgorithm::CrossingNumber: {
+    size_t cn = 0;
+
+    uint32_t e = first;
+    do {
+      const Vec2 P1 = corner(e);
+      const Vec2 P2 = corner(m_edgeNextEdges[e]);
+
+      const bool upwardCrossing   = (P1.y <= P.y) && (P2.y > P.y);
+      const bool downwardCrossing = (P1.y > P.y) && (P2.y <= P.y);
+
+      if (upwardCrossing || downwardCrossing) {
+        const T t = (P.y - P1.y) / (P2.y - P1.y);
+
+        if (P.x < P1.x + t * (P2.x - P1.x)) {
+          cn += 1;
+        }
+      }
+
+      e = m_edgeNextEdges[e];
+    } while (e != first);
+
+    inside = (cn & 1);
+
+    break;
+  }
+  case Polygon2D<T>::InsideOutsideAlgorithm::WindingNumber: {
+    int wn = 0;
+
+    uint32_t e = first;
+    do {
+      const Vec2 P1 = corner(e);
+      const Vec2 P2 = corner(m_edgeNextEdges[e]);
+
+      const T isLeft = (P2.x - P1.x) * (P.y - P1.y) - (P.x - P1.x) * (P2.y - P1.y);
+
+      if (P1.y <= P.y) {
+        if (P2.y > P.y && isLeft > T(0)) {
+          ++wn;
+        }
+      }
+      else {
+        if (P2.y <= P.y && isLeft < T(0)) {
+          --wn;
+        }
+      }
+
+      e = m_edgeNextEdges[e];
+    } while (e != first);
+
+    inside = (wn != 0);
+
+    break;
+  }
+  case Polygon2D<T>::InsideOutsideAlgorithm::SubtendedAngle: {
+    constexpr T pi = EBGeometry::pi<T>;
+
+    T sumTheta = T(0);
+
+    uint32_t e = first;
+    do {
+      const Vec2 p1 = corner(e) - P;
+      const Vec2 p2 = corner(m_edgeNextEdges[e]) - P;
+
+      T dTheta = std::atan2(p2.y, p2.x) - std::atan2(p1.y, p1.x);
+
+      while (dTheta > pi) {
+        dTheta -= T(2) * pi;
+      }
+      while (dTheta < -pi) {
+        dTheta += T(2) * pi;
+      }
+
+      sumTheta += dTheta;
+
+      e = m_edgeNextEdges[e];
+    } while (e != first);
+
+    inside = std::abs(std::abs(sumTheta) / (T(2) * pi) - T(1)) < T(0.5);
+
+    break;
+  }
+  default: {
+    std::cerr << "In file 'EBGeometry_DCEL_IndexedMeshImplem.hpp' function IndexedMeshT<T, Meta>::isPointInsideFace "
+                 "- the inside/outside algorithm does not match any of the known InsideOutsideAlgorithm enumerators.\n";
+    EBGEOMETRY_EXPECT(false);
+
+    break;
+  }
+  }
+
+  return inside;
+}
+
+template <class T, class Meta>
+inline T
+IndexedMeshT<T, Meta>::faceSignedDistance(const uint32_t a_face, const Vec3& a_x0) const noexcept
+{
+  EBGEOMETRY_EXPECT(a_face < m_faceEdges.size());
+  EBGEOMETRY_EXPECT(std::isfinite(a_x0[0]));
+  EBGEOMETRY_EXPECT(std::isfinite(a_x0[1]));
+  EBGEOMETRY_EXPECT(std::isfinite(a_x0[2]));
+
+  if (this->isPointInsideFace(a_face, a_x0)) {
+    return m_faceNormals[a_face].dot(a_x0 - m_faceCentroids[a_face]);
+  }
+
+  T retval = std::numeric_limits<T>::infinity();
+
+  const uint32_t first = m_faceEdges[a_face];
+
+  uint32_t e = first;
+  do {
+    const T curDist = this->edgeSignedDistance(e, a_x0);
+
+    retval = (std::abs(curDist) < std::abs(retval)) ? curDist : retval;
+
+    e = m_edgeNextEdges[e];
+  } while (e != first && e != NoIndex);
+
+  return retval;
+}
+
+template <class T, class Meta>
+inline T
+IndexedMeshT<T, Meta>::faceUnsignedDistance2(const uint32_t a_face, const Vec3& a_x0) const noexcept
+{
+  EBGEOMETRY_EXPECT(a_face < m_faceEdges.size());
+  EBGEOMETRY_EXPECT(std::isfinite(a_x0[0]));
+  EBGEOMETRY_EXPECT(std::isfinite(a_x0[1]));
+  EBGEOMETRY_EXPECT(std::isfinite(a_x0[2]));
+
+  if (this->isPointInsideFace(a_face, a_x0)) {
+    const T normDist = m_faceNormals[a_face].dot(a_x0 - m_faceCentroids[a_face]);
+
+    return normDist * normDist;
+  }
+
+  T retval = std::numeric_limits<T>::infinity();
+
+  const uint32_t first = m_faceEdges[a_face];
+
+  uint32_t e = first;
+  do {
+    retval = std::min(retval, this->edgeUnsignedDistance2(e, a_x0));
+
+    e = m_edgeNextEdges[e];
+  } while (e != first && e != NoIndex);
+
+  return retval;
+}
+
+template <class T, class Meta>
+inline T
+IndexedMeshT<T, Meta>::edgeSignedDistance(const uint32_t a_edge, const Vec3& a_x0) const noexcept
+{
+  const uint32_t v1 = m_edgeVertices[a_edge];
+  const uint32_t v2 = m_edgeVertices[m_edgeNextEdges[a_edge]];
+
+  const Vec3& x1   = m_vertexPositions[v1];
+  const Vec3  x2x1 = m_vertexPositions[v2] - x1;
+
+  EBGEOMETRY_EXPECT(x2x1.dot(x2x1) > T(0));
+
+  // Project the point to the edge, as in EdgeT::signedDistance().
+  const T t = (a_x0 - x1).dot(x2x1) / x2x1.dot(x2x1);
+
+  if (t <= T(0)) {
+    return this->vertexSignedDistance(v1, a_x0);
+  }
+  if (t >= T(1)) {
+    return this->vertexSignedDistance(v2, a_x0);
+  }
+
+  const Vec3 delta = a_x0 - (x1 + t * x2x1);
+  const T    sgn   = (m_edgeNormals[a_edge].dot(delta) > T(0)) ? T(1) : T(-1);
+
+  return sgn * delta.length();
+}
+
+template <class T, class Meta>
+inline T
+IndexedMeshT<T, Meta>::edgeUnsignedDistance2(const uint32_t a_edge, const Vec3& a_x0) const noexcept
+{
+  const Vec3& x1   = m_vertexPositions[m_edgeVertices[a_edge]];
+  const Vec3  x2x1 = m_vertexPositions[m_edgeVertices[m_edgeNextEdges[a_edge]]] - x1;
+
+  EBGEOMETRY_EXPECT(x2x1.dot(x2x1) > T(0));
+
+  const T t = std::clamp((a_x0 - x1).dot(x2x1) / x2x1.dot(x2x1), T(0), T(1));
+
+  const Vec3 delta = a_x0 - (x1 + t * x2x1);
+
+  return delta.dot(delta);
+}
+
+template <class T, class Meta>
+inline T
+IndexedMeshT<T, Meta>::vertexSignedDistance(const uint32_t a_vertex, const Vec3& a_x0) const noexcept
+{
+  const Vec3 delta = a_x0 - m_vertexPositions[a_vertex];
+  const T    sign  = (m_vertexNormals[a_vertex].dot(delta) > T(0)) ? T(1) : T(-1);
+
+  return delta.length() * sign;
+}
+
+} // namespace DCEL
+
+} // namespace EBGeometry
+
+#endif
@@ -215,7 +215,8 @@ public:
    * VertexNormalWeight::None for unweighted vertex normals or
    * VertexNormalWeight::Angle for the pseudonormal
    * @details This will reconcile faces, edges, and vertices, e.g. computing the
-   * area and normal vector for faces
+   * area and normal vector for faces. Each of the three stages runs in parallel and gives
+   * bit-identical results to reconciling the objects one at a time.
    */
   inline void
   reconcile(const DCEL::VertexNormalWeight a_weight = DCEL::VertexNormalWeight::Angle) noexcept;
@@ -337,16 +338,21 @@ protected:
    */
   std::vector<FacePtr> m_faces;
 
+  /**
+   * @brief Smallest number of faces, edges, or vertices reconcile() hands to one thread at a time.
+   */
+  static constexpr std::size_t s_parallelGrainSize = 256;
+
   /**
    * @brief Function which computes internal things for the polygon faces.
-   * @note This calls DCEL::FaceT<T, Meta>::reconcile()
+   * @note This calls DCEL::FaceT<T, Meta>::reconcile() on all faces in parallel
    */
   inline void
   reconcileFaces() noexcept;
 
   /**
    * @brief Function which computes internal things for the half-edges
-   * @note This calls DCEL::EdgeT<T, Meta>::reconcile()
+   * @note This calls DCEL::EdgeT<T, Meta>::reconcile() on all half-edges in parallel
    */
   inline void
   reconcileEdges() noexcept;
@@ -354,8 +360,12 @@ protected:
   /**
    * @brief Function which computes internal things for the vertices
    * @param[in] a_weight Vertex angle weighting
-   * @note This calls DCEL::VertexT<T, Meta>::computeVertexNormalAverage() or
-   * DCEL::VertexT<T, Meta>::computeVertexNormalAngleWeighted()
+   * @details With VertexNormalWeight::None this calls DCEL::VertexT<T, Meta>::computeVertexNormalAverage() on all
+   * vertices in parallel. With VertexNormalWeight::Angle the subtended angle at every face corner is computed once,
+   * in parallel over the faces, and gathered per vertex through a flat vertex-to-corner (CSR) adjacency built from
+   * each vertex's face list. The sums run in face-list order, so the normals match
+   * DCEL::VertexT<T, Meta>::computeVertexNormalAngleWeighted() bit for bit; vertices with a degenerate corner fall
+   * back to that function, which also reports the defect.
    */
   inline void
   reconcileVertices(const DCEL::VertexNormalWeight a_weight) noexcept;
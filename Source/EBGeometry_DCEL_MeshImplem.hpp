@@ -15,12 +15,15 @@
 #include <algorithm>
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <iostream>
 #include <limits>
 #include <map>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 // Our includes
@@ -30,6 +33,7 @@
 #include "EBGeometry_DCEL_Mesh.hpp"
 #include "EBGeometry_DCEL_Vertex.hpp"
 #include "EBGeometry_Macros.hpp"
+#include "EBGeometry_Parallel.hpp"
 
 namespace EBGeometry {
 
@@ -321,52 +325,218 @@ template <class T, class Meta>
 inline void
 MeshT<T, Meta>::reconcileFaces() noexcept
 {
-  for (auto& f : m_faces) {
-    EBGEOMETRY_EXPECT(f != nullptr);
+  Parallel::parallelFor(0, m_faces.size(), s_parallelGrainSize, [&](const size_t a_lo, const size_t a_hi) noexcept {
+    for (size_t i = a_lo; i < a_hi; i++) {
+      EBGEOMETRY_EXPECT(m_faces[i] != nullptr);
 
-    f->reconcile();
-  }
+      m_faces[i]->reconcile();
+    }
+  });
 }
 
 template <class T, class Meta>
 inline void
 MeshT<T, Meta>::reconcileEdges() noexcept
 {
-  for (auto& e : m_edges) {
-    EBGEOMETRY_EXPECT(e != nullptr);
+  Parallel::parallelFor(0, m_edges.size(), s_parallelGrainSize, [&](const size_t a_lo, const size_t a_hi) noexcept {
+    for (size_t i = a_lo; i < a_hi; i++) {
+      EBGEOMETRY_EXPECT(m_edges[i] != nullptr);
 
-    e->reconcile();
-  }
+      m_edges[i]->reconcile();
+    }
+  });
 }
 
 template <class T, class Meta>
 inline void
 MeshT<T, Meta>::reconcileVertices(const DCEL::VertexNormalWeight a_weight) noexcept
 {
-  for (auto& v : m_vertices) {
-    EBGEOMETRY_EXPECT(v != nullptr);
+  const size_t numVertices = m_vertices.size();
+  const size_t numFaces    = m_faces.size();
+  const size_t grain       = s_parallelGrainSize;
 
-    switch (a_weight) {
-    case DCEL::VertexNormalWeight::None: {
-      v->computeVertexNormalAverage();
+  switch (a_weight) {
+  case DCEL::VertexNormalWeight::None: {
+    Parallel::parallelFor(0, numVertices, grain, [&](const size_t a_lo, const size_t a_hi) noexcept {
+      for (size_t i = a_lo; i < a_hi; i++) {
+        EBGEOMETRY_EXPECT(m_vertices[i] != nullptr);
 
-      break;
-    }
-    case DCEL::VertexNormalWeight::Angle: {
-      v->computeVertexNormalAngleWeighted();
+        m_vertices[i]->computeVertexNormalAverage();
+      }
+    });
 
-      break;
-    }
-    default: {
-      std::cerr << "In file 'EBGeometry_DCEL_MeshImplem.hpp' function "
-                   "DCEL::MeshT<T, Meta>::reconcileVertices(VertexNormalWeighting) - a_weight does "
-                   "not match any of the known VertexNormalWeight enumerators; this indicates a "
-                   "corrupted or out-of-range enum value rather than a normal runtime condition.\n";
-      EBGEOMETRY_EXPECT(false);
-
-      break;
+    break;
+  }
+  case DCEL::VertexNormalWeight::Angle: {
+    using EdgeIterator = EdgeIteratorT<T, Meta>;
+
+    constexpr size_t noCorner = std::numeric_limits<size_t>::max();
+
+    EBGEOMETRY_EXPECT(numFaces < size_t(std::numeric_limits<uint32_t>::max()));
+
+    // Face index lookup: (address, index) pairs sorted by address.
+    std::vector<std::pair<const Face*, uint32_t>> faceIndices(numFaces);
+
+    Parallel::parallelFor(0, numFaces, grain, [&](const size_t a_lo, const size_t a_hi) noexcept {
+      for (size_t i = a_lo; i < a_hi; i++) {
+        faceIndices[i] = {m_faces[i].get(), static_cast<uint32_t>(i)};
+      }
+    });
+
+    const auto byAddress = [](const std::pair<const Face*, uint32_t>& a_lhs,
+                              const std::pair<const Face*, uint32_t>& a_rhs) noexcept -> bool {
+      return std::less<const Face*>()(a_lhs.first, a_rhs.first);
+    };
+
+    std::sort(faceIndices.begin(), faceIndices.end(), byAddress);
+
+    const auto faceIndex = [&](const Face* a_face) noexcept -> size_t {
+      const auto it = std::lower_bound(faceIndices.begin(), faceIndices.end(), std::make_pair(a_face, 0U), byAddress);
+
+      return (it != faceIndices.end() && it->first == a_face) ? size_t(it->second) : numFaces;
+    };
+
+    // Corners of face i are cornerOffsets[i], ..., cornerOffsets[i+1]-1, in half-edge order.
+    std::vector<size_t> cornerOffsets(numFaces + 1, 0);
+
+    Parallel::parallelFor(0, numFaces, grain, [&](const size_t a_lo, const size_t a_hi) noexcept {
+      for (size_t i = a_lo; i < a_hi; i++) {
+        for (EdgeIterator edgeIt(*m_faces[i]); edgeIt.ok(); ++edgeIt) {
+          cornerOffsets[i + 1]++;
+        }
+      }
+    });
+
+    for (size_t i = 0; i < numFaces; i++) {
+      cornerOffsets[i + 1] += cornerOffsets[i];
     }
+
+    // The subtended angle at each corner, computed exactly as VertexT::computeVertexNormalAngleWeighted() does.
+    // Corners it would reject are flagged.
+    std::vector<const Vertex*> cornerVertices(cornerOffsets.back());
+    std::vector<T>             cornerAngles(cornerOffsets.back());
+    std::vector<size_t>        cornerFaces(cornerOffsets.back());
+    std::vector<char>          cornerValid(cornerOffsets.back());
+
+    Parallel::parallelFor(0, numFaces, grain, [&](const size_t a_lo, const size_t a_hi) noexcept {
+      for (size_t i = a_lo; i < a_hi; i++) {
+        const size_t first = cornerOffsets[i];
+        const size_t N     = cornerOffsets[i + 1] - first;
+
+        size_t c = first;
+        for (EdgeIterator edgeIt(*m_faces[i]); edgeIt.ok(); ++edgeIt) {
+          cornerVertices[c++] = edgeIt()->getVertex().get();
+        }
+
+        for (size_t k = 0; k < N; k++) {
+          const Vertex* v0 = cornerVertices[first + k];
+          const Vertex* v1 = cornerVertices[first + (k + N - 1) % N];
+          const Vertex* v2 = cornerVertices[first + (k + 1) % N];
+
+          bool valid = (N >= 3) && (v0 != nullptr) && (v1 != nullptr) && (v2 != nullptr);
+          for (size_t m = 0; m < N && valid; m++) {
+            valid = (m == k) || (cornerVertices[first + m] != v0);
+          }
+
+          if (valid) {
+            const Vec3& x0 = v0->getPosition();
+            const Vec3& x1 = v1->getPosition();
+            const Vec3& x2 = v2->getPosition();
+
+            valid = (x0 != x1) && (x0 != x2) && (x1 != x2);
+
+            if (valid) {
+              Vec3 e1 = x1 - x0;
+              Vec3 e2 = x2 - x0;
+
+              e1 = e1 / e1.length();
+              e2 = e2 / e2.length();
+
+              cornerAngles[first + k] = std::acos(std::clamp(e1.dot(e2), T(-1), T(1)));
+            }
+          }
+
+          cornerFaces[first + k] = i;
+          cornerValid[first + k] = valid ? 1 : 0;
+        }
+      }
+    });
+
+    // Vertex-to-corner CSR adjacency, in the order of each vertex's face list.
+    std::vector<size_t> vertexOffsets(numVertices + 1, 0);
+
+    Parallel::parallelFor(0, numVertices, grain, [&](const size_t a_lo, const size_t a_hi) noexcept {
+      for (size_t i = a_lo; i < a_hi; i++) {
+        EBGEOMETRY_EXPECT(m_vertices[i] != nullptr);
+
+        vertexOffsets[i + 1] = m_vertices[i]->getFaces().size();
+      }
+    });
+
+    for (size_t i = 0; i < numVertices; i++) {
+      vertexOffsets[i + 1] += vertexOffsets[i];
     }
+
+    std::vector<size_t> vertexCorners(vertexOffsets.back(), noCorner);
+
+    Parallel::parallelFor(0, numVertices, grain, [&](const size_t a_lo, const size_t a_hi) noexcept {
+      for (size_t i = a_lo; i < a_hi; i++) {
+        const Vertex* v     = m_vertices[i].get();
+        const auto&   faces = m_vertices[i]->getFaces();
+
+        for (size_t j = 0; j < faces.size(); j++) {
+          const size_t f = faceIndex(faces[j].get());
+
+          if (f < numFaces) {
+            for (size_t c = cornerOffsets[f]; c < cornerOffsets[f + 1]; c++) {
+              if (cornerVertices[c] == v && cornerValid[c] != 0) {
+                vertexCorners[vertexOffsets[i] + j] = c;
+              }
+            }
+          }
+        }
+      }
+    });
+
+    Parallel::parallelFor(0, numVertices, grain, [&](const size_t a_lo, const size_t a_hi) noexcept {
+      for (size_t i = a_lo; i < a_hi; i++) {
+        auto& v = m_vertices[i];
+
+        bool valid = vertexOffsets[i + 1] > vertexOffsets[i];
+        for (size_t j = vertexOffsets[i]; j < vertexOffsets[i + 1] && valid; j++) {
+          valid = vertexCorners[j] != noCorner;
+        }
+
+        if (valid) {
+          // Same expression as the serial code, so that floating-point contraction does not differ either.
+          Vec3 normal = Vec3::zeros();
+          for (size_t j = vertexOffsets[i]; j < vertexOffsets[i + 1]; j++) {
+            const size_t c     = vertexCorners[j];
+            const T      alpha = cornerAngles[c];
+
+            normal += alpha * m_faces[cornerFaces[c]]->getNormal();
+          }
+
+          v->setNormal(normal);
+          v->normalizeNormalVector();
+        }
+        else {
+          v->computeVertexNormalAngleWeighted();
+        }
+      }
+    });
+
+    break;
+  }
+  default: {
+    std::cerr << "In file 'EBGeometry_DCEL_MeshImplem.hpp' function "
+                 "DCEL::MeshT<T, Meta>::reconcileVertices(VertexNormalWeighting) - a_weight does "
+                 "not match any of the known VertexNormalWeight enumerators; this indicates a "
+                 "corrupted or out-of-range enum value rather than a normal runtime condition.\n";
+    EBGEOMETRY_EXPECT(false);
+
+    break;
+  }
   }
 }
 
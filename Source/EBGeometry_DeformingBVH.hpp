@@ -0,0 +1,262 @@
+// SPDX-FileCopyrightText: 2026 Robert Marskar <robert.marskar@sintef.no>
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+/**
+ * @file    EBGeometry_DeformingBVH.hpp
+ * @brief   A PackedBVH for moving geometry that decides by itself when refitting is no longer enough.
+ * @author  Robert Marskar
+ */
+
+#ifndef EBGEOMETRY_DEFORMINGBVH_HPP
+#define EBGEOMETRY_DEFORMINGBVH_HPP
+
+// Std includes
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#if defined(EBGEOMETRY_ENABLE_THREADS)
+#include <thread>
+#endif
+
+// Our includes
+#include "EBGeometry_BVH.hpp"
+#include "EBGeometry_BoundingVolumes.hpp"
+
+namespace EBGeometry {
+
+namespace BVH {
+
+/**
+ * @brief Default quality threshold of DeformingBVH.
+ * @details A rebuild is started once the SAH cost of the refitted tree exceeds that of the freshly built tree by this
+ * factor.
+ */
+inline constexpr double RebuildThreshold = 1.5;
+
+/**
+ * @brief A PackedBVH over moving primitives that is refitted every step and rebuilt when refitting has degraded it.
+ * @details The primitives are held through shared pointers, and the caller moves them by modifying the objects
+ * they point to (as for PackedBVH::refit()). Each call to update() refits the tree and compares its SAH cost (see
+ * PackedBVH::computeSAHCost()) with the cost the tree had right after it was built. The SAH cost is relative to
+ * the root's surface area, so translating, rotating or uniformly scaling the geometry leaves it unchanged; it only
+ * grows when primitives move relative to each other and the node boxes start to overlap. Once the ratio exceeds
+ * the threshold the tree is rebuilt with binned SAH.
+ *
+ * In background mode the rebuild runs on a thread of its own, from the primitive boxes at the time it was started,
+ * and the refitted tree stays in use meanwhile. It is deliberately not a task on the Parallel thread pool: a thread
+ * waiting on a TaskGroup executes pending pool tasks inline, and could otherwise end up running the whole rebuild
+ * in the middle of an unrelated parallelFor(). The first update() after the rebuild has finished refits the new
+ * tree to the current geometry and swaps it in. getTree() and the swap go through the atomic shared_ptr functions,
+ * so a thread that holds a tree from getTree() keeps it alive. update() itself modifies the current tree in place
+ * and must not run concurrently with queries on it. Without EBGEOMETRY_ENABLE_THREADS, rebuilds are always done in
+ * place.
+ * @tparam T Floating-point precision.
+ * @tparam P Primitive type.
+ * @tparam K Branching factor.
+ */
+template <class T, class P, size_t K = DefaultBranchingRatio<T>()>
+class DeformingBVH
+{
+  static_assert(std::is_floating_point_v<T>, "DeformingBVH<T, P, K> requires a floating-point T");
+  static_assert(K >= 2, "DeformingBVH requires branching factor K >= 2");
+
+public:
+  /**
+   * @brief Alias for the managed tree.
+   */
+  using Tree = PackedBVH<T, P, K>;
+
+  /**
+   * @brief Alias for the bounding volume type.
+   */
+  using BV = typename Tree::BV;
+
+  /**
+   * @brief Function that returns the current bounding volume of a primitive.
+   */
+  using BVConstructor = std::function<BV(const P&)>;
+
+  /**
+   * @brief Default constructor is disallowed.
+   */
+  DeformingBVH() = delete;
+
+  /**
+   * @brief Build the initial tree.
+   * @param[in] a_primitives       Primitives. Must be non-empty and non-null.
+   * @param[in] a_bvConstructor    Returns the current bounding volume of a primitive.
+   * @param[in] a_rebuildThreshold Rebuild once the SAH cost has grown by this factor since the last build. Must be
+   * at least one.
+   * @param[in] a_background       Rebuild on a background thread while the refitted tree stays in use.
+   */
+  DeformingBVH(const std::vector<std::shared_ptr<const P>>& a_primitives,
+               const BVConstructor&                         a_bvConstructor,
+               double                                       a_rebuildThreshold = RebuildThreshold,
+               bool                                         a_background       = false);
+
+  /**
+   * @brief Disallowed -- a background rebuild refers to this object.
+   */
+  DeformingBVH(const DeformingBVH&) = delete;
+
+  /**
+   * @brief Disallowed -- a background rebuild refers to this object.
+   */
+  DeformingBVH(DeformingBVH&&) = delete;
+
+  /**
+   * @brief Disallowed -- a background rebuild refers to this object.
+   */
+  DeformingBVH&
+  operator=(const DeformingBVH&) = delete;
+
+  /**
+   * @brief Disallowed -- a background rebuild refers to this object.
+   */
+  DeformingBVH&
+  operator=(DeformingBVH&&) = delete;
+
+  /**
+   * @brief Destructor. Waits for a background rebuild to finish.
+   */
+  ~DeformingBVH();
+
+  /**
+   * @brief Bring the tree up to date with the moved primitives.
+   * @details Swaps in a finished background rebuild, or else refits the current tree and starts a rebuild if its
+   * SAH cost ratio exceeds the threshold.
+   * @return True if the tree was replaced by a rebuilt one.
+   */
+  bool
+  update();
+
+  /**
+   * @brief Wait for a background rebuild, if one is running, and swap it in.
+   * @details Rethrows an exception thrown by the rebuild, in which case the current tree stays in use.
+   * @return True if the tree was replaced.
+   */
+  bool
+  finishRebuild();
+
+  /**
+   * @brief Get the current tree.
+   * @return Shared pointer to the tree, which stays valid after a later swap.
+   */
+  [[nodiscard]] std::shared_ptr<const Tree>
+  getTree() const noexcept;
+
+  /**
+   * @brief Get the SAH cost of the tree relative to its cost right after it was built.
+   * @return Cost ratio as of the last update().
+   */
+  [[nodiscard]] double
+  getCostRatio() const noexcept;
+
+  /**
+   * @brief Get the number of rebuilds since construction.
+   * @return Number of trees swapped in by update() or finishRebuild(). The initial build does not count.
+   */
+  [[nodiscard]] size_t
+  getNumRebuilds() const noexcept;
+
+  /**
+   * @brief Check if a background rebuild is running or waiting to be swapped in.
+   * @return True if it is.
+   */
+  [[nodiscard]] bool
+  isRebuilding() const noexcept;
+
+protected:
+  /**
+   * @brief Build a tree with binned SAH.
+   * @param[in] a_primsAndBVs Primitives and their bounding volumes.
+   * @return The tree.
+   */
+  [[nodiscard]] static std::shared_ptr<Tree>
+  build(PrimAndBVList<P, BV>&& a_primsAndBVs);
+
+  /**
+   * @brief Pair every primitive of the current tree with its current bounding volume.
+   * @return Input for build().
+   */
+  [[nodiscard]] PrimAndBVList<P, BV>
+  snapshot() const;
+
+  /**
+   * @brief Make a_tree the current tree and reset the cost reference to its SAH cost.
+   * @param[in] a_tree New tree.
+   */
+  void
+  swap(const std::shared_ptr<Tree>& a_tree);
+
+  /**
+   * @brief Bounding-volume constructor.
+   */
+  BVConstructor m_bvConstructor;
+
+  /**
+   * @brief Rebuild threshold on the SAH cost ratio.
+   */
+  double m_rebuildThreshold;
+
+  /**
+   * @brief Rebuild in the background.
+   */
+  bool m_background;
+
+  /**
+   * @brief Current tree. Accessed through the atomic shared_ptr functions.
+   */
+  std::shared_ptr<Tree> m_tree;
+
+  /**
+   * @brief SAH cost of the current tree right after it was built.
+   */
+  double m_builtCost = 0.0;
+
+  /**
+   * @brief SAH cost ratio as of the last update().
+   */
+  double m_costRatio = 1.0;
+
+  /**
+   * @brief Number of rebuilds.
+   */
+  size_t m_numRebuilds = 0;
+
+#if defined(EBGEOMETRY_ENABLE_THREADS)
+  /**
+   * @brief Thread of the background rebuild. Joinable from the start of a rebuild until finishRebuild().
+   */
+  std::thread m_rebuild;
+#endif
+
+  /**
+   * @brief Tree produced by the background rebuild.
+   */
+  std::shared_ptr<Tree> m_rebuilt;
+
+  /**
+   * @brief Exception thrown by the background rebuild, if any. Rethrown from finishRebuild().
+   */
+  std::exception_ptr m_rebuildError;
+
+  /**
+   * @brief Set by the background rebuild when m_rebuilt (or m_rebuildError) is ready.
+   */
+  std::atomic<bool> m_rebuildDone{false};
+};
+
+} // namespace BVH
+
+} // namespace EBGeometry
+
+#include "EBGeometry_DeformingBVHImplem.hpp"
+
+#endif
@@ -0,0 +1,212 @@
+// SPDX-FileCopyrightText: 2026 Robert Marskar <robert.marskar@sintef.no>
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+/**
+ * @file    EBGeometry_DeformingBVHImplem.hpp
+ * @brief   Implementation of EBGeometry_DeformingBVH.hpp
+ * @author  Robert Marskar
+ */
+
+#ifndef EBGEOMETRY_DEFORMINGBVHIMPLEM_HPP
+#define EBGEOMETRY_DEFORMINGBVHIMPLEM_HPP
+
+// Std includes
+#include <exception>
+#include <utility>
+
+// Our includes
+#include "EBGeometry_DeformingBVH.hpp"
+#include "EBGeometry_Macros.hpp"
+
+namespace EBGeometry {
+
+namespace BVH {
+
+template <class T, class P, size_t K>
+inline DeformingBVH<T, P, K>::DeformingBVH(const std::vector<std::shared_ptr<const P>>& a_primitives,
+                                           const BVConstructor&                         a_bvConstructor,
+                                           const double                                 a_rebuildThreshold,
+                                           const bool                                   a_background)
+  : m_bvConstructor(a_bvConstructor),
+    m_rebuildThreshold(a_rebuildThreshold),
+    m_background(a_background)
+{
+  EBGEOMETRY_EXPECT(!a_primitives.empty());
+  EBGEOMETRY_EXPECT(a_rebuildThreshold >= 1.0);
+
+  PrimAndBVList<P, BV> primsAndBVs;
+  primsAndBVs.reserve(a_primitives.size());
+
+  for (const auto& prim : a_primitives) {
+    EBGEOMETRY_EXPECT(prim != nullptr);
+
+    primsAndBVs.emplace_back(prim, m_bvConstructor(*prim));
+  }
+
+  this->swap(build(std::move(primsAndBVs)));
+}
+
+template <class T, class P, size_t K>
+inline DeformingBVH<T, P, K>::~DeformingBVH()
+{
+#if defined(EBGEOMETRY_ENABLE_THREADS)
+  // The rebuild writes m_rebuilt and m_rebuildError, so it must be done before they are destroyed.
+  if (m_rebuild.joinable()) {
+    m_rebuild.join();
+  }
+#endif
+}
+
+template <class T, class P, size_t K>
+inline bool
+DeformingBVH<T, P, K>::update()
+{
+  if (this->isRebuilding() && m_rebuildDone.load()) {
+    return this->finishRebuild();
+  }
+
+  std::shared_ptr<Tree> tree = std::atomic_load(&m_tree);
+
+  tree->refit(m_bvConstructor);
+
+  m_costRatio = (m_builtCost > 0.0) ? tree->computeSAHCost() / m_builtCost : 1.0;
+
+  if (m_costRatio <= m_rebuildThreshold || this->isRebuilding()) {
+    return false;
+  }
+
+#if defined(EBGEOMETRY_ENABLE_THREADS)
+  if (m_background) {
+    m_rebuildDone.store(false);
+
+    m_rebuild = std::thread([this, primsAndBVs = this->snapshot()]() mutable {
+      try {
+        m_rebuilt = build(std::move(primsAndBVs));
+      }
+      catch (...) {
+        m_rebuildError = std::current_exception();
+      }
+
+      m_rebuildDone.store(true);
+    });
+
+    return false;
+  }
+#endif
+
+  this->swap(build(this->snapshot()));
+
+  m_numRebuilds++;
+
+  return true;
+}
+
+template <class T, class P, size_t K>
+inline bool
+DeformingBVH<T, P, K>::finishRebuild()
+{
+  if (!this->isRebuilding()) {
+    return false;
+  }
+
+#if defined(EBGEOMETRY_ENABLE_THREADS)
+  m_rebuild.join();
+#endif
+
+  if (m_rebuildError) {
+    std::exception_ptr error;
+
+    std::swap(error, m_rebuildError);
+
+    std::rethrow_exception(error);
+  }
+
+  // The rebuild started from the boxes of an earlier step.
+  m_rebuilt->refit(m_bvConstructor);
+
+  this->swap(m_rebuilt);
+
+  m_rebuilt.reset();
+  m_numRebuilds++;
+
+  return true;
+}
+
+template <class T, class P, size_t K>
+inline std::shared_ptr<const typename DeformingBVH<T, P, K>::Tree>
+DeformingBVH<T, P, K>::getTree() const noexcept
+{
+  return std::atomic_load(&m_tree);
+}
+
+template <class T, class P, size_t K>
+inline double
+DeformingBVH<T, P, K>::getCostRatio() const noexcept
+{
+  return m_costRatio;
+}
+
+template <class T, class P, size_t K>
+inline size_t
+DeformingBVH<T, P, K>::getNumRebuilds() const noexcept
+{
+  return m_numRebuilds;
+}
+
+template <class T, class P, size_t K>
+inline bool
+DeformingBVH<T, P, K>::isRebuilding() const noexcept
+{
+#if defined(EBGEOMETRY_ENABLE_THREADS)
+  return m_rebuild.joinable();
+#else
+  return false;
+#endif
+}
+
+template <class T, class P, size_t K>
+inline std::shared_ptr<typename DeformingBVH<T, P, K>::Tree>
+DeformingBVH<T, P, K>::build(PrimAndBVList<P, BV>&& a_primsAndBVs)
+{
+  TreeBVH<T, P, BV, K> root(std::move(a_primsAndBVs));
+
+  root.topDownSortAndPartition(BinnedSAHPartitioner<T, P, BV, K>, DefaultLeafPredicate<T, P, BV, K>);
+
+  return root.pack();
+}
+
+template <class T, class P, size_t K>
+inline PrimAndBVList<P, typename DeformingBVH<T, P, K>::BV>
+DeformingBVH<T, P, K>::snapshot() const
+{
+  const std::shared_ptr<const Tree> tree       = std::atomic_load(&m_tree);
+  const auto&                       primitives = tree->getPrimitives();
+
+  PrimAndBVList<P, BV> primsAndBVs;
+  primsAndBVs.reserve(primitives.size());
+
+  for (const auto& prim : primitives) {
+    primsAndBVs.emplace_back(prim, m_bvConstructor(*prim));
+  }
+
+  return primsAndBVs;
+}
+
+template <class T, class P, size_t K>
+inline void
+DeformingBVH<T, P, K>::swap(const std::shared_ptr<Tree>& a_tree)
+{
+  EBGEOMETRY_EXPECT(a_tree != nullptr);
+
+  std::atomic_store(&m_tree, a_tree);
+
+  m_builtCost = a_tree->computeSAHCost();
+  m_costRatio = 1.0;
+}
+
+} // namespace BVH
+
+} // namespace EBGeometry
+
+#endif
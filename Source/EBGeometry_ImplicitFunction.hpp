@@ -12,11 +12,13 @@
 #define EBGEOMETRY_IMPLICITFUNCTION_HPP
 
 // Std includes
+#include <cstddef>
 #include <type_traits>
 #include <vector>
 
 // Our includes
 #include "EBGeometry_BoundingVolumes.hpp"
+#include "EBGeometry_Parallel.hpp"
 #include "EBGeometry_Vec.hpp"
 
 namespace EBGeometry {
@@ -59,6 +61,45 @@ public:
   [[nodiscard]] T
   operator()(const Vec3T<T>& a_point) const noexcept;
 
+  /**
+   * @brief Batched value function. Evaluates the implicit function at a contiguous array of points.
+   * @details The default implementation simply loops over value(). Composite functions (CSG nodes, transforms,
+   * BVH-accelerated unions, mesh distance functions) override this so that a whole array is pushed through each
+   * node of the function graph at once: one virtual dispatch per node per batch rather than per point, and the
+   * node's own data (child pointers, BVH root, transform parameters) stays hot in cache while it works through the
+   * array. Results are identical to calling value() point by point.
+   * @param[in]  a_points    Query points (a_numPoints entries).
+   * @param[out] a_values    Function values at a_points (a_numPoints entries).
+   * @param[in]  a_numPoints Number of query points.
+   */
+  virtual void
+  values(const Vec3T<T>* a_points, T* a_values, std::size_t a_numPoints) const noexcept;
+
+  /**
+   * @brief Number of points composite overrides of values() hand to a child function per call.
+   * @details Bounds the stack-allocated scratch buffers (transformed points, intermediate child values) used by the
+   * CSG nodes and transforms, so batched evaluation never allocates and the working set stays in L1/L2.
+   */
+  static constexpr std::size_t s_batchChunkSize = 256;
+
+  /**
+   * @brief Batched value function, run in parallel on EBGeometry's thread pool.
+   * @details Splits the array into blocks of at least s_parallelGrainSize points and calls values() on the blocks
+   * concurrently (see Parallel::parallelFor()). Results are identical to values(). Requires values() to be safe to
+   * call concurrently, which holds for every function in EBGeometry; user-defined subclasses that keep mutable
+   * state must not use this.
+   * @param[in]  a_points    Query points (a_numPoints entries).
+   * @param[out] a_values    Function values at a_points (a_numPoints entries).
+   * @param[in]  a_numPoints Number of query points.
+   */
+  void
+  parallelValues(const Vec3T<T>* a_points, T* a_values, std::size_t a_numPoints) const;
+
+  /**
+   * @brief Smallest number of points parallelValues() hands to one values() call.
+   */
+  static constexpr std::size_t s_parallelGrainSize = 1024;
+
   /**
    * @brief Compute an approximation to the bounding volume for the implicit surface using octree subdivision.
    * @details Recursively subdivides the initial box and marks each child cell as intersected when
@@ -24,6 +24,7 @@
 #include "EBGeometry_ImplicitFunction.hpp"
 #include "EBGeometry_Macros.hpp"
 #include "EBGeometry_Octree.hpp"
+#include "EBGeometry_Parallel.hpp"
 #include "EBGeometry_Vec.hpp"
 
 namespace EBGeometry {
@@ -39,6 +40,30 @@ ImplicitFunction<T>::operator()(const Vec3T<T>& a_point) const noexcept
   return this->value(a_point);
 }
 
+template <class T>
+void
+ImplicitFunction<T>::values(const Vec3T<T>* a_points, T* a_values, std::size_t a_numPoints) const noexcept
+{
+  EBGEOMETRY_EXPECT(a_numPoints == 0 || a_points != nullptr);
+  EBGEOMETRY_EXPECT(a_numPoints == 0 || a_values != nullptr);
+
+  for (std::size_t i = 0; i < a_numPoints; i++) {
+    a_values[i] = this->value(a_points[i]);
+  }
+}
+
+template <class T>
+void
+ImplicitFunction<T>::parallelValues(const Vec3T<T>* a_points, T* a_values, std::size_t a_numPoints) const
+{
+  EBGEOMETRY_EXPECT(a_numPoints == 0 || a_points != nullptr);
+  EBGEOMETRY_EXPECT(a_numPoints == 0 || a_values != nullptr);
+
+  Parallel::parallelFor(0, a_numPoints, s_parallelGrainSize, [&](std::size_t a_lo, std::size_t a_hi) {
+    this->values(a_points + a_lo, a_values + a_lo, a_hi - a_lo);
+  });
+}
+
 template <class T>
 template <class BV>
 BV
@@ -0,0 +1,196 @@
+// SPDX-FileCopyrightText: 2026 Robert Marskar <robert.marskar@sintef.no>
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+/**
+ * @file    EBGeometry_InstancedSDF.hpp
+ * @brief   Signed distance to many placed copies of a few shared triangle meshes, through a two-level BVH.
+ * @author  Robert Marskar
+ */
+
+#ifndef EBGEOMETRY_INSTANCEDSDF_HPP
+#define EBGEOMETRY_INSTANCEDSDF_HPP
+
+// Std includes
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+// Our includes
+#include "EBGeometry_BVH.hpp"
+#include "EBGeometry_BoundingVolumes.hpp"
+#include "EBGeometry_SignedDistanceFunction.hpp"
+#include "EBGeometry_Vec.hpp"
+
+namespace EBGeometry {
+
+/**
+ * @brief Placement of one instance: a rotation, a uniform scale and a translation.
+ * @details Maps a point y in the instance's own (local) space to world space as x = s R y + t. Only rotations,
+ * uniform scaling and translations are supported because they are the transformations that preserve distances up
+ * to the factor s, so a local signed distance d is exactly the world distance s d. A shear or a non-uniform scale
+ * would turn the local distance into a bound only.
+ * @tparam T Floating-point precision.
+ */
+template <class T>
+class InstanceTransform
+{
+  static_assert(std::is_floating_point_v<T>, "InstanceTransform<T> requires a floating-point T");
+
+public:
+  /**
+   * @brief Identity transform.
+   */
+  InstanceTransform() noexcept;
+
+  /**
+   * @brief Full constructor.
+   * @details The rotation is applied first, then the scale, then the translation.
+   * @param[in] a_translation Translation t.
+   * @param[in] a_axis        Rotation axis. Need not be normalized, but must be nonzero.
+   * @param[in] a_angle       Rotation angle about a_axis, in degrees (counter-clockwise, right-hand rule).
+   * @param[in] a_scale       Uniform scale factor s. Must be positive.
+   */
+  InstanceTransform(const Vec3T<T>& a_translation,
+                    const Vec3T<T>& a_axis  = Vec3T<T>::unit(2),
+                    const T         a_angle = T(0),
+                    const T         a_scale = T(1)) noexcept;
+
+  /**
+   * @brief Map a world-space point into the instance's local space, y = R^T (x - t) / s.
+   * @param[in] a_point World-space point.
+   * @return The point in local space.
+   */
+  [[nodiscard]] Vec3T<T>
+  toLocal(const Vec3T<T>& a_point) const noexcept;
+
+  /**
+   * @brief Map a local-space point into world space, x = s R y + t.
+   * @param[in] a_point Local-space point.
+   * @return The point in world space.
+   */
+  [[nodiscard]] Vec3T<T>
+  toWorld(const Vec3T<T>& a_point) const noexcept;
+
+  /**
+   * @brief Get the uniform scale factor.
+   * @return s.
+   */
+  [[nodiscard]] T
+  getScale() const noexcept;
+
+  /**
+   * @brief Compute the world-space AABB enclosing a local-space AABB.
+   * @param[in] a_box Local-space box.
+   * @return The smallest AABB enclosing the eight transformed corners of a_box.
+   */
+  [[nodiscard]] BoundingVolumes::AABBT<T>
+  toWorld(const BoundingVolumes::AABBT<T>& a_box) const noexcept;
+
+protected:
+  /**
+   * @brief Rows of the rotation matrix R.
+   */
+  std::array<Vec3T<T>, 3> m_rotation;
+
+  /**
+   * @brief Translation t.
+   */
+  Vec3T<T> m_translation;
+
+  /**
+   * @brief Uniform scale factor s.
+   */
+  T m_scale;
+};
+
+/**
+ * @brief Signed distance to a scene built from placed copies (instances) of a few shared meshes.
+ * @details Each instance holds a shared_ptr to a bottom-level mesh and an InstanceTransform. A top-level PackedBVH
+ * is built over the instances' world-space boxes; a query traverses it, maps the point into the local space of each
+ * instance it reaches, and continues into that instance's own BVH with the current distance as the pruning bound
+ * (see TriMeshSDF::boundedSignedDistance()). Memory is proportional to the unique geometry plus one transform per
+ * instance, and no virtual call is made per instance.
+ *
+ * The result is the signed distance to the nearest triangle of any instance, exactly as if every instance's
+ * triangles had been transformed and collected into one mesh. Overlapping instances are therefore not merged into
+ * a union: use UnionIF/BVHUnionIF when instances intersect each other.
+ * @tparam T    Floating-point precision.
+ * @tparam Mesh Bottom-level mesh type, e.g. TriMeshSDF. Must provide boundedSignedDistance() and
+ * computeBoundingVolume().
+ * @tparam K    Branching factor of the top-level BVH.
+ */
+template <class T, class Mesh, size_t K = BVH::DefaultBranchingRatio<T>()>
+class InstancedSDF : public SignedDistanceFunction<T>
+{
+  static_assert(std::is_floating_point_v<T>, "InstancedSDF<T, Mesh, K> requires a floating-point T");
+  static_assert(K >= 2, "InstancedSDF requires branching factor K >= 2");
+
+public:
+  /**
+   * @brief One placed copy of a mesh.
+   */
+  struct Instance
+  {
+    std::shared_ptr<const Mesh> mesh;      ///< Shared bottom-level mesh.
+    InstanceTransform<T>        transform; ///< Placement of the mesh in world space.
+  };
+
+  /**
+   * @brief Alias for the top-level BVH over the instances.
+   */
+  using Root = BVH::PackedBVH<T, Instance, K, BVH::ValueStorage<Instance>>;
+
+  /**
+   * @brief Default constructor is disallowed.
+   */
+  InstancedSDF() = delete;
+
+  /**
+   * @brief Build the top-level BVH over a list of instances.
+   * @details The top-level tree is built with binned SAH over the instances' world-space boxes.
+   * @param[in] a_instances Instances. Must be non-empty, and every mesh must be non-null.
+   */
+  explicit InstancedSDF(const std::vector<Instance>& a_instances) noexcept;
+
+  /**
+   * @brief Destructor.
+   */
+  ~InstancedSDF() override = default;
+
+  /**
+   * @brief Signed distance to the nearest instance surface.
+   * @param[in] a_point Query point.
+   * @return Signed distance; negative inside the nearest instance.
+   */
+  [[nodiscard]] T
+  signedDistance(const Vec3T<T>& a_point) const noexcept override;
+
+  /**
+   * @brief Get the top-level BVH.
+   * @return Const reference to the shared-pointer owning the top-level BVH.
+   */
+  [[nodiscard]] const std::shared_ptr<Root>&
+  getRoot() const noexcept;
+
+  /**
+   * @brief Compute the AABB enclosing every instance.
+   * @return World-space bounding box of the scene.
+   */
+  [[nodiscard]] BoundingVolumes::AABBT<T>
+  computeBoundingVolume() const noexcept;
+
+protected:
+  /**
+   * @brief Top-level BVH over the instances' world-space boxes.
+   */
+  std::shared_ptr<Root> m_bvh;
+};
+
+} // namespace EBGeometry
+
+#include "EBGeometry_InstancedSDFImplem.hpp"
+
+#endif
@@ -0,0 +1,181 @@
+// SPDX-FileCopyrightText: 2026 Robert Marskar <robert.marskar@sintef.no>
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+/**
+ * @file    EBGeometry_InstancedSDFImplem.hpp
+ * @brief   Implementation of EBGeometry_InstancedSDF.hpp
+ * @author  Robert Marskar
+ */
+
+#ifndef EBGEOMETRY_INSTANCEDSDFIMPLEM_HPP
+#define EBGEOMETRY_INSTANCEDSDFIMPLEM_HPP
+
+// Std includes
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+// Our includes
+#include "EBGeometry_Constants.hpp"
+#include "EBGeometry_InstancedSDF.hpp"
+#include "EBGeometry_Macros.hpp"
+
+namespace EBGeometry {
+
+template <class T>
+InstanceTransform<T>::InstanceTransform() noexcept
+  : m_rotation{Vec3T<T>::unit(0), Vec3T<T>::unit(1), Vec3T<T>::unit(2)},
+    m_translation(Vec3T<T>::zeros()),
+    m_scale(T(1))
+{}
+
+template <class T>
+InstanceTransform<T>::InstanceTransform(const Vec3T<T>& a_translation,
+                                        const Vec3T<T>& a_axis,
+                                        const T         a_angle,
+                                        const T         a_scale) noexcept
+  : m_translation(a_translation),
+    m_scale(a_scale)
+{
+  EBGEOMETRY_EXPECT(a_axis.length() > T(0));
+  EBGEOMETRY_EXPECT(std::isfinite(a_angle));
+  EBGEOMETRY_EXPECT(a_scale > T(0));
+
+  // Rodrigues' rotation formula about the unit axis n.
+  const Vec3T<T> n = a_axis / a_axis.length();
+
+  const T theta = a_angle * pi<T> / T(180);
+  const T c     = std::cos(theta);
+  const T s     = std::sin(theta);
+  const T C     = T(1) - c;
+
+  m_rotation[0] = Vec3T<T>(c + n[0] * n[0] * C, n[0] * n[1] * C - n[2] * s, n[0] * n[2] * C + n[1] * s);
+  m_rotation[1] = Vec3T<T>(n[1] * n[0] * C + n[2] * s, c + n[1] * n[1] * C, n[1] * n[2] * C - n[0] * s);
+  m_rotation[2] = Vec3T<T>(n[2] * n[0] * C - n[1] * s, n[2] * n[1] * C + n[0] * s, c + n[2] * n[2] * C);
+}
+
+template <class T>
+Vec3T<T>
+InstanceTransform<T>::toLocal(const Vec3T<T>& a_point) const noexcept
+{
+  const Vec3T<T> d = (a_point - m_translation) / m_scale;
+
+  return d[0] * m_rotation[0] + d[1] * m_rotation[1] + d[2] * m_rotation[2];
+}
+
+template <class T>
+Vec3T<T>
+InstanceTransform<T>::toWorld(const Vec3T<T>& a_point) const noexcept
+{
+  const Vec3T<T> r(m_rotation[0].dot(a_point), m_rotation[1].dot(a_point), m_rotation[2].dot(a_point));
+
+  return m_scale * r + m_translation;
+}
+
+template <class T>
+T
+InstanceTransform<T>::getScale() const noexcept
+{
+  return m_scale;
+}
+
+template <class T>
+BoundingVolumes::AABBT<T>
+InstanceTransform<T>::toWorld(const BoundingVolumes::AABBT<T>& a_box) const noexcept
+{
+  const Vec3T<T>& lo = a_box.getLowCorner();
+  const Vec3T<T>& hi = a_box.getHighCorner();
+
+  std::vector<Vec3T<T>> corners;
+  corners.reserve(8);
+
+  for (int i = 0; i < 8; i++) {
+    const Vec3T<T> corner((i & 1) != 0 ? hi[0] : lo[0], (i & 2) != 0 ? hi[1] : lo[1], (i & 4) != 0 ? hi[2] : lo[2]);
+
+    corners.emplace_back(this->toWorld(corner));
+  }
+
+  return BoundingVolumes::AABBT<T>(corners);
+}
+
+template <class T, class Mesh, size_t K>
+InstancedSDF<T, Mesh, K>::InstancedSDF(const std::vector<Instance>& a_instances) noexcept
+{
+  EBGEOMETRY_EXPECT(!a_instances.empty());
+
+  using AABB = BoundingVolumes::AABBT<T>;
+
+  std::vector<std::pair<Instance, AABB>> primsAndBVs;
+  primsAndBVs.reserve(a_instances.size());
+
+  for (const Instance& instance : a_instances) {
+    EBGEOMETRY_EXPECT(instance.mesh != nullptr);
+
+    primsAndBVs.emplace_back(instance, instance.transform.toWorld(instance.mesh->computeBoundingVolume()));
+  }
+
+  m_bvh = std::make_shared<Root>(std::move(primsAndBVs),
+                                 BVH::BinnedSAHPartitioner<T, Instance, AABB, K>,
+                                 BVH::DefaultLeafPredicate<T, Instance, AABB, K>);
+}
+
+template <class T, class Mesh, size_t K>
+T
+InstancedSDF<T, Mesh, K>::signedDistance(const Vec3T<T>& a_point) const noexcept
+{
+  EBGEOMETRY_EXPECT(m_bvh != nullptr);
+  EBGEOMETRY_EXPECT(std::isfinite(a_point[0]));
+  EBGEOMETRY_EXPECT(std::isfinite(a_point[1]));
+  EBGEOMETRY_EXPECT(std::isfinite(a_point[2]));
+
+  T           minDist   = std::numeric_limits<T>::max();
+  const auto* instances = m_bvh->getPrimitiveData();
+
+  // Each instance continues the search in its own local space, with the current world distance (converted to local
+  // units) as the bound, so its bottom-level traversal skips everything that cannot improve on what was found.
+  const auto evalLeaf = [instances, &a_point](T& a_state, size_t a_offset, size_t a_count) noexcept {
+    for (size_t i = a_offset; i < a_offset + a_count; i++) {
+      const Instance& instance = instances[i];
+
+      const T scale = instance.transform.getScale();
+      const T bound = std::min(std::abs(a_state) / scale, std::numeric_limits<T>::max());
+      const T d     = instance.mesh->boundedSignedDistance(instance.transform.toLocal(a_point), bound);
+
+      EBGEOMETRY_EXPECT(!std::isnan(d));
+
+      if (std::abs(d) < bound) {
+        a_state = scale * d;
+      }
+    }
+  };
+
+  const auto pruneDist2 = [](const T& a_state) noexcept -> T { return a_state * a_state; };
+
+  m_bvh->pruneTraverse(a_point, minDist, evalLeaf, pruneDist2);
+
+  return minDist;
+}
+
+template <class T, class Mesh, size_t K>
+const std::shared_ptr<typename InstancedSDF<T, Mesh, K>::Root>&
+InstancedSDF<T, Mesh, K>::getRoot() const noexcept
+{
+  EBGEOMETRY_EXPECT(m_bvh != nullptr);
+
+  return m_bvh;
+}
+
+template <class T, class Mesh, size_t K>
+BoundingVolumes::AABBT<T>
+InstancedSDF<T, Mesh, K>::computeBoundingVolume() const noexcept
+{
+  EBGEOMETRY_EXPECT(m_bvh != nullptr);
+
+  return m_bvh->getBoundingVolume();
+}
+
+} // namespace EBGeometry
+
+#endif
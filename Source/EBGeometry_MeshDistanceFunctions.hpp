@@ -16,6 +16,7 @@
 #include <cstdint>
 #include <limits>
 #include <memory>
+#include <string>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -23,6 +24,7 @@
 // Our includes
 #include "EBGeometry_BVH.hpp"
 #include "EBGeometry_BoundingVolumes.hpp"
+#include "EBGeometry_DCEL_IndexedMesh.hpp"
 #include "EBGeometry_DCEL_Mesh.hpp"
 #include "EBGeometry_SignedDistanceFunction.hpp"
 #include "EBGeometry_Triangle.hpp"
@@ -162,15 +164,20 @@ public:
    */
   using Mesh = typename EBGeometry::DCEL::MeshT<T, Meta>;
 
+  /**
+   * @brief Alias for index-based DCEL mesh type
+   */
+  using IndexedMesh = typename EBGeometry::DCEL::IndexedMeshT<T, Meta>;
+
   /**
    * @brief Alias for the linearized BVH root
    */
   using Root = EBGeometry::BVH::PackedBVH<T, Face, K>;
 
   /**
-   * @brief Alias for a single linearized node
+   * @brief Alias for the node description handed to the traversal callbacks
    */
-  using Node = typename Root::Node;
+  using Node = typename Root::NodeView;
 
   /**
    * @brief Default disallowed constructor
@@ -183,10 +190,20 @@ public:
    * level must consciously choose a build strategy. Use Parser::readIntoPackedBVH for sensible
    * defaults.
    * @param[in] a_mesh   Input mesh.
-   * @param[in] a_build  BVH build strategy. SAH (binned Surface Area Heuristic) is recommended.
+   * @param[in] a_build  BVH build strategy. SAH (binned Surface Area Heuristic) is recommended; PLOC builds
+   * faster at close to SAH quality; SBVH gives tighter trees for meshes with long, thin faces.
    */
   MeshSDF(const std::shared_ptr<Mesh>& a_mesh, const BVH::Build a_build);
 
+  /**
+   * @brief Constructor from an index-based DCEL mesh.
+   * @details The BVH primitives are DCEL faces, so this builds the linked mesh with IndexedMeshT::toMesh() first.
+   * Use TriMeshSDF for triangle meshes, which reads the index arrays directly.
+   * @param[in] a_mesh   Input mesh.
+   * @param[in] a_build  BVH build strategy.
+   */
+  MeshSDF(const std::shared_ptr<IndexedMesh>& a_mesh, const BVH::Build a_build);
+
   /**
    * @brief Destructor
    */
@@ -232,10 +249,34 @@ public:
   [[nodiscard]] T
   signedDistance(const Vec3T<T>& a_point) const noexcept override;
 
+  /**
+   * @brief Batched signed distance to the mesh.
+   * @details Carries the points through the BVH in packets of s_packetSize consecutive points (see
+   * PackedBVH::packetPruneTraverse()), so each node and its child boxes are loaded once per packet. Each point is
+   * still pruned against its own running distance, exactly as in signedDistance().
+   *
+   * Results are identical to signedDistance(): the faces are visited in a different order, but exact ties go to
+   * the lower-indexed face in both, so points equidistant from several faces (e.g. at a sharp edge) get the same
+   * sign.
+   * @param[in]  a_points    Query points (a_numPoints entries).
+   * @param[out] a_values    Signed distances at a_points (a_numPoints entries).
+   * @param[in]  a_numPoints Number of query points.
+   */
+  void
+  values(const Vec3T<T>* a_points, T* a_values, std::size_t a_numPoints) const noexcept override;
+
+  /**
+   * @brief Number of consecutive points values() carries through the BVH as one packet.
+   * @details See PackedBVH::packetPruneTraverse(). Callers get the most out of values() by ordering their points
+   * in small spatially compact blocks of this size (e.g. 4x4x4 blocks of grid cells).
+   */
+  static constexpr std::size_t s_packetSize = 16;
+
   /**
    * @brief Return faces within BVH-pruned candidate distance of a_point.
    * @details Traverses the PackedBVH and collects candidate faces.  The
-   * result pairs each face with its unsigned distance to a_point.
+   * result pairs each face with its unsigned distance to a_point. Each face
+   * appears at most once, also when an SBVH build put it into several leaves.
    * @param[in] a_point  Query point.
    * @param[in] a_sorted If true, the returned vector is sorted by ascending
    * unsigned distance (closest face first).
@@ -265,6 +306,14 @@ public:
   [[nodiscard]] EBGeometry::BoundingVolumes::AABBT<T>
   computeBoundingVolume() const noexcept;
 
+  /**
+   * @brief Compute quality metrics of the BVH over the faces.
+   * @details Forwards to PackedBVH::computeMetrics(); primitives are faces.
+   * @return SAH cost, effective parent overlap, leaf depths and leaf fill.
+   */
+  [[nodiscard]] BVH::TreeMetrics
+  computeMetrics() const;
+
 protected:
   /**
    * @brief Linearized BVH
@@ -323,6 +372,11 @@ public:
    */
   using Mesh = EBGeometry::DCEL::MeshT<T, Meta>;
 
+  /**
+   * @brief Alias for index-based DCEL mesh type
+   */
+  using IndexedMesh = EBGeometry::DCEL::IndexedMeshT<T, Meta>;
+
   /**
    * @brief Alias for DCEL face type
    */
@@ -362,7 +416,10 @@ public:
    * defaults.
    * @param[in] a_mesh          DCEL mesh.
    * @param[in] a_build         BVH build strategy. SAH (binned Surface Area Heuristic) produces
-   * near-optimal traversal cost; TopDown (centroid median) is faster to build but yields deeper trees.
+   * near-optimal traversal cost; TopDown (centroid median) is faster to build but yields deeper trees. PLOC
+   * (bottom-up clustering) builds much faster than SAH, in parallel, at close to SAH quality. SBVH (SAH with
+   * spatial splits) builds slower than SAH but gives tighter trees for meshes with long, thin triangles; a
+   * triangle may then appear in more than one leaf.
    * @param[in] a_maxLeafGroups Maximum number of full W-sized TriangleSoA groups per BVH leaf; the
    * actual raw-triangle leaf-size bound used is a_maxLeafGroups * W. This bounds the pre-packing
    * tree's leaf size, not the packed representation directly: each leaf's triangles become their
@@ -375,6 +432,16 @@ public:
    */
   TriMeshSDF(const std::shared_ptr<Mesh>& a_mesh, const BVH::Build a_build, const size_t a_maxLeafGroups) noexcept;
 
+  /**
+   * @brief Full constructor from an index-based DCEL mesh. Reads the triangles straight from the mesh arrays.
+   * @param[in] a_mesh          Index-based DCEL mesh. Must be triangulated.
+   * @param[in] a_build         BVH build strategy (see the mesh-based constructor for details).
+   * @param[in] a_maxLeafGroups Maximum number of full W-sized TriangleSoA groups per BVH leaf. Must be > 0.
+   */
+  TriMeshSDF(const std::shared_ptr<IndexedMesh>& a_mesh,
+             const BVH::Build                    a_build,
+             const size_t                        a_maxLeafGroups) noexcept;
+
   /**
    * @brief Full constructor. Takes the input triangles and creates the BVH.
    * @param[in] a_triangles     Input triangle soup.
@@ -386,6 +453,12 @@ public:
              const BVH::Build                         a_build,
              const size_t                             a_maxLeafGroups) noexcept;
 
+  /**
+   * @brief Construct from an already built BVH, e.g. one read by Root::load().
+   * @param[in] a_root Packed BVH over SoA triangle groups. Must not be nullptr.
+   */
+  explicit TriMeshSDF(const std::shared_ptr<Root>& a_root) noexcept;
+
   /**
    * @brief Destructor
    */
@@ -431,6 +504,41 @@ public:
   [[nodiscard]] T
   signedDistance(const Vec3T<T>& a_point) const noexcept override;
 
+  /**
+   * @brief Signed distance to the triangle mesh, if it is closer than a known bound.
+   * @details The traversal starts with @p a_bound as its pruning distance instead of infinity, so a caller that
+   * already knows a closer surface (e.g. InstancedSDF, which visits several meshes per query) skips every node
+   * and triangle farther away than that.
+   * @param[in] a_point Query point.
+   * @param[in] a_bound Distance bound. Must be positive.
+   * @return The signed distance if its magnitude is smaller than @p a_bound, otherwise @p a_bound.
+   */
+  [[nodiscard]] T
+  boundedSignedDistance(const Vec3T<T>& a_point, const T a_bound) const noexcept;
+
+  /**
+   * @brief Batched signed distance to the triangle mesh.
+   * @details Carries the points through the BVH in packets of s_packetSize consecutive points (see
+   * PackedBVH::packetPruneTraverse()), so each node and its child boxes are loaded once per packet. Each point is
+   * still pruned against its own running distance, exactly as in signedDistance().
+   *
+   * Results are identical to signedDistance(): the triangle groups are visited in a different order, but exact ties
+   * go to the lower-indexed group in both, so points equidistant from several triangles (e.g. at a sharp edge) get
+   * the same sign.
+   * @param[in]  a_points    Query points (a_numPoints entries).
+   * @param[out] a_values    Signed distances at a_points (a_numPoints entries).
+   * @param[in]  a_numPoints Number of query points.
+   */
+  void
+  values(const Vec3T<T>* a_points, T* a_values, std::size_t a_numPoints) const noexcept override;
+
+  /**
+   * @brief Number of consecutive points values() carries through the BVH as one packet.
+   * @details See PackedBVH::packetPruneTraverse(). Callers get the most out of values() by ordering their points
+   * in small spatially compact blocks of this size (e.g. 4x4x4 blocks of grid cells).
+   */
+  static constexpr std::size_t s_packetSize = 16;
+
   /**
    * @brief Signed distance to the closest triangle, together with that triangle's metadata.
    * @details The metadata-retrieving companion to signedDistance(): it drives the same SIMD-pruned
@@ -466,6 +574,44 @@ public:
   [[nodiscard]] EBGeometry::BoundingVolumes::AABBT<T>
   computeBoundingVolume() const noexcept;
 
+  /**
+   * @brief Compute quality metrics of the BVH over the triangle groups.
+   * @details Forwards to PackedBVH::computeMetrics(). Primitives are the SoA triangle groups of up to W triangles,
+   * so the leaf fill counts groups, not triangles.
+   * @return SAH cost, effective parent overlap, leaf depths and leaf fill.
+   */
+  [[nodiscard]] BVH::TreeMetrics
+  computeMetrics() const;
+
+  /**
+   * @brief Write the BVH, triangles included, to a binary file that load() reads back without a rebuild.
+   * @details Forwards to PackedBVH::save(); see there for the format. Requires the default BVH::ValueStorage.
+   * @param[in] a_filename File name. An existing file is overwritten.
+   * @return True on success, false (with a message on std::cerr) otherwise.
+   */
+  bool
+  save(const std::string& a_filename) const;
+
+  /**
+   * @brief Read a TriMeshSDF from a binary file written by save().
+   * @details Skips parsing, DCEL construction and the BVH build entirely: the file is read in bulk by
+   * PackedBVH::load(). The file must have been written with the same T, Meta, K and W.
+   * @param[in] a_filename File name.
+   * @return The signed distance function, or nullptr (with a message on std::cerr) on failure.
+   */
+  [[nodiscard]] static std::shared_ptr<TriMeshSDF>
+  load(const std::string& a_filename);
+
+  /**
+   * @brief Map a binary file written by save() into memory and query it in place.
+   * @details Forwards to PackedBVH::map(): nothing is read up front, and every process that maps the same file shares
+   * one physical copy of the BVH and its triangles. The BVH is read-only, so it cannot be refitted or optimized.
+   * @param[in] a_filename File name.
+   * @return The signed distance function, or nullptr (with a message on std::cerr) on failure.
+   */
+  [[nodiscard]] static std::shared_ptr<TriMeshSDF>
+  map(const std::string& a_filename);
+
 protected:
   /**
    * @brief Bounding volume hierarchy storing SoA triangle groups.
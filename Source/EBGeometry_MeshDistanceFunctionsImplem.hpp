@@ -21,12 +21,14 @@
 #include <limits>
 #include <memory>
 #include <type_traits>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
 // Our includes
 #include "EBGeometry_DCEL_Edge.hpp"
 #include "EBGeometry_DCEL_Face.hpp"
+#include "EBGeometry_DCEL_IndexedMesh.hpp"
 #include "EBGeometry_DCEL_Mesh.hpp"
 #include "EBGeometry_DCEL_Vertex.hpp"
 #include "EBGeometry_Macros.hpp"
@@ -48,7 +50,7 @@ namespace MeshDistanceFunctionsDetail {
  * @tparam BV   Bounding-volume type (e.g. AABBT<T>).
  * @tparam K    BVH branching factor (number of children per node).
  * @param[in] a_dcelMesh Input DCEL mesh.
- * @param[in] a_build    Build strategy (TopDown, Morton, Nested, or SAH). SAH is the default.
+ * @param[in] a_build    Build strategy (TopDown, Morton, Nested, SAH, PLOC, or SBVH). SAH is the default.
  * @return Shared pointer to the root of the resulting tree BVH.
  */
 template <class T, class Meta, class BV, size_t K>
@@ -104,6 +106,20 @@ buildDCELTreeBVH(const std::shared_ptr<EBGeometry::DCEL::MeshT<T, Meta>>& a_dcel
 
     break;
   }
+  case BVH::Build::PLOC: {
+    bvh->plocSortAndPartition();
+
+    break;
+  }
+  case BVH::Build::SBVH: {
+    const auto polygon = [](const Prim& a_face, std::vector<Vec3T<T>>& a_vertices) {
+      a_vertices = a_face.getAllVertexCoordinates();
+    };
+
+    bvh->spatialSortAndPartition(polygon);
+
+    break;
+  }
   default: {
     std::cerr << "EBGeometry::MeshDistanceFunctionsDetail::buildDCELTreeBVH - unsupported build method requested"
               << '\n';
@@ -125,7 +141,7 @@ buildDCELTreeBVH(const std::shared_ptr<EBGeometry::DCEL::MeshT<T, Meta>>& a_dcel
  * @tparam BV   Bounding-volume type (e.g. AABBT<T>).
  * @tparam K    BVH branching factor (number of children per internal node).
  * @param[in] a_triangles   Triangle soup to build the BVH over.
- * @param[in] a_build       Build strategy (TopDown, Morton, Nested, or SAH).
+ * @param[in] a_build       Build strategy (TopDown, Morton, Nested, SAH, PLOC, or SBVH).
  * @param[in] a_maxLeafSize Maximum number of triangles per BVH leaf node
  * (ignored for Morton and Nested builds).
  * @return Shared pointer to the root of the resulting tree BVH.
@@ -194,6 +210,22 @@ buildTriTreeBVH(const std::vector<std::shared_ptr<EBGeometry::Triangle<T, Meta>>
 
     break;
   }
+  case BVH::Build::PLOC: {
+    bvh->plocSortAndPartition(a_maxLeafSize);
+
+    break;
+  }
+  case BVH::Build::SBVH: {
+    const auto polygon = [](const Prim& a_triangle, std::vector<Vec3T<T>>& a_vertices) {
+      const auto& vertices = a_triangle.getVertexPositions();
+
+      a_vertices.assign(vertices.begin(), vertices.end());
+    };
+
+    bvh->spatialSortAndPartition(polygon, a_maxLeafSize);
+
+    break;
+  }
   default: {
     std::cerr << "EBGeometry::MeshDistanceFunctionsDetail::buildTriTreeBVH - unsupported build method requested"
               << '\n';
@@ -205,6 +237,105 @@ buildTriTreeBVH(const std::vector<std::shared_ptr<EBGeometry::Triangle<T, Meta>>
   return bvh;
 }
 
+/**
+ * @brief Running result of a nearest-primitive search: the closest signed distance so far and its primitive.
+ * @details Internal helper; not part of the public API. Exact ties in magnitude go to the lower primitive index
+ * (see keepNearest()), so the result does not depend on the order in which a traversal visits the primitives.
+ * Point-by-point and packet traversals of the same tree therefore pick the same primitive, and hence the same sign.
+ * @tparam T Floating-point precision type.
+ */
+template <class T>
+struct NearestPrimitive
+{
+  T           minDist = std::numeric_limits<T>::max();         ///< Signed distance to the closest primitive so far.
+  std::size_t index   = std::numeric_limits<std::size_t>::max(); ///< Index of that primitive.
+};
+
+/**
+ * @brief Fold one primitive into a running nearest-primitive search.
+ * @details Internal helper; not part of the public API. The primitive wins if it is strictly closer, or exactly as
+ * close with a lower index.
+ * @tparam T Floating-point precision type.
+ * @param[in,out] a_nearest Running search result.
+ * @param[in]     a_dist    Signed distance to the primitive.
+ * @param[in]     a_index   Index of the primitive.
+ */
+template <class T>
+inline void
+keepNearest(NearestPrimitive<T>& a_nearest, const T a_dist, const std::size_t a_index) noexcept
+{
+  EBGEOMETRY_EXPECT(!std::isnan(a_dist));
+
+  const T absDist = std::abs(a_dist);
+  const T absMin  = std::abs(a_nearest.minDist);
+
+  if (absDist < absMin || (absDist == absMin && a_index < a_nearest.index)) {
+    a_nearest.minDist = a_dist;
+    a_nearest.index   = a_index;
+  }
+}
+
+/**
+ * @brief Batched signed distance over a packed BVH using packet traversal.
+ * @details Internal helper; not part of the public API. Points are processed in consecutive packets of
+ * a_packetSize that share one PackedBVH::packetPruneTraverse() walk, so a coherent packet (e.g. a small block of
+ * grid cells) fetches each node once instead of once per point. Every lane prunes against its own running distance
+ * exactly as PackedBVH::pruneTraverse() does, and exact ties go to the lower primitive index (see keepNearest()),
+ * so results are identical to point-by-point queries.
+ * @tparam T            Floating-point precision type.
+ * @tparam Root         Packed BVH type (must provide packetPruneTraverse()).
+ * @tparam LeafDistance Callable (size_t primitiveIndex, const Vec3T<T>& point) -> T signed distance.
+ * @param[in]  a_bvh          Packed BVH to traverse.
+ * @param[in]  a_points       Query points (a_numPoints entries).
+ * @param[out] a_values       Signed distances at a_points (a_numPoints entries).
+ * @param[in]  a_numPoints    Number of query points.
+ * @param[in]  a_leafDistance Signed distance from a point to the primitive at a given index.
+ * @param[in]  a_packetSize   Points per packet; at most Root::s_maxPacketSize.
+ */
+template <class T, class Root, class LeafDistance>
+void
+coherentSignedDistances(const Root&         a_bvh,
+                        const Vec3T<T>*     a_points,
+                        T*                  a_values,
+                        const std::size_t   a_numPoints,
+                        const LeafDistance& a_leafDistance,
+                        const std::size_t   a_packetSize) noexcept
+{
+  EBGEOMETRY_EXPECT(a_packetSize >= 1 && a_packetSize <= Root::s_maxPacketSize);
+
+  using Nearest = NearestPrimitive<T>;
+
+  const auto pruneDist2 = [](const Nearest& a_state) noexcept -> T { return a_state.minDist * a_state.minDist; };
+
+  std::array<Nearest, Root::s_maxPacketSize> states;
+
+  for (std::size_t begin = 0; begin < a_numPoints; begin += a_packetSize) {
+    const std::size_t count  = std::min(a_packetSize, a_numPoints - begin);
+    const Vec3T<T>*   packet = a_points + begin;
+
+    for (std::size_t lane = 0; lane < count; lane++) {
+      EBGEOMETRY_EXPECT(std::isfinite(packet[lane][0]));
+      EBGEOMETRY_EXPECT(std::isfinite(packet[lane][1]));
+      EBGEOMETRY_EXPECT(std::isfinite(packet[lane][2]));
+
+      states[lane] = Nearest();
+    }
+
+    const auto evalLeaf =
+      [&a_leafDistance, packet](Nearest& a_state, size_t a_lane, size_t a_offset, size_t a_count) noexcept {
+        for (size_t i = a_offset; i < a_offset + a_count; i++) {
+          keepNearest(a_state, a_leafDistance(i, packet[a_lane]), i);
+        }
+      };
+
+    a_bvh.packetPruneTraverse(packet, states.data(), count, evalLeaf, pruneDist2);
+
+    for (std::size_t lane = 0; lane < count; lane++) {
+      a_values[begin + lane] = states[lane].minDist;
+    }
+  }
+}
+
 } // namespace MeshDistanceFunctionsDetail
 
 template <class T, class Meta>
@@ -265,6 +396,11 @@ MeshSDF<T, Meta, K>::MeshSDF(const std::shared_ptr<Mesh>& a_mesh, const BVH::Bui
   m_mesh = a_mesh;
 }
 
+template <class T, class Meta, size_t K>
+MeshSDF<T, Meta, K>::MeshSDF(const std::shared_ptr<IndexedMesh>& a_mesh, const BVH::Build a_build)
+  : MeshSDF((a_mesh != nullptr) ? a_mesh->toMesh() : nullptr, a_build)
+{}
+
 template <class T, class Meta, size_t K>
 T
 MeshSDF<T, Meta, K>::signedDistance(const Vec3T<T>& a_point) const noexcept
@@ -274,24 +410,37 @@ MeshSDF<T, Meta, K>::signedDistance(const Vec3T<T>& a_point) const noexcept
   EBGEOMETRY_EXPECT(std::isfinite(a_point[1]));
   EBGEOMETRY_EXPECT(std::isfinite(a_point[2]));
 
-  T           minDist = std::numeric_limits<T>::max();
-  const auto& faces   = m_bvh->getPrimitives();
+  using Nearest = MeshDistanceFunctionsDetail::NearestPrimitive<T>;
 
-  const auto evalLeaf = [&faces, &a_point](T& a_state, size_t a_offset, size_t a_count) noexcept {
-    for (size_t i = a_offset; i < a_offset + a_count; i++) {
-      const T curDist = faces[i]->signedDistance(a_point);
+  Nearest     nearest;
+  const auto& faces = m_bvh->getPrimitives();
 
-      EBGEOMETRY_EXPECT(!std::isnan(curDist));
-
-      a_state = std::abs(curDist) < std::abs(a_state) ? curDist : a_state;
+  const auto evalLeaf = [&faces, &a_point](Nearest& a_state, size_t a_offset, size_t a_count) noexcept {
+    for (size_t i = a_offset; i < a_offset + a_count; i++) {
+      MeshDistanceFunctionsDetail::keepNearest(a_state, faces[i]->signedDistance(a_point), i);
     }
   };
 
-  const auto pruneDist2 = [](const T& a_state) noexcept -> T { return a_state * a_state; };
+  const auto pruneDist2 = [](const Nearest& a_state) noexcept -> T { return a_state.minDist * a_state.minDist; };
 
-  m_bvh->pruneTraverse(a_point, minDist, evalLeaf, pruneDist2);
+  m_bvh->pruneTraverse(a_point, nearest, evalLeaf, pruneDist2);
 
-  return minDist;
+  return nearest.minDist;
+}
+
+template <class T, class Meta, size_t K>
+void
+MeshSDF<T, Meta, K>::values(const Vec3T<T>* a_points, T* a_values, std::size_t a_numPoints) const noexcept
+{
+  EBGEOMETRY_EXPECT(m_bvh != nullptr);
+
+  const auto& faces = m_bvh->getPrimitives();
+
+  MeshDistanceFunctionsDetail::coherentSignedDistances(
+    *m_bvh, a_points, a_values, a_numPoints, [&faces](size_t a_face, const Vec3T<T>& a_point) noexcept -> T {
+      return faces[a_face]->signedDistance(a_point);
+    },
+    s_packetSize);
 }
 
 template <class T, class Meta, size_t K>
@@ -332,7 +481,7 @@ MeshSDF<T, Meta, K>::getClosestFaces(const Vec3T<T>& a_point, const bool a_sorte
 
   const EBGeometry::BVH::PackedLeafEvaluator<Face> leafEvaluator =
     [&shortestDistanceSoFar, &a_point, &candidateFaces](
-      const std::vector<std::shared_ptr<const Face>>& a_faces, size_t offset, size_t count) noexcept -> void {
+      const std::shared_ptr<const Face>* a_faces, size_t offset, size_t count) noexcept -> void {
     for (size_t i = offset; i < offset + count; i++) {
       const T distToFace = std::sqrt(a_faces[i]->unsignedDistance2(a_point));
 
@@ -347,6 +496,14 @@ MeshSDF<T, Meta, K>::getClosestFaces(const Vec3T<T>& a_point, const bool a_sorte
 
   m_bvh->traverse(leafEvaluator, prunePredicate, childOrderer, nodeKeyFactory);
 
+  // An SBVH build can put a face into several leaves, so the traversal may reach it more than once, with the same
+  // distance each time. Keep its first occurrence.
+  std::unordered_set<const Face*> seen;
+
+  const auto isRepeat = [&seen](const FaceAndDist& a_face) { return !seen.insert(a_face.first.get()).second; };
+
+  candidateFaces.erase(std::remove_if(candidateFaces.begin(), candidateFaces.end(), isRepeat), candidateFaces.end());
+
   if (a_sorted) {
     std::sort(candidateFaces.begin(), candidateFaces.end(), [](const FaceAndDist& a, const FaceAndDist& b) {
       return a.second < b.second;
@@ -383,6 +540,15 @@ MeshSDF<T, Meta, K>::computeBoundingVolume() const noexcept
   return m_bvh->getBoundingVolume();
 };
 
+template <class T, class Meta, size_t K>
+BVH::TreeMetrics
+MeshSDF<T, Meta, K>::computeMetrics() const
+{
+  EBGEOMETRY_EXPECT(m_bvh != nullptr);
+
+  return m_bvh->computeMetrics();
+}
+
 template <class T, class Meta, size_t K, size_t W, class StoragePolicy>
 std::vector<typename TriMeshSDF<T, Meta, K, W, StoragePolicy>::TriAoSoA>
 TriMeshSDF<T, Meta, K, W, StoragePolicy>::groupTrianglesIntoSoA(
@@ -459,6 +625,62 @@ TriMeshSDF<T, Meta, K, W, StoragePolicy>::TriMeshSDF(const std::shared_ptr<Mesh>
             ->template packWith<TriAoSoA, Converter, StoragePolicy>(&TriMeshSDF::groupTrianglesIntoSoA);
 }
 
+template <class T, class Meta, size_t K, size_t W, class StoragePolicy>
+TriMeshSDF<T, Meta, K, W, StoragePolicy>::TriMeshSDF(const std::shared_ptr<IndexedMesh>& a_mesh,
+                                                     const BVH::Build                    a_build,
+                                                     const size_t                        a_maxLeafGroups) noexcept
+{
+  EBGEOMETRY_EXPECT(a_mesh != nullptr);
+  EBGEOMETRY_EXPECT(a_maxLeafGroups > 0);
+
+  using AABB = EBGeometry::BoundingVolumes::AABBT<T>;
+
+  const auto& positions     = a_mesh->getVertexPositions();
+  const auto& vertexNormals = a_mesh->getVertexNormals();
+  const auto& edgeVertices  = a_mesh->getEdgeVertices();
+  const auto& nextEdges     = a_mesh->getEdgeNextEdges();
+  const auto& edgeNormals   = a_mesh->getEdgeNormals();
+  const auto& faceEdges     = a_mesh->getFaceEdges();
+  const auto& faceNormals   = a_mesh->getFaceNormals();
+  const auto& faceMetaData  = a_mesh->getFaceMetaData();
+
+  std::vector<std::shared_ptr<Tri>> triangles;
+  triangles.reserve(faceEdges.size());
+
+  for (size_t f = 0; f < faceEdges.size(); f++) {
+    const uint32_t e0 = faceEdges[f];
+    const uint32_t e1 = nextEdges[e0];
+    const uint32_t e2 = nextEdges[e1];
+
+    EBGEOMETRY_EXPECT(nextEdges[e2] == e0);
+
+    if (nextEdges[e2] != e0) {
+      std::cerr << "TriMeshSDF -- mesh not triangulated!\n";
+    }
+
+    const uint32_t v0 = edgeVertices[e0];
+    const uint32_t v1 = edgeVertices[e1];
+    const uint32_t v2 = edgeVertices[e2];
+
+    auto tri = std::make_shared<Tri>();
+
+    tri->setNormal(faceNormals[f]);
+    tri->setVertexPositions({positions[v0], positions[v1], positions[v2]});
+    tri->setVertexNormals({vertexNormals[v0], vertexNormals[v1], vertexNormals[v2]});
+    tri->setEdgeNormals({edgeNormals[e0], edgeNormals[e1], edgeNormals[e2]});
+    tri->setMetaData(faceMetaData[f]);
+
+    triangles.emplace_back(tri);
+  }
+
+  const size_t maxLeafSize = a_maxLeafGroups * W;
+
+  using Converter = decltype(&TriMeshSDF::groupTrianglesIntoSoA);
+
+  m_bvh = EBGeometry::MeshDistanceFunctionsDetail::buildTriTreeBVH<T, Meta, AABB, K>(triangles, a_build, maxLeafSize)
+            ->template packWith<TriAoSoA, Converter, StoragePolicy>(&TriMeshSDF::groupTrianglesIntoSoA);
+}
+
 template <class T, class Meta, size_t K, size_t W, class StoragePolicy>
 TriMeshSDF<T, Meta, K, W, StoragePolicy>::TriMeshSDF(const std::vector<std::shared_ptr<Tri>>& a_triangles,
                                                      const BVH::Build                         a_build,
@@ -477,35 +699,64 @@ TriMeshSDF<T, Meta, K, W, StoragePolicy>::TriMeshSDF(const std::vector<std::shar
             ->template packWith<TriAoSoA, Converter, StoragePolicy>(&TriMeshSDF::groupTrianglesIntoSoA);
 }
 
+template <class T, class Meta, size_t K, size_t W, class StoragePolicy>
+TriMeshSDF<T, Meta, K, W, StoragePolicy>::TriMeshSDF(const std::shared_ptr<Root>& a_root) noexcept : m_bvh(a_root)
+{
+  EBGEOMETRY_EXPECT(m_bvh != nullptr);
+}
+
 template <class T, class Meta, size_t K, size_t W, class StoragePolicy>
 T
 TriMeshSDF<T, Meta, K, W, StoragePolicy>::signedDistance(const Vec3T<T>& a_point) const noexcept
+{
+  return this->boundedSignedDistance(a_point, std::numeric_limits<T>::max());
+}
+
+template <class T, class Meta, size_t K, size_t W, class StoragePolicy>
+T
+TriMeshSDF<T, Meta, K, W, StoragePolicy>::boundedSignedDistance(const Vec3T<T>& a_point,
+                                                                const T         a_bound) const noexcept
 {
   EBGEOMETRY_EXPECT(m_bvh != nullptr);
   EBGEOMETRY_EXPECT(std::isfinite(a_point[0]));
   EBGEOMETRY_EXPECT(std::isfinite(a_point[1]));
   EBGEOMETRY_EXPECT(std::isfinite(a_point[2]));
+  EBGEOMETRY_EXPECT(a_bound > T(0));
 
-  T           minDist = std::numeric_limits<T>::max();
-  const auto& groups  = m_bvh->getPrimitives();
-
-  const auto evalLeaf = [&groups, &a_point](T& a_state, size_t a_offset, size_t a_count) noexcept {
-    for (size_t i = a_offset; i < a_offset + a_count; i++) {
-      const T d = StoragePolicy::get(groups[i]).signedDistance(a_point);
+  using Nearest = MeshDistanceFunctionsDetail::NearestPrimitive<T>;
 
-      EBGEOMETRY_EXPECT(!std::isnan(d));
+  // The bound starts out as index 0, so a group exactly at the bound never displaces it.
+  Nearest     nearest{a_bound, 0};
+  const auto* groups = m_bvh->getPrimitiveData();
 
-      if (std::abs(d) < std::abs(a_state)) {
-        a_state = d;
-      }
+  const auto evalLeaf = [groups, &a_point](Nearest& a_state, size_t a_offset, size_t a_count) noexcept {
+    for (size_t i = a_offset; i < a_offset + a_count; i++) {
+      MeshDistanceFunctionsDetail::keepNearest(a_state, StoragePolicy::get(groups[i]).signedDistance(a_point), i);
     }
   };
 
-  const auto pruneDist2 = [](const T& a_state) noexcept -> T { return a_state * a_state; };
+  const auto pruneDist2 = [](const Nearest& a_state) noexcept -> T { return a_state.minDist * a_state.minDist; };
+
+  m_bvh->pruneTraverse(a_point, nearest, evalLeaf, pruneDist2);
+
+  return nearest.minDist;
+}
+
+template <class T, class Meta, size_t K, size_t W, class StoragePolicy>
+void
+TriMeshSDF<T, Meta, K, W, StoragePolicy>::values(const Vec3T<T>* a_points,
+                                                 T*              a_values,
+                                                 std::size_t     a_numPoints) const noexcept
+{
+  EBGEOMETRY_EXPECT(m_bvh != nullptr);
 
-  m_bvh->pruneTraverse(a_point, minDist, evalLeaf, pruneDist2);
+  const auto* groups = m_bvh->getPrimitiveData();
 
-  return minDist;
+  MeshDistanceFunctionsDetail::coherentSignedDistances(
+    *m_bvh, a_points, a_values, a_numPoints, [groups](size_t a_group, const Vec3T<T>& a_point) noexcept -> T {
+      return StoragePolicy::get(groups[a_group]).signedDistance(a_point);
+    },
+    s_packetSize);
 }
 
 template <class T, class Meta, size_t K, size_t W, class StoragePolicy>
@@ -521,29 +772,41 @@ TriMeshSDF<T, Meta, K, W, StoragePolicy>::getClosestTriangle(const Vec3T<T>& a_p
   // triangle's metadata: each visited leaf group reports both its closest signed distance and that
   // triangle's Meta via TriangleAoSoA::signedDistance(point, Meta&). The pruning bound is still the
   // squared running distance, so node pruning is identical to signedDistance()'s.
-  ClosestTriangle closest;
+  struct State
+  {
+    MeshDistanceFunctionsDetail::NearestPrimitive<T> nearest;
+    Meta                                             metaData{};
+  };
 
-  const auto& groups = m_bvh->getPrimitives();
+  State state;
 
-  const auto evalLeaf = [&groups, &a_point](ClosestTriangle& a_state, size_t a_offset, size_t a_count) noexcept {
+  const auto* groups = m_bvh->getPrimitiveData();
+
+  const auto evalLeaf = [groups, &a_point](State& a_state, size_t a_offset, size_t a_count) noexcept {
     for (size_t i = a_offset; i < a_offset + a_count; i++) {
       Meta    groupMeta{};
       const T d = StoragePolicy::get(groups[i]).signedDistance(a_point, groupMeta);
 
-      EBGEOMETRY_EXPECT(!std::isnan(d));
+      const std::size_t prevIndex = a_state.nearest.index;
+
+      MeshDistanceFunctionsDetail::keepNearest(a_state.nearest, d, i);
 
-      if (std::abs(d) < std::abs(a_state.signedDistance)) {
-        a_state.signedDistance = d;
-        a_state.metaData       = groupMeta;
+      if (a_state.nearest.index != prevIndex) {
+        a_state.metaData = groupMeta;
       }
     }
   };
 
-  const auto pruneDist2 = [](const ClosestTriangle& a_state) noexcept -> T {
-    return a_state.signedDistance * a_state.signedDistance;
+  const auto pruneDist2 = [](const State& a_state) noexcept -> T {
+    return a_state.nearest.minDist * a_state.nearest.minDist;
   };
 
-  m_bvh->pruneTraverse(a_point, closest, evalLeaf, pruneDist2);
+  m_bvh->pruneTraverse(a_point, state, evalLeaf, pruneDist2);
+
+  ClosestTriangle closest;
+
+  closest.signedDistance = state.nearest.minDist;
+  closest.metaData       = state.metaData;
 
   return closest;
 }
@@ -575,6 +838,42 @@ TriMeshSDF<T, Meta, K, W, StoragePolicy>::computeBoundingVolume() const noexcept
   return m_bvh->getBoundingVolume();
 };
 
+template <class T, class Meta, size_t K, size_t W, class StoragePolicy>
+BVH::TreeMetrics
+TriMeshSDF<T, Meta, K, W, StoragePolicy>::computeMetrics() const
+{
+  EBGEOMETRY_EXPECT(m_bvh != nullptr);
+
+  return m_bvh->computeMetrics();
+}
+
+template <class T, class Meta, size_t K, size_t W, class StoragePolicy>
+bool
+TriMeshSDF<T, Meta, K, W, StoragePolicy>::save(const std::string& a_filename) const
+{
+  EBGEOMETRY_EXPECT(m_bvh != nullptr);
+
+  return m_bvh->save(a_filename);
+}
+
+template <class T, class Meta, size_t K, size_t W, class StoragePolicy>
+std::shared_ptr<TriMeshSDF<T, Meta, K, W, StoragePolicy>>
+TriMeshSDF<T, Meta, K, W, StoragePolicy>::load(const std::string& a_filename)
+{
+  const std::shared_ptr<Root> root = Root::load(a_filename);
+
+  return (root != nullptr) ? std::make_shared<TriMeshSDF>(root) : nullptr;
+}
+
+template <class T, class Meta, size_t K, size_t W, class StoragePolicy>
+std::shared_ptr<TriMeshSDF<T, Meta, K, W, StoragePolicy>>
+TriMeshSDF<T, Meta, K, W, StoragePolicy>::map(const std::string& a_filename)
+{
+  const std::shared_ptr<Root> root = Root::map(a_filename);
+
+  return (root != nullptr) ? std::make_shared<TriMeshSDF>(root) : nullptr;
+}
+
 } // namespace EBGeometry
 
 #endif
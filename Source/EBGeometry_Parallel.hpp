@@ -0,0 +1,423 @@
+// SPDX-FileCopyrightText: 2026 Robert Marskar <robert.marskar@sintef.no>
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+/**
+ * @file    EBGeometry_Parallel.hpp
+ * @brief   A dependency-free, work-stealing thread pool with parallelFor() and TaskGroup.
+ * @details Threading is optional. It is compiled in only when EBGEOMETRY_ENABLE_THREADS is defined (the
+ *          EBGEOMETRY_ENABLE_THREADS CMake option does this and links the platform's thread library); otherwise
+ *          every entry point below runs serially on the calling thread, with the same results.
+ * @author  Robert Marskar
+ */
+
+#ifndef EBGEOMETRY_PARALLEL_HPP
+#define EBGEOMETRY_PARALLEL_HPP
+
+// Std includes
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#if defined(EBGEOMETRY_ENABLE_THREADS)
+#include <condition_variable>
+#include <thread>
+#endif
+
+namespace EBGeometry {
+
+/**
+ * @brief Namespace for EBGeometry's shared-memory parallelism: a global work-stealing thread pool and the
+ * parallelFor()/TaskGroup primitives that the bulk queries and BVH builders are written against.
+ * @details The pool size is controlled with setNumThreads() (default: the EBGEOMETRY_NUM_THREADS environment
+ * variable if set, else std::thread::hardware_concurrency()). The calling thread always takes part in the work, so
+ * a pool of N threads starts N-1 workers, and N == 1 runs everything serially without starting any.
+ *
+ * Everything EBGeometry runs in parallel writes disjoint outputs (one value per query point, one subtree per
+ * task), so results never depend on scheduling. The only thing that can depend on the thread count is how a
+ * parallelFor() range is cut into chunks, which in turn may steer chunk-local heuristics (e.g. seeding a query's
+ * pruning bound from the previous point in the same chunk) towards a different winner among exactly tied
+ * candidates. setDeterministic(true) pins the chunking to the grain size alone, which makes every result
+ * bit-for-bit independent of the thread count.
+ */
+namespace Parallel {
+
+/**
+ * @brief A work-stealing pool of worker threads.
+ * @details Every worker owns a task deque. A task submitted from a worker goes to the back of that worker's own
+ * deque and is popped from there LIFO (depth-first, cache-warm), while idle workers steal from the front of other
+ * deques FIFO (the oldest, typically largest, tasks). Tasks submitted from outside the pool are dealt round-robin.
+ * Threads blocked in TaskGroup::wait() keep executing pending tasks instead of sleeping, so nested parallelism
+ * (tasks that spawn and wait on tasks) cannot deadlock.
+ *
+ * Users rarely need this class directly: the global pool behind getThreadPool() serves parallelFor() and
+ * TaskGroup.
+ */
+class ThreadPool
+{
+public:
+  /**
+   * @brief Task type.
+   */
+  using Task = std::function<void()>;
+
+  /**
+   * @brief Disallowed -- a thread count is required.
+   */
+  ThreadPool() = delete;
+
+  /**
+   * @brief Start a pool.
+   * @param[in] a_numThreads Total number of threads including the caller; starts a_numThreads - 1 workers. Values
+   * below one are treated as one. Ignored (always one) when EBGEOMETRY_ENABLE_THREADS is not defined.
+   */
+  inline explicit ThreadPool(unsigned a_numThreads);
+
+  /**
+   * @brief Disallowed -- the workers hold a pointer to this pool.
+   */
+  ThreadPool(const ThreadPool&) = delete;
+
+  /**
+   * @brief Disallowed -- the workers hold a pointer to this pool.
+   */
+  ThreadPool(ThreadPool&&) = delete;
+
+  /**
+   * @brief Disallowed -- the workers hold a pointer to this pool.
+   */
+  ThreadPool&
+  operator=(const ThreadPool&) = delete;
+
+  /**
+   * @brief Disallowed -- the workers hold a pointer to this pool.
+   */
+  ThreadPool&
+  operator=(ThreadPool&&) = delete;
+
+  /**
+   * @brief Stop and join all workers. Tasks still queued are discarded.
+   */
+  inline ~ThreadPool();
+
+  /**
+   * @brief Total number of threads that execute tasks, including the thread that waits on them.
+   * @return Number of workers plus one.
+   */
+  [[nodiscard]] inline unsigned
+  getNumThreads() const noexcept;
+
+  /**
+   * @brief Queue a task for execution by some thread in the pool.
+   * @details Runs the task immediately on the calling thread when the pool has no workers.
+   * @param[in] a_task Task to run.
+   */
+  inline void
+  submit(Task&& a_task);
+
+  /**
+   * @brief Run one queued task on the calling thread, if there is one.
+   * @details Used by waiting threads to help out rather than block. Prefers the calling worker's own deque, then
+   * steals from the others.
+   * @return True if a task was run.
+   */
+  inline bool
+  runPendingTask();
+
+private:
+#if defined(EBGEOMETRY_ENABLE_THREADS)
+  /**
+   * @brief One task deque with its lock.
+   */
+  struct TaskQueue
+  {
+    std::mutex       mutex; ///< Guards tasks.
+    std::deque<Task> tasks; ///< Queued tasks; the owner works at the back, thieves at the front.
+  };
+
+  /**
+   * @brief Main loop of worker a_index: run tasks while there are any, otherwise sleep until one arrives.
+   * @param[in] a_index Worker index (its own deque).
+   */
+  inline void
+  workerLoop(std::size_t a_index);
+
+  /**
+   * @brief Pop a task, preferring deque a_first (from the back) and then stealing from the others (from the front).
+   * @param[in]  a_first Deque to look at first.
+   * @param[out] a_task  The popped task.
+   * @return True if a task was popped.
+   */
+  inline bool
+  popTask(std::size_t a_first, Task& a_task);
+
+  /**
+   * @brief Index of the calling thread's own deque if it is a worker of this pool, else the deque external
+   * submissions go to next.
+   * @return A deque index.
+   */
+  inline std::size_t
+  homeQueue() noexcept;
+
+  /**
+   * @brief One deque per worker.
+   */
+  std::vector<std::unique_ptr<TaskQueue>> m_queues;
+
+  /**
+   * @brief The worker threads.
+   */
+  std::vector<std::thread> m_workers;
+
+  /**
+   * @brief Number of queued, not yet started tasks.
+   */
+  std::atomic<std::size_t> m_numQueued{0};
+
+  /**
+   * @brief Round-robin counter for tasks submitted from outside the pool.
+   */
+  std::atomic<std::size_t> m_nextQueue{0};
+
+  /**
+   * @brief Set on destruction.
+   */
+  std::atomic<bool> m_stop{false};
+
+  /**
+   * @brief Lock that idle workers sleep on.
+   */
+  std::mutex m_sleepMutex;
+
+  /**
+   * @brief Signalled when a task is queued or the pool stops.
+   */
+  std::condition_variable m_wakeUp;
+#endif
+};
+
+/**
+ * @brief A group of tasks that can be waited on together.
+ * @details run() hands a task to the global pool; wait() blocks until every task run through this group has
+ * finished, executing pending pool tasks on the calling thread in the meantime. Tasks may themselves create and
+ * wait on task groups. If a task throws, the first exception is rethrown from wait(). The destructor waits too, so
+ * a group never outlives its tasks. A group shares ownership of the pool it was created on, so it stays usable
+ * across setNumThreads(): its tasks keep running on that pool, which is only joined once the group is gone.
+ */
+class TaskGroup
+{
+public:
+  /**
+   * @brief Create an empty group on the global pool.
+   */
+  inline TaskGroup();
+
+  /**
+   * @brief Disallowed -- running tasks refer to the group.
+   */
+  TaskGroup(const TaskGroup&) = delete;
+
+  /**
+   * @brief Disallowed -- running tasks refer to the group.
+   */
+  TaskGroup(TaskGroup&&) = delete;
+
+  /**
+   * @brief Disallowed -- running tasks refer to the group.
+   */
+  TaskGroup&
+  operator=(const TaskGroup&) = delete;
+
+  /**
+   * @brief Disallowed -- running tasks refer to the group.
+   */
+  TaskGroup&
+  operator=(TaskGroup&&) = delete;
+
+  /**
+   * @brief Wait for all tasks. Exceptions thrown by them are swallowed here; call wait() to observe them.
+   */
+  inline ~TaskGroup();
+
+  /**
+   * @brief Run a task asynchronously (synchronously if the pool has a single thread).
+   * @tparam F Callable with signature void().
+   * @param[in] a_task Task. It must stay valid, together with everything it refers to, until wait() returns.
+   */
+  template <class F>
+  inline void
+  run(F&& a_task);
+
+  /**
+   * @brief Block until every task run through this group has finished.
+   * @details Rethrows the first exception thrown by any of them.
+   */
+  inline void
+  wait();
+
+private:
+  /**
+   * @brief Pool the tasks run on.
+   */
+  std::shared_ptr<ThreadPool> m_pool;
+
+  /**
+   * @brief Number of unfinished tasks.
+   */
+  std::atomic<std::size_t> m_numPending{0};
+
+  /**
+   * @brief Guards m_exception.
+   */
+  std::mutex m_exceptionMutex;
+
+  /**
+   * @brief First exception thrown by a task, if any.
+   */
+  std::exception_ptr m_exception;
+};
+
+/**
+ * @brief The global pool that parallelFor() and TaskGroup run on. Created on first use.
+ * @details Once the pool exists this is a single atomic load; the lock is only taken to create or replace it. The
+ * reference is only valid until the next setNumThreads() that resizes the pool; hold a TaskGroup to keep a pool
+ * running across that.
+ * @return The pool.
+ */
+inline ThreadPool&
+getThreadPool();
+
+/**
+ * @brief Resize the global pool.
+ * @details Starts a new pool of workers for all subsequent parallel work. The old pool is joined as soon as no
+ * TaskGroup created on it remains, which is immediately unless one is still alive.
+ * @param[in] a_numThreads Total number of threads including the caller; 0 selects
+ * std::thread::hardware_concurrency(). Has no effect when EBGEOMETRY_ENABLE_THREADS is not defined.
+ */
+inline void
+setNumThreads(unsigned a_numThreads);
+
+/**
+ * @brief Number of threads of the global pool, including the calling thread.
+ * @return Thread count; always one when EBGEOMETRY_ENABLE_THREADS is not defined.
+ */
+[[nodiscard]] inline unsigned
+getNumThreads();
+
+/**
+ * @brief Turn the deterministic-results mode on or off (default off).
+ * @details In deterministic mode parallelFor() always cuts its range into chunks of exactly the grain size,
+ * whatever the thread count, so anything computed chunk by chunk is bit-for-bit reproducible across thread
+ * counts and runs. Otherwise chunks are enlarged to a few per thread, which lowers scheduling overhead.
+ * @param[in] a_deterministic True to turn deterministic mode on.
+ */
+inline void
+setDeterministic(bool a_deterministic) noexcept;
+
+/**
+ * @brief Whether deterministic-results mode is on.
+ * @return True if it is.
+ */
+[[nodiscard]] inline bool
+isDeterministic() noexcept;
+
+/**
+ * @brief Run a_func over the index range [a_begin, a_end), cut into chunks that are processed in parallel.
+ * @details a_func is called once per chunk as a_func(lo, hi), concurrently on different threads for different
+ * chunks, so it must be safe to call concurrently for disjoint ranges. Chunks are at least a_grainSize long (the
+ * last one may be shorter); in deterministic mode they are exactly a_grainSize long (see setDeterministic()).
+ * With a single thread, or when the range fits in one chunk, a_func runs on the calling thread. Exceptions thrown
+ * by a_func propagate to the caller.
+ * @tparam F Callable with signature void(std::size_t lo, std::size_t hi).
+ * @param[in] a_begin     First index.
+ * @param[in] a_end       One past the last index.
+ * @param[in] a_grainSize Minimum chunk length; values below one are treated as one.
+ * @param[in] a_func      Chunk body.
+ */
+template <class F>
+inline void
+parallelFor(std::size_t a_begin, std::size_t a_end, std::size_t a_grainSize, F&& a_func);
+
+/**
+ * @brief Helpers shared by the hash-and-sort passes over polygon soups (vertex welding, pair-edge reconciliation,
+ * binary STL decoding).
+ */
+namespace Detail {
+
+/**
+ * @brief splitmix64 finalizer, used to hash keys before they are sorted.
+ * @param[in] a_x Key to mix.
+ * @return Mixed key.
+ */
+[[nodiscard]] inline uint64_t
+mix(uint64_t a_x) noexcept;
+
+/**
+ * @brief Number of chunks that a_numItems items are split into for a chunked parallel pass.
+ * @details At least one, at most four per thread, and no smaller than a_grainSize items on average.
+ * @param[in] a_numItems  Number of items.
+ * @param[in] a_grainSize Smallest average chunk length.
+ */
+[[nodiscard]] inline std::size_t
+numChunks(std::size_t a_numItems, std::size_t a_grainSize) noexcept;
+
+/**
+ * @brief First item of chunk a_chunk when a_numItems items are split into a_numChunks chunks.
+ * @details Chunk a_chunk holds [chunkBegin(a_chunk), chunkBegin(a_chunk + 1)).
+ * @param[in] a_numItems  Number of items.
+ * @param[in] a_numChunks Number of chunks.
+ * @param[in] a_chunk     Chunk index, in [0, a_numChunks].
+ */
+[[nodiscard]] inline std::size_t
+chunkBegin(std::size_t a_numItems, std::size_t a_numChunks, std::size_t a_chunk) noexcept;
+
+/**
+ * @brief Call a_func(begin, end) for every run [begin, end) of equal keys that starts in [a_lo, a_hi).
+ * @details A run that starts before a_lo is skipped and one that starts before a_hi is followed past it, so
+ * disjoint ranges that cover the keys visit every run exactly once.
+ * @tparam Key Key type, compared with ==.
+ * @tparam F   Callable with signature void(std::size_t begin, std::size_t end).
+ * @param[in] a_sortedKeys Keys, sorted so that equal keys are adjacent.
+ * @param[in] a_lo         First position.
+ * @param[in] a_hi         One past the last position.
+ * @param[in] a_func       Run body.
+ */
+template <class Key, class F>
+inline void
+forEachRun(const std::vector<Key>& a_sortedKeys, std::size_t a_lo, std::size_t a_hi, const F& a_func) noexcept;
+
+/**
+ * @brief Number the items in [0, a_numItems) for which a_keep(i) holds, in ascending order, in parallel.
+ * @details Counts the kept items per chunk, scans the counts, calls a_resize(total) once, and then calls
+ * a_emit(i, k) for the kept item i with rank k. Each chunk emits from its own offset, so the ranks do not depend
+ * on the thread count.
+ * @param[in] a_numItems  Number of items.
+ * @param[in] a_grainSize Smallest average chunk length.
+ * @param[in] a_keep      Called as bool a_keep(std::size_t i). Must be pure, it is called twice per item.
+ * @param[in] a_resize    Called as a_resize(std::size_t total) before any a_emit call.
+ * @param[in] a_emit      Called as a_emit(std::size_t i, std::size_t k).
+ * @return Number of kept items.
+ */
+template <class Keep, class Resize, class Emit>
+inline std::size_t
+compactInOrder(std::size_t   a_numItems,
+               std::size_t   a_grainSize,
+               const Keep&   a_keep,
+               const Resize& a_resize,
+               const Emit&   a_emit) noexcept;
+
+} // namespace Detail
+
+} // namespace Parallel
+
+} // namespace EBGeometry
+
+#include "EBGeometry_ParallelImplem.hpp"
+
+#endif
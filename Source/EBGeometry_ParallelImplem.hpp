@@ -0,0 +1,626 @@
+// SPDX-FileCopyrightText: 2026 Robert Marskar <robert.marskar@sintef.no>
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+/**
+ * @file    EBGeometry_ParallelImplem.hpp
+ * @brief   Implementation of EBGeometry_Parallel.hpp
+ * @author  Robert Marskar
+ */
+
+#ifndef EBGEOMETRY_PARALLELIMPLEM_HPP
+#define EBGEOMETRY_PARALLELIMPLEM_HPP
+
+// Std includes
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+
+// Our includes
+#include "EBGeometry_Macros.hpp"
+#include "EBGeometry_Parallel.hpp"
+
+namespace EBGeometry {
+namespace Parallel {
+
+namespace Detail {
+
+#if defined(EBGEOMETRY_ENABLE_THREADS)
+/**
+ * @brief Pool the calling thread is a worker of, or nullptr.
+ * @return Reference to the thread-local slot.
+ */
+inline const void*&
+currentPool() noexcept
+{
+  thread_local const void* pool = nullptr;
+
+  return pool;
+}
+
+/**
+ * @brief Deque index of the calling thread within currentPool().
+ * @return Reference to the thread-local slot.
+ */
+inline std::size_t&
+currentWorker() noexcept
+{
+  thread_local std::size_t worker = 0;
+
+  return worker;
+}
+
+/**
+ * @brief Default size of the global pool: EBGEOMETRY_NUM_THREADS if set to a positive integer, else the hardware
+ * concurrency.
+ * @return Thread count, at least one.
+ */
+inline unsigned
+defaultNumThreads() noexcept
+{
+  if (const char* env = std::getenv("EBGEOMETRY_NUM_THREADS")) {
+    const long n = std::strtol(env, nullptr, 10);
+
+    if (n > 0) {
+      return static_cast<unsigned>(n);
+    }
+  }
+
+  return std::max(1U, std::thread::hardware_concurrency());
+}
+#endif
+
+/**
+ * @brief Storage for the global pool.
+ * @details Shared with every TaskGroup created on it (see sharedThreadPool()), so a pool replaced by setNumThreads()
+ * lives on until the last such group is gone. Only written under globalPoolMutex(), with std::atomic_store().
+ * @return Reference to the owning pointer.
+ */
+inline std::shared_ptr<ThreadPool>&
+globalPool()
+{
+  static std::shared_ptr<ThreadPool> pool;
+
+  return pool;
+}
+
+/**
+ * @brief The global pool as published to getThreadPool(), or nullptr before it is created.
+ * @details Only written under globalPoolMutex(), so that getThreadPool() can read it without the lock.
+ * @return Reference to the pointer.
+ */
+inline std::atomic<ThreadPool*>&
+globalPoolPointer() noexcept
+{
+  static std::atomic<ThreadPool*> pointer{nullptr};
+
+  return pointer;
+}
+
+/**
+ * @brief Guards creation and replacement of the global pool.
+ * @return The lock.
+ */
+inline std::mutex&
+globalPoolMutex()
+{
+  static std::mutex mutex;
+
+  return mutex;
+}
+
+/**
+ * @brief Shared ownership of the global pool, creating it on first use.
+ * @return The pool.
+ */
+inline std::shared_ptr<ThreadPool>
+sharedThreadPool()
+{
+  // getThreadPool() creates the pool, and setNumThreads() only ever replaces it, so the load below is never empty.
+  static_cast<void>(getThreadPool());
+
+  return std::atomic_load(&globalPool());
+}
+
+/**
+ * @brief Deterministic-mode flag.
+ * @return Reference to the flag.
+ */
+inline std::atomic<bool>&
+deterministic() noexcept
+{
+  static std::atomic<bool> flag{false};
+
+  return flag;
+}
+
+} // namespace Detail
+
+#if defined(EBGEOMETRY_ENABLE_THREADS)
+
+inline ThreadPool::ThreadPool(unsigned a_numThreads)
+{
+  const std::size_t numWorkers = std::max(1U, a_numThreads) - 1;
+
+  for (std::size_t i = 0; i < numWorkers; i++) {
+    m_queues.emplace_back(std::make_unique<TaskQueue>());
+  }
+  for (std::size_t i = 0; i < numWorkers; i++) {
+    m_workers.emplace_back([this, i] { this->workerLoop(i); });
+  }
+}
+
+inline ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_sleepMutex);
+
+    m_stop.store(true);
+  }
+  m_wakeUp.notify_all();
+
+  for (auto& worker : m_workers) {
+    worker.join();
+  }
+}
+
+inline unsigned
+ThreadPool::getNumThreads() const noexcept
+{
+  return static_cast<unsigned>(m_workers.size()) + 1;
+}
+
+inline std::size_t
+ThreadPool::homeQueue() noexcept
+{
+  if (Detail::currentPool() == this) {
+    return Detail::currentWorker();
+  }
+
+  return m_nextQueue.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+}
+
+inline void
+ThreadPool::submit(Task&& a_task)
+{
+  if (m_workers.empty()) {
+    a_task();
+
+    return;
+  }
+
+  TaskQueue& queue = *m_queues[this->homeQueue()];
+  {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+
+    queue.tasks.emplace_back(std::move(a_task));
+  }
+
+  // Incrementing under the sleep lock closes the window between a worker's last look at the counter and it going
+  // to sleep.
+  {
+    std::lock_guard<std::mutex> lock(m_sleepMutex);
+
+    m_numQueued.fetch_add(1);
+  }
+  m_wakeUp.notify_one();
+}
+
+inline bool
+ThreadPool::popTask(std::size_t a_first, Task& a_task)
+{
+  const std::size_t numQueues = m_queues.size();
+
+  for (std::size_t i = 0; i < numQueues; i++) {
+    TaskQueue& queue = *m_queues[(a_first + i) % numQueues];
+
+    std::lock_guard<std::mutex> lock(queue.mutex);
+
+    if (!queue.tasks.empty()) {
+      if (i == 0) {
+        a_task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+      }
+      else {
+        a_task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+      }
+
+      m_numQueued.fetch_sub(1);
+
+      return true;
+    }
+  }
+
+  return false;
+}
+
+inline bool
+ThreadPool::runPendingTask()
+{
+  if (m_workers.empty() || m_numQueued.load() == 0) {
+    return false;
+  }
+
+  const std::size_t first = (Detail::currentPool() == this) ? Detail::currentWorker() : 0;
+
+  Task task;
+  if (this->popTask(first, task)) {
+    task();
+
+    return true;
+  }
+
+  return false;
+}
+
+inline void
+ThreadPool::workerLoop(std::size_t a_index)
+{
+  Detail::currentPool()   = this;
+  Detail::currentWorker() = a_index;
+
+  while (true) {
+    Task task;
+    if (this->popTask(a_index, task)) {
+      task();
+
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(m_sleepMutex);
+
+    m_wakeUp.wait(lock, [this] { return m_stop.load() || m_numQueued.load() > 0; });
+
+    if (m_stop.load()) {
+      return;
+    }
+  }
+}
+
+inline void
+setNumThreads(unsigned a_numThreads)
+{
+  std::lock_guard<std::mutex> lock(Detail::globalPoolMutex());
+
+  const unsigned numThreads = (a_numThreads == 0) ? std::max(1U, std::thread::hardware_concurrency()) : a_numThreads;
+
+  auto& pool = Detail::globalPool();
+  if (!pool || pool->getNumThreads() != numThreads) {
+    // Task groups still holding the old pool keep it running; it is joined when the last of them goes away, which
+    // is here if there are none.
+    const std::shared_ptr<ThreadPool> retired = pool;
+
+    std::atomic_store(&pool, std::make_shared<ThreadPool>(numThreads));
+
+    Detail::globalPoolPointer().store(pool.get(), std::memory_order_release);
+  }
+}
+
+inline ThreadPool&
+getThreadPool()
+{
+  // The pool only changes under the lock, so it is only taken until the pool exists.
+  if (ThreadPool* const published = Detail::globalPoolPointer().load(std::memory_order_acquire)) {
+    return *published;
+  }
+
+  std::lock_guard<std::mutex> lock(Detail::globalPoolMutex());
+
+  auto& pool = Detail::globalPool();
+  if (!pool) {
+    std::atomic_store(&pool, std::make_shared<ThreadPool>(Detail::defaultNumThreads()));
+
+    Detail::globalPoolPointer().store(pool.get(), std::memory_order_release);
+  }
+
+  return *pool;
+}
+
+#else
+
+inline ThreadPool::ThreadPool(unsigned)
+{}
+
+inline ThreadPool::~ThreadPool()
+{}
+
+inline unsigned
+ThreadPool::getNumThreads() const noexcept
+{
+  return 1;
+}
+
+inline void
+ThreadPool::submit(Task&& a_task)
+{
+  a_task();
+}
+
+inline bool
+ThreadPool::runPendingTask()
+{
+  return false;
+}
+
+inline void
+setNumThreads(unsigned)
+{}
+
+inline ThreadPool&
+getThreadPool()
+{
+  // The pool only changes under the lock, so it is only taken until the pool exists.
+  if (ThreadPool* const published = Detail::globalPoolPointer().load(std::memory_order_acquire)) {
+    return *published;
+  }
+
+  std::lock_guard<std::mutex> lock(Detail::globalPoolMutex());
+
+  auto& pool = Detail::globalPool();
+  if (!pool) {
+    std::atomic_store(&pool, std::make_shared<ThreadPool>(1U));
+
+    Detail::globalPoolPointer().store(pool.get(), std::memory_order_release);
+  }
+
+  return *pool;
+}
+
+#endif
+
+inline unsigned
+getNumThreads()
+{
+  return getThreadPool().getNumThreads();
+}
+
+inline void
+setDeterministic(bool a_deterministic) noexcept
+{
+  Detail::deterministic().store(a_deterministic);
+}
+
+inline bool
+isDeterministic() noexcept
+{
+  return Detail::deterministic().load();
+}
+
+inline TaskGroup::TaskGroup() : m_pool(Detail::sharedThreadPool())
+{}
+
+inline TaskGroup::~TaskGroup()
+{
+  try {
+    this->wait();
+  }
+  catch (...) {
+  }
+}
+
+template <class F>
+inline void
+TaskGroup::run(F&& a_task)
+{
+  m_numPending.fetch_add(1);
+
+  m_pool->submit([this, task = std::forward<F>(a_task)]() mutable {
+    try {
+      task();
+    }
+    catch (...) {
+      std::lock_guard<std::mutex> lock(m_exceptionMutex);
+
+      if (!m_exception) {
+        m_exception = std::current_exception();
+      }
+    }
+
+    m_numPending.fetch_sub(1);
+  });
+}
+
+inline void
+TaskGroup::wait()
+{
+  // Help out rather than block. The tasks of this group are either queued (so some thread, possibly this one,
+  // will pick them up) or running on another thread, in which case we yield until they are done.
+  while (m_numPending.load() > 0) {
+    if (!m_pool->runPendingTask()) {
+#if defined(EBGEOMETRY_ENABLE_THREADS)
+      std::this_thread::yield();
+#endif
+    }
+  }
+
+  std::exception_ptr exception;
+  {
+    std::lock_guard<std::mutex> lock(m_exceptionMutex);
+
+    std::swap(exception, m_exception);
+  }
+
+  if (exception) {
+    std::rethrow_exception(exception);
+  }
+}
+
+template <class F>
+inline void
+parallelFor(std::size_t a_begin, std::size_t a_end, std::size_t a_grainSize, F&& a_func)
+{
+  if (a_end <= a_begin) {
+    return;
+  }
+
+  const std::size_t numItems   = a_end - a_begin;
+  const std::size_t numThreads = getNumThreads();
+
+  std::size_t chunkSize = std::max(std::size_t(1), a_grainSize);
+  if (!isDeterministic()) {
+    // About eight chunks per thread balances load without drowning in scheduling overhead.
+    chunkSize = std::max(chunkSize, numItems / (8 * numThreads));
+  }
+
+  const std::size_t numChunks = (numItems + chunkSize - 1) / chunkSize;
+
+  auto runChunk = [&](std::size_t a_chunk) {
+    const std::size_t lo = a_begin + a_chunk * chunkSize;
+    const std::size_t hi = std::min(a_end, lo + chunkSize);
+
+    a_func(lo, hi);
+  };
+
+  if (numThreads == 1 || numChunks == 1) {
+    for (std::size_t chunk = 0; chunk < numChunks; chunk++) {
+      runChunk(chunk);
+    }
+
+    return;
+  }
+
+  // Chunks are claimed from a shared counter by one task per thread, so a slow chunk never holds up a
+  // pre-assigned block of others.
+  std::atomic<std::size_t> nextChunk{0};
+
+  auto worker = [&]() {
+    for (std::size_t chunk = nextChunk.fetch_add(1); chunk < numChunks; chunk = nextChunk.fetch_add(1)) {
+      runChunk(chunk);
+    }
+  };
+
+  TaskGroup         group;
+  const std::size_t numTasks = std::min(numThreads, numChunks) - 1;
+  for (std::size_t i = 0; i < numTasks; i++) {
+    group.run(worker);
+  }
+
+  try {
+    worker();
+  }
+  catch (...) {
+    // Stop handing out chunks and let the other tasks drain before the exception leaves this frame.
+    nextChunk.store(numChunks);
+    try {
+      group.wait();
+    }
+    catch (...) {
+    }
+
+    throw;
+  }
+
+  group.wait();
+}
+
+namespace Detail {
+
+inline uint64_t
+mix(uint64_t a_x) noexcept
+{
+  a_x ^= a_x >> 30;
+  a_x *= 0xBF58476D1CE4E5B9ULL;
+  a_x ^= a_x >> 27;
+  a_x *= 0x94D049BB133111EBULL;
+  a_x ^= a_x >> 31;
+
+  return a_x;
+}
+
+inline std::size_t
+numChunks(const std::size_t a_numItems, const std::size_t a_grainSize) noexcept
+{
+  const std::size_t grain = std::max(std::size_t(1), a_grainSize);
+
+  return std::max(std::size_t(1), std::min(a_numItems / grain, 4 * std::size_t(getNumThreads())));
+}
+
+inline std::size_t
+chunkBegin(const std::size_t a_numItems, const std::size_t a_numChunks, const std::size_t a_chunk) noexcept
+{
+  EBGEOMETRY_EXPECT(a_numChunks > 0);
+  EBGEOMETRY_EXPECT(a_chunk <= a_numChunks);
+
+  return (a_numItems * a_chunk) / a_numChunks;
+}
+
+template <class Key, class F>
+inline void
+forEachRun(const std::vector<Key>& a_sortedKeys,
+           const std::size_t       a_lo,
+           const std::size_t       a_hi,
+           const F&                a_func) noexcept
+{
+  const std::size_t numKeys = a_sortedKeys.size();
+
+  EBGEOMETRY_EXPECT(a_hi <= numKeys);
+
+  std::size_t begin = a_lo;
+  while (begin > 0 && begin < a_hi && a_sortedKeys[begin] == a_sortedKeys[begin - 1]) {
+    begin++;
+  }
+
+  while (begin < a_hi) {
+    std::size_t end = begin + 1;
+    while (end < numKeys && a_sortedKeys[end] == a_sortedKeys[begin]) {
+      end++;
+    }
+
+    a_func(begin, end);
+
+    begin = end;
+  }
+}
+
+template <class Keep, class Resize, class Emit>
+inline std::size_t
+compactInOrder(const std::size_t a_numItems,
+               const std::size_t a_grainSize,
+               const Keep&       a_keep,
+               const Resize&     a_resize,
+               const Emit&       a_emit) noexcept
+{
+  const std::size_t numChunks = Detail::numChunks(a_numItems, a_grainSize);
+
+  const auto chunkBegin = [a_numItems, numChunks](const std::size_t a_chunk) noexcept -> std::size_t {
+    return Detail::chunkBegin(a_numItems, numChunks, a_chunk);
+  };
+
+  std::vector<std::size_t> chunkOffsets(numChunks + 1, 0);
+
+  parallelFor(0, numChunks, 1, [&](const std::size_t a_lo, const std::size_t a_hi) noexcept {
+    for (std::size_t chunk = a_lo; chunk < a_hi; chunk++) {
+      for (std::size_t i = chunkBegin(chunk); i < chunkBegin(chunk + 1); i++) {
+        chunkOffsets[chunk + 1] += a_keep(i) ? 1 : 0;
+      }
+    }
+  });
+
+  for (std::size_t chunk = 0; chunk < numChunks; chunk++) {
+    chunkOffsets[chunk + 1] += chunkOffsets[chunk];
+  }
+
+  a_resize(chunkOffsets.back());
+
+  parallelFor(0, numChunks, 1, [&](const std::size_t a_lo, const std::size_t a_hi) noexcept {
+    for (std::size_t chunk = a_lo; chunk < a_hi; chunk++) {
+      std::size_t next = chunkOffsets[chunk];
+
+      for (std::size_t i = chunkBegin(chunk); i < chunkBegin(chunk + 1); i++) {
+        if (a_keep(i)) {
+          a_emit(i, next++);
+        }
+      }
+    }
+  });
+
+  return chunkOffsets.back();
+}
+
+} // namespace Detail
+
+} // namespace Parallel
+} // namespace EBGeometry
+
+#endif
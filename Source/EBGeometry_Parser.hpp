@@ -20,6 +20,7 @@
 
 // Our includes
 #include "EBGeometry_BoundingVolumes.hpp"
+#include "EBGeometry_DCEL_IndexedMesh.hpp"
 #include "EBGeometry_DCEL_Mesh.hpp"
 #include "EBGeometry_MeshDistanceFunctions.hpp"
 #include "EBGeometry_OBJ.hpp"
@@ -38,6 +39,11 @@ namespace EBGeometry {
  */
 namespace Parser {
 
+/**
+ * @brief Smallest number of STL records that decodeBinarySTL() hands to one thread.
+ */
+static constexpr size_t ParallelGrainSize = 16384;
+
 /**
  * @brief Simple enum for separating ASCII and binary files
  */
@@ -108,6 +114,48 @@ template <typename T>
 [[nodiscard]] STL<T>
 readSTL(const std::string& a_filename);
 
+/**
+ * @brief Read a binary STL file into a raw polygon soup.
+ * @details The file is memory-mapped where the platform supports it (and read in one piece otherwise), and decoded
+ * with decodeBinarySTL().
+ * @tparam T Floating-point precision used for vertex coordinates.
+ * @param[in]  a_filename STL file name.
+ * @param[out] a_vertices Vertex coordinates, three per facet unless a_weld is true.
+ * @param[out] a_facets   Facets, as indices into a_vertices.
+ * @param[in]  a_weld     If true, duplicate vertices are removed while decoding, as by Soup::compress().
+ * @return True if the file could be read, false (with a message on std::cerr) otherwise.
+ */
+template <typename T>
+[[nodiscard]] inline static bool
+readBinarySTL(const std::string&                a_filename,
+              std::vector<Vec3T<T>>&            a_vertices,
+              std::vector<std::vector<size_t>>& a_facets,
+              const bool                        a_weld = false) noexcept;
+
+/**
+ * @brief Decode a binary STL file held in memory into a raw polygon soup.
+ * @details The buffer must hold the 80-byte header, the facet count, and that many 50-byte facet records; a buffer
+ * that is too short is rejected, trailing bytes are ignored with a warning. The records are decoded in parallel
+ * chunks. Like readSTL(), this only keeps the first solid, i.e. the facets whose attribute word equals the smallest
+ * one in the file.
+ * @tparam T Floating-point precision used for vertex coordinates.
+ * @param[in]  a_data     Start of the file contents.
+ * @param[in]  a_size     Size of the file contents in bytes.
+ * @param[out] a_vertices Vertex coordinates, three per facet unless a_weld is true.
+ * @param[out] a_facets   Facets, as indices into a_vertices.
+ * @param[in]  a_weld     If true, duplicate vertices are removed while decoding, as by Soup::compress().
+ * @param[in]  a_source   Name of the data source, used in error messages.
+ * @return True if the buffer holds a binary STL file, false (with a message on std::cerr) otherwise.
+ */
+template <typename T>
+[[nodiscard]] inline static bool
+decodeBinarySTL(const char*                       a_data,
+                const size_t                      a_size,
+                std::vector<Vec3T<T>>&            a_vertices,
+                std::vector<std::vector<size_t>>& a_facets,
+                const bool                        a_weld,
+                const std::string&                a_source) noexcept;
+
 /**
  * @brief Read multiple STL files into raw STL data structures.
  * @tparam T Floating-point precision used for vertex coordinates.
@@ -182,6 +230,28 @@ template <typename T, typename Meta = DCEL::DefaultMetaData>
 [[nodiscard]] inline static std::vector<std::shared_ptr<EBGeometry::DCEL::MeshT<T, Meta>>>
 readIntoDCEL(const std::vector<std::string>& a_files);
 
+/**
+ * @brief Read a file containing a single watertight object and return it as an index-based DCEL mesh.
+ * @tparam T    Floating-point precision for vertex coordinates.
+ * @tparam Meta Per-face metadata type stored in the DCEL mesh.
+ * @param[in] a_filename File name (STL, PLY, VTK, or OBJ).
+ * @return Shared pointer to the constructed DCEL mesh.
+ */
+template <typename T, typename Meta = DCEL::DefaultMetaData>
+[[nodiscard]] inline static std::shared_ptr<EBGeometry::DCEL::IndexedMeshT<T, Meta>>
+readIntoIndexedDCEL(const std::string a_filename);
+
+/**
+ * @brief Read multiple files containing single watertight objects and return them as index-based DCEL meshes.
+ * @tparam T    Floating-point precision for vertex coordinates.
+ * @tparam Meta Per-face metadata type stored in the DCEL mesh.
+ * @param[in] a_files List of file names (STL, PLY, VTK, or OBJ).
+ * @return Vector of shared pointers to the constructed DCEL meshes, one per file.
+ */
+template <typename T, typename Meta = DCEL::DefaultMetaData>
+[[nodiscard]] inline static std::vector<std::shared_ptr<EBGeometry::DCEL::IndexedMeshT<T, Meta>>>
+readIntoIndexedDCEL(const std::vector<std::string>& a_files);
+
 /**
  * @brief Read a file and return it as a bare DCEL signed-distance function (O(N) scan, no BVH).
  * @tparam T    Floating-point precision for signed-distance evaluation.
@@ -235,7 +305,8 @@ readIntoPackedBVH(const std::vector<std::string>& a_files, const BVH::Build a_bu
 /**
  * @brief Read a file and return the mesh enclosed in a SIMD-optimised triangle BVH.
  * @details Triangles are grouped into SoA bundles of W and packed into a linearised K-ary BVH.
- * At query time the BVH uses SIMD intrinsics to evaluate W triangles per leaf visit.
+ * At query time the BVH uses SIMD intrinsics to evaluate W triangles per leaf visit. The triangles come from
+ * readIntoTriangles(), so no DCEL mesh is built on the way.
  * @tparam T    Floating-point precision for signed-distance evaluation.
  * @tparam Meta Per-face metadata type.
  * @tparam K    BVH branching factor. Defaults to BVH::DefaultBranchingRatio<T>() — the SIMD-optimal value for
@@ -250,7 +321,8 @@ readIntoPackedBVH(const std::vector<std::string>& a_files, const BVH::Build a_bu
  * @param[in] a_maxLeafGroups Maximum number of full W-sized TriangleSoA groups per BVH leaf; the
  * actual raw-triangle leaf-size bound used is a_maxLeafGroups * W (see TriMeshSDF's mesh-based
  * constructor for the tree-quality/SIMD-occupancy trade-off). Defaults to 4.
- * @param[in] a_build         BVH build strategy. SAH is the default and recommended choice.
+ * @param[in] a_build         BVH build strategy. SAH is the default and recommended choice; PLOC builds faster
+ * at close to SAH quality; SBVH suits meshes with long, thin triangles.
  * @return Shared pointer to the TriMeshSDF enclosing the mesh.
  */
 template <typename T,
@@ -274,7 +346,8 @@ readIntoTriangleBVH(const std::string a_filename,
  * @param[in] a_files         List of file names (STL, PLY, or VTK).
  * @param[in] a_maxLeafGroups Maximum number of full W-sized TriangleSoA groups per BVH leaf (see
  * the single-file overload for details). Defaults to 4.
- * @param[in] a_build         BVH build strategy. SAH is the default and recommended choice.
+ * @param[in] a_build         BVH build strategy. SAH is the default and recommended choice; PLOC builds faster
+ * at close to SAH quality; SBVH suits meshes with long, thin triangles.
  * @return Vector of shared pointers to TriMeshSDF objects, one per file.
  */
 template <typename T,
@@ -289,11 +362,13 @@ readIntoTriangleBVH(const std::vector<std::string>& a_files,
 
 /**
  * @brief Read a file and return all faces as a flat list of Triangle objects.
- * @details The mesh is first parsed into a DCEL, then each face is extracted into an
- * independent Triangle with precomputed vertex positions, normals, and edge normals.
+ * @details Each face becomes an independent Triangle with precomputed vertex positions, normals, and edge normals.
+ * These are computed directly from the compressed soup (see Soup::soupToTriangles()) without building a DCEL mesh,
+ * and polygons are fan-triangulated. The triangles live in one contiguous block which every returned pointer
+ * shares ownership of.
  * @tparam T    Floating-point precision for vertex coordinates and normals.
  * @tparam Meta Per-face metadata type.
- * @param[in] a_filename File name (STL, PLY, or VTK).
+ * @param[in] a_filename File name (STL, PLY, VTK, or OBJ).
  * @return Flat vector of shared pointers to Triangle objects.
  */
 template <typename T, typename Meta>
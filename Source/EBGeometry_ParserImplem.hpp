@@ -12,12 +12,14 @@
 #define EBGEOMETRY_PARSERIMPLEM_HPP
 
 // Std includes
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <fstream>
 #include <iostream>
 #include <iterator>
+#include <limits>
 #include <map>
 #include <memory>
 #include <sstream>
@@ -26,7 +28,15 @@
 #include <utility>
 #include <vector>
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 // Our includes
+#include "EBGeometry_Parallel.hpp"
 #include "EBGeometry_Parser.hpp"
 #include "EBGeometry_Soup.hpp"
 
@@ -251,97 +261,9 @@ Parser::readSTL(const std::string& a_filename)
     break;
   }
   case Parser::Encoding::Binary: {
-    std::ifstream fstream(a_filename);
-
-    if (fstream.is_open()) {
-
-      // Read STL header and discard that info rightaway.
-      char header[80];
-      fstream.read(header, 80);
-
-      // Read the number of triangles
-      char tmp[4];
-      fstream.read(tmp, 4);
-      uint32_t numTriangles;
-      memcpy(&numTriangles, &tmp, 4);
-
-      using VertexList = std::vector<Vec3T<T>>;
-      using FacetList  = std::vector<std::vector<size_t>>;
-
-      std::map<uint16_t, std::pair<VertexList, FacetList>> verticesAndFacets;
-
-      // Read triangles into raw vertices and facets.
-      char normal[12];
-      char v1[12];
-      char v2[12];
-      char v3[12];
-      char att[2];
-
-      float x;
-      float y;
-      float z;
-
-      uint16_t id;
-
-      for (size_t i = 0; i < numTriangles; i++) {
-        fstream.read(normal, 12);
-        fstream.read(v1, 12);
-        fstream.read(v2, 12);
-        fstream.read(v3, 12);
-        fstream.read(att, 2);
-
-        char* ptr = nullptr;
-
-        Vec3T<T> v[3];
-
-        ptr = v1;
-        memcpy(&x, ptr, 4);
-        ptr += 4;
-        memcpy(&y, ptr, 4);
-        ptr += 4;
-        memcpy(&z, ptr, 4);
-        v[0] = Vec3T<T>(static_cast<T>(x), static_cast<T>(y), static_cast<T>(z));
-
-        ptr = v2;
-        memcpy(&x, ptr, 4);
-        ptr += 4;
-        memcpy(&y, ptr, 4);
-        ptr += 4;
-        memcpy(&z, ptr, 4);
-        v[1] = Vec3T<T>(static_cast<T>(x), static_cast<T>(y), static_cast<T>(z));
-
-        ptr = v3;
-        memcpy(&x, ptr, 4);
-        ptr += 4;
-        memcpy(&y, ptr, 4);
-        ptr += 4;
-        memcpy(&z, ptr, 4);
-        v[2] = Vec3T<T>(static_cast<T>(x), static_cast<T>(y), static_cast<T>(z));
-
-        memcpy(&id, &att, 2);
-
-        if (verticesAndFacets.find(id) == verticesAndFacets.end()) {
-          verticesAndFacets.emplace(id, std::make_pair(VertexList(), FacetList()));
-        }
-
-        auto& objectVertices = verticesAndFacets.at(id).first;
-        auto& objectFacets   = verticesAndFacets.at(id).second;
-
-        // Insert a new facet.
-        std::vector<size_t> curFacet;
-        for (auto& j : v) {
-          objectVertices.emplace_back(j);
-          curFacet.emplace_back(objectVertices.size() - 1);
-        }
-
-        objectFacets.emplace_back(curFacet);
-      }
-
-      vertices = verticesAndFacets.begin()->second.first;
-      facets   = verticesAndFacets.begin()->second.second;
-    }
-    else {
-      std::cerr << "Parser::readSTL -- Error! Could not open binary file " + a_filename + "\n";
+    if (!Parser::readBinarySTL(a_filename, vertices, facets)) {
+      vertices.resize(0);
+      facets.resize(0);
     }
 
     break;
@@ -356,6 +278,177 @@ Parser::readSTL(const std::string& a_filename)
   return stl;
 }
 
+template <typename T>
+inline bool
+Parser::readBinarySTL(const std::string&                a_filename,
+                      std::vector<Vec3T<T>>&            a_vertices,
+                      std::vector<std::vector<size_t>>& a_facets,
+                      const bool                        a_weld) noexcept
+{
+  static_assert(std::is_floating_point_v<T>, "Parser::readBinarySTL requires T to be a floating-point type");
+
+#if defined(__unix__) || defined(__APPLE__)
+  const int fd = ::open(a_filename.c_str(), O_RDONLY);
+
+  if (fd < 0) {
+    std::cerr << "Parser::readBinarySTL -- Error! Could not open binary file " + a_filename + "\n";
+
+    return false;
+  }
+
+  struct stat status
+  {};
+
+  const bool   haveSize = ::fstat(fd, &status) == 0 && status.st_size > 0;
+  const size_t size     = haveSize ? size_t(status.st_size) : 0;
+  void* const  data     = haveSize ? ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+
+  // The mapping outlives the descriptor.
+  ::close(fd);
+
+  if (data == MAP_FAILED) {
+    std::cerr << "Parser::readBinarySTL -- Error! Could not map binary file " + a_filename + "\n";
+
+    return false;
+  }
+
+  // The records are read front to back.
+  ::madvise(data, size, MADV_SEQUENTIAL);
+
+  const char* const bytes = static_cast<const char*>(data);
+  const bool        ok    = Parser::decodeBinarySTL(bytes, size, a_vertices, a_facets, a_weld, a_filename);
+
+  ::munmap(data, size);
+
+  return ok;
+#else
+  std::ifstream fstream(a_filename, std::ios::binary | std::ios::ate);
+
+  if (!fstream.is_open()) {
+    std::cerr << "Parser::readBinarySTL -- Error! Could not open binary file " + a_filename + "\n";
+
+    return false;
+  }
+
+  std::vector<char> buffer(static_cast<size_t>(fstream.tellg()));
+
+  fstream.seekg(0);
+  fstream.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+
+  return Parser::decodeBinarySTL(buffer.data(), buffer.size(), a_vertices, a_facets, a_weld, a_filename);
+#endif
+}
+
+template <typename T>
+inline bool
+Parser::decodeBinarySTL(const char*                       a_data,
+                        const size_t                      a_size,
+                        std::vector<Vec3T<T>>&            a_vertices,
+                        std::vector<std::vector<size_t>>& a_facets,
+                        const bool                        a_weld,
+                        const std::string&                a_source) noexcept
+{
+  static_assert(std::is_floating_point_v<T>, "Parser::decodeBinarySTL requires T to be a floating-point type");
+
+  // 80-byte header, uint32 facet count, then per facet: normal, three vertices (12 floats) and a uint16 attribute.
+  constexpr size_t headerSize = 84;
+  constexpr size_t recordSize = 50;
+
+  a_vertices.resize(0);
+  a_facets.resize(0);
+
+  if (a_data == nullptr || a_size < headerSize) {
+    std::cerr << "Parser::decodeBinarySTL -- Error! '" + a_source + "' is too short to be a binary STL file\n";
+
+    return false;
+  }
+
+  uint32_t count;
+  std::memcpy(&count, a_data + 80, 4);
+
+  const size_t numRecords = size_t(count);
+
+  if ((a_size - headerSize) / recordSize < numRecords) {
+    std::cerr << "Parser::decodeBinarySTL -- Error! '" + a_source + "' declares " + std::to_string(numRecords) +
+                   " facets but only holds " + std::to_string((a_size - headerSize) / recordSize) + "\n";
+
+    return false;
+  }
+  if (a_size != headerSize + recordSize * numRecords) {
+    std::cerr << "Parser::decodeBinarySTL -- Warning! Ignoring trailing bytes after the facets in '" + a_source +
+                   "'\n";
+  }
+
+  const char* const records = a_data + headerSize;
+
+  const auto attribute = [records](const size_t a_record) noexcept -> uint16_t {
+    uint16_t id;
+    std::memcpy(&id, records + recordSize * a_record + 48, 2);
+
+    return id;
+  };
+
+  // Find the first solid (smallest attribute), then decode its facets in record order.
+  const size_t grain     = ParallelGrainSize;
+  const size_t numChunks = Parallel::Detail::numChunks(numRecords, grain);
+
+  std::vector<uint16_t> chunkMin(numChunks, std::numeric_limits<uint16_t>::max());
+
+  Parallel::parallelFor(0, numChunks, 1, [&](const size_t a_lo, const size_t a_hi) noexcept {
+    for (size_t chunk = a_lo; chunk < a_hi; chunk++) {
+      const size_t chunkEnd = Parallel::Detail::chunkBegin(numRecords, numChunks, chunk + 1);
+
+      for (size_t r = Parallel::Detail::chunkBegin(numRecords, numChunks, chunk); r < chunkEnd; r++) {
+        chunkMin[chunk] = std::min(chunkMin[chunk], attribute(r));
+      }
+    }
+  });
+
+  const uint16_t solid = *std::min_element(chunkMin.begin(), chunkMin.end());
+
+  const size_t numFacets = Parallel::Detail::compactInOrder(
+    numRecords,
+    grain,
+    [&attribute, solid](const size_t a_record) noexcept -> bool {
+      return attribute(a_record) == solid;
+    },
+    [&a_vertices](const size_t a_numFacets) noexcept -> void {
+      a_vertices.resize(3 * a_numFacets);
+    },
+    [&](const size_t a_record, const size_t a_facet) noexcept -> void {
+      // Skip the facet normal; EBGeometry always recomputes it.
+      float xyz[9];
+      std::memcpy(xyz, records + recordSize * a_record + 12, sizeof(xyz));
+
+      for (size_t v = 0; v < 3; v++) {
+        a_vertices[3 * a_facet + v] = Vec3T<T>(static_cast<T>(xyz[3 * v]),
+                                               static_cast<T>(xyz[3 * v + 1]),
+                                               static_cast<T>(xyz[3 * v + 2]));
+      }
+    });
+
+  // With welding, the vertices are compressed before the facets are built, so the facets come out final.
+  std::vector<uint32_t> remap;
+  if (a_weld) {
+    remap = Soup::weld(a_vertices);
+  }
+
+  a_facets.resize(numFacets);
+
+  Parallel::parallelFor(0, numFacets, grain, [&](const size_t a_lo, const size_t a_hi) noexcept {
+    for (size_t f = a_lo; f < a_hi; f++) {
+      if (a_weld) {
+        a_facets[f] = {size_t(remap[3 * f]), size_t(remap[3 * f + 1]), size_t(remap[3 * f + 2])};
+      }
+      else {
+        a_facets[f] = {3 * f, 3 * f + 1, 3 * f + 2};
+      }
+    }
+  });
+
+  return true;
+}
+
 template <typename T>
 [[nodiscard]] std::vector<STL<T>>
 Parser::readSTL(const std::vector<std::string>& a_filenames)
@@ -1814,6 +1907,73 @@ Parser::readIntoDCEL(const std::vector<std::string>& a_files)
   return objects;
 }
 
+template <typename T, typename Meta>
+[[nodiscard]] inline std::shared_ptr<EBGeometry::DCEL::IndexedMeshT<T, Meta>>
+Parser::readIntoIndexedDCEL(const std::string a_filename)
+{
+  static_assert(std::is_floating_point_v<T>, "Parser::readIntoIndexedDCEL requires T to be a floating-point type");
+  auto mesh = std::make_shared<EBGeometry::DCEL::IndexedMeshT<T, Meta>>();
+
+  const auto ft = Parser::getFileType(a_filename);
+
+  switch (ft) {
+  case Parser::FileType::STL: {
+    const STL<T> stl = readSTL<T>(a_filename);
+
+    mesh = stl.template convertToIndexedDCEL<Meta>();
+
+    break;
+  }
+  case Parser::FileType::PLY: {
+    const PLY<T> ply = readPLY<T>(a_filename);
+
+    mesh = ply.template convertToIndexedDCEL<Meta>();
+
+    break;
+  }
+  case Parser::FileType::VTK: {
+    const VTK<T> vtk = readVTK<T>(a_filename);
+
+    mesh = vtk.template convertToIndexedDCEL<Meta>();
+
+    break;
+  }
+  case Parser::FileType::OBJ: {
+    const OBJ<T> obj = readOBJ<T>(a_filename);
+
+    mesh = obj.template convertToIndexedDCEL<Meta>();
+
+    break;
+  }
+  case Parser::FileType::Unsupported: {
+    std::cerr << "Parser::read - file type unsupported for '" + a_filename + "'\n";
+
+    break;
+  }
+  default: {
+    std::cerr << "Parser::read - logic bust\n";
+
+    break;
+  }
+  }
+
+  return mesh;
+}
+
+template <typename T, typename Meta>
+[[nodiscard]] inline std::vector<std::shared_ptr<EBGeometry::DCEL::IndexedMeshT<T, Meta>>>
+Parser::readIntoIndexedDCEL(const std::vector<std::string>& a_files)
+{
+  std::vector<std::shared_ptr<EBGeometry::DCEL::IndexedMeshT<T, Meta>>> objects;
+
+  objects.reserve(a_files.size());
+  for (const auto& file : a_files) {
+    objects.emplace_back(Parser::readIntoIndexedDCEL<T, Meta>(file));
+  }
+
+  return objects;
+}
+
 template <typename T, typename Meta>
 [[nodiscard]] inline std::shared_ptr<FlatMeshSDF<T, Meta>>
 Parser::readIntoMesh(const std::string a_filename)
@@ -1841,34 +2001,55 @@ template <typename T, typename Meta>
 [[nodiscard]] std::vector<std::shared_ptr<Triangle<T, Meta>>>
 Parser::readIntoTriangles(const std::string a_filename)
 {
-  const auto mesh = Parser::readIntoDCEL<T, Meta>(a_filename);
+  static_assert(std::is_floating_point_v<T>, "Parser::readIntoTriangles requires T to be a floating-point type");
 
-  std::vector<std::shared_ptr<Triangle<T, Meta>>> triangles;
+  // The triangles are built straight from the soup (no DCEL) into one contiguous block.
+  std::vector<Triangle<T, Meta>> block;
 
-  bool onlyTriangles = true;
+  const auto ft = Parser::getFileType(a_filename);
 
-  for (const auto& f : mesh->getFaces()) {
-    const auto normal   = f->getNormal();
-    const auto vertices = f->gatherVertices();
-    const auto edges    = f->gatherEdges();
+  switch (ft) {
+  case Parser::FileType::STL: {
+    block = readSTL<T>(a_filename).template convertToTriangles<Meta>();
 
-    if (vertices.size() != 3) {
-      onlyTriangles = false;
-    }
+    break;
+  }
+  case Parser::FileType::PLY: {
+    block = readPLY<T>(a_filename).template convertToTriangles<Meta>();
+
+    break;
+  }
+  case Parser::FileType::VTK: {
+    block = readVTK<T>(a_filename).template convertToTriangles<Meta>();
 
-    // Create the triangle
-    auto tri = std::make_shared<Triangle<T, Meta>>();
+    break;
+  }
+  case Parser::FileType::OBJ: {
+    block = readOBJ<T>(a_filename).template convertToTriangles<Meta>();
 
-    tri->setNormal(normal);
-    tri->setVertexPositions({vertices[0]->getPosition(), vertices[1]->getPosition(), vertices[2]->getPosition()});
-    tri->setVertexNormals({vertices[0]->getNormal(), vertices[1]->getNormal(), vertices[2]->getNormal()});
-    tri->setEdgeNormals({vertices[0]->getNormal(), vertices[1]->getNormal(), vertices[2]->getNormal()});
+    break;
+  }
+  case Parser::FileType::Unsupported: {
+    std::cerr << "Parser::read - file type unsupported for '" + a_filename + "'\n";
 
-    triangles.emplace_back(tri);
+    break;
   }
+  default: {
+    std::cerr << "Parser::read - logic bust\n";
+
+    break;
+  }
+  }
+
+  // Hand out aliasing pointers into the block rather than allocating every triangle on its own. Each pointer keeps
+  // the whole block alive.
+  const auto storage = std::make_shared<std::vector<Triangle<T, Meta>>>(std::move(block));
+
+  std::vector<std::shared_ptr<Triangle<T, Meta>>> triangles;
 
-  if (!onlyTriangles) {
-    std::cerr << "Parser::readIntoTriangles -- file '" + a_filename + "' is not composed of only triangles!" << "\n";
+  triangles.reserve(storage->size());
+  for (auto& tri : *storage) {
+    triangles.emplace_back(storage, &tri);
   }
 
   return triangles;
@@ -21,6 +21,7 @@
 // Our includes
 #include "EBGeometry_BVH.hpp"
 #include "EBGeometry_BoundingVolumes.hpp"
+#include "EBGeometry_Parallel.hpp"
 #include "EBGeometry_PointAoSoA.hpp"
 #include "EBGeometry_PointSoA.hpp"
 #include "EBGeometry_Vec.hpp"
@@ -41,6 +42,10 @@ namespace EBGeometry {
  * metadata(). The class hides all of pruneTraverse()/the SoA leaf kernel/the seed-from-own-leaf
  * optimization behind a few high-level query methods.
  *
+ * Tree quality metrics come from the inherited PackedBVH::computeMetrics(), where primitives are the
+ * PointAoSoA groups. All queries, including the seeded self-queries with their own traversal loop,
+ * feed the BVH::TraversalStatistics counters when those are enabled.
+ *
  * @note Queries come in two flavours. *External* queries (closestPoint / closestPoints) take an
  * arbitrary point and traverse top-down. *Self* queries (nearestNeighbor / nearestNeighbors), and
  * the batch allNearestNeighbors(), take a point already in the cloud and additionally **seed the
@@ -76,6 +81,16 @@ public:
    */
   using Node = typename Base::Node;
 
+  /**
+   * @brief Leaf range type inherited from Base.
+   */
+  using Leaf = typename Base::Leaf;
+
+  /**
+   * @brief Self-contained node description (with its box) used by the build.
+   */
+  using NodeView = typename Base::NodeView;
+
   /**
    * @brief Axis-aligned bounding box type.
    */
@@ -119,6 +134,23 @@ public:
   [[nodiscard]] inline Hit
   closestPoint(const Vec3T<T>& a_query) const noexcept;
 
+  /**
+   * @brief Closest cloud point to each of a batch of arbitrary query points.
+   * @details Consecutive queries are carried through the tree s_packetSize at a time as one packet (see
+   * BVH::PackedBVH::packetPruneTraverse()), so a spatially coherent batch -- e.g. a block of grid cell centres --
+   * fetches each node once per packet instead of once per query. Incoherent batches remain correct.
+   * @param[in]  a_queries    Query points (need not be in the cloud).
+   * @param[in]  a_numQueries Number of query points.
+   * @param[out] a_out        Buffer of at least a_numQueries Hits; a_out[i] is the result for a_queries[i].
+   */
+  inline void
+  closestPoint(const Vec3T<T>* a_queries, std::size_t a_numQueries, Hit* a_out) const noexcept;
+
+  /**
+   * @brief Number of consecutive queries the batch queries carry through the tree as one packet.
+   */
+  static constexpr std::size_t s_packetSize = 16;
+
   /**
    * @brief The a_k closest cloud points to an arbitrary query point, nearest first.
    * @param[in]  a_query Query point (need not be in the cloud).
@@ -151,9 +183,11 @@ public:
    * @brief For every point, its a_k nearest *other* points (the k-nearest-neighbor graph).
    * @details Processes points in leaf (build) order -- already spatially coherent, so consecutive
    * queries touch nearby leaves and stay hot in cache, with no per-call sort -- and seeds each from
-   * its own leaf, so the whole batch is cheaper than the sum of independent queries. Result is
-   * flattened row-major: entry [i*a_k + j] is the j-th nearest neighbor of point i (ascending by
-   * distance).
+   * its own leaf, so the whole batch is cheaper than the sum of independent queries. For a_k == 1,
+   * consecutive points additionally share one packet traversal (see closestPoint() batch). Blocks of
+   * points run in parallel on the thread pool (see Parallel::parallelFor()); the result does not depend
+   * on the thread count. Result is flattened row-major: entry [i*a_k + j] is the j-th nearest neighbor
+   * of point i (ascending by distance).
    * @param[in] a_k Number of neighbors per point.
    * @return A vector of size numPoints()*a_k of Hits.
    */
@@ -244,7 +278,7 @@ private:
    */
   struct BuildResult
   {
-    std::vector<Node>          nodes;      ///< Flat BVH nodes in depth-first layout.
+    std::vector<NodeView>      nodes;      ///< Flat BVH nodes in depth-first layout.
     std::vector<PointGroup>    primitives; ///< Packed SoA leaf groups referenced by the leaf nodes.
     std::vector<std::uint32_t> leafOff;    ///< Per-point own-leaf group offset (for seeding).
     std::vector<std::uint32_t> leafCnt;    ///< Per-point own-leaf group count (for seeding).
@@ -295,6 +329,20 @@ private:
         std::uint32_t   a_seedOff,
         std::uint32_t   a_seedCnt) const noexcept;
 
+  /**
+   * @brief The packet query core: the single nearest cloud point to each of up to s_packetSize points.
+   * @param[in]  a_queries    Query points, one per lane.
+   * @param[in]  a_self       Cloud index of each query point (self-queries: excluded from its own result and
+   *                          seeded from its own leaf), or nullptr for external queries.
+   * @param[in]  a_numQueries Number of lanes; at most s_packetSize.
+   * @param[out] a_out        One Hit per lane; left untouched for a lane that finds no point.
+   */
+  inline void
+  queryPacket(const Vec3T<T>*    a_queries,
+              const std::size_t* a_self,
+              std::size_t        a_numQueries,
+              Hit*               a_out) const noexcept;
+
   /**
    * @brief Brute-force single nearest by full scan (shared by closestPointBruteForce /
    * nearestNeighborBruteForce).
@@ -322,6 +370,11 @@ private:
    */
   static constexpr std::size_t s_none = std::numeric_limits<std::size_t>::max();
 
+  /**
+   * @brief Smallest number of query points allNearestNeighbors() hands to one thread at a time.
+   */
+  static constexpr std::size_t s_parallelGrainSize = 256;
+
   /**
    * @brief Point positions, indexed by cloud index. Kept for self-query points and spatial ordering.
    */
@@ -291,6 +291,9 @@ PointCloudBVH<T, Meta, K, W>::query(const Vec3T<T>& a_query,
       // without paying pruneTraverse's per-interior-node child-sort and its separate m_childAabbSoA
       // SIMD load. For these cheap SoA point leaves that makes the unordered DFS ~20% faster. (This
       // holds ONLY because of the seed: see the external branch below.)
+      BVH::Detail::TraversalCounter counter;
+
+      counter.visitLeaf(a_seedCnt);
       scanLeafBest(best, a_seedOff, a_seedCnt);
 
       // Prune-before-push scalar DFS: a child is pushed only when its bounding volume is closer than
@@ -300,33 +303,49 @@ PointCloudBVH<T, Meta, K, W>::query(const Vec3T<T>& a_query,
       // convention; the guard catches a pathological overrun in debug builds.
       constexpr int maxStack = 256;
 
-      std::uint32_t stack[maxStack];
-      int           stackTop = 0;
+      // Interior nodes do not store their own box (it lives in the parent's SoA record), so each stack
+      // entry carries the squared box distance computed when it was pushed.
+      struct Entry
+      {
+        std::uint32_t node;
+        T             d2;
+      };
+
+      Entry stack[maxStack];
+      int   stackTop = 0;
 
-      stack[stackTop++] = 0U;
+      stack[stackTop++] = {0U, this->getBoundingVolume().getDistance2(a_query)};
+
+      const Leaf* const leaves = this->getLeafData();
 
       while (stackTop > 0) {
-        const Node& node = this->m_linearNodes[stack[--stackTop]];
+        const Entry entry = stack[--stackTop];
+        const Node& node  = this->m_linearNodes[entry.node];
 
-        if (node.getDistanceToBoundingVolume2(a_query) >= best.distanceSquared) {
+        if (entry.d2 >= best.distanceSquared) {
           continue; // stale: best tightened since this node was pushed
         }
 
+        counter.visitNode();
+
         if (node.isLeaf()) {
-          const std::uint32_t primOffset = node.getPrimitivesOffset();
+          const Leaf& leaf = leaves[node.getLeafIndex()];
 
-          if (primOffset != a_seedOff) {
-            scanLeafBest(best, primOffset, node.getNumPrimitives());
+          if (leaf.m_primOff != a_seedOff) {
+            counter.visitLeaf(leaf.m_numPrims);
+            scanLeafBest(best, leaf.m_primOff, leaf.m_numPrims);
           }
         }
         else {
           const auto& childOffsets = node.getChildOffsets();
 
-          for (std::size_t k = 0; k < K; k++) {
-            if (this->m_linearNodes[childOffsets[k]].getDistanceToBoundingVolume2(a_query) < best.distanceSquared) {
+          for (std::size_t k = 0; k < node.getNumChildren(); k++) {
+            const T d2 = this->getChildBoundingVolume(node.getChildBoxesIndex(), k).getDistance2(a_query);
+
+            if (d2 < best.distanceSquared) {
               EBGEOMETRY_EXPECT(stackTop < maxStack);
 
-              stack[stackTop++] = childOffsets[k];
+              stack[stackTop++] = {childOffsets[k], d2};
             }
           }
         }
@@ -426,6 +445,102 @@ PointCloudBVH<T, Meta, K, W>::query(const Vec3T<T>& a_query,
   a_found = state.found;
 }
 
+template <class T, class Meta, size_t K, size_t W>
+inline void
+PointCloudBVH<T, Meta, K, W>::queryPacket(const Vec3T<T>*    a_queries,
+                                          const std::size_t* a_self,
+                                          std::size_t        a_numQueries,
+                                          Hit*               a_out) const noexcept
+{
+  EBGEOMETRY_EXPECT(a_numQueries <= s_packetSize);
+  EBGEOMETRY_EXPECT(a_numQueries == 0 || a_queries != nullptr);
+  EBGEOMETRY_EXPECT(a_numQueries == 0 || a_out != nullptr);
+
+  if (a_numQueries == 0 || this->m_linearNodes.empty()) {
+    return;
+  }
+
+  // Same lean single-nearest state as query()'s k == 1 fast path, one per lane.
+  struct Best
+  {
+    T           distanceSquared = std::numeric_limits<T>::max();
+    std::size_t index           = s_none;
+  };
+
+  std::array<Best, s_packetSize>          best;
+  std::array<std::size_t, s_packetSize>   exclude;
+  std::array<std::uint32_t, s_packetSize> seedOff;
+  std::array<std::uint32_t, s_packetSize> seedCnt;
+
+  const auto scanLeafBest = [this](Best&           a_best,
+                                   const Vec3T<T>& a_query,
+                                   std::size_t     a_exclude,
+                                   std::size_t     a_off,
+                                   std::size_t     a_cnt) noexcept {
+    // Scan into a local copy: the lane states live in an array the compiler cannot prove disjoint from the
+    // primitives, so updating them in place would force a reload of every lane's metadata.
+    Best running = a_best;
+
+    for (std::size_t g = 0; g < a_cnt; g++) {
+      const PointGroup&      group     = this->m_primitives[a_off + g];
+      const std::array<T, W> distances = group.getDistances2(a_query);
+
+      for (std::size_t lane = 0; lane < W; lane++) {
+        const std::size_t cloudIndex = group.getMetaData(lane);
+
+        if (cloudIndex != a_exclude && distances[lane] < running.distanceSquared) {
+          running.distanceSquared = distances[lane];
+          running.index           = cloudIndex;
+        }
+      }
+    }
+
+    a_best = running;
+  };
+
+  for (std::size_t lane = 0; lane < a_numQueries; lane++) {
+    EBGEOMETRY_EXPECT(std::isfinite(a_queries[lane][0]));
+    EBGEOMETRY_EXPECT(std::isfinite(a_queries[lane][1]));
+    EBGEOMETRY_EXPECT(std::isfinite(a_queries[lane][2]));
+
+    best[lane]    = Best();
+    exclude[lane] = s_none;
+    seedOff[lane] = 0;
+    seedCnt[lane] = 0;
+
+    // Self-queries seed each lane from its own leaf, exactly as query() does, and skip that leaf below.
+    if (a_self != nullptr) {
+      const std::size_t p = a_self[lane];
+
+      EBGEOMETRY_EXPECT(p < m_positions.size());
+
+      exclude[lane] = p;
+      seedOff[lane] = m_leafOff[p];
+      seedCnt[lane] = m_leafCnt[p];
+
+      scanLeafBest(best[lane], a_queries[lane], p, seedOff[lane], seedCnt[lane]);
+    }
+  }
+
+  const auto evalLeaf = [&](Best& a_best, std::size_t a_lane, std::size_t a_off, std::size_t a_cnt) noexcept {
+    if (seedCnt[a_lane] > 0 && static_cast<std::uint32_t>(a_off) == seedOff[a_lane]) {
+      return; // own leaf already scanned in the seed
+    }
+
+    scanLeafBest(a_best, a_queries[a_lane], exclude[a_lane], a_off, a_cnt);
+  };
+
+  const auto pruneDist2 = [](const Best& a_best) noexcept -> T { return a_best.distanceSquared; };
+
+  this->packetPruneTraverse(a_queries, best.data(), a_numQueries, evalLeaf, pruneDist2);
+
+  for (std::size_t lane = 0; lane < a_numQueries; lane++) {
+    if (best[lane].index != s_none) {
+      a_out[lane] = Hit{best[lane].index, best[lane].distanceSquared};
+    }
+  }
+}
+
 template <class T, class Meta, size_t K, size_t W>
 inline typename PointCloudBVH<T, Meta, K, W>::Hit
 PointCloudBVH<T, Meta, K, W>::closestPoint(const Vec3T<T>& a_query) const noexcept
@@ -438,6 +553,26 @@ PointCloudBVH<T, Meta, K, W>::closestPoint(const Vec3T<T>& a_query) const noexce
   return hit;
 }
 
+template <class T, class Meta, size_t K, size_t W>
+inline void
+PointCloudBVH<T, Meta, K, W>::closestPoint(const Vec3T<T>* a_queries,
+                                           std::size_t     a_numQueries,
+                                           Hit*            a_out) const noexcept
+{
+  EBGEOMETRY_EXPECT(a_numQueries == 0 || a_queries != nullptr);
+  EBGEOMETRY_EXPECT(a_numQueries == 0 || a_out != nullptr);
+
+  for (std::size_t begin = 0; begin < a_numQueries; begin += s_packetSize) {
+    const std::size_t count = std::min(s_packetSize, a_numQueries - begin);
+
+    for (std::size_t i = begin; i < begin + count; i++) {
+      a_out[i] = Hit();
+    }
+
+    this->queryPacket(a_queries + begin, nullptr, count, a_out + begin);
+  }
+}
+
 template <class T, class Meta, size_t K, size_t W>
 inline std::size_t
 PointCloudBVH<T, Meta, K, W>::closestPoints(const Vec3T<T>& a_query, std::size_t a_k, Hit* a_out) const noexcept
@@ -495,14 +630,55 @@ PointCloudBVH<T, Meta, K, W>::allNearestNeighbors(std::size_t a_k) const
   // consecutive queries touch nearby leaves and each seeded own-leaf stays hot in cache -- the same
   // benefit a Hilbert sort would give, but reusing m_order costs nothing per call (no re-sort).
   // Ordering affects only speed, not results.
-  for (const std::uint32_t p : m_order) {
-    EBGEOMETRY_EXPECT(p < numPoints);
+  //
+  // Every query writes only its own rows of the result, so blocks of consecutive points run in parallel and the
+  // result does not depend on the thread count.
+  if (a_k == 1) {
+    // Consecutive points in leaf order mostly share a leaf, so packets of them walk nearly the same nodes.
+    const std::size_t numPackets = (numPoints + s_packetSize - 1) / s_packetSize;
 
-    std::size_t found = 0;
+    Parallel::parallelFor(0, numPackets, s_parallelGrainSize / s_packetSize, [&](std::size_t a_lo, std::size_t a_hi) {
+      std::array<Vec3T<T>, s_packetSize>    queries;
+      std::array<std::size_t, s_packetSize> self;
+      std::array<Hit, s_packetSize>         hits;
+
+      for (std::size_t packet = a_lo; packet < a_hi; packet++) {
+        const std::size_t begin = packet * s_packetSize;
+        const std::size_t count = std::min(s_packetSize, numPoints - begin);
+
+        for (std::size_t lane = 0; lane < count; lane++) {
+          const std::uint32_t p = m_order[begin + lane];
+
+          EBGEOMETRY_EXPECT(p < numPoints);
+
+          queries[lane] = m_positions[p];
+          self[lane]    = p;
+          hits[lane]    = Hit();
+        }
 
-    this->query(m_positions[p], a_k, &result[p * a_k], found, p, m_leafOff[p], m_leafCnt[p]);
+        this->queryPacket(queries.data(), self.data(), count, hits.data());
+
+        for (std::size_t lane = 0; lane < count; lane++) {
+          result[self[lane]] = hits[lane];
+        }
+      }
+    });
+
+    return result;
   }
 
+  Parallel::parallelFor(0, numPoints, s_parallelGrainSize, [&](std::size_t a_lo, std::size_t a_hi) {
+    for (std::size_t i = a_lo; i < a_hi; i++) {
+      const std::uint32_t p = m_order[i];
+
+      EBGEOMETRY_EXPECT(p < numPoints);
+
+      std::size_t found = 0;
+
+      this->query(m_positions[p], a_k, &result[p * a_k], found, p, m_leafOff[p], m_leafCnt[p]);
+    }
+  });
+
   return result;
 }
 
@@ -19,6 +19,7 @@
 #include <vector>
 
 // Our includes
+#include "EBGeometry_Parallel.hpp"
 #include "EBGeometry_Vec.hpp"
 
 namespace EBGeometry {
@@ -95,6 +96,17 @@ public:
   [[nodiscard]] inline Hit
   closestPoint(const Vec3T<T>& a_query) const noexcept;
 
+  /**
+   * @brief Closest cloud point to each of a batch of arbitrary query points.
+   * @details Same contract as PointCloudBVH's batch closestPoint(). Each query already touches only a
+   * shell or two of cells, so the grid simply answers them one by one.
+   * @param[in]  a_queries    Query points (need not be in the cloud).
+   * @param[in]  a_numQueries Number of query points.
+   * @param[out] a_out        Buffer of at least a_numQueries Hits; a_out[i] is the result for a_queries[i].
+   */
+  inline void
+  closestPoint(const Vec3T<T>* a_queries, std::size_t a_numQueries, Hit* a_out) const noexcept;
+
   /**
    * @brief The a_k closest cloud points to an arbitrary query point, nearest first.
    * @param[in]  a_query Query point (need not be in the cloud).
@@ -126,8 +138,9 @@ public:
   /**
    * @brief For every point, its a_k nearest *other* points (the k-nearest-neighbor graph).
    * @details Processes points in cell (spatial) order so consecutive queries touch nearby cells and
-   * stay hot in cache. Result is flattened row-major: entry [i*a_k + j] is the j-th nearest neighbor
-   * of point i (ascending by distance).
+   * stay hot in cache. Blocks of points run in parallel on the thread pool (see
+   * Parallel::parallelFor()); the result does not depend on the thread count. Result is flattened
+   * row-major: entry [i*a_k + j] is the j-th nearest neighbor of point i (ascending by distance).
    * @param[in] a_k Number of neighbors per point.
    * @return A vector of size numPoints()*a_k of Hits.
    */
@@ -274,6 +287,11 @@ private:
    */
   static constexpr std::size_t s_none = std::numeric_limits<std::size_t>::max();
 
+  /**
+   * @brief Smallest number of query points allNearestNeighbors() hands to one thread at a time.
+   */
+  static constexpr std::size_t s_parallelGrainSize = 256;
+
   /**
    * @brief Point positions, indexed by cloud index.
    */
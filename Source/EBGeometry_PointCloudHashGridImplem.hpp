@@ -318,6 +318,20 @@ PointCloudHashGrid<T, Meta>::closestPoint(const Vec3T<T>& a_query) const noexcep
   return hit;
 }
 
+template <class T, class Meta>
+inline void
+PointCloudHashGrid<T, Meta>::closestPoint(const Vec3T<T>* a_queries,
+                                          std::size_t     a_numQueries,
+                                          Hit*            a_out) const noexcept
+{
+  EBGEOMETRY_EXPECT(a_numQueries == 0 || a_queries != nullptr);
+  EBGEOMETRY_EXPECT(a_numQueries == 0 || a_out != nullptr);
+
+  for (std::size_t i = 0; i < a_numQueries; i++) {
+    a_out[i] = this->closestPoint(a_queries[i]);
+  }
+}
+
 template <class T, class Meta>
 inline std::size_t
 PointCloudHashGrid<T, Meta>::closestPoints(const Vec3T<T>& a_query, std::size_t a_k, Hit* a_out) const noexcept
@@ -372,14 +386,19 @@ PointCloudHashGrid<T, Meta>::allNearestNeighbors(std::size_t a_k) const
   std::vector<Hit> result(numPoints * a_k);
 
   // Process points in cell (spatial) order -- consecutive queries touch nearby cells, staying hot in
-  // cache. m_cellPoints already holds the cloud indices in cell order.
-  for (const std::uint32_t p : m_cellPoints) {
-    EBGEOMETRY_EXPECT(std::size_t(p) < numPoints);
+  // cache. m_cellPoints already holds the cloud indices in cell order. Every query writes only its own rows of the
+  // result, so blocks of consecutive points run in parallel and the result does not depend on the thread count.
+  Parallel::parallelFor(0, m_cellPoints.size(), s_parallelGrainSize, [&](std::size_t a_lo, std::size_t a_hi) {
+    for (std::size_t i = a_lo; i < a_hi; i++) {
+      const std::uint32_t p = m_cellPoints[i];
 
-    std::size_t found = 0;
+      EBGEOMETRY_EXPECT(std::size_t(p) < numPoints);
 
-    this->query(m_positions[p], a_k, &result[std::size_t(p) * a_k], found, std::size_t(p));
-  }
+      std::size_t found = 0;
+
+      this->query(m_positions[p], a_k, &result[std::size_t(p) * a_k], found, std::size_t(p));
+    }
+  });
 
   return result;
 }
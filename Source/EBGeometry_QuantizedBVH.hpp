@@ -0,0 +1,262 @@
+// SPDX-FileCopyrightText: 2026 Robert Marskar <robert.marskar@sintef.no>
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+/**
+ * @file    EBGeometry_QuantizedBVH.hpp
+ * @brief   A compressed, read-only BVH whose child boxes are quantized to 8 or 16 bits relative to their parent.
+ * @author  Robert Marskar
+ */
+
+#ifndef EBGEOMETRY_QUANTIZEDBVH_HPP
+#define EBGEOMETRY_QUANTIZEDBVH_HPP
+
+// Std includes
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#if defined(__SSE4_1__) || defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+// Our includes
+#include "EBGeometry_BVH.hpp"
+#include "EBGeometry_BoundingVolumes.hpp"
+#include "EBGeometry_Vec.hpp"
+
+namespace EBGeometry {
+
+namespace BVH {
+
+/**
+ * @brief A compressed copy of a PackedBVH for distance queries on large meshes.
+ * @details A PackedBVH stores the box of every node in full precision, in its parent's SoA record. Here only
+ * interior nodes are stored, and each stores the boxes of its K children as Q-bit integers on a
+ * grid spanning the node's own box: one origin and one grid spacing per axis in full precision, then K lower and
+ * K upper grid indices per axis. Lower corners are rounded down and upper corners up, with a small outward margin
+ * that absorbs the floating-point error of the dequantization, so every dequantized box contains the exact box.
+ * Pruning therefore never skips a subtree that pruneTraverse() on the original tree would visit, and queries give
+ * the same results -- at the cost of visiting a few more nodes, as the quantized boxes are slightly larger.
+ *
+ * A child slot refers either to another interior node or, with s_leafFlag set, to a Leaf record holding the
+ * primitive range. Leaves are not nodes, so they take no box storage at all. With Q = uint8_t, K = 4 and
+ * T = float one node fills exactly one 64-byte cache line; in double precision with K = 8 a node takes 128 bytes,
+ * against about 420 bytes per interior node (node plus SoA record) in a PackedBVH.
+ *
+ * The tree is read-only: it is built once from a finished PackedBVH, whose primitives are copied. To follow
+ * moving geometry, refit the PackedBVH and compress it again.
+ *
+ * @tparam T             Floating-point precision.
+ * @tparam P             Primitive type.
+ * @tparam K             Branching factor.
+ * @tparam Q             Integer type of the quantized boxes: uint8_t or uint16_t.
+ * @tparam StoragePolicy Storage policy of the primitive array, as in PackedBVH.
+ */
+template <class T, class P, size_t K, class Q, class StoragePolicy>
+class QuantizedBVH
+{
+  static_assert(std::is_floating_point_v<T>, "QuantizedBVH: T must be a floating-point type");
+  static_assert(K >= 2, "QuantizedBVH: branching factor K must be at least 2");
+  static_assert(std::is_same_v<Q, uint8_t> || std::is_same_v<Q, uint16_t>,
+                "QuantizedBVH: Q must be uint8_t or uint16_t");
+
+public:
+  /**
+   * @brief AABB type of the full-precision boxes.
+   */
+  using BV = EBGeometry::BoundingVolumes::AABBT<T>;
+
+  /**
+   * @brief Storage representation of one entry in the primitive array.
+   */
+  using StorageType = typename StoragePolicy::StorageType;
+
+  /**
+   * @brief The uncompressed tree this is built from.
+   */
+  using Packed = PackedBVH<T, P, K, StoragePolicy>;
+
+  /**
+   * @brief Set in a child reference that refers to a Leaf rather than to a QuantizedNode.
+   */
+  static constexpr uint32_t s_leafFlag = 0x80000000U;
+
+  /**
+   * @brief Interior node: the boxes of its K children, quantized on a grid spanning the node's own box.
+   */
+  struct QuantizedNode
+  {
+    /**
+     * @brief Grid origin, per axis: the low corner of the node's box, moved outward by the rounding margin.
+     */
+    T m_origin[3];
+
+    /**
+     * @brief Grid spacing, per axis.
+     */
+    T m_scale[3];
+
+    /**
+     * @brief Lower grid indices of the child boxes: m_lo[axis][child], rounded down.
+     */
+    Q m_lo[3][K];
+
+    /**
+     * @brief Upper grid indices of the child boxes: m_hi[axis][child], rounded up.
+     */
+    Q m_hi[3][K];
+
+    /**
+     * @brief Child references: a QuantizedNode index, or a Leaf index with s_leafFlag set.
+     * @details Unused slots hold BVH::EmptyChild.
+     */
+    uint32_t m_child[K];
+
+    /**
+     * @brief Expand the child boxes to full precision, SoA layout (the same as PackedBVH's SoA cache).
+     * @details Vectorized with SSE4.1/AVX where K is a multiple of the vector width, scalar otherwise.
+     * @param[out] a_lo Lower corners: a_lo[axis][child].
+     * @param[out] a_hi Upper corners: a_hi[axis][child].
+     */
+    inline void
+    dequantize(T (&a_lo)[3][K], T (&a_hi)[3][K]) const noexcept;
+  };
+
+  /**
+   * @brief Leaf: a range in the primitive array.
+   */
+  struct Leaf
+  {
+    /**
+     * @brief Index of the first primitive.
+     */
+    uint32_t m_primOff;
+
+    /**
+     * @brief Number of primitives.
+     */
+    uint32_t m_numPrims;
+  };
+
+  /**
+   * @brief Disallowed weak construction.
+   */
+  QuantizedBVH() = delete;
+
+  /**
+   * @brief Compress a finished PackedBVH (owned or mapped). Interior nodes are quantized in parallel.
+   * @details Interior nodes and leaves keep the depth-first order of @p a_bvh, and the primitives are copied in
+   * the same order, so the leaves reference the same primitive ranges as in @p a_bvh.
+   * @param[in] a_bvh Tree to compress. Must not be empty.
+   */
+  explicit inline QuantizedBVH(const Packed& a_bvh);
+
+  /**
+   * @brief Get the global primitive list (in leaf-traversal order).
+   * @return Reference to m_primitives.
+   */
+  [[nodiscard]] inline const std::vector<StorageType>&
+  getPrimitives() const noexcept;
+
+  /**
+   * @brief Get the interior nodes, in depth-first order.
+   * @return Reference to m_nodes.
+   */
+  [[nodiscard]] inline const std::vector<QuantizedNode>&
+  getNodes() const noexcept;
+
+  /**
+   * @brief Get the leaves, in depth-first order.
+   * @return Reference to m_leaves.
+   */
+  [[nodiscard]] inline const std::vector<Leaf>&
+  getLeaves() const noexcept;
+
+  /**
+   * @brief Get the reference to the root: the first interior node, or a single leaf.
+   * @return Child reference of the root.
+   */
+  [[nodiscard]] inline uint32_t
+  getRoot() const noexcept;
+
+  /**
+   * @brief Get the full-precision bounding volume of the root.
+   * @return Reference to m_bv.
+   */
+  [[nodiscard]] inline const BV&
+  getBoundingVolume() const noexcept;
+
+  /**
+   * @brief Compute and return the bounding volume of this BVH.
+   * @return Root bounding volume.
+   */
+  [[nodiscard]] inline BV
+  computeBoundingVolume() const noexcept;
+
+  /**
+   * @brief Distance-pruned traversal; the same contract as PackedBVH::pruneTraverse().
+   * @details At each interior node the K child boxes are dequantized with SIMD, their squared distances to
+   * @p a_point computed, and the children within the current pruning bound pushed farthest-first, so the nearest
+   * is visited next. Since the dequantized boxes contain the exact ones, a nearest-primitive search finds the
+   * same minimum as PackedBVH::pruneTraverse().
+   * @tparam State            Caller-defined running search state.
+   * @tparam LeafEvaluator    Callable: (State&, size_t offset, size_t count) noexcept -> void.
+   * @tparam PruneDistSquared Callable: (const State&) noexcept -> T. Squared pruning bound.
+   * @param[in]     a_point      Query point.
+   * @param[in,out] a_state      Running search state.
+   * @param[in]     a_evalLeaf   Leaf-visit callback.
+   * @param[in]     a_pruneDist2 Pruning-bound callback.
+   */
+  template <class State, class LeafEvaluator, class PruneDistSquared>
+  inline void
+  pruneTraverse(const Vec3T<T>&    a_point,
+                State&             a_state,
+                LeafEvaluator&&    a_evalLeaf,
+                PruneDistSquared&& a_pruneDist2) const noexcept;
+
+protected:
+  /**
+   * @brief Full-precision bounding volume of the root.
+   */
+  BV m_bv;
+
+  /**
+   * @brief Child reference of the root.
+   */
+  uint32_t m_root;
+
+  /**
+   * @brief Interior nodes in depth-first order.
+   */
+  std::vector<QuantizedNode> m_nodes;
+
+  /**
+   * @brief Leaves in depth-first order.
+   */
+  std::vector<Leaf> m_leaves;
+
+  /**
+   * @brief Global primitive list in leaf-traversal order.
+   */
+  std::vector<StorageType> m_primitives;
+
+  /**
+   * @brief Quantize the child boxes of one interior node.
+   * @param[out] a_node     Node to fill (grid and child boxes; not the child references).
+   * @param[in]  a_parent   Box of the node.
+   * @param[in]  a_children Boxes of its K children.
+   */
+  static inline void
+  quantize(QuantizedNode& a_node, const BV& a_parent, const BV* const (&a_children)[K]) noexcept;
+};
+
+} // namespace BVH
+
+} // namespace EBGeometry
+
+#include "EBGeometry_QuantizedBVHImplem.hpp"
+
+#endif
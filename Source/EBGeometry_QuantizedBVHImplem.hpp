@@ -0,0 +1,364 @@
+// SPDX-FileCopyrightText: 2026 Robert Marskar <robert.marskar@sintef.no>
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+/**
+ * @file    EBGeometry_QuantizedBVHImplem.hpp
+ * @brief   Implementation of EBGeometry_QuantizedBVH.hpp
+ * @author  Robert Marskar
+ */
+
+#ifndef EBGEOMETRY_QUANTIZEDBVHIMPLEM_HPP
+#define EBGEOMETRY_QUANTIZEDBVHIMPLEM_HPP
+
+// Std includes
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+// Our includes
+#include "EBGeometry_Macros.hpp"
+#include "EBGeometry_Parallel.hpp"
+#include "EBGeometry_QuantizedBVH.hpp"
+
+namespace EBGeometry {
+
+namespace BVH {
+
+namespace Detail {
+
+#if defined(__SSE4_1__)
+/**
+ * @brief Load four quantized values and widen them to 32-bit integers.
+ * @tparam Q uint8_t or uint16_t.
+ * @param[in] a_values First of the four values. Need not be aligned.
+ * @return The values as four 32-bit lanes.
+ */
+template <class Q>
+inline __m128i
+loadQuantized4(const Q* a_values) noexcept
+{
+  if constexpr (std::is_same_v<Q, uint8_t>) {
+    int32_t bytes;
+    std::memcpy(&bytes, a_values, sizeof(bytes));
+
+    return _mm_cvtepu8_epi32(_mm_cvtsi32_si128(bytes));
+  }
+  else {
+    return _mm_cvtepu16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(a_values)));
+  }
+}
+#endif
+
+} // namespace Detail
+
+template <class T, class P, size_t K, class Q, class StoragePolicy>
+inline void
+QuantizedBVH<T, P, K, Q, StoragePolicy>::QuantizedNode::dequantize(T (&a_lo)[3][K], T (&a_hi)[3][K]) const noexcept
+{
+  // Every path computes origin + q * scale with a separate multiply and add; quantize() leaves a margin for the
+  // rounding of either form, so a compiler that fuses the scalar path into an FMA is harmless.
+#if defined(__AVX__)
+  if constexpr (K % 8 == 0 && std::is_same_v<T, float>) {
+    for (size_t dir = 0; dir < 3; dir++) {
+      const __m256 origin = _mm256_set1_ps(m_origin[dir]);
+      const __m256 scale  = _mm256_set1_ps(m_scale[dir]);
+
+      for (size_t k = 0; k < K; k += 8) {
+        const __m256i lo = _mm256_insertf128_si256(
+          _mm256_castsi128_si256(Detail::loadQuantized4(&m_lo[dir][k])), Detail::loadQuantized4(&m_lo[dir][k + 4]), 1);
+        const __m256i hi = _mm256_insertf128_si256(
+          _mm256_castsi128_si256(Detail::loadQuantized4(&m_hi[dir][k])), Detail::loadQuantized4(&m_hi[dir][k + 4]), 1);
+
+        _mm256_storeu_ps(&a_lo[dir][k], _mm256_add_ps(origin, _mm256_mul_ps(_mm256_cvtepi32_ps(lo), scale)));
+        _mm256_storeu_ps(&a_hi[dir][k], _mm256_add_ps(origin, _mm256_mul_ps(_mm256_cvtepi32_ps(hi), scale)));
+      }
+    }
+
+    return;
+  }
+  if constexpr (K % 4 == 0 && std::is_same_v<T, double>) {
+    for (size_t dir = 0; dir < 3; dir++) {
+      const __m256d origin = _mm256_set1_pd(m_origin[dir]);
+      const __m256d scale  = _mm256_set1_pd(m_scale[dir]);
+
+      for (size_t k = 0; k < K; k += 4) {
+        const __m256d lo = _mm256_cvtepi32_pd(Detail::loadQuantized4(&m_lo[dir][k]));
+        const __m256d hi = _mm256_cvtepi32_pd(Detail::loadQuantized4(&m_hi[dir][k]));
+
+        _mm256_storeu_pd(&a_lo[dir][k], _mm256_add_pd(origin, _mm256_mul_pd(lo, scale)));
+        _mm256_storeu_pd(&a_hi[dir][k], _mm256_add_pd(origin, _mm256_mul_pd(hi, scale)));
+      }
+    }
+
+    return;
+  }
+#endif
+#if defined(__SSE4_1__)
+  if constexpr (K % 4 == 0 && std::is_same_v<T, float>) {
+    for (size_t dir = 0; dir < 3; dir++) {
+      const __m128 origin = _mm_set1_ps(m_origin[dir]);
+      const __m128 scale  = _mm_set1_ps(m_scale[dir]);
+
+      for (size_t k = 0; k < K; k += 4) {
+        const __m128 lo = _mm_cvtepi32_ps(Detail::loadQuantized4(&m_lo[dir][k]));
+        const __m128 hi = _mm_cvtepi32_ps(Detail::loadQuantized4(&m_hi[dir][k]));
+
+        _mm_storeu_ps(&a_lo[dir][k], _mm_add_ps(origin, _mm_mul_ps(lo, scale)));
+        _mm_storeu_ps(&a_hi[dir][k], _mm_add_ps(origin, _mm_mul_ps(hi, scale)));
+      }
+    }
+
+    return;
+  }
+#endif
+
+  for (size_t dir = 0; dir < 3; dir++) {
+    for (size_t k = 0; k < K; k++) {
+      a_lo[dir][k] = m_origin[dir] + T(m_lo[dir][k]) * m_scale[dir];
+      a_hi[dir][k] = m_origin[dir] + T(m_hi[dir][k]) * m_scale[dir];
+    }
+  }
+}
+
+template <class T, class P, size_t K, class Q, class StoragePolicy>
+inline QuantizedBVH<T, P, K, Q, StoragePolicy>::QuantizedBVH(const Packed& a_bvh) : m_bv(), m_root(0)
+{
+  using Node = typename Packed::NodeView;
+
+  // Nodes detached by PackedBVH::remove() are still in the array; compress a compacted copy instead.
+  if (a_bvh.hasGarbage()) {
+    Packed compacted(a_bvh);
+    compacted.compact();
+
+    *this = QuantizedBVH(compacted);
+
+    return;
+  }
+
+  // The packed tree keeps each box in the SoA record of the node's parent; reassemble the nodes to get at them.
+  const std::vector<Node> views    = a_bvh.getNodeViews();
+  const Node* const       nodes    = views.data();
+  const size_t            numNodes = views.size();
+
+  EBGEOMETRY_EXPECT(numNodes > 0);
+  EBGEOMETRY_EXPECT(numNodes < s_leafFlag);
+
+  // Interior nodes and leaves are numbered separately, each in the depth-first order of the packed tree.
+  std::vector<uint32_t> refs(numNodes);
+
+  for (size_t i = 0; i < numNodes; i++) {
+    const Node& node = nodes[i];
+
+    if (node.isLeaf()) {
+      refs[i] = s_leafFlag | static_cast<uint32_t>(m_leaves.size());
+
+      m_leaves.push_back({node.getPrimitivesOffset(), node.getNumPrimitives()});
+    }
+    else {
+      refs[i] = static_cast<uint32_t>(m_nodes.size());
+
+      m_nodes.emplace_back();
+    }
+  }
+
+  Parallel::parallelFor(0, numNodes, 1024, [&](size_t a_lo, size_t a_hi) {
+    for (size_t i = a_lo; i < a_hi; i++) {
+      const Node& node = nodes[i];
+
+      if (!node.isLeaf()) {
+        QuantizedNode& quantizedNode = m_nodes[refs[i]];
+        const BV*      children[K];
+
+        // Unused slots take the parent's box, which quantizes exactly; they are never descended into.
+        for (size_t k = 0; k < K; k++) {
+          const uint32_t child = node.getChildOffsets()[k];
+
+          if (child == EmptyChild) {
+            children[k]              = &node.getBoundingVolume();
+            quantizedNode.m_child[k] = EmptyChild;
+          }
+          else {
+            children[k]              = &nodes[child].getBoundingVolume();
+            quantizedNode.m_child[k] = refs[child];
+          }
+        }
+
+        quantize(quantizedNode, node.getBoundingVolume(), children);
+      }
+    }
+  });
+
+  m_bv   = nodes[0].getBoundingVolume();
+  m_root = refs[0];
+
+  m_primitives.assign(a_bvh.getPrimitiveData(), a_bvh.getPrimitiveData() + a_bvh.getNumPrimitives());
+}
+
+template <class T, class P, size_t K, class Q, class StoragePolicy>
+inline void
+QuantizedBVH<T, P, K, Q, StoragePolicy>::quantize(QuantizedNode& a_node,
+                                                  const BV&      a_parent,
+                                                  const BV* const (&a_children)[K]) noexcept
+{
+  constexpr T levels = T(std::numeric_limits<Q>::max());
+
+  for (size_t dir = 0; dir < 3; dir++) {
+    const T lo = a_parent.getLowCorner()[dir];
+    const T hi = a_parent.getHighCorner()[dir];
+
+    // Larger than the rounding error of origin + q * scale in dequantize() for any q, fused or not. Dequantized
+    // lower corners are at least this far below the exact ones, and upper corners this far above.
+    const T margin =
+      T(4) * std::numeric_limits<T>::epsilon() * std::max(std::abs(lo), std::abs(hi)) + std::numeric_limits<T>::min();
+
+    const T origin = lo - margin;
+    T       scale  = (hi + margin - origin) / levels;
+
+    while (origin + levels * scale < hi + margin) {
+      scale = std::nextafter(scale, std::numeric_limits<T>::max());
+    }
+
+    a_node.m_origin[dir] = origin;
+    a_node.m_scale[dir]  = scale;
+
+    for (size_t k = 0; k < K; k++) {
+      const T childLo = a_children[k]->getLowCorner()[dir] - margin;
+      const T childHi = a_children[k]->getHighCorner()[dir] + margin;
+
+      T qLo = std::clamp(std::floor((childLo - origin) / scale), T(0), levels);
+      T qHi = std::clamp(std::ceil((childHi - origin) / scale), T(0), levels);
+
+      // The division above is rounded too, so settle the grid indices by the dequantized values themselves.
+      while (qLo > T(0) && origin + qLo * scale > childLo) {
+        qLo -= T(1);
+      }
+      while (qHi < levels && origin + qHi * scale < childHi) {
+        qHi += T(1);
+      }
+
+      a_node.m_lo[dir][k] = static_cast<Q>(qLo);
+      a_node.m_hi[dir][k] = static_cast<Q>(qHi);
+    }
+  }
+}
+
+template <class T, class P, size_t K, class Q, class StoragePolicy>
+inline const std::vector<typename QuantizedBVH<T, P, K, Q, StoragePolicy>::StorageType>&
+QuantizedBVH<T, P, K, Q, StoragePolicy>::getPrimitives() const noexcept
+{
+  return m_primitives;
+}
+
+template <class T, class P, size_t K, class Q, class StoragePolicy>
+inline const std::vector<typename QuantizedBVH<T, P, K, Q, StoragePolicy>::QuantizedNode>&
+QuantizedBVH<T, P, K, Q, StoragePolicy>::getNodes() const noexcept
+{
+  return m_nodes;
+}
+
+template <class T, class P, size_t K, class Q, class StoragePolicy>
+inline const std::vector<typename QuantizedBVH<T, P, K, Q, StoragePolicy>::Leaf>&
+QuantizedBVH<T, P, K, Q, StoragePolicy>::getLeaves() const noexcept
+{
+  return m_leaves;
+}
+
+template <class T, class P, size_t K, class Q, class StoragePolicy>
+inline uint32_t
+QuantizedBVH<T, P, K, Q, StoragePolicy>::getRoot() const noexcept
+{
+  return m_root;
+}
+
+template <class T, class P, size_t K, class Q, class StoragePolicy>
+inline const EBGeometry::BoundingVolumes::AABBT<T>&
+QuantizedBVH<T, P, K, Q, StoragePolicy>::getBoundingVolume() const noexcept
+{
+  return m_bv;
+}
+
+template <class T, class P, size_t K, class Q, class StoragePolicy>
+inline EBGeometry::BoundingVolumes::AABBT<T>
+QuantizedBVH<T, P, K, Q, StoragePolicy>::computeBoundingVolume() const noexcept
+{
+  return m_bv;
+}
+
+template <class T, class P, size_t K, class Q, class StoragePolicy>
+template <class State, class LeafEvaluator, class PruneDistSquared>
+inline void
+QuantizedBVH<T, P, K, Q, StoragePolicy>::pruneTraverse(const Vec3T<T>&    a_point,
+                                                       State&             a_state,
+                                                       LeafEvaluator&&    a_evalLeaf,
+                                                       PruneDistSquared&& a_pruneDist2) const noexcept
+{
+  struct StackEntry
+  {
+    uint32_t ref;
+    T        dist2;
+  };
+
+  alignas(64) StackEntry stack[256];
+  alignas(64) T          lo[3][K];
+  alignas(64) T          hi[3][K];
+
+  Detail::TraversalCounter counter;
+
+  int top      = 0;
+  stack[top++] = {m_root, T(0)};
+
+  while (top > 0) {
+    const StackEntry entry = stack[--top];
+
+    if (entry.dist2 > a_pruneDist2(a_state)) {
+      continue;
+    }
+
+    counter.visitNode();
+
+    if ((entry.ref & s_leafFlag) != 0U) {
+      const Leaf& leaf = m_leaves[entry.ref & ~s_leafFlag];
+
+      counter.visitLeaf(leaf.m_numPrims);
+      a_evalLeaf(a_state, leaf.m_primOff, leaf.m_numPrims);
+    }
+    else {
+      const QuantizedNode& node = m_nodes[entry.ref];
+
+      node.dequantize(lo, hi);
+
+      std::array<std::pair<T, uint32_t>, K> children;
+
+      for (size_t k = 0; k < K; k++) {
+        const T dx = std::max(T(0), std::max(lo[0][k] - a_point[0], a_point[0] - hi[0][k]));
+        const T dy = std::max(T(0), std::max(lo[1][k] - a_point[1], a_point[1] - hi[1][k]));
+        const T dz = std::max(T(0), std::max(lo[2][k] - a_point[2], a_point[2] - hi[2][k]));
+
+        children[k] = {dx * dx + dy * dy + dz * dz, node.m_child[k]};
+      }
+
+      std::sort(children.begin(),
+                children.end(),
+                [](const std::pair<T, uint32_t>& a, const std::pair<T, uint32_t>& b) noexcept {
+                  return a.first > b.first;
+                });
+
+      const T newBest2 = a_pruneDist2(a_state);
+
+      for (const auto& [d, ref] : children) {
+        if (d <= newBest2 && ref != EmptyChild) {
+          stack[top++] = {ref, d};
+        }
+      }
+    }
+  }
+}
+
+} // namespace BVH
+
+} // namespace EBGeometry
+
+#endif
@@ -13,10 +13,12 @@
 
 // Std includes
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 
 // Our includes
+#include "EBGeometry_Parallel.hpp"
 #include "EBGeometry_Vec.hpp"
 
 namespace EBGeometry {
@@ -65,6 +67,11 @@ static constexpr unsigned int ValidBits = 21;
  */
 static constexpr Code ValidSpan = (static_cast<uint64_t>(1) << ValidBits) - 1;
 
+/**
+ * @brief Smallest number of points that computeBins() and sortByCode() hand to one thread.
+ */
+static constexpr size_t ParallelGrainSize = 16384;
+
 /**
  * @brief Implementation of the Morton SFC
  */
@@ -159,7 +166,8 @@ struct Hilbert
  * curve-parameterized ordering built on top of it). If every point coincides on some axis (a planar
  * cloud or duplicate points), that axis's normalization divisor would be zero; it is clamped to 1
  * (the numerator is also exactly zero there for every point, so any nonzero divisor yields the same,
- * correct bin index of 0), avoiding a divide-by-zero.
+ * correct bin index of 0), avoiding a divide-by-zero. Runs in parallel on the thread pool for large
+ * inputs.
  * @tparam T Floating-point precision.
  * @param[in] a_points Points to bin (e.g. bounding-volume centroids, or a raw point cloud).
  * @return One SFC::Index per input point, in the same order.
@@ -168,13 +176,28 @@ template <class T>
 [[nodiscard]] inline std::vector<Index>
 computeBins(const std::vector<Vec3T<T>>& a_points) noexcept;
 
+/**
+ * @brief Return the permutation that sorts a_codes in ascending order.
+ * @details A least-significant-digit radix sort over 8-bit digits. Passes above the highest bit set
+ * in any code are skipped, so a Morton/Nested/Hilbert code set (63 significant bits at most) takes
+ * at most eight linear passes. Large inputs are split into chunks: each chunk builds its own digit
+ * histogram and scatters its own elements, in parallel on the thread pool. Chunk-major offsets keep
+ * the scatter stable. The sort is stable (equal codes keep their input order), so the result is
+ * unique and does not depend on the thread count.
+ * @param[in] a_codes Codes to sort. Must hold fewer than 2^32 entries.
+ * @return Indices into a_codes, sorted by ascending code; ties in ascending index order.
+ */
+[[nodiscard]] inline std::vector<uint32_t>
+sortByCode(const std::vector<Code>& a_codes) noexcept;
+
 /**
  * @brief Return the index permutation that orders a_points along a space-filling curve.
  * @details Bins the points (computeBins), encodes each cell with Curve::encode(), and returns the
  * indices sorted by ascending code -- so a_points[result[0]], a_points[result[1]], ... walk the
- * curve. This is the one-call form of the "bin, encode, sort" pattern; the points themselves are not
- * moved or copied. @p Curve is a pure template parameter (encode() is static, so no instance is
- * needed) and comes first so it can be named while @p T is still deduced from a_points -- e.g.
+ * curve (points in the same cell keep their input order; see sortByCode()). This is the one-call
+ * form of the "bin, encode, sort" pattern; the points themselves are not moved or copied. @p Curve
+ * is a pure template parameter (encode() is static, so no instance is needed) and comes first so it
+ * can be named while @p T is still deduced from a_points -- e.g.
  * order<SFC::Nested>(points), or just order(points) for the Morton default.
  * @tparam Curve Space-filling curve type (SFC::Morton, SFC::Nested, ...). Defaults to SFC::Morton.
  * @tparam T     Floating-point precision (deduced from a_points).
@@ -15,13 +15,17 @@
 #include <algorithm>
 #include <climits>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
+#include <limits>
 #include <numeric>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 // Our includes
 #include "EBGeometry_Macros.hpp"
+#include "EBGeometry_Parallel.hpp"
 #include "EBGeometry_SFC.hpp"
 #include "EBGeometry_Vec.hpp"
 
@@ -230,18 +234,37 @@ computeBins(const std::vector<Vec3T<T>>& a_points) noexcept
 {
   static_assert(std::is_floating_point_v<T>, "EBGeometry::SFC::computeBins requires a floating-point type T");
 
+  const size_t numPoints = a_points.size();
+
   // The space-filling curves operate on positive integer coordinates only, using up to 2^21 valid
-  // bits per direction. Normalize the real-valued points into that grid.
+  // bits per direction. Normalize the real-valued points into that grid. The bounding range is
+  // reduced per chunk and then merged; min/max give the same result in any order.
+  const size_t numChunks =
+    std::max(size_t(1), std::min(numPoints / ParallelGrainSize, 4 * size_t(Parallel::getNumThreads())));
+
+  std::vector<std::pair<Vec3T<T>, Vec3T<T>>> ranges(numChunks, {+Vec3T<T>::infinity(), -Vec3T<T>::infinity()});
+
+  Parallel::parallelFor(0, numChunks, 1, [&](size_t a_lo, size_t a_hi) noexcept {
+    for (size_t chunk = a_lo; chunk < a_hi; chunk++) {
+      for (size_t i = (numPoints * chunk) / numChunks; i < (numPoints * (chunk + 1)) / numChunks; i++) {
+        const auto& p = a_points[i];
+
+        EBGEOMETRY_EXPECT(std::isfinite(p[0]));
+        EBGEOMETRY_EXPECT(std::isfinite(p[1]));
+        EBGEOMETRY_EXPECT(std::isfinite(p[2]));
+
+        ranges[chunk].first  = min(ranges[chunk].first, p);
+        ranges[chunk].second = max(ranges[chunk].second, p);
+      }
+    }
+  });
+
   Vec3T<T> minCoord = +Vec3T<T>::infinity();
   Vec3T<T> maxCoord = -Vec3T<T>::infinity();
 
-  for (const auto& p : a_points) {
-    EBGEOMETRY_EXPECT(std::isfinite(p[0]));
-    EBGEOMETRY_EXPECT(std::isfinite(p[1]));
-    EBGEOMETRY_EXPECT(std::isfinite(p[2]));
-
-    minCoord = min(minCoord, p);
-    maxCoord = max(maxCoord, p);
+  for (const auto& [lo, hi] : ranges) {
+    minCoord = min(minCoord, lo);
+    maxCoord = max(maxCoord, hi);
   }
 
   Vec3T<T> delta = (maxCoord - minCoord) / ValidSpan;
@@ -255,8 +278,7 @@ computeBins(const std::vector<Vec3T<T>>& a_points) noexcept
     }
   }
 
-  std::vector<Index> bins;
-  bins.reserve(a_points.size());
+  std::vector<Index> bins(numPoints);
 
   // Clamp each floored index into [0, ValidSpan], the range encode() requires. Two float divisions
   // can round a max-boundary point's index to ValidSpan + 1 (and a min-boundary point's to a tiny
@@ -266,15 +288,113 @@ computeBins(const std::vector<Vec3T<T>>& a_points) noexcept
     return static_cast<unsigned int>(f < T(0) ? T(0) : (f > T(ValidSpan) ? T(ValidSpan) : f));
   };
 
-  for (const auto& p : a_points) {
-    const Vec3T<T> curBin = (p - minCoord) / delta;
+  Parallel::parallelFor(0, numPoints, ParallelGrainSize, [&](size_t a_lo, size_t a_hi) noexcept {
+    for (size_t i = a_lo; i < a_hi; i++) {
+      const Vec3T<T> curBin = (a_points[i] - minCoord) / delta;
 
-    bins.emplace_back(Index{toBin(curBin[0]), toBin(curBin[1]), toBin(curBin[2])});
-  }
+      bins[i] = Index{toBin(curBin[0]), toBin(curBin[1]), toBin(curBin[2])};
+    }
+  });
 
   return bins;
 }
 
+inline std::vector<uint32_t>
+sortByCode(const std::vector<Code>& a_codes) noexcept
+{
+  constexpr unsigned int RadixBits = 8;
+  constexpr size_t       Radix     = size_t(1) << RadixBits;
+
+  const size_t numCodes = a_codes.size();
+
+  EBGEOMETRY_EXPECT(numCodes <= size_t(std::numeric_limits<uint32_t>::max()));
+
+  const size_t numChunks =
+    std::max(size_t(1), std::min(numCodes / ParallelGrainSize, 4 * size_t(Parallel::getNumThreads())));
+
+  const auto chunkBegin = [numCodes, numChunks](size_t a_chunk) noexcept -> size_t {
+    return (numCodes * a_chunk) / numChunks;
+  };
+
+  // Only digits below the highest bit set in any code can differ, so the passes above it are skipped.
+  std::vector<Code> chunkBits(numChunks, 0);
+
+  Parallel::parallelFor(0, numChunks, 1, [&](size_t a_lo, size_t a_hi) noexcept {
+    for (size_t chunk = a_lo; chunk < a_hi; chunk++) {
+      for (size_t i = chunkBegin(chunk); i < chunkBegin(chunk + 1); i++) {
+        chunkBits[chunk] |= a_codes[i];
+      }
+    }
+  });
+
+  Code allBits = 0;
+  for (const Code bits : chunkBits) {
+    allBits |= bits;
+  }
+
+  unsigned int numPasses = 0;
+  while (numPasses * RadixBits < CHAR_BIT * sizeof(Code) && (allBits >> (numPasses * RadixBits)) != 0) {
+    numPasses++;
+  }
+
+  std::vector<Code>     keys(a_codes);
+  std::vector<uint32_t> indices(numCodes);
+  std::iota(indices.begin(), indices.end(), uint32_t(0));
+
+  std::vector<Code>     keysOut(numCodes);
+  std::vector<uint32_t> indicesOut(numCodes);
+
+  // offsets[chunk * Radix + digit] is first a digit count and then the chunk's scatter position for that digit.
+  std::vector<size_t> offsets(numChunks * Radix);
+
+  for (unsigned int pass = 0; pass < numPasses; pass++) {
+    const unsigned int shift = pass * RadixBits;
+
+    std::fill(offsets.begin(), offsets.end(), size_t(0));
+
+    Parallel::parallelFor(0, numChunks, 1, [&](size_t a_lo, size_t a_hi) noexcept {
+      for (size_t chunk = a_lo; chunk < a_hi; chunk++) {
+        size_t* counts = &offsets[chunk * Radix];
+
+        for (size_t i = chunkBegin(chunk); i < chunkBegin(chunk + 1); i++) {
+          counts[(keys[i] >> shift) & (Radix - 1)]++;
+        }
+      }
+    });
+
+    // Exclusive scan in digit-major, chunk-minor order: every element of digit d precedes every element of digit
+    // d + 1, and within one digit earlier chunks precede later ones -- which keeps the sort stable.
+    size_t running = 0;
+    for (size_t digit = 0; digit < Radix; digit++) {
+      for (size_t chunk = 0; chunk < numChunks; chunk++) {
+        const size_t count = offsets[chunk * Radix + digit];
+
+        offsets[chunk * Radix + digit] = running;
+
+        running += count;
+      }
+    }
+
+    Parallel::parallelFor(0, numChunks, 1, [&](size_t a_lo, size_t a_hi) noexcept {
+      for (size_t chunk = a_lo; chunk < a_hi; chunk++) {
+        size_t* positions = &offsets[chunk * Radix];
+
+        for (size_t i = chunkBegin(chunk); i < chunkBegin(chunk + 1); i++) {
+          const size_t pos = positions[(keys[i] >> shift) & (Radix - 1)]++;
+
+          keysOut[pos]    = keys[i];
+          indicesOut[pos] = indices[i];
+        }
+      }
+    });
+
+    keys.swap(keysOut);
+    indices.swap(indicesOut);
+  }
+
+  return indices;
+}
+
 template <class Curve, class T>
 inline std::vector<uint32_t>
 order(const std::vector<Vec3T<T>>& a_points) noexcept
@@ -283,19 +403,15 @@ order(const std::vector<Vec3T<T>>& a_points) noexcept
 
   const std::vector<Index> bins = computeBins<T>(a_points);
 
-  std::vector<Code> codes;
-  codes.reserve(a_points.size());
-  for (const auto& bin : bins) {
-    codes.push_back(Curve::encode(bin));
-  }
+  std::vector<Code> codes(a_points.size());
 
-  std::vector<uint32_t> indices(a_points.size());
-  std::iota(indices.begin(), indices.end(), uint32_t(0));
-  std::sort(indices.begin(), indices.end(), [&codes](uint32_t a_lhs, uint32_t a_rhs) noexcept -> bool {
-    return codes[a_lhs] < codes[a_rhs];
+  Parallel::parallelFor(0, a_points.size(), ParallelGrainSize, [&](size_t a_lo, size_t a_hi) noexcept {
+    for (size_t i = a_lo; i < a_hi; i++) {
+      codes[i] = Curve::encode(bins[i]);
+    }
   });
 
-  return indices;
+  return sortByCode(codes);
 }
 
 } // namespace SFC
@@ -19,6 +19,7 @@
 #include <vector>
 
 // Our includes
+#include "EBGeometry_DCEL_IndexedMesh.hpp"
 #include "EBGeometry_DCEL_Mesh.hpp"
 #include "EBGeometry_STL.hpp"
 #include "EBGeometry_Soup.hpp"
@@ -94,6 +95,48 @@ STL<T>::convertToDCEL() const noexcept
   return mesh;
 }
 
+template <typename T>
+template <typename Meta>
+std::shared_ptr<EBGeometry::DCEL::IndexedMeshT<T, Meta>>
+STL<T>::convertToIndexedDCEL() const noexcept
+{
+  // Do a deep copy of the vertices and facets since they need to be compressed.
+  std::vector<Vec3T<T>>            vertices = m_vertexCoordinates;
+  std::vector<std::vector<size_t>> facets   = m_facets;
+
+  if (Soup::containsDegeneratePolygons(vertices, facets)) {
+    std::cerr << "STL::convertToIndexedDCEL - STL contains degenerate faces\n";
+  }
+
+  auto mesh = std::make_shared<EBGeometry::DCEL::IndexedMeshT<T, Meta>>();
+
+  Soup::compress(vertices, facets);
+  Soup::soupToIndexedDCEL(*mesh, vertices, facets, m_id);
+
+  return mesh;
+}
+
+template <typename T>
+template <typename Meta>
+std::vector<EBGeometry::Triangle<T, Meta>>
+STL<T>::convertToTriangles() const noexcept
+{
+  // Do a deep copy of the vertices and facets since they need to be compressed.
+  std::vector<Vec3T<T>>            vertices = m_vertexCoordinates;
+  std::vector<std::vector<size_t>> facets   = m_facets;
+
+  if (Soup::containsDegeneratePolygons(vertices, facets)) {
+    std::cerr << "STL::convertToTriangles - STL contains degenerate faces\n";
+  }
+
+  std::vector<EBGeometry::Triangle<T, Meta>> triangles;
+
+  Soup::compress(vertices, facets);
+  Soup::soupToTriangles(triangles, vertices, facets, m_id);
+
+  return triangles;
+}
+
 } // namespace EBGeometry
 
 #endif
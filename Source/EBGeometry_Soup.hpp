@@ -13,12 +13,15 @@
 
 // Std includes
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
 
 // Our includes
 #include "EBGeometry_DCEL.hpp"
+#include "EBGeometry_DCEL_IndexedMesh.hpp"
+#include "EBGeometry_Triangle.hpp"
 #include "EBGeometry_Vec.hpp"
 
 namespace EBGeometry {
@@ -41,17 +44,40 @@ template <typename T>
 containsDegeneratePolygons(const std::vector<EBGeometry::Vec3T<T>>& a_vertices,
                            const std::vector<std::vector<size_t>>&  a_facets) noexcept;
 
+/**
+ * @brief Weld duplicate vertices in place and return where each input vertex went.
+ * @details Vertices are bucketed by a 64-bit hash -- of their coordinate bits, or of their grid cell of size
+ * a_tolerance -- and the hashes are ordered with the parallel radix sort SFC::sortByCode(). Without a tolerance,
+ * each vertex is merged into the lowest-indexed vertex with the same coordinate bits (so NaN coordinates only merge
+ * with identical NaNs). With a positive tolerance, every pair of vertices within a_tolerance of each other (found
+ * through the 27 surrounding cells) is joined in a union-find, so merging is transitive: a chain of vertices less
+ * than a_tolerance apart collapses into one, represented by its lowest-indexed vertex. Vertices with non-finite
+ * coordinates are never merged in this mode. The welded vertices keep the order of their first occurrence, so the
+ * result does not depend on the thread count.
+ * @tparam T Floating-point precision type for vertex coordinates.
+ * @param[in,out] a_vertices  Vertex coordinate list; duplicates are removed in place. Must hold fewer than 2^32
+ * vertices.
+ * @param[in]     a_tolerance Welding distance. Zero (the default) only merges bitwise-equal positions (with -0 == 0).
+ * @return Flat remap array: input vertex i is now a_vertices[result[i]].
+ */
+template <typename T>
+[[nodiscard]] inline static std::vector<uint32_t>
+weld(std::vector<EBGeometry::Vec3T<T>>& a_vertices, const T a_tolerance = T(0)) noexcept;
+
 /**
  * @brief Compress a polygon soup by removing duplicate vertices.
- * @details After this call, `a_vertices` contains only unique vertex positions and
- * `a_facets` has been updated to reference the new indices.
+ * @details After this call, `a_vertices` contains only unique vertex positions, in order of first occurrence, and
+ * `a_facets` has been updated to reference the new indices. See weld() for the welding itself.
  * @tparam T Floating-point precision type for vertex coordinates.
- * @param[in,out] a_vertices Vertex coordinate list; duplicates are removed in place.
- * @param[in,out] a_facets   Index lists; updated to reference the compressed vertex list.
+ * @param[in,out] a_vertices  Vertex coordinate list; duplicates are removed in place.
+ * @param[in,out] a_facets    Index lists; updated to reference the compressed vertex list.
+ * @param[in]     a_tolerance Welding distance. Zero (the default) only merges coincident vertices.
  */
 template <typename T>
 inline static void
-compress(std::vector<EBGeometry::Vec3T<T>>& a_vertices, std::vector<std::vector<size_t>>& a_facets) noexcept;
+compress(std::vector<EBGeometry::Vec3T<T>>& a_vertices,
+         std::vector<std::vector<size_t>>&  a_facets,
+         const T                            a_tolerance = T(0)) noexcept;
 
 /**
  * @brief Convert a polygon soup into a DCEL half-edge mesh.
@@ -71,11 +97,52 @@ soupToDCEL(EBGeometry::DCEL::MeshT<T, Meta>&        a_mesh,
            const std::vector<std::vector<size_t>>&  a_facets,
            const std::string&                       a_id) noexcept;
 
+/**
+ * @brief Convert a polygon soup into an index-based DCEL mesh.
+ * @details Same as soupToDCEL but fills the flat arrays of DCEL::IndexedMeshT: defines the topology, runs a sanity
+ * check, and reconciles normals with angle-weighted vertex normals.
+ * @tparam T    Floating-point precision type for vertex coordinates.
+ * @tparam Meta Metadata type attached to DCEL vertices, edges, and faces.
+ * @param[out] a_mesh     Output DCEL mesh populated by this call.
+ * @param[in]  a_vertices Compressed vertex coordinate list.
+ * @param[in]  a_facets   Index lists defining each polygon face.
+ * @param[in]  a_id       Identifier string used in diagnostic messages.
+ */
+template <typename T, typename Meta>
+inline static void
+soupToIndexedDCEL(EBGeometry::DCEL::IndexedMeshT<T, Meta>& a_mesh,
+                  const std::vector<EBGeometry::Vec3T<T>>& a_vertices,
+                  const std::vector<std::vector<size_t>>&  a_facets,
+                  const std::string&                       a_id) noexcept;
+
+/**
+ * @brief Convert a polygon soup straight into self-contained triangles, without building a DCEL mesh.
+ * @details Computes the same face normals, angle-weighted vertex pseudonormals, and edge pseudonormals as
+ * soupToDCEL followed by reconcile(), but directly from the index arrays: half-edges are paired through a flat hash
+ * table keyed on their vertex pair, and the only allocations are a handful of arrays sized by the soup. Polygons
+ * with more than three vertices are fan-triangulated, which is exact for convex planar polygons.
+ * @tparam T    Floating-point precision type for vertex coordinates.
+ * @tparam Meta Metadata type attached to the triangles.
+ * @param[out] a_triangles Output triangles, one per triangle of the (fan-triangulated) soup.
+ * @param[in]  a_vertices  Compressed vertex coordinate list.
+ * @param[in]  a_facets    Index lists defining each polygon face.
+ * @param[in]  a_id        Identifier string used in diagnostic messages.
+ */
+template <typename T, typename Meta>
+inline static void
+soupToTriangles(std::vector<EBGeometry::Triangle<T, Meta>>& a_triangles,
+                const std::vector<EBGeometry::Vec3T<T>>&    a_vertices,
+                const std::vector<std::vector<size_t>>&     a_facets,
+                const std::string&                          a_id) noexcept;
+
 /**
  * @brief Reconcile pair edges: link each half-edge with its reverse.
- * @details For every half-edge (u→v) the function finds the corresponding reverse
- * half-edge (v→u) by iterating over all faces incident to u and sets the pair-edge
- * pointer on both.
+ * @details Half-edges are keyed by a hash of their unordered vertex pair {u, v}, and the keys are grouped with the
+ * parallel radix sort SFC::sortByCode(). Within each group the lowest-indexed half-edge (u→v) is paired with the
+ * first later half-edge that runs v→u, and the pair-edge pointer is set on both. On a manifold, consistently
+ * oriented mesh this links every interior edge. Boundary half-edges keep their pair edge (normally nullptr) and are
+ * reported by DCEL::MeshT::sanityCheck(). All other half-edges in a group, which only occur at non-manifold or
+ * inconsistently oriented edges, are also left unpaired and are counted in a warning printed to std::cerr.
  * @tparam T    Floating-point precision type.
  * @tparam Meta Metadata type attached to DCEL edges.
  * @param[in,out] a_edges Collection of all half-edges to reconcile.
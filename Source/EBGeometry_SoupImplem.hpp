@@ -13,8 +13,14 @@
 
 // Std includes
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <limits>
 #include <map>
 #include <memory>
 #include <string>
@@ -25,9 +31,12 @@
 // Our includes
 #include "EBGeometry_DCEL_Edge.hpp"
 #include "EBGeometry_DCEL_Face.hpp"
+#include "EBGeometry_DCEL_IndexedMesh.hpp"
 #include "EBGeometry_DCEL_Mesh.hpp"
 #include "EBGeometry_DCEL_Vertex.hpp"
 #include "EBGeometry_Macros.hpp"
+#include "EBGeometry_Parallel.hpp"
+#include "EBGeometry_SFC.hpp"
 #include "EBGeometry_Soup.hpp"
 
 namespace EBGeometry {
@@ -74,74 +83,251 @@ Soup::containsDegeneratePolygons(const std::vector<EBGeometry::Vec3T<T>>& a_vert
 }
 
 template <typename T>
-inline void
-Soup::compress(std::vector<EBGeometry::Vec3T<T>>& a_vertices, std::vector<std::vector<size_t>>& a_facets) noexcept
+inline std::vector<uint32_t>
+Soup::weld(std::vector<EBGeometry::Vec3T<T>>& a_vertices, const T a_tolerance) noexcept
 {
-  static_assert(std::is_floating_point_v<T>, "Soup::compress requires a floating-point T");
+  static_assert(std::is_floating_point_v<T>, "Soup::weld requires a floating-point T");
+  static_assert(sizeof(T) == 4 || sizeof(T) == 8, "Soup::weld hashes 32- or 64-bit coordinates");
 
   using Vec3 = EBGeometry::Vec3T<T>;
+  using Bits = std::conditional_t<sizeof(T) == 8, uint64_t, uint32_t>;
 
   // TLDR: Polygon soups read from file (STL, OBJ, PLY, VTK, ...) typically contain many duplicate
   //       vertices (each facet lists its own copies of shared vertex positions). We need to remove
-  //       those duplicates and also update a_facets such that each facet references the compressed
-  //       vertex vector.
+  //       those duplicates and tell the caller where every vertex ended up.
 
-  const size_t originalVertexCount = a_vertices.size();
+  EBGEOMETRY_EXPECT(a_tolerance >= T(0));
+  EBGEOMETRY_EXPECT(a_vertices.size() < size_t(std::numeric_limits<uint32_t>::max()));
 
-  // Create a "map" of the vertices, storing their original indices. Then sort
-  // the map lexicographically.
-  std::vector<std::pair<Vec3, size_t>> vertexMap;
-  for (size_t i = 0; i < a_vertices.size(); i++) {
-    vertexMap.emplace_back(a_vertices[i], i);
-  }
+  const size_t numVertices = a_vertices.size();
+  const size_t grain       = SFC::ParallelGrainSize;
+
+  const auto hash3 = [](const uint64_t a, const uint64_t b, const uint64_t c) noexcept -> SFC::Code {
+    return Parallel::Detail::mix(a + Parallel::Detail::mix(b + Parallel::Detail::mix(c)));
+  };
+
+  // Coordinate bits, with -0 folded into +0 since they compare equal.
+  const auto bits = [](const T a_x) noexcept -> uint64_t {
+    const T x = (a_x == T(0)) ? T(0) : a_x;
+
+    Bits b;
+    std::memcpy(&b, &x, sizeof(T));
+
+    return uint64_t(b);
+  };
+
+  const bool useGrid = a_tolerance > T(0);
+  const T    invCell = useGrid ? T(1) / a_tolerance : T(0);
+  const T    tol2    = a_tolerance * a_tolerance;
+
+  // Grid cells are only defined for finite coordinates that fit in an int64 cell index. Other vertices (NaN, inf,
+  // or absurdly far out) are hashed by their bits and never welded.
+  const auto onGrid = [invCell](const Vec3& a_x) noexcept -> bool {
+    constexpr T maxCell = T(4611686018427387904.0); // 2^62
+
+    return std::abs(a_x[0] * invCell) < maxCell && std::abs(a_x[1] * invCell) < maxCell &&
+           std::abs(a_x[2] * invCell) < maxCell;
+  };
+
+  const auto cell = [invCell](const T a_x) noexcept -> int64_t {
+    return static_cast<int64_t>(std::floor(a_x * invCell));
+  };
 
-  std::sort(vertexMap.begin(), vertexMap.end(), [](const std::pair<Vec3, size_t>& A, const std::pair<Vec3, size_t>& B) {
-    const Vec3& a = A.first;
-    const Vec3& b = B.first;
+  const auto cellCode = [&hash3](const int64_t a_i, const int64_t a_j, const int64_t a_k) noexcept -> SFC::Code {
+    return hash3(uint64_t(a_i), uint64_t(a_j), uint64_t(a_k));
+  };
 
-    return a.lessLX(b);
+  const auto bitCode = [&hash3, &bits](const Vec3& a_x) noexcept -> SFC::Code {
+    return hash3(bits(a_x[0]), bits(a_x[1]), bits(a_x[2]));
+  };
+
+  std::vector<SFC::Code> codes(numVertices);
+
+  Parallel::parallelFor(0, numVertices, grain, [&](const size_t a_lo, const size_t a_hi) noexcept {
+    for (size_t i = a_lo; i < a_hi; i++) {
+      const Vec3& x = a_vertices[i];
+
+      codes[i] = (useGrid && onGrid(x)) ? cellCode(cell(x[0]), cell(x[1]), cell(x[2])) : bitCode(x);
+    }
   });
 
-  // Compress the vertex vector. While doing so we should build up the old-to-new index map
-  a_vertices.clear();
+  // Stable, so equal codes are listed in ascending vertex index.
+  const std::vector<uint32_t> order = SFC::sortByCode(codes);
 
-  if (vertexMap.empty()) {
-    a_facets.clear();
-    return;
-  }
+  std::vector<SFC::Code> sortedCodes(numVertices);
+
+  Parallel::parallelFor(0, numVertices, grain, [&](const size_t a_lo, const size_t a_hi) noexcept {
+    for (size_t k = a_lo; k < a_hi; k++) {
+      sortedCodes[k] = codes[order[k]];
+    }
+  });
+
+  codes = std::vector<SFC::Code>();
+
+  // rep[i] is the lowest vertex index that vertex i merges into; rep[i] <= i.
+  std::vector<uint32_t> rep(numVertices);
 
-  std::map<size_t, size_t> indexMap;
+  if (useGrid) {
+    // Concurrent union-find over all pairs within the tolerance. Roots are only ever linked to smaller roots, so
+    // every set ends up rooted at its lowest index no matter how the unions interleave.
+    std::vector<std::atomic<uint32_t>> parent(numVertices);
 
-  a_vertices.emplace_back(vertexMap.front().first);
-  indexMap.emplace(vertexMap.front().second, 0);
+    Parallel::parallelFor(0, numVertices, grain, [&](const size_t a_lo, const size_t a_hi) noexcept {
+      for (size_t i = a_lo; i < a_hi; i++) {
+        parent[i].store(static_cast<uint32_t>(i), std::memory_order_relaxed);
+      }
+    });
+
+    const auto findRoot = [&parent](uint32_t a_i) noexcept -> uint32_t {
+      uint32_t p = parent[a_i].load(std::memory_order_acquire);
+      while (p != a_i) {
+        a_i = p;
+        p   = parent[a_i].load(std::memory_order_acquire);
+      }
+
+      return a_i;
+    };
+
+    const auto unite = [&parent, &findRoot](uint32_t a_i, uint32_t a_j) noexcept -> void {
+      while (true) {
+        a_i = findRoot(a_i);
+        a_j = findRoot(a_j);
+
+        if (a_i == a_j) {
+          return;
+        }
+        if (a_i < a_j) {
+          std::swap(a_i, a_j);
+        }
+
+        // a_i is the larger root; it is still a root if nobody linked it in the meantime.
+        uint32_t expected = a_i;
+        if (parent[a_i].compare_exchange_strong(expected, a_j, std::memory_order_acq_rel)) {
+          return;
+        }
+      }
+    };
+
+    Parallel::parallelFor(0, numVertices, grain, [&](const size_t a_lo, const size_t a_hi) noexcept {
+      for (size_t i = a_lo; i < a_hi; i++) {
+        const Vec3& x = a_vertices[i];
 
-  for (size_t i = 1; i < vertexMap.size(); i++) {
-    const size_t oldIndex = vertexMap[i].second;
+        if (!onGrid(x)) {
+          continue;
+        }
+
+        const int64_t ci = cell(x[0]);
+        const int64_t cj = cell(x[1]);
+        const int64_t ck = cell(x[2]);
+
+        for (int64_t di = -1; di <= 1; di++) {
+          for (int64_t dj = -1; dj <= 1; dj++) {
+            for (int64_t dk = -1; dk <= 1; dk++) {
+              const SFC::Code code = cellCode(ci + di, cj + dj, ck + dk);
+
+              // Each pair is united once, from its higher index; candidates come in ascending index.
+              auto k = size_t(std::lower_bound(sortedCodes.begin(), sortedCodes.end(), code) - sortedCodes.begin());
+              for (; k < numVertices && sortedCodes[k] == code && order[k] < i; k++) {
+                if ((a_vertices[order[k]] - x).length2() <= tol2) {
+                  unite(static_cast<uint32_t>(i), order[k]);
+                }
+              }
+            }
+          }
+        }
+      }
+    });
 
-    const auto& cur  = vertexMap[i].first;
-    const auto& prev = vertexMap[i - 1].first;
+    Parallel::parallelFor(0, numVertices, grain, [&](const size_t a_lo, const size_t a_hi) noexcept {
+      for (size_t i = a_lo; i < a_hi; i++) {
+        rep[i] = findRoot(static_cast<uint32_t>(i));
+      }
+    });
+  }
+  else {
+    // Positions are compared through the same folded bits as the hash, so that NaN coordinates (which never
+    // compare equal) still match themselves.
+    const auto sameBits = [&bits](const Vec3& a_x, const Vec3& a_y) noexcept -> bool {
+      return bits(a_x[0]) == bits(a_y[0]) && bits(a_x[1]) == bits(a_y[1]) && bits(a_x[2]) == bits(a_y[2]);
+    };
+
+    // Each chunk handles the runs of equal hashes that start inside it. Within a run, distinct positions only
+    // share a hash by collision, so the quadratic scan is over very few elements.
+    Parallel::parallelFor(0, numVertices, grain, [&](const size_t a_lo, const size_t a_hi) noexcept {
+      Parallel::Detail::forEachRun(sortedCodes, a_lo, a_hi, [&](const size_t a_begin, const size_t a_end) noexcept {
+        for (size_t k = a_begin; k < a_end; k++) {
+          size_t m = a_begin;
+          while (m < k && !sameBits(a_vertices[order[m]], a_vertices[order[k]])) {
+            m++;
+          }
+
+          rep[order[k]] = order[m];
+        }
+      });
+    });
+  }
 
-    if (cur != prev) {
-      a_vertices.emplace_back(cur);
+  // Number the surviving vertices in order of first occurrence.
+  std::vector<uint32_t> remap(numVertices);
+  std::vector<Vec3>     welded;
+
+  Parallel::Detail::compactInOrder(
+    numVertices,
+    grain,
+    [&rep](const size_t a_i) noexcept -> bool {
+      return rep[a_i] == a_i;
+    },
+    [&welded](const size_t a_numWelded) noexcept -> void {
+      welded.resize(a_numWelded);
+    },
+    [&](const size_t a_i, const size_t a_k) noexcept -> void {
+      welded[a_k] = a_vertices[a_i];
+      remap[a_i]  = static_cast<uint32_t>(a_k);
+    });
+
+  // Representatives precede the vertices merged into them, but may sit in another chunk.
+  Parallel::parallelFor(0, numVertices, grain, [&](const size_t a_lo, const size_t a_hi) noexcept {
+    for (size_t i = a_lo; i < a_hi; i++) {
+      if (rep[i] != i) {
+        remap[i] = remap[rep[i]];
+      }
     }
+  });
+
+  a_vertices.swap(welded);
 
-    indexMap.emplace(oldIndex, a_vertices.size() - 1);
+  return remap;
+}
+
+template <typename T>
+inline void
+Soup::compress(std::vector<EBGeometry::Vec3T<T>>& a_vertices,
+               std::vector<std::vector<size_t>>&  a_facets,
+               const T                            a_tolerance) noexcept
+{
+  static_assert(std::is_floating_point_v<T>, "Soup::compress requires a floating-point T");
+
+  const size_t originalVertexCount = a_vertices.size();
+
+  if (originalVertexCount == 0) {
+    a_facets.clear();
+
+    return;
   }
 
-  // Fix facet indicing. Use find() rather than at() so that a malformed facet (referencing a
-  // vertex index that was never in the original a_vertices) triggers a diagnosable
-  // EBGEOMETRY_EXPECT rather than an uncontrolled std::terminate() from throwing inside this
-  // noexcept function.
-  for (auto& facet : a_facets) {
-    for (size_t& ivert : facet) {
-      EBGEOMETRY_EXPECT(ivert < originalVertexCount);
+  const std::vector<uint32_t> remap = Soup::weld(a_vertices, a_tolerance);
 
-      const auto it = indexMap.find(ivert);
-      EBGEOMETRY_EXPECT(it != indexMap.end());
+  // Fix facet indicing. A malformed facet (referencing a vertex index that was never in the original a_vertices)
+  // triggers a diagnosable EBGEOMETRY_EXPECT.
+  Parallel::parallelFor(0, a_facets.size(), SFC::ParallelGrainSize, [&](const size_t a_lo, const size_t a_hi) noexcept {
+    for (size_t f = a_lo; f < a_hi; f++) {
+      for (size_t& ivert : a_facets[f]) {
+        EBGEOMETRY_EXPECT(ivert < originalVertexCount);
 
-      ivert = it->second;
+        ivert = remap[ivert];
+      }
     }
-  }
+  });
 }
 
 template <typename T, typename Meta>
@@ -225,41 +411,355 @@ Soup::soupToDCEL(EBGeometry::DCEL::MeshT<T, Meta>&        a_mesh,
   a_mesh.reconcile(EBGeometry::DCEL::VertexNormalWeight::Angle);
 }
 
+template <typename T, typename Meta>
+inline void
+Soup::soupToIndexedDCEL(EBGeometry::DCEL::IndexedMeshT<T, Meta>& a_mesh,
+                        const std::vector<EBGeometry::Vec3T<T>>& a_vertices,
+                        const std::vector<std::vector<size_t>>&  a_facets,
+                        const std::string&                       a_id) noexcept
+{
+  static_assert(std::is_floating_point_v<T>, "Soup::soupToIndexedDCEL requires a floating-point T");
+
+  // define() also pairs the half-edges.
+  a_mesh.define(a_vertices, a_facets);
+
+  a_mesh.sanityCheck(a_id);
+
+  a_mesh.reconcile(EBGeometry::DCEL::VertexNormalWeight::Angle);
+}
+
+template <typename T, typename Meta>
+inline void
+Soup::soupToTriangles(std::vector<EBGeometry::Triangle<T, Meta>>& a_triangles,
+                      const std::vector<EBGeometry::Vec3T<T>>&    a_vertices,
+                      const std::vector<std::vector<size_t>>&     a_facets,
+                      const std::string&                          a_id) noexcept
+{
+  static_assert(std::is_floating_point_v<T>, "Soup::soupToTriangles requires a floating-point T");
+
+  using Vec3 = EBGeometry::Vec3T<T>;
+
+  constexpr uint32_t noIndex  = std::numeric_limits<uint32_t>::max();
+  constexpr uint64_t emptyKey = std::numeric_limits<uint64_t>::max();
+  constexpr size_t   grain    = 4096;
+
+  EBGEOMETRY_EXPECT(a_vertices.size() < noIndex);
+
+  // Fan-triangulate the soup into flat corner indices.
+  std::vector<uint32_t> corners;
+  for (const auto& facet : a_facets) {
+    if (facet.size() < 3) {
+      std::cerr << "Soup::soupToTriangles -- not enough vertices in face, skipping it\n";
+
+      EBGEOMETRY_EXPECT(facet.size() >= 3);
+
+      continue;
+    }
+
+    for (size_t i = 1; i + 1 < facet.size(); i++) {
+      EBGEOMETRY_EXPECT(facet[0] < a_vertices.size());
+      EBGEOMETRY_EXPECT(facet[i] < a_vertices.size());
+      EBGEOMETRY_EXPECT(facet[i + 1] < a_vertices.size());
+
+      corners.emplace_back(static_cast<uint32_t>(facet[0]));
+      corners.emplace_back(static_cast<uint32_t>(facet[i]));
+      corners.emplace_back(static_cast<uint32_t>(facet[i + 1]));
+    }
+  }
+
+  const size_t numTriangles = corners.size() / 3;
+
+  EBGEOMETRY_EXPECT(corners.size() < noIndex);
+
+  // Face normals from the first non-degenerate vertex triple, as in DCEL::FaceT::computeNormal().
+  std::vector<Vec3> faceNormals(numTriangles);
+
+  Parallel::parallelFor(0, numTriangles, grain, [&](const size_t a_lo, const size_t a_hi) noexcept {
+    for (size_t t = a_lo; t < a_hi; t++) {
+      Vec3 normal = Vec3::zeros();
+
+      for (size_t i = 0; i < 3; i++) {
+        const Vec3& x0 = a_vertices[corners[3 * t + i]];
+        const Vec3& x1 = a_vertices[corners[3 * t + (i + 1) % 3]];
+        const Vec3& x2 = a_vertices[corners[3 * t + (i + 2) % 3]];
+
+        normal = (x2 - x0).cross(x2 - x1);
+
+        if (normal.length() > T(0)) {
+          break;
+        }
+      }
+
+      const T len = normal.length();
+
+      faceNormals[t] = (len > std::numeric_limits<T>::epsilon()) ? normal / len : Vec3::zeros();
+    }
+  });
+
+  // Pair half-edge 3*t+i (corner i -> corner i+1 of triangle t) with its reverse through an open-addressing table
+  // keyed on the sorted vertex pair.
+  const size_t numHalfEdges = corners.size();
+
+  size_t capacity = 16;
+  while (capacity < 2 * numHalfEdges) {
+    capacity *= 2;
+  }
+
+  int shift = 64;
+  for (size_t c = capacity; c > 1; c >>= 1) {
+    shift--;
+  }
+
+  std::vector<uint64_t> keys(capacity, emptyKey);
+  std::vector<uint32_t> slots(capacity, noIndex);
+  std::vector<uint32_t> pairEdges(numHalfEdges, noIndex);
+
+  size_t numBadEdges = 0;
+
+  for (size_t h = 0; h < numHalfEdges; h++) {
+    const uint32_t from = corners[h];
+    const uint32_t to   = corners[h - h % 3 + (h + 1) % 3];
+
+    const uint64_t key = (uint64_t(std::min(from, to)) << 32) | uint64_t(std::max(from, to));
+
+    size_t slot = static_cast<size_t>((key * 0x9E3779B97F4A7C15ULL) >> shift);
+    while (keys[slot] != emptyKey && keys[slot] != key) {
+      slot = (slot + 1) & (capacity - 1);
+    }
+
+    if (keys[slot] == emptyKey) {
+      keys[slot]  = key;
+      slots[slot] = static_cast<uint32_t>(h);
+    }
+    else {
+      // Only an unpaired half-edge running the other way is a valid pair.
+      const uint32_t other = slots[slot];
+
+      if (pairEdges[other] == noIndex && corners[other] == to) {
+        pairEdges[other] = static_cast<uint32_t>(h);
+        pairEdges[h]     = other;
+      }
+      else {
+        numBadEdges++;
+      }
+    }
+  }
+
+  // Free the table before the output triangles are allocated.
+  keys  = std::vector<uint64_t>();
+  slots = std::vector<uint32_t>();
+
+  // Angle-weighted vertex pseudonormals, accumulated in face order as VertexT::computeVertexNormalAngleWeighted()
+  // does over its faces.
+  std::vector<Vec3> vertexNormals(a_vertices.size(), Vec3::zeros());
+
+  for (size_t t = 0; t < numTriangles; t++) {
+    for (size_t i = 0; i < 3; i++) {
+      const uint32_t v = corners[3 * t + i];
+
+      const Vec3& x0 = a_vertices[v];
+      const Vec3& x1 = a_vertices[corners[3 * t + (i + 1) % 3]];
+      const Vec3& x2 = a_vertices[corners[3 * t + (i + 2) % 3]];
+
+      if (x0 == x1 || x0 == x2) {
+        continue;
+      }
+
+      Vec3 v1 = x1 - x0;
+      Vec3 v2 = x2 - x0;
+
+      v1 = v1 / v1.length();
+      v2 = v2 / v2.length();
+
+      vertexNormals[v] += std::acos(std::clamp(v1.dot(v2), T(-1), T(1))) * faceNormals[t];
+    }
+  }
+
+  for (auto& n : vertexNormals) {
+    const T len = n.length();
+
+    if (len > std::numeric_limits<T>::epsilon()) {
+      n = n / len;
+    }
+  }
+
+  // Assemble the triangles. Edge pseudonormals are the normalized sum of the two face normals, as in
+  // DCEL::EdgeT::computeNormal(); boundary edges take their own face normal.
+  a_triangles.resize(numTriangles);
+
+  Parallel::parallelFor(0, numTriangles, grain, [&](const size_t a_lo, const size_t a_hi) noexcept {
+    for (size_t t = a_lo; t < a_hi; t++) {
+      std::array<Vec3, 3> positions;
+      std::array<Vec3, 3> normals;
+      std::array<Vec3, 3> edgeNormals;
+
+      for (size_t i = 0; i < 3; i++) {
+        const size_t h = 3 * t + i;
+
+        Vec3 edgeNormal = faceNormals[t];
+        if (pairEdges[h] != noIndex) {
+          edgeNormal += faceNormals[pairEdges[h] / 3];
+        }
+
+        const T len = edgeNormal.length();
+
+        positions[i]   = a_vertices[corners[h]];
+        normals[i]     = vertexNormals[corners[h]];
+        edgeNormals[i] = (len > std::numeric_limits<T>::epsilon()) ? edgeNormal / len : Vec3::zeros();
+      }
+
+      auto& tri = a_triangles[t];
+
+      tri.setNormal(faceNormals[t]);
+      tri.setVertexPositions(positions);
+      tri.setVertexNormals(normals);
+      tri.setEdgeNormals(edgeNormals);
+    }
+  });
+
+  // Same diagnostics as DCEL::MeshT::sanityCheck() for the defects that can be seen here.
+  std::map<std::string, size_t> warnings = {{"degenerate face", 0},
+                                            {"no pair edge (not watertight)", 0},
+                                            {"non-manifold or inconsistently oriented edge", numBadEdges}};
+
+  for (const auto& n : faceNormals) {
+    warnings["degenerate face"] += (n == Vec3::zeros()) ? 1 : 0;
+  }
+  for (const uint32_t p : pairEdges) {
+    warnings["no pair edge (not watertight)"] += (p == noIndex) ? 1 : 0;
+  }
+
+  std::string baseError = "Soup::soupToTriangles(...)";
+  if (a_id != "") {
+    baseError += " for '" + a_id + "'";
+  }
+  baseError += " - warnings about error '";
+
+  for (const auto& warn : warnings) {
+    if (warn.second > 0) {
+      std::cerr << baseError << warn.first << "' = " << warn.second << "\n";
+    }
+  }
+}
+
 template <typename T, typename Meta>
 inline void
 Soup::reconcilePairEdgesDCEL(std::vector<std::shared_ptr<EBGeometry::DCEL::EdgeT<T, Meta>>>& a_edges) noexcept
 {
   static_assert(std::is_floating_point_v<T>, "Soup::reconcilePairEdgesDCEL requires a floating-point T");
 
-  for (auto& curEdge : a_edges) {
-    EBGEOMETRY_EXPECT(curEdge != nullptr);
+  using Vertex = EBGeometry::DCEL::VertexT<T, Meta>;
+
+  EBGEOMETRY_EXPECT(a_edges.size() < size_t(std::numeric_limits<uint32_t>::max()));
 
-    const auto& nextEdge = curEdge->getNextEdge();
-    EBGEOMETRY_EXPECT(nextEdge != nullptr);
+  const size_t numEdges = a_edges.size();
+  const size_t grain    = SFC::ParallelGrainSize;
 
-    const auto& vertexStart = curEdge->getVertex();
-    const auto& vertexEnd   = nextEdge->getVertex();
-    EBGEOMETRY_EXPECT(vertexStart != nullptr);
+  // Origin and end vertex of every half-edge, and a hash of the unordered pair.
+  std::vector<const Vertex*> from(numEdges);
+  std::vector<const Vertex*> to(numEdges);
+  std::vector<SFC::Code>     codes(numEdges);
 
-    for (const auto& p : vertexStart->getFaces()) {
-      EBGEOMETRY_EXPECT(p != nullptr);
+  Parallel::parallelFor(0, numEdges, grain, [&](const size_t a_lo, const size_t a_hi) noexcept {
+    for (size_t e = a_lo; e < a_hi; e++) {
+      const auto& curEdge = a_edges[e];
+      EBGEOMETRY_EXPECT(curEdge != nullptr);
 
-      for (EBGeometry::DCEL::EdgeIteratorT<T, Meta> edgeIt(*p); edgeIt.ok(); ++edgeIt) {
-        const auto& polyCurEdge = edgeIt();
-        EBGEOMETRY_EXPECT(polyCurEdge != nullptr);
+      const auto& nextEdge = curEdge->getNextEdge();
+      EBGEOMETRY_EXPECT(nextEdge != nullptr);
+      EBGEOMETRY_EXPECT(curEdge->getVertex() != nullptr);
 
-        const auto& polyNextEdge = polyCurEdge->getNextEdge();
-        EBGEOMETRY_EXPECT(polyNextEdge != nullptr);
+      from[e] = curEdge->getVertex().get();
+      to[e]   = nextEdge->getVertex().get();
 
-        const auto& polyVertexStart = polyCurEdge->getVertex();
-        const auto& polyVertexEnd   = polyNextEdge->getVertex();
+      const uint64_t a = uint64_t(reinterpret_cast<std::uintptr_t>(from[e]));
+      const uint64_t b = uint64_t(reinterpret_cast<std::uintptr_t>(to[e]));
 
-        if (vertexStart == polyVertexEnd && polyVertexStart == vertexEnd) { // Found the pair edge
-          curEdge->setPairEdge(polyCurEdge);
-          polyCurEdge->setPairEdge(curEdge);
+      codes[e] = Parallel::Detail::mix(std::min(a, b) + Parallel::Detail::mix(std::max(a, b)));
+    }
+  });
+
+  // Stable, so each run of equal codes lists its half-edges in ascending index.
+  const std::vector<uint32_t> order = SFC::sortByCode(codes);
+
+  std::vector<SFC::Code> sortedCodes(numEdges);
+
+  Parallel::parallelFor(0, numEdges, grain, [&](const size_t a_lo, const size_t a_hi) noexcept {
+    for (size_t k = a_lo; k < a_hi; k++) {
+      sortedCodes[k] = codes[order[k]];
+    }
+  });
+
+  codes = std::vector<SFC::Code>();
+
+  const auto sameEdge = [&from, &to](const uint32_t a_e1, const uint32_t a_e2) noexcept -> bool {
+    return (from[a_e1] == from[a_e2] && to[a_e1] == to[a_e2]) || (from[a_e1] == to[a_e2] && to[a_e1] == from[a_e2]);
+  };
+
+  // Each chunk links the runs of equal codes that start inside it and counts its own defects. Different vertex
+  // pairs only share a code by collision, so runs are short and scanning them is cheap.
+  const size_t numChunks = Parallel::Detail::numChunks(numEdges, grain);
+
+  std::vector<size_t> badEdges(numChunks, 0);
+
+  const auto linkRun = [&](const size_t a_chunk, const size_t a_begin, const size_t a_end) noexcept -> void {
+    for (size_t k = a_begin; k < a_end; k++) {
+      const uint32_t e = order[k];
+
+      // Only the first half-edge of each vertex pair handles the group.
+      bool isFirst = true;
+      for (size_t m = a_begin; m < k && isFirst; m++) {
+        isFirst = !sameEdge(order[m], e);
+      }
+
+      if (!isFirst) {
+        continue;
+      }
+
+      size_t groupSize = 1;
+      size_t pair      = a_end;
+
+      for (size_t m = k + 1; m < a_end; m++) {
+        if (sameEdge(order[m], e)) {
+          groupSize++;
+
+          if (pair == a_end && from[order[m]] == to[e]) {
+            pair = m;
+          }
         }
       }
+
+      if (pair != a_end) {
+        a_edges[e]->setPairEdge(a_edges[order[pair]]);
+        a_edges[order[pair]]->setPairEdge(a_edges[e]);
+      }
+
+      if (groupSize > 1) {
+        badEdges[a_chunk] += groupSize - ((pair != a_end) ? 2 : 0);
+      }
+    }
+  };
+
+  Parallel::parallelFor(0, numChunks, 1, [&](const size_t a_lo, const size_t a_hi) noexcept {
+    for (size_t chunk = a_lo; chunk < a_hi; chunk++) {
+      Parallel::Detail::forEachRun(sortedCodes,
+                                   Parallel::Detail::chunkBegin(numEdges, numChunks, chunk),
+                                   Parallel::Detail::chunkBegin(numEdges, numChunks, chunk + 1),
+                                   [&](const size_t a_begin, const size_t a_end) noexcept {
+                                     linkRun(chunk, a_begin, a_end);
+                                   });
     }
+  });
+
+  size_t numBadEdges = 0;
+  for (const size_t n : badEdges) {
+    numBadEdges += n;
+  }
+
+  if (numBadEdges > 0) {
+    const std::string baseError = "Soup::reconcilePairEdgesDCEL(...) - warnings about error '";
+
+    std::cerr << baseError << "non-manifold or inconsistently oriented edge' = " << numBadEdges << "\n";
   }
 }
 
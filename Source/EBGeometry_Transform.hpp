@@ -199,6 +199,16 @@ public:
   [[nodiscard]] T
   value(const Vec3T<T>& a_point) const noexcept override;
 
+  /**
+   * @brief Batched value function with the sign flipped.
+   * @details Evaluates the wrapped function over the whole array, then negates in place.
+   * @param[in]  a_points    Query points (a_numPoints entries).
+   * @param[out] a_values    Function values at a_points (a_numPoints entries).
+   * @param[in]  a_numPoints Number of query points.
+   */
+  void
+  values(const Vec3T<T>* a_points, T* a_values, std::size_t a_numPoints) const noexcept override;
+
 protected:
   /**
    * @brief Implicit function
@@ -269,6 +279,16 @@ public:
   [[nodiscard]] T
   value(const Vec3T<T>& a_point) const noexcept override;
 
+  /**
+   * @brief Batched value function with translation applied to the query points.
+   * @details Shifts the whole array into the wrapped function's frame, then evaluates it in one call.
+   * @param[in]  a_points    Query points (a_numPoints entries).
+   * @param[out] a_values    Function values at a_points (a_numPoints entries).
+   * @param[in]  a_numPoints Number of query points.
+   */
+  void
+  values(const Vec3T<T>* a_points, T* a_values, std::size_t a_numPoints) const noexcept override;
+
 protected:
   /**
    * @brief Underlying implicit function
@@ -347,7 +367,24 @@ public:
   [[nodiscard]] T
   value(const Vec3T<T>& a_point) const noexcept override;
 
+  /**
+   * @brief Batched value function with rotation applied to the query points.
+   * @details Inversely rotates the whole array, then evaluates the wrapped function in one call.
+   * @param[in]  a_points    Query points (a_numPoints entries).
+   * @param[out] a_values    Function values at a_points (a_numPoints entries).
+   * @param[in]  a_numPoints Number of query points.
+   */
+  void
+  values(const Vec3T<T>* a_points, T* a_values, std::size_t a_numPoints) const noexcept override;
+
 protected:
+  /**
+   * @brief Apply the inverse rotation to a query point (shared by value() and values()).
+   * @param[in] a_point Query point.
+   * @return The point rotated into the wrapped function's frame.
+   */
+  [[nodiscard]] inline Vec3T<T>
+  rotatePoint(const Vec3T<T>& a_point) const noexcept;
   /**
    * @brief Underlying implicit function.
    */
@@ -437,6 +474,16 @@ public:
   [[nodiscard]] T
   value(const Vec3T<T>& a_point) const noexcept override;
 
+  /**
+   * @brief Batched value function with the offset applied.
+   * @details Evaluates the wrapped function over the whole array, then subtracts the offset in place.
+   * @param[in]  a_points    Query points (a_numPoints entries).
+   * @param[out] a_values    Function values at a_points (a_numPoints entries).
+   * @param[in]  a_numPoints Number of query points.
+   */
+  void
+  values(const Vec3T<T>* a_points, T* a_values, std::size_t a_numPoints) const noexcept override;
+
 protected:
   /**
    * @brief Underlying implicit function.
@@ -512,6 +559,17 @@ public:
   [[nodiscard]] T
   value(const Vec3T<T>& a_point) const noexcept override;
 
+  /**
+   * @brief Batched value function with scaling applied.
+   * @details Scales the whole array into the wrapped function's frame, evaluates it in one call, and rescales the
+   * values.
+   * @param[in]  a_points    Query points (a_numPoints entries).
+   * @param[out] a_values    Function values at a_points (a_numPoints entries).
+   * @param[in]  a_numPoints Number of query points.
+   */
+  void
+  values(const Vec3T<T>* a_points, T* a_values, std::size_t a_numPoints) const noexcept override;
+
 protected:
   /**
    * @brief Original implicit function.
@@ -587,6 +645,16 @@ public:
   [[nodiscard]] T
   value(const Vec3T<T>& a_point) const noexcept override;
 
+  /**
+   * @brief Batched value function for the annular shell.
+   * @details Evaluates the wrapped function over the whole array, then applies |f| - delta in place.
+   * @param[in]  a_points    Query points (a_numPoints entries).
+   * @param[out] a_values    Function values at a_points (a_numPoints entries).
+   * @param[in]  a_numPoints Number of query points.
+   */
+  void
+  values(const Vec3T<T>* a_points, T* a_values, std::size_t a_numPoints) const noexcept override;
+
 protected:
   /**
    * @brief Original implicit function.
@@ -669,6 +737,17 @@ public:
   [[nodiscard]] T
   value(const Vec3T<T>& a_point) const noexcept override;
 
+  /**
+   * @brief Batched blurred value function.
+   * @details Evaluates the wrapped function once per stencil offset over the whole array and accumulates the stencil
+   * sum with the same grouping as value(), so results are identical.
+   * @param[in]  a_points    Query points (a_numPoints entries).
+   * @param[out] a_values    Function values at a_points (a_numPoints entries).
+   * @param[in]  a_numPoints Number of query points.
+   */
+  void
+  values(const Vec3T<T>* a_points, T* a_values, std::size_t a_numPoints) const noexcept override;
+
 protected:
   /**
    * @brief Original implicit function
@@ -757,6 +836,17 @@ public:
   [[nodiscard]] T
   value(const Vec3T<T>& a_point) const noexcept override;
 
+  /**
+   * @brief Batched mollified value function.
+   * @details Evaluates the wrapped function once per mollifier sample over the whole array and accumulates the weighted
+   * sum in the same order as value(), so results are identical.
+   * @param[in]  a_points    Query points (a_numPoints entries).
+   * @param[out] a_values    Function values at a_points (a_numPoints entries).
+   * @param[in]  a_numPoints Number of query points.
+   */
+  void
+  values(const Vec3T<T>* a_points, T* a_values, std::size_t a_numPoints) const noexcept override;
+
 protected:
   /**
    * @brief Original implicit function.
@@ -840,6 +930,16 @@ public:
   [[nodiscard]] T
   value(const Vec3T<T>& a_point) const noexcept override;
 
+  /**
+   * @brief Batched value function with elongation applied.
+   * @details Elongates the whole array, then evaluates the wrapped function in one call.
+   * @param[in]  a_points    Query points (a_numPoints entries).
+   * @param[out] a_values    Function values at a_points (a_numPoints entries).
+   * @param[in]  a_numPoints Number of query points.
+   */
+  void
+  values(const Vec3T<T>* a_points, T* a_values, std::size_t a_numPoints) const noexcept override;
+
 protected:
   /**
    * @brief Underlying implicit function to be elongated
@@ -915,6 +1015,16 @@ public:
   [[nodiscard]] T
   value(const Vec3T<T>& a_point) const noexcept override;
 
+  /**
+   * @brief Batched value function with reflection applied.
+   * @details Reflects the whole array, then evaluates the wrapped function in one call.
+   * @param[in]  a_points    Query points (a_numPoints entries).
+   * @param[out] a_values    Function values at a_points (a_numPoints entries).
+   * @param[in]  a_numPoints Number of query points.
+   */
+  void
+  values(const Vec3T<T>* a_points, T* a_values, std::size_t a_numPoints) const noexcept override;
+
 protected:
   /**
    * @brief Underlying implicit function to be reflected
@@ -12,6 +12,8 @@
 #define EBGEOMETRY_TRANSFORMIMPLEM_HPP
 
 // Std includes
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstddef>
 #include <memory>
@@ -136,6 +138,19 @@ ComplementIF<T>::value(const Vec3T<T>& a_point) const noexcept
   return -m_implicitFunction->value(a_point);
 }
 
+template <class T>
+void
+ComplementIF<T>::values(const Vec3T<T>* a_points, T* a_values, std::size_t a_numPoints) const noexcept
+{
+  EBGEOMETRY_EXPECT(m_implicitFunction != nullptr);
+
+  m_implicitFunction->values(a_points, a_values, a_numPoints);
+
+  for (std::size_t i = 0; i < a_numPoints; i++) {
+    a_values[i] = -a_values[i];
+  }
+}
+
 template <class T>
 TranslateIF<T>::TranslateIF(const std::shared_ptr<ImplicitFunction<T>>& a_implicitFunction,
                             const Vec3T<T>&                             a_translation) noexcept
@@ -161,6 +176,28 @@ TranslateIF<T>::value(const Vec3T<T>& a_point) const noexcept
   return m_implicitFunction->value(a_point - m_shift);
 }
 
+template <class T>
+void
+TranslateIF<T>::values(const Vec3T<T>* a_points, T* a_values, std::size_t a_numPoints) const noexcept
+{
+  EBGEOMETRY_EXPECT(m_implicitFunction != nullptr);
+
+  constexpr std::size_t chunkSize = ImplicitFunction<T>::s_batchChunkSize;
+
+  std::array<Vec3T<T>, chunkSize> mappedPoints;
+
+  // The point transform is applied to a chunk at a time so the mapped points live on the stack.
+  for (std::size_t begin = 0; begin < a_numPoints; begin += chunkSize) {
+    const std::size_t count = std::min(chunkSize, a_numPoints - begin);
+
+    for (std::size_t i = 0; i < count; i++) {
+      mappedPoints[i] = a_points[begin + i] - m_shift;
+    }
+
+    m_implicitFunction->values(mappedPoints.data(), a_values + begin, count);
+  }
+}
+
 template <class T>
 RotateIF<T>::RotateIF(const std::shared_ptr<ImplicitFunction<T>>& a_implicitFunction,
                       const T                                     a_angle,
@@ -189,6 +226,34 @@ RotateIF<T>::value(const Vec3T<T>& a_point) const noexcept
   EBGEOMETRY_EXPECT(std::isfinite(a_point[1]));
   EBGEOMETRY_EXPECT(std::isfinite(a_point[2]));
 
+  return m_implicitFunction->value(this->rotatePoint(a_point));
+}
+
+template <class T>
+void
+RotateIF<T>::values(const Vec3T<T>* a_points, T* a_values, std::size_t a_numPoints) const noexcept
+{
+  EBGEOMETRY_EXPECT(m_implicitFunction != nullptr);
+
+  constexpr std::size_t chunkSize = ImplicitFunction<T>::s_batchChunkSize;
+
+  std::array<Vec3T<T>, chunkSize> mappedPoints;
+
+  for (std::size_t begin = 0; begin < a_numPoints; begin += chunkSize) {
+    const std::size_t count = std::min(chunkSize, a_numPoints - begin);
+
+    for (std::size_t i = 0; i < count; i++) {
+      mappedPoints[i] = this->rotatePoint(a_points[begin + i]);
+    }
+
+    m_implicitFunction->values(mappedPoints.data(), a_values + begin, count);
+  }
+}
+
+template <class T>
+Vec3T<T>
+RotateIF<T>::rotatePoint(const Vec3T<T>& a_point) const noexcept
+{
   const T& x = a_point[0];
   const T& y = a_point[1];
   const T& z = a_point[2];
@@ -221,7 +286,7 @@ RotateIF<T>::value(const Vec3T<T>& a_point) const noexcept
   }
   }
 
-  return m_implicitFunction->value(rotatedPoint);
+  return rotatedPoint;
 }
 
 template <class T>
@@ -246,6 +311,19 @@ OffsetIF<T>::value(const Vec3T<T>& a_point) const noexcept
   return m_implicitFunction->value(a_point) - m_offset;
 }
 
+template <class T>
+void
+OffsetIF<T>::values(const Vec3T<T>* a_points, T* a_values, std::size_t a_numPoints) const noexcept
+{
+  EBGEOMETRY_EXPECT(m_implicitFunction != nullptr);
+
+  m_implicitFunction->values(a_points, a_values, a_numPoints);
+
+  for (std::size_t i = 0; i < a_numPoints; i++) {
+    a_values[i] = a_values[i] - m_offset;
+  }
+}
+
 template <class T>
 ScaleIF<T>::ScaleIF(const std::shared_ptr<ImplicitFunction<T>>& a_implicitFunction, const T a_scale) noexcept
 {
@@ -269,6 +347,31 @@ ScaleIF<T>::value(const Vec3T<T>& a_point) const noexcept
   return (m_implicitFunction->value(a_point / m_scale)) * m_scale;
 }
 
+template <class T>
+void
+ScaleIF<T>::values(const Vec3T<T>* a_points, T* a_values, std::size_t a_numPoints) const noexcept
+{
+  EBGEOMETRY_EXPECT(m_implicitFunction != nullptr);
+
+  constexpr std::size_t chunkSize = ImplicitFunction<T>::s_batchChunkSize;
+
+  std::array<Vec3T<T>, chunkSize> mappedPoints;
+
+  for (std::size_t begin = 0; begin < a_numPoints; begin += chunkSize) {
+    const std::size_t count = std::min(chunkSize, a_numPoints - begin);
+
+    for (std::size_t i = 0; i < count; i++) {
+      mappedPoints[i] = a_points[begin + i] / m_scale;
+    }
+
+    m_implicitFunction->values(mappedPoints.data(), a_values + begin, count);
+
+    for (std::size_t i = 0; i < count; i++) {
+      a_values[begin + i] *= m_scale;
+    }
+  }
+}
+
 template <class T>
 AnnularIF<T>::AnnularIF(const std::shared_ptr<ImplicitFunction<T>>& a_implicitFunction, const T a_delta) noexcept
 {
@@ -291,6 +394,19 @@ AnnularIF<T>::value(const Vec3T<T>& a_point) const noexcept
   return std::abs(m_implicitFunction->value(a_point)) - m_delta;
 }
 
+template <class T>
+void
+AnnularIF<T>::values(const Vec3T<T>* a_points, T* a_values, std::size_t a_numPoints) const noexcept
+{
+  EBGEOMETRY_EXPECT(m_implicitFunction != nullptr);
+
+  m_implicitFunction->values(a_points, a_values, a_numPoints);
+
+  for (std::size_t i = 0; i < a_numPoints; i++) {
+    a_values[i] = std::abs(a_values[i]) - m_delta;
+  }
+}
+
 template <class T>
 BlurIF<T>::BlurIF(const std::shared_ptr<ImplicitFunction<T>>& a_implicitFunction,
                   const T                                     a_blurDistance,
@@ -341,6 +457,75 @@ BlurIF<T>::value(const Vec3T<T>& a_point) const noexcept
   return value;
 }
 
+template <class T>
+void
+BlurIF<T>::values(const Vec3T<T>* a_points, T* a_values, std::size_t a_numPoints) const noexcept
+{
+  EBGEOMETRY_EXPECT(m_implicitFunction != nullptr);
+
+  const T A = std::pow(m_alpha, T(3.0)) * std::pow((T(1.0) - m_alpha) / T(2.0), T(0.0));
+  const T B = std::pow(m_alpha, T(2.0)) * std::pow((T(1.0) - m_alpha) / T(2.0), T(1.0));
+  const T C = std::pow(m_alpha, T(1.0)) * std::pow((T(1.0) - m_alpha) / T(2.0), T(2.0));
+  const T D = std::pow(m_alpha, T(0.0)) * std::pow((T(1.0) - m_alpha) / T(2.0), T(3.0));
+
+  const Vec3T<T> x = m_blurDistance * Vec3T<T>::unit(0);
+  const Vec3T<T> y = m_blurDistance * Vec3T<T>::unit(1);
+  const Vec3T<T> z = m_blurDistance * Vec3T<T>::unit(2);
+
+  // The 27 stencil offsets, as signs on (x, y, z) in the exact order value() visits them. Each offset is applied
+  // to p one axis at a time (p + x + y rather than p + (x + y)) so the stencil points are bitwise those of value().
+  constexpr int numStencil = 27;
+  constexpr int stencil[numStencil][3] = {
+    {0, 0, 0},   {1, 0, 0},   {-1, 0, 0},  {0, 1, 0},   {0, -1, 0}, {0, 0, 1},   {0, 0, -1},  {1, 1, 0},   {1, -1, 0},
+    {-1, 1, 0},  {-1, -1, 0}, {1, 0, 1},   {1, 0, -1},  {-1, 0, 1}, {-1, 0, -1}, {0, 1, 1},   {0, 1, -1},  {0, -1, 1},
+    {0, -1, -1}, {1, 1, 1},   {1, 1, -1},  {1, -1, 1},  {1, -1, -1}, {-1, 1, 1}, {-1, 1, -1}, {-1, -1, 1}, {-1, -1, -1}};
+
+  const Vec3T<T> axes[3] = {x, y, z};
+
+  // Smaller chunks than the other transforms: all 27 stencil values per point are held until the point is reduced.
+  constexpr std::size_t chunkSize = 32;
+
+  std::array<Vec3T<T>, chunkSize>          mappedPoints;
+  std::array<std::array<T, chunkSize>, 27> f;
+
+  for (std::size_t begin = 0; begin < a_numPoints; begin += chunkSize) {
+    const std::size_t count = std::min(chunkSize, a_numPoints - begin);
+
+    for (int s = 0; s < numStencil; s++) {
+      for (std::size_t i = 0; i < count; i++) {
+        Vec3T<T> p = a_points[begin + i];
+
+        for (int dir = 0; dir < 3; dir++) {
+          if (stencil[s][dir] > 0) {
+            p = p + axes[dir];
+          }
+          else if (stencil[s][dir] < 0) {
+            p = p - axes[dir];
+          }
+        }
+
+        mappedPoints[i] = p;
+      }
+
+      m_implicitFunction->values(mappedPoints.data(), f[s].data(), count);
+    }
+
+    for (std::size_t i = 0; i < count; i++) {
+      T value = 0.0;
+
+      value += A * f[0][i];
+      value += B * (f[1][i] + f[2][i] + f[3][i] + f[4][i] + f[5][i] + f[6][i]);
+      value += C * (f[7][i] + f[8][i] + f[9][i] + f[10][i]);
+      value += C * (f[11][i] + f[12][i] + f[13][i] + f[14][i]);
+      value += C * (f[15][i] + f[16][i] + f[17][i] + f[18][i]);
+      value += D * (f[19][i] + f[20][i] + f[21][i] + f[22][i]);
+      value += D * (f[23][i] + f[24][i] + f[25][i] + f[26][i]);
+
+      a_values[begin + i] = value;
+    }
+  }
+}
+
 template <class T>
 MollifyIF<T>::MollifyIF(const std::shared_ptr<ImplicitFunction<T>>& a_implicitFunction,
                         const std::shared_ptr<ImplicitFunction<T>>& a_mollifier,
@@ -406,6 +591,41 @@ MollifyIF<T>::value(const Vec3T<T>& a_point) const noexcept
   return ret;
 }
 
+template <class T>
+void
+MollifyIF<T>::values(const Vec3T<T>* a_points, T* a_values, std::size_t a_numPoints) const noexcept
+{
+  EBGEOMETRY_EXPECT(m_implicitFunction != nullptr);
+  EBGEOMETRY_EXPECT(!m_sampledMollifier.empty());
+
+  constexpr std::size_t chunkSize = ImplicitFunction<T>::s_batchChunkSize;
+
+  std::array<Vec3T<T>, chunkSize> mappedPoints;
+  std::array<T, chunkSize>        childValues;
+
+  // One batched child call per mollifier sample (rather than per sample per point), accumulating in the same order
+  // as value().
+  for (std::size_t begin = 0; begin < a_numPoints; begin += chunkSize) {
+    const std::size_t count = std::min(chunkSize, a_numPoints - begin);
+
+    T* ret = a_values + begin;
+
+    std::fill(ret, ret + count, T(0.0));
+
+    for (const auto& mollifier : m_sampledMollifier) {
+      for (std::size_t i = 0; i < count; i++) {
+        mappedPoints[i] = a_points[begin + i] - mollifier.first;
+      }
+
+      m_implicitFunction->values(mappedPoints.data(), childValues.data(), count);
+
+      for (std::size_t i = 0; i < count; i++) {
+        ret[i] += childValues[i] * mollifier.second;
+      }
+    }
+  }
+}
+
 template <class T>
 ElongateIF<T>::ElongateIF(const std::shared_ptr<ImplicitFunction<T>>& a_implicitFunction,
                           const Vec3T<T>&                             a_elongation) noexcept
@@ -434,6 +654,27 @@ ElongateIF<T>::value(const Vec3T<T>& a_point) const noexcept
   return m_implicitFunction->value(a_point - clamp(a_point, -m_elongation, m_elongation));
 }
 
+template <class T>
+void
+ElongateIF<T>::values(const Vec3T<T>* a_points, T* a_values, std::size_t a_numPoints) const noexcept
+{
+  EBGEOMETRY_EXPECT(m_implicitFunction != nullptr);
+
+  constexpr std::size_t chunkSize = ImplicitFunction<T>::s_batchChunkSize;
+
+  std::array<Vec3T<T>, chunkSize> mappedPoints;
+
+  for (std::size_t begin = 0; begin < a_numPoints; begin += chunkSize) {
+    const std::size_t count = std::min(chunkSize, a_numPoints - begin);
+
+    for (std::size_t i = 0; i < count; i++) {
+      mappedPoints[i] = a_points[begin + i] - clamp(a_points[begin + i], -m_elongation, m_elongation);
+    }
+
+    m_implicitFunction->values(mappedPoints.data(), a_values + begin, count);
+  }
+}
+
 template <class T>
 ReflectIF<T>::ReflectIF(const std::shared_ptr<ImplicitFunction<T>>& a_implicitFunction,
                         const size_t&                               a_reflectPlane) noexcept
@@ -461,6 +702,27 @@ ReflectIF<T>::value(const Vec3T<T>& a_point) const noexcept
   return m_implicitFunction->value(a_point * m_reflectParams);
 }
 
+template <class T>
+void
+ReflectIF<T>::values(const Vec3T<T>* a_points, T* a_values, std::size_t a_numPoints) const noexcept
+{
+  EBGEOMETRY_EXPECT(m_implicitFunction != nullptr);
+
+  constexpr std::size_t chunkSize = ImplicitFunction<T>::s_batchChunkSize;
+
+  std::array<Vec3T<T>, chunkSize> mappedPoints;
+
+  for (std::size_t begin = 0; begin < a_numPoints; begin += chunkSize) {
+    const std::size_t count = std::min(chunkSize, a_numPoints - begin);
+
+    for (std::size_t i = 0; i < count; i++) {
+      mappedPoints[i] = a_points[begin + i] * m_reflectParams;
+    }
+
+    m_implicitFunction->values(mappedPoints.data(), a_values + begin, count);
+  }
+}
+
 } // namespace EBGeometry
 
 #endif
@@ -21,6 +21,7 @@
 
 // Our includes
 #include "EBGeometry_DCEL.hpp"
+#include "EBGeometry_Triangle.hpp"
 #include "EBGeometry_Vec.hpp"
 
 namespace EBGeometry {
@@ -184,6 +185,27 @@ public:
   [[nodiscard]] std::shared_ptr<EBGeometry::DCEL::MeshT<T, Meta>>
   convertToDCEL() const noexcept;
 
+  /**
+   * @brief Turn the VTK mesh into an index-based DCEL mesh.
+   * @details Like convertToDCEL() but produces the flat arrays of DCEL::IndexedMeshT. No meta-data is populated.
+   * @tparam Meta Metadata type attached to DCEL vertices, edges, and faces.
+   * @return Shared pointer to the constructed DCEL mesh.
+   */
+  template <typename Meta>
+  [[nodiscard]] std::shared_ptr<EBGeometry::DCEL::IndexedMeshT<T, Meta>>
+  convertToIndexedDCEL() const noexcept;
+
+  /**
+   * @brief Turn the VTK mesh into self-contained triangles without building a DCEL mesh.
+   * @details Computes the same pseudonormals as convertToDCEL() directly from the facet indices, see
+   * Soup::soupToTriangles(). No meta-data is populated.
+   * @tparam Meta Metadata type attached to the triangles.
+   * @return Triangles stored contiguously.
+   */
+  template <typename Meta>
+  [[nodiscard]] std::vector<EBGeometry::Triangle<T, Meta>>
+  convertToTriangles() const noexcept;
+
 protected:
   /**
    * @brief VTK object ID.
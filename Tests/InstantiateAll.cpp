@@ -78,6 +78,8 @@ using Meta = short;
                                                                                \
   /* -- Mesh distance functions --------------------------------------------*/\
   template class FlatMeshSDF<PREC, Meta>;                                    \
+  template class InstanceTransform<PREC>;                                    \
+  template class InstancedSDF<PREC, TriMeshSDF<PREC, Meta, 4, 4>, 4>;        \
                                                                                \
   /* -- Point clouds --------------------------------------------------------*/\
   template struct PointSoAT<PREC>;                                           \
@@ -85,6 +87,11 @@ using Meta = short;
   template class PointCloudBVH<PREC, Meta>;                                  \
   template class PointCloudHashGrid<PREC, Meta>;                             \
                                                                                \
+  /* -- Compressed BVHs -----------------------------------------------------*/\
+  template class BVH::QuantizedBVH<PREC, Triangle<PREC, Meta>, 4>;           \
+  template class BVH::QuantizedBVH<PREC, Triangle<PREC, Meta>, 8, uint16_t>; \
+  template class BVH::DeformingBVH<PREC, Triangle<PREC, Meta>, 4>;           \
+                                                                               \
   namespace BoundingVolumes {                                                \
   template class AABBT<PREC>;                                                \
   template class SphereT<PREC>;                                              \
@@ -95,6 +102,7 @@ using Meta = short;
   template class FaceT<PREC, Meta>;                                         \
   template class EdgeT<PREC, Meta>;                                         \
   template class VertexT<PREC, Meta>;                                       \
+  template class IndexedMeshT<PREC, Meta>;                                  \
   }
 
 EBGEOMETRY_INSTANTIATE_ALL(double)
@@ -124,6 +132,8 @@ instantiateFunctionTemplates()
 
   (void)Parser::readIntoDCEL<T, Meta>(file);
   (void)Parser::readIntoDCEL<T, Meta>(files);
+  (void)Parser::readIntoIndexedDCEL<T, Meta>(file);
+  (void)Parser::readIntoIndexedDCEL<T, Meta>(files);
   (void)Parser::readIntoMesh<T, Meta>(file);
   (void)Parser::readIntoMesh<T, Meta>(files);
   (void)Parser::readIntoPackedBVH<T, Meta>(file);
@@ -132,11 +142,22 @@ instantiateFunctionTemplates()
   (void)Parser::readIntoTriangles<T, Meta>(files);
   (void)Parser::readIntoTriangleBVH<T, Meta>(file);
   (void)Parser::readIntoTriangleBVH<T, Meta>(files);
+  (void)TriMeshSDF<T, Meta, 4, 4>::load(file);
+  (void)TriMeshSDF<T, Meta, 4, 4>::map(file);
+  (void)&TriMeshSDF<T, Meta, 4, 4>::save;
 
   (void)STL<T>().template convertToDCEL<Meta>();
   (void)PLY<T>().template convertToDCEL<Meta>();
   (void)VTK<T>().template convertToDCEL<Meta>();
   (void)OBJ<T>().template convertToDCEL<Meta>();
+  (void)STL<T>().template convertToIndexedDCEL<Meta>();
+  (void)PLY<T>().template convertToIndexedDCEL<Meta>();
+  (void)VTK<T>().template convertToIndexedDCEL<Meta>();
+  (void)OBJ<T>().template convertToIndexedDCEL<Meta>();
+  (void)STL<T>().template convertToTriangles<Meta>();
+  (void)PLY<T>().template convertToTriangles<Meta>();
+  (void)VTK<T>().template convertToTriangles<Meta>();
+  (void)OBJ<T>().template convertToTriangles<Meta>();
 }
 
 template void
@@ -11,10 +11,17 @@
 #include "EBGeometry.hpp"
 #include "TestFloatingPointUtils.hpp"
 
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
 #include <limits>
 #include <memory>
+#include <numeric>
 #include <random>
+#include <sstream>
+#include <string>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -191,6 +198,12 @@ TEMPLATE_TEST_CASE("TreeBVH/PackedBVH: signedDistance agrees with the brute-forc
   buildAndCheck("BottomUp (Morton)", [](auto& a_tree) { a_tree.template bottomUpSortAndPartition<SFC::Morton>(); });
 
   buildAndCheck("BottomUp (Nested)", [](auto& a_tree) { a_tree.template bottomUpSortAndPartition<SFC::Nested>(); });
+
+  buildAndCheck("PLOC (Morton)", [](auto& a_tree) { a_tree.plocSortAndPartition(); });
+
+  buildAndCheck("PLOC (Hilbert, radius 2)", [](auto& a_tree) {
+    a_tree.template plocSortAndPartition<SFC::Hilbert>(K - 1, 2);
+  });
 }
 
 TEMPLATE_TEST_CASE("MeshSDF: signedDistance agrees with FlatMeshSDF for every BVH::Build strategy",
@@ -206,7 +219,12 @@ TEMPLATE_TEST_CASE("MeshSDF: signedDistance agrees with FlatMeshSDF for every BV
 
   const FlatMeshSDF<T, Meta> flat(mesh);
 
-  for (const auto build : {BVH::Build::TopDown, BVH::Build::Morton, BVH::Build::Nested, BVH::Build::SAH}) {
+  for (const auto build : {BVH::Build::TopDown,
+                           BVH::Build::Morton,
+                           BVH::Build::Nested,
+                           BVH::Build::SAH,
+                           BVH::Build::PLOC,
+                           BVH::Build::SBVH}) {
     const MeshSDF<T, Meta, K> packed(mesh, build);
 
     for (const auto& p : queryPoints<T>()) {
@@ -230,7 +248,12 @@ TEMPLATE_TEST_CASE("TriMeshSDF: signedDistance agrees with FlatMeshSDF and MeshS
   const FlatMeshSDF<T, Meta> flat(mesh);
   const MeshSDF<T, Meta, K>  packed(mesh, BVH::Build::SAH);
 
-  for (const auto build : {BVH::Build::TopDown, BVH::Build::Morton, BVH::Build::Nested, BVH::Build::SAH}) {
+  for (const auto build : {BVH::Build::TopDown,
+                           BVH::Build::Morton,
+                           BVH::Build::Nested,
+                           BVH::Build::SAH,
+                           BVH::Build::PLOC,
+                           BVH::Build::SBVH}) {
     const TriMeshSDF<T, Meta, K, W> tri(mesh, build, 2);
 
     for (const auto& p : queryPoints<T>()) {
@@ -240,6 +263,128 @@ TEMPLATE_TEST_CASE("TriMeshSDF: signedDistance agrees with FlatMeshSDF and MeshS
   }
 }
 
+TEMPLATE_TEST_CASE("MeshSDF/TriMeshSDF values(): batched evaluation matches signedDistance() for coherent and "
+                   "incoherent point orders",
+                   "[BVH][Dodecahedron][Batch]",
+                   EBGEOMETRY_TEST_PRECISIONS)
+{
+  using T    = TestType;
+  using Vec3 = Vec3T<T>;
+
+  constexpr size_t K = 4;
+  constexpr size_t W = 4;
+
+  const auto mesh = Parser::readIntoDCEL<T, Meta>(dataPath("dodecahedron.stl"));
+  REQUIRE(mesh != nullptr);
+
+  const MeshSDF<T, Meta, K>       packed(mesh, BVH::Build::SAH);
+  const TriMeshSDF<T, Meta, K, W> tri(mesh, BVH::Build::SAH, 2);
+
+  // A lexicographic grid (coherent: consecutive points are neighbors, the case the packet
+  // traversal is built for), followed by the same grid shuffled (incoherent: packets spread over
+  // the whole tree, which must never change the result).
+  std::vector<Vec3> points;
+  for (int i = 0; i <= 8; i++) {
+    for (int j = 0; j <= 8; j++) {
+      for (int k = 0; k <= 8; k++) {
+        points.emplace_back(T(-2) + T(0.5) * T(i), T(-2) + T(0.5) * T(j), T(-2) + T(0.5) * T(k));
+      }
+    }
+  }
+
+  std::vector<Vec3> shuffled = points;
+  std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937(42));
+  points.insert(points.end(), shuffled.begin(), shuffled.end());
+
+  std::vector<T> packedValues(points.size());
+  std::vector<T> triValues(points.size());
+
+  packed.values(points.data(), packedValues.data(), points.size());
+  tri.values(points.data(), triValues.data(), points.size());
+
+  for (size_t i = 0; i < points.size(); i++) {
+    REQUIRE(packedValues[i] == packed.signedDistance(points[i]));
+    REQUIRE(triValues[i] == tri.signedDistance(points[i]));
+  }
+}
+
+TEMPLATE_TEST_CASE("MeshSDF/TriMeshSDF values(): exact ties between faces resolve as in signedDistance()",
+                   "[BVH][Batch]",
+                   EBGEOMETRY_TEST_PRECISIONS)
+{
+  using T    = TestType;
+  using Vec3 = Vec3T<T>;
+
+  constexpr size_t K = 4;
+  constexpr size_t W = 4;
+
+  // Two overlapping axis-aligned cubes, [-1, 1]^3 and the same shifted by 1.5 along x, queried on a dyadic lattice:
+  // every distance is exact, and the lattice is full of points exactly equidistant from two or more faces. Where
+  // the cubes overlap, such faces can disagree on the sign (e.g. (1.5, 0.5, 0) is 0.5 outside the first cube and
+  // 0.5 inside the second), so a tie resolved differently shows up as a flipped sign.
+  std::vector<Vec3>                verts;
+  std::vector<std::vector<size_t>> facets;
+
+  for (const T shift : {T(0), T(1.5)}) {
+    const size_t first = verts.size();
+
+    for (int corner = 0; corner < 8; corner++) {
+      verts.emplace_back(shift + T((corner & 1) ? 1 : -1), T((corner & 2) ? 1 : -1), T((corner & 4) ? 1 : -1));
+    }
+
+    for (const auto& tri : std::vector<std::vector<size_t>>{{0, 2, 3},
+                                                            {0, 3, 1},
+                                                            {4, 5, 7},
+                                                            {4, 7, 6},
+                                                            {0, 1, 5},
+                                                            {0, 5, 4},
+                                                            {2, 6, 7},
+                                                            {2, 7, 3},
+                                                            {1, 3, 7},
+                                                            {1, 7, 5},
+                                                            {0, 4, 6},
+                                                            {0, 6, 2}}) {
+      facets.push_back({first + tri[0], first + tri[1], first + tri[2]});
+    }
+  }
+
+  auto mesh = std::make_shared<DCEL::MeshT<T, Meta>>();
+  Soup::soupToDCEL(*mesh, verts, facets, "cubes");
+  mesh->reconcile();
+
+  std::vector<Vec3> points;
+  for (int i = -8; i <= 14; i++) {
+    for (int j = -8; j <= 8; j++) {
+      for (int k = -8; k <= 8; k++) {
+        points.emplace_back(T(0.25) * T(i), T(0.25) * T(j), T(0.25) * T(k));
+      }
+    }
+  }
+
+  std::vector<Vec3> shuffled = points;
+  std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937(7));
+  points.insert(points.end(), shuffled.begin(), shuffled.end());
+
+  for (const auto build : {BVH::Build::SAH, BVH::Build::PLOC, BVH::Build::SBVH}) {
+    const MeshSDF<T, Meta, K>       packed(mesh, build);
+    const TriMeshSDF<T, Meta, K, W> tri(mesh, build, 1);
+
+    std::vector<T> packedValues(points.size());
+    std::vector<T> triValues(points.size());
+
+    packed.values(points.data(), packedValues.data(), points.size());
+    tri.values(points.data(), triValues.data(), points.size());
+
+    for (size_t i = 0; i < points.size(); i++) {
+      const T triDist = tri.signedDistance(points[i]);
+
+      REQUIRE(packedValues[i] == packed.signedDistance(points[i]));
+      REQUIRE(triValues[i] == triDist);
+      REQUIRE(tri.getClosestTriangle(points[i]).signedDistance == triDist);
+    }
+  }
+}
+
 TEMPLATE_TEST_CASE("MeshSDF::getClosestFaces returns the correct number of candidate faces, sorted on request",
                    "[BVH][Dodecahedron]",
                    EBGEOMETRY_TEST_PRECISIONS)
@@ -267,6 +412,71 @@ TEMPLATE_TEST_CASE("MeshSDF::getClosestFaces returns the correct number of candi
   REQUIRE_THAT(closestUnsignedDist, withinAbsT(std::abs(packed.signedDistance(p)), traversalMargin<T>()));
 }
 
+TEMPLATE_TEST_CASE("MeshSDF::getClosestFaces reports every face once under an SBVH build",
+                   "[BVH][SBVH]",
+                   EBGEOMETRY_TEST_PRECISIONS)
+{
+  using T    = TestType;
+  using Vec3 = Vec3T<T>;
+
+  constexpr size_t K = 4;
+  constexpr size_t N = 200;
+
+  // A flat bipyramid: every face is a long sliver from one of the two apexes to the rim, so the SBVH build splits
+  // space and puts faces into several leaves.
+  const T pi = T(4) * std::atan(T(1));
+
+  std::vector<Vec3>                verts{Vec3(0, 0, T(0.5)), Vec3(0, 0, T(-0.5))};
+  std::vector<std::vector<size_t>> facets;
+  for (size_t i = 0; i < N; i++) {
+    const T t = T(2) * pi * T(i) / T(N);
+
+    verts.emplace_back(10 * std::cos(t), 10 * std::sin(t), T(0));
+
+    const size_t cur  = 2 + i;
+    const size_t next = 2 + (i + 1) % N;
+
+    facets.push_back({0, cur, next});
+    facets.push_back({1, next, cur});
+  }
+
+  auto mesh = std::make_shared<DCEL::MeshT<T, Meta>>();
+  Soup::soupToDCEL(*mesh, verts, facets, "bipyramid");
+  mesh->reconcile();
+
+  const MeshSDF<T, Meta, K> sbvh(mesh, BVH::Build::SBVH);
+  const MeshSDF<T, Meta, K> sah(mesh, BVH::Build::SAH);
+
+  REQUIRE(sbvh.computeMetrics().numPrimitives > mesh->getFaces().size());
+
+  // Points all over the bipyramid. A face is reached again when the clipped box of another of its parts is no
+  // farther away than the face itself.
+  std::vector<Vec3> points;
+
+  unsigned int state = 2468u;
+  const auto   next  = [&state]() -> T {
+    state = state * 1103515245u + 12345u;
+    return T((state >> 8) % 10000u) / T(5000) - T(1);
+  };
+  for (int i = 0; i < 400; i++) {
+    points.emplace_back(12 * next(), 12 * next(), 2 * next());
+  }
+
+  for (const auto& q : points) {
+    const auto faces = sbvh.getClosestFaces(q, true);
+    REQUIRE(!faces.empty());
+
+    std::vector<const DCEL::FaceT<T, Meta>*> unique;
+    for (const auto& face : faces) {
+      unique.emplace_back(face.first.get());
+    }
+    std::sort(unique.begin(), unique.end());
+
+    CHECK(std::adjacent_find(unique.begin(), unique.end()) == unique.end());
+    CHECK_THAT(faces.front().second, withinAbsT(sah.getClosestFaces(q, true).front().second, tightMargin<T>()));
+  }
+}
+
 TEMPLATE_TEST_CASE("TriMeshSDF::getClosestTriangle reports the closest triangle's metadata and a "
                    "distance matching signedDistance()",
                    "[BVH][TriMesh][Meta]",
@@ -392,6 +602,98 @@ TEMPLATE_TEST_CASE("PackedBVH::pruneTraverse: nearest-neighbor search over a pri
   }
 }
 
+TEMPLATE_TEST_CASE("PackedBVH::packetPruneTraverse: every lane of a packet finds the same nearest "
+                   "neighbor as an independent pruneTraverse()",
+                   "[BVH][pruneTraverse][packet]",
+                   EBGEOMETRY_TEST_PRECISIONS)
+{
+  using T    = TestType;
+  using AABB = BoundingVolumes::AABBT<T>;
+  using Vec3 = Vec3T<T>;
+  using Pnt  = BareTestPoint<T>;
+
+  constexpr size_t K = 4;
+
+  std::vector<Vec3> positions;
+  for (int i = 0; i < 5; i++) {
+    for (int j = 0; j < 5; j++) {
+      for (int k = 0; k < 5; k++) {
+        positions.emplace_back(T(i) + T(0.3) * T(j), T(j) - T(0.2) * T(k), T(k) + T(0.1) * T(i));
+      }
+    }
+  }
+
+  BVH::PrimAndBVList<Pnt, AABB> primsAndBVs;
+  for (const auto& pos : positions) {
+    primsAndBVs.emplace_back(std::make_shared<Pnt>(Pnt{pos}), AABB(pos, pos));
+  }
+
+  auto tree = std::make_shared<BVH::TreeBVH<T, Pnt, AABB, K>>(primsAndBVs);
+  tree->topDownSortAndPartition();
+
+  const auto  packed = tree->pack();
+  const auto& prims  = packed->getPrimitives();
+
+  // A coherent 4x4x4 block of cell centres (the case packets are built for), followed by the same
+  // block shuffled and a handful of far-away points, so that packets also mix distant lanes.
+  std::vector<Vec3> queries;
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 4; j++) {
+      for (int k = 0; k < 4; k++) {
+        queries.emplace_back(T(1.125) + T(0.25) * T(i), T(1.125) + T(0.25) * T(j), T(1.125) + T(0.25) * T(k));
+      }
+    }
+  }
+
+  std::vector<Vec3> shuffled = queries;
+  std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937(7));
+  queries.insert(queries.end(), shuffled.begin(), shuffled.end());
+
+  for (const auto& q : queryPoints<T>()) {
+    queries.emplace_back(q);
+  }
+
+  const auto pruneDist2 = [](const T& a_state) noexcept -> T { return a_state; };
+
+  const auto nearest2 = [&prims](T& a_state, const Vec3& a_query, size_t a_offset, size_t a_count) noexcept {
+    for (size_t i = 0; i < a_count; i++) {
+      a_state = std::min(a_state, (prims[a_offset + i]->m_pos - a_query).length2());
+    }
+  };
+
+  for (const size_t packetSize : {size_t(1), size_t(7), size_t(16), size_t(64)}) {
+    for (size_t begin = 0; begin < queries.size(); begin += packetSize) {
+      const size_t count  = std::min(packetSize, queries.size() - begin);
+      const Vec3*  packet = queries.data() + begin;
+
+      std::vector<T> states(count, std::numeric_limits<T>::max());
+
+      packed->packetPruneTraverse(
+        packet,
+        states.data(),
+        count,
+        [&nearest2, packet](T& a_state, size_t a_lane, size_t a_offset, size_t a_count) noexcept {
+          nearest2(a_state, packet[a_lane], a_offset, a_count);
+        },
+        pruneDist2);
+
+      for (size_t lane = 0; lane < count; lane++) {
+        T single = std::numeric_limits<T>::max();
+
+        packed->pruneTraverse(
+          packet[lane],
+          single,
+          [&nearest2, &packet, lane](T& a_state, size_t a_offset, size_t a_count) noexcept {
+            nearest2(a_state, packet[lane], a_offset, a_count);
+          },
+          pruneDist2);
+
+        REQUIRE(states[lane] == single);
+      }
+    }
+  }
+}
+
 // Regression test for the ValueStorage::appendTreeLeaf O(N^2) build bug: a per-leaf
 // reserve(size + leafSize) that defeated std::vector's geometric growth, reallocating the whole
 // primitive buffer on every leaf. Both ValueStorage build paths that append leaves one at a time
@@ -549,78 +851,1511 @@ TEMPLATE_TEST_CASE("BVH refit: TreeBVH::refit and PackedBVH::refit update boundi
     return state;
   };
 
-  // Tight bounding box over the current handle positions -- what a correctly-refitted root equals.
-  const auto tightRoot = [&handles]() noexcept -> AABB {
-    Vec3 lo = +Vec3::max();
-    Vec3 hi = -Vec3::max();
+  // Tight bounding box over the current handle positions -- what a correctly-refitted root equals.
+  const auto tightRoot = [&handles]() noexcept -> AABB {
+    Vec3 lo = +Vec3::max();
+    Vec3 hi = -Vec3::max();
+
+    for (const auto& h : handles) {
+      lo = min(lo, h->m_pos);
+      hi = max(hi, h->m_pos);
+    }
+
+    return AABB(lo, hi);
+  };
+
+  const auto bruteNearest2 = [&handles](const Vec3& a_query) noexcept -> T {
+    T brute2 = std::numeric_limits<T>::max();
+
+    for (const auto& h : handles) {
+      brute2 = std::min(brute2, (h->m_pos - a_query).length2());
+    }
+
+    return brute2;
+  };
+
+  SECTION("refit with unchanged geometry reproduces the original bounding volumes")
+  {
+    const AABB before = packed->getBoundingVolume();
+
+    tree->refit(bvConstructor);
+    packed->refit(bvConstructor);
+
+    for (int d = 0; d < 3; d++) {
+      REQUIRE_THAT(packed->getBoundingVolume().getLowCorner()[d],
+                   withinAbsT(before.getLowCorner()[d], tightMargin<T>()));
+      REQUIRE_THAT(packed->getBoundingVolume().getHighCorner()[d],
+                   withinAbsT(before.getHighCorner()[d], tightMargin<T>()));
+    }
+
+    for (const auto& q : queryPoints<T>()) {
+      REQUIRE_THAT(nearest2(q), withinAbsT(bruteNearest2(q), traversalMargin<T>()));
+    }
+  }
+
+  SECTION("refit after moving the geometry keeps every query correct")
+  {
+    // Displace every point by a per-point, non-uniform translation: primitives shift without
+    // migrating between leaves -- exactly the refit use case.
+    for (size_t i = 0; i < handles.size(); i++) {
+      const T s = T(0.05) * T(i);
+
+      handles[i]->m_pos += Vec3(T(2.0) + s, T(-1.0) - s, T(0.5) * s);
+    }
+
+    tree->refit(bvConstructor);
+    packed->refit(bvConstructor);
+
+    // Both roots must agree with the tight box over the moved cloud.
+    const AABB tight = tightRoot();
+
+    for (int d = 0; d < 3; d++) {
+      REQUIRE_THAT(tree->getBoundingVolume().getLowCorner()[d], withinAbsT(tight.getLowCorner()[d], tightMargin<T>()));
+      REQUIRE_THAT(tree->getBoundingVolume().getHighCorner()[d],
+                   withinAbsT(tight.getHighCorner()[d], tightMargin<T>()));
+      REQUIRE_THAT(packed->getBoundingVolume().getLowCorner()[d],
+                   withinAbsT(tight.getLowCorner()[d], tightMargin<T>()));
+      REQUIRE_THAT(packed->getBoundingVolume().getHighCorner()[d],
+                   withinAbsT(tight.getHighCorner()[d], tightMargin<T>()));
+    }
+
+    for (const auto& q : queryPoints<T>()) {
+      REQUIRE_THAT(nearest2(q), withinAbsT(bruteNearest2(q), traversalMargin<T>()));
+    }
+  }
+}
+
+TEMPLATE_TEST_CASE("PackedBVH::refit: parallel and partial refits give the same tree as a serial full refit",
+                   "[BVH][refit]",
+                   EBGEOMETRY_TEST_PRECISIONS)
+{
+  using T      = TestType;
+  using AABB   = BoundingVolumes::AABBT<T>;
+  using Vec3   = Vec3T<T>;
+  using Pnt    = BareTestPoint<T>;
+  using Packed = BVH::PackedBVH<T, Pnt, 4>;
+
+  std::mt19937                      rng(11u);
+  std::uniform_real_distribution<T> uniform(T(0), T(1));
+
+  std::vector<std::shared_ptr<Pnt>> handles;
+  BVH::PrimAndBVList<Pnt, AABB>     primsAndBVs;
+  for (int i = 0; i < 40000; i++) {
+    handles.emplace_back(std::make_shared<Pnt>(Pnt{Vec3(uniform(rng), uniform(rng), uniform(rng))}));
+    primsAndBVs.emplace_back(handles.back(), AABB(handles.back()->m_pos, handles.back()->m_pos));
+  }
+
+  BVH::TreeBVH<T, Pnt, AABB, 4> tree(std::move(primsAndBVs));
+  tree.topDownSortAndPartition(BVH::BinnedSAHPartitioner<T, Pnt, AABB, 4>);
+
+  const std::shared_ptr<Packed> original = tree.pack();
+
+  REQUIRE(original->computeMetrics().numNodes >= BVH::ParallelRefitThreshold);
+
+  const auto bvConstructor = [](const Pnt& a_p) noexcept -> AABB { return AABB(a_p.m_pos, a_p.m_pos); };
+
+  // Every node box, in traversal order.
+  const auto boxes = [](const Packed& a_bvh) {
+    std::vector<std::pair<Vec3, Vec3>> result;
+
+    a_bvh.template traverse<size_t>(
+      [](const std::shared_ptr<const Pnt>*, size_t, size_t) {},
+      [&result](const typename Packed::NodeView& a_node, const size_t&) {
+        result.emplace_back(a_node.getBoundingVolume().getLowCorner(), a_node.getBoundingVolume().getHighCorner());
+
+        return true;
+      },
+      [](std::array<std::pair<uint32_t, size_t>, 4>&) {},
+      [](const typename Packed::NodeView&) { return size_t(0); });
+
+    return result;
+  };
+
+  // Nearest-neighbor queries through the SoA child boxes, against a brute-force scan.
+  const auto checkQueries = [&handles](const Packed& a_bvh) {
+    for (const auto& q : queryPoints<T>()) {
+      T nearest = std::numeric_limits<T>::max();
+      a_bvh.pruneTraverse(
+        q,
+        nearest,
+        [&prims = a_bvh.getPrimitives(), &q](T& a_state, size_t a_offset, size_t a_count) noexcept {
+          for (size_t i = a_offset; i < a_offset + a_count; i++) {
+            a_state = std::min(a_state, (prims[i]->m_pos - q).length2());
+          }
+        },
+        [](const T& a_state) noexcept -> T { return a_state; });
+
+      T brute = std::numeric_limits<T>::max();
+      for (const auto& h : handles) {
+        brute = std::min(brute, (h->m_pos - q).length2());
+      }
+
+      CHECK(nearest == brute);
+    }
+  };
+
+  const auto withThreads = [](const unsigned a_numThreads, const auto& a_func) {
+    const unsigned numThreads = Parallel::getNumThreads();
+
+    Parallel::setNumThreads(a_numThreads);
+    a_func();
+    Parallel::setNumThreads(numThreads);
+  };
+
+  // Move one percent of the points, by their index in the packed primitive array.
+  const auto& prims = original->getPrimitives();
+
+  std::vector<uint32_t> moved;
+  for (uint32_t i = 0; i < prims.size(); i += 100) {
+    moved.emplace_back(i);
+  }
+  moved.emplace_back(moved.back());
+
+  for (const uint32_t i : moved) {
+    const Pnt* p = prims[i].get();
+
+    const auto handle = std::find_if(handles.begin(), handles.end(), [p](const auto& h) { return h.get() == p; });
+    REQUIRE(handle != handles.end());
+
+    (*handle)->m_pos = Vec3(uniform(rng), uniform(rng), uniform(rng));
+  }
+
+  Packed serial = *original;
+  withThreads(1, [&]() { serial.refit(bvConstructor); });
+
+  SECTION("Parallel full refit")
+  {
+    Packed parallel = *original;
+    withThreads(4, [&]() { parallel.refit(bvConstructor); });
+
+    CHECK(boxes(parallel) == boxes(serial));
+    checkQueries(parallel);
+  }
+
+  SECTION("Partial refit")
+  {
+    Packed partial = *original;
+    withThreads(4, [&]() { partial.refit(moved, bvConstructor); });
+
+    CHECK(boxes(partial) == boxes(serial));
+    checkQueries(partial);
+
+    // Again, with the maps from the first call.
+    partial.refit(moved, bvConstructor);
+    CHECK(boxes(partial) == boxes(serial));
+  }
+
+  SECTION("Partial refit after an insertion rebuilds the maps")
+  {
+    Packed partial = *original;
+    partial.refit(moved, bvConstructor);
+
+    const auto added = std::make_shared<Pnt>(Pnt{Vec3(T(2), T(2), T(2))});
+    partial.insert(added, AABB(added->m_pos, added->m_pos));
+
+    added->m_pos = Vec3(T(3), T(2), T(2));
+    partial.refit({static_cast<uint32_t>(partial.getPrimitives().size() - 1)}, bvConstructor);
+
+    CHECK(partial.getBoundingVolume().getHighCorner() == Vec3(T(3), T(2), T(2)));
+
+    Packed full = partial;
+    full.refit(bvConstructor);
+
+    CHECK(boxes(partial) == boxes(full));
+  }
+}
+
+TEMPLATE_TEST_CASE("PackedBVH::optimize: restructuring lowers the interior surface area, keeps the leaves, and "
+                   "queries still match brute force",
+                   "[BVH][optimize]",
+                   EBGEOMETRY_TEST_PRECISIONS)
+{
+  using T    = TestType;
+  using AABB = BoundingVolumes::AABBT<T>;
+  using Vec3 = Vec3T<T>;
+  using Pnt  = BareTestPoint<T>;
+
+  constexpr size_t K = 4;
+
+  using Node = typename BVH::PackedBVH<T, Pnt, K>::NodeView;
+
+  std::vector<Vec3> positions;
+
+  unsigned int state = 97531u;
+  const auto   next  = [&state]() -> T {
+    state = state * 1103515245u + 12345u;
+    return T((state >> 8) % 10000u) / T(1000);
+  };
+  for (int i = 0; i < 2000; i++) {
+    positions.emplace_back(next(), next(), next());
+  }
+
+  std::vector<std::shared_ptr<Pnt>> handles;
+  BVH::PrimAndBVList<Pnt, AABB>     primsAndBVs;
+  for (const auto& pos : positions) {
+    handles.emplace_back(std::make_shared<Pnt>(Pnt{pos}));
+    primsAndBVs.emplace_back(handles.back(), AABB(pos, pos));
+  }
+
+  // Summed surface area of the interior nodes, and every leaf as (offset, count), from an unpruned traversal.
+  using Leaves = std::vector<std::pair<size_t, size_t>>;
+
+  const auto inspect = [](const BVH::PackedBVH<T, Pnt, K>& a_bvh, T& a_interiorArea, Leaves& a_leaves) {
+    a_interiorArea = T(0);
+    a_leaves.clear();
+
+    a_bvh.template traverse<int>(
+      [&a_leaves](const std::shared_ptr<const Pnt>*, size_t a_offset, size_t a_count) {
+        a_leaves.emplace_back(a_offset, a_count);
+      },
+      [&a_interiorArea](const Node& a_node, const int&) {
+        if (!a_node.isLeaf()) {
+          a_interiorArea += a_node.getBoundingVolume().getArea();
+        }
+        return true;
+      },
+      [](std::array<std::pair<uint32_t, int>, K>&) {},
+      [](const Node&) { return 0; });
+
+    std::sort(a_leaves.begin(), a_leaves.end());
+  };
+
+  const auto checkQueries = [&handles](const BVH::PackedBVH<T, Pnt, K>& a_bvh) {
+    const auto& prims = a_bvh.getPrimitives();
+
+    for (const auto& q : queryPoints<T>()) {
+      T          nearest2 = std::numeric_limits<T>::max();
+      const auto evalLeaf = [&prims, &q](T& a_state, size_t a_offset, size_t a_count) noexcept {
+        for (size_t i = 0; i < a_count; i++) {
+          a_state = std::min(a_state, (prims[a_offset + i]->m_pos - q).length2());
+        }
+      };
+
+      a_bvh.pruneTraverse(q, nearest2, evalLeaf, [](const T& a_state) noexcept -> T { return a_state; });
+
+      T brute2 = std::numeric_limits<T>::max();
+      for (const auto& h : handles) {
+        brute2 = std::min(brute2, (h->m_pos - q).length2());
+      }
+
+      REQUIRE_THAT(nearest2, withinAbsT(brute2, traversalMargin<T>()));
+    }
+  };
+
+  const auto optimizeAndCheck = [&](BVH::PackedBVH<T, Pnt, K>& a_bvh) {
+    T      areaBefore;
+    T      areaAfter;
+    Leaves leavesBefore;
+    Leaves leavesAfter;
+
+    const auto primsBefore = a_bvh.getPrimitives();
+    const AABB rootBefore  = a_bvh.getBoundingVolume();
+
+    inspect(a_bvh, areaBefore, leavesBefore);
+    a_bvh.optimize();
+    inspect(a_bvh, areaAfter, leavesAfter);
+
+    // Only interior nodes move: the primitive array, the leaf ranges and the root box are exactly as before.
+    REQUIRE(a_bvh.getPrimitives() == primsBefore);
+    REQUIRE(leavesAfter == leavesBefore);
+    REQUIRE(a_bvh.getBoundingVolume().getLowCorner() == rootBefore.getLowCorner());
+    REQUIRE(a_bvh.getBoundingVolume().getHighCorner() == rootBefore.getHighCorner());
+    REQUIRE(areaAfter < areaBefore);
+
+    checkQueries(a_bvh);
+
+    // A second call finds nothing left to improve under the same greedy criterion.
+    a_bvh.optimize();
+
+    T areaAgain;
+    inspect(a_bvh, areaAgain, leavesAfter);
+    REQUIRE(areaAgain <= areaAfter);
+  };
+
+  SECTION("Bottom-up Morton tree")
+  {
+    auto tree = std::make_shared<BVH::TreeBVH<T, Pnt, AABB, K>>(primsAndBVs);
+    tree->template bottomUpSortAndPartition<SFC::Morton>();
+
+    optimizeAndCheck(*tree->pack());
+  }
+
+  SECTION("Direct SFC tree, where the last node on each level has fewer than K children")
+  {
+    std::vector<std::pair<Pnt, AABB>> flat;
+    for (const auto& pos : positions) {
+      flat.emplace_back(Pnt{pos}, AABB(pos, pos));
+    }
+
+    BVH::PackedBVH<T, Pnt, K> packed(std::move(flat), size_t(3));
+
+    optimizeAndCheck(packed);
+  }
+
+  SECTION("SAH tree refitted after the geometry was scrambled")
+  {
+    auto tree = std::make_shared<BVH::TreeBVH<T, Pnt, AABB, K>>(primsAndBVs);
+    tree->topDownSortAndPartition(BVH::BinnedSAHPartitioner<T, Pnt, AABB, K>);
+
+    const auto packed = tree->pack();
+
+    // Mirror the cloud in x: leaves keep their primitives but now lie on the wrong side of their ancestors.
+    for (size_t i = 0; i < handles.size(); i += 2) {
+      handles[i]->m_pos[0] = T(10) - handles[i]->m_pos[0];
+    }
+    packed->refit([](const Pnt& a_p) noexcept -> AABB { return AABB(a_p.m_pos, a_p.m_pos); });
+
+    optimizeAndCheck(*packed);
+  }
+
+  SECTION("A tree whose root is a leaf is left alone")
+  {
+    BVH::PrimAndBVList<Pnt, AABB> few(primsAndBVs.begin(), primsAndBVs.begin() + 2);
+
+    auto tree = std::make_shared<BVH::TreeBVH<T, Pnt, AABB, K>>(few);
+    tree->topDownSortAndPartition();
+
+    const auto packed = tree->pack();
+    packed->optimize();
+
+    REQUIRE(packed->getPrimitives().size() == 2);
+  }
+}
+
+TEMPLATE_TEST_CASE("PackedBVH::relayout: every layout keeps parents before children and gives the same queries",
+                   "[BVH][relayout]",
+                   EBGEOMETRY_TEST_PRECISIONS)
+{
+  using T      = TestType;
+  using AABB   = BoundingVolumes::AABBT<T>;
+  using Vec3   = Vec3T<T>;
+  using Pnt    = BareTestPoint<T>;
+  using Packed = BVH::PackedBVH<T, Pnt, 4, BVH::ValueStorage<Pnt>>;
+  using Node   = typename Packed::NodeView;
+
+  std::vector<std::pair<Pnt, AABB>> primsAndBVs;
+
+  unsigned int state = 24680u;
+  const auto   next  = [&state]() -> T {
+    state = state * 1103515245u + 12345u;
+    return T((state >> 8) % 10000u) / T(1000);
+  };
+  for (int i = 0; i < 3000; i++) {
+    const Vec3 pos(next(), next(), next());
+
+    primsAndBVs.emplace_back(Pnt{pos}, AABB(pos, pos));
+  }
+
+  const Packed original(std::move(primsAndBVs), BVH::BinnedSAHPartitioner<T, Pnt, AABB, 4>);
+
+  const auto bytes = [](const Packed& a_bvh) {
+    std::stringstream stream;
+    REQUIRE(a_bvh.save(stream));
+
+    return stream.str();
+  };
+
+  const auto evalLeaf = [](const Packed& a_bvh, const Vec3& a_query) {
+    return [prims = a_bvh.getPrimitiveData(), &a_query](T& a_state, size_t a_offset, size_t a_count) noexcept {
+      for (size_t i = 0; i < a_count; i++) {
+        a_state = std::min(a_state, (prims[a_offset + i].m_pos - a_query).length2());
+      }
+    };
+  };
+
+  const auto pruneDist2 = [](const T& a_state) noexcept -> T { return a_state; };
+
+  const auto nearest2 = [&](const Packed& a_bvh, const Vec3& a_query) {
+    T nearest = std::numeric_limits<T>::max();
+    a_bvh.pruneTraverse(a_query, nearest, evalLeaf(a_bvh, a_query), pruneDist2);
+
+    return nearest;
+  };
+
+  // Depth of every node and every (parent, child) edge, by node index. The callbacks only see node views, so the
+  // key of each node is a serial number, and the child orderer (which sees the child indices) records which node
+  // each serial number belongs to. The root is node 0 and gets serial number 0.
+  struct Shape
+  {
+    std::vector<size_t>                    depth;
+    std::vector<std::pair<size_t, size_t>> edges;
+  };
+
+  const auto shape = [](const Packed& a_bvh) {
+    Shape               result;
+    std::vector<size_t> nodeOfSerial{0};
+    size_t              numSerials = 0;
+    size_t              current    = 0;
+    const size_t        n          = a_bvh.computeMetrics().numNodes;
+
+    result.depth.assign(n, 0);
+
+    a_bvh.template traverse<size_t>(
+      [](const Pnt*, size_t, size_t) {},
+      [&current, &nodeOfSerial](const Node&, const size_t& a_serial) {
+        current = nodeOfSerial[a_serial];
+
+        return true;
+      },
+      [&](std::array<std::pair<uint32_t, size_t>, 4>& a_children) {
+        for (const auto& child : a_children) {
+          if (child.first != BVH::EmptyChild) {
+            nodeOfSerial.resize(std::max(nodeOfSerial.size(), child.second + 1));
+            nodeOfSerial[child.second] = child.first;
+
+            result.edges.emplace_back(current, child.first);
+            result.depth[child.first] = result.depth[current] + 1;
+          }
+        }
+      },
+      [&numSerials](const Node&) { return numSerials++; });
+
+    return result;
+  };
+
+  const Shape            before  = shape(original);
+  const BVH::TreeMetrics metrics = original.computeMetrics();
+
+  REQUIRE(before.edges.size() + 1 == metrics.numNodes);
+
+  const auto checkLayout = [&](const Packed& a_bvh) {
+    const Shape after = shape(a_bvh);
+
+    REQUIRE(after.edges.size() == before.edges.size());
+    for (const auto& [parent, child] : after.edges) {
+      CHECK(parent < child);
+    }
+
+    // Same tree: the metrics and every query agree.
+    const BVH::TreeMetrics relaid = a_bvh.computeMetrics();
+
+    CHECK(relaid.numNodes == metrics.numNodes);
+    CHECK(relaid.leafFill == metrics.leafFill);
+    CHECK(relaid.maxLeafDepth == metrics.maxLeafDepth);
+    CHECK_THAT(relaid.sahCost, Catch::Matchers::WithinRel(metrics.sahCost, 1.E-9));
+    CHECK_THAT(relaid.epo, Catch::Matchers::WithinRel(metrics.epo, 1.E-9));
+
+    for (const auto& q : queryPoints<T>()) {
+      CHECK(nearest2(a_bvh, q) == nearest2(original, q));
+    }
+
+    // The layout survives a round trip through a file, which checks the ordering contract again.
+    std::stringstream stream(bytes(a_bvh));
+
+    const auto loaded = Packed::load(stream);
+    REQUIRE(loaded != nullptr);
+    CHECK(bytes(*loaded) == bytes(a_bvh));
+
+    return after;
+  };
+
+  SECTION("Breadth-first")
+  {
+    Packed bvh = original;
+    bvh.relayout(BVH::Layout::BreadthFirst);
+
+    const Shape after = checkLayout(bvh);
+
+    for (size_t i = 1; i < after.depth.size(); i++) {
+      CHECK(after.depth[i - 1] <= after.depth[i]);
+    }
+  }
+
+  SECTION("Van Emde Boas")
+  {
+    Packed bvh = original;
+    bvh.relayout(BVH::Layout::VanEmdeBoas);
+
+    const Shape after = checkLayout(bvh);
+
+    // The first block holds the upper half of the levels.
+    const size_t top = (metrics.maxLeafDepth + 1) / 2;
+
+    const size_t numTop = size_t(std::count_if(after.depth.begin(), after.depth.end(), [top](size_t d) {
+      return d < top;
+    }));
+
+    REQUIRE(numTop > 1);
+    for (size_t i = 0; i < after.depth.size(); i++) {
+      CHECK((after.depth[i] < top) == (i < numTop));
+    }
+  }
+
+  SECTION("Visit frequency")
+  {
+    Packed bvh = original;
+
+    const auto record = [&](const Packed& a_bvh) {
+      std::vector<uint64_t> visits;
+      for (const auto& q : queryPoints<T>()) {
+        T nearest = std::numeric_limits<T>::max();
+        a_bvh.recordVisits(visits, q, nearest, evalLeaf(a_bvh, q), pruneDist2);
+
+        CHECK(nearest == nearest2(a_bvh, q));
+      }
+
+      return visits;
+    };
+
+    const std::vector<uint64_t> visits = record(bvh);
+
+    REQUIRE(visits.size() == metrics.numNodes);
+    CHECK(visits[0] == queryPoints<T>().size());
+    CHECK(std::count(visits.begin(), visits.end(), 0U) > 0);
+
+    bvh.relayout(visits);
+    checkLayout(bvh);
+
+    // The most visited nodes come first.
+    const std::vector<uint64_t> again = record(bvh);
+
+    CHECK(std::is_sorted(again.rbegin(), again.rend()));
+    CHECK(std::accumulate(again.begin(), again.end(), uint64_t(0)) ==
+          std::accumulate(visits.begin(), visits.end(), uint64_t(0)));
+  }
+
+  SECTION("Depth-first restores the built tree, and refit works in any layout")
+  {
+    Packed bvh = original;
+    bvh.relayout(BVH::Layout::VanEmdeBoas);
+    bvh.relayout(BVH::Layout::DepthFirst);
+
+    CHECK(bytes(bvh) == bytes(original));
+
+    const auto inflate = [](const Pnt& a_prim) {
+      return AABB(a_prim.m_pos - Vec3::ones(), a_prim.m_pos + Vec3::ones());
+    };
+
+    Packed refitted = original;
+    refitted.refit(inflate);
+
+    bvh.relayout(BVH::Layout::BreadthFirst);
+    bvh.refit(inflate);
+    bvh.relayout(BVH::Layout::DepthFirst);
+
+    CHECK(bytes(bvh) == bytes(refitted));
+  }
+}
+
+TEMPLATE_TEST_CASE("PackedBVH::insert/remove: a dynamically updated tree answers queries like a brute-force scan",
+                   "[BVH][dynamic]",
+                   EBGEOMETRY_TEST_PRECISIONS)
+{
+  using T      = TestType;
+  using AABB   = BoundingVolumes::AABBT<T>;
+  using Vec3   = Vec3T<T>;
+  using Pnt    = BareTestPoint<T>;
+  using Packed = BVH::PackedBVH<T, Pnt, 4, BVH::ValueStorage<Pnt>>;
+  using Node   = typename Packed::NodeView;
+
+  unsigned int state = 13579u;
+  const auto   next  = [&state]() -> T {
+    state = state * 1103515245u + 12345u;
+    return T((state >> 8) % 10000u) / T(1000);
+  };
+
+  std::vector<Vec3>                 live;
+  std::vector<std::pair<Pnt, AABB>> primsAndBVs;
+  for (int i = 0; i < 400; i++) {
+    const Vec3 pos(next(), next(), next());
+
+    live.emplace_back(pos);
+    primsAndBVs.emplace_back(Pnt{pos}, AABB(pos, pos));
+  }
+
+  Packed bvh(std::move(primsAndBVs), BVH::BinnedSAHPartitioner<T, Pnt, AABB, 4>);
+
+  const auto bytes = [](const Packed& a_bvh) {
+    std::stringstream stream;
+    REQUIRE(a_bvh.save(stream));
+
+    return stream.str();
+  };
+
+  const auto nearest2 = [](const Packed& a_bvh, const Vec3& a_query) {
+    T nearest = std::numeric_limits<T>::max();
+    a_bvh.pruneTraverse(
+      a_query,
+      nearest,
+      [prims = a_bvh.getPrimitiveData(), &a_query](T& a_state, size_t a_offset, size_t a_count) noexcept {
+        for (size_t i = 0; i < a_count; i++) {
+          a_state = std::min(a_state, (prims[a_offset + i].m_pos - a_query).length2());
+        }
+      },
+      [](const T& a_state) noexcept -> T { return a_state; });
+
+    return nearest;
+  };
+
+  const auto bruteForce2 = [&live](const Vec3& a_query) {
+    T nearest = std::numeric_limits<T>::max();
+    for (const Vec3& pos : live) {
+      nearest = std::min(nearest, (pos - a_query).length2());
+    }
+
+    return nearest;
+  };
+
+  // Every reachable leaf holds live primitives only, every interior node has at least two children and comes before
+  // them, and the queries agree with a scan over the live points.
+  const auto check = [&](const Packed& a_bvh) {
+    // Node keys are serial numbers, mapped to node indices by the child orderer as in the relayout test.
+    std::vector<size_t> nodeOfSerial{0};
+    size_t              numSerials = 0;
+    size_t              current    = 0;
+    std::vector<size_t> leafPrims;
+
+    a_bvh.template traverse<size_t>(
+      [&leafPrims](const Pnt*, size_t a_offset, size_t a_count) {
+        for (size_t i = a_offset; i < a_offset + a_count; i++) {
+          leafPrims.emplace_back(i);
+        }
+      },
+      [&current, &nodeOfSerial](const Node& a_node, const size_t& a_serial) {
+        current = nodeOfSerial[a_serial];
+
+        CHECK((a_node.isLeaf() || a_node.getNumChildren() >= 2));
+
+        return true;
+      },
+      [&current, &nodeOfSerial](std::array<std::pair<uint32_t, size_t>, 4>& a_children) {
+        for (const auto& child : a_children) {
+          if (child.first != BVH::EmptyChild) {
+            nodeOfSerial.resize(std::max(nodeOfSerial.size(), child.second + 1));
+            nodeOfSerial[child.second] = child.first;
+
+            CHECK(current < child.first);
+          }
+        }
+      },
+      [&numSerials](const Node&) { return numSerials++; });
+
+    std::sort(leafPrims.begin(), leafPrims.end());
+    CHECK(std::adjacent_find(leafPrims.begin(), leafPrims.end()) == leafPrims.end());
+    CHECK(leafPrims.size() == live.size());
+    CHECK(a_bvh.computeMetrics().numPrimitives == live.size());
+
+    for (const auto& q : queryPoints<T>()) {
+      CHECK(nearest2(a_bvh, q) == bruteForce2(q));
+    }
+    for (const Vec3& pos : live) {
+      CHECK(nearest2(a_bvh, pos) == T(0));
+    }
+  };
+
+  const auto insertPoint = [&](Packed& a_bvh, const Vec3& a_pos) {
+    a_bvh.insert(Pnt{a_pos}, AABB(a_pos, a_pos));
+    live.emplace_back(a_pos);
+  };
+
+  const auto removePoint = [&](Packed& a_bvh, const size_t a_index) {
+    const Vec3 pos = live[a_index];
+
+    live.erase(live.begin() + std::ptrdiff_t(a_index));
+
+    return a_bvh.remove(AABB(pos, pos), [&pos](const Pnt& a_prim) noexcept { return a_prim.m_pos == pos; });
+  };
+
+  SECTION("Interleaved inserts and removes, with automatic compaction")
+  {
+    for (int round = 0; round < 10; round++) {
+      for (int i = 0; i < 60; i++) {
+        insertPoint(bvh, Vec3(next(), next(), next()));
+      }
+      for (int i = 0; i < 90; i++) {
+        CHECK(removePoint(bvh, size_t(next() * T(1000)) % live.size()));
+      }
+
+      check(bvh);
+    }
+
+    REQUIRE(live.size() == 100);
+  }
+
+  SECTION("Inserting a sorted sequence keeps the tree shallow")
+  {
+    for (int i = 0; i < 2000; i++) {
+      insertPoint(bvh, Vec3(T(20) + T(i) / T(100), T(0), T(0)));
+    }
+
+    check(bvh);
+
+    // Four children per node, so a balanced tree over the leaves has depth ceil(log4(numLeaves)).
+    const BVH::TreeMetrics metrics  = bvh.computeMetrics();
+    const size_t           balanced = size_t(std::ceil(std::log(double(metrics.numLeaves)) / std::log(4.0)));
+
+    CHECK(metrics.maxLeafDepth <= 2 * balanced + 2);
+  }
+
+  SECTION("compact() drops the garbage without changing the saved tree")
+  {
+    for (int i = 0; i < 100; i++) {
+      CHECK(removePoint(bvh, size_t(next() * T(1000)) % live.size()));
+    }
+    for (int i = 0; i < 20; i++) {
+      insertPoint(bvh, Vec3(next(), next(), next()));
+    }
+
+    REQUIRE(bvh.getNumPrimitives() > live.size());
+
+    const std::string saved = bytes(bvh);
+
+    std::stringstream stream(saved);
+    const auto        loaded = Packed::load(stream);
+    REQUIRE(loaded != nullptr);
+    check(*loaded);
+
+    bvh.compact();
+
+    CHECK(bvh.getNumPrimitives() == live.size());
+    CHECK(bytes(bvh) == saved);
+    check(bvh);
+  }
+
+  SECTION("refit() and optimize() work after removals")
+  {
+    for (int i = 0; i < 50; i++) {
+      CHECK(removePoint(bvh, size_t(next() * T(1000)) % live.size()));
+    }
+
+    bvh.refit([](const Pnt& a_prim) { return AABB(a_prim.m_pos - Vec3::ones(), a_prim.m_pos + Vec3::ones()); });
+    check(bvh);
+
+    bvh.optimize();
+    check(bvh);
+  }
+
+  SECTION("Removing a primitive that is not in the tree, or the last one, fails")
+  {
+    const Vec3 absent(T(-1), T(-1), T(-1));
+
+    CHECK_FALSE(bvh.remove(AABB(absent, absent), [](const Pnt&) noexcept { return true; }));
+    CHECK_FALSE(bvh.remove(AABB(live[0], live[0]), [](const Pnt&) noexcept { return false; }));
+
+    std::vector<std::pair<Pnt, AABB>> single{{Pnt{absent}, AABB(absent, absent)}};
+
+    Packed lonely(std::move(single), BVH::BinnedSAHPartitioner<T, Pnt, AABB, 4>);
+
+    CHECK_FALSE(lonely.remove(AABB(absent, absent), [](const Pnt&) noexcept { return true; }));
+
+    lonely.insert(Pnt{Vec3::ones()}, AABB(Vec3::ones(), Vec3::ones()));
+    CHECK(lonely.remove(AABB(absent, absent), [&absent](const Pnt& a_prim) noexcept {
+      return a_prim.m_pos == absent;
+    }));
+    CHECK(nearest2(lonely, Vec3::zeros()) == T(3));
+  }
+}
+
+TEMPLATE_TEST_CASE("PackedBVH::computeMetrics: node counts, leaf depths and fill, padding, SAH cost and EPO",
+                   "[BVH][metrics]",
+                   EBGEOMETRY_TEST_PRECISIONS)
+{
+  using T    = TestType;
+  using AABB = BoundingVolumes::AABBT<T>;
+  using Vec3 = Vec3T<T>;
+  using Pnt  = BareTestPoint<T>;
+
+  constexpr size_t K = 4;
+
+  using Node = typename BVH::PackedBVH<T, Pnt, K>::NodeView;
+
+  // SAH cost from an unpruned traversal, as an independent check of computeMetrics().
+  const auto sahCost = [](const BVH::PackedBVH<T, Pnt, K>& a_bvh) -> double {
+    double weightedArea = 0.0;
+
+    a_bvh.template traverse<int>(
+      [](const std::shared_ptr<const Pnt>*, size_t, size_t) {},
+      [&weightedArea](const Node& a_node, const int&) {
+        const double cost = a_node.isLeaf() ? double(a_node.getNumPrimitives()) : 1.0;
+
+        weightedArea += cost * double(a_node.getBoundingVolume().getArea());
+
+        return true;
+      },
+      [](std::array<std::pair<uint32_t, int>, K>&) {},
+      [](const Node&) { return 0; });
+
+    return weightedArea / double(a_bvh.getBoundingVolume().getArea());
+  };
+
+  SECTION("SFC build: no padded leaves, and the last node on a level has fewer children")
+  {
+    // 20 points in leaves of 4 give 5 leaves. The first four share an interior node under the root, and the fifth,
+    // which would be the only child of the second one, hangs from the root itself.
+    std::vector<std::pair<Pnt, AABB>> primsAndBVs;
+    for (int i = 0; i < 20; i++) {
+      const Vec3 pos(T(i % 3), T((7 * i) % 5), T((3 * i) % 7));
+
+      primsAndBVs.emplace_back(Pnt{pos}, AABB(pos, pos));
+    }
+
+    const BVH::PackedBVH<T, Pnt, K> packed(std::move(primsAndBVs), size_t(4));
+    const BVH::TreeMetrics          metrics = packed.computeMetrics();
+
+    CHECK(metrics.numNodes == 7);
+    CHECK(metrics.numInteriorNodes == 2);
+    CHECK(metrics.numLeaves == 5);
+    CHECK(metrics.numPaddedLeaves == 0);
+    CHECK(metrics.numPrimitives == 20);
+    CHECK(metrics.minLeafDepth == 1);
+    CHECK(metrics.maxLeafDepth == 2);
+    CHECK_THAT(metrics.meanLeafDepth, Catch::Matchers::WithinRel(1.8, 1.E-12));
+    REQUIRE(metrics.leafFill.size() == 5);
+    CHECK(metrics.leafFill[4] == 5);
+    CHECK_THAT(metrics.sahCost, Catch::Matchers::WithinRel(sahCost(packed), 1.E-9));
+    CHECK(metrics.epo >= 0.0);
+    CHECK(metrics.epo <= 1.0);
+
+    // The children of every interior node.
+    std::vector<size_t> numChildren;
+
+    packed.template traverse<int>(
+      [](const std::shared_ptr<const Pnt>*, size_t, size_t) {},
+      [&numChildren](const Node& a_node, const int&) {
+        if (!a_node.isLeaf()) {
+          numChildren.emplace_back(a_node.getNumChildren());
+        }
+
+        return true;
+      },
+      [](std::array<std::pair<uint32_t, int>, K>&) {},
+      [](const Node&) { return 0; });
+
+    REQUIRE(numChildren.size() == metrics.numInteriorNodes);
+
+    std::sort(numChildren.begin(), numChildren.end());
+    CHECK(numChildren == std::vector<size_t>{2, 4});
+  }
+
+  SECTION("SFC build: no interior node has fewer than two children")
+  {
+    // With one point per leaf, 17 leaves give a lone child on two consecutive levels (17 = 4 * 4 + 1 and
+    // 5 = 4 + 1), and 65 leaves on three.
+    for (int n = 2; n <= 70; n++) {
+      INFO("Number of points: " << n);
+
+      std::vector<std::pair<Pnt, AABB>> primsAndBVs;
+      for (int i = 0; i < n; i++) {
+        const Vec3 pos(T(i % 3), T((7 * i) % 5), T(i));
+
+        primsAndBVs.emplace_back(Pnt{pos}, AABB(pos, pos));
+      }
+
+      const BVH::PackedBVH<T, Pnt, K> packed(std::move(primsAndBVs), size_t(1));
+      const BVH::TreeMetrics          metrics = packed.computeMetrics();
+
+      size_t numInterior = 0;
+      size_t numLeaves   = 0;
+
+      packed.template traverse<int>(
+        [](const std::shared_ptr<const Pnt>*, size_t, size_t) {},
+        [&](const Node& a_node, const int&) {
+          if (a_node.isLeaf()) {
+            numLeaves++;
+          }
+          else {
+            CHECK(a_node.getNumChildren() >= 2);
+
+            numInterior++;
+          }
+
+          return true;
+        },
+        [](std::array<std::pair<uint32_t, int>, K>&) {},
+        [](const Node&) { return 0; });
+
+      CHECK(numLeaves == size_t(n));
+      CHECK(numInterior == metrics.numInteriorNodes);
+      CHECK(metrics.numNodes == numLeaves + numInterior);
+      CHECK_THAT(metrics.sahCost, Catch::Matchers::WithinRel(sahCost(packed), 1.E-9));
+    }
+  }
+
+  SECTION("Disjoint leaves have zero EPO, and scrambling the geometry raises it")
+  {
+    // Small cubes strung out along x, so every split of the top-down build is on x and no two leaves overlap. The
+    // primitives need a volume: overlap between point leaves has no area.
+    const auto box = [](const Pnt& a_p) noexcept -> AABB {
+      return AABB(a_p.m_pos - T(0.25) * Vec3::ones(), a_p.m_pos + T(0.25) * Vec3::ones());
+    };
+
+    std::vector<std::shared_ptr<Pnt>> handles;
+    BVH::PrimAndBVList<Pnt, AABB>     primsAndBVs;
+    for (int i = 0; i < 256; i++) {
+      const Vec3 pos(T(i), T(0.1) * T((7 * i) % 5), T(0.1) * T((3 * i) % 7));
+
+      handles.emplace_back(std::make_shared<Pnt>(Pnt{pos}));
+      primsAndBVs.emplace_back(handles.back(), box(*handles.back()));
+    }
+
+    auto tree = std::make_shared<BVH::TreeBVH<T, Pnt, AABB, K>>(primsAndBVs);
+    tree->topDownSortAndPartition();
+
+    const auto packed = tree->pack();
+
+    const BVH::TreeMetrics before = packed->computeMetrics();
+
+    size_t numLeafPrims = 0;
+    for (size_t n = 0; n < before.leafFill.size(); n++) {
+      numLeafPrims += n * before.leafFill[n];
+    }
+
+    CHECK(before.numPaddedLeaves == 0);
+    CHECK(numLeafPrims == before.numPrimitives);
+    CHECK(before.numNodes == before.numLeaves + before.numInteriorNodes);
+    CHECK(before.epo == 0.0);
+    CHECK_THAT(before.sahCost, Catch::Matchers::WithinRel(sahCost(*packed), 1.E-9));
+
+    for (size_t i = 0; i < handles.size(); i += 2) {
+      handles[i]->m_pos[0] = T(255) - handles[i]->m_pos[0];
+    }
+    packed->refit(box);
+
+    const BVH::TreeMetrics after = packed->computeMetrics();
+
+    CHECK(after.epo > 0.0);
+    CHECK(after.epo <= 1.0);
+    CHECK(after.sahCost > before.sahCost);
+  }
+
+  SECTION("MeshSDF and TriMeshSDF report the metrics of their BVH")
+  {
+    const auto mesh = Parser::readIntoDCEL<T, Meta>(dataPath("dodecahedron.stl"));
+    REQUIRE(mesh != nullptr);
+
+    const MeshSDF<T, Meta, K>       meshSDF(mesh, BVH::Build::SAH);
+    const TriMeshSDF<T, Meta, K, 4> triMeshSDF(mesh, BVH::Build::SAH, 2);
+
+    for (const BVH::TreeMetrics& metrics : {meshSDF.computeMetrics(), triMeshSDF.computeMetrics()}) {
+      size_t numLeafPrims = 0;
+      for (size_t n = 0; n < metrics.leafFill.size(); n++) {
+        numLeafPrims += n * metrics.leafFill[n];
+      }
+
+      CHECK(numLeafPrims == metrics.numPrimitives);
+      CHECK(metrics.sahCost >= 1.0);
+      CHECK(metrics.epo >= 0.0);
+      CHECK(metrics.epo <= 1.0);
+    }
+
+    CHECK(meshSDF.computeMetrics().numPrimitives == mesh->getFaces().size());
+  }
+}
+
+TEMPLATE_TEST_CASE("BVH::getTraversalStatistics: traversals count their nodes, leaves and primitives when "
+                   "EBGEOMETRY_ENABLE_TRAVERSAL_STATISTICS is defined, and nothing otherwise",
+                   "[BVH][metrics]",
+                   EBGEOMETRY_TEST_PRECISIONS)
+{
+  using T    = TestType;
+  using AABB = BoundingVolumes::AABBT<T>;
+  using Vec3 = Vec3T<T>;
+  using Pnt  = BareTestPoint<T>;
+
+  constexpr size_t K = 4;
+
+  using Node = typename BVH::PackedBVH<T, Pnt, K>::NodeView;
+
+  BVH::PrimAndBVList<Pnt, AABB> primsAndBVs;
+  for (int i = 0; i < 5; i++) {
+    for (int j = 0; j < 5; j++) {
+      for (int k = 0; k < 5; k++) {
+        const Vec3 pos(T(i) + T(0.3) * T(j), T(j) - T(0.2) * T(k), T(k) + T(0.1) * T(i));
+
+        primsAndBVs.emplace_back(std::make_shared<Pnt>(Pnt{pos}), AABB(pos, pos));
+      }
+    }
+  }
+
+  auto tree = std::make_shared<BVH::TreeBVH<T, Pnt, AABB, K>>(primsAndBVs);
+  tree->topDownSortAndPartition();
+
+  const auto  packed = tree->pack();
+  const auto& prims  = packed->getPrimitives();
+
+  const auto pruneDist2 = [](const T& a_state) noexcept -> T { return a_state; };
+
+  // Our own tally of what the traversals hand to the leaf evaluator.
+  uint64_t numLeaves     = 0;
+  uint64_t numPrimitives = 0;
+
+  const auto nearest2 = [&](T& a_state, const Vec3& a_query, size_t a_offset, size_t a_count) noexcept {
+    numLeaves++;
+    numPrimitives += a_count;
+
+    for (size_t i = 0; i < a_count; i++) {
+      a_state = std::min(a_state, (prims[a_offset + i]->m_pos - a_query).length2());
+    }
+  };
+
+  const auto check = [&](uint64_t a_numTraversals) {
+    const BVH::TraversalStatistics stats = BVH::getTraversalStatistics();
+
+#if defined(EBGEOMETRY_ENABLE_TRAVERSAL_STATISTICS)
+    CHECK(stats.numTraversals == a_numTraversals);
+    CHECK(stats.numLeavesVisited == numLeaves);
+    CHECK(stats.numPrimitivesTested == numPrimitives);
+    CHECK(stats.numNodesVisited > 0);
+    CHECK(stats.numLeavesVisited > 0);
+#else
+    (void)a_numTraversals;
+
+    CHECK(stats.numTraversals == 0);
+    CHECK(stats.numNodesVisited == 0);
+    CHECK(stats.numLeavesVisited == 0);
+    CHECK(stats.numPrimitivesTested == 0);
+#endif
+  };
+
+  BVH::resetTraversalStatistics();
+
+  SECTION("pruneTraverse")
+  {
+    for (const auto& q : queryPoints<T>()) {
+      T state = std::numeric_limits<T>::max();
+
+      packed->pruneTraverse(
+        q,
+        state,
+        [&nearest2, &q](T& a_state, size_t a_offset, size_t a_count) noexcept {
+          nearest2(a_state, q, a_offset, a_count);
+        },
+        pruneDist2);
+    }
+
+    check(queryPoints<T>().size());
+
+#if defined(EBGEOMETRY_ENABLE_TRAVERSAL_STATISTICS)
+    CHECK(BVH::getTraversalStatistics().numNodesVisited >= numLeaves);
+#endif
+  }
+
+  SECTION("packetPruneTraverse counts one traversal per packet and one leaf evaluation per lane")
+  {
+    const std::vector<Vec3> queries = queryPoints<T>();
+
+    std::vector<T> states(queries.size(), std::numeric_limits<T>::max());
+
+    packed->packetPruneTraverse(
+      queries.data(),
+      states.data(),
+      queries.size(),
+      [&nearest2, &queries](T& a_state, size_t a_lane, size_t a_offset, size_t a_count) noexcept {
+        nearest2(a_state, queries[a_lane], a_offset, a_count);
+      },
+      pruneDist2);
+
+    check(1);
+  }
+
+  SECTION("traverse")
+  {
+    packed->template traverse<int>(
+      [&](const std::shared_ptr<const Pnt>*, size_t, size_t a_count) {
+        numLeaves++;
+        numPrimitives += a_count;
+      },
+      [](const Node&, const int&) { return true; },
+      [](std::array<std::pair<uint32_t, int>, K>&) {},
+      [](const Node&) { return 0; });
+
+    check(1);
+
+#if defined(EBGEOMETRY_ENABLE_TRAVERSAL_STATISTICS)
+    CHECK(BVH::getTraversalStatistics().numPrimitivesTested == prims.size());
+    CHECK(BVH::getTraversalStatistics().numNodesVisited == packed->computeMetrics().numNodes);
+#endif
+  }
+
+  SECTION("resetTraversalStatistics clears the counters")
+  {
+    const Vec3 q(0, 0, 0);
+
+    T state = std::numeric_limits<T>::max();
+
+    packed->pruneTraverse(
+      q,
+      state,
+      [&nearest2, &q](T& a_state, size_t a_offset, size_t a_count) noexcept {
+        nearest2(a_state, q, a_offset, a_count);
+      },
+      pruneDist2);
+
+    BVH::resetTraversalStatistics();
+
+    const BVH::TraversalStatistics stats = BVH::getTraversalStatistics();
+
+    CHECK(stats.numTraversals == 0);
+    CHECK(stats.numNodesVisited == 0);
+    CHECK(stats.numLeavesVisited == 0);
+    CHECK(stats.numPrimitivesTested == 0);
+  }
+}
+
+TEMPLATE_TEST_CASE("PackedBVH::save/load: a round trip reproduces the tree exactly, and incompatible or corrupt "
+                   "streams are rejected",
+                   "[BVH][serialization]",
+                   EBGEOMETRY_TEST_PRECISIONS)
+{
+  using T      = TestType;
+  using AABB   = BoundingVolumes::AABBT<T>;
+  using Vec3   = Vec3T<T>;
+  using Pnt    = BareTestPoint<T>;
+  using Packed = BVH::PackedBVH<T, Pnt, 4, BVH::ValueStorage<Pnt>>;
+
+  std::vector<std::pair<Pnt, AABB>> primsAndBVs;
+  for (int i = 0; i < 5; i++) {
+    for (int j = 0; j < 5; j++) {
+      for (int k = 0; k < 5; k++) {
+        const Vec3 pos(T(i) + T(0.3) * T(j), T(j) - T(0.2) * T(k), T(k) + T(0.1) * T(i));
+
+        primsAndBVs.emplace_back(Pnt{pos}, AABB(pos, pos));
+      }
+    }
+  }
+
+  const Packed packed(std::move(primsAndBVs), BVH::BinnedSAHPartitioner<T, Pnt, AABB, 4>);
+
+  std::stringstream stream;
+  REQUIRE(packed.save(stream));
+
+  const std::string bytes = stream.str();
+
+  SECTION("Round trip")
+  {
+    const auto loaded = Packed::load(stream);
+    REQUIRE(loaded != nullptr);
+
+    // Same primitives in the same order, and the same tree: the metrics cover every node and leaf.
+    REQUIRE(loaded->getPrimitives().size() == packed.getPrimitives().size());
+    for (size_t i = 0; i < packed.getPrimitives().size(); i++) {
+      REQUIRE(loaded->getPrimitives()[i].m_pos == packed.getPrimitives()[i].m_pos);
+    }
+
+    const BVH::TreeMetrics before = packed.computeMetrics();
+    const BVH::TreeMetrics after  = loaded->computeMetrics();
+
+    CHECK(after.numNodes == before.numNodes);
+    CHECK(after.leafFill == before.leafFill);
+    CHECK(after.sahCost == before.sahCost);
+
+    // The SoA child boxes were read, not rebuilt, and the SIMD traversal finds the same nearest neighbors.
+    const auto pruneDist2 = [](const T& a_state) noexcept -> T { return a_state; };
+    const auto nearest2   = [](const Packed& a_bvh, const Vec3& a_query, const auto& a_pruneDist2) {
+      const auto& prims = a_bvh.getPrimitives();
+
+      T state = std::numeric_limits<T>::max();
+
+      a_bvh.pruneTraverse(
+        a_query,
+        state,
+        [&prims, &a_query](T& a_state, size_t a_offset, size_t a_count) noexcept {
+          for (size_t i = 0; i < a_count; i++) {
+            a_state = std::min(a_state, (prims[a_offset + i].m_pos - a_query).length2());
+          }
+        },
+        a_pruneDist2);
+
+      return state;
+    };
+
+    for (const auto& q : queryPoints<T>()) {
+      CHECK(nearest2(*loaded, q, pruneDist2) == nearest2(packed, q, pruneDist2));
+    }
+
+    // Writing the loaded tree gives the same bytes.
+    std::stringstream again;
+    REQUIRE(loaded->save(again));
+    CHECK(again.str() == bytes);
+  }
+
+  SECTION("Sections are aligned, only interior nodes have SoA child boxes, and only leaves have leaf records")
+  {
+    BVH::Detail::SerializationHeader header;
+    std::memcpy(&header, bytes.data(), sizeof(header));
+
+    CHECK(header.version == BVH::SerializationVersion);
+    CHECK(header.nodesOffset % BVH::Detail::SerializationAlignment == 0);
+    CHECK(header.soaOffset % BVH::Detail::SerializationAlignment == 0);
+    CHECK(header.leavesOffset % BVH::Detail::SerializationAlignment == 0);
+    CHECK(header.primitivesOffset % BVH::Detail::SerializationAlignment == 0);
+    CHECK(header.size == bytes.size());
+
+    const BVH::TreeMetrics metrics = packed.computeMetrics();
+
+    CHECK(header.numNodes == metrics.numNodes);
+    CHECK(header.numInteriorNodes == metrics.numInteriorNodes);
+    CHECK(header.numLeaves == metrics.numLeaves);
+    CHECK(header.leavesOffset - header.soaOffset <
+          header.numInteriorNodes * header.soaSize + BVH::Detail::SerializationAlignment);
+    CHECK(header.primitivesOffset - header.leavesOffset <
+          header.numLeaves * header.leafSize + BVH::Detail::SerializationAlignment);
+  }
+
+  SECTION("Rejected streams")
+  {
+    const auto loadBytes = [](const std::string& a_bytes) {
+      std::stringstream in(a_bytes);
+
+      return Packed::load(in);
+    };
+
+    const auto patched = [&bytes](size_t a_offset, uint32_t a_value) {
+      std::string copy = bytes;
+      std::memcpy(&copy[a_offset], &a_value, sizeof(a_value));
+
+      return copy;
+    };
+
+    BVH::Detail::SerializationHeader header;
+    std::memcpy(&header, bytes.data(), sizeof(header));
+
+    CHECK(loadBytes(std::string()) == nullptr);
+    CHECK(loadBytes(std::string(bytes.size(), 'x')) == nullptr);
+    CHECK(loadBytes(bytes.substr(0, bytes.size() - 1)) == nullptr);
+    CHECK(loadBytes(patched(offsetof(BVH::Detail::SerializationHeader, endianTag), 0x04030201U)) == nullptr);
+    CHECK(loadBytes(patched(offsetof(BVH::Detail::SerializationHeader, version), BVH::SerializationVersion + 1)) ==
+          nullptr);
+
+    // An interior root without a first child, and one with an unused slot before a used one.
+    using Record = BVH::Detail::SerializedNode<4>;
+
+    CHECK(loadBytes(patched(size_t(header.nodesOffset) + offsetof(Record, childOff), BVH::EmptyChild)) == nullptr);
+    CHECK(loadBytes(patched(size_t(header.nodesOffset) + offsetof(Record, childOff) + sizeof(uint32_t),
+                            BVH::EmptyChild)) == nullptr);
+
+    // A root whose SoA child-box record does not exist.
+    CHECK(loadBytes(patched(size_t(header.nodesOffset) + offsetof(Record, ref),
+                            static_cast<uint32_t>(header.numInteriorNodes))) == nullptr);
+
+    // A leaf record that is empty, and one whose primitives run past the end of the primitive array.
+    using Leaf = BVH::Detail::SerializedLeaf;
+
+    CHECK(loadBytes(patched(size_t(header.leavesOffset) + offsetof(Leaf, numPrims), 0U)) == nullptr);
+    CHECK(loadBytes(patched(size_t(header.leavesOffset) + offsetof(Leaf, primOff),
+                            static_cast<uint32_t>(header.numPrimitives))) == nullptr);
+
+    // Headers that are consistent in themselves but describe far more data than the stream holds, or whose counts
+    // wrap around when added, are rejected before anything is allocated.
+    using Header = BVH::Detail::SerializationHeader;
+
+    const auto patchedHeader = [&bytes](const Header& a_header) {
+      std::string copy = bytes;
+      std::memcpy(&copy[0], &a_header, sizeof(a_header));
+
+      return copy;
+    };
+
+    Header huge = header;
+    huge.numPrimitives = std::numeric_limits<uint32_t>::max();
+    huge.size          = huge.primitivesOffset + huge.numPrimitives * huge.primitiveSize;
+    CHECK(loadBytes(patchedHeader(huge)) == nullptr);
+
+    Header wrapped = header;
+    wrapped.numInteriorNodes = std::numeric_limits<uint64_t>::max();
+    wrapped.numLeaves        = header.numNodes + 1;
+    CHECK(loadBytes(patchedHeader(wrapped)) == nullptr);
+
+    // A stream that cannot tell its length is not read.
+    std::stringstream unseekable(bytes);
+    unseekable.setstate(std::ios::failbit);
+    CHECK(Packed::load(unseekable) == nullptr);
+
+    // A tree written in one precision does not load in the other.
+    using Other    = std::conditional_t<std::is_same_v<T, float>, double, float>;
+    using OtherPnt = BareTestPoint<Other>;
+
+    std::stringstream in(bytes);
+    CHECK(BVH::PackedBVH<Other, OtherPnt, 4, BVH::ValueStorage<OtherPnt>>::load(in) == nullptr);
+  }
+}
+
+TEMPLATE_TEST_CASE("PackedBVH::view: a serialized tree is queried in place, read-only",
+                   "[BVH][serialization]",
+                   EBGEOMETRY_TEST_PRECISIONS)
+{
+  using T      = TestType;
+  using AABB   = BoundingVolumes::AABBT<T>;
+  using Vec3   = Vec3T<T>;
+  using Pnt    = BareTestPoint<T>;
+  using Packed = BVH::PackedBVH<T, Pnt, 4, BVH::ValueStorage<Pnt>>;
+
+  std::vector<std::pair<Pnt, AABB>> primsAndBVs;
+  for (int i = 0; i < 6; i++) {
+    for (int j = 0; j < 6; j++) {
+      const Vec3 pos(T(i) - T(0.4) * T(j), T(j) + T(0.2) * T(i), T(i * j) * T(0.1));
+
+      primsAndBVs.emplace_back(Pnt{pos}, AABB(pos, pos));
+    }
+  }
+
+  const Packed packed(std::move(primsAndBVs), BVH::BinnedSAHPartitioner<T, Pnt, AABB, 4>);
+
+  std::stringstream stream;
+  REQUIRE(packed.save(stream));
+
+  const std::string bytes = stream.str();
+
+  // Over-aligned blocks, so the buffer starts on a section boundary like a mapped file does.
+  struct alignas(BVH::Detail::SerializationAlignment) Block
+  {
+    char bytes[BVH::Detail::SerializationAlignment];
+  };
+
+  std::vector<Block> buffer(bytes.size() / sizeof(Block) + 2);
+  char* const        data = reinterpret_cast<char*>(buffer.data());
+  std::memcpy(data, bytes.data(), bytes.size());
+
+  const auto nearest2 = [](const Packed& a_bvh, const Vec3& a_query) {
+    const Pnt* prims = a_bvh.getPrimitiveData();
+
+    T state = std::numeric_limits<T>::max();
+
+    a_bvh.pruneTraverse(
+      a_query,
+      state,
+      [prims, &a_query](T& a_state, size_t a_offset, size_t a_count) noexcept {
+        for (size_t i = 0; i < a_count; i++) {
+          a_state = std::min(a_state, (prims[a_offset + i].m_pos - a_query).length2());
+        }
+      },
+      [](const T& a_state) noexcept -> T { return a_state; });
+
+    return state;
+  };
+
+  SECTION("Queries match the owned tree")
+  {
+    const auto viewed = Packed::view(data, bytes.size());
+    REQUIRE(viewed != nullptr);
+
+    CHECK(viewed->isMapped());
+    CHECK(!packed.isMapped());
+    CHECK(viewed->getPrimitives().empty());
+    CHECK(viewed->getNumPrimitives() == packed.getNumPrimitives());
+    // Primitives are the last section, and are used where they lie.
+    CHECK(reinterpret_cast<const char*>(viewed->getPrimitiveData()) ==
+          data + bytes.size() - packed.getNumPrimitives() * sizeof(Pnt));
+    CHECK(viewed->computeMetrics().sahCost == packed.computeMetrics().sahCost);
 
-    for (const auto& h : handles) {
-      lo = min(lo, h->m_pos);
-      hi = max(hi, h->m_pos);
+    for (const auto& q : queryPoints<T>()) {
+      CHECK(nearest2(*viewed, q) == nearest2(packed, q));
     }
 
-    return AABB(lo, hi);
-  };
+    // The generic traversal hands leaf evaluators the primitives of a viewed tree, too.
+    const auto nearestByTraverse = [](const Packed& a_bvh, const Vec3& a_query) {
+      using Node = typename Packed::NodeView;
 
-  const auto bruteNearest2 = [&handles](const Vec3& a_query) noexcept -> T {
-    T brute2 = std::numeric_limits<T>::max();
+      T best = std::numeric_limits<T>::max();
 
-    for (const auto& h : handles) {
-      brute2 = std::min(brute2, (h->m_pos - a_query).length2());
+      a_bvh.template traverse<T>(
+        [&best, &a_query](const Pnt* a_prims, size_t a_offset, size_t a_count) noexcept {
+          for (size_t i = a_offset; i < a_offset + a_count; i++) {
+            best = std::min(best, (a_prims[i].m_pos - a_query).length2());
+          }
+        },
+        [&best](const Node&, const T& a_dist2) noexcept { return a_dist2 <= best; },
+        [](std::array<std::pair<uint32_t, T>, 4>&) noexcept {},
+        [&a_query](const Node& a_node) noexcept { return a_node.getDistanceToBoundingVolume2(a_query); });
+
+      return best;
+    };
+
+    for (const auto& q : queryPoints<T>()) {
+      CHECK(nearestByTraverse(*viewed, q) == nearest2(packed, q));
     }
 
-    return brute2;
-  };
+    // Copies share the same memory, and writing a viewed tree gives the bytes it was viewed from.
+    const Packed copy = *viewed;
+    CHECK(copy.getPrimitiveData() == viewed->getPrimitiveData());
 
-  SECTION("refit with unchanged geometry reproduces the original bounding volumes")
+    std::stringstream again;
+    REQUIRE(copy.save(again));
+    CHECK(again.str() == bytes);
+  }
+
+  SECTION("A viewed tree is read-only")
   {
-    const AABB before = packed->getBoundingVolume();
+    auto viewed = Packed::view(data, bytes.size());
+    REQUIRE(viewed != nullptr);
 
-    tree->refit(bvConstructor);
-    packed->refit(bvConstructor);
+    viewed->refit([](const Pnt& a_prim) { return AABB(a_prim.m_pos - Vec3::ones(), a_prim.m_pos + Vec3::ones()); });
+    viewed->optimize();
+    viewed->relayout(BVH::Layout::BreadthFirst);
 
-    for (int d = 0; d < 3; d++) {
-      REQUIRE_THAT(packed->getBoundingVolume().getLowCorner()[d],
-                   withinAbsT(before.getLowCorner()[d], tightMargin<T>()));
-      REQUIRE_THAT(packed->getBoundingVolume().getHighCorner()[d],
-                   withinAbsT(before.getHighCorner()[d], tightMargin<T>()));
-    }
+    CHECK(std::memcmp(data, bytes.data(), bytes.size()) == 0);
+  }
+
+  SECTION("The owner is kept alive")
+  {
+    auto owner = std::make_shared<std::vector<Block>>(buffer);
+
+    const auto viewed = Packed::view(owner->data(), bytes.size(), owner);
+    REQUIRE(viewed != nullptr);
+
+    owner.reset();
 
     for (const auto& q : queryPoints<T>()) {
-      REQUIRE_THAT(nearest2(q), withinAbsT(bruteNearest2(q), traversalMargin<T>()));
+      CHECK(nearest2(*viewed, q) == nearest2(packed, q));
     }
   }
 
-  SECTION("refit after moving the geometry keeps every query correct")
+  SECTION("Rejected buffers")
   {
-    // Displace every point by a per-point, non-uniform translation: primitives shift without
-    // migrating between leaves -- exactly the refit use case.
-    for (size_t i = 0; i < handles.size(); i++) {
-      const T s = T(0.05) * T(i);
+    CHECK(Packed::view(nullptr, 0) == nullptr);
+    CHECK(Packed::view(data, bytes.size() - 1) == nullptr);
 
-      handles[i]->m_pos += Vec3(T(2.0) + s, T(-1.0) - s, T(0.5) * s);
-    }
+    // The same bytes, shifted off the section alignment.
+    std::memmove(data + sizeof(T), data, bytes.size());
+    CHECK(Packed::view(data + sizeof(T), bytes.size()) == nullptr);
+  }
+}
 
-    tree->refit(bvConstructor);
-    packed->refit(bvConstructor);
+TEMPLATE_TEST_CASE("TriMeshSDF::save/load/map: a mesh loaded or mapped from a file gives the same signed distances "
+                   "without a rebuild",
+                   "[BVH][serialization][TriMesh]",
+                   EBGEOMETRY_TEST_PRECISIONS)
+{
+  using T = TestType;
 
-    // Both roots must agree with the tight box over the moved cloud.
-    const AABB tight = tightRoot();
+  constexpr size_t K = 4;
+  constexpr size_t W = 4;
 
-    for (int d = 0; d < 3; d++) {
-      REQUIRE_THAT(tree->getBoundingVolume().getLowCorner()[d], withinAbsT(tight.getLowCorner()[d], tightMargin<T>()));
-      REQUIRE_THAT(tree->getBoundingVolume().getHighCorner()[d],
-                   withinAbsT(tight.getHighCorner()[d], tightMargin<T>()));
-      REQUIRE_THAT(packed->getBoundingVolume().getLowCorner()[d],
-                   withinAbsT(tight.getLowCorner()[d], tightMargin<T>()));
-      REQUIRE_THAT(packed->getBoundingVolume().getHighCorner()[d],
-                   withinAbsT(tight.getHighCorner()[d], tightMargin<T>()));
-    }
+  const auto mesh = Parser::readIntoDCEL<T, Meta>(dataPath("dodecahedron.stl"));
+  REQUIRE(mesh != nullptr);
 
-    for (const auto& q : queryPoints<T>()) {
-      REQUIRE_THAT(nearest2(q), withinAbsT(bruteNearest2(q), traversalMargin<T>()));
-    }
+  const TriMeshSDF<T, Meta, K, W> built(mesh, BVH::Build::SAH, 2);
+
+  const std::string filename =
+    (std::filesystem::temp_directory_path() / ("EBGeometry_TestBVH_" + std::to_string(sizeof(T)) + ".ebg")).string();
+
+  REQUIRE(built.save(filename));
+
+  const auto loaded = TriMeshSDF<T, Meta, K, W>::load(filename);
+  const auto mapped = TriMeshSDF<T, Meta, K, W>::map(filename);
+  std::filesystem::remove(filename);
+
+  REQUIRE(loaded != nullptr);
+  REQUIRE(mapped != nullptr);
+
+  // The mapping outlives the file name.
+  for (const auto& p : queryPoints<T>()) {
+    CHECK(loaded->signedDistance(p) == built.signedDistance(p));
+    CHECK(loaded->getClosestTriangle(p).metaData == built.getClosestTriangle(p).metaData);
+    CHECK(mapped->signedDistance(p) == built.signedDistance(p));
+    CHECK(mapped->getClosestTriangle(p).metaData == built.getClosestTriangle(p).metaData);
+  }
+
+  const std::vector<Vec3T<T>> points = queryPoints<T>();
+  std::vector<T>              values(points.size());
+
+  mapped->values(points.data(), values.data(), points.size());
+  for (size_t i = 0; i < points.size(); i++) {
+    CHECK(values[i] == built.signedDistance(points[i]));
   }
+
+  CHECK(TriMeshSDF<T, Meta, K, W>::load(filename) == nullptr);
+  CHECK(TriMeshSDF<T, Meta, K, W>::map(filename) == nullptr);
 }
 
 TEMPLATE_TEST_CASE("Parser::readIntoPackedBVH matches MeshSDF built directly from the same mesh",
@@ -807,6 +2542,337 @@ TEMPLATE_TEST_CASE("TreeBVH::bottomUpSortAndPartition handles primitive sets who
   }
 }
 
+TEMPLATE_TEST_CASE("TreeBVH::plocSortAndPartition: every primitive lands in exactly one bounded leaf and "
+                   "nearest-neighbor queries match brute force",
+                   "[BVH][PLOC]",
+                   EBGEOMETRY_TEST_PRECISIONS)
+{
+  using T    = TestType;
+  using AABB = BoundingVolumes::AABBT<T>;
+  using Vec3 = Vec3T<T>;
+  using Pnt  = BareTestPoint<T>;
+
+  constexpr size_t K = 4;
+
+  auto buildAndCheck = [&](const std::vector<Vec3>& a_positions, size_t a_maxLeafSize, size_t a_searchRadius) {
+    INFO("Leaf size " << a_maxLeafSize << ", search radius " << a_searchRadius);
+
+    BVH::PrimAndBVList<Pnt, AABB> primsAndBVs;
+    for (const auto& pos : a_positions) {
+      primsAndBVs.emplace_back(std::make_shared<Pnt>(Pnt{pos}), AABB(pos, pos));
+    }
+
+    auto tree = std::make_shared<BVH::TreeBVH<T, Pnt, AABB, K>>(primsAndBVs);
+    tree->plocSortAndPartition(a_maxLeafSize, a_searchRadius);
+    REQUIRE(tree->isPartitioned());
+
+    const auto packed = tree->pack();
+    REQUIRE(packed != nullptr);
+    REQUIRE(packed->getPrimitives().size() == a_positions.size());
+
+    // An unpruned traversal visits every leaf once: together the leaves must tile the primitive array.
+    using Leaves = std::vector<std::pair<size_t, size_t>>;
+
+    Leaves leaves;
+    packed->pruneTraverse(
+      Vec3::zeros(),
+      leaves,
+      [](Leaves& a_leaves, size_t a_offset, size_t a_count) noexcept { a_leaves.emplace_back(a_offset, a_count); },
+      [](const Leaves&) noexcept { return std::numeric_limits<T>::max(); });
+
+    std::sort(leaves.begin(), leaves.end());
+
+    size_t next = 0;
+    for (const auto& [offset, count] : leaves) {
+      REQUIRE(offset == next);
+      REQUIRE(count > 0);
+      REQUIRE(count <= std::max(a_maxLeafSize, K - 1));
+
+      next += count;
+    }
+    REQUIRE(next == a_positions.size());
+
+    const auto& prims      = packed->getPrimitives();
+    const auto  pruneDist2 = [](const T& a_state) noexcept -> T { return a_state; };
+
+    for (const auto& q : queryPoints<T>()) {
+      T          state    = std::numeric_limits<T>::max();
+      const auto evalLeaf = [&prims, &q](T& a_state, size_t a_offset, size_t a_count) noexcept {
+        for (size_t i = 0; i < a_count; i++) {
+          a_state = std::min(a_state, (prims[a_offset + i]->m_pos - q).length2());
+        }
+      };
+
+      packed->pruneTraverse(q, state, evalLeaf, pruneDist2);
+
+      T bruteMin2 = std::numeric_limits<T>::max();
+      for (const auto& pos : a_positions) {
+        bruteMin2 = std::min(bruteMin2, (pos - q).length2());
+      }
+
+      REQUIRE_THAT(state, withinAbsT(bruteMin2, traversalMargin<T>()));
+    }
+  };
+
+  SECTION("Scattered point cloud")
+  {
+    std::vector<Vec3> positions;
+
+    unsigned int state = 2468u;
+    const auto   next  = [&state]() -> T {
+      state = state * 1103515245u + 12345u;
+      return T((state >> 8) % 10000u) / T(1000);
+    };
+    for (int i = 0; i < 3000; i++) {
+      positions.emplace_back(next(), next(), next());
+    }
+
+    buildAndCheck(positions, K - 1, BVH::PLOCSearchRadius);
+    buildAndCheck(positions, 8, 1);
+    buildAndCheck(positions, 1, 4);
+  }
+
+  SECTION("All primitives exactly coincident (every merge is a tie)")
+  {
+    buildAndCheck(std::vector<Vec3>(50, Vec3(2, -1, 3)), K - 1, BVH::PLOCSearchRadius);
+  }
+
+  SECTION("Fewer primitives than K: the root stays a leaf")
+  {
+    buildAndCheck({Vec3(0, 0, 0), Vec3(1, 0, 0)}, 1, BVH::PLOCSearchRadius);
+  }
+}
+
+TEMPLATE_TEST_CASE("BVH::splitPolygon/clipPolygonToBox: clipped triangles have the expected bounds",
+                   "[BVH][SBVH]",
+                   EBGEOMETRY_TEST_PRECISIONS)
+{
+  using T    = TestType;
+  using AABB = BoundingVolumes::AABBT<T>;
+  using Vec3 = Vec3T<T>;
+
+  const std::vector<Vec3> tri{Vec3(0, 0, 0), Vec3(4, 0, 0), Vec3(0, 4, 0)};
+
+  std::vector<Vec3> below;
+  std::vector<Vec3> above;
+  std::vector<Vec3> scratch;
+
+  BVH::splitPolygon<T>(tri, 0, T(2), &below, &above);
+
+  const AABB everywhere(Vec3(-10, -10, -10), Vec3(10, 10, 10));
+  const AABB belowBox = BVH::polygonBoundingBox(below, everywhere);
+  const AABB aboveBox = BVH::polygonBoundingBox(above, everywhere);
+
+  REQUIRE(belowBox.getLowCorner() == Vec3(0, 0, 0));
+  REQUIRE(belowBox.getHighCorner() == Vec3(2, 4, 0));
+  REQUIRE(aboveBox.getLowCorner() == Vec3(2, 0, 0));
+  REQUIRE(aboveBox.getHighCorner() == Vec3(4, 2, 0));
+
+  // Only the corner x, y >= 1, x + y <= 4 of the triangle lies inside the box.
+  std::vector<Vec3> polygon = tri;
+  BVH::clipPolygonToBox(polygon, AABB(Vec3(1, 1, -1), Vec3(3, 3, 1)), scratch);
+
+  const AABB clippedBox = BVH::polygonBoundingBox(polygon, everywhere);
+
+  REQUIRE(clippedBox.getLowCorner() == Vec3(1, 1, 0));
+  REQUIRE(clippedBox.getHighCorner() == Vec3(3, 3, 0));
+
+  // A box beyond the hypotenuse misses the triangle altogether.
+  polygon = tri;
+  BVH::clipPolygonToBox(polygon, AABB(Vec3(3, 3, -1), Vec3(4, 4, 1)), scratch);
+
+  REQUIRE(polygon.empty());
+}
+
+TEMPLATE_TEST_CASE("TreeBVH::spatialSortAndPartition: sliver triangles are duplicated within budget and signed "
+                   "distances match brute force",
+                   "[BVH][SBVH]",
+                   EBGEOMETRY_TEST_PRECISIONS)
+{
+  using T    = TestType;
+  using AABB = BoundingVolumes::AABBT<T>;
+  using Vec3 = Vec3T<T>;
+  using Tri  = Triangle<T, Meta>;
+
+  constexpr size_t K = 4;
+  constexpr int    N = 600;
+
+  // A disk tessellated as a fan: every triangle is a long sliver from the center to the rim, so the triangle
+  // bounding boxes overlap heavily and object splits alone cannot separate them.
+  const T pi = T(4) * std::atan(T(1));
+
+  std::vector<std::shared_ptr<Tri>> tris;
+  for (int i = 0; i < N; i++) {
+    const T t0 = T(2) * pi * T(i) / T(N);
+    const T t1 = T(2) * pi * T(i + 1) / T(N);
+
+    auto tri = std::make_shared<Tri>();
+    tri->setVertexPositions(
+      {Vec3(0, 0, 0), Vec3(10 * std::cos(t0), 10 * std::sin(t0), 0), Vec3(10 * std::cos(t1), 10 * std::sin(t1), 0)});
+    tri->setNormal(Vec3(0, 0, 1));
+    tri->setVertexNormals({Vec3(0, 0, 1), Vec3(0, 0, 1), Vec3(0, 0, 1)});
+    tri->setEdgeNormals({Vec3(0, 0, 1), Vec3(0, 0, 1), Vec3(0, 0, 1)});
+
+    tris.emplace_back(tri);
+  }
+
+  std::vector<Vec3> queries;
+
+  unsigned int state = 1357u;
+  const auto   next  = [&state]() -> T {
+    state = state * 1103515245u + 12345u;
+    return T((state >> 8) % 10000u) / T(5000) - T(1);
+  };
+  for (int i = 0; i < 200; i++) {
+    queries.emplace_back(12 * next(), 12 * next(), next());
+  }
+
+  const auto brute = [&tris](const Vec3& a_point) -> T {
+    T minDist = std::numeric_limits<T>::max();
+    for (const auto& tri : tris) {
+      const T d = tri->signedDistance(a_point);
+      if (std::abs(d) < std::abs(minDist)) {
+        minDist = d;
+      }
+    }
+    return minDist;
+  };
+
+  const auto polygon = [](const Tri& a_tri, std::vector<Vec3>& a_vertices) {
+    const auto& vp = a_tri.getVertexPositions();
+    a_vertices.assign(vp.begin(), vp.end());
+  };
+
+  BVH::PrimAndBVList<Tri, AABB> primsAndBVs;
+  for (const auto& tri : tris) {
+    const auto&             vp = tri->getVertexPositions();
+    const std::vector<Vec3> verts{vp[0], vp[1], vp[2]};
+    primsAndBVs.emplace_back(tri, AABB(verts));
+  }
+
+  for (const double budget : {0.0, BVH::SpatialSplitBudget, 1.0}) {
+    INFO("Budget " << budget);
+
+    constexpr size_t maxLeafSize = 4;
+
+    auto tree = std::make_shared<BVH::TreeBVH<T, Tri, AABB, K>>(primsAndBVs);
+    tree->spatialSortAndPartition(polygon, maxLeafSize, budget);
+    REQUIRE(tree->isPartitioned());
+
+    const auto packed = tree->pack();
+    REQUIRE(packed != nullptr);
+
+    const auto& prims = packed->getPrimitives();
+
+    // Duplicates are whole primitives, at most budget * N of them, and no triangle may be dropped.
+    if (budget == 0.0) {
+      REQUIRE(prims.size() == size_t(N));
+    }
+    else {
+      REQUIRE(prims.size() > size_t(N));
+      REQUIRE(prims.size() <= size_t(N) + size_t(budget * N));
+    }
+
+    std::vector<const Tri*> unique;
+    for (const auto& prim : prims) {
+      unique.emplace_back(&(*prim));
+    }
+    std::sort(unique.begin(), unique.end());
+    unique.erase(std::unique(unique.begin(), unique.end()), unique.end());
+
+    REQUIRE(unique.size() == size_t(N));
+
+    using Leaves = std::vector<std::pair<size_t, size_t>>;
+
+    Leaves leaves;
+    packed->pruneTraverse(
+      Vec3::zeros(),
+      leaves,
+      [](Leaves& a_leaves, size_t a_offset, size_t a_count) noexcept { a_leaves.emplace_back(a_offset, a_count); },
+      [](const Leaves&) noexcept { return std::numeric_limits<T>::max(); });
+
+    for (const auto& leaf : leaves) {
+      REQUIRE(leaf.second > 0);
+      REQUIRE(leaf.second <= maxLeafSize);
+    }
+
+    const auto pruneDist2 = [](const T& a_state) noexcept -> T { return a_state * a_state; };
+
+    for (const auto& q : queries) {
+      T          minDist  = std::numeric_limits<T>::max();
+      const auto evalLeaf = [&prims, &q](T& a_state, size_t a_offset, size_t a_count) noexcept {
+        for (size_t i = 0; i < a_count; i++) {
+          const T d = prims[a_offset + i]->signedDistance(q);
+          if (std::abs(d) < std::abs(a_state)) {
+            a_state = d;
+          }
+        }
+      };
+
+      packed->pruneTraverse(q, minDist, evalLeaf, pruneDist2);
+
+      REQUIRE_THAT(minDist, withinAbsT(brute(q), traversalMargin<T>()));
+    }
+
+    // remove() takes out every reference to a triangle, also those in leaves whose clipped boxes do not contain the
+    // triangle's box.
+    std::vector<const Tri*> kept;
+    for (int i = 0; i < N; i++) {
+      const Tri* target = tris[size_t(i)].get();
+
+      if (i % 3 == 0) {
+        REQUIRE(packed->remove(primsAndBVs[size_t(i)].second,
+                               [target](const Tri& a_tri) noexcept { return &a_tri == target; }));
+      }
+      else {
+        kept.emplace_back(target);
+      }
+    }
+
+    packed->compact();
+
+    std::vector<const Tri*> left;
+    for (const auto& prim : packed->getPrimitives()) {
+      left.emplace_back(&(*prim));
+    }
+    std::sort(left.begin(), left.end());
+    left.erase(std::unique(left.begin(), left.end()), left.end());
+    std::sort(kept.begin(), kept.end());
+
+    REQUIRE(left == kept);
+
+    for (const auto& q : queries) {
+      T keptDist = std::numeric_limits<T>::max();
+      for (const Tri* tri : kept) {
+        const T d = tri->signedDistance(q);
+        if (std::abs(d) < std::abs(keptDist)) {
+          keptDist = d;
+        }
+      }
+
+      T          minDist  = std::numeric_limits<T>::max();
+      const auto evalLeaf = [prims = packed->getPrimitiveData(), &q](T& a_state, size_t a_offset, size_t a_count) {
+        for (size_t i = 0; i < a_count; i++) {
+          const T d = prims[a_offset + i]->signedDistance(q);
+          if (std::abs(d) < std::abs(a_state)) {
+            a_state = d;
+          }
+        }
+      };
+
+      packed->pruneTraverse(q, minDist, evalLeaf, pruneDist2);
+
+      REQUIRE_THAT(minDist, withinAbsT(keptDist, traversalMargin<T>()));
+    }
+  }
+
+  const TriMeshSDF<T, Meta, K, 4> triMesh(tris, BVH::Build::SBVH, 1);
+
+  for (const auto& q : queries) {
+    REQUIRE_THAT(triMesh.signedDistance(q), withinAbsT(brute(q), traversalMargin<T>()));
+  }
+}
+
 TEMPLATE_TEST_CASE("PackedBVH: BVH::ValueStorage and the default BVH::SharedPtrStorage agree exactly",
                    "[BVH][StoragePolicy]",
                    EBGEOMETRY_TEST_PRECISIONS)
@@ -1167,9 +3233,8 @@ TEMPLATE_TEST_CASE("PackedBVH: direct SFC-build constructor (no TreeBVH) matches
   }
   REQUIRE(positions.size() == 125);
 
-  // Target leaf sizes chosen so the resulting real-leaf count lands both exactly on a power of K
-  // (125/25=5 real leaves -> pads to 8) and well off of one (125/7=18 real leaves -> pads to 32;
-  // 125/1=125 real leaves -> pads to 128), exercising the padding path at different ratios.
+  // Target leaf sizes chosen so the leaf count is never a power of K (125/25=5 leaves, 125/7=18 leaves,
+  // 125/1=125 leaves), so the last node on every level has fewer than K children.
   for (const size_t targetLeafSize : {size_t(1), size_t(7), size_t(25), size_t(125)}) {
     INFO("Target leaf size: " << targetLeafSize);
 
@@ -1603,6 +3668,31 @@ TEMPLATE_TEST_CASE("PackedBVH: direct top-down/SAH-build constructor (no TreeBVH
     // cluster-then-SAH path rather than collapsing to a single cluster.
     const BVH::PackedBVH<T, Pnt, K> packed(makeFlatPrims(), BVH::ClusterSpec{size_t(4)});
     checkPacked("ClusterSAH", packed);
+
+    // Every leaf holds a single cluster; ranges of fewer than K clusters give nodes with fewer than K children.
+    using PackedNode = typename BVH::PackedBVH<T, Pnt, K>::NodeView;
+
+    size_t partialNodes = 0;
+
+    packed.template traverse<int>(
+      [](const std::shared_ptr<const Pnt>*, size_t, size_t) {},
+      [&partialNodes](const PackedNode& a_node, const int&) {
+        if (a_node.isLeaf()) {
+          CHECK(a_node.getNumPrimitives() <= 4);
+        }
+        else {
+          CHECK(a_node.getNumChildren() >= 2);
+
+          partialNodes += (a_node.getNumChildren() < K) ? 1 : 0;
+        }
+
+        return true;
+      },
+      [](std::array<std::pair<uint32_t, int>, K>&) {},
+      [](const PackedNode&) { return 0; });
+
+    CHECK(partialNodes > 0);
+    CHECK(packed.computeMetrics().numPaddedLeaves == 0);
   }
 
   SECTION("Single primitive (root is itself a leaf) -- every direct partitioner")
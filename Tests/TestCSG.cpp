@@ -10,7 +10,11 @@
 #include "TestFloatingPointUtils.hpp"
 
 #include <cmath>
+#include <memory>
+#include <string>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 #include <catch2/catch_template_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
@@ -419,6 +423,53 @@ TEMPLATE_TEST_CASE("BVHUnion: free function matches BVHUnionIF and the (primsAnd
   }
 }
 
+TEMPLATE_TEST_CASE("BVHUnionIF: insert() and remove() update the union without a rebuild",
+                   "[CSG][BVHUnion]",
+                   EBGEOMETRY_TEST_PRECISIONS)
+{
+  using T    = TestType;
+  using Vec3 = Vec3T<T>;
+
+  constexpr size_t K = 4;
+
+  const auto spheres = sphereRow<T>();
+  const auto bvs     = sphereRowBVs<T>();
+
+  BVHUnionIF<T, Sphere<T>, BV<T>, K> bvhUnion(spheres, bvs);
+
+  // Add a second row above the first, then take out every other sphere of the first row.
+  std::vector<std::shared_ptr<IF<T>>> live;
+  for (int i = 0; i < NumRowSpheres; i++) {
+    const Vec3 center(3.0 * i, 3.0, 0);
+
+    const auto sphere = std::make_shared<Sphere<T>>(center, T(1));
+
+    bvhUnion.insert(sphere, sphereBV<T>(center, T(1)));
+    live.emplace_back(sphere);
+  }
+  for (int i = 0; i < NumRowSpheres; i++) {
+    if (i % 2 == 0) {
+      CHECK(bvhUnion.remove(spheres[size_t(i)], bvs[size_t(i)]));
+    }
+    else {
+      live.emplace_back(spheres[size_t(i)]);
+    }
+  }
+
+  // Already removed.
+  CHECK_FALSE(bvhUnion.remove(spheres[0], bvs[0]));
+
+  const UnionIF<T> sharpUnion(live);
+
+  for (const auto& p : lineQueryPoints<T>()) {
+    for (const T y : {T(-1), T(0), T(1.5), T(3), T(4)}) {
+      const Vec3 q(p[0], y, T(0.5));
+
+      REQUIRE_THAT(bvhUnion.value(q), withinAbsT(sharpUnion.value(q), formulaMargin<T>()));
+    }
+  }
+}
+
 TEMPLATE_TEST_CASE("BVHSmoothUnionIF: agrees with SmoothUnionIF far from any blend region",
                    "[CSG][BVHSmoothUnion]",
                    EBGEOMETRY_TEST_PRECISIONS)
@@ -885,3 +936,61 @@ TEMPLATE_TEST_CASE("FiniteRepetition: free function matches FiniteRepetitionIF",
     REQUIRE_THAT(freeFunc->value(p), withinAbsT(direct.value(p), formulaMargin<T>()));
   }
 }
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Batched evaluation (ImplicitFunction::values)
+// ─────────────────────────────────────────────────────────────────────────────
+
+TEMPLATE_TEST_CASE("CSG values(): every combinator's batched evaluation matches point-by-point value()",
+                   "[CSG][Batch]",
+                   EBGEOMETRY_TEST_PRECISIONS)
+{
+  using T    = TestType;
+  using Vec3 = Vec3T<T>;
+
+  constexpr size_t K = 4;
+
+  const std::shared_ptr<IF<T>> a = sphereC<T>();
+  const std::shared_ptr<IF<T>> b = sphereD<T>();
+  const std::shared_ptr<IF<T>> c = sphereB<T>();
+
+  const std::vector<std::shared_ptr<IF<T>>> abc{a, b, c};
+
+  const auto spheres = sphereRow<T>();
+  const auto bvs     = sphereRowBVs<T>();
+
+  std::vector<std::pair<std::string, std::shared_ptr<IF<T>>>> functions{
+    {"Union", Union<T>(abc)},
+    {"SmoothUnion", SmoothUnion<T>(abc, T(0.5))},
+    {"Intersection", Intersection<T>(abc)},
+    {"SmoothIntersection", SmoothIntersection<T>(abc, T(0.5))},
+    {"Difference", Difference<T>(a, b)},
+    {"SmoothDifference", SmoothDifference<T>(a, b, T(0.5))},
+    {"FiniteRepetition", FiniteRepetition<T>(a, Vec3(5, 5, 5), Vec3(2, 2, 2), Vec3(2, 2, 2))},
+    {"BVHUnion", std::make_shared<BVHUnionIF<T, Sphere<T>, BV<T>, K>>(spheres, bvs)},
+    {"BVHSmoothUnion", std::make_shared<BVHSmoothUnionIF<T, Sphere<T>, BV<T>, K>>(spheres, bvs, T(0.5))},
+    {"Nested", Difference<T>(Union<T>(abc), SmoothIntersection<T>(a, b, T(0.25)))},
+  };
+
+  // More points than ImplicitFunction::s_batchChunkSize so chunk boundaries are exercised.
+  std::vector<Vec3> points;
+  for (const T x : sweepValues<T>(T(-4.0), T(36.0), 24)) {
+    for (const T y : sweepValues<T>(T(-3.0), T(3.0), 6)) {
+      for (const T z : sweepValues<T>(T(-2.0), T(2.0), 3)) {
+        points.emplace_back(x, y, z);
+      }
+    }
+  }
+  REQUIRE(points.size() > IF<T>::s_batchChunkSize);
+
+  for (const auto& [name, function] : functions) {
+    INFO(name);
+
+    std::vector<T> batched(points.size());
+    function->values(points.data(), batched.data(), points.size());
+
+    for (size_t i = 0; i < points.size(); i++) {
+      REQUIRE_THAT(batched[i], withinAbsT(function->value(points[i]), exactMargin<T>()));
+    }
+  }
+}
@@ -4,8 +4,15 @@
 #include "EBGeometry.hpp"
 #include "TestFloatingPointUtils.hpp"
 
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <map>
 #include <string>
 #include <type_traits>
+#include <vector>
 
 #include <catch2/catch_template_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
@@ -744,6 +751,145 @@ TEMPLATE_TEST_CASE("MeshT: reconcile computes positive face areas and unit-lengt
   }
 }
 
+TEMPLATE_TEST_CASE("MeshT: parallel reconcile matches reconciling one object at a time",
+                   "[DCEL][Mesh]",
+                   EBGEOMETRY_TEST_PRECISIONS)
+{
+  using T = TestType;
+
+  // A wavy N x N grid of quads and triangles, large enough to be split over several threads.
+  constexpr size_t N = 48;
+
+  std::vector<Vec3T<T>> verts;
+  for (size_t j = 0; j <= N; j++) {
+    for (size_t i = 0; i <= N; i++) {
+      verts.emplace_back(T(i), T(j), T(0.3) * std::sin(T(i)) * std::cos(T(0.7) * T(j)));
+    }
+  }
+
+  std::vector<std::vector<size_t>> facets;
+  for (size_t j = 0; j < N; j++) {
+    for (size_t i = 0; i < N; i++) {
+      const size_t v = j * (N + 1) + i;
+
+      if ((i + j) % 2 == 0) {
+        facets.push_back({v, v + 1, v + N + 2, v + N + 1});
+      }
+      else {
+        facets.push_back({v, v + 1, v + N + 2});
+        facets.push_back({v, v + N + 2, v + N + 1});
+      }
+    }
+  }
+
+  TestMesh<T> mesh;
+  Soup::soupToDCEL(mesh, verts, facets, "");
+
+  for (const auto& f : mesh.getFaces()) {
+    const Vec3T<T> normal   = f->getNormal();
+    const Vec3T<T> centroid = f->getCentroid();
+    const T        area     = f->getArea();
+
+    f->reconcile();
+
+    REQUIRE(f->getNormal() == normal);
+    REQUIRE(f->getCentroid() == centroid);
+    REQUIRE(f->getArea() == area);
+  }
+
+  for (const auto& e : mesh.getEdges()) {
+    REQUIRE(e->computeNormal() == e->getNormal());
+  }
+
+  for (const auto& v : mesh.getVertices()) {
+    const Vec3T<T> normal = v->getNormal();
+
+    v->computeVertexNormalAngleWeighted();
+
+    REQUIRE(v->getNormal() == normal);
+  }
+
+  mesh.reconcile(VertexNormalWeight::None);
+
+  for (const auto& v : mesh.getVertices()) {
+    const Vec3T<T> normal = v->getNormal();
+
+    v->computeVertexNormalAverage();
+
+    REQUIRE(v->getNormal() == normal);
+  }
+}
+
+TEMPLATE_TEST_CASE("MeshT: angle-weighted vertex normals are bit-identical to the serial per-vertex computation",
+                   "[DCEL][Mesh]",
+                   EBGEOMETRY_TEST_PRECISIONS)
+{
+  using T    = TestType;
+  using Vec3 = Vec3T<T>;
+
+  // An irregular triangulated height field, so that every vertex sums corners of different angles.
+  constexpr size_t N = 40;
+
+  unsigned int state = 97531u;
+  const auto   next  = [&state]() -> T {
+    state = state * 1103515245u + 12345u;
+    return T((state >> 8) % 10000u) / T(10000);
+  };
+
+  std::vector<Vec3> verts;
+  for (size_t j = 0; j <= N; j++) {
+    for (size_t i = 0; i <= N; i++) {
+      verts.emplace_back(T(i) + T(0.4) * next(), T(j) + T(0.4) * next(), next());
+    }
+  }
+
+  std::vector<std::vector<size_t>> facets;
+  for (size_t j = 0; j < N; j++) {
+    for (size_t i = 0; i < N; i++) {
+      const size_t v = j * (N + 1) + i;
+
+      facets.push_back({v, v + 1, v + N + 2});
+      facets.push_back({v, v + N + 2, v + N + 1});
+    }
+  }
+
+  const auto sameBits = [](const Vec3& a_lhs, const Vec3& a_rhs) -> bool {
+    for (size_t d = 0; d < 3; d++) {
+      const T lhs = a_lhs[d];
+      const T rhs = a_rhs[d];
+
+      if (std::memcmp(&lhs, &rhs, sizeof(T)) != 0) {
+        return false;
+      }
+    }
+
+    return true;
+  };
+
+  const unsigned numThreads = Parallel::getNumThreads();
+
+  for (const unsigned threads : {1U, 3U}) {
+    INFO("Threads " << threads);
+
+    Parallel::setNumThreads(threads);
+
+    TestMesh<T> mesh;
+    Soup::soupToDCEL(mesh, verts, facets, "");
+
+    mesh.reconcile(VertexNormalWeight::Angle);
+
+    for (const auto& v : mesh.getVertices()) {
+      const Vec3 normal = v->getNormal();
+
+      v->computeVertexNormalAngleWeighted();
+
+      CHECK(sameBits(v->getNormal(), normal));
+    }
+  }
+
+  Parallel::setNumThreads(numThreads);
+}
+
 TEMPLATE_TEST_CASE("MeshT: flip negates all vertex, edge, and face normals", "[DCEL][Mesh]", EBGEOMETRY_TEST_PRECISIONS)
 {
   using T   = TestType;
@@ -947,6 +1093,120 @@ TEMPLATE_TEST_CASE("Soup::compress on empty input clears the facet list", "[Soup
   REQUIRE(facets.empty());
 }
 
+TEMPLATE_TEST_CASE("Soup::weld returns a flat remap in first-occurrence order", "[Soup]", EBGEOMETRY_TEST_PRECISIONS)
+{
+  using T = TestType;
+
+  // Three interleaved copies of a 32^3 lattice -- enough vertices to span several parallel chunks. Copy c of
+  // lattice point p sits at index 3*p + c, so the welded list must be the lattice in order and vertex i must map
+  // to i/3. The last copy spells zero as -0, which must weld with +0.
+  constexpr size_t N = 32;
+
+  std::vector<Vec3T<T>> verts;
+  for (size_t p = 0; p < N * N * N; p++) {
+    const Vec3T<T> x(T(p % N), T((p / N) % N), T(p / (N * N)));
+
+    verts.emplace_back(x);
+    verts.emplace_back(x);
+    verts.emplace_back(x[0] == T(0) ? -T(0) : x[0], x[1], x[2]);
+  }
+
+  const std::vector<Vec3T<T>> original = verts;
+  const std::vector<uint32_t> remap    = Soup::weld(verts);
+
+  REQUIRE(verts.size() == N * N * N);
+  REQUIRE(remap.size() == original.size());
+
+  for (size_t i = 0; i < original.size(); i++) {
+    REQUIRE(remap[i] == i / 3);
+    REQUIRE(verts[remap[i]] == original[i]);
+  }
+}
+
+TEMPLATE_TEST_CASE("Soup::weld with a tolerance merges chains of close vertices", "[Soup]", EBGEOMETRY_TEST_PRECISIONS)
+{
+  using T = TestType;
+
+  // Vertices 0 and 1 are 1.5 * eps apart, but both are within eps of vertex 2, so all three are one vertex.
+  const T eps = T(1e-2);
+
+  std::vector<Vec3T<T>> verts = {{0, 0, 0}, {T(1.5) * eps, 0, 0}, {T(0.75) * eps, 0, 0}, {1, 1, 1}};
+
+  const std::vector<uint32_t> remap = Soup::weld(verts, eps);
+
+  REQUIRE(verts.size() == 2);
+  REQUIRE(remap == std::vector<uint32_t>{0, 0, 0, 1});
+  REQUIRE(verts[0] == Vec3T<T>(0, 0, 0));
+}
+
+TEMPLATE_TEST_CASE("Soup::weld handles NaN coordinates", "[Soup]", EBGEOMETRY_TEST_PRECISIONS)
+{
+  using T = TestType;
+
+  const T nan = std::numeric_limits<T>::quiet_NaN();
+  const T inf = std::numeric_limits<T>::infinity();
+
+  std::vector<Vec3T<T>> input;
+  for (size_t i = 0; i < 10; i++) {
+    input.emplace_back(T(i), 0, 0);
+  }
+  input.emplace_back(nan, 0, 0);
+  input.emplace_back(0, 0, 0);
+  input.emplace_back(nan, 0, 0);
+  input.emplace_back(inf, 0, 0);
+
+  // Without a tolerance, identical NaNs weld like any other coordinate bits.
+  std::vector<Vec3T<T>>       exact      = input;
+  const std::vector<uint32_t> exactRemap = Soup::weld(exact);
+
+  REQUIRE(exact.size() == 12);
+  REQUIRE(exactRemap == std::vector<uint32_t>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 0, 10, 11});
+
+  // With a tolerance, non-finite vertices are left alone.
+  std::vector<Vec3T<T>>       close      = input;
+  const std::vector<uint32_t> closeRemap = Soup::weld(close, T(0.5));
+
+  REQUIRE(close.size() == 13);
+  REQUIRE(closeRemap == std::vector<uint32_t>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 0, 11, 12});
+}
+
+TEMPLATE_TEST_CASE("Soup::compress with a tolerance welds near-coincident vertices",
+                   "[Soup]",
+                   EBGEOMETRY_TEST_PRECISIONS)
+{
+  using T = TestType;
+
+  // The two triangles disagree on the shared edge by less than the tolerance, and B straddles a grid cell face.
+  const T eps   = T(1e-3);
+  const T noise = T(2e-4);
+
+  std::vector<Vec3T<T>> verts = {
+    {0, 0, 0},                      // 0 = A
+    {T(1) - noise / 2, 0, 0},       // 1 = B
+    {0, 1, 0},                      // 2 = C
+    {T(1) + noise / 2, noise, 0},   // 3 = B, perturbed
+    {noise, -noise, noise},         // 4 = A, perturbed
+    {0, -1, 0},                     // 5 = D
+    {T(0.5), T(0.5), T(10) * eps}}; // 6 = E, near nothing
+  std::vector<std::vector<size_t>> facets = {{0, 1, 2}, {3, 4, 5}, {0, 2, 6}};
+
+  std::vector<Vec3T<T>>            exactVerts  = verts;
+  std::vector<std::vector<size_t>> exactFacets = facets;
+
+  Soup::compress(exactVerts, exactFacets);
+  Soup::compress(verts, facets, eps);
+
+  REQUIRE(exactVerts.size() == 7); // Without a tolerance nothing merges.
+  REQUIRE(verts.size() == 5);      // A, B, C, D, E.
+  REQUIRE(facets[0][0] == facets[1][1]);
+  REQUIRE(facets[0][1] == facets[1][0]);
+  REQUIRE(facets[2][2] == 4);
+
+  // Representatives are the first occurrences.
+  REQUIRE(verts[facets[0][0]] == Vec3T<T>(0, 0, 0));
+  REQUIRE(verts[facets[0][1]] == Vec3T<T>(T(1) - noise / 2, 0, 0));
+}
+
 TEMPLATE_TEST_CASE("Soup::soupToDCEL builds correct vertex, edge, and face counts",
                    "[Soup]",
                    EBGEOMETRY_TEST_PRECISIONS)
@@ -972,6 +1232,76 @@ TEMPLATE_TEST_CASE("Soup::soupToDCEL reconciles every half-edge's pair edge on a
   }
 }
 
+TEMPLATE_TEST_CASE("Soup::reconcilePairEdgesDCEL pairs the interior edges of an open grid",
+                   "[Soup]",
+                   EBGEOMETRY_TEST_PRECISIONS)
+{
+  using T = TestType;
+
+  // An N x N grid of triangulated quads has more half-edges than one parallel chunk. Interior edges must pair with
+  // their reverse; the 4N boundary edges stay unpaired.
+  constexpr size_t N = 128;
+
+  std::vector<Vec3T<T>> verts;
+  for (size_t j = 0; j <= N; j++) {
+    for (size_t i = 0; i <= N; i++) {
+      verts.emplace_back(T(i), T(j), T(0));
+    }
+  }
+
+  std::vector<std::vector<size_t>> facets;
+  for (size_t j = 0; j < N; j++) {
+    for (size_t i = 0; i < N; i++) {
+      const size_t v = j * (N + 1) + i;
+
+      facets.push_back({v, v + 1, v + N + 2});
+      facets.push_back({v, v + N + 2, v + N + 1});
+    }
+  }
+
+  TestMesh<T> mesh;
+  Soup::soupToDCEL(mesh, verts, facets, "grid");
+
+  size_t numBoundary = 0;
+  for (const auto& e : mesh.getEdges()) {
+    const auto& pair = e->getPairEdge();
+
+    if (pair == nullptr) {
+      numBoundary++;
+
+      continue;
+    }
+
+    REQUIRE(pair->getPairEdge() == e);
+    REQUIRE(pair->getVertex() == e->getOtherVertex());
+    REQUIRE(pair->getOtherVertex() == e->getVertex());
+  }
+
+  REQUIRE(mesh.getEdges().size() == 6 * N * N);
+  REQUIRE(numBoundary == 4 * N);
+}
+
+TEMPLATE_TEST_CASE("Soup::reconcilePairEdgesDCEL leaves the extra half-edges of a non-manifold edge unpaired",
+                   "[Soup]",
+                   EBGEOMETRY_TEST_PRECISIONS)
+{
+  using T = TestType;
+
+  // Three triangles hinged on the edge 0-1. The first half-edge on the hinge pairs with the first one running the
+  // other way; the third has nothing left to pair with.
+  std::vector<Vec3T<T>>            verts  = {{0, 0, 0}, {1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}};
+  std::vector<std::vector<size_t>> facets = {{0, 1, 2}, {1, 0, 3}, {1, 0, 4}};
+
+  TestMesh<T> mesh;
+  Soup::soupToDCEL(mesh, verts, facets, "hinge");
+
+  const auto& edges = mesh.getEdges();
+
+  REQUIRE(edges[0]->getPairEdge() == edges[3]);
+  REQUIRE(edges[3]->getPairEdge() == edges[0]);
+  REQUIRE(edges[6]->getPairEdge() == nullptr);
+}
+
 // ─────────────────────────────────────────────────────────────────────────────
 // Structural tests
 // ─────────────────────────────────────────────────────────────────────────────
@@ -1143,3 +1473,293 @@ TEMPLATE_TEST_CASE("FastTriMeshSDF: matches MeshSDF for tetrahedron",
   const T dEdgeFast  = fast->signedDistance(Vec3T<T>(0.5, 0.0, 0.0));
   REQUIRE_THAT(dEdgeFast, withinAbsT(dEdgeBrute, traversalMargin<T>()));
 }
+
+// ─────────────────────────────────────────────────────────────────────────────
+// IndexedMeshT (index-based, struct-of-arrays DCEL)
+// ─────────────────────────────────────────────────────────────────────────────
+
+template <class T>
+using TestIndexedMesh = IndexedMeshT<T, DefaultMetaData>;
+
+// Both readers compress and traverse the soup in the same order, so the linked and the indexed mesh number their
+// vertices, half-edges, and faces identically.
+template <class T>
+static void
+requireSameMesh(const TestMesh<T>& a_mesh, const TestIndexedMesh<T>& a_indexed)
+{
+  const auto& vertices = a_mesh.getVertices();
+  const auto& edges    = a_mesh.getEdges();
+  const auto& faces    = a_mesh.getFaces();
+
+  REQUIRE(a_indexed.getNumVertices() == vertices.size());
+  REQUIRE(a_indexed.getNumEdges() == edges.size());
+  REQUIRE(a_indexed.getNumFaces() == faces.size());
+
+  const auto requireSameVec = [](const Vec3T<T>& a_actual, const Vec3T<T>& a_expected) {
+    for (size_t dir = 0; dir < 3; dir++) {
+      REQUIRE_THAT(a_actual[dir], withinAbsT(a_expected[dir], exactMargin<T>()));
+    }
+  };
+
+  for (size_t v = 0; v < vertices.size(); v++) {
+    REQUIRE(a_indexed.getVertexPositions()[v] == vertices[v]->getPosition());
+    requireSameVec(a_indexed.getVertexNormals()[v], vertices[v]->getNormal());
+  }
+
+  std::map<const TestEdge<T>*, uint32_t> edgeIndex;
+  for (size_t e = 0; e < edges.size(); e++) {
+    edgeIndex[edges[e].get()] = static_cast<uint32_t>(e);
+  }
+
+  for (size_t e = 0; e < edges.size(); e++) {
+    REQUIRE(a_indexed.getEdgeNextEdges()[e] == edgeIndex.at(edges[e]->getNextEdge().get()));
+    REQUIRE(a_indexed.getEdgePairEdges()[e] == edgeIndex.at(edges[e]->getPairEdge().get()));
+    requireSameVec(a_indexed.getEdgeNormals()[e], edges[e]->getNormal());
+  }
+
+  for (size_t f = 0; f < faces.size(); f++) {
+    requireSameVec(a_indexed.getFaceNormals()[f], faces[f]->getNormal());
+    requireSameVec(a_indexed.getFaceCentroids()[f], faces[f]->getCentroid());
+    REQUIRE_THAT(a_indexed.getFaceAreas()[f], withinAbsT(faces[f]->getArea(), exactMargin<T>()));
+  }
+}
+
+TEMPLATE_TEST_CASE("IndexedMeshT: tetrahedron topology and normals", "[DCEL][IndexedMesh]", EBGEOMETRY_TEST_PRECISIONS)
+{
+  using T = TestType;
+
+  // Same soup as buildTetrahedron().
+  std::vector<Vec3T<T>>            verts  = {{0.0, 0.0, 0.0}, {1.0, 0.0, 0.0}, {0.0, 1.0, 0.0}, {0.0, 0.0, 1.0}};
+  std::vector<std::vector<size_t>> facets = {{0, 2, 1}, {0, 1, 3}, {0, 3, 2}, {1, 2, 3}};
+
+  Soup::compress(verts, facets);
+
+  TestIndexedMesh<T> mesh;
+  Soup::soupToIndexedDCEL(mesh, verts, facets, "tetrahedron-indexed");
+
+  REQUIRE(mesh.getNumVertices() == 4);
+  REQUIRE(mesh.getNumEdges() == 12);
+  REQUIRE(mesh.getNumFaces() == 4);
+
+  // Every half-edge u->v is paired with a v->u of another face, and pairing is an involution.
+  const auto& pairs = mesh.getEdgePairEdges();
+  for (uint32_t e = 0; e < 12; e++) {
+    const uint32_t p = pairs[e];
+
+    REQUIRE(p != TestIndexedMesh<T>::NoIndex);
+    REQUIRE(pairs[p] == e);
+    REQUIRE(mesh.getEdgeFaces()[p] != mesh.getEdgeFaces()[e]);
+    REQUIRE(mesh.getEdgeVertices()[p] == mesh.getEdgeVertices()[mesh.getEdgeNextEdges()[e]]);
+  }
+
+  REQUIRE(mesh.getFaceVertices(3).size() == 3);
+
+  REQUIRE_THAT(mesh.getFaceNormals()[0][2], withinAbsT(T(-1.0), exactMargin<T>()));
+  REQUIRE_THAT(mesh.getFaceAreas()[0], withinAbsT(T(0.5), exactMargin<T>()));
+  REQUIRE_THAT(mesh.getFaceCentroids()[0][0], withinAbsT(T(1.0 / 3.0), exactMargin<T>()));
+
+  requireSameMesh(*buildTetrahedron<T>(), mesh);
+
+  REQUIRE(mesh.signedDistance(Vec3T<T>(0.25, 0.25, 0.25)) < T(0.0));
+  REQUIRE(mesh.signedDistance(Vec3T<T>(2.0, 2.0, 2.0)) > T(0.0));
+  REQUIRE_THAT(mesh.signedDistance(Vec3T<T>(0.0, 0.0, -2.0)), withinAbsT(T(2.0), exactMargin<T>()));
+
+  mesh.flip();
+
+  REQUIRE(mesh.signedDistance(Vec3T<T>(0.25, 0.25, 0.25)) > T(0.0));
+  REQUIRE_THAT(mesh.getFaceNormals()[0][2], withinAbsT(T(1.0), exactMargin<T>()));
+}
+
+TEMPLATE_TEST_CASE("IndexedMeshT: an open mesh leaves boundary half-edges unpaired",
+                   "[DCEL][IndexedMesh]",
+                   EBGEOMETRY_TEST_PRECISIONS)
+{
+  using T = TestType;
+
+  // Two triangles sharing the diagonal of the unit square.
+  const std::vector<Vec3T<T>>            verts  = {{0.0, 0.0, 0.0}, {1.0, 0.0, 0.0}, {1.0, 1.0, 0.0}, {0.0, 1.0, 0.0}};
+  const std::vector<std::vector<size_t>> facets = {{0, 1, 2}, {0, 2, 3}};
+
+  TestIndexedMesh<T> mesh(verts, facets);
+  mesh.reconcile();
+
+  size_t numUnpaired = 0;
+  for (const uint32_t p : mesh.getEdgePairEdges()) {
+    numUnpaired += (p == TestIndexedMesh<T>::NoIndex) ? 1 : 0;
+  }
+
+  REQUIRE(numUnpaired == 4);
+
+  // Boundary edges take the normal of their face.
+  for (const auto& n : mesh.getEdgeNormals()) {
+    REQUIRE_THAT(n[2], withinAbsT(T(1.0), exactMargin<T>()));
+  }
+
+  REQUIRE_THAT(mesh.unsignedDistance2(Vec3T<T>(0.5, 0.25, 0.5)), withinAbsT(T(0.25), exactMargin<T>()));
+}
+
+TEMPLATE_TEST_CASE("IndexedMeshT: matches MeshT on the data files", "[DCEL][IndexedMesh]", EBGEOMETRY_TEST_PRECISIONS)
+{
+  using T = TestType;
+
+  const std::vector<std::string> files = {"dodecahedron.obj",
+                                          "dodecahedron.ply",
+                                          "dodecahedron.stl",
+                                          "dodecahedron.vtk",
+                                          "tetrahedron.stl"};
+
+  for (const auto& file : files) {
+    CAPTURE(file);
+
+    const auto mesh    = Parser::readIntoDCEL<T>(g_dataDir + "/" + file);
+    const auto indexed = Parser::readIntoIndexedDCEL<T>(g_dataDir + "/" + file);
+
+    REQUIRE(mesh != nullptr);
+    REQUIRE(indexed != nullptr);
+
+    requireSameMesh(*mesh, *indexed);
+
+    // The linked mesh rebuilt from the arrays is the same mesh again.
+    requireSameMesh(*indexed->toMesh(), *indexed);
+
+    for (const auto algorithm : {TestMesh<T>::SearchAlgorithm::Direct, TestMesh<T>::SearchAlgorithm::Direct2}) {
+      for (int i = -3; i <= 3; i++) {
+        const Vec3T<T> x(T(0.4) * T(i), T(0.3) * T(i) + T(0.1), T(0.2) - T(0.5) * T(i));
+
+        REQUIRE_THAT(indexed->signedDistance(x, algorithm),
+                     withinAbsT(mesh->signedDistance(x, algorithm), formulaMargin<T>()));
+      }
+    }
+
+    const Vec3T<T> x(T(0.7), T(-0.2), T(1.3));
+    REQUIRE_THAT(indexed->unsignedDistance2(x), withinAbsT(mesh->unsignedDistance2(x), formulaMargin<T>()));
+  }
+}
+
+TEMPLATE_TEST_CASE("IndexedMeshT: TriMeshSDF and MeshSDF built from the arrays",
+                   "[DCEL][IndexedMesh]",
+                   EBGEOMETRY_TEST_PRECISIONS)
+{
+  using T = TestType;
+
+  const std::string path    = g_dataDir + "/dodecahedron.stl";
+  const auto        mesh    = Parser::readIntoDCEL<T>(path);
+  const auto        indexed = Parser::readIntoIndexedDCEL<T>(path);
+
+  const TriMeshSDF<T, DefaultMetaData, 4, 4> fromMesh(mesh, BVH::Build::SAH, 1);
+  const TriMeshSDF<T, DefaultMetaData, 4, 4> fromIndexed(indexed, BVH::Build::SAH, 1);
+  const TestMeshSDF<T>                       meshSDF(indexed, BVH::Build::SAH);
+
+  for (int i = -4; i <= 4; i++) {
+    const Vec3T<T> x(T(0.3) * T(i), T(0.1) - T(0.2) * T(i), T(0.25) * T(i));
+
+    REQUIRE_THAT(fromIndexed.signedDistance(x), withinAbsT(fromMesh.signedDistance(x), exactMargin<T>()));
+    REQUIRE_THAT(meshSDF.signedDistance(x), withinAbsT(fromMesh.signedDistance(x), traversalMargin<T>()));
+  }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Soup::soupToTriangles (soup -> triangles without a DCEL)
+// ─────────────────────────────────────────────────────────────────────────────
+
+TEMPLATE_TEST_CASE("Soup::soupToTriangles matches the DCEL pseudonormals", "[DCEL][Soup]", EBGEOMETRY_TEST_PRECISIONS)
+{
+  using T = TestType;
+
+  const auto requireSameVec = [](const Vec3T<T>& a_actual, const Vec3T<T>& a_expected) {
+    for (size_t dir = 0; dir < 3; dir++) {
+      REQUIRE_THAT(a_actual[dir], withinAbsT(a_expected[dir], exactMargin<T>()));
+    }
+  };
+
+  for (const std::string file : {"dodecahedron.stl", "tetrahedron.stl"}) {
+    CAPTURE(file);
+
+    const auto mesh      = Parser::readIntoDCEL<T>(g_dataDir + "/" + file);
+    const auto triangles = Parser::readIntoTriangles<T, DefaultMetaData>(g_dataDir + "/" + file);
+
+    REQUIRE(triangles.size() == mesh->getFaces().size());
+
+    // All triangles share one block.
+    REQUIRE(static_cast<size_t>(triangles.front().use_count()) == triangles.size());
+
+    for (size_t f = 0; f < triangles.size(); f++) {
+      const auto& face     = mesh->getFaces()[f];
+      const auto  vertices = face->gatherVertices();
+      const auto  edges    = face->gatherEdges();
+
+      requireSameVec(triangles[f]->getNormal(), face->getNormal());
+
+      for (size_t i = 0; i < 3; i++) {
+        REQUIRE(triangles[f]->getVertexPositions()[i] == vertices[i]->getPosition());
+        requireSameVec(triangles[f]->getVertexNormals()[i], vertices[i]->getNormal());
+        requireSameVec(triangles[f]->getEdgeNormals()[i], edges[i]->getNormal());
+      }
+    }
+  }
+}
+
+TEMPLATE_TEST_CASE("Soup::soupToTriangles fan-triangulates polygons", "[DCEL][Soup]", EBGEOMETRY_TEST_PRECISIONS)
+{
+  using T = TestType;
+
+  // Unit cube from six outward-facing quads.
+  std::vector<Vec3T<T>> verts = {{0.0, 0.0, 0.0},
+                                 {1.0, 0.0, 0.0},
+                                 {1.0, 1.0, 0.0},
+                                 {0.0, 1.0, 0.0},
+                                 {0.0, 0.0, 1.0},
+                                 {1.0, 0.0, 1.0},
+                                 {1.0, 1.0, 1.0},
+                                 {0.0, 1.0, 1.0}};
+
+  std::vector<std::vector<size_t>> facets = {
+    {0, 3, 2, 1}, {4, 5, 6, 7}, {0, 1, 5, 4}, {2, 3, 7, 6}, {0, 4, 7, 3}, {1, 2, 6, 5}};
+
+  Soup::compress(verts, facets);
+
+  std::vector<Triangle<T, DefaultMetaData>> triangles;
+  Soup::soupToTriangles(triangles, verts, facets, "cube");
+
+  REQUIRE(triangles.size() == 12);
+
+  auto mesh = std::make_shared<TestMesh<T>>();
+  Soup::soupToDCEL(*mesh, verts, facets, "cube");
+
+  // The two half-edges of each quad diagonal are flat; the cube edges bisect their two faces. The corner angles
+  // of the fan add up to those of the quad, so every vertex normal points along a cube diagonal.
+  const T invSqrt3 = T(1.0) / std::sqrt(T(3.0));
+
+  size_t numFlat = 0;
+  for (const auto& tri : triangles) {
+    for (size_t i = 0; i < 3; i++) {
+      const T cosine = tri.getEdgeNormals()[i].dot(tri.getNormal());
+
+      if (std::abs(cosine - T(1.0)) < T(exactMargin<T>())) {
+        numFlat++;
+      }
+      else {
+        REQUIRE_THAT(cosine, withinAbsT(std::sqrt(T(0.5)), exactMargin<T>()));
+      }
+
+      for (size_t dir = 0; dir < 3; dir++) {
+        REQUIRE_THAT(std::abs(tri.getVertexNormals()[i][dir]), withinAbsT(invSqrt3, exactMargin<T>()));
+      }
+    }
+  }
+
+  REQUIRE(numFlat == 12);
+
+  for (int i = -3; i <= 3; i++) {
+    const Vec3T<T> x(T(0.5) + T(0.4) * T(i), T(0.2) * T(i), T(0.5) - T(0.3) * T(i));
+
+    T minDist = std::numeric_limits<T>::max();
+    for (const auto& tri : triangles) {
+      const T d = tri.signedDistance(x);
+
+      minDist = (std::abs(d) < std::abs(minDist)) ? d : minDist;
+    }
+
+    REQUIRE_THAT(minDist, withinAbsT(mesh->signedDistance(x), formulaMargin<T>()));
+  }
+}
@@ -0,0 +1,190 @@
+// SPDX-FileCopyrightText: 2026 Robert Marskar <robert.marskar@sintef.no>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Test suite for DeformingBVH: rigid motions must only refit, a scrambled geometry must trigger a rebuild, and the
+// managed tree must answer nearest-neighbor queries like a brute-force scan after every update, in place or with
+// the rebuild running in the background.
+
+#include "EBGeometry.hpp"
+#include "TestFloatingPointUtils.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_template_test_macros.hpp>
+
+using namespace EBGeometry;
+
+namespace {
+
+template <class T>
+struct MovingPoint
+{
+  Vec3T<T> m_pos;
+};
+
+// Restores the global pool size on scope exit.
+class ScopedThreads
+{
+public:
+  explicit ScopedThreads(unsigned a_numThreads) : m_numThreads(Parallel::getNumThreads())
+  {
+    Parallel::setNumThreads(a_numThreads);
+  }
+
+  ~ScopedThreads()
+  {
+    Parallel::setNumThreads(m_numThreads);
+  }
+
+  ScopedThreads(const ScopedThreads&) = delete;
+  ScopedThreads&
+  operator=(const ScopedThreads&) = delete;
+
+private:
+  unsigned m_numThreads;
+};
+
+} // namespace
+
+TEMPLATE_TEST_CASE("DeformingBVH: refits rigid motions and rebuilds once the geometry is scrambled",
+                   "[BVH][DeformingBVH]",
+                   EBGEOMETRY_TEST_PRECISIONS)
+{
+  using T         = TestType;
+  using Vec3      = Vec3T<T>;
+  using Pnt       = MovingPoint<T>;
+  using Deforming = BVH::DeformingBVH<T, Pnt, 4>;
+  using Tree      = typename Deforming::Tree;
+  using AABB      = typename Deforming::BV;
+
+  std::mt19937                      rng(7u);
+  std::uniform_real_distribution<T> uniform(T(0), T(1));
+
+  std::vector<std::shared_ptr<Pnt>>       handles;
+  std::vector<std::shared_ptr<const Pnt>> primitives;
+  for (int i = 0; i < 2000; i++) {
+    handles.emplace_back(std::make_shared<Pnt>(Pnt{Vec3(uniform(rng), uniform(rng), uniform(rng))}));
+    primitives.emplace_back(handles.back());
+  }
+
+  const auto bvConstructor = [](const Pnt& a_p) noexcept -> AABB { return AABB(a_p.m_pos, a_p.m_pos); };
+
+  const auto nearest2 = [](const Tree& a_tree, const Vec3& a_query) {
+    T nearest = std::numeric_limits<T>::max();
+    a_tree.pruneTraverse(
+      a_query,
+      nearest,
+      [&prims = a_tree.getPrimitives(), &a_query](T& a_state, size_t a_offset, size_t a_count) noexcept {
+        for (size_t i = a_offset; i < a_offset + a_count; i++) {
+          a_state = std::min(a_state, (prims[i]->m_pos - a_query).length2());
+        }
+      },
+      [](const T& a_state) noexcept -> T { return a_state; });
+
+    return nearest;
+  };
+
+  const auto check = [&](const Tree& a_tree) {
+    for (int q = 0; q < 50; q++) {
+      const Vec3 query(T(2) * uniform(rng) - T(0.5), T(2) * uniform(rng) - T(0.5), T(2) * uniform(rng) - T(0.5));
+
+      T brute = std::numeric_limits<T>::max();
+      for (const auto& h : handles) {
+        brute = std::min(brute, (h->m_pos - query).length2());
+      }
+
+      CHECK(nearest2(a_tree, query) == brute);
+    }
+  };
+
+  // Swap the positions of random pairs of points, which keeps the cloud but tangles the tree.
+  const auto scramble = [&]() {
+    std::uniform_int_distribution<size_t> index(0, handles.size() - 1);
+
+    for (size_t i = 0; i < handles.size(); i++) {
+      std::swap(handles[i]->m_pos, handles[index(rng)]->m_pos);
+    }
+  };
+
+  SECTION("In-place rebuilds")
+  {
+    Deforming deforming(primitives, bvConstructor);
+
+    REQUIRE(deforming.getTree() != nullptr);
+    CHECK(deforming.getCostRatio() == 1.0);
+
+    // Translations and uniform scaling leave the normalized SAH cost as it was.
+    for (int step = 0; step < 5; step++) {
+      for (auto& h : handles) {
+        h->m_pos = T(1.1) * h->m_pos + Vec3(T(0.1), T(0), -T(0.2));
+      }
+
+      CHECK_FALSE(deforming.update());
+      CHECK(std::abs(deforming.getCostRatio() - 1.0) < 1.E-3);
+    }
+
+    check(*deforming.getTree());
+    CHECK(deforming.getNumRebuilds() == 0);
+
+    const std::shared_ptr<const Tree> before = deforming.getTree();
+
+    scramble();
+
+    CHECK(deforming.update());
+    CHECK(deforming.getNumRebuilds() == 1);
+    CHECK(deforming.getCostRatio() == 1.0);
+    CHECK(deforming.getTree() != before);
+
+    check(*deforming.getTree());
+
+    CHECK_FALSE(deforming.update());
+    CHECK(deforming.getCostRatio() < BVH::RebuildThreshold);
+  }
+
+  SECTION("Background rebuilds")
+  {
+    // The rebuild runs on a thread of its own, not on the pool, so it is backgrounded even with a pool of one.
+    const ScopedThreads threads(1);
+
+    Deforming deforming(primitives, bvConstructor, BVH::RebuildThreshold, true);
+
+    const std::shared_ptr<const Tree> before = deforming.getTree();
+
+    scramble();
+
+#if defined(EBGEOMETRY_ENABLE_THREADS)
+    // The refitted tree answers queries while the new one is built.
+    CHECK_FALSE(deforming.update());
+    CHECK(deforming.isRebuilding());
+    CHECK(deforming.getTree() == before);
+    CHECK(deforming.getCostRatio() > BVH::RebuildThreshold);
+
+    check(*deforming.getTree());
+
+    // The geometry moves on before the new tree is swapped in.
+    for (auto& h : handles) {
+      h->m_pos += Vec3(T(0.5), T(0.5), T(0.5));
+    }
+
+    CHECK(deforming.finishRebuild());
+#else
+    CHECK(deforming.update());
+#endif
+
+    CHECK_FALSE(deforming.isRebuilding());
+    CHECK_FALSE(deforming.finishRebuild());
+    CHECK(deforming.getNumRebuilds() == 1);
+    CHECK(deforming.getTree() != before);
+
+    check(*deforming.getTree());
+
+    // A tree taken before the swap stays alive.
+    CHECK(before->getPrimitives().size() == handles.size());
+  }
+}
@@ -0,0 +1,168 @@
+// SPDX-FileCopyrightText: 2026 Robert Marskar <robert.marskar@sintef.no>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Test suite for InstanceTransform and InstancedSDF: the transform must be a similarity with an exact inverse, and
+// the two-level traversal must give the distances of a brute-force loop over every instance.
+
+#include "EBGeometry.hpp"
+#include "TestFloatingPointUtils.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+using namespace EBGeometry;
+
+namespace {
+
+using Meta = DCEL::DefaultMetaData;
+
+} // namespace
+
+TEMPLATE_TEST_CASE("InstanceTransform: rotation, scale and translation, and their inverse",
+                   "[InstancedSDF]",
+                   EBGEOMETRY_TEST_PRECISIONS)
+{
+  using T    = TestType;
+  using AABB = BoundingVolumes::AABBT<T>;
+
+  SECTION("The default transform is the identity")
+  {
+    const InstanceTransform<T> identity;
+    const Vec3T<T>             p(T(1), -T(2), T(3));
+
+    CHECK(identity.toWorld(p) == p);
+    CHECK(identity.toLocal(p) == p);
+    CHECK(identity.getScale() == T(1));
+  }
+  SECTION("A quarter turn about z maps x to y")
+  {
+    const InstanceTransform<T> transform(Vec3T<T>(T(10), T(0), T(0)), Vec3T<T>::unit(2), T(90), T(2));
+    const Vec3T<T>             x = transform.toWorld(Vec3T<T>::unit(0));
+
+    CHECK_THAT(x[0], withinAbsT<T>(T(10), looseMargin<T>()));
+    CHECK_THAT(x[1], withinAbsT<T>(T(2), looseMargin<T>()));
+    CHECK_THAT(x[2], withinAbsT<T>(T(0), looseMargin<T>()));
+  }
+  SECTION("toLocal inverts toWorld, and world distances are local distances times the scale")
+  {
+    const InstanceTransform<T> transform(Vec3T<T>(T(1), T(2), -T(3)), Vec3T<T>(T(1), T(1), T(0)), T(37), T(1.5));
+
+    const Vec3T<T> a(T(0.3), -T(0.7), T(1.1));
+    const Vec3T<T> b(-T(2), T(0.5), T(0.25));
+
+    const Vec3T<T> roundTrip = transform.toLocal(transform.toWorld(a));
+    for (std::size_t dir = 0; dir < 3; dir++) {
+      CHECK_THAT(roundTrip[dir], withinAbsT<T>(a[dir], looseMargin<T>()));
+    }
+
+    const T worldDist = (transform.toWorld(a) - transform.toWorld(b)).length();
+    CHECK_THAT(worldDist, withinAbsT<T>(T(1.5) * (a - b).length(), looseMargin<T>()));
+  }
+  SECTION("The world box encloses every transformed corner")
+  {
+    const InstanceTransform<T> transform(Vec3T<T>(T(5), T(0), T(0)), Vec3T<T>(T(0), T(1), T(1)), T(60), T(0.5));
+    const AABB                 local(-Vec3T<T>::ones(), Vec3T<T>(T(2), T(1), T(3)));
+    const AABB                 world = transform.toWorld(local);
+
+    for (int i = 0; i < 8; i++) {
+      const Vec3T<T> corner((i & 1) != 0 ? T(2) : -T(1), (i & 2) != 0 ? T(1) : -T(1), (i & 4) != 0 ? T(3) : -T(1));
+      const Vec3T<T> x = transform.toWorld(corner);
+
+      CHECK(x >= world.getLowCorner());
+      CHECK(x <= world.getHighCorner());
+    }
+  }
+}
+
+TEMPLATE_TEST_CASE("InstancedSDF: two-level queries match a brute-force loop over the instances",
+                   "[InstancedSDF][TriMesh]",
+                   EBGEOMETRY_TEST_PRECISIONS)
+{
+  using T = TestType;
+
+  using Mesh      = TriMeshSDF<T, Meta, 4, 4>;
+  using Instanced = InstancedSDF<T, Mesh, 4>;
+  using Instance  = typename Instanced::Instance;
+
+  const auto dcel = Parser::readIntoDCEL<T, Meta>(std::string(EBGEOMETRY_TEST_DATA_DIR) + "/dodecahedron.stl");
+  REQUIRE(dcel != nullptr);
+
+  const auto mesh = std::make_shared<const Mesh>(dcel, BVH::Build::SAH, 1);
+
+  const BoundingVolumes::AABBT<T> meshBox = mesh->computeBoundingVolume();
+  const T                         size    = (meshBox.getHighCorner() - meshBox.getLowCorner()).length();
+
+  // A 6x4x3 grid of copies with random orientations and scales, far enough apart that none of them overlap.
+  std::mt19937                      rng(42u);
+  std::uniform_real_distribution<T> uniform(T(0), T(1));
+
+  std::vector<Instance> instances;
+  for (int i = 0; i < 6; i++) {
+    for (int j = 0; j < 4; j++) {
+      for (int k = 0; k < 3; k++) {
+        const Vec3T<T> translation = T(2) * size * Vec3T<T>(T(i), T(j), T(k));
+        const Vec3T<T> axis(uniform(rng) - T(0.5), uniform(rng) - T(0.5), uniform(rng) + T(0.1));
+        const T        angle = T(360) * uniform(rng);
+        const T        scale = T(0.5) + uniform(rng);
+
+        instances.emplace_back(Instance{mesh, InstanceTransform<T>(translation, axis, angle, scale)});
+      }
+    }
+  }
+
+  const Instanced instanced(instances);
+
+  REQUIRE(instanced.getRoot()->computeMetrics().numLeaves > 1);
+
+  const BoundingVolumes::AABBT<T> sceneBox = instanced.computeBoundingVolume();
+  for (const Instance& instance : instances) {
+    const BoundingVolumes::AABBT<T> box = instance.transform.toWorld(meshBox);
+
+    CHECK(box.getLowCorner() >= sceneBox.getLowCorner());
+    CHECK(box.getHighCorner() <= sceneBox.getHighCorner());
+  }
+
+  // Query points across the scene, a margin beyond it, and at the centres of a few instances (inside).
+  const Vec3T<T> lo = sceneBox.getLowCorner() - size * Vec3T<T>::ones();
+  const Vec3T<T> hi = sceneBox.getHighCorner() + size * Vec3T<T>::ones();
+
+  std::vector<Vec3T<T>> queries;
+  for (int q = 0; q < 300; q++) {
+    queries.emplace_back(lo + Vec3T<T>(uniform(rng), uniform(rng), uniform(rng)) * (hi - lo));
+  }
+  for (std::size_t i = 0; i < instances.size(); i += 5) {
+    queries.emplace_back(instances[i].transform.toWorld(meshBox.getCentroid()));
+  }
+
+  for (const Vec3T<T>& q : queries) {
+    T bruteForce = std::numeric_limits<T>::max();
+    for (const Instance& instance : instances) {
+      const T d = instance.transform.getScale() * instance.mesh->signedDistance(instance.transform.toLocal(q));
+
+      if (std::abs(d) < std::abs(bruteForce)) {
+        bruteForce = d;
+      }
+    }
+
+    CHECK_THAT(instanced.signedDistance(q), withinAbsT<T>(bruteForce, looseMargin<T>()));
+  }
+
+  SECTION("boundedSignedDistance agrees with signedDistance below the bound, and reports the bound above it")
+  {
+    for (const Vec3T<T>& q : queries) {
+      const Vec3T<T> y = instances[0].transform.toLocal(q);
+      const T        d = mesh->signedDistance(y);
+
+      CHECK(mesh->boundedSignedDistance(y, std::abs(d) * T(2)) == d);
+      CHECK(mesh->boundedSignedDistance(y, std::abs(d) * T(0.5)) == std::abs(d) * T(0.5));
+    }
+  }
+}
@@ -0,0 +1,661 @@
+// SPDX-FileCopyrightText: 2026 Robert Marskar <robert.marskar@sintef.no>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Test suite for EBGeometry_Parallel.hpp: the thread pool, parallelFor() and TaskGroup themselves, and the bulk
+// queries and builders that run on them. Every parallel result is compared exactly against the same computation
+// run on a single thread, so these tests also pass (trivially) when EBGEOMETRY_ENABLE_THREADS is not defined.
+
+#include "EBGeometry.hpp"
+#include "TestFloatingPointUtils.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+using namespace EBGeometry;
+
+namespace {
+
+// Restores the global pool size and deterministic mode on scope exit, so one test cannot leak its settings into
+// the next.
+class ScopedThreads
+{
+public:
+  explicit ScopedThreads(unsigned a_numThreads, bool a_deterministic = false)
+    : m_numThreads(Parallel::getNumThreads()), m_deterministic(Parallel::isDeterministic())
+  {
+    Parallel::setNumThreads(a_numThreads);
+    Parallel::setDeterministic(a_deterministic);
+  }
+
+  ~ScopedThreads()
+  {
+    Parallel::setNumThreads(m_numThreads);
+    Parallel::setDeterministic(m_deterministic);
+  }
+
+  ScopedThreads(const ScopedThreads&) = delete;
+  ScopedThreads&
+  operator=(const ScopedThreads&) = delete;
+
+private:
+  unsigned m_numThreads;
+  bool     m_deterministic;
+};
+
+// A fixed, reproducible random cloud of n points in the unit cube.
+template <class T>
+std::vector<Vec3T<T>>
+makeCloud(std::size_t a_n, unsigned a_seed)
+{
+  std::mt19937                      rng(a_seed);
+  std::uniform_real_distribution<T> dist(T(0), T(1));
+  std::vector<Vec3T<T>>             pos(a_n);
+  for (std::size_t i = 0; i < a_n; i++) {
+    pos[i] = Vec3T<T>(dist(rng), dist(rng), dist(rng));
+  }
+  return pos;
+}
+
+template <class T>
+struct BarePoint
+{
+  Vec3T<T> m_pos;
+};
+
+} // namespace
+
+TEST_CASE("Parallel::setNumThreads: the pool reports the requested size", "[Parallel]")
+{
+  ScopedThreads threads(3);
+
+#if defined(EBGEOMETRY_ENABLE_THREADS)
+  CHECK(Parallel::getNumThreads() == 3);
+
+  Parallel::setNumThreads(1);
+  CHECK(Parallel::getNumThreads() == 1);
+
+  Parallel::setNumThreads(0);
+  CHECK(Parallel::getNumThreads() >= 1);
+#else
+  CHECK(Parallel::getNumThreads() == 1);
+#endif
+
+  // Lookups from the workers see the replaced pool, not the one it replaced.
+  std::array<const Parallel::ThreadPool*, 64> seen{};
+
+  Parallel::parallelFor(0, seen.size(), 1, [&seen](std::size_t a_lo, std::size_t a_hi) {
+    for (std::size_t i = a_lo; i < a_hi; i++) {
+      seen[i] = &Parallel::getThreadPool();
+    }
+  });
+
+  for (const Parallel::ThreadPool* pool : seen) {
+    CHECK(pool == &Parallel::getThreadPool());
+  }
+}
+
+TEST_CASE("Parallel::parallelFor: every index is visited exactly once, in chunks of at least the grain size",
+          "[Parallel]")
+{
+  for (const unsigned numThreads : {1U, 2U, 4U}) {
+    for (const bool deterministic : {false, true}) {
+      ScopedThreads threads(numThreads, deterministic);
+
+      INFO("threads = " << numThreads << ", deterministic = " << deterministic);
+
+      constexpr std::size_t begin = 7;
+      constexpr std::size_t end   = 10007;
+      constexpr std::size_t grain = 64;
+
+      std::vector<std::atomic<int>> visits(end);
+      std::atomic<std::size_t>      shortChunks{0};
+      std::atomic<std::size_t>      misalignedChunks{0};
+
+      // Catch2 assertions are not thread-safe, so the body only counts and the checks happen afterwards.
+      Parallel::parallelFor(begin, end, grain, [&](std::size_t a_lo, std::size_t a_hi) {
+        if (a_hi - a_lo < grain) {
+          shortChunks++;
+        }
+        if ((a_lo - begin) % grain != 0) {
+          misalignedChunks++;
+        }
+        for (std::size_t i = a_lo; i < a_hi; i++) {
+          visits[i]++;
+        }
+      });
+
+      for (std::size_t i = 0; i < end; i++) {
+        REQUIRE(visits[i].load() == (i >= begin ? 1 : 0));
+      }
+
+      // Only the last chunk may be short. In deterministic mode chunks are exactly grain-sized, so they all start
+      // on a multiple of the grain size.
+      CHECK(shortChunks.load() <= 1);
+      if (deterministic) {
+        CHECK(misalignedChunks.load() == 0);
+      }
+    }
+  }
+}
+
+TEST_CASE("Parallel::parallelFor: empty ranges never call the body and exceptions reach the caller", "[Parallel]")
+{
+  ScopedThreads threads(4);
+
+  bool called = false;
+  Parallel::parallelFor(5, 5, 1, [&](std::size_t, std::size_t) { called = true; });
+  Parallel::parallelFor(5, 3, 1, [&](std::size_t, std::size_t) { called = true; });
+  CHECK_FALSE(called);
+
+  CHECK_THROWS_AS(Parallel::parallelFor(0,
+                                        1000,
+                                        1,
+                                        [](std::size_t a_lo, std::size_t a_hi) {
+                                          if (a_lo <= 500 && 500 < a_hi) {
+                                            throw std::runtime_error("chunk failed");
+                                          }
+                                        }),
+                  std::runtime_error);
+
+  // The pool is still usable afterwards.
+  std::atomic<std::size_t> sum{0};
+  Parallel::parallelFor(0, 100, 1, [&](std::size_t a_lo, std::size_t a_hi) {
+    for (std::size_t i = a_lo; i < a_hi; i++) {
+      sum += i;
+    }
+  });
+  CHECK(sum.load() == 4950);
+}
+
+TEST_CASE("Parallel::TaskGroup: nested groups complete and the first exception is rethrown from wait()",
+          "[Parallel]")
+{
+  ScopedThreads threads(4);
+
+  SECTION("recursive fork-join (tasks that spawn and wait on tasks) does not deadlock")
+  {
+    std::atomic<std::size_t> leaves{0};
+
+    std::function<void(int)> fork = [&](int a_depth) {
+      if (a_depth == 0) {
+        leaves++;
+        return;
+      }
+
+      Parallel::TaskGroup group;
+      for (int i = 0; i < 3; i++) {
+        group.run([&fork, a_depth] { fork(a_depth - 1); });
+      }
+      group.wait();
+    };
+
+    fork(6);
+
+    CHECK(leaves.load() == 729);
+  }
+
+  SECTION("exceptions")
+  {
+    Parallel::TaskGroup group;
+
+    std::atomic<int> ran{0};
+    for (int i = 0; i < 16; i++) {
+      group.run([&ran, i] {
+        ran++;
+        if (i == 5) {
+          throw std::runtime_error("task failed");
+        }
+      });
+    }
+
+    CHECK_THROWS_AS(group.wait(), std::runtime_error);
+    CHECK(ran.load() == 16);
+
+    // A second wait() has nothing left to report.
+    CHECK_NOTHROW(group.wait());
+  }
+}
+
+TEST_CASE("Parallel::TaskGroup: a group outlives setNumThreads() and keeps running on its own pool", "[Parallel]")
+{
+  ScopedThreads threads(3);
+
+  std::atomic<int> ran{0};
+
+  Parallel::TaskGroup group;
+
+  group.run([&ran] { ran++; });
+  group.wait();
+
+  // The group's pool is retired here, but must stay alive (and keep its workers) for as long as the group does.
+  Parallel::setNumThreads(2);
+
+  for (int i = 0; i < 64; i++) {
+    group.run([&ran] { ran++; });
+  }
+  group.wait();
+
+  CHECK(ran.load() == 65);
+
+#if defined(EBGEOMETRY_ENABLE_THREADS)
+  CHECK(Parallel::getNumThreads() == 2);
+#endif
+}
+
+TEMPLATE_TEST_CASE("ImplicitFunction::parallelValues matches values() for any thread count",
+                   "[Parallel][ImplicitFunction]",
+                   EBGEOMETRY_TEST_PRECISIONS)
+{
+  using T = TestType;
+
+  const auto points = makeCloud<T>(10000, 7);
+
+  const auto sphere = std::make_shared<SphereSDF<T>>(Vec3T<T>(T(0.5), T(0.5), T(0.5)), T(0.3));
+  const auto box    = std::make_shared<BoxSDF<T>>(Vec3T<T>(T(0.1), T(0.2), T(0.3)), Vec3T<T>(T(0.6), T(0.7), T(0.8)));
+  const auto csg    = Union<T>(sphere, box);
+
+  std::vector<T> expected(points.size());
+  csg->values(points.data(), expected.data(), points.size());
+
+  for (const unsigned numThreads : {1U, 3U}) {
+    ScopedThreads threads(numThreads);
+
+    std::vector<T> actual(points.size(), T(-1));
+    csg->parallelValues(points.data(), actual.data(), points.size());
+
+    INFO("threads = " << numThreads);
+    REQUIRE(actual == expected);
+  }
+}
+
+TEMPLATE_TEST_CASE("PointCloudBVH/PointCloudHashGrid::allNearestNeighbors: results do not depend on the thread "
+                   "count",
+                   "[Parallel][PointCloudBVH][PointCloudHashGrid]",
+                   EBGEOMETRY_TEST_PRECISIONS)
+{
+  using T = TestType;
+
+  const auto                     pos = makeCloud<T>(5000, 11);
+  const std::vector<std::size_t> meta(pos.size(), 0);
+
+  const PointCloudBVH<T, std::size_t>      bvh(pos, meta);
+  const PointCloudHashGrid<T, std::size_t> grid(pos, meta);
+
+  for (const std::size_t k : {std::size_t(1), std::size_t(4)}) {
+    INFO("k = " << k);
+
+    std::vector<typename PointCloudBVH<T, std::size_t>::Hit>      bvhSerial;
+    std::vector<typename PointCloudHashGrid<T, std::size_t>::Hit> gridSerial;
+    {
+      ScopedThreads threads(1);
+
+      bvhSerial  = bvh.allNearestNeighbors(k);
+      gridSerial = grid.allNearestNeighbors(k);
+    }
+
+    ScopedThreads threads(4);
+
+    const auto bvhParallel  = bvh.allNearestNeighbors(k);
+    const auto gridParallel = grid.allNearestNeighbors(k);
+
+    REQUIRE(bvhParallel.size() == bvhSerial.size());
+    REQUIRE(gridParallel.size() == gridSerial.size());
+
+    for (std::size_t i = 0; i < bvhSerial.size(); i++) {
+      REQUIRE(bvhParallel[i].index == bvhSerial[i].index);
+      REQUIRE(bvhParallel[i].distanceSquared == bvhSerial[i].distanceSquared);
+      REQUIRE(gridParallel[i].index == gridSerial[i].index);
+      REQUIRE(gridParallel[i].distanceSquared == gridSerial[i].distanceSquared);
+    }
+  }
+}
+
+TEMPLATE_TEST_CASE("TreeBVH::topDownSortAndPartition builds the same tree on one thread and on many",
+                   "[Parallel][BVH]",
+                   EBGEOMETRY_TEST_PRECISIONS)
+{
+  using T    = TestType;
+  using AABB = BoundingVolumes::AABBT<T>;
+  using Pnt  = BarePoint<T>;
+
+  constexpr std::size_t K = 4;
+
+  // Large enough that several levels of the tree are above BVH::ParallelBuildThreshold.
+  const auto pos = makeCloud<T>(8 * BVH::ParallelBuildThreshold, 3);
+
+  const auto build = [&pos](unsigned a_numThreads) {
+    ScopedThreads threads(a_numThreads);
+
+    BVH::PrimAndBVList<Pnt, AABB> prims;
+    for (const auto& p : pos) {
+      prims.emplace_back(std::make_shared<Pnt>(Pnt{p}), AABB(p, p));
+    }
+
+    auto tree = std::make_shared<BVH::TreeBVH<T, Pnt, AABB, K>>(prims);
+    tree->topDownSortAndPartition(BVH::BinnedSAHPartitioner<T, Pnt, AABB, K>);
+
+    return tree->pack();
+  };
+
+  const auto serial   = build(1);
+  const auto parallel = build(4);
+
+  const auto& serialPrims   = serial->getPrimitives();
+  const auto& parallelPrims = parallel->getPrimitives();
+
+  REQUIRE(serialPrims.size() == pos.size());
+  REQUIRE(parallelPrims.size() == serialPrims.size());
+
+  // Packing walks the tree depth-first, so identical trees give identical primitive orders.
+  for (std::size_t i = 0; i < serialPrims.size(); i++) {
+    REQUIRE(parallelPrims[i]->m_pos == serialPrims[i]->m_pos);
+  }
+}
+
+TEMPLATE_TEST_CASE("TreeBVH::plocSortAndPartition builds the same tree on one thread and on many",
+                   "[Parallel][BVH][PLOC]",
+                   EBGEOMETRY_TEST_PRECISIONS)
+{
+  using T    = TestType;
+  using AABB = BoundingVolumes::AABBT<T>;
+  using Pnt  = BarePoint<T>;
+
+  constexpr std::size_t K = 4;
+
+  // Enough clusters that the first rounds are split over several chunks, and a collapse that forks subtrees.
+  const auto pos = makeCloud<T>(4 * BVH::ParallelBuildThreshold + 77, 11);
+
+  const auto build = [&pos](unsigned a_numThreads) {
+    ScopedThreads threads(a_numThreads);
+
+    BVH::PrimAndBVList<Pnt, AABB> prims;
+    for (const auto& p : pos) {
+      prims.emplace_back(std::make_shared<Pnt>(Pnt{p}), AABB(p, p));
+    }
+
+    auto tree = std::make_shared<BVH::TreeBVH<T, Pnt, AABB, K>>(prims);
+    tree->plocSortAndPartition();
+
+    return tree->pack();
+  };
+
+  const auto serial   = build(1);
+  const auto parallel = build(4);
+
+  const auto& serialPrims   = serial->getPrimitives();
+  const auto& parallelPrims = parallel->getPrimitives();
+
+  REQUIRE(serialPrims.size() == pos.size());
+  REQUIRE(parallelPrims.size() == serialPrims.size());
+
+  for (std::size_t i = 0; i < serialPrims.size(); i++) {
+    REQUIRE(parallelPrims[i]->m_pos == serialPrims[i]->m_pos);
+  }
+}
+
+TEMPLATE_TEST_CASE("TreeBVH::spatialSortAndPartition builds the same tree on one thread and on many",
+                   "[Parallel][BVH][SBVH]",
+                   EBGEOMETRY_TEST_PRECISIONS)
+{
+  using T    = TestType;
+  using Vec3 = Vec3T<T>;
+  using AABB = BoundingVolumes::AABBT<T>;
+  using Tri  = std::array<Vec3, 3>;
+
+  constexpr std::size_t K = 4;
+
+  // Long, thin triangles between random point pairs, enough of them that the upper levels are forked.
+  const auto from = makeCloud<T>(BVH::ParallelBuildThreshold + 500, 13);
+  const auto to   = makeCloud<T>(from.size(), 17);
+
+  std::vector<std::shared_ptr<const Tri>> tris;
+  for (std::size_t i = 0; i < from.size(); i++) {
+    tris.emplace_back(std::make_shared<const Tri>(Tri{from[i], to[i], from[i] + Vec3(0, 0, T(0.01))}));
+  }
+
+  const auto build = [&tris](unsigned a_numThreads) {
+    ScopedThreads threads(a_numThreads);
+
+    BVH::PrimAndBVList<Tri, AABB> prims;
+    for (const auto& tri : tris) {
+      prims.emplace_back(tri, AABB(std::vector<Vec3>(tri->begin(), tri->end())));
+    }
+
+    auto tree = std::make_shared<BVH::TreeBVH<T, Tri, AABB, K>>(prims);
+    tree->spatialSortAndPartition(
+      [](const Tri& a_tri, std::vector<Vec3>& a_vertices) { a_vertices.assign(a_tri.begin(), a_tri.end()); });
+
+    return tree->pack();
+  };
+
+  const auto serial   = build(1);
+  const auto parallel = build(4);
+
+  const auto& serialPrims   = serial->getPrimitives();
+  const auto& parallelPrims = parallel->getPrimitives();
+
+  REQUIRE(serialPrims.size() > tris.size());
+  REQUIRE(parallelPrims.size() == serialPrims.size());
+
+  for (std::size_t i = 0; i < serialPrims.size(); i++) {
+    REQUIRE(parallelPrims[i] == serialPrims[i]);
+  }
+}
+
+TEMPLATE_TEST_CASE("PackedBVH::optimize restructures the same tree on one thread and on many",
+                   "[Parallel][BVH][optimize]",
+                   EBGEOMETRY_TEST_PRECISIONS)
+{
+  using T    = TestType;
+  using AABB = BoundingVolumes::AABBT<T>;
+  using Pnt  = BarePoint<T>;
+
+  constexpr std::size_t K = 4;
+
+  using Packed = BVH::PackedBVH<T, Pnt, K>;
+  using Node   = typename Packed::NodeView;
+
+  // Enough nodes per level that the treelets of one depth are spread over several chunks.
+  const auto pos = makeCloud<T>(30000, 19);
+
+  BVH::PrimAndBVList<Pnt, AABB> prims;
+  for (const auto& p : pos) {
+    prims.emplace_back(std::make_shared<Pnt>(Pnt{p}), AABB(p, p));
+  }
+
+  auto tree = std::make_shared<BVH::TreeBVH<T, Pnt, AABB, K>>(prims);
+  tree->template bottomUpSortAndPartition<SFC::Morton>();
+
+  // Every node's box in depth-first order, which pins down the whole tree.
+  const auto optimized = [&tree](unsigned a_numThreads) {
+    ScopedThreads threads(a_numThreads);
+
+    const auto packed = tree->pack();
+    packed->optimize();
+
+    std::vector<AABB> boxes;
+    packed->template traverse<int>(
+      [](const std::shared_ptr<const Pnt>*, std::size_t, std::size_t) {},
+      [&boxes](const Node& a_node, const int&) {
+        boxes.emplace_back(a_node.getBoundingVolume());
+        return true;
+      },
+      [](std::array<std::pair<uint32_t, int>, K>&) {},
+      [](const Node&) { return 0; });
+
+    return boxes;
+  };
+
+  const auto serial   = optimized(1);
+  const auto parallel = optimized(4);
+
+  REQUIRE(parallel.size() == serial.size());
+
+  for (std::size_t i = 0; i < serial.size(); i++) {
+    REQUIRE(parallel[i].getLowCorner() == serial[i].getLowCorner());
+    REQUIRE(parallel[i].getHighCorner() == serial[i].getHighCorner());
+  }
+}
+
+TEMPLATE_TEST_CASE("PackedBVH::computeMetrics gives the same SAH cost and EPO on one thread and on many",
+                   "[Parallel][BVH][metrics]",
+                   EBGEOMETRY_TEST_PRECISIONS)
+{
+  using T    = TestType;
+  using AABB = BoundingVolumes::AABBT<T>;
+  using Pnt  = BarePoint<T>;
+
+  constexpr std::size_t K = 4;
+
+  const auto pos = makeCloud<T>(5000, 23);
+
+  BVH::PrimAndBVList<Pnt, AABB> prims;
+  for (const auto& p : pos) {
+    prims.emplace_back(std::make_shared<Pnt>(Pnt{p}), AABB(p, p));
+  }
+
+  auto tree = std::make_shared<BVH::TreeBVH<T, Pnt, AABB, K>>(prims);
+  tree->template bottomUpSortAndPartition<SFC::Morton>();
+
+  const auto packed = tree->pack();
+
+  const auto metrics = [&packed](unsigned a_numThreads) {
+    ScopedThreads threads(a_numThreads);
+
+    return packed->computeMetrics();
+  };
+
+  const BVH::TreeMetrics serial   = metrics(1);
+  const BVH::TreeMetrics parallel = metrics(4);
+
+  REQUIRE(serial.epo > 0.0);
+  REQUIRE(parallel.epo == serial.epo);
+  REQUIRE(parallel.sahCost == serial.sahCost);
+  REQUIRE(parallel.leafFill == serial.leafFill);
+}
+
+TEMPLATE_TEST_CASE("PackedBVH: the direct top-down SAH build is identical on one thread and on many",
+                   "[Parallel][BVH][DirectTopDownBuild]",
+                   EBGEOMETRY_TEST_PRECISIONS)
+{
+  using T    = TestType;
+  using AABB = BoundingVolumes::AABBT<T>;
+  using Pnt  = BarePoint<T>;
+
+  constexpr std::size_t K = 4;
+
+  // Large enough that the root split is binned in parallel (BVH::ParallelBinningThreshold) and several levels
+  // below it are forked (BVH::ParallelBuildThreshold).
+  const auto pos = makeCloud<T>(BVH::ParallelBinningThreshold + 1000, 5);
+
+  const auto build = [&pos](unsigned a_numThreads) {
+    ScopedThreads threads(a_numThreads);
+
+    std::vector<std::pair<Pnt, AABB>> prims;
+    for (const auto& p : pos) {
+      prims.emplace_back(Pnt{p}, AABB(p, p));
+    }
+
+    return BVH::PackedBVH<T, Pnt, K>(std::move(prims), BVH::BinnedSAHPartitioner<T, Pnt, AABB, K>);
+  };
+
+  const auto serial   = build(1);
+  const auto parallel = build(4);
+
+  const auto& serialPrims   = serial.getPrimitives();
+  const auto& parallelPrims = parallel.getPrimitives();
+
+  REQUIRE(serialPrims.size() == pos.size());
+  REQUIRE(parallelPrims.size() == serialPrims.size());
+
+  for (std::size_t i = 0; i < serialPrims.size(); i++) {
+    REQUIRE(parallelPrims[i]->m_pos == serialPrims[i]->m_pos);
+  }
+
+  // An unpruned traversal visits every leaf in an order fixed by the node array alone, so identical leaf
+  // sequences mean identical trees.
+  using Leaves = std::vector<std::pair<std::size_t, std::size_t>>;
+
+  const auto leafSequence = [](const BVH::PackedBVH<T, Pnt, K>& a_bvh, const Vec3T<T>& a_query) {
+    Leaves leaves;
+    a_bvh.pruneTraverse(
+      a_query,
+      leaves,
+      [](Leaves& a_leaves, std::size_t a_offset, std::size_t a_count) noexcept {
+        a_leaves.emplace_back(a_offset, a_count);
+      },
+      [](const Leaves&) noexcept { return std::numeric_limits<T>::max(); });
+    return leaves;
+  };
+
+  for (const auto& q : {Vec3T<T>(T(0.5), T(0.5), T(0.5)), Vec3T<T>(T(-1), T(0.2), T(2))}) {
+    REQUIRE(leafSequence(parallel, q) == leafSequence(serial, q));
+  }
+}
+
+TEMPLATE_TEST_CASE("PackedBVH: the direct SFC build is identical on one thread and on many",
+                   "[Parallel][BVH][DirectSFCBuild]",
+                   EBGEOMETRY_TEST_PRECISIONS)
+{
+  using T    = TestType;
+  using AABB = BoundingVolumes::AABBT<T>;
+  using Pnt  = BarePoint<T>;
+
+  constexpr std::size_t K = 4;
+
+  // Enough points that the radix sort runs over several chunks (SFC::ParallelGrainSize), and a leaf count that is
+  // not a power of K so the padded levels are exercised.
+  const auto pos = makeCloud<T>(4 * SFC::ParallelGrainSize + 123, 7);
+
+  const auto build = [&pos](unsigned a_numThreads) {
+    ScopedThreads threads(a_numThreads);
+
+    std::vector<std::pair<Pnt, AABB>> prims;
+    for (const auto& p : pos) {
+      prims.emplace_back(Pnt{p}, AABB(p, p));
+    }
+
+    return BVH::PackedBVH<T, Pnt, K>(std::move(prims), 6);
+  };
+
+  const auto serial   = build(1);
+  const auto parallel = build(4);
+
+  const auto& serialPrims   = serial.getPrimitives();
+  const auto& parallelPrims = parallel.getPrimitives();
+
+  REQUIRE(parallelPrims.size() == serialPrims.size());
+
+  for (std::size_t i = 0; i < serialPrims.size(); i++) {
+    REQUIRE(parallelPrims[i]->m_pos == serialPrims[i]->m_pos);
+  }
+
+  using Leaves = std::vector<std::pair<std::size_t, std::size_t>>;
+
+  const auto leafSequence = [](const BVH::PackedBVH<T, Pnt, K>& a_bvh, const Vec3T<T>& a_query) {
+    Leaves leaves;
+    a_bvh.pruneTraverse(
+      a_query,
+      leaves,
+      [](Leaves& a_leaves, std::size_t a_offset, std::size_t a_count) noexcept {
+        a_leaves.emplace_back(a_offset, a_count);
+      },
+      [](const Leaves&) noexcept { return std::numeric_limits<T>::max(); });
+    return leaves;
+  };
+
+  for (const auto& q : {Vec3T<T>(T(0.5), T(0.5), T(0.5)), Vec3T<T>(T(-1), T(0.2), T(2))}) {
+    REQUIRE(leafSequence(parallel, q) == leafSequence(serial, q));
+  }
+}
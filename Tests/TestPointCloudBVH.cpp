@@ -87,6 +87,33 @@ TEMPLATE_TEST_CASE("PointCloudBVH queries match brute force", "[PointCloudBVH]",
     }
   }
 
+  SECTION("batch closestPoint matches the single-query results")
+  {
+    // A coherent block of grid cell centres (what packets are built for), then incoherent external points;
+    // the count is deliberately not a multiple of the packet size.
+    std::vector<Vec3T<T>> queries;
+    for (int i = 0; i < 6; i++) {
+      for (int j = 0; j < 6; j++) {
+        for (int k = 0; k < 6; k++) {
+          queries.emplace_back(T(0.3) + T(0.05) * T(i), T(0.4) + T(0.05) * T(j), T(0.5) + T(0.05) * T(k));
+        }
+      }
+    }
+    const std::vector<Vec3T<T>> external = makeCloud<T>(37, 123u);
+    queries.insert(queries.end(), external.begin(), external.end());
+
+    std::vector<typename PointCloudBVH<T, std::size_t>::Hit> hits(queries.size());
+    bvh.closestPoint(queries.data(), queries.size(), hits.data());
+
+    for (std::size_t i = 0; i < queries.size(); i++) {
+      const auto single = bvh.closestPoint(queries[i]);
+
+      REQUIRE(hits[i].index < n);
+      CHECK(hits[i].distanceSquared == single.distanceSquared);
+      CHECK_THAT((pos[hits[i].index] - queries[i]).length2(), withinAbsT<T>(single.distanceSquared, tol));
+    }
+  }
+
   SECTION("querying at a cloud point returns that point at distance 0")
   {
     for (std::size_t i = 0; i < n; i += 137) {
@@ -142,6 +169,7 @@ TEMPLATE_TEST_CASE("PointCloudBVH queries match brute force", "[PointCloudBVH]",
     REQUIRE(all.size() == n);
     for (std::size_t i = 0; i < n; i += 29) {
       const auto single = bvh.nearestNeighbor(i);
+      CHECK(all[i].index != i);
       CHECK_THAT(all[i].distanceSquared, withinAbsT<T>(single.distanceSquared, tol));
     }
   }
@@ -154,6 +182,24 @@ TEMPLATE_TEST_CASE("PointCloudBVH queries match brute force", "[PointCloudBVH]",
     }
   }
 
+  SECTION("computeMetrics describes the tree the queries run on")
+  {
+    const BVH::TreeMetrics metrics = bvh.computeMetrics();
+
+    size_t numLeaves = 0;
+    for (const size_t count : metrics.leafFill) {
+      numLeaves += count;
+    }
+
+    CHECK(numLeaves == metrics.numLeaves);
+    CHECK(metrics.numPrimitives == bvh.getPrimitives().size());
+    CHECK(metrics.numPrimitives * PointSoA::DefaultWidth<T>() >= n);
+    CHECK(metrics.minLeafDepth <= metrics.maxLeafDepth);
+    CHECK(metrics.sahCost >= 1.0);
+    CHECK(metrics.epo >= 0.0);
+    CHECK(metrics.epo <= 1.0);
+  }
+
   SECTION("brute-force reference methods match an independent scan (and the accelerated queries)")
   {
     constexpr std::size_t k = 4;
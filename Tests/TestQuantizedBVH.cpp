@@ -0,0 +1,239 @@
+// SPDX-FileCopyrightText: 2026 Robert Marskar <robert.marskar@sintef.no>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Test suite for QuantizedBVH: the quantized child boxes must be conservative (contain the exact boxes), so that
+// queries on the compressed tree give exactly the results of the PackedBVH it was built from. Both quantization
+// widths and three branching factors are covered, which exercises the SIMD and scalar dequantization paths.
+
+#include "EBGeometry.hpp"
+#include "TestFloatingPointUtils.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_template_test_macros.hpp>
+
+using namespace EBGeometry;
+
+namespace {
+
+using Meta = DCEL::DefaultMetaData;
+
+// A fixed, reproducible random cloud of n points, clustered so that sibling boxes differ a lot in size.
+template <class T>
+std::vector<Vec3T<T>>
+makeCloud(std::size_t a_n, unsigned a_seed)
+{
+  std::mt19937                      rng(a_seed);
+  std::uniform_real_distribution<T> dist(T(0), T(1));
+  std::vector<Vec3T<T>>             pos(a_n);
+  for (std::size_t i = 0; i < a_n; i++) {
+    const T spread = (i % 3 == 0) ? T(1) : T(0.01);
+
+    pos[i] = Vec3T<T>(T(10) + spread * dist(rng), spread * dist(rng), -T(3) + spread * dist(rng));
+  }
+  return pos;
+}
+
+// Nearest squared distance to a point in the cloud, through any tree with a pruneTraverse().
+template <class T, class BVHType>
+T
+nearest2(const BVHType& a_bvh, const std::vector<typename BVHType::StorageType>& a_groups, const Vec3T<T>& a_query)
+{
+  T state = std::numeric_limits<T>::max();
+
+  a_bvh.pruneTraverse(
+    a_query,
+    state,
+    [&a_groups, &a_query](T& a_state, std::size_t a_offset, std::size_t a_count) noexcept {
+      for (std::size_t i = a_offset; i < a_offset + a_count; i++) {
+        a_state = std::min(a_state, a_groups[i].getMinimumDistance2(a_query));
+      }
+    },
+    [](const T& a_state) noexcept -> T { return a_state; });
+
+  return state;
+}
+
+// Builds a point-cloud BVH with branching factor K, compresses it with Q-bit boxes, and checks it.
+template <class T, std::size_t K, class Q>
+void
+checkPointCloud()
+{
+  using Cloud     = PointCloudBVH<T, std::size_t, K>;
+  using Group     = typename Cloud::PointGroup;
+  using Quantized = BVH::QuantizedBVH<T, Group, K, Q, BVH::ValueStorage<Group>>;
+  using AABB      = BoundingVolumes::AABBT<T>;
+
+  constexpr std::size_t n = 3000;
+
+  const std::vector<Vec3T<T>>    pos = makeCloud<T>(n, 20261017u);
+  const std::vector<std::size_t> meta(n, 0);
+
+  const Cloud     cloud(pos, meta, 1);
+  const Quantized quantized(cloud);
+
+  const BVH::TreeMetrics metrics = cloud.computeMetrics();
+
+  REQUIRE(quantized.getNodes().size() == metrics.numInteriorNodes);
+  REQUIRE(quantized.getLeaves().size() == metrics.numLeaves);
+  REQUIRE(quantized.getPrimitives().size() == cloud.getPrimitives().size());
+  REQUIRE(quantized.getRoot() == 0U);
+
+  CHECK(quantized.getBoundingVolume().getLowCorner() == cloud.getBoundingVolume().getLowCorner());
+  CHECK(quantized.getBoundingVolume().getHighCorner() == cloud.getBoundingVolume().getHighCorner());
+
+  const auto& groups = quantized.getPrimitives();
+
+  // Every dequantized child box must contain the exact box of the points below that child.
+  std::function<AABB(uint32_t)> check = [&](uint32_t a_ref) -> AABB {
+    if ((a_ref & Quantized::s_leafFlag) != 0U) {
+      const auto& leaf = quantized.getLeaves()[a_ref & ~Quantized::s_leafFlag];
+
+      std::vector<AABB> boxes;
+      for (uint32_t i = leaf.m_primOff; i < leaf.m_primOff + leaf.m_numPrims; i++) {
+        boxes.emplace_back(groups[i].template computeBoundingVolume<AABB>());
+      }
+
+      return AABB(boxes);
+    }
+
+    const auto& node = quantized.getNodes()[a_ref];
+
+    alignas(64) T lo[3][K];
+    alignas(64) T hi[3][K];
+    node.dequantize(lo, hi);
+
+    std::vector<AABB> boxes;
+    for (std::size_t k = 0; k < K; k++) {
+      const AABB exact = check(node.m_child[k]);
+
+      for (std::size_t dir = 0; dir < 3; dir++) {
+        CHECK(lo[dir][k] <= exact.getLowCorner()[dir]);
+        CHECK(hi[dir][k] >= exact.getHighCorner()[dir]);
+      }
+
+      boxes.emplace_back(exact);
+    }
+
+    return AABB(boxes);
+  };
+
+  (void)check(quantized.getRoot());
+
+  // Nearest-point queries, inside and well outside the cloud, match the uncompressed tree exactly.
+  std::vector<Vec3T<T>> queries = makeCloud<T>(200, 7u);
+  for (const Vec3T<T>& q : makeCloud<T>(50, 8u)) {
+    queries.emplace_back(q * T(3));
+  }
+
+  for (const auto& q : queries) {
+    CHECK(nearest2<T>(quantized, groups, q) == nearest2<T>(cloud, cloud.getPrimitives(), q));
+  }
+}
+
+} // namespace
+
+TEMPLATE_TEST_CASE("QuantizedBVH: conservative child boxes, and nearest-point queries that match PackedBVH",
+                   "[QuantizedBVH]",
+                   EBGEOMETRY_TEST_PRECISIONS)
+{
+  using T = TestType;
+
+  SECTION("K = 4, 8-bit boxes")
+  {
+    checkPointCloud<T, 4, uint8_t>();
+  }
+  SECTION("K = 4, 16-bit boxes")
+  {
+    checkPointCloud<T, 4, uint16_t>();
+  }
+  SECTION("K = 8, 8-bit boxes")
+  {
+    checkPointCloud<T, 8, uint8_t>();
+  }
+  SECTION("K = 2, 16-bit boxes")
+  {
+    checkPointCloud<T, 2, uint16_t>();
+  }
+}
+
+TEMPLATE_TEST_CASE("QuantizedBVH: signed distances through a compressed TriMeshSDF tree",
+                   "[QuantizedBVH][TriMesh]",
+                   EBGEOMETRY_TEST_PRECISIONS)
+{
+  using T = TestType;
+
+  constexpr std::size_t K = 4;
+  constexpr std::size_t W = 4;
+
+  using Group     = TriangleAoSoA<T, Meta, W>;
+  using Quantized = BVH::QuantizedBVH<T, Group, K, uint8_t, BVH::ValueStorage<Group>>;
+
+  const auto mesh = Parser::readIntoDCEL<T, Meta>(std::string(EBGEOMETRY_TEST_DATA_DIR) + "/dodecahedron.stl");
+  REQUIRE(mesh != nullptr);
+
+  const TriMeshSDF<T, Meta, K, W> sdf(mesh, BVH::Build::SAH, 1);
+  const Quantized                 quantized(*sdf.getRoot());
+
+  const auto& groups = quantized.getPrimitives();
+
+  for (int i = -4; i <= 4; i++) {
+    for (int j = -4; j <= 4; j++) {
+      const Vec3T<T> p(T(0.5) * T(i), T(0.37) * T(j), T(0.11) * T(i * j));
+
+      T minDist = std::numeric_limits<T>::max();
+
+      quantized.pruneTraverse(
+        p,
+        minDist,
+        [&groups, &p](T& a_state, std::size_t a_offset, std::size_t a_count) noexcept {
+          for (std::size_t g = a_offset; g < a_offset + a_count; g++) {
+            const T d = groups[g].signedDistance(p);
+
+            if (std::abs(d) < std::abs(a_state)) {
+              a_state = d;
+            }
+          }
+        },
+        [](const T& a_state) noexcept -> T { return a_state * a_state; });
+
+      CHECK(minDist == sdf.signedDistance(p));
+    }
+  }
+}
+
+TEMPLATE_TEST_CASE("QuantizedBVH: node sizes, and a tree that is a single leaf",
+                   "[QuantizedBVH]",
+                   EBGEOMETRY_TEST_PRECISIONS)
+{
+  using T = TestType;
+
+  // One 64-byte cache line per node in single precision with K = 4 and 8-bit boxes.
+  STATIC_REQUIRE(sizeof(BVH::QuantizedBVH<float, Triangle<float, Meta>, 4>::QuantizedNode) == 64);
+  STATIC_REQUIRE(sizeof(BVH::QuantizedBVH<double, Triangle<double, Meta>, 8>::QuantizedNode) == 128);
+
+  using Cloud     = PointCloudBVH<T, std::size_t, 4>;
+  using Group     = typename Cloud::PointGroup;
+  using Quantized = BVH::QuantizedBVH<T, Group, 4, uint8_t, BVH::ValueStorage<Group>>;
+
+  const std::vector<Vec3T<T>>    pos = {Vec3T<T>(T(1), T(2), T(3)), Vec3T<T>(T(-1), T(0), T(2))};
+  const std::vector<std::size_t> meta(pos.size(), 0);
+
+  const Cloud     cloud(pos, meta);
+  const Quantized quantized(cloud);
+
+  REQUIRE(quantized.getNodes().empty());
+  REQUIRE(quantized.getLeaves().size() == 1);
+  REQUIRE(quantized.getRoot() == Quantized::s_leafFlag);
+
+  const Vec3T<T> q(T(0), T(0), T(0));
+  CHECK(nearest2<T>(quantized, quantized.getPrimitives(), q) == nearest2<T>(cloud, cloud.getPrimitives(), q));
+}
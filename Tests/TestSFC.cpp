@@ -5,7 +5,9 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <vector>
 
@@ -254,3 +256,29 @@ TEST_CASE("SFC::order: is a permutation ordering points by non-decreasing SFC co
     REQUIRE(SFC::Hilbert::encode(bins[orderHilbert[i - 1]]) <= SFC::Hilbert::encode(bins[orderHilbert[i]]));
   }
 }
+
+TEST_CASE("SFC::sortByCode: matches std::stable_sort, ties included", "[SFC][order]")
+{
+  // Few distinct high bits (lots of ties, several skipped radix passes) and full-width codes; the large size spans
+  // several radix-sort chunks.
+  for (const SFC::Code mask : {SFC::Code(0xFF), SFC::Code(0xFFFFF), ~SFC::Code(0)}) {
+    for (const size_t n : {size_t(0), size_t(1), size_t(1000), 4 * SFC::ParallelGrainSize + 17}) {
+      uint64_t                state = 987654321u;
+      std::vector<SFC::Code> codes(n);
+      for (auto& code : codes) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        code  = (state ^ (state >> 29)) & mask;
+      }
+
+      std::vector<uint32_t> expected(n);
+      for (size_t i = 0; i < n; i++) {
+        expected[i] = static_cast<uint32_t>(i);
+      }
+      std::stable_sort(expected.begin(), expected.end(), [&codes](uint32_t a_lhs, uint32_t a_rhs) {
+        return codes[a_lhs] < codes[a_rhs];
+      });
+
+      REQUIRE(SFC::sortByCode(codes) == expected);
+    }
+  }
+}
@@ -5,6 +5,10 @@
 #include "TestFloatingPointUtils.hpp"
 
 #include <array>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <string>
 #include <vector>
 
@@ -53,6 +57,36 @@ buildTetrahedronSoup()
   return stl;
 }
 
+// Write triangles as a binary STL file, with per-facet attribute words. a_extra appends that many garbage bytes.
+static void
+writeBinarySTL(const std::string&                                a_filename,
+               const std::vector<std::array<Vec3T<float>, 3>>& a_triangles,
+               const std::vector<uint16_t>&                      a_attributes,
+               const size_t                                      a_extra = 0)
+{
+  std::ofstream os(a_filename, std::ios::binary);
+
+  const char     header[80] = "binary test file";
+  const uint32_t count      = static_cast<uint32_t>(a_triangles.size());
+
+  os.write(header, 80);
+  os.write(reinterpret_cast<const char*>(&count), 4);
+
+  for (size_t i = 0; i < a_triangles.size(); i++) {
+    float record[12] = {0, 0, 1};
+    for (size_t v = 0; v < 3; v++) {
+      for (size_t d = 0; d < 3; d++) {
+        record[3 + 3 * v + d] = a_triangles[i][v][d];
+      }
+    }
+
+    os.write(reinterpret_cast<const char*>(record), sizeof(record));
+    os.write(reinterpret_cast<const char*>(&a_attributes[i]), 2);
+  }
+
+  os.write(std::string(a_extra, 'x').data(), static_cast<std::streamsize>(a_extra));
+}
+
 TEMPLATE_TEST_CASE("STL: default construction is empty", "[STL]", EBGEOMETRY_TEST_PRECISIONS)
 {
   using T = TestType;
@@ -157,6 +191,118 @@ TEMPLATE_TEST_CASE("Parser::readSTL reads the test tetrahedron file into raw ver
   }
 }
 
+TEMPLATE_TEST_CASE("Parser::readSTL reads binary files and keeps the first solid", "[STL]", EBGEOMETRY_TEST_PRECISIONS)
+{
+  using T = TestType;
+
+  const Vec3T<float> A(0, 0, 0);
+  const Vec3T<float> B(1, 0, 0);
+  const Vec3T<float> C(0, 1, 0);
+  const Vec3T<float> D(0, 0, 1);
+  const Vec3T<float> E(5, 5, 5);
+
+  // The tetrahedron is solid 3; the stray triangle belongs to solid 7 and must be skipped.
+  const std::vector<std::array<Vec3T<float>, 3>> triangles = {{A, C, B}, {A, B, D}, {E, B, D}, {A, D, C}, {B, C, D}};
+  const std::vector<uint16_t>                    ids       = {3, 3, 7, 3, 3};
+
+  const std::string filename =
+    (std::filesystem::temp_directory_path() / ("EBGeometry_TestSTL_" + std::to_string(sizeof(T)) + ".stl")).string();
+
+  writeBinarySTL(filename, triangles, ids);
+
+  const auto stl = Parser::readSTL<T>(filename);
+
+  const auto& vertices = stl.getVertexCoordinates();
+  const auto& facets   = stl.getFacets();
+
+  REQUIRE(vertices.size() == 12);
+  REQUIRE(facets.size() == 4);
+
+  for (size_t f = 0; f < 4; f++) {
+    const auto& triangle = triangles[f < 2 ? f : f + 1];
+
+    REQUIRE(facets[f] == std::vector<size_t>{3 * f, 3 * f + 1, 3 * f + 2});
+
+    for (size_t v = 0; v < 3; v++) {
+      REQUIRE(vertices[3 * f + v] == Vec3T<T>(T(triangle[v][0]), T(triangle[v][1]), T(triangle[v][2])));
+    }
+  }
+
+  // Welding while decoding gives the same soup as compressing afterwards.
+  std::vector<Vec3T<T>>            welded;
+  std::vector<std::vector<size_t>> weldedFacets;
+
+  std::vector<Vec3T<T>>            compressed       = vertices;
+  std::vector<std::vector<size_t>> compressedFacets = facets;
+
+  Soup::compress(compressed, compressedFacets);
+
+  REQUIRE(Parser::readBinarySTL(filename, welded, weldedFacets, true));
+  REQUIRE(welded == compressed);
+  REQUIRE(weldedFacets == compressedFacets);
+  REQUIRE(welded.size() == 4);
+
+  std::filesystem::remove(filename);
+}
+
+TEMPLATE_TEST_CASE("Parser::readBinarySTL validates the facet count against the file size",
+                   "[STL]",
+                   EBGEOMETRY_TEST_PRECISIONS)
+{
+  using T = TestType;
+
+  // An N x N grid of triangles, enough records to be decoded in several chunks.
+  constexpr size_t N = 128;
+
+  std::vector<std::array<Vec3T<float>, 3>> triangles;
+  for (size_t j = 0; j < N; j++) {
+    for (size_t i = 0; i < N; i++) {
+      const Vec3T<float> x00(float(i), float(j), 0);
+      const Vec3T<float> x10(float(i + 1), float(j), 0);
+      const Vec3T<float> x01(float(i), float(j + 1), 0);
+      const Vec3T<float> x11(float(i + 1), float(j + 1), 0);
+
+      triangles.push_back({x00, x10, x11});
+      triangles.push_back({x00, x11, x01});
+    }
+  }
+
+  const std::vector<uint16_t> ids(triangles.size(), 0);
+
+  const std::string filename =
+    (std::filesystem::temp_directory_path() / ("EBGeometry_TestSTL_" + std::to_string(sizeof(T)) + ".stl")).string();
+
+  std::vector<Vec3T<T>>            vertices;
+  std::vector<std::vector<size_t>> facets;
+
+  // Trailing bytes are ignored.
+  writeBinarySTL(filename, triangles, ids, 7);
+
+  REQUIRE(Parser::readBinarySTL(filename, vertices, facets, true));
+  REQUIRE(vertices.size() == (N + 1) * (N + 1));
+  REQUIRE(facets.size() == 2 * N * N);
+
+  for (size_t f = 0; f < facets.size(); f++) {
+    for (size_t v = 0; v < 3; v++) {
+      const auto& x = triangles[f][v];
+
+      REQUIRE(vertices[facets[f][v]] == Vec3T<T>(T(x[0]), T(x[1]), T(x[2])));
+    }
+  }
+
+  // A file that ends before its last facet is rejected.
+  const auto size = std::filesystem::file_size(filename);
+  std::filesystem::resize_file(filename, size - 7 - 1);
+
+  REQUIRE_FALSE(Parser::readBinarySTL(filename, vertices, facets));
+  REQUIRE(vertices.empty());
+  REQUIRE(facets.empty());
+
+  std::filesystem::remove(filename);
+
+  REQUIRE_FALSE(Parser::readBinarySTL(filename, vertices, facets));
+}
+
 TEMPLATE_TEST_CASE("Parser::readSTL + convertToDCEL round-trips into a valid, watertight DCEL mesh",
                    "[STL]",
                    EBGEOMETRY_TEST_PRECISIONS)
@@ -11,7 +11,11 @@
 #include "TestFloatingPointUtils.hpp"
 
 #include <cmath>
+#include <memory>
+#include <string>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 #include <catch2/catch_template_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
@@ -598,3 +602,49 @@ TEMPLATE_TEST_CASE("Reflect: free function matches ReflectIF", "[Transform][Refl
     REQUIRE_THAT(freeFunc->value(p), withinAbsT(direct.value(p), exactMargin<T>()));
   }
 }
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Batched evaluation (ImplicitFunction::values)
+// ─────────────────────────────────────────────────────────────────────────────
+
+TEMPLATE_TEST_CASE("Transform values(): every transform's batched evaluation matches point-by-point value()",
+                   "[Transform][Batch]",
+                   EBGEOMETRY_TEST_PRECISIONS)
+{
+  using T    = TestType;
+  using Vec3 = Vec3T<T>;
+
+  const std::shared_ptr<IF<T>> sphere = std::make_shared<Sphere<T>>(Vec3(0.5, -0.25, 0.125), T(1));
+
+  const std::vector<std::pair<std::string, std::shared_ptr<IF<T>>>> functions{
+    {"Complement", Complement<T>(sphere)},
+    {"Translate", Translate<T>(sphere, Vec3(1, 2, 3))},
+    {"Rotate", Rotate<T>(sphere, T(30), 1)},
+    {"Offset", Offset<T>(sphere, T(0.25))},
+    {"Scale", Scale<T>(sphere, T(2))},
+    {"Annular", Annular<T>(sphere, T(0.1))},
+    {"Blur", Blur<T>(sphere, T(0.3))},
+    {"Mollify", Mollify<T>(sphere, T(0.25), 3)},
+    {"Elongate", Elongate<T>(sphere, Vec3(0.5, 0, 1))},
+    {"Reflect", Reflect<T>(sphere, size_t(2))},
+    {"Chained", Translate<T>(Rotate<T>(Scale<T>(sphere, T(0.5)), T(45), 2), Vec3(-1, 0, 1))},
+  };
+
+  // More points than ImplicitFunction::s_batchChunkSize so chunk boundaries are exercised.
+  std::vector<Vec3> points;
+  for (int i = 0; i < 300; i++) {
+    points.emplace_back(T(-3) + T(0.02) * T(i), T(0.5) * std::sin(T(i)), T(0.5) * std::cos(T(i)));
+  }
+  REQUIRE(points.size() > IF<T>::s_batchChunkSize);
+
+  for (const auto& [name, function] : functions) {
+    INFO(name);
+
+    std::vector<T> batched(points.size());
+    function->values(points.data(), batched.data(), points.size());
+
+    for (size_t i = 0; i < points.size(); i++) {
+      REQUIRE_THAT(batched[i], withinAbsT(function->value(points[i]), exactMargin<T>()));
+    }
+  }
+}